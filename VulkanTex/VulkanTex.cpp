@@ -1,6 +1,7 @@
 #include <cstdlib>
 #include <vulkan/vulkan_core.h>
 #include "VulkanTex.h"
+#include "VulkanTexP.h"
 
 namespace VulkanTex
 {
@@ -488,7 +489,21 @@ namespace VulkanTex
 
             default:
             {
-                assert(!IsCompressed(fmt) && !IsPacked(fmt) && !IsPlanar(fmt));
+                size_t blockWidth  = 0;
+                size_t blockHeight = 0;
+
+                if (Internal::GetASTCBlockSize(fmt, blockWidth, blockHeight))
+                {
+                    // ASTC always uses 128-bit blocks, only the footprint varies
+                    const uint64_t nbw = std::max<uint64_t>(1u, (uint64_t(width) + blockWidth - 1u) / blockWidth);
+                    const uint64_t nbh = std::max<uint64_t>(1u, (uint64_t(height) + blockHeight - 1u) / blockHeight);
+                    pitch = nbw * 16u;
+                    slice = pitch * nbh;
+                    break;
+                }
+
+                // Vulkan _PACKn formats are plain pixels here; only the 4:2:2 layouts above need special pitch handling
+                assert(!IsCompressed(fmt) && !IsPlanar(fmt));
 
                 size_t bpp = 0;
 
@@ -594,19 +609,46 @@ namespace VulkanTex
                 return height + ((height + 1) >> 1);
 
             default:
+            {
+                size_t blockWidth  = 0;
+                size_t blockHeight = 0;
+
+                if (Internal::GetASTCBlockSize(fmt, blockWidth, blockHeight))
+                    return std::max<size_t>(1, (height + blockHeight - 1) / blockHeight);
+
                 assert(IsValid(fmt));
                 assert(!IsCompressed(fmt) && !IsPlanar(fmt));
                 return height;
+            }
         }
     }
 
+    // sRGB / UNORM pairs; formats without a pairing are returned unchanged
     VkFormat MakeSRGB(VkFormat fmt) noexcept
     {
         switch (fmt)
         {
+            case VK_FORMAT_R8_UNORM:
+                return VK_FORMAT_R8_SRGB;
+
+            case VK_FORMAT_R8G8_UNORM:
+                return VK_FORMAT_R8G8_SRGB;
+
+            case VK_FORMAT_R8G8B8_UNORM:
+                return VK_FORMAT_R8G8B8_SRGB;
+
+            case VK_FORMAT_B8G8R8_UNORM:
+                return VK_FORMAT_B8G8R8_SRGB;
+
             case VK_FORMAT_R8G8B8A8_UNORM:
                 return VK_FORMAT_R8G8B8A8_SRGB;
 
+            case VK_FORMAT_B8G8R8A8_UNORM:
+                return VK_FORMAT_B8G8R8A8_SRGB;
+
+            case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+                return VK_FORMAT_A8B8G8R8_SRGB_PACK32;
+
             case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
                 return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
 
@@ -619,15 +661,163 @@ namespace VulkanTex
             case VK_FORMAT_BC3_UNORM_BLOCK:
                 return VK_FORMAT_BC3_SRGB_BLOCK;
 
-            case VK_FORMAT_B8G8R8A8_UNORM:
-                return VK_FORMAT_B8G8R8A8_SRGB;
-
-            case VK_FORMAT_B8G8R8_UNORM:
-                return VK_FORMAT_B8G8R8_SRGB;
-
             case VK_FORMAT_BC7_UNORM_BLOCK:
                 return VK_FORMAT_BC7_SRGB_BLOCK;
 
+            case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_5x4_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_5x4_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_5x5_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_6x5_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_6x5_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_6x6_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_8x5_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_8x5_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_8x6_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_8x6_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_8x8_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_10x5_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_10x5_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_10x6_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_10x6_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_10x8_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_10x8_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_10x10_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_10x10_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_12x10_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_12x10_SRGB_BLOCK;
+
+            case VK_FORMAT_ASTC_12x12_UNORM_BLOCK:
+                return VK_FORMAT_ASTC_12x12_SRGB_BLOCK;
+
+            case VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG:
+                return VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG;
+
+            case VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG:
+                return VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG;
+
+            case VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG:
+                return VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG;
+
+            case VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG:
+                return VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG;
+
+            default:
+                return fmt;
+        }
+    }
+
+    // Inverse of MakeSRGB
+    VkFormat MakeLinear(VkFormat fmt) noexcept
+    {
+        switch (fmt)
+        {
+            case VK_FORMAT_R8_SRGB:
+                return VK_FORMAT_R8_UNORM;
+
+            case VK_FORMAT_R8G8_SRGB:
+                return VK_FORMAT_R8G8_UNORM;
+
+            case VK_FORMAT_R8G8B8_SRGB:
+                return VK_FORMAT_R8G8B8_UNORM;
+
+            case VK_FORMAT_B8G8R8_SRGB:
+                return VK_FORMAT_B8G8R8_UNORM;
+
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                return VK_FORMAT_R8G8B8A8_UNORM;
+
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                return VK_FORMAT_B8G8R8A8_UNORM;
+
+            case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+                return VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+
+            case VK_FORMAT_BC2_SRGB_BLOCK:
+                return VK_FORMAT_BC2_UNORM_BLOCK;
+
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+                return VK_FORMAT_BC3_UNORM_BLOCK;
+
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return VK_FORMAT_BC7_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_5x4_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_5x4_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_5x5_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_6x5_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_6x5_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_6x6_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_8x5_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_8x5_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_8x6_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_8x6_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_8x8_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_10x5_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_10x5_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_10x6_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_10x6_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_10x8_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_10x8_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_10x10_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_10x10_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_12x10_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_12x10_UNORM_BLOCK;
+
+            case VK_FORMAT_ASTC_12x12_SRGB_BLOCK:
+                return VK_FORMAT_ASTC_12x12_UNORM_BLOCK;
+
+            case VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG:
+                return VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG;
+
+            case VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG:
+                return VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG;
+
+            case VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG:
+                return VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG;
+
+            case VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG:
+                return VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG;
+
             default:
                 return fmt;
         }
@@ -655,6 +845,100 @@ namespace VulkanTex
         }
     }
 
+    //-------------------------------------------------------------------------------------
+    // Checks the shape ScratchImage::Initialize/Adopt accept, resolving mipLevels 0 to a full chain
+    //-------------------------------------------------------------------------------------
+    namespace
+    {
+        bool ValidateMetadata(const TexMetadata& mdata, size_t& mipLevels) noexcept
+        {
+            if (!IsValid(mdata.format))
+                return false;
+
+            if (IsPalettized(mdata.format))
+                return false;
+
+            switch (mdata.dimension)
+            {
+                case TEX_DIMENSION_TEXTURE1D:
+                {
+                    if ((!mdata.width) ||
+                        (mdata.height != 1) ||
+                        (mdata.depth != 1) ||
+                        (!mdata.arraySize))
+                        return false;
+
+                    if (!CalculateMipLevels(mdata.width, 1, mipLevels))
+                        return false;
+
+                    break;
+                }
+
+                case TEX_DIMENSION_TEXTURE2D:
+                {
+                    if ((!mdata.width) ||
+                        (!mdata.height) ||
+                        (mdata.depth != 1) ||
+                        (!mdata.arraySize))
+                        return false;
+
+                    if (mdata.IsCubemap())
+                    {
+                        if ((mdata.arraySize % 6) != 0)
+                            return false;
+                    }
+
+                    if (!CalculateMipLevels(mdata.width, mdata.height, mipLevels))
+                        return false;
+
+                    break;
+                }
+
+                case TEX_DIMENSION_TEXTURE3D:
+                {
+                    if ((!mdata.width) ||
+                        (!mdata.height) ||
+                        (!mdata.depth) ||
+                        (mdata.arraySize != 1))
+                        return false;
+
+                    if (!CalculateMipLevels3D(mdata.width, mdata.height, mdata.depth, mipLevels))
+                        return false;
+
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Checks metadata decoded from a file before anything is sized from it
+    //-------------------------------------------------------------------------------------
+    bool Internal::ValidateFileMetadata(const TexMetadata& mdata) noexcept
+    {
+        if (!mdata.mipLevels)
+            return false;
+
+        size_t mipLevels = mdata.mipLevels;
+        if (!ValidateMetadata(mdata, mipLevels) || (mipLevels != mdata.mipLevels))
+            return false;
+
+        // Direct3D 11 resource limits, as DecodeDDSHeader
+        if ((mdata.width > 16384u) || (mdata.height > 16384u) || (mdata.arraySize > 2048u * 6u))
+            return false;
+
+        if ((mdata.dimension == TEX_DIMENSION_TEXTURE3D)
+            && ((mdata.width > 2048u) || (mdata.height > 2048u) || (mdata.depth > 2048u)))
+            return false;
+
+        return true;
+    }
+
     //=====================================================================================
     // ScratchImage - Bitmap image container
     //=====================================================================================
@@ -669,11 +953,17 @@ namespace VulkanTex
             m_metadata = moveFrom.m_metadata;
             m_image = moveFrom.m_image;
             m_memory = moveFrom.m_memory;
+            m_capacity = moveFrom.m_capacity;
+            m_deleter = moveFrom.m_deleter;
+            m_deleterContext = moveFrom.m_deleterContext;
 
             moveFrom.m_nimages = 0;
             moveFrom.m_size = 0;
             moveFrom.m_image = nullptr;
             moveFrom.m_memory = nullptr;
+            moveFrom.m_capacity = 0;
+            moveFrom.m_deleter = nullptr;
+            moveFrom.m_deleterContext = nullptr;
         }
         return *this;
     }
@@ -683,69 +973,11 @@ namespace VulkanTex
     //-------------------------------------------------------------------------------------
     bool ScratchImage::Initialize(const TexMetadata& mdata, CP_FLAGS flags) noexcept
     {
-        if (!IsValid(mdata.format))
-            return false;
-
-        if (IsPalettized(mdata.format))
-            return false;
-
         size_t mipLevels = mdata.mipLevels;
+        if (!ValidateMetadata(mdata, mipLevels))
+            return false;
 
-        switch (mdata.dimension)
-        {
-            case TEX_DIMENSION_TEXTURE1D:
-            {
-                if ((!mdata.width) ||
-                    (mdata.height != 1) ||
-                    (mdata.depth != 1) ||
-                    (!mdata.arraySize))
-                    return false;
-
-                if (!CalculateMipLevels(mdata.width, 1, mipLevels))
-                    return false;
-
-                break;
-            }
-
-            case TEX_DIMENSION_TEXTURE2D:
-            {
-                if ((!mdata.width) ||
-                    (!mdata.height) ||
-                    (mdata.depth != 1) ||
-                    (!mdata.arraySize))
-                    return false;
-
-                if (mdata.IsCubemap())
-                {
-                    if ((mdata.arraySize % 6) != 0)
-                        return false;
-                }
-
-                if (!CalculateMipLevels(mdata.width, mdata.height, mipLevels))
-                    return false;
-
-                break;
-            }
-
-            case TEX_DIMENSION_TEXTURE3D:
-            {
-                if ((!mdata.width) ||
-                    (!mdata.height) ||
-                    (!mdata.depth) ||
-                    (mdata.arraySize != 1))
-                    return false;
-
-                if (!CalculateMipLevels3D(mdata.width, mdata.height, mdata.depth, mipLevels))
-                    return false;
-
-                break;
-            }
-
-            default:
-                return false;
-        }
-
-        Release();
+        Reset();
 
         m_metadata.width      = mdata.width;
         m_metadata.height     = mdata.height;
@@ -757,9 +989,8 @@ namespace VulkanTex
         m_metadata.format     = mdata.format;
         m_metadata.dimension  = mdata.dimension;
 
-        size_t           pixelSize = 0;
-        size_t           nimages   = 0;
-        constexpr size_t alignment = 16;
+        size_t pixelSize = 0;
+        size_t nimages   = 0;
 
         bool hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
 
@@ -774,26 +1005,16 @@ namespace VulkanTex
         m_nimages = nimages;
         memset(m_image, 0, sizeof(Image) * nimages);
 
-#if _WIN32
-        m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, alignment));
-#else
-        size_t remainder = pixelSize % alignment;
-
-        if (remainder != 0) 
-        {
-            pixelSize += (alignment - remainder);
-        }
-
-        m_memory = static_cast<uint8_t*>(std::aligned_alloc(alignment, pixelSize));
-#endif
-
-        if (!m_memory)
+        if (!AllocatePixels(pixelSize))
         {
             Release();
             return false;
         }
 
-        memset(m_memory, 0, pixelSize);
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_ZERO_FILL, pixelSize);
+            memset(m_memory, 0, pixelSize);
+        }
         m_size = pixelSize;
 
         if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
@@ -832,7 +1053,7 @@ namespace VulkanTex
         if (!CalculateMipLevels(width, height, mipLevels))
             return false;
 
-        Release();
+        Reset();
 
         m_metadata.width = width;
         m_metadata.height = height;
@@ -844,9 +1065,8 @@ namespace VulkanTex
         m_metadata.format = fmt;
         m_metadata.dimension = TEX_DIMENSION_TEXTURE2D;
 
-        size_t           pixelSize = 0; 
-        size_t           nimages   = 0;
-        constexpr size_t alignment = 16;
+        size_t pixelSize = 0;
+        size_t nimages   = 0;
 
         bool hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
 
@@ -860,26 +1080,16 @@ namespace VulkanTex
         m_nimages = nimages;
         memset(m_image, 0, sizeof(Image) * nimages);
 
-#if _WIN32
-        m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, alignment));
-#else
-        size_t remainder = pixelSize % alignment;
-
-        if (remainder != 0) 
-        {
-            pixelSize += (alignment - remainder);
-        }
-
-        m_memory = static_cast<uint8_t*>(std::aligned_alloc(alignment, pixelSize));
-#endif
-
-        if (!m_memory)
+        if (!AllocatePixels(pixelSize))
         {
             Release();
             return false;
         }
 
-        memset(m_memory, 0, pixelSize);
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_ZERO_FILL, pixelSize);
+            memset(m_memory, 0, pixelSize);
+        }
         m_size = pixelSize;
 
         if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
@@ -905,7 +1115,7 @@ namespace VulkanTex
         if (!CalculateMipLevels3D(width, height, depth, mipLevels))
             return false;
 
-        Release();
+        Reset();
 
         m_metadata.width = width;
         m_metadata.height = height;
@@ -917,9 +1127,8 @@ namespace VulkanTex
         m_metadata.format = fmt;
         m_metadata.dimension = TEX_DIMENSION_TEXTURE3D;
 
-        size_t           pixelSize = 0;
-        size_t           nimages   = 0;
-        constexpr size_t alignment = 16;
+        size_t pixelSize = 0;
+        size_t nimages   = 0;
 
         bool hr = DetermineImageArray(m_metadata, flags, nimages, pixelSize);
 
@@ -936,25 +1145,15 @@ namespace VulkanTex
         m_nimages = nimages;
         memset(m_image, 0, sizeof(Image) * nimages);
 
-#if _WIN32
-        m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, alignment));
-#else
-        size_t remainder = pixelSize % alignment;
-
-        if (remainder != 0) 
-        {
-            pixelSize += (alignment - remainder);
-        }
-
-        m_memory = static_cast<uint8_t*>(std::aligned_alloc(alignment, pixelSize));
-#endif
-
-        if (!m_memory)
+        if (!AllocatePixels(pixelSize))
         {
             Release();
             return false;
         }
-        memset(m_memory, 0, pixelSize);
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_ZERO_FILL, pixelSize);
+            memset(m_memory, 0, pixelSize);
+        }
         m_size = pixelSize;
 
         if (!SetupImageArray(m_memory, pixelSize, m_metadata, flags, m_image, nimages))
@@ -1150,31 +1349,149 @@ namespace VulkanTex
             }
         }
 
-        return true;
-    }
+        return true;
+    }
+
+    void ScratchImage::Release() noexcept
+    {
+        Reset();
+        FreePixels();
+    }
+
+    void ScratchImage::Reset() noexcept
+    {
+        m_nimages = 0;
+        m_size = 0;
+
+        if (m_image)
+        {
+            delete[] m_image;
+            m_image = nullptr;
+        }
+
+        memset(&m_metadata, 0, sizeof(m_metadata));
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Keeps the current pixel allocation when it is large enough, so re-initializing the
+    // same ScratchImage for a series of files does not return to the allocator each time
+    //-------------------------------------------------------------------------------------
+    bool ScratchImage::AllocatePixels(size_t& pixelSize) noexcept
+    {
+        constexpr size_t alignment = 16;
+
+#if !_WIN32
+        size_t remainder = pixelSize % alignment;
+
+        if (remainder != 0)
+        {
+            pixelSize += (alignment - remainder);
+        }
+#endif
+
+        if (m_memory && (pixelSize <= m_capacity))
+            return true;
+
+        Internal::SavePhaseTimer timer(SAVE_PHASE_ALLOCATE, pixelSize);
+
+        FreePixels();
+
+#if _WIN32
+        m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, alignment));
+#else
+        m_memory = static_cast<uint8_t*>(std::aligned_alloc(alignment, pixelSize));
+#endif
+
+        if (!m_memory)
+            return false;
+
+        m_capacity = pixelSize;
+
+        return true;
+    }
+
+    void ScratchImage::FreePixels() noexcept
+    {
+        if (m_memory)
+        {
+            if (m_capacity)
+            {
+#if _WIN32
+                _aligned_free(m_memory);
+#else
+                std::free(m_memory);
+#endif
+            }
+            else if (m_deleter)
+            {
+                m_deleter(m_deleterContext, m_memory);
+            }
+
+            m_memory = nullptr;
+        }
+
+        m_capacity = 0;
+        m_deleter = nullptr;
+        m_deleterContext = nullptr;
+    }
+
+    bool ScratchImage::Adopt(
+        const TexMetadata& mdata,
+        uint8_t* pixels,
+        size_t size,
+        PixelDeleter deleter,
+        void* context,
+        CP_FLAGS flags) noexcept
+    {
+        if (!pixels || !size)
+            return false;
+
+        size_t mipLevels = mdata.mipLevels;
+        if (!ValidateMetadata(mdata, mipLevels))
+            return false;
+
+        TexMetadata layout = mdata;
+        layout.mipLevels = mipLevels;
+
+        size_t pixelSize = 0;
+        size_t nimages   = 0;
+
+        if (!DetermineImageArray(layout, flags, nimages, pixelSize) || (size < pixelSize))
+            return false;
 
-    void ScratchImage::Release() noexcept
-    {
-        m_nimages = 0;
-        m_size = 0;
+        auto images = new (std::nothrow) Image[nimages];
+        if (!images)
+            return false;
 
-        if (m_image)
-        {
-            delete[] m_image;
-            m_image = nullptr;
-        }
+        memset(images, 0, sizeof(Image) * nimages);
 
-        if (m_memory)
+        if (!SetupImageArray(pixels, pixelSize, layout, flags, images, nimages))
         {
-#if _WIN32
-            _aligned_free(m_memory);
-#else
-            std::free(m_memory);
-#endif
-            m_memory = nullptr;
+            delete[] images;
+            return false;
         }
 
-        memset(&m_metadata, 0, sizeof(m_metadata));
+        Release();
+
+        m_metadata.width      = layout.width;
+        m_metadata.height     = layout.height;
+        m_metadata.depth      = layout.depth;
+        m_metadata.arraySize  = layout.arraySize;
+        m_metadata.mipLevels  = layout.mipLevels;
+        m_metadata.miscFlags  = layout.miscFlags;
+        m_metadata.miscFlags2 = layout.miscFlags2;
+        m_metadata.format     = layout.format;
+        m_metadata.dimension  = layout.dimension;
+
+        m_image          = images;
+        m_nimages        = nimages;
+        m_memory         = pixels;
+        m_size           = pixelSize;
+        m_capacity       = 0;
+        m_deleter        = deleter;
+        m_deleterContext = context;
+
+        return true;
     }
 
     bool ScratchImage::OverrideFormat(VkFormat f) noexcept
@@ -1252,6 +1569,148 @@ namespace VulkanTex
         return &m_image[index];
     }
 
+    //=====================================================================================
+    // ImageSetView - Non-owning image set
+    //=====================================================================================
+    bool ImageSetView::InitializeFromImage(const Image& srcImage, bool allow1D) noexcept
+    {
+        return InitializeArrayFromImages(&srcImage, 1, allow1D);
+    }
+
+    bool ImageSetView::InitializeArrayFromImages(const Image* srcImages, size_t nImages, bool allow1D) noexcept
+    {
+        if (!srcImages || !nImages)
+            return false;
+
+        const VkFormat format = srcImages[0].format;
+        const size_t width = srcImages[0].width;
+        const size_t height = srcImages[0].height;
+
+        if (!IsValid(format) || IsPalettized(format) || !width || !height)
+            return false;
+
+        for (size_t index = 0; index < nImages; ++index)
+        {
+            if (!srcImages[index].pixels)
+                return false;
+
+            if (srcImages[index].format != format || srcImages[index].width != width || srcImages[index].height != height)
+            {
+                // All images must be the same format, width, and height
+                return false;
+            }
+        }
+
+        TexMetadata mdata = {};
+        mdata.width     = width;
+        mdata.height    = height;
+        mdata.depth     = 1;
+        mdata.arraySize = nImages;
+        mdata.mipLevels = 1;
+        mdata.format    = format;
+        mdata.dimension = (height > 1 || !allow1D) ? TEX_DIMENSION_TEXTURE2D : TEX_DIMENSION_TEXTURE1D;
+
+        images   = srcImages;
+        nimages  = nImages;
+        metadata = mdata;
+
+        return true;
+    }
+
+    bool ImageSetView::InitializeCubeFromImages(const Image* srcImages, size_t nImages) noexcept
+    {
+        if (!srcImages || !nImages)
+            return false;
+
+        if ((nImages % 6) != 0)
+            return false;
+
+        bool hr = InitializeArrayFromImages(srcImages, nImages, false);
+        if (hr == false)
+            return hr;
+
+        metadata.miscFlags |= TEX_MISC_TEXTURECUBE;
+
+        return true;
+    }
+
+    bool ImageSetView::Initialize3DFromImages(const Image* srcImages, size_t depth) noexcept
+    {
+        if (!srcImages || !depth)
+            return false;
+
+        if (depth > INT16_MAX)
+            return false;
+
+        bool hr = InitializeArrayFromImages(srcImages, depth, false);
+        if (hr == false)
+            return hr;
+
+        metadata.depth     = depth;
+        metadata.arraySize = 1;
+        metadata.dimension = TEX_DIMENSION_TEXTURE3D;
+
+        return true;
+    }
+
+    bool ImageSetView::Validate() const noexcept
+    {
+        if (!images || !nimages)
+            return false;
+
+        size_t count = 0;
+        size_t pixelSize = 0;
+
+        if (!DetermineImageArray(metadata, CP_FLAGS_NONE, count, pixelSize) || (count != nimages))
+            return false;
+
+        auto matches = [&](const Image& image, size_t mip) noexcept
+        {
+            return image.pixels
+                && (image.format == metadata.format)
+                && (image.width == std::max<size_t>(metadata.width >> mip, 1u))
+                && (image.height == std::max<size_t>(metadata.height >> mip, 1u));
+        };
+
+        size_t index = 0;
+
+        if (metadata.dimension == TEX_DIMENSION_TEXTURE3D)
+        {
+            size_t d = metadata.depth;
+
+            for (size_t level = 0; level < metadata.mipLevels; ++level)
+            {
+                for (size_t slice = 0; slice < d; ++slice, ++index)
+                {
+                    if (!matches(images[index], level))
+                        return false;
+                }
+
+                if (d > 1)
+                    d >>= 1;
+            }
+        }
+        else
+        {
+            for (size_t item = 0; item < metadata.arraySize; ++item)
+            {
+                for (size_t level = 0; level < metadata.mipLevels; ++level, ++index)
+                {
+                    if (!matches(images[index], level))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const Image* ImageSetView::GetImage(size_t mip, size_t item, size_t slice) const noexcept
+    {
+        const size_t index = metadata.ComputeIndex(mip, item, slice);
+        return (index < nimages) ? &images[index] : nullptr;
+    }
+
     //=====================================================================================
     // Blob - Bitmap image container
     //=====================================================================================
@@ -1263,9 +1722,11 @@ namespace VulkanTex
 
             m_buffer = moveFrom.m_buffer;
             m_size = moveFrom.m_size;
+            m_capacity = moveFrom.m_capacity;
 
             moveFrom.m_buffer = nullptr;
             moveFrom.m_size = 0;
+            moveFrom.m_capacity = 0;
         }
 
         return *this;
@@ -1284,6 +1745,7 @@ namespace VulkanTex
         }
 
         m_size = 0;
+        m_capacity = 0;
     }
 
     bool Blob::Initialize(size_t size) noexcept
@@ -1291,20 +1753,33 @@ namespace VulkanTex
         if (!size)
             return false;
 
-        Release();
-
+        // Only the allocation is rounded up (aligned_alloc needs a multiple of the
+        // alignment); the buffer size stays what was asked for, so writers that size a
+        // blob exactly don't hand out uninitialized tail bytes
         constexpr size_t alignment = 16;
-#if _WIN32
-        m_buffer = reinterpret_cast<uint8_t*>(_aligned_malloc(size, alignment));
-#else
-        std::size_t remainder = size % alignment;
+        size_t capacity = size;
+#if !_WIN32
+        std::size_t remainder = capacity % alignment;
 
         if (remainder != 0)
         {
-            size += (alignment - remainder);
+            capacity += (alignment - remainder);
+        }
+#endif
+
+        // Reuse the current buffer when it is large enough (contents are not preserved)
+        if (m_buffer && (capacity <= m_capacity))
+        {
+            m_size = size;
+            return true;
         }
 
-        m_buffer = reinterpret_cast<uint8_t*>(std::aligned_alloc(alignment, size));
+        Release();
+
+#if _WIN32
+        m_buffer = reinterpret_cast<uint8_t*>(_aligned_malloc(capacity, alignment));
+#else
+        m_buffer = reinterpret_cast<uint8_t*>(std::aligned_alloc(alignment, capacity));
 #endif
 
         if (!m_buffer)
@@ -1314,6 +1789,7 @@ namespace VulkanTex
         }
 
         m_size = size;
+        m_capacity = capacity;
 
         return true;
     }
@@ -1343,17 +1819,18 @@ namespace VulkanTex
             return false;
 
         constexpr size_t alignment = 16;
+        size_t capacity = size;
 #if _WIN32
-        auto tbuffer = reinterpret_cast<uint8_t*>(_aligned_malloc(size, alignment));
+        auto tbuffer = reinterpret_cast<uint8_t*>(_aligned_malloc(capacity, alignment));
 #else
-        std::size_t remainder = size % alignment;
+        std::size_t remainder = capacity % alignment;
 
         if (remainder != 0)
         {
-            size += (alignment - remainder);
+            capacity += (alignment - remainder);
         }
 
-        auto tbuffer = reinterpret_cast<uint8_t*>(std::aligned_alloc(alignment, size));
+        auto tbuffer = reinterpret_cast<uint8_t*>(std::aligned_alloc(alignment, capacity));
 #endif
         if (!tbuffer)
             return false;
@@ -1364,10 +1841,25 @@ namespace VulkanTex
 
         m_buffer = tbuffer;
         m_size = size;
+        m_capacity = capacity;
 
         return true;
     }
 
+    //=====================================================================================
+    // ParallelismScope
+    //=====================================================================================
+    ParallelismScope::ParallelismScope(size_t maxWorkers) noexcept :
+        m_previous(Internal::t_maxWorkers)
+    {
+        Internal::t_maxWorkers = maxWorkers;
+    }
+
+    ParallelismScope::~ParallelismScope()
+    {
+        Internal::t_maxWorkers = m_previous;
+    }
+
     //=====================================================================================
     // TexMetadata
     //=====================================================================================
@@ -2577,6 +3069,149 @@ namespace VulkanTex
         }
     }
 
+    //=====================================================================================
+    // ASTC format helpers
+    //=====================================================================================
+    bool Internal::IsASTC(VkFormat fmt) noexcept
+    {
+        size_t blockWidth  = 0;
+        size_t blockHeight = 0;
+        return GetASTCBlockSize(fmt, blockWidth, blockHeight);
+    }
+
+    bool Internal::IsASTCHDR(VkFormat fmt) noexcept
+    {
+        switch (fmt)
+        {
+            case VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK:
+            case VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    bool Internal::GetASTCBlockSize(VkFormat fmt, size_t& blockWidth, size_t& blockHeight) noexcept
+    {
+        switch (fmt)
+        {
+            case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK:
+                blockWidth  = 4;
+                blockHeight = 4;
+                return true;
+
+            case VK_FORMAT_ASTC_5x4_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_5x4_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK:
+                blockWidth  = 5;
+                blockHeight = 4;
+                return true;
+
+            case VK_FORMAT_ASTC_5x5_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_5x5_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK:
+                blockWidth  = 5;
+                blockHeight = 5;
+                return true;
+
+            case VK_FORMAT_ASTC_6x5_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_6x5_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK:
+                blockWidth  = 6;
+                blockHeight = 5;
+                return true;
+
+            case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_6x6_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK:
+                blockWidth  = 6;
+                blockHeight = 6;
+                return true;
+
+            case VK_FORMAT_ASTC_8x5_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_8x5_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK:
+                blockWidth  = 8;
+                blockHeight = 5;
+                return true;
+
+            case VK_FORMAT_ASTC_8x6_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_8x6_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK:
+                blockWidth  = 8;
+                blockHeight = 6;
+                return true;
+
+            case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK:
+                blockWidth  = 8;
+                blockHeight = 8;
+                return true;
+
+            case VK_FORMAT_ASTC_10x5_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_10x5_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK:
+                blockWidth  = 10;
+                blockHeight = 5;
+                return true;
+
+            case VK_FORMAT_ASTC_10x6_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_10x6_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK:
+                blockWidth  = 10;
+                blockHeight = 6;
+                return true;
+
+            case VK_FORMAT_ASTC_10x8_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_10x8_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK:
+                blockWidth  = 10;
+                blockHeight = 8;
+                return true;
+
+            case VK_FORMAT_ASTC_10x10_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_10x10_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK:
+                blockWidth  = 10;
+                blockHeight = 10;
+                return true;
+
+            case VK_FORMAT_ASTC_12x10_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_12x10_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK:
+                blockWidth  = 12;
+                blockHeight = 10;
+                return true;
+
+            case VK_FORMAT_ASTC_12x12_UNORM_BLOCK:
+            case VK_FORMAT_ASTC_12x12_SRGB_BLOCK:
+            case VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK:
+                blockWidth  = 12;
+                blockHeight = 12;
+                return true;
+
+            default:
+                blockWidth = blockHeight = 0;
+                return false;
+        }
+    }
+
     //=====================================================================================
     // Image I/O
     //=====================================================================================
@@ -2598,6 +3233,15 @@ namespace VulkanTex
         CapturedResourceInfo* capturedResourceInfo,
         DDS_FLAGS             flags,
         const char*           fileName) noexcept
+    {
+        return SaveToDDSFile(capturedResourceInfo, flags, DDSSaveOptions{}, fileName);
+    }
+
+    bool SaveToDDSFile(
+        CapturedResourceInfo* capturedResourceInfo,
+        DDS_FLAGS             flags,
+        const DDSSaveOptions& options,
+        const char*           fileName) noexcept
     {
         if ((capturedResourceInfo                           == nullptr) ||
             (capturedResourceInfo->mappedData               == nullptr) ||
@@ -2608,6 +3252,17 @@ namespace VulkanTex
             return false;
         }
 
+        // Within a memory budget the subresources are streamed from the mapped data without a copy of the whole texture
+        if (options.memoryBudget && !(flags & (DDS_FLAGS_SUPERCOMPRESS_FAST | DDS_FLAGS_SUPERCOMPRESS_HIGH)))
+        {
+            TexMetadata capturedMetadata = {};
+            std::vector<Image> capturedImages;
+            if (!Internal::GetCapturedImages(*capturedResourceInfo, capturedMetadata, capturedImages))
+                return false;
+
+            return SaveToDDSFile(capturedImages.data(), capturedImages.size(), capturedMetadata, flags, options, fileName);
+        }
+
         ScratchImage scratchImageResult = {};
         TexMetadata  mdata              = {};
         bool         result             = false;
@@ -2696,6 +3351,8 @@ namespace VulkanTex
         uint8_t* mappedData = capturedResourceInfo->mappedData;
         uint32_t dindex     = 0;
 
+        Internal::SavePhaseTimer copyTimer(SAVE_PHASE_COPY);
+
         for (uint32_t plane = 0U; plane < capturedResourceInfo->planeCount; ++plane)
         {
             for (uint32_t item = 0U; item < capturedResourceInfo->layerCount; ++item)
@@ -2729,15 +3386,20 @@ namespace VulkanTex
                                       subresInfo.height,
                                       1); // Do not consider slice now
 
+                    copyTimer.AddBytes(uint64_t(srcDataInfo.rowPitch) * subresInfo.height);
+
                     ++dindex;
                 }
             }
         }
 
+        copyTimer.Finish();
+
         result = SaveToDDSFile(scratchImageResult.GetImages(),
                                scratchImageResult.GetImageCount(),
                                mdata,
                                flags,
+                               options,
                                fileName);
 
         return result;
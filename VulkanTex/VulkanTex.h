@@ -151,6 +151,27 @@ namespace VulkanTex
 
         // Enables the loader to read large dimension .dds files (i.e. greater than known hardware requirements)
         DDS_FLAGS_ALLOW_LARGE_FILES = 0x1000000,
+
+        // Writer emits a 'VTSC' container of losslessly compressed subresource chunks (see DecompressDDSMemory)
+        DDS_FLAGS_SUPERCOMPRESS_FAST = 0x2000000,
+
+        // As DDS_FLAGS_SUPERCOMPRESS_FAST with a slower, higher ratio search
+        DDS_FLAGS_SUPERCOMPRESS_HIGH = 0x4000000,
+
+        // SaveToDDSFile sizes the file up front, maps it and fills the subresources from worker threads
+        // (positioned writes where the file cannot be mapped, the regular stream writer on Windows)
+        DDS_FLAGS_MAPPED_FILE = 0x8000000,
+    };
+
+    enum KTX2_FLAGS : uint32_t
+    {
+        KTX2_FLAGS_NONE = 0x0,
+
+        // Level data is losslessly supercompressed per subresource chunk (vendor supercompression scheme)
+        KTX2_FLAGS_SUPERCOMPRESS_FAST = 0x1,
+
+        // As KTX2_FLAGS_SUPERCOMPRESS_FAST with a slower, higher ratio search
+        KTX2_FLAGS_SUPERCOMPRESS_HIGH = 0x2,
     };
 
     enum TGA_FLAGS : uint32_t
@@ -312,6 +333,375 @@ namespace VulkanTex
         return a;
     }
 
+
+    // KTX2_FLAGS helper functions
+    inline constexpr KTX2_FLAGS operator |(KTX2_FLAGS a, KTX2_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        return static_cast<KTX2_FLAGS>(out);
+    }
+
+    inline KTX2_FLAGS &operator |=(KTX2_FLAGS &a, KTX2_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        a = static_cast<KTX2_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr KTX2_FLAGS operator &(KTX2_FLAGS a, KTX2_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        return static_cast<KTX2_FLAGS>(out);
+    }
+
+    inline KTX2_FLAGS &operator &=(KTX2_FLAGS &a, KTX2_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        a = static_cast<KTX2_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr KTX2_FLAGS operator ~(KTX2_FLAGS a) noexcept
+    {
+        uint32_t out = ~static_cast<uint32_t>(a);
+        return static_cast<KTX2_FLAGS>(out);
+    }
+
+    inline constexpr KTX2_FLAGS operator ^(KTX2_FLAGS a, KTX2_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        return static_cast<KTX2_FLAGS>(out);
+    }
+
+    inline KTX2_FLAGS &operator ^=(KTX2_FLAGS &a, KTX2_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        a = static_cast<KTX2_FLAGS>(out);
+        return a;
+    }
+
+    enum CONVERT_FLAGS : uint32_t
+    {
+        CONVERT_FLAGS_NONE = 0x0,
+
+        // Treat the source as sRGB encoded even if its format is not an _SRGB format
+        CONVERT_FLAGS_SRGB_IN = 0x1,
+
+        // Encode the result as sRGB even if the target format is not an _SRGB format
+        CONVERT_FLAGS_SRGB_OUT = 0x2,
+
+        CONVERT_FLAGS_SRGB = CONVERT_FLAGS_SRGB_IN | CONVERT_FLAGS_SRGB_OUT,
+
+        // Copy encoded values as-is between _SRGB and linear formats (no gamma conversion)
+        CONVERT_FLAGS_IGNORE_SRGB = 0x4,
+
+        // Always go through the float4 intermediate, even when a direct fast path exists
+        CONVERT_FLAGS_NO_FAST_PATH = 0x8,
+    };
+
+    struct ConvertOptions
+    {
+        CONVERT_FLAGS flags     = CONVERT_FLAGS_NONE;
+        float         threshold = 0.5f; // Alpha cutoff when the target format has a 1-bit alpha channel
+    };
+
+    // CONVERT_FLAGS helper functions
+    inline constexpr CONVERT_FLAGS operator |(CONVERT_FLAGS a, CONVERT_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        return static_cast<CONVERT_FLAGS>(out);
+    }
+
+    inline CONVERT_FLAGS &operator |=(CONVERT_FLAGS &a, CONVERT_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        a = static_cast<CONVERT_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr CONVERT_FLAGS operator &(CONVERT_FLAGS a, CONVERT_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        return static_cast<CONVERT_FLAGS>(out);
+    }
+
+    inline CONVERT_FLAGS &operator &=(CONVERT_FLAGS &a, CONVERT_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        a = static_cast<CONVERT_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr CONVERT_FLAGS operator ~(CONVERT_FLAGS a) noexcept
+    {
+        uint32_t out = ~static_cast<uint32_t>(a);
+        return static_cast<CONVERT_FLAGS>(out);
+    }
+
+    inline constexpr CONVERT_FLAGS operator ^(CONVERT_FLAGS a, CONVERT_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        return static_cast<CONVERT_FLAGS>(out);
+    }
+
+    inline CONVERT_FLAGS &operator ^=(CONVERT_FLAGS &a, CONVERT_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        a = static_cast<CONVERT_FLAGS>(out);
+        return a;
+    }
+
+    enum TEX_FILTER_FLAGS : uint32_t
+    {
+        TEX_FILTER_DEFAULT = 0,
+
+        // Filter color channels independently of alpha (by default straight alpha weights the color samples)
+        TEX_FILTER_SEPARATE_ALPHA = 0x100,
+
+        // Filtering mode to use for mip generation / resizing (defaults to box)
+        TEX_FILTER_POINT = 0x100000,
+        TEX_FILTER_LINEAR = 0x200000,
+        TEX_FILTER_CUBIC = 0x300000,
+        TEX_FILTER_BOX = 0x400000,
+        TEX_FILTER_FANT = 0x400000, // Equiv to Box filtering for mipmap generation
+        TEX_FILTER_KAISER = 0x600000, // Kaiser-windowed sinc
+
+        TEX_FILTER_MODE_MASK = 0xF00000,
+
+        // Treat the data as sRGB encoded even if the format is not an _SRGB format (filtering happens in linear space)
+        TEX_FILTER_SRGB_IN = 0x1000000,
+        TEX_FILTER_SRGB_OUT = 0x2000000,
+        TEX_FILTER_SRGB = TEX_FILTER_SRGB_IN | TEX_FILTER_SRGB_OUT,
+
+        // Filter the encoded values of _SRGB formats directly
+        TEX_FILTER_IGNORE_SRGB = 0x4000000,
+    };
+
+    // TEX_FILTER_FLAGS helper functions
+    inline constexpr TEX_FILTER_FLAGS operator |(TEX_FILTER_FLAGS a, TEX_FILTER_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        return static_cast<TEX_FILTER_FLAGS>(out);
+    }
+
+    inline TEX_FILTER_FLAGS &operator |=(TEX_FILTER_FLAGS &a, TEX_FILTER_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        a = static_cast<TEX_FILTER_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr TEX_FILTER_FLAGS operator &(TEX_FILTER_FLAGS a, TEX_FILTER_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        return static_cast<TEX_FILTER_FLAGS>(out);
+    }
+
+    inline TEX_FILTER_FLAGS &operator &=(TEX_FILTER_FLAGS &a, TEX_FILTER_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        a = static_cast<TEX_FILTER_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr TEX_FILTER_FLAGS operator ~(TEX_FILTER_FLAGS a) noexcept
+    {
+        uint32_t out = ~static_cast<uint32_t>(a);
+        return static_cast<TEX_FILTER_FLAGS>(out);
+    }
+
+    inline constexpr TEX_FILTER_FLAGS operator ^(TEX_FILTER_FLAGS a, TEX_FILTER_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        return static_cast<TEX_FILTER_FLAGS>(out);
+    }
+
+    inline TEX_FILTER_FLAGS &operator ^=(TEX_FILTER_FLAGS &a, TEX_FILTER_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        a = static_cast<TEX_FILTER_FLAGS>(out);
+        return a;
+    }
+
+    enum CMSE_FLAGS : uint32_t
+    {
+        CMSE_DEFAULT = 0,
+
+        // Linearize the values of the image before comparison (implied by _SRGB formats)
+        CMSE_IMAGE1_SRGB = 0x1,
+        CMSE_IMAGE2_SRGB = 0x2,
+
+        // Channels to leave out of the comparison
+        CMSE_IGNORE_RED = 0x10,
+        CMSE_IGNORE_GREEN = 0x20,
+        CMSE_IGNORE_BLUE = 0x40,
+        CMSE_IGNORE_ALPHA = 0x80,
+
+        // Map the image from [0, 1] to [-1, 1] before comparison (e.g. unsigned normal maps)
+        CMSE_IMAGE1_X2_BIAS = 0x100,
+        CMSE_IMAGE2_X2_BIAS = 0x200,
+    };
+
+    // CMSE_FLAGS helper functions
+    inline constexpr CMSE_FLAGS operator |(CMSE_FLAGS a, CMSE_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        return static_cast<CMSE_FLAGS>(out);
+    }
+
+    inline CMSE_FLAGS &operator |=(CMSE_FLAGS &a, CMSE_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        a = static_cast<CMSE_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr CMSE_FLAGS operator &(CMSE_FLAGS a, CMSE_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        return static_cast<CMSE_FLAGS>(out);
+    }
+
+    inline CMSE_FLAGS &operator &=(CMSE_FLAGS &a, CMSE_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        a = static_cast<CMSE_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr CMSE_FLAGS operator ~(CMSE_FLAGS a) noexcept
+    {
+        uint32_t out = ~static_cast<uint32_t>(a);
+        return static_cast<CMSE_FLAGS>(out);
+    }
+
+    inline constexpr CMSE_FLAGS operator ^(CMSE_FLAGS a, CMSE_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        return static_cast<CMSE_FLAGS>(out);
+    }
+
+    inline CMSE_FLAGS &operator ^=(CMSE_FLAGS &a, CMSE_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        a = static_cast<CMSE_FLAGS>(out);
+        return a;
+    }
+
+    enum TEX_PMALPHA_FLAGS : uint32_t
+    {
+        TEX_PMALPHA_DEFAULT = 0,
+
+        // Scale the encoded values of _SRGB formats directly (by default color is scaled in linear space)
+        TEX_PMALPHA_IGNORE_SRGB = 0x1,
+
+        // Treat the data as sRGB encoded even if the format is not an _SRGB format
+        TEX_PMALPHA_SRGB = 0x1000000,
+    };
+
+    // TEX_PMALPHA_FLAGS helper functions
+    inline constexpr TEX_PMALPHA_FLAGS operator |(TEX_PMALPHA_FLAGS a, TEX_PMALPHA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        return static_cast<TEX_PMALPHA_FLAGS>(out);
+    }
+
+    inline TEX_PMALPHA_FLAGS &operator |=(TEX_PMALPHA_FLAGS &a, TEX_PMALPHA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        a = static_cast<TEX_PMALPHA_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr TEX_PMALPHA_FLAGS operator &(TEX_PMALPHA_FLAGS a, TEX_PMALPHA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        return static_cast<TEX_PMALPHA_FLAGS>(out);
+    }
+
+    inline TEX_PMALPHA_FLAGS &operator &=(TEX_PMALPHA_FLAGS &a, TEX_PMALPHA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        a = static_cast<TEX_PMALPHA_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr TEX_PMALPHA_FLAGS operator ~(TEX_PMALPHA_FLAGS a) noexcept
+    {
+        uint32_t out = ~static_cast<uint32_t>(a);
+        return static_cast<TEX_PMALPHA_FLAGS>(out);
+    }
+
+    inline constexpr TEX_PMALPHA_FLAGS operator ^(TEX_PMALPHA_FLAGS a, TEX_PMALPHA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        return static_cast<TEX_PMALPHA_FLAGS>(out);
+    }
+
+    inline TEX_PMALPHA_FLAGS &operator ^=(TEX_PMALPHA_FLAGS &a, TEX_PMALPHA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        a = static_cast<TEX_PMALPHA_FLAGS>(out);
+        return a;
+    }
+
+    enum DELTA_FLAGS : uint32_t
+    {
+        DELTA_FLAGS_NONE = 0x0,
+
+        // Track 64x64 tiles (texels, or blocks for compressed formats) instead of whole subresources
+        DELTA_FLAGS_TILES = 0x1,
+
+        // Write a full base image even if hashes from an earlier save exist
+        DELTA_FLAGS_FORCE_BASE = 0x2,
+    };
+
+    // DELTA_FLAGS helper functions
+    inline constexpr DELTA_FLAGS operator |(DELTA_FLAGS a, DELTA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        return static_cast<DELTA_FLAGS>(out);
+    }
+
+    inline DELTA_FLAGS &operator |=(DELTA_FLAGS &a, DELTA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+        a = static_cast<DELTA_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr DELTA_FLAGS operator &(DELTA_FLAGS a, DELTA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        return static_cast<DELTA_FLAGS>(out);
+    }
+
+    inline DELTA_FLAGS &operator &=(DELTA_FLAGS &a, DELTA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) & static_cast<uint32_t>(b);
+        a = static_cast<DELTA_FLAGS>(out);
+        return a;
+    }
+
+    inline constexpr DELTA_FLAGS operator ~(DELTA_FLAGS a) noexcept
+    {
+        uint32_t out = ~static_cast<uint32_t>(a);
+        return static_cast<DELTA_FLAGS>(out);
+    }
+
+    inline constexpr DELTA_FLAGS operator ^(DELTA_FLAGS a, DELTA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        return static_cast<DELTA_FLAGS>(out);
+    }
+
+    inline DELTA_FLAGS &operator ^=(DELTA_FLAGS &a, DELTA_FLAGS b) noexcept
+    {
+        uint32_t out = static_cast<uint32_t>(a) ^ static_cast<uint32_t>(b);
+        a = static_cast<DELTA_FLAGS>(out);
+        return a;
+    }
+
     //---------------------------------------------------------------------------------
     // Format Utilities
     bool IsValid(VkFormat fmt) noexcept;
@@ -340,6 +730,7 @@ namespace VulkanTex
     size_t ComputeScanlines(VkFormat fmt, size_t height) noexcept;
 
     VkFormat MakeSRGB(VkFormat fmt) noexcept;
+    VkFormat MakeLinear(VkFormat fmt) noexcept;
 
     // Row-by-row memcpy
     void MemcpySubresource(
@@ -410,10 +801,12 @@ namespace VulkanTex
     {
     public:
         ScratchImage() noexcept
-            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr)
+            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr), m_capacity(0),
+              m_deleter(nullptr), m_deleterContext(nullptr)
         {}
         ScratchImage(ScratchImage&& moveFrom) noexcept
-            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr)
+            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr), m_capacity(0),
+              m_deleter(nullptr), m_deleterContext(nullptr)
         {
             *this = std::move(moveFrom);
         }
@@ -436,7 +829,19 @@ namespace VulkanTex
         bool InitializeCubeFromImages(const Image* images, size_t nImages, CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
         bool Initialize3DFromImages(const Image* images, size_t depth, CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
 
+        // Uses caller memory laid out as SetupImageArray describes for 'mdata' and 'flags' (at least
+        // the pixelSize DetermineImageArray reports) instead of allocating and copying. Release calls
+        // deleter(context, pixels), a null deleter leaves the memory with the caller. Nothing is
+        // adopted when this fails.
+        using PixelDeleter = void (*)(void* context, uint8_t* pixels);
+        bool Adopt(
+            const TexMetadata& mdata, uint8_t* pixels, size_t size,
+            PixelDeleter deleter, void* context = nullptr, CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
+
+        // Initialize* keeps the pixel allocation of a previous Initialize when it is large enough;
+        // Reset drops the images but keeps that allocation, Release frees everything
         void Release() noexcept;
+        void Reset() noexcept;
 
         bool OverrideFormat(VkFormat f) noexcept;
 
@@ -455,6 +860,40 @@ namespace VulkanTex
         TexMetadata m_metadata;
         Image*      m_image;
         uint8_t*    m_memory;
+        size_t      m_capacity;         // 0 for adopted memory
+        PixelDeleter m_deleter;
+        void*       m_deleterContext;
+
+        bool AllocatePixels(size_t& pixelSize) noexcept;
+        void FreePixels() noexcept;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Non-owning set of images in TexMetadata::ComputeIndex order. The Image descriptors and
+    // their pixels belong to the caller and must outlive the view; a ScratchImage converts
+    // implicitly, so entry points taking a view accept either.
+    struct ImageSetView
+    {
+        const Image* images;
+        size_t       nimages;
+        TexMetadata  metadata;
+
+        ImageSetView() noexcept : images(nullptr), nimages(0), metadata{} {}
+        ImageSetView(const Image* srcImages, size_t count, const TexMetadata& mdata) noexcept
+            : images(srcImages), nimages(count), metadata(mdata) {}
+        ImageSetView(const ScratchImage& image) noexcept
+            : images(image.GetImages()), nimages(image.GetImageCount()), metadata(image.GetMetadata()) {}
+
+        // Same checks and resulting metadata as the ScratchImage counterparts, without the copy
+        bool InitializeFromImage(const Image& srcImage, bool allow1D = false) noexcept;
+        bool InitializeArrayFromImages(const Image* srcImages, size_t nImages, bool allow1D = false) noexcept;
+        bool InitializeCubeFromImages(const Image* srcImages, size_t nImages) noexcept;
+        bool Initialize3DFromImages(const Image* srcImages, size_t depth) noexcept;
+
+        // Checks the image count and each image's format and dimensions against 'metadata'
+        bool Validate() const noexcept;
+
+        const Image* GetImage(size_t mip, size_t item, size_t slice) const noexcept;
     };
 
     //---------------------------------------------------------------------------------
@@ -462,8 +901,8 @@ namespace VulkanTex
     class Blob
     {
     public:
-        Blob() noexcept : m_buffer(nullptr), m_size(0) {}
-        Blob(Blob&& moveFrom) noexcept : m_buffer(nullptr), m_size(0) { *this = std::move(moveFrom); }
+        Blob() noexcept : m_buffer(nullptr), m_size(0), m_capacity(0) {}
+        Blob(Blob&& moveFrom) noexcept : m_buffer(nullptr), m_size(0), m_capacity(0) { *this = std::move(moveFrom); }
         ~Blob() { Release(); }
 
         Blob& operator= (Blob&& moveFrom) noexcept;
@@ -471,6 +910,7 @@ namespace VulkanTex
         Blob(const Blob&) = delete;
         Blob& operator=(const Blob&) = delete;
 
+        // Reuses the current buffer when it is large enough
         bool Initialize(size_t size) noexcept;
 
         void Release() noexcept;
@@ -490,10 +930,342 @@ namespace VulkanTex
     private:
         uint8_t* m_buffer;
         size_t   m_size;
+        size_t   m_capacity;
+    };
+
+    //---------------------------------------------------------------------------------
+    // 128-bit content hash of image data
+    struct ContentHash
+    {
+        uint64_t low;
+        uint64_t high;
+
+        bool operator==(const ContentHash& other) const noexcept { return (low == other.low) && (high == other.high); }
+        bool operator!=(const ContentHash& other) const noexcept { return !(*this == other); }
+    };
+
+    //---------------------------------------------------------------------------------
+    // Deduplicating capture store
+    // Every unique subresource payload is written once to <directory>/payloads,
+    // a capture is a small manifest (<directory>/<name>.vtcs) referencing payloads by content hash.
+    class CaptureStore
+    {
+    public:
+        CaptureStore() noexcept : m_impl(nullptr) {}
+        CaptureStore(CaptureStore&& moveFrom) noexcept : m_impl(nullptr) { *this = std::move(moveFrom); }
+        ~CaptureStore() { Close(); }
+
+        CaptureStore& operator= (CaptureStore&& moveFrom) noexcept;
+
+        CaptureStore(const CaptureStore&) = delete;
+        CaptureStore& operator=(const CaptureStore&) = delete;
+
+        // Creates the directory if needed and indexes the payloads already present
+        bool Open(const char* directory) noexcept;
+
+        void Close() noexcept;
+
+        bool Add(const char* name, const Image* images, size_t nimages, const TexMetadata& metadata) noexcept;
+        bool Add(const char* name, const ImageSetView& images) noexcept;
+        bool Add(const char* name, const CapturedResourceInfo* capturedResourceInfo) noexcept;
+
+        // Rebuilds a capture from its manifest
+        bool Load(const char* name, ScratchImage& image) const noexcept;
+        bool ExportToDDSFile(const char* name, DDS_FLAGS flags, const char* szFile) const noexcept;
+
+        // Payloads written / references to existing payloads since Open
+        size_t GetPayloadsWritten() const noexcept;
+        size_t GetPayloadsReused() const noexcept;
+
+    private:
+        struct Impl;
+        Impl* m_impl;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Incremental capture
+    // Keeps the hashes of the last save of every resource id and writes only the subresources
+    // (or tiles) that changed since, together with a manifest of the written regions.
+    // The first save of an id, or a save whose layout changed, is a full base.
+    class DeltaCapture
+    {
+    public:
+        DeltaCapture() noexcept : m_impl(nullptr) {}
+        DeltaCapture(DeltaCapture&& moveFrom) noexcept : m_impl(nullptr) { *this = std::move(moveFrom); }
+        ~DeltaCapture() { Reset(); }
+
+        DeltaCapture& operator= (DeltaCapture&& moveFrom) noexcept;
+
+        DeltaCapture(const DeltaCapture&) = delete;
+        DeltaCapture& operator=(const DeltaCapture&) = delete;
+
+        bool Save(
+            uint64_t resourceId, const CapturedResourceInfo* capturedResourceInfo,
+            DELTA_FLAGS flags, const char* szFile) noexcept;
+        bool Save(
+            uint64_t resourceId, const Image* images, size_t nimages, const TexMetadata& metadata,
+            DELTA_FLAGS flags, const char* szFile) noexcept;
+        bool Save(uint64_t resourceId, const ImageSetView& images, DELTA_FLAGS flags, const char* szFile) noexcept;
+
+        // Drops the history of one resource / of all resources (the next save is a base)
+        void Forget(uint64_t resourceId) noexcept;
+        void Reset() noexcept;
+
+        // Regions written by the last successful Save
+        size_t GetLastRegionCount() const noexcept;
+
+    private:
+        struct Impl;
+        Impl* m_impl;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Texture archive
+    // Packs many textures into a single file: every payload starts on a 4 KiB boundary
+    // (direct I/O / mmap friendly), names are found through a hashed index stored at the end.
+    // The archive only appears under its final name once Finish succeeded.
+    class TextureArchiveWriter
+    {
+    public:
+        TextureArchiveWriter() noexcept : m_impl(nullptr) {}
+        TextureArchiveWriter(TextureArchiveWriter&& moveFrom) noexcept : m_impl(nullptr) { *this = std::move(moveFrom); }
+        ~TextureArchiveWriter() { Close(); }
+
+        TextureArchiveWriter& operator= (TextureArchiveWriter&& moveFrom) noexcept;
+
+        TextureArchiveWriter(const TextureArchiveWriter&) = delete;
+        TextureArchiveWriter& operator=(const TextureArchiveWriter&) = delete;
+
+        bool Open(const char* szFile) noexcept;
+
+        // Discards an archive that was not finished
+        void Close() noexcept;
+
+        // Names must be unique within the archive
+        bool Add(const char* name, const Image* images, size_t nimages, const TexMetadata& metadata) noexcept;
+        bool Add(const char* name, const ImageSetView& images) noexcept;
+        bool Add(const char* name, const CapturedResourceInfo* capturedResourceInfo) noexcept;
+
+        bool Finish() noexcept;
+
+        size_t GetEntryCount() const noexcept;
+
+    private:
+        struct Impl;
+        Impl* m_impl;
+    };
+
+    // Read-only view of an archive, the file is mapped copy-on-write.
+    // GetImages fills 'images' (GetImageCount entries, ScratchImage order) with views pointing
+    // into the mapping, valid until Close.
+    class TextureArchive
+    {
+    public:
+        TextureArchive() noexcept : m_impl(nullptr) {}
+        TextureArchive(TextureArchive&& moveFrom) noexcept : m_impl(nullptr) { *this = std::move(moveFrom); }
+        ~TextureArchive() { Close(); }
+
+        TextureArchive& operator= (TextureArchive&& moveFrom) noexcept;
+
+        TextureArchive(const TextureArchive&) = delete;
+        TextureArchive& operator=(const TextureArchive&) = delete;
+
+        bool Open(const char* szFile) noexcept;
+        void Close() noexcept;
+
+        size_t GetEntryCount() const noexcept;
+
+        // Returns size_t(-1) if the name is not in the archive
+        size_t Find(const char* name) const noexcept;
+
+        const char* GetName(size_t entry) const noexcept;
+        bool GetMetadata(size_t entry, TexMetadata& metadata) const noexcept;
+        size_t GetImageCount(size_t entry) const noexcept;
+
+        bool GetImages(size_t entry, Image* images, size_t nimages) const noexcept;
+        bool Load(size_t entry, ScratchImage& image) const noexcept;
+
+    private:
+        struct Impl;
+        Impl* m_impl;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Save instrumentation
+    // While a SaveTraceScope is alive on a thread, the save entry points called from that thread
+    // (SaveToDDSMemory, SaveToDDSFile including the captured-resource overload) add the time and
+    // bytes of each phase to 'stats' and report every phase to 'callback'. Without a scope nothing
+    // is measured.
+    enum SAVE_PHASE : uint32_t
+    {
+        SAVE_PHASE_HEADER_ENCODE = 0,
+        SAVE_PHASE_ALLOCATE,
+        SAVE_PHASE_ZERO_FILL,
+        SAVE_PHASE_COPY,
+        SAVE_PHASE_REPACK,          // Copies that change the row layout (24bpp)
+        SAVE_PHASE_COMPRESS,        // DDS_FLAGS_SUPERCOMPRESS_*
+        SAVE_PHASE_WRITE,           // One call per write issued to the file
+        SAVE_PHASE_COUNT
+    };
+
+    const char* GetSavePhaseName(SAVE_PHASE phase) noexcept;
+
+    struct SavePhaseStats
+    {
+        uint64_t nanoseconds;
+        uint64_t bytes;
+        uint64_t calls;
+    };
+
+    struct Stats
+    {
+        SavePhaseStats phases[SAVE_PHASE_COUNT];
+
+        void Reset() noexcept { *this = {}; }
+        uint64_t GetWriteCalls() const noexcept { return phases[SAVE_PHASE_WRITE].calls; }
+    };
+
+    // 'start' is in nanoseconds on the steady clock
+    using SaveTraceCallback = void (*)(void* context, SAVE_PHASE phase, uint64_t start, uint64_t duration, uint64_t bytes);
+
+    // Scopes nest; 'stats' and 'callback' are only used from the installing thread
+    class SaveTraceScope
+    {
+    public:
+        explicit SaveTraceScope(Stats* stats, SaveTraceCallback callback = nullptr, void* context = nullptr) noexcept;
+        ~SaveTraceScope();
+
+        SaveTraceScope(const SaveTraceScope&) = delete;
+        SaveTraceScope& operator=(const SaveTraceScope&) = delete;
+
+        void Record(SAVE_PHASE phase, uint64_t start, uint64_t duration, uint64_t bytes) const noexcept;
+
+    private:
+        Stats*                m_stats;
+        SaveTraceCallback     m_callback;
+        void*                 m_context;
+        const SaveTraceScope* m_previous;
+    };
+
+    // Thread-safe SaveTraceCallback sink (pass TraceRecorder::Callback with the recorder as
+    // context) that exports the Chrome trace event format (chrome://tracing, Perfetto)
+    class TraceRecorder
+    {
+    public:
+        TraceRecorder() noexcept;
+        TraceRecorder(TraceRecorder&& moveFrom) noexcept : m_impl(nullptr) { *this = std::move(moveFrom); }
+        ~TraceRecorder();
+
+        TraceRecorder& operator= (TraceRecorder&& moveFrom) noexcept;
+
+        TraceRecorder(const TraceRecorder&) = delete;
+        TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+        static void Callback(void* context, SAVE_PHASE phase, uint64_t start, uint64_t duration, uint64_t bytes) noexcept;
+
+        size_t GetEventCount() const noexcept;
+        void Clear() noexcept;
+
+        bool ExportChromeTrace(const char* szFile) const noexcept;
+
+    private:
+        struct Impl;
+        Impl* m_impl;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Threading
+    // Operations called from the installing thread use at most 'maxWorkers' threads (including
+    // the caller) while the scope is alive; 0 restores the default of one per hardware thread.
+    // Batch tools that already process one file per core use 1 to avoid nested oversubscription.
+    class ParallelismScope
+    {
+    public:
+        explicit ParallelismScope(size_t maxWorkers) noexcept;
+        ~ParallelismScope();
+
+        ParallelismScope(const ParallelismScope&) = delete;
+        ParallelismScope& operator=(const ParallelismScope&) = delete;
+
+    private:
+        size_t m_previous;
+    };
+
+    //---------------------------------------------------------------------------------
+    // File I/O backends
+    // The DDS file savers and loaders issue the header and every subresource span of a file as
+    // one batch of positional transfers through the backend installed on the calling thread.
+    enum IO_BACKEND : uint32_t
+    {
+        // Blocking stream writes and vectored reads from the calling thread
+        IO_BACKEND_DEFAULT = 0,
+
+        // pread/pwrite calls spread over worker threads
+        IO_BACKEND_THREAD_POOL,
+
+        // One io_uring submission per batch, fixed buffers for staged spans (Linux);
+        // IO_BACKEND_THREAD_POOL where io_uring is unavailable
+        IO_BACKEND_IO_URING,
+    };
+
+    bool IsIOBackendSupported(IO_BACKEND backend) noexcept;
+
+    class IOBackendScope
+    {
+    public:
+        explicit IOBackendScope(IO_BACKEND backend) noexcept;
+        ~IOBackendScope();
+
+        IOBackendScope(const IOBackendScope&) = delete;
+        IOBackendScope& operator=(const IOBackendScope&) = delete;
+
+    private:
+        IO_BACKEND m_previous;
     };
 
     // Image I/O
+    // Extra SaveToDDSFile controls, a default-constructed value behaves like the overloads without options
+    struct DDSSaveOptions
+    {
+        // Plain DDS files of at least this many bytes are written with O_DIRECT through a ring of
+        // page-aligned buffers, keeping large dumps out of the page cache; 0 disables it. Linux only,
+        // file systems that reject O_DIRECT use the regular writers.
+        uint64_t directIOThreshold = 0;
+
+        // Upper bound on the staging memory of a plain DDS save: subresources are copied in row bands
+        // through one scratch buffer of at most this many bytes and written in file order (no mapped,
+        // O_DIRECT or batched writes); 0 means no bound. The CapturedResourceInfo overload then reads
+        // straight from mappedData instead of copying the capture into a ScratchImage first.
+        size_t memoryBudget = 0;
+    };
+
     // DDS operations
+    // Subresources are used in their stored layout (legacy formats that need expanding are rejected),
+    // 'VTSC' containers are accepted as well. The range overloads load mips [firstMip, firstMip + mipCount)
+    // of array items [firstItem, firstItem + itemCount), 0 counts mean "to the end"; the file loader only
+    // reads those byte ranges. 'metadata' always describes the whole file.
+    bool GetMetadataFromDDSMemory(
+        const uint8_t* pSource, size_t size, DDS_FLAGS flags,
+        TexMetadata& metadata) noexcept;
+    bool GetMetadataFromDDSFile(
+        const char* szFile, DDS_FLAGS flags,
+        TexMetadata& metadata) noexcept;
+
+    bool LoadFromDDSMemory(
+        const uint8_t* pSource, size_t size, DDS_FLAGS flags,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+    bool LoadFromDDSMemory(
+        const uint8_t* pSource, size_t size, DDS_FLAGS flags,
+        size_t firstMip, size_t mipCount, size_t firstItem, size_t itemCount,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+    bool LoadFromDDSFile(
+        const char* szFile, DDS_FLAGS flags,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+    bool LoadFromDDSFile(
+        const char* szFile, DDS_FLAGS flags,
+        size_t firstMip, size_t mipCount, size_t firstItem, size_t itemCount,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+
     bool SaveToDDSMemory(
         const Image& image,
         DDS_FLAGS flags,
@@ -507,10 +1279,23 @@ namespace VulkanTex
         CapturedResourceInfo* capturedResourceInfo,
         DDS_FLAGS             flags,
         const char*           fileName) noexcept;
+    bool SaveToDDSFile(
+        CapturedResourceInfo* capturedResourceInfo,
+        DDS_FLAGS             flags,
+        const DDSSaveOptions& options,
+        const char*           fileName) noexcept;
     bool SaveToDDSFile(const Image& image, DDS_FLAGS flags, const char* szFile) noexcept;
     bool SaveToDDSFile(
         const Image* images, size_t nimages, const TexMetadata& metadata,
         DDS_FLAGS flags, const char* szFile) noexcept;
+    bool SaveToDDSMemory(const ImageSetView& images, DDS_FLAGS flags, Blob& blob) noexcept;
+    bool SaveToDDSFile(
+        const Image* images, size_t nimages, const TexMetadata& metadata,
+        DDS_FLAGS flags, const DDSSaveOptions& options, const char* szFile) noexcept;
+    bool SaveToDDSFile(const ImageSetView& images, DDS_FLAGS flags, const char* szFile) noexcept;
+    bool SaveToDDSFile(
+        const ImageSetView& images, DDS_FLAGS flags, const DDSSaveOptions& options,
+        const char* szFile) noexcept;
     // DDS helper functions
     bool EncodeDDSHeader(
         const TexMetadata& metadata, DDS_FLAGS flags,
@@ -529,6 +1314,208 @@ namespace VulkanTex
         size_t& required) noexcept;
 #endif
 
+    // Supercompressed DDS containers (DDS_FLAGS_SUPERCOMPRESS_*)
+    // Subresources are stored as independently decodable chunks; DecompressDDSSubresource returns the
+    // tightly packed bytes of subresource 'index' (DDS storage order) without decoding the others.
+    bool IsSupercompressedDDS(const uint8_t* pSource, size_t size) noexcept;
+    bool DecompressDDSMemory(const uint8_t* pSource, size_t size, Blob& dds) noexcept;
+    bool DecompressDDSFile(const char* szSource, const char* szDestination) noexcept;
+    bool DecompressDDSSubresource(
+        const uint8_t* pSource, size_t size, size_t index,
+        Blob& data) noexcept;
+
+    // KTX2 operations
+    // Level data is stored with its native VkFormat and located through the level index, so the
+    // firstMip/mipCount overloads only read the requested levels (mipCount 0 means "to the end").
+    // 'metadata' always describes the whole file.
+    bool GetMetadataFromKTX2Memory(
+        const uint8_t* pSource, size_t size,
+        TexMetadata& metadata) noexcept;
+    bool GetMetadataFromKTX2File(
+        const char* szFile,
+        TexMetadata& metadata) noexcept;
+
+    bool LoadFromKTX2Memory(
+        const uint8_t* pSource, size_t size,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+    bool LoadFromKTX2Memory(
+        const uint8_t* pSource, size_t size,
+        size_t firstMip, size_t mipCount,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+    bool LoadFromKTX2File(
+        const char* szFile,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+    bool LoadFromKTX2File(
+        const char* szFile,
+        size_t firstMip, size_t mipCount,
+        TexMetadata* metadata, ScratchImage& image) noexcept;
+
+    bool SaveToKTX2Memory(const Image& image, KTX2_FLAGS flags, Blob& blob) noexcept;
+    bool SaveToKTX2Memory(
+        const Image* images, size_t nimages, const TexMetadata& metadata,
+        KTX2_FLAGS flags, Blob& blob) noexcept;
+    bool SaveToKTX2File(const Image& image, KTX2_FLAGS flags, const char* szFile) noexcept;
+    bool SaveToKTX2File(
+        const Image* images, size_t nimages, const TexMetadata& metadata,
+        KTX2_FLAGS flags, const char* szFile) noexcept;
+    bool SaveToKTX2Memory(const ImageSetView& images, KTX2_FLAGS flags, Blob& blob) noexcept;
+    bool SaveToKTX2File(const ImageSetView& images, KTX2_FLAGS flags, const char* szFile) noexcept;
+
+    // Format conversion
+    bool Convert(
+        const Image& srcImage, VkFormat format, ConvertOptions options,
+        ScratchImage& image) noexcept;
+    bool Convert(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        VkFormat format, ConvertOptions options, ScratchImage& result) noexcept;
+    bool Convert(
+        const ImageSetView& srcImages, VkFormat format, ConvertOptions options,
+        ScratchImage& result) noexcept;
+
+    // Mipmap generation
+    bool GenerateMipMaps(
+        const Image& baseImage, TEX_FILTER_FLAGS filter, size_t levels,
+        ScratchImage& mipChain) noexcept;
+    bool GenerateMipMaps(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        TEX_FILTER_FLAGS filter, size_t levels, ScratchImage& mipChain) noexcept;
+    bool GenerateMipMaps(
+        const ImageSetView& srcImages, TEX_FILTER_FLAGS filter, size_t levels,
+        ScratchImage& mipChain) noexcept;
+
+    bool GenerateMipMaps3D(
+        const Image* baseImages, size_t depth, TEX_FILTER_FLAGS filter, size_t levels,
+        ScratchImage& mipChain) noexcept;
+    bool GenerateMipMaps3D(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        TEX_FILTER_FLAGS filter, size_t levels, ScratchImage& mipChain) noexcept;
+    bool GenerateMipMaps3D(
+        const ImageSetView& srcImages, TEX_FILTER_FLAGS filter, size_t levels,
+        ScratchImage& mipChain) noexcept;
+
+    // Image resize
+    // Only the top level of each item/slice is resized, the result has a single mip level.
+    // TEX_FILTER_FANT (BOX) averages when shrinking and interpolates linearly when enlarging.
+    bool Resize(
+        const Image& srcImage, size_t width, size_t height,
+        TEX_FILTER_FLAGS filter, ScratchImage& image) noexcept;
+    bool Resize(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        size_t width, size_t height, TEX_FILTER_FLAGS filter, ScratchImage& result) noexcept;
+    bool Resize(
+        const ImageSetView& srcImages, size_t width, size_t height,
+        TEX_FILTER_FLAGS filter, ScratchImage& result) noexcept;
+
+    // Cubemap utilities
+    // Faces are in Vulkan order (+X, -X, +Y, -Y, +Z, -Z). Cross layouts have -X +Z +X (-Z) across the
+    // middle with +Y above and -Y below +Z; the vertical cross keeps -Z under -Y, rotated 180 degrees.
+    // Strips hold the faces in order, left to right / top to bottom.
+    enum CUBE_LAYOUT : uint32_t
+    {
+        CUBE_LAYOUT_HORIZONTAL_CROSS = 0,   // 4 x 3 faces
+        CUBE_LAYOUT_VERTICAL_CROSS,         // 3 x 4 faces
+        CUBE_LAYOUT_HORIZONTAL_STRIP,       // 6 x 1 faces
+        CUBE_LAYOUT_VERTICAL_STRIP,         // 1 x 6 faces
+    };
+
+    bool UnpackCubeLayout(const Image& srcImage, CUBE_LAYOUT layout, ScratchImage& cube) noexcept;
+
+    // Concatenates cubemaps / cube arrays (same format, face size and mip count) into one cube array
+    bool AssembleCubeArray(const ImageSetView* cubes, size_t nCubes, ScratchImage& result) noexcept;
+
+    // Equirectangular (+Z at the horizontal center, +Y up) <-> cubemap reprojection.
+    // TEX_FILTER_POINT takes the nearest texel, other modes sample bilinearly; sRGB and alpha weighting
+    // follow the TEX_FILTER_* flags as in Resize. CubeToEquirect reads the top mip of the first cube.
+    bool EquirectToCube(const Image& srcImage, size_t faceSize, TEX_FILTER_FLAGS filter, ScratchImage& cube) noexcept;
+    bool CubeToEquirect(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        size_t width, size_t height, TEX_FILTER_FLAGS filter, ScratchImage& image) noexcept;
+    bool CubeToEquirect(
+        const ImageSetView& srcImages, size_t width, size_t height,
+        TEX_FILTER_FLAGS filter, ScratchImage& image) noexcept;
+
+    // Image-based lighting, both read the top mip of the first cube (sRGB sources are linearized).
+    // PrefilterCubemapGGX convolves the radiance with the GGX lobe (N = V = R): mip m of the result holds
+    // roughness m / (mipLevels - 1), so mip 0 is the source itself. Every mip uses a fixed table of
+    // sampleCount importance samples (0 selects 512) read from a box-filtered chain of the source at the
+    // level matching each sample's solid angle. mipLevels 0 selects the full chain; the result keeps the
+    // source face size and is ready for SaveToDDSFile with format VK_FORMAT_R16G16B16A16_SFLOAT.
+    bool PrefilterCubemapGGX(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        size_t mipLevels, size_t sampleCount, VkFormat format, ScratchImage& cube) noexcept;
+    bool PrefilterCubemapGGX(
+        const ImageSetView& srcImages,
+        size_t mipLevels, size_t sampleCount, VkFormat format, ScratchImage& cube) noexcept;
+
+    // Order-2 spherical harmonics of the irradiance, coefficients receives 9 RGB triplets (27 floats) with
+    // E(n) = c0 + c1 y + c2 z + c3 x + c4 xy + c5 yz + c6 (3z^2 - 1) + c7 xz + c8 (x^2 - y^2)
+    // for the unit normal n = (x, y, z). Lambertian exit radiance is albedo * E(n) / pi.
+    bool ComputeIrradianceSH(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata, float* coefficients) noexcept;
+    bool ComputeIrradianceSH(const ImageSetView& srcImages, float* coefficients) noexcept;
+
+    // Alpha premultiplication
+    // Color channels are multiplied by (or divided by) alpha, texels with zero alpha keep their color
+    // when unpremultiplying. The result's alpha mode is set to PREMULTIPLIED / STRAIGHT; inputs already
+    // marked with that mode are rejected. Formats need an alpha channel and a scanline kernel.
+    bool PremultiplyAlpha(const Image& srcImage, TEX_PMALPHA_FLAGS flags, ScratchImage& image) noexcept;
+    bool PremultiplyAlpha(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        TEX_PMALPHA_FLAGS flags, ScratchImage& result) noexcept;
+    bool PremultiplyAlpha(const ImageSetView& srcImages, TEX_PMALPHA_FLAGS flags, ScratchImage& result) noexcept;
+
+    bool UnpremultiplyAlpha(const Image& srcImage, TEX_PMALPHA_FLAGS flags, ScratchImage& image) noexcept;
+    bool UnpremultiplyAlpha(
+        const Image* srcImages, size_t nimages, const TexMetadata& metadata,
+        TEX_PMALPHA_FLAGS flags, ScratchImage& result) noexcept;
+    bool UnpremultiplyAlpha(const ImageSetView& srcImages, TEX_PMALPHA_FLAGS flags, ScratchImage& result) noexcept;
+
+    // Image comparison
+    // Block-compressed inputs are decompressed first (only ASTC is supported).
+    // mseV (optional, 4 floats) receives the per-channel error, PSNR uses a peak value of 1.0,
+    // SSIM is the mean of 8x8 windows (stride 4) over the compared channels.
+    bool ComputeMSE(
+        const Image& image1, const Image& image2,
+        float& mse, float* mseV, CMSE_FLAGS flags = CMSE_DEFAULT) noexcept;
+    bool ComputeMSE(
+        const ImageSetView& image1, const ImageSetView& image2,
+        float& mse, float* mseV, CMSE_FLAGS flags = CMSE_DEFAULT) noexcept;
+
+    bool ComputePSNR(
+        const Image& image1, const Image& image2,
+        float& psnr, CMSE_FLAGS flags = CMSE_DEFAULT) noexcept;
+    bool ComputePSNR(
+        const ImageSetView& image1, const ImageSetView& image2,
+        float& psnr, CMSE_FLAGS flags = CMSE_DEFAULT) noexcept;
+
+    bool ComputeSSIM(
+        const Image& image1, const Image& image2,
+        float& ssim, CMSE_FLAGS flags = CMSE_DEFAULT) noexcept;
+    bool ComputeSSIM(
+        const ImageSetView& image1, const ImageSetView& image2,
+        float& ssim, CMSE_FLAGS flags = CMSE_DEFAULT) noexcept;
+
+    // Content hashing
+    // Only the ComputeScanlines rows of the image are hashed (pitch padding is ignored),
+    // the format and dimensions are mixed in so equal bytes with a different layout differ.
+    bool ComputeContentHash(const Image& image, ContentHash& hash) noexcept;
+    bool ComputeContentHash64(const Image& image, uint64_t& hash) noexcept;
+
+    // Delta capture reconstruction (files[0] must be a base, followed by its deltas in save order)
+    bool LoadFromDeltaFiles(const char* const* files, size_t count, ScratchImage& image) noexcept;
+    bool SaveDeltasToDDSFile(
+        const char* const* files, size_t count,
+        DDS_FLAGS flags, const char* szFile) noexcept;
+
+    // Texture decompression
+    // ASTC LDR/HDR to R8G8B8A8_UNORM/SRGB, R16G16B16A16_SFLOAT or R32G32B32A32_SFLOAT
+    // (VK_FORMAT_UNDEFINED picks RGBA8 for LDR and RGBA16F for HDR footprints)
+    bool Decompress(const Image& cImage, VkFormat format, ScratchImage& image) noexcept;
+    bool Decompress(
+        const Image* cImages, size_t nimages, const TexMetadata& metadata,
+        VkFormat format, ScratchImage& images) noexcept;
+    bool Decompress(const ImageSetView& cImages, VkFormat format, ScratchImage& images) noexcept;
+
     // Image helper functions
     bool DetermineImageArray(
         const TexMetadata& metadata, CP_FLAGS cpFlags,
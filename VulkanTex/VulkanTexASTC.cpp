@@ -0,0 +1,1793 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr size_t   ASTC_BLOCK_BYTES      = 16;
+    constexpr uint32_t ASTC_MAX_TEXELS       = 144;
+    constexpr uint32_t ASTC_MAX_WEIGHTS      = 64;
+    constexpr uint32_t ASTC_MIN_WEIGHT_BITS  = 24;
+    constexpr uint32_t ASTC_MAX_WEIGHT_BITS  = 96;
+    constexpr uint32_t ASTC_MAX_COLOR_INTS   = 18;
+    constexpr uint32_t ASTC_PARTITION_SEEDS  = 1024;
+    constexpr uint32_t ASTC_BLOCK_MODES      = 2048;
+    constexpr uint32_t ASTC_GRID_DIMS        = 11; // Weight grid dimensions range over 2..12
+
+    // Quantization levels used by the integer sequence encoding (ISE)
+    enum QUANT_METHOD : uint8_t
+    {
+        QUANT_2 = 0, QUANT_3, QUANT_4, QUANT_5, QUANT_6, QUANT_8, QUANT_10, QUANT_12,
+        QUANT_16, QUANT_20, QUANT_24, QUANT_32, QUANT_40, QUANT_48, QUANT_64, QUANT_80,
+        QUANT_96, QUANT_128, QUANT_160, QUANT_192, QUANT_256,
+        QUANT_COUNT
+    };
+
+    struct ISERange
+    {
+        uint8_t bits;
+        uint8_t trits;
+        uint8_t quints;
+    };
+
+    constexpr ISERange c_iseRanges[QUANT_COUNT] =
+    {
+        { 1, 0, 0 }, { 0, 1, 0 }, { 2, 0, 0 }, { 0, 0, 1 }, { 1, 1, 0 }, { 3, 0, 0 }, { 1, 0, 1 },
+        { 2, 1, 0 }, { 4, 0, 0 }, { 2, 0, 1 }, { 3, 1, 0 }, { 5, 0, 0 }, { 3, 0, 1 }, { 4, 1, 0 },
+        { 6, 0, 0 }, { 4, 0, 1 }, { 5, 1, 0 }, { 7, 0, 0 }, { 5, 0, 1 }, { 6, 1, 0 }, { 8, 0, 0 },
+    };
+
+    constexpr uint32_t ISESequenceBitCount(uint32_t count, uint32_t quant) noexcept
+    {
+        const ISERange& range = c_iseRanges[quant];
+        uint32_t bits = count * range.bits;
+
+        if (range.trits)
+            bits += (count * 8 + 4) / 5;
+        else if (range.quints)
+            bits += (count * 7 + 2) / 3;
+
+        return bits;
+    }
+
+    // Bit patterns used to build the 'B' term of trit/quint unquantization (MSB first, 'a' is bit 0 of the value)
+    struct UnquantPattern
+    {
+        uint8_t     quant;
+        const char* pattern;
+        uint16_t    c;
+    };
+
+    constexpr UnquantPattern c_colorPatterns[] =
+    {
+        { QUANT_6,   "000000000", 204 },
+        { QUANT_10,  "000000000", 113 },
+        { QUANT_12,  "b000b0bb0", 93 },
+        { QUANT_20,  "b0000bb00", 54 },
+        { QUANT_24,  "cb000cbcb", 44 },
+        { QUANT_40,  "cb0000cbc", 26 },
+        { QUANT_48,  "dcb000dcb", 22 },
+        { QUANT_80,  "dcb0000dc", 13 },
+        { QUANT_96,  "edcb000ed", 11 },
+        { QUANT_160, "edcb0000e", 6 },
+        { QUANT_192, "fedcb000f", 5 },
+    };
+
+    constexpr UnquantPattern c_weightPatterns[] =
+    {
+        { QUANT_6,  "0000000", 50 },
+        { QUANT_10, "0000000", 28 },
+        { QUANT_12, "b000b0b", 23 },
+        { QUANT_20, "b0000b0", 13 },
+        { QUANT_24, "cb000cb", 11 },
+    };
+
+    uint32_t ReplicateBits(uint32_t value, uint32_t fromBits, uint32_t toBits) noexcept
+    {
+        if (!fromBits)
+            return 0;
+
+        uint32_t result = 0;
+        int      shift  = static_cast<int>(toBits);
+
+        while (shift > 0)
+        {
+            shift -= static_cast<int>(fromBits);
+            result |= (shift >= 0) ? (value << shift) : (value >> -shift);
+        }
+
+        return result & ((1u << toBits) - 1u);
+    }
+
+    uint32_t PatternToB(const char* pattern, uint32_t value) noexcept
+    {
+        uint32_t result = 0;
+
+        for (const char* p = pattern; *p; ++p)
+        {
+            result <<= 1;
+
+            if (*p != '0')
+                result |= (value >> (*p - 'a')) & 1u;
+        }
+
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Footprint independent tables, built once
+    //---------------------------------------------------------------------------------
+    struct GlobalTables
+    {
+        uint8_t tritDecode[256][5];
+        uint8_t quintDecode[128][3];
+        uint8_t colorUnquant[QUANT_COUNT][256];
+        uint8_t weightUnquant[QUANT_32 + 1][32];
+        int8_t  colorQuantMode[ASTC_MAX_COLOR_INTS / 2 + 1][129]; // [integer pairs][available bits]
+
+        GlobalTables() noexcept
+        {
+            for (uint32_t t = 0; t < 256; ++t)
+            {
+                uint32_t c, t0, t1, t2, t3, t4;
+
+                if (((t >> 2) & 7) == 7)
+                {
+                    c  = (((t >> 5) & 7) << 2) | (t & 3);
+                    t4 = t3 = 2;
+                }
+                else
+                {
+                    c = t & 0x1F;
+
+                    if (((t >> 5) & 3) == 3)
+                    {
+                        t4 = 2;
+                        t3 = (t >> 7) & 1;
+                    }
+                    else
+                    {
+                        t4 = (t >> 7) & 1;
+                        t3 = (t >> 5) & 3;
+                    }
+                }
+
+                if ((c & 3) == 3)
+                {
+                    t2 = 2;
+                    t1 = (c >> 4) & 1;
+                    t0 = (((c >> 3) & 1) << 1) | (((c >> 2) & 1) & ~((c >> 3) & 1));
+                }
+                else if (((c >> 2) & 3) == 3)
+                {
+                    t2 = t1 = 2;
+                    t0 = c & 3;
+                }
+                else
+                {
+                    t2 = (c >> 4) & 1;
+                    t1 = (c >> 2) & 3;
+                    t0 = (((c >> 1) & 1) << 1) | ((c & 1) & ~((c >> 1) & 1));
+                }
+
+                tritDecode[t][0] = static_cast<uint8_t>(t0);
+                tritDecode[t][1] = static_cast<uint8_t>(t1);
+                tritDecode[t][2] = static_cast<uint8_t>(t2);
+                tritDecode[t][3] = static_cast<uint8_t>(t3);
+                tritDecode[t][4] = static_cast<uint8_t>(t4);
+            }
+
+            for (uint32_t q = 0; q < 128; ++q)
+            {
+                uint32_t q0, q1, q2;
+
+                if ((((q >> 1) & 3) == 3) && (((q >> 5) & 3) == 0))
+                {
+                    const uint32_t q0b = q & 1;
+                    q2 = (q0b << 2) | ((((q >> 4) & 1) & ~q0b) << 1) | (((q >> 3) & 1) & ~q0b);
+                    q1 = q0 = 4;
+                }
+                else
+                {
+                    uint32_t c;
+
+                    if (((q >> 1) & 3) == 3)
+                    {
+                        q2 = 4;
+                        c  = (((q >> 3) & 3) << 3) | ((~(q >> 5) & 3) << 1) | (q & 1);
+                    }
+                    else
+                    {
+                        q2 = (q >> 5) & 3;
+                        c  = q & 0x1F;
+                    }
+
+                    if ((c & 7) == 5)
+                    {
+                        q1 = 4;
+                        q0 = (c >> 3) & 3;
+                    }
+                    else
+                    {
+                        q1 = (c >> 3) & 3;
+                        q0 = c & 7;
+                    }
+                }
+
+                quintDecode[q][0] = static_cast<uint8_t>(q0);
+                quintDecode[q][1] = static_cast<uint8_t>(q1);
+                quintDecode[q][2] = static_cast<uint8_t>(q2);
+            }
+
+            // Color endpoint unquantization to 0..255
+            memset(colorUnquant, 0, sizeof(colorUnquant));
+
+            for (uint32_t quant = 0; quant < QUANT_COUNT; ++quant)
+            {
+                const ISERange& range = c_iseRanges[quant];
+
+                if (!range.trits && !range.quints)
+                {
+                    for (uint32_t v = 0; v < (1u << range.bits); ++v)
+                    {
+                        colorUnquant[quant][v] = static_cast<uint8_t>(ReplicateBits(v, range.bits, 8));
+                    }
+                }
+            }
+
+            for (const auto& entry : c_colorPatterns)
+            {
+                const ISERange& range  = c_iseRanges[entry.quant];
+                const uint32_t  levels = (range.trits ? 3u : 5u) << range.bits;
+
+                for (uint32_t v = 0; v < levels; ++v)
+                {
+                    const uint32_t d = v >> range.bits;
+                    const uint32_t a = (v & 1) ? 0x1FFu : 0u;
+                    const uint32_t b = PatternToB(entry.pattern, v);
+
+                    uint32_t t = (d * entry.c + b) ^ a;
+                    t = (a & 0x80) | (t >> 2);
+
+                    colorUnquant[entry.quant][v] = static_cast<uint8_t>(t);
+                }
+            }
+
+            // Weight unquantization to 0..64
+            memset(weightUnquant, 0, sizeof(weightUnquant));
+
+            for (uint32_t quant = 0; quant <= QUANT_32; ++quant)
+            {
+                const ISERange& range = c_iseRanges[quant];
+
+                if (!range.trits && !range.quints)
+                {
+                    for (uint32_t v = 0; v < (1u << range.bits); ++v)
+                    {
+                        uint32_t w = ReplicateBits(v, range.bits, 6);
+                        weightUnquant[quant][v] = static_cast<uint8_t>((w > 32) ? w + 1 : w);
+                    }
+                }
+            }
+
+            for (uint32_t v = 0; v < 3; ++v)
+                weightUnquant[QUANT_3][v] = static_cast<uint8_t>(v * 32);
+
+            for (uint32_t v = 0; v < 5; ++v)
+                weightUnquant[QUANT_5][v] = static_cast<uint8_t>(v * 16);
+
+            for (const auto& entry : c_weightPatterns)
+            {
+                const ISERange& range  = c_iseRanges[entry.quant];
+                const uint32_t  levels = (range.trits ? 3u : 5u) << range.bits;
+
+                for (uint32_t v = 0; v < levels; ++v)
+                {
+                    const uint32_t d = v >> range.bits;
+                    const uint32_t a = (v & 1) ? 0x7Fu : 0u;
+                    const uint32_t b = PatternToB(entry.pattern, v);
+
+                    uint32_t t = (d * entry.c + b) ^ a;
+                    t = (a & 0x20) | (t >> 2);
+
+                    weightUnquant[entry.quant][v] = static_cast<uint8_t>((t > 32) ? t + 1 : t);
+                }
+            }
+
+            // Highest color quantization that fits the remaining bits
+            for (uint32_t pairs = 0; pairs <= ASTC_MAX_COLOR_INTS / 2; ++pairs)
+            {
+                for (uint32_t bits = 0; bits <= 128; ++bits)
+                {
+                    int8_t mode = -1;
+
+                    if (pairs > 0)
+                    {
+                        for (int quant = QUANT_256; quant >= QUANT_6; --quant)
+                        {
+                            if (ISESequenceBitCount(pairs * 2, static_cast<uint32_t>(quant)) <= bits)
+                            {
+                                mode = static_cast<int8_t>(quant);
+                                break;
+                            }
+                        }
+                    }
+
+                    colorQuantMode[pairs][bits] = mode;
+                }
+            }
+        }
+    };
+
+    const GlobalTables& GetGlobalTables() noexcept
+    {
+        static const GlobalTables s_tables;
+        return s_tables;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Per-footprint tables: decoded block modes, weight infill and partition assignment
+    //---------------------------------------------------------------------------------
+    struct BlockModeInfo
+    {
+        uint8_t valid;
+        uint8_t xWeights;
+        uint8_t yWeights;
+        uint8_t dualPlane;
+        uint8_t weightQuant;
+        uint8_t weightBits;
+    };
+
+    // Bilinear weight infill for one texel: four grid indices and their 1/16th weights
+    struct InfillTexel
+    {
+        uint8_t index[4];
+        uint8_t weight[4];
+    };
+
+    struct FootprintTables
+    {
+        uint32_t                       blockWidth;
+        uint32_t                       blockHeight;
+        uint32_t                       texelCount;
+        BlockModeInfo                  modes[ASTC_BLOCK_MODES];
+        std::unique_ptr<InfillTexel[]> infill[ASTC_GRID_DIMS * ASTC_GRID_DIMS];
+        std::unique_ptr<uint8_t[]>     partitions; // [partitionCount - 2][seed][texel]
+
+        const InfillTexel* GetInfill(uint32_t xWeights, uint32_t yWeights) const noexcept
+        {
+            return infill[(xWeights - 2) * ASTC_GRID_DIMS + (yWeights - 2)].get();
+        }
+
+        const uint8_t* GetPartitions(uint32_t partitionCount, uint32_t seed) const noexcept
+        {
+            return partitions.get() + (size_t((partitionCount - 2) * ASTC_PARTITION_SEEDS + seed) * texelCount);
+        }
+    };
+
+    bool DecodeBlockMode(uint32_t blockMode, uint32_t blockWidth, uint32_t blockHeight, BlockModeInfo& info) noexcept
+    {
+        memset(&info, 0, sizeof(info));
+
+        uint32_t baseQuant = (blockMode >> 4) & 1;
+        uint32_t h         = (blockMode >> 9) & 1;
+        uint32_t d         = (blockMode >> 10) & 1;
+        const uint32_t a   = (blockMode >> 5) & 3;
+        uint32_t xWeights  = 0;
+        uint32_t yWeights  = 0;
+
+        if ((blockMode & 3) != 0)
+        {
+            baseQuant |= (blockMode & 3) << 1;
+            uint32_t b = (blockMode >> 7) & 3;
+
+            switch ((blockMode >> 2) & 3)
+            {
+                case 0:  xWeights = b + 4; yWeights = a + 2; break;
+                case 1:  xWeights = b + 8; yWeights = a + 2; break;
+                case 2:  xWeights = a + 2; yWeights = b + 8; break;
+                default:
+                    b &= 1;
+                    if (blockMode & 0x100)
+                    {
+                        xWeights = b + 2;
+                        yWeights = a + 2;
+                    }
+                    else
+                    {
+                        xWeights = a + 2;
+                        yWeights = b + 6;
+                    }
+                    break;
+            }
+        }
+        else
+        {
+            baseQuant |= ((blockMode >> 2) & 3) << 1;
+
+            if (((blockMode >> 2) & 3) == 0)
+                return false;
+
+            const uint32_t b = (blockMode >> 9) & 3;
+
+            switch ((blockMode >> 7) & 3)
+            {
+                case 0:  xWeights = 12;    yWeights = a + 2; break;
+                case 1:  xWeights = a + 2; yWeights = 12;    break;
+                case 2:
+                    xWeights = a + 6;
+                    yWeights = b + 6;
+                    d = h = 0;
+                    break;
+                default:
+                    if (a == 0)
+                    {
+                        xWeights = 6;
+                        yWeights = 10;
+                    }
+                    else if (a == 1)
+                    {
+                        xWeights = 10;
+                        yWeights = 6;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                    break;
+            }
+        }
+
+        if ((xWeights > blockWidth) || (yWeights > blockHeight))
+            return false;
+
+        const uint32_t weightCount = xWeights * yWeights * (d + 1);
+        const uint32_t quant       = (baseQuant - 2) + 6 * h;
+
+        if ((weightCount > ASTC_MAX_WEIGHTS) || (quant > QUANT_32))
+            return false;
+
+        const uint32_t weightBits = ISESequenceBitCount(weightCount, quant);
+
+        if ((weightBits < ASTC_MIN_WEIGHT_BITS) || (weightBits > ASTC_MAX_WEIGHT_BITS))
+            return false;
+
+        info.valid       = 1;
+        info.xWeights    = static_cast<uint8_t>(xWeights);
+        info.yWeights    = static_cast<uint8_t>(yWeights);
+        info.dualPlane   = static_cast<uint8_t>(d);
+        info.weightQuant = static_cast<uint8_t>(quant);
+        info.weightBits  = static_cast<uint8_t>(weightBits);
+
+        return true;
+    }
+
+    uint32_t Hash52(uint32_t p) noexcept
+    {
+        p ^= p >> 15;
+        p -= p << 17;
+        p += p << 7;
+        p += p << 4;
+        p ^= p >> 5;
+        p += p << 16;
+        p ^= p >> 7;
+        p ^= p >> 3;
+        p ^= p << 6;
+        p ^= p >> 17;
+        return p;
+    }
+
+    uint32_t SelectPartition(uint32_t seed, uint32_t x, uint32_t y, uint32_t partitionCount, bool smallBlock) noexcept
+    {
+        if (smallBlock)
+        {
+            x <<= 1;
+            y <<= 1;
+        }
+
+        seed += (partitionCount - 1) * 1024;
+
+        const uint32_t rnum = Hash52(seed);
+
+        uint8_t seeds[8];
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            seeds[i] = static_cast<uint8_t>((rnum >> (i * 4)) & 0xF);
+            seeds[i] = static_cast<uint8_t>(seeds[i] * seeds[i]);
+        }
+
+        uint32_t sh1, sh2;
+        if (seed & 1)
+        {
+            sh1 = (seed & 2) ? 4 : 5;
+            sh2 = (partitionCount == 3) ? 6 : 5;
+        }
+        else
+        {
+            sh1 = (partitionCount == 3) ? 6 : 5;
+            sh2 = (seed & 2) ? 4 : 5;
+        }
+
+        // The z terms of the 3D hash drop out for 2D footprints
+        uint32_t a = (uint32_t(seeds[0] >> sh1) * x + uint32_t(seeds[1] >> sh2) * y + (rnum >> 14)) & 0x3F;
+        uint32_t b = (uint32_t(seeds[2] >> sh1) * x + uint32_t(seeds[3] >> sh2) * y + (rnum >> 10)) & 0x3F;
+        uint32_t c = (uint32_t(seeds[4] >> sh1) * x + uint32_t(seeds[5] >> sh2) * y + (rnum >> 6)) & 0x3F;
+        uint32_t d = (uint32_t(seeds[6] >> sh1) * x + uint32_t(seeds[7] >> sh2) * y + (rnum >> 2)) & 0x3F;
+
+        if (partitionCount < 4)
+            d = 0;
+
+        if (partitionCount < 3)
+            c = 0;
+
+        if ((a >= b) && (a >= c) && (a >= d))
+            return 0;
+        else if ((b >= c) && (b >= d))
+            return 1;
+        else if (c >= d)
+            return 2;
+
+        return 3;
+    }
+
+    bool BuildInfill(uint32_t blockWidth, uint32_t blockHeight, uint32_t xWeights, uint32_t yWeights, InfillTexel* texels) noexcept
+    {
+        const uint32_t ds = (1024 + blockWidth / 2) / (blockWidth - 1);
+        const uint32_t dt = (1024 + blockHeight / 2) / (blockHeight - 1);
+        const uint32_t gridCount = xWeights * yWeights;
+
+        for (uint32_t t = 0; t < blockHeight; ++t)
+        {
+            for (uint32_t s = 0; s < blockWidth; ++s)
+            {
+                const uint32_t gs = (ds * s * (xWeights - 1) + 32) >> 6;
+                const uint32_t gt = (dt * t * (yWeights - 1) + 32) >> 6;
+                const uint32_t fs = gs & 0xF;
+                const uint32_t ft = gt & 0xF;
+                const uint32_t v0 = (gs >> 4) + (gt >> 4) * xWeights;
+
+                const uint32_t w11 = (fs * ft + 8) >> 4;
+                const uint32_t w10 = ft - w11;
+                const uint32_t w01 = fs - w11;
+                const uint32_t w00 = 16 - fs - ft + w11;
+
+                // Taps past the grid edge always carry a zero weight, clamp them to stay in bounds
+                auto clampIndex = [gridCount, v0](uint32_t index) noexcept
+                {
+                    return static_cast<uint8_t>((index < gridCount) ? index : v0);
+                };
+
+                InfillTexel& texel = texels[t * blockWidth + s];
+                texel.index[0]  = static_cast<uint8_t>(v0);
+                texel.index[1]  = clampIndex(v0 + 1);
+                texel.index[2]  = clampIndex(v0 + xWeights);
+                texel.index[3]  = clampIndex(v0 + xWeights + 1);
+                texel.weight[0] = static_cast<uint8_t>(w00);
+                texel.weight[1] = static_cast<uint8_t>(w01);
+                texel.weight[2] = static_cast<uint8_t>(w10);
+                texel.weight[3] = static_cast<uint8_t>(w11);
+            }
+        }
+
+        return true;
+    }
+
+    bool BuildFootprint(FootprintTables& tables, uint32_t blockWidth, uint32_t blockHeight) noexcept
+    {
+        tables.blockWidth  = blockWidth;
+        tables.blockHeight = blockHeight;
+        tables.texelCount  = blockWidth * blockHeight;
+
+        for (uint32_t mode = 0; mode < ASTC_BLOCK_MODES; ++mode)
+        {
+            BlockModeInfo& info = tables.modes[mode];
+
+            if (!DecodeBlockMode(mode, blockWidth, blockHeight, info))
+                continue;
+
+            auto& infill = tables.infill[(info.xWeights - 2) * ASTC_GRID_DIMS + (info.yWeights - 2)];
+
+            if (!infill)
+            {
+                infill.reset(new (std::nothrow) InfillTexel[tables.texelCount]);
+
+                if (!infill)
+                    return false;
+
+                BuildInfill(blockWidth, blockHeight, info.xWeights, info.yWeights, infill.get());
+            }
+        }
+
+        const size_t partitionSize = size_t(3) * ASTC_PARTITION_SEEDS * tables.texelCount;
+        tables.partitions.reset(new (std::nothrow) uint8_t[partitionSize]);
+
+        if (!tables.partitions)
+            return false;
+
+        const bool smallBlock = (tables.texelCount < 31);
+        uint8_t*   dest       = tables.partitions.get();
+
+        for (uint32_t partitionCount = 2; partitionCount <= 4; ++partitionCount)
+        {
+            for (uint32_t seed = 0; seed < ASTC_PARTITION_SEEDS; ++seed)
+            {
+                for (uint32_t y = 0; y < blockHeight; ++y)
+                {
+                    for (uint32_t x = 0; x < blockWidth; ++x)
+                    {
+                        *dest++ = static_cast<uint8_t>(SelectPartition(seed, x, y, partitionCount, smallBlock));
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const FootprintTables* GetFootprintTables(uint32_t blockWidth, uint32_t blockHeight) noexcept
+    {
+        // Footprints range over 4..12 in each dimension
+        constexpr uint32_t c_slots = 9;
+
+        static std::once_flag                   s_once[c_slots * c_slots];
+        static std::unique_ptr<FootprintTables> s_tables[c_slots * c_slots];
+
+        if ((blockWidth < 4) || (blockWidth > 12) || (blockHeight < 4) || (blockHeight > 12))
+            return nullptr;
+
+        const uint32_t slot = (blockWidth - 4) * c_slots + (blockHeight - 4);
+
+        std::call_once(s_once[slot], [&]() noexcept
+        {
+            std::unique_ptr<FootprintTables> tables(new (std::nothrow) FootprintTables());
+
+            if (tables && BuildFootprint(*tables, blockWidth, blockHeight))
+            {
+                s_tables[slot] = std::move(tables);
+            }
+        });
+
+        return s_tables[slot].get();
+    }
+
+    //---------------------------------------------------------------------------------
+    // Bit access on a 128-bit block
+    //---------------------------------------------------------------------------------
+    struct Bits128
+    {
+        uint64_t lo;
+        uint64_t hi;
+
+        uint32_t Read(uint32_t offset, uint32_t count) const noexcept
+        {
+            if (!count || (offset >= 128))
+                return 0;
+
+            uint64_t value;
+
+            if (offset >= 64)
+                value = hi >> (offset - 64);
+            else if (offset == 0)
+                value = lo;
+            else
+                value = (lo >> offset) | (hi << (64 - offset));
+
+            return static_cast<uint32_t>(value & ((uint64_t(1) << count) - 1u));
+        }
+
+        // Clears every bit at or above 'offset'
+        Bits128 MaskAbove(uint32_t offset) const noexcept
+        {
+            Bits128 result = *this;
+
+            if (offset < 64)
+            {
+                result.lo &= (offset) ? ((uint64_t(1) << offset) - 1u) : 0u;
+                result.hi  = 0;
+            }
+            else if (offset < 128)
+            {
+                result.hi &= (offset > 64) ? ((uint64_t(1) << (offset - 64)) - 1u) : 0u;
+            }
+
+            return result;
+        }
+    };
+
+    uint64_t ReverseBits64(uint64_t v) noexcept
+    {
+        v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+        v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+        v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+        v = ((v >> 8) & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+        v = ((v >> 16) & 0x0000FFFF0000FFFFull) | ((v & 0x0000FFFF0000FFFFull) << 16);
+        return (v >> 32) | (v << 32);
+    }
+
+    void DecodeISE(
+        const GlobalTables& gt,
+        const Bits128& block, uint32_t offset,
+        uint32_t quant, uint32_t count,
+        uint8_t* output) noexcept
+    {
+        const ISERange& range = c_iseRanges[quant];
+        const uint32_t  b     = range.bits;
+
+        // Trailing trit/quint bits of a partial group are implicitly zero
+        const Bits128 bits = block.MaskAbove(offset + ISESequenceBitCount(count, quant));
+
+        if (range.trits)
+        {
+            for (uint32_t i = 0; i < count; i += 5)
+            {
+                uint32_t m[5];
+                uint32_t t = 0;
+
+                m[0] = bits.Read(offset, b); offset += b;
+                t |= bits.Read(offset, 2);   offset += 2;
+                m[1] = bits.Read(offset, b); offset += b;
+                t |= bits.Read(offset, 2) << 2; offset += 2;
+                m[2] = bits.Read(offset, b); offset += b;
+                t |= bits.Read(offset, 1) << 4; offset += 1;
+                m[3] = bits.Read(offset, b); offset += b;
+                t |= bits.Read(offset, 2) << 5; offset += 2;
+                m[4] = bits.Read(offset, b); offset += b;
+                t |= bits.Read(offset, 1) << 7; offset += 1;
+
+                for (uint32_t j = 0; (j < 5) && (i + j < count); ++j)
+                {
+                    output[i + j] = static_cast<uint8_t>((gt.tritDecode[t][j] << b) | m[j]);
+                }
+            }
+        }
+        else if (range.quints)
+        {
+            for (uint32_t i = 0; i < count; i += 3)
+            {
+                uint32_t m[3];
+                uint32_t q = 0;
+
+                m[0] = bits.Read(offset, b); offset += b;
+                q |= bits.Read(offset, 3);   offset += 3;
+                m[1] = bits.Read(offset, b); offset += b;
+                q |= bits.Read(offset, 2) << 3; offset += 2;
+                m[2] = bits.Read(offset, b); offset += b;
+                q |= bits.Read(offset, 2) << 5; offset += 2;
+
+                for (uint32_t j = 0; (j < 3) && (i + j < count); ++j)
+                {
+                    output[i + j] = static_cast<uint8_t>((gt.quintDecode[q][j] << b) | m[j]);
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                output[i] = static_cast<uint8_t>(bits.Read(offset, b));
+                offset += b;
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Color endpoint decoding
+    //---------------------------------------------------------------------------------
+    inline int ClampInt(int v, int low, int high) noexcept
+    {
+        return (v < low) ? low : ((v > high) ? high : v);
+    }
+
+    inline void BitTransferSigned(int& a, int& b) noexcept
+    {
+        b >>= 1;
+        b |= a & 0x80;
+        a >>= 1;
+        a &= 0x3F;
+
+        if (a & 0x20)
+            a -= 0x40;
+    }
+
+    inline void BlueContract(int& r, int& g, int b) noexcept
+    {
+        r = (r + b) >> 1;
+        g = (g + b) >> 1;
+    }
+
+    void HDRRGBOUnpack(const int* v, int e0[4], int e1[4]) noexcept
+    {
+        const int modeval = ((v[0] & 0xC0) >> 6) | (((v[1] & 0x80) >> 7) << 2) | (((v[2] & 0x80) >> 7) << 3);
+
+        int majcomp, mode;
+
+        if ((modeval & 0xC) != 0xC)
+        {
+            majcomp = modeval >> 2;
+            mode    = modeval & 3;
+        }
+        else if (modeval != 0xF)
+        {
+            majcomp = modeval & 3;
+            mode    = 4;
+        }
+        else
+        {
+            majcomp = 0;
+            mode    = 5;
+        }
+
+        int red   = v[0] & 0x3F;
+        int green = v[1] & 0x1F;
+        int blue  = v[2] & 0x1F;
+        int scale = v[3] & 0x1F;
+
+        const int bit0 = (v[1] >> 6) & 1;
+        const int bit1 = (v[1] >> 5) & 1;
+        const int bit2 = (v[2] >> 6) & 1;
+        const int bit3 = (v[2] >> 5) & 1;
+        const int bit4 = (v[3] >> 7) & 1;
+        const int bit5 = (v[3] >> 6) & 1;
+        const int bit6 = (v[3] >> 5) & 1;
+
+        const int oh = 1 << mode;
+
+        if (oh & 0x30) green |= bit0 << 6;
+        if (oh & 0x3A) green |= bit1 << 5;
+        if (oh & 0x30) blue  |= bit2 << 6;
+        if (oh & 0x3A) blue  |= bit3 << 5;
+
+        if (oh & 0x3D) scale |= bit6 << 5;
+        if (oh & 0x2D) scale |= bit5 << 6;
+        if (oh & 0x04) scale |= bit4 << 7;
+
+        if (oh & 0x3B) red |= bit4 << 6;
+        if (oh & 0x04) red |= bit3 << 6;
+        if (oh & 0x10) red |= bit5 << 7;
+        if (oh & 0x0F) red |= bit2 << 7;
+        if (oh & 0x05) red |= bit1 << 8;
+        if (oh & 0x0A) red |= bit0 << 8;
+        if (oh & 0x05) red |= bit0 << 9;
+        if (oh & 0x02) red |= bit6 << 9;
+        if (oh & 0x01) red |= bit3 << 10;
+        if (oh & 0x02) red |= bit5 << 10;
+
+        static constexpr int c_shift[6] = { 1, 1, 2, 3, 4, 5 };
+        const int shift = c_shift[mode];
+
+        red   <<= shift;
+        green <<= shift;
+        blue  <<= shift;
+        scale <<= shift;
+
+        if (mode != 5)
+        {
+            green = red - green;
+            blue  = red - blue;
+        }
+
+        if (majcomp == 1)
+            std::swap(red, green);
+        else if (majcomp == 2)
+            std::swap(red, blue);
+
+        e1[0] = std::max(red, 0) << 4;
+        e1[1] = std::max(green, 0) << 4;
+        e1[2] = std::max(blue, 0) << 4;
+        e0[0] = std::max(red - scale, 0) << 4;
+        e0[1] = std::max(green - scale, 0) << 4;
+        e0[2] = std::max(blue - scale, 0) << 4;
+        e0[3] = e1[3] = 0x7800;
+    }
+
+    void HDRRGBUnpack(const int* v, int e0[4], int e1[4]) noexcept
+    {
+        const int modeval = ((v[1] & 0x80) >> 7) | (((v[2] & 0x80) >> 7) << 1) | (((v[3] & 0x80) >> 7) << 2);
+        const int majcomp = ((v[4] & 0x80) >> 7) | (((v[5] & 0x80) >> 7) << 1);
+
+        e0[3] = e1[3] = 0x7800;
+
+        if (majcomp == 3)
+        {
+            e0[0] = v[0] << 8;
+            e0[1] = v[2] << 8;
+            e0[2] = (v[4] & 0x7F) << 9;
+            e1[0] = v[1] << 8;
+            e1[1] = v[3] << 8;
+            e1[2] = (v[5] & 0x7F) << 9;
+            return;
+        }
+
+        int a  = v[0] | ((v[1] & 0x40) << 2);
+        int b0 = v[2] & 0x3F;
+        int b1 = v[3] & 0x3F;
+        int c  = v[1] & 0x3F;
+        int d0 = v[4] & 0x7F;
+        int d1 = v[5] & 0x7F;
+
+        static constexpr int c_dbits[8] = { 7, 6, 7, 6, 5, 6, 5, 6 };
+        const int dbits = c_dbits[modeval];
+
+        const int bit0 = (v[2] >> 6) & 1;
+        const int bit1 = (v[3] >> 6) & 1;
+        const int bit2 = (v[4] >> 6) & 1;
+        const int bit3 = (v[5] >> 6) & 1;
+        const int bit4 = (v[4] >> 5) & 1;
+        const int bit5 = (v[5] >> 5) & 1;
+
+        const int oh = 1 << modeval;
+
+        if (oh & 0xA4) a |= bit0 << 9;
+        if (oh & 0x08) a |= bit2 << 9;
+        if (oh & 0x50) a |= bit4 << 9;
+        if (oh & 0x50) a |= bit5 << 10;
+        if (oh & 0xA0) a |= bit1 << 10;
+        if (oh & 0xC0) a |= bit2 << 11;
+
+        if (oh & 0x04) c |= bit1 << 6;
+        if (oh & 0xE8) c |= bit3 << 6;
+        if (oh & 0x20) c |= bit2 << 7;
+
+        if (oh & 0x5B)
+        {
+            b0 |= bit0 << 6;
+            b1 |= bit1 << 6;
+        }
+
+        if (oh & 0x12)
+        {
+            b0 |= bit2 << 7;
+            b1 |= bit3 << 7;
+        }
+
+        if (oh & 0xAF)
+        {
+            d0 |= bit4 << 5;
+            d1 |= bit5 << 5;
+        }
+
+        if (oh & 0x05)
+        {
+            d0 |= bit2 << 6;
+            d1 |= bit3 << 6;
+        }
+
+        // Sign-extend the 'd' terms
+        const int signBit = 1 << (dbits - 1);
+        d0 = (d0 & (signBit - 1)) - (d0 & signBit);
+        d1 = (d1 & (signBit - 1)) - (d1 & signBit);
+
+        const int shift = (modeval >> 1) ^ 3;
+        a  *= 1 << shift;
+        b0 *= 1 << shift;
+        b1 *= 1 << shift;
+        c  *= 1 << shift;
+        d0 *= 1 << shift;
+        d1 *= 1 << shift;
+
+        int red1   = ClampInt(a, 0, 0xFFF);
+        int green1 = ClampInt(a - b0, 0, 0xFFF);
+        int blue1  = ClampInt(a - b1, 0, 0xFFF);
+        int red0   = ClampInt(a - c, 0, 0xFFF);
+        int green0 = ClampInt(a - b0 - c - d0, 0, 0xFFF);
+        int blue0  = ClampInt(a - b1 - c - d1, 0, 0xFFF);
+
+        if (majcomp == 1)
+        {
+            std::swap(red0, green0);
+            std::swap(red1, green1);
+        }
+        else if (majcomp == 2)
+        {
+            std::swap(red0, blue0);
+            std::swap(red1, blue1);
+        }
+
+        e0[0] = red0 << 4;
+        e0[1] = green0 << 4;
+        e0[2] = blue0 << 4;
+        e1[0] = red1 << 4;
+        e1[1] = green1 << 4;
+        e1[2] = blue1 << 4;
+    }
+
+    void HDRAlphaUnpack(int v6, int v7, int& a0, int& a1) noexcept
+    {
+        const int selector = ((v6 >> 7) & 1) | ((v7 >> 6) & 2);
+        v6 &= 0x7F;
+        v7 &= 0x7F;
+
+        if (selector == 3)
+        {
+            a0 = v6 << 5;
+            a1 = v7 << 5;
+        }
+        else
+        {
+            v6 |= (v7 << (selector + 1)) & 0x780;
+            v7 &= (0x3F >> selector);
+            v7 ^= 32 >> selector;
+            v7 -= 32 >> selector;
+            v6 <<= (4 - selector);
+            v7 <<= (4 - selector);
+            v7 += v6;
+
+            a0 = v6;
+            a1 = ClampInt(v7, 0, 0xFFF);
+        }
+
+        a0 <<= 4;
+        a1 <<= 4;
+    }
+
+    // Decodes one endpoint pair into the 16-bit interpolation domain.
+    // lnsMask gets a bit per component that holds an HDR (logarithmic) value.
+    bool DecodeEndpoints(
+        uint32_t cem, const int* v,
+        bool srgb, bool hdrProfile,
+        int e0[4], int e1[4], uint32_t& lnsMask) noexcept
+    {
+        int l0[4] = { 0, 0, 0, 0xFF };
+        int l1[4] = { 0, 0, 0, 0xFF };
+        lnsMask = 0;
+
+        switch (cem)
+        {
+            case 0:
+                l0[0] = l0[1] = l0[2] = v[0];
+                l1[0] = l1[1] = l1[2] = v[1];
+                break;
+
+            case 1:
+            {
+                const int lum0 = (v[0] >> 2) | (v[1] & 0xC0);
+                const int lum1 = std::min(lum0 + (v[1] & 0x3F), 0xFF);
+                l0[0] = l0[1] = l0[2] = lum0;
+                l1[0] = l1[1] = l1[2] = lum1;
+                break;
+            }
+
+            case 4:
+                l0[0] = l0[1] = l0[2] = v[0];
+                l1[0] = l1[1] = l1[2] = v[1];
+                l0[3] = v[2];
+                l1[3] = v[3];
+                break;
+
+            case 5:
+            {
+                int v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+                BitTransferSigned(v1, v0);
+                BitTransferSigned(v3, v2);
+                l0[0] = l0[1] = l0[2] = v0;
+                l1[0] = l1[1] = l1[2] = ClampInt(v0 + v1, 0, 0xFF);
+                l0[3] = v2;
+                l1[3] = ClampInt(v2 + v3, 0, 0xFF);
+                break;
+            }
+
+            case 6:
+            case 10:
+                l0[0] = (v[0] * v[3]) >> 8;
+                l0[1] = (v[1] * v[3]) >> 8;
+                l0[2] = (v[2] * v[3]) >> 8;
+                l1[0] = v[0];
+                l1[1] = v[1];
+                l1[2] = v[2];
+
+                if (cem == 10)
+                {
+                    l0[3] = v[4];
+                    l1[3] = v[5];
+                }
+                break;
+
+            case 8:
+            case 12:
+            {
+                const int s0 = v[0] + v[2] + v[4];
+                const int s1 = v[1] + v[3] + v[5];
+
+                if (cem == 12)
+                {
+                    l0[3] = v[6];
+                    l1[3] = v[7];
+                }
+
+                if (s1 >= s0)
+                {
+                    l0[0] = v[0]; l0[1] = v[2]; l0[2] = v[4];
+                    l1[0] = v[1]; l1[1] = v[3]; l1[2] = v[5];
+                }
+                else
+                {
+                    l0[0] = v[1]; l0[1] = v[3]; l0[2] = v[5];
+                    l1[0] = v[0]; l1[1] = v[2]; l1[2] = v[4];
+                    BlueContract(l0[0], l0[1], l0[2]);
+                    BlueContract(l1[0], l1[1], l1[2]);
+                    std::swap(l0[3], l1[3]);
+                }
+                break;
+            }
+
+            case 9:
+            case 13:
+            {
+                int w[8];
+                for (uint32_t i = 0; i < 8; ++i)
+                    w[i] = (i < 6 || cem == 13) ? v[i] : 0;
+
+                BitTransferSigned(w[1], w[0]);
+                BitTransferSigned(w[3], w[2]);
+                BitTransferSigned(w[5], w[4]);
+
+                if (cem == 13)
+                {
+                    BitTransferSigned(w[7], w[6]);
+                    l0[3] = w[6];
+                    l1[3] = w[6] + w[7];
+                }
+
+                if (w[1] + w[3] + w[5] >= 0)
+                {
+                    l0[0] = w[0];        l0[1] = w[2];        l0[2] = w[4];
+                    l1[0] = w[0] + w[1]; l1[1] = w[2] + w[3]; l1[2] = w[4] + w[5];
+                }
+                else
+                {
+                    l0[0] = w[0] + w[1]; l0[1] = w[2] + w[3]; l0[2] = w[4] + w[5];
+                    l1[0] = w[0];        l1[1] = w[2];        l1[2] = w[4];
+                    BlueContract(l0[0], l0[1], l0[2]);
+                    BlueContract(l1[0], l1[1], l1[2]);
+                    std::swap(l0[3], l1[3]);
+                }
+
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    l0[c] = ClampInt(l0[c], 0, 0xFF);
+                    l1[c] = ClampInt(l1[c], 0, 0xFF);
+                }
+                break;
+            }
+
+            case 2:
+            case 3:
+            {
+                if (!hdrProfile)
+                    return false;
+
+                int y0, y1;
+
+                if (cem == 2)
+                {
+                    if (v[1] >= v[0])
+                    {
+                        y0 = v[0] << 4;
+                        y1 = v[1] << 4;
+                    }
+                    else
+                    {
+                        y0 = (v[1] << 4) + 8;
+                        y1 = (v[0] << 4) - 8;
+                    }
+                }
+                else
+                {
+                    if (v[0] & 0x80)
+                    {
+                        y0 = ((v[1] & 0xE0) << 4) | ((v[0] & 0x7F) << 2);
+                        y1 = (v[1] & 0x1F) << 2;
+                    }
+                    else
+                    {
+                        y0 = ((v[1] & 0xF0) << 4) | ((v[0] & 0x7F) << 1);
+                        y1 = (v[1] & 0x0F) << 1;
+                    }
+
+                    y1 = std::min(y1 + y0, 0xFFF);
+                }
+
+                e0[0] = e0[1] = e0[2] = y0 << 4;
+                e1[0] = e1[1] = e1[2] = y1 << 4;
+                e0[3] = e1[3] = 0x7800;
+                lnsMask = 0xF;
+                return true;
+            }
+
+            case 7:
+                if (!hdrProfile)
+                    return false;
+
+                HDRRGBOUnpack(v, e0, e1);
+                lnsMask = 0xF;
+                return true;
+
+            case 11:
+            case 14:
+            case 15:
+                if (!hdrProfile)
+                    return false;
+
+                HDRRGBUnpack(v, e0, e1);
+                lnsMask = 0xF;
+
+                if (cem == 14)
+                {
+                    // LDR alpha alongside HDR color
+                    e0[3] = v[6] * 257;
+                    e1[3] = v[7] * 257;
+                    lnsMask = 0x7;
+                }
+                else if (cem == 15)
+                {
+                    HDRAlphaUnpack(v[6], v[7], e0[3], e1[3]);
+                }
+                return true;
+
+            default:
+                return false;
+        }
+
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            if (srgb)
+            {
+                e0[c] = (l0[c] << 8) | 0x80;
+                e1[c] = (l1[c] << 8) | 0x80;
+            }
+            else
+            {
+                e0[c] = l0[c] * 257;
+                e1[c] = l1[c] * 257;
+            }
+        }
+
+        return true;
+    }
+
+    // Logarithmic HDR interpolation result to FP16 bits
+    inline uint16_t LNSToHalf(uint32_t p) noexcept
+    {
+        const uint32_t mc = p & 0x7FF;
+        const uint32_t ec = p >> 11;
+        uint32_t mt;
+
+        if (mc < 512)
+            mt = 3 * mc;
+        else if (mc < 1536)
+            mt = 4 * mc - 512;
+        else
+            mt = 5 * mc - 2048;
+
+        const uint32_t result = (ec << 10) | (mt >> 3);
+        return static_cast<uint16_t>(std::min<uint32_t>(result, 0x7BFF));
+    }
+
+    //---------------------------------------------------------------------------------
+    // Block decode
+    //---------------------------------------------------------------------------------
+
+    // Decoded texels are UNORM16, or FP16 bits where the matching bit in 'halfMask' is set
+    struct DecodedBlock
+    {
+        uint16_t texels[ASTC_MAX_TEXELS][4];
+        uint8_t  halfMask[ASTC_MAX_TEXELS];
+    };
+
+    void FillErrorBlock(const FootprintTables& fp, DecodedBlock& out) noexcept
+    {
+        for (uint32_t i = 0; i < fp.texelCount; ++i)
+        {
+            out.texels[i][0] = 0xFFFF;
+            out.texels[i][1] = 0;
+            out.texels[i][2] = 0xFFFF;
+            out.texels[i][3] = 0xFFFF;
+            out.halfMask[i]  = 0;
+        }
+    }
+
+    void DecodeBlock(
+        const GlobalTables& gt,
+        const FootprintTables& fp,
+        const uint8_t* pBlock,
+        bool srgb, bool hdrProfile,
+        DecodedBlock& out) noexcept
+    {
+        Bits128 block;
+        memcpy(&block.lo, pBlock, sizeof(uint64_t));
+        memcpy(&block.hi, pBlock + sizeof(uint64_t), sizeof(uint64_t));
+
+        const uint32_t blockMode = block.Read(0, 11);
+
+        //--- Void-extent (constant color) block
+        if ((blockMode & 0x1FF) == 0x1FC)
+        {
+            const bool hdrVoid = (blockMode & 0x200) != 0;
+
+            if ((block.Read(10, 2) != 3) || (hdrVoid && !hdrProfile))
+            {
+                FillErrorBlock(fp, out);
+                return;
+            }
+
+            uint16_t color[4];
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                color[c] = static_cast<uint16_t>(block.Read(64 + c * 16, 16));
+            }
+
+            for (uint32_t i = 0; i < fp.texelCount; ++i)
+            {
+                memcpy(out.texels[i], color, sizeof(color));
+                out.halfMask[i] = hdrVoid ? 0xF : 0;
+            }
+            return;
+        }
+
+        const BlockModeInfo& mode = fp.modes[blockMode];
+        if (!mode.valid)
+        {
+            FillErrorBlock(fp, out);
+            return;
+        }
+
+        const uint32_t partitionCount = block.Read(11, 2) + 1;
+        if ((partitionCount == 4) && mode.dualPlane)
+        {
+            FillErrorBlock(fp, out);
+            return;
+        }
+
+        //--- Color endpoint modes
+        uint32_t cems[4]           = {};
+        uint32_t belowWeights      = 128 - mode.weightBits;
+        uint32_t extraCEMBits      = 0;
+        uint32_t partitionIndex    = 0;
+
+        if (partitionCount == 1)
+        {
+            cems[0] = block.Read(13, 4);
+        }
+        else
+        {
+            partitionIndex = block.Read(13, 10);
+
+            const uint32_t selector = block.Read(23, 2);
+
+            if (selector == 0)
+            {
+                const uint32_t shared = block.Read(25, 4);
+                for (uint32_t p = 0; p < partitionCount; ++p)
+                    cems[p] = shared;
+            }
+            else
+            {
+                extraCEMBits = 3 * partitionCount - 4;
+                belowWeights -= extraCEMBits;
+
+                const uint32_t encoded = block.Read(23, 6) | (block.Read(belowWeights, extraCEMBits) << 6);
+                const uint32_t baseClass = selector - 1;
+
+                uint32_t bitPos = 2;
+                for (uint32_t p = 0; p < partitionCount; ++p, ++bitPos)
+                {
+                    cems[p] = (((encoded >> bitPos) & 1) + baseClass) << 2;
+                }
+
+                for (uint32_t p = 0; p < partitionCount; ++p, bitPos += 2)
+                {
+                    cems[p] |= (encoded >> bitPos) & 3;
+                }
+            }
+        }
+
+        uint32_t colorIntegers = 0;
+        for (uint32_t p = 0; p < partitionCount; ++p)
+        {
+            colorIntegers += ((cems[p] >> 2) + 1) * 2;
+        }
+
+        if (colorIntegers > ASTC_MAX_COLOR_INTS)
+        {
+            FillErrorBlock(fp, out);
+            return;
+        }
+
+        const uint32_t colorStart = (partitionCount == 1) ? 17 : 29;
+        int colorBits = static_cast<int>(belowWeights) - static_cast<int>(colorStart);
+
+        if (mode.dualPlane)
+            colorBits -= 2;
+
+        if (colorBits < 0)
+            colorBits = 0;
+
+        const int colorQuant = gt.colorQuantMode[colorIntegers >> 1][colorBits];
+        if (colorQuant < QUANT_6)
+        {
+            FillErrorBlock(fp, out);
+            return;
+        }
+
+        uint8_t colorValues[ASTC_MAX_COLOR_INTS];
+        DecodeISE(gt, block, colorStart, static_cast<uint32_t>(colorQuant), colorIntegers, colorValues);
+
+        int      endpoints[4][2][4];
+        uint32_t lnsMasks[4] = {};
+        {
+            uint32_t valueIndex = 0;
+
+            for (uint32_t p = 0; p < partitionCount; ++p)
+            {
+                int values[8] = {};
+                const uint32_t count = ((cems[p] >> 2) + 1) * 2;
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    values[i] = gt.colorUnquant[colorQuant][colorValues[valueIndex++]];
+                }
+
+                if (!DecodeEndpoints(cems[p], values, srgb, hdrProfile, endpoints[p][0], endpoints[p][1], lnsMasks[p]))
+                {
+                    FillErrorBlock(fp, out);
+                    return;
+                }
+            }
+        }
+
+        //--- Weights, stored bit-reversed from the top of the block
+        const Bits128 reversed = { ReverseBits64(block.hi), ReverseBits64(block.lo) };
+        const uint32_t gridCount   = uint32_t(mode.xWeights) * mode.yWeights;
+        const uint32_t weightCount = gridCount * (mode.dualPlane ? 2u : 1u);
+
+        uint8_t rawWeights[ASTC_MAX_WEIGHTS];
+        DecodeISE(gt, reversed, 0, mode.weightQuant, weightCount, rawWeights);
+
+        uint8_t planeWeights[2][ASTC_MAX_WEIGHTS];
+        const uint8_t* unquant = gt.weightUnquant[mode.weightQuant];
+
+        if (mode.dualPlane)
+        {
+            for (uint32_t i = 0; i < gridCount; ++i)
+            {
+                planeWeights[0][i] = unquant[rawWeights[2 * i]];
+                planeWeights[1][i] = unquant[rawWeights[2 * i + 1]];
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < gridCount; ++i)
+            {
+                planeWeights[0][i] = unquant[rawWeights[i]];
+            }
+        }
+
+        const uint32_t ccs = mode.dualPlane ? block.Read(belowWeights - 2, 2) : 4u;
+
+        const InfillTexel* infill     = fp.GetInfill(mode.xWeights, mode.yWeights);
+        const uint8_t*     partitions = (partitionCount > 1) ? fp.GetPartitions(partitionCount, partitionIndex) : nullptr;
+
+        //--- Interpolate each texel
+        for (uint32_t i = 0; i < fp.texelCount; ++i)
+        {
+            const InfillTexel& it = infill[i];
+
+            uint32_t w[2];
+            for (uint32_t plane = 0; plane < (mode.dualPlane ? 2u : 1u); ++plane)
+            {
+                const uint8_t* pw = planeWeights[plane];
+                w[plane] = (uint32_t(pw[it.index[0]]) * it.weight[0] +
+                            uint32_t(pw[it.index[1]]) * it.weight[1] +
+                            uint32_t(pw[it.index[2]]) * it.weight[2] +
+                            uint32_t(pw[it.index[3]]) * it.weight[3] + 8) >> 4;
+            }
+
+            const uint32_t p = partitions ? partitions[i] : 0;
+            uint8_t mask = 0;
+
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                const uint32_t weight = (c == ccs) ? w[1] : w[0];
+                const uint32_t value  = (uint32_t(endpoints[p][0][c]) * (64 - weight) +
+                                         uint32_t(endpoints[p][1][c]) * weight + 32) >> 6;
+
+                if (lnsMasks[p] & (1u << c))
+                {
+                    out.texels[i][c] = LNSToHalf(value);
+                    mask |= static_cast<uint8_t>(1u << c);
+                }
+                else
+                {
+                    out.texels[i][c] = static_cast<uint16_t>(value);
+                }
+            }
+
+            out.halfMask[i] = mask;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Writes decoded texels into the destination format
+    //---------------------------------------------------------------------------------
+    inline float TexelToFloat(uint16_t value, bool isHalf) noexcept
+    {
+        return isHalf ? HalfToFloat(value) : (float(value) * (1.f / 65535.f));
+    }
+
+    void StoreTexelRow(
+        const DecodedBlock& block, uint32_t first, size_t count,
+        VkFormat format, uint8_t* pDest) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                for (size_t x = 0; x < count; ++x)
+                {
+                    const uint16_t* texel = block.texels[first + x];
+                    const uint8_t   mask  = block.halfMask[first + x];
+
+                    for (uint32_t c = 0; c < 4; ++c)
+                    {
+                        if (mask & (1u << c))
+                        {
+                            const float f = HalfToFloat(texel[c]);
+                            pDest[x * 4 + c] = (f > 0.f) ? static_cast<uint8_t>(std::min(f, 1.f) * 255.f + 0.5f) : 0;
+                        }
+                        else
+                        {
+                            pDest[x * 4 + c] = static_cast<uint8_t>(texel[c] >> 8);
+                        }
+                    }
+                }
+                break;
+
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+            {
+                auto dest = reinterpret_cast<uint16_t*>(pDest);
+
+                for (size_t x = 0; x < count; ++x)
+                {
+                    const uint16_t* texel = block.texels[first + x];
+                    const uint8_t   mask  = block.halfMask[first + x];
+
+                    for (uint32_t c = 0; c < 4; ++c)
+                    {
+                        dest[x * 4 + c] = (mask & (1u << c)) ? texel[c] : FloatToHalf(float(texel[c]) * (1.f / 65535.f));
+                    }
+                }
+                break;
+            }
+
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+            {
+                auto dest = reinterpret_cast<float*>(pDest);
+
+                for (size_t x = 0; x < count; ++x)
+                {
+                    const uint16_t* texel = block.texels[first + x];
+                    const uint8_t   mask  = block.halfMask[first + x];
+
+                    for (uint32_t c = 0; c < 4; ++c)
+                    {
+                        dest[x * 4 + c] = TexelToFloat(texel[c], (mask & (1u << c)) != 0);
+                    }
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    bool IsSupportedDecodeTarget(VkFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    // Decodes a band of block rows [blockRowBegin, blockRowEnd) of one image
+    void DecodeASTCRows(
+        const Image& cImage, const Image& image,
+        const FootprintTables& fp,
+        size_t blockRowBegin, size_t blockRowEnd) noexcept
+    {
+        const GlobalTables& gt = GetGlobalTables();
+
+        const bool srgb       = IsSRGB(cImage.format);
+        const bool hdrProfile = IsASTCHDR(cImage.format);
+        const size_t blocksX  = std::max<size_t>(1, (cImage.width + fp.blockWidth - 1) / fp.blockWidth);
+        const size_t bpp      = BitsPerPixel(image.format) / 8;
+
+        DecodedBlock decoded;
+
+        for (size_t by = blockRowBegin; by < blockRowEnd; ++by)
+        {
+            const uint8_t* pSrc = cImage.pixels + by * cImage.rowPitch;
+            const size_t   y0   = by * fp.blockHeight;
+            const size_t   rows = std::min<size_t>(fp.blockHeight, image.height - y0);
+
+            for (size_t bx = 0; bx < blocksX; ++bx, pSrc += ASTC_BLOCK_BYTES)
+            {
+                DecodeBlock(gt, fp, pSrc, srgb, hdrProfile, decoded);
+
+                const size_t x0      = bx * fp.blockWidth;
+                const size_t columns = std::min<size_t>(fp.blockWidth, image.width - x0);
+
+                for (size_t ty = 0; ty < rows; ++ty)
+                {
+                    uint8_t* pDest = image.pixels + (y0 + ty) * image.rowPitch + x0 * bpp;
+                    StoreTexelRow(decoded, static_cast<uint32_t>(ty * fp.blockWidth), columns, image.format, pDest);
+                }
+            }
+        }
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Decompression
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Decompress(
+    const Image& cImage,
+    VkFormat format,
+    ScratchImage& image) noexcept
+{
+    TexMetadata mdata = {};
+    mdata.width     = cImage.width;
+    mdata.height    = cImage.height;
+    mdata.depth     = 1;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = cImage.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    return Decompress(&cImage, 1, mdata, format, image);
+}
+
+bool VulkanTex::Decompress(
+    const ImageSetView& cImages,
+    VkFormat format,
+    ScratchImage& images) noexcept
+{
+    return Decompress(cImages.images, cImages.nimages, cImages.metadata, format, images);
+}
+
+bool VulkanTex::Decompress(
+    const Image* cImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    VkFormat format,
+    ScratchImage& images) noexcept
+{
+    if (!cImages || !nimages)
+        return false;
+
+    size_t blockWidth  = 0;
+    size_t blockHeight = 0;
+
+    if (!GetASTCBlockSize(metadata.format, blockWidth, blockHeight))
+        return false;
+
+    if (format == VK_FORMAT_UNDEFINED)
+    {
+        // Pick a default decompressed format based on ASTC profile
+        if (IsASTCHDR(metadata.format))
+            format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        else if (IsSRGB(metadata.format))
+            format = VK_FORMAT_R8G8B8A8_SRGB;
+        else
+            format = VK_FORMAT_R8G8B8A8_UNORM;
+    }
+
+    if (!IsSupportedDecodeTarget(format))
+        return false;
+
+    const FootprintTables* fp = GetFootprintTables(static_cast<uint32_t>(blockWidth), static_cast<uint32_t>(blockHeight));
+    if (!fp)
+        return false;
+
+    TexMetadata mdata2 = metadata;
+    mdata2.format = format;
+
+    bool hr = images.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    if (nimages != images.GetImageCount())
+    {
+        images.Release();
+        return false;
+    }
+
+    const Image* dest = images.GetImages();
+    if (!dest)
+    {
+        images.Release();
+        return false;
+    }
+
+    // Flatten every block row of every image into one work list
+    std::vector<size_t> rowStart;
+
+    try
+    {
+        rowStart.resize(nimages + 1);
+    }
+    catch (...)
+    {
+        images.Release();
+        return false;
+    }
+
+    rowStart[0] = 0;
+
+    for (size_t index = 0; index < nimages; ++index)
+    {
+        const Image& src = cImages[index];
+
+        if ((src.format != metadata.format) || !src.pixels)
+        {
+            images.Release();
+            return false;
+        }
+
+        if ((src.width != dest[index].width) || (src.height != dest[index].height))
+        {
+            images.Release();
+            return false;
+        }
+
+        size_t rowPitch   = 0;
+        size_t slicePitch = 0;
+
+        if (!ComputePitch(src.format, src.width, src.height, rowPitch, slicePitch) ||
+            (src.rowPitch < rowPitch))
+        {
+            images.Release();
+            return false;
+        }
+
+        rowStart[index + 1] = rowStart[index] + ComputeScanlines(src.format, src.height);
+    }
+
+    ParallelFor(rowStart[nimages], 4, [&](size_t begin, size_t end) noexcept
+    {
+        // Locate the image holding 'begin', then walk forward
+        size_t index = static_cast<size_t>(std::upper_bound(rowStart.begin(), rowStart.end(), begin) - rowStart.begin()) - 1;
+
+        while (begin < end)
+        {
+            const size_t last = std::min(end, rowStart[index + 1]);
+
+            DecodeASTCRows(cImages[index], dest[index], *fp, begin - rowStart[index], last - rowStart[index]);
+
+            begin = last;
+            ++index;
+        }
+    });
+
+    return true;
+}
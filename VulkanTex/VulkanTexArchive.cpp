@@ -0,0 +1,805 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+#if _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr uint32_t c_archiveMagic   = 0x52415456; // "VTAR"
+    constexpr uint32_t c_archiveVersion = 1;
+
+    // Entry payloads (and the index) start on a page boundary for direct I/O and mapping,
+    // subresources inside an entry are 16-byte aligned
+    constexpr uint64_t c_payloadAlignment     = 4096;
+    constexpr uint64_t c_subresourceAlignment = 16;
+
+    constexpr uint32_t c_maxBucketBits = 24;
+
+#pragma pack(push, 1)
+    struct ARCHIVE_HEADER
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t bucketBits;
+        uint64_t subresourceCount;
+        uint64_t bucketOffset;      // (1 << bucketBits) + 1 uint32_t, first entry of every bucket
+        uint64_t entryOffset;       // ARCHIVE_ENTRY[entryCount], sorted by hash then name
+        uint64_t subresourceOffset; // uint64_t[subresourceCount], absolute offsets
+        uint64_t stringOffset;      // NUL-terminated names
+        uint64_t stringSize;
+        uint64_t fileSize;
+        uint64_t reserved;
+    };
+
+    struct ARCHIVE_ENTRY
+    {
+        uint64_t hash;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+        uint32_t arraySize;
+        uint32_t mipLevels;
+        uint32_t miscFlags;
+        uint32_t miscFlags2;
+        uint32_t format;
+        uint32_t dimension;
+        uint32_t firstSubresource;
+        uint32_t subresourceCount;
+        uint32_t reserved;
+        uint64_t payloadOffset;
+        uint64_t payloadSize;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(ARCHIVE_HEADER) == 80, "Archive header size mismatch");
+    static_assert(sizeof(ARCHIVE_ENTRY) == 80, "Archive entry size mismatch");
+
+    inline uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // FNV-1a with a final avalanche so the top bits (used for buckets) are well mixed
+    uint64_t HashName(const char* name, size_t length) noexcept
+    {
+        uint64_t h = 0xCBF29CE484222325ull;
+        for (size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint8_t>(name[i]);
+            h *= 0x100000001B3ull;
+        }
+
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    inline size_t GetBucket(uint64_t hash, uint32_t bucketBits) noexcept
+    {
+        return bucketBits ? static_cast<size_t>(hash >> (64 - bucketBits)) : 0u;
+    }
+
+    bool GetSubresourceSize(const Image& image, size_t& rowPitch, size_t& slicePitch) noexcept
+    {
+        return ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE)
+            && (rowPitch <= image.rowPitch);
+    }
+
+    TexMetadata GetEntryMetadata(const ARCHIVE_ENTRY& entry) noexcept
+    {
+        TexMetadata metadata = {};
+        metadata.width      = entry.width;
+        metadata.height     = entry.height;
+        metadata.depth      = entry.depth;
+        metadata.arraySize  = entry.arraySize;
+        metadata.mipLevels  = entry.mipLevels;
+        metadata.miscFlags  = entry.miscFlags;
+        metadata.miscFlags2 = entry.miscFlags2;
+        metadata.format     = static_cast<VkFormat>(entry.format);
+        metadata.dimension  = static_cast<TEX_DIMENSION>(entry.dimension);
+        return metadata;
+    }
+}
+
+
+//=====================================================================================
+// TextureArchiveWriter
+//=====================================================================================
+
+struct TextureArchiveWriter::Impl
+{
+    std::filesystem::path           path;
+    std::filesystem::path           tempPath;
+    std::ofstream                   file;
+    uint64_t                        offset;
+    std::vector<ARCHIVE_ENTRY>      entries;
+    std::vector<uint64_t>           subresources;
+    std::string                     strings;
+    std::unordered_set<std::string> names;
+};
+
+TextureArchiveWriter& TextureArchiveWriter::operator= (TextureArchiveWriter&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        Close();
+
+        m_impl = moveFrom.m_impl;
+        moveFrom.m_impl = nullptr;
+    }
+    return *this;
+}
+
+//-------------------------------------------------------------------------------------
+// Open / close
+//-------------------------------------------------------------------------------------
+bool TextureArchiveWriter::Open(const char* szFile) noexcept
+{
+    Close();
+
+    if (!szFile)
+        return false;
+
+    try
+    {
+        std::unique_ptr<Impl> impl(new Impl);
+        impl->path = std::filesystem::path(szFile);
+        impl->tempPath = impl->path;
+        impl->tempPath += ".tmp";
+
+        // The archive only appears under its final name once Finish wrote the index
+        impl->file.open(impl->tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!impl->file)
+            return false;
+
+        // Header page, rewritten by Finish
+        const std::vector<char> page(static_cast<size_t>(c_payloadAlignment), 0);
+        impl->file.write(page.data(), static_cast<std::streamsize>(page.size()));
+        if (!impl->file)
+            return false;
+
+        impl->offset = c_payloadAlignment;
+        m_impl = impl.release();
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void TextureArchiveWriter::Close() noexcept
+{
+    if (!m_impl)
+        return;
+
+    // Not finished, drop the partial archive
+    if (m_impl->file.is_open())
+    {
+        m_impl->file.close();
+
+        std::error_code ec;
+        std::filesystem::remove(m_impl->tempPath, ec);
+    }
+
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+size_t TextureArchiveWriter::GetEntryCount() const noexcept
+{
+    return m_impl ? m_impl->entries.size() : 0;
+}
+
+//-------------------------------------------------------------------------------------
+// Add a texture
+//-------------------------------------------------------------------------------------
+bool TextureArchiveWriter::Add(const char* name, const Image* images, size_t nimages, const TexMetadata& metadata) noexcept
+{
+    if (!m_impl || !name || !*name || !images || !nimages)
+        return false;
+
+    if ((metadata.width > UINT32_MAX) || (metadata.height > UINT32_MAX) || (metadata.depth > UINT32_MAX)
+        || (metadata.arraySize > UINT32_MAX) || (metadata.mipLevels > UINT32_MAX))
+        return false;
+
+    try
+    {
+        const size_t length = strlen(name);
+        if ((length > UINT32_MAX) || (m_impl->strings.size() + length + 1 > UINT32_MAX))
+            return false;
+
+        if (m_impl->names.count(std::string(name, length)))
+            return false;
+
+        // TextureArchive::Open applies the same checks to every entry
+        size_t expected = 0, pixelSize = 0;
+        if (!ValidateFileMetadata(metadata)
+            || !DetermineImageArray(metadata, CP_FLAGS_NONE, expected, pixelSize) || (nimages != expected))
+            return false;
+
+        ARCHIVE_ENTRY entry = {};
+        entry.hash             = HashName(name, length);
+        entry.nameOffset       = static_cast<uint32_t>(m_impl->strings.size());
+        entry.nameLength       = static_cast<uint32_t>(length);
+        entry.width            = static_cast<uint32_t>(metadata.width);
+        entry.height           = static_cast<uint32_t>(metadata.height);
+        entry.depth            = static_cast<uint32_t>(metadata.depth);
+        entry.arraySize        = static_cast<uint32_t>(metadata.arraySize);
+        entry.mipLevels        = static_cast<uint32_t>(metadata.mipLevels);
+        entry.miscFlags        = metadata.miscFlags;
+        entry.miscFlags2       = metadata.miscFlags2;
+        entry.format           = static_cast<uint32_t>(metadata.format);
+        entry.dimension        = static_cast<uint32_t>(metadata.dimension);
+        entry.firstSubresource = static_cast<uint32_t>(m_impl->subresources.size());
+        entry.subresourceCount = static_cast<uint32_t>(nimages);
+        entry.payloadOffset    = m_impl->offset;
+
+        // Validate everything before the first write, a rejected texture must leave the stream at m_impl->offset
+        std::vector<size_t> rowPitches(nimages);
+        for (size_t i = 0; i < nimages; ++i)
+        {
+            const Image& image = images[i];
+
+            size_t slicePitch;
+            if (!image.pixels || (image.format != metadata.format) || !GetSubresourceSize(image, rowPitches[i], slicePitch))
+                return false;
+        }
+
+        std::vector<uint64_t> offsets(nimages);
+        uint64_t offset = m_impl->offset;
+
+        std::ofstream& file = m_impl->file;
+        const char zeros[c_subresourceAlignment] = {};
+
+        for (size_t i = 0; i < nimages; ++i)
+        {
+            const Image& image = images[i];
+            const size_t rowPitch = rowPitches[i];
+
+            const uint64_t aligned = AlignUp(offset, c_subresourceAlignment);
+            file.write(zeros, static_cast<std::streamsize>(aligned - offset));
+            offsets[i] = aligned;
+
+            const size_t rows = ComputeScanlines(image.format, image.height);
+            const uint8_t* pSource = image.pixels;
+
+            if (image.rowPitch == rowPitch)
+            {
+                file.write(reinterpret_cast<const char*>(pSource), static_cast<std::streamsize>(rowPitch * rows));
+            }
+            else
+            {
+                for (size_t y = 0; y < rows; ++y, pSource += image.rowPitch)
+                {
+                    file.write(reinterpret_cast<const char*>(pSource), static_cast<std::streamsize>(rowPitch));
+                }
+            }
+
+            offset = aligned + rowPitch * rows;
+        }
+
+        entry.payloadSize = offset - entry.payloadOffset;
+
+        // Next payload starts on a fresh page
+        const uint64_t next = AlignUp(offset, c_payloadAlignment);
+        const std::vector<char> padding(static_cast<size_t>(next - offset), 0);
+        file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        if (!file)
+        {
+            // Rewind so the next texture lands where the index expects it
+            file.clear();
+            file.seekp(static_cast<std::streamoff>(m_impl->offset));
+            return false;
+        }
+
+        m_impl->offset = next;
+        m_impl->subresources.insert(m_impl->subresources.end(), offsets.begin(), offsets.end());
+        m_impl->strings.append(name, length);
+        m_impl->strings.push_back('\0');
+        m_impl->names.emplace(name, length);
+        m_impl->entries.push_back(entry);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool TextureArchiveWriter::Add(const char* name, const ImageSetView& images) noexcept
+{
+    return Add(name, images.images, images.nimages, images.metadata);
+}
+
+bool TextureArchiveWriter::Add(const char* name, const CapturedResourceInfo* capturedResourceInfo) noexcept
+{
+    if (!capturedResourceInfo)
+        return false;
+
+    try
+    {
+        TexMetadata metadata;
+        std::vector<Image> images;
+        if (!GetCapturedImages(*capturedResourceInfo, metadata, images))
+            return false;
+
+        return Add(name, images.data(), images.size(), metadata);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+//-------------------------------------------------------------------------------------
+// Write the index and publish the archive
+//-------------------------------------------------------------------------------------
+bool TextureArchiveWriter::Finish() noexcept
+{
+    if (!m_impl || !m_impl->file.is_open())
+        return false;
+
+    try
+    {
+        auto& entries = m_impl->entries;
+
+        std::sort(entries.begin(), entries.end(), [&](const ARCHIVE_ENTRY& a, const ARCHIVE_ENTRY& b)
+        {
+            if (a.hash != b.hash)
+                return a.hash < b.hash;
+
+            return strcmp(m_impl->strings.c_str() + a.nameOffset, m_impl->strings.c_str() + b.nameOffset) < 0;
+        });
+
+        // About one entry per bucket
+        const uint32_t bucketBits = std::min<uint32_t>(c_maxBucketBits,
+            static_cast<uint32_t>(std::bit_width(entries.size())));
+        const size_t bucketCount = size_t(1) << bucketBits;
+
+        std::vector<uint32_t> buckets(bucketCount + 1, 0);
+        size_t entry = 0;
+        for (size_t bucket = 0; bucket <= bucketCount; ++bucket)
+        {
+            while ((entry < entries.size()) && (GetBucket(entries[entry].hash, bucketBits) < bucket))
+                ++entry;
+
+            buckets[bucket] = static_cast<uint32_t>(entry);
+        }
+
+        ARCHIVE_HEADER header = {};
+        header.magic             = c_archiveMagic;
+        header.version           = c_archiveVersion;
+        header.entryCount        = static_cast<uint32_t>(entries.size());
+        header.bucketBits        = bucketBits;
+        header.subresourceCount  = m_impl->subresources.size();
+        header.bucketOffset      = m_impl->offset;
+        header.entryOffset       = AlignUp(header.bucketOffset + buckets.size() * sizeof(uint32_t), 8);
+        header.subresourceOffset = header.entryOffset + entries.size() * sizeof(ARCHIVE_ENTRY);
+        header.stringOffset      = header.subresourceOffset + m_impl->subresources.size() * sizeof(uint64_t);
+        header.stringSize        = m_impl->strings.size();
+        header.fileSize          = header.stringOffset + header.stringSize;
+
+        std::ofstream& file = m_impl->file;
+
+        const uint64_t padding = header.entryOffset - (header.bucketOffset + buckets.size() * sizeof(uint32_t));
+        const char zeros[8] = {};
+
+        file.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(uint32_t)));
+        file.write(zeros, static_cast<std::streamsize>(padding));
+        file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(ARCHIVE_ENTRY)));
+        file.write(reinterpret_cast<const char*>(m_impl->subresources.data()), static_cast<std::streamsize>(m_impl->subresources.size() * sizeof(uint64_t)));
+        file.write(m_impl->strings.data(), static_cast<std::streamsize>(m_impl->strings.size()));
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.close();
+
+        if (!file)
+            return false;
+
+        std::error_code ec;
+        std::filesystem::rename(m_impl->tempPath, m_impl->path, ec);
+        return !ec;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+
+//=====================================================================================
+// TextureArchive
+//=====================================================================================
+
+struct TextureArchive::Impl
+{
+    uint8_t*             data;
+    size_t               size;
+    ARCHIVE_HEADER       header;
+    const uint32_t*      buckets;
+    const ARCHIVE_ENTRY* entries;
+    const uint64_t*      subresources;
+    const char*          strings;
+
+#if _WIN32
+    HANDLE               file;
+    HANDLE               mapping;
+#endif
+
+    Impl() noexcept :
+        data(nullptr),
+        size(0),
+        header{},
+        buckets(nullptr),
+        entries(nullptr),
+        subresources(nullptr),
+        strings(nullptr)
+#if _WIN32
+        , file(INVALID_HANDLE_VALUE)
+        , mapping(nullptr)
+#endif
+    {
+    }
+
+    ~Impl()
+    {
+#if _WIN32
+        if (data)
+            UnmapViewOfFile(data);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+#else
+        if (data)
+            munmap(data, size);
+#endif
+    }
+
+    // Private copy-on-write mapping: Image views are writable without touching the file
+    bool Map(const std::filesystem::path& path) noexcept
+    {
+#if _WIN32
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart <= 0))
+            return false;
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (!mapping)
+            return false;
+
+        data = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return data != nullptr;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st = {};
+        if ((fstat(fd, &st) != 0) || (st.st_size <= 0))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (mapped == MAP_FAILED)
+            return false;
+
+        data = static_cast<uint8_t*>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+};
+
+TextureArchive& TextureArchive::operator= (TextureArchive&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        Close();
+
+        m_impl = moveFrom.m_impl;
+        moveFrom.m_impl = nullptr;
+    }
+    return *this;
+}
+
+//-------------------------------------------------------------------------------------
+// Open / close
+//-------------------------------------------------------------------------------------
+bool TextureArchive::Open(const char* szFile) noexcept
+{
+    Close();
+
+    if (!szFile)
+        return false;
+
+    try
+    {
+        std::unique_ptr<Impl> impl(new Impl);
+        if (!impl->Map(std::filesystem::path(szFile)) || (impl->size < sizeof(ARCHIVE_HEADER)))
+            return false;
+
+        ARCHIVE_HEADER& header = impl->header;
+        memcpy(&header, impl->data, sizeof(header));
+
+        if ((header.magic != c_archiveMagic) || (header.version != c_archiveVersion)
+            || (header.bucketBits > c_maxBucketBits) || (header.fileSize > impl->size))
+            return false;
+
+        const uint64_t bucketBytes = ((uint64_t(1) << header.bucketBits) + 1) * sizeof(uint32_t);
+        if ((header.bucketOffset > header.fileSize) || (bucketBytes > header.fileSize - header.bucketOffset)
+            || (header.entryOffset % 8) || (header.entryOffset < header.bucketOffset + bucketBytes)
+            || (header.entryOffset > header.fileSize)
+            || (uint64_t(header.entryCount) * sizeof(ARCHIVE_ENTRY) > header.fileSize - header.entryOffset)
+            || (header.subresourceOffset > header.fileSize)
+            || (header.subresourceCount > (header.fileSize - header.subresourceOffset) / sizeof(uint64_t))
+            || (header.stringOffset > header.fileSize) || (header.stringSize > header.fileSize - header.stringOffset)
+            || (header.bucketOffset % alignof(uint32_t)) || (header.subresourceOffset % alignof(uint64_t)))
+            return false;
+
+        // The index is used in place (mapping bases are page aligned)
+        impl->buckets      = reinterpret_cast<const uint32_t*>(impl->data + header.bucketOffset);
+        impl->entries      = reinterpret_cast<const ARCHIVE_ENTRY*>(impl->data + header.entryOffset);
+        impl->subresources = reinterpret_cast<const uint64_t*>(impl->data + header.subresourceOffset);
+        impl->strings      = reinterpret_cast<const char*>(impl->data + header.stringOffset);
+
+        const size_t bucketCount = size_t(1) << header.bucketBits;
+        for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            if ((impl->buckets[bucket] > impl->buckets[bucket + 1]) || (impl->buckets[bucket + 1] > header.entryCount))
+                return false;
+        }
+
+        for (size_t i = 0; i < header.entryCount; ++i)
+        {
+            const ARCHIVE_ENTRY& entry = impl->entries[i];
+            if ((uint64_t(entry.nameOffset) + entry.nameLength >= header.stringSize)
+                || (impl->strings[entry.nameOffset + entry.nameLength] != '\0')
+                || (uint64_t(entry.firstSubresource) + entry.subresourceCount > header.subresourceCount)
+                || (entry.payloadOffset > header.fileSize) || (entry.payloadSize > header.fileSize - entry.payloadOffset))
+                return false;
+
+            // Entry metadata sizes the image arrays of GetImages / Load
+            const TexMetadata metadata = GetEntryMetadata(entry);
+
+            size_t expected = 0, pixelSize = 0;
+            if (!ValidateFileMetadata(metadata)
+                || !DetermineImageArray(metadata, CP_FLAGS_NONE, expected, pixelSize) || (expected != entry.subresourceCount))
+                return false;
+        }
+
+        m_impl = impl.release();
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void TextureArchive::Close() noexcept
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+//-------------------------------------------------------------------------------------
+// Lookup
+//-------------------------------------------------------------------------------------
+size_t TextureArchive::GetEntryCount() const noexcept
+{
+    return m_impl ? m_impl->header.entryCount : 0;
+}
+
+size_t TextureArchive::Find(const char* name) const noexcept
+{
+    if (!m_impl || !name)
+        return size_t(-1);
+
+    const size_t length = strlen(name);
+    const uint64_t hash = HashName(name, length);
+    const size_t bucket = GetBucket(hash, m_impl->header.bucketBits);
+
+    for (size_t i = m_impl->buckets[bucket]; i < m_impl->buckets[bucket + 1]; ++i)
+    {
+        const ARCHIVE_ENTRY& entry = m_impl->entries[i];
+        if ((entry.hash == hash) && (entry.nameLength == length)
+            && (memcmp(m_impl->strings + entry.nameOffset, name, length) == 0))
+            return i;
+    }
+
+    return size_t(-1);
+}
+
+const char* TextureArchive::GetName(size_t entry) const noexcept
+{
+    if (!m_impl || (entry >= m_impl->header.entryCount))
+        return nullptr;
+
+    return m_impl->strings + m_impl->entries[entry].nameOffset;
+}
+
+bool TextureArchive::GetMetadata(size_t entry, TexMetadata& metadata) const noexcept
+{
+    if (!m_impl || (entry >= m_impl->header.entryCount))
+        return false;
+
+    metadata = GetEntryMetadata(m_impl->entries[entry]);
+    return true;
+}
+
+size_t TextureArchive::GetImageCount(size_t entry) const noexcept
+{
+    if (!m_impl || (entry >= m_impl->header.entryCount))
+        return 0;
+
+    return m_impl->entries[entry].subresourceCount;
+}
+
+//-------------------------------------------------------------------------------------
+// Image views / copies
+//-------------------------------------------------------------------------------------
+bool TextureArchive::GetImages(size_t entry, Image* images, size_t nimages) const noexcept
+{
+    if (!m_impl || !images || (entry >= m_impl->header.entryCount))
+        return false;
+
+    const ARCHIVE_ENTRY& desc = m_impl->entries[entry];
+    if (nimages < desc.subresourceCount)
+        return false;
+
+    // Same layout math as ScratchImage, pointing into the mapping instead
+    const TexMetadata metadata = GetEntryMetadata(desc);
+
+    size_t expected = 0, pixelSize = 0;
+    if (!DetermineImageArray(metadata, CP_FLAGS_NONE, expected, pixelSize) || (expected != desc.subresourceCount))
+        return false;
+
+    size_t index = 0;
+    const size_t depth = (metadata.dimension == TEX_DIMENSION_TEXTURE3D) ? metadata.depth : 1;
+    const size_t items = (metadata.dimension == TEX_DIMENSION_TEXTURE3D) ? 1 : metadata.arraySize;
+
+    auto setImage = [&](size_t width, size_t height) noexcept
+    {
+        size_t rowPitch, slicePitch;
+        if (!ComputePitch(metadata.format, width, height, rowPitch, slicePitch, CP_FLAGS_NONE))
+            return false;
+
+        const uint64_t offset = m_impl->subresources[desc.firstSubresource + index];
+        if ((offset < desc.payloadOffset) || (offset > desc.payloadOffset + desc.payloadSize)
+            || (slicePitch > desc.payloadOffset + desc.payloadSize - offset))
+            return false;
+
+        Image& image = images[index++];
+        image.width      = width;
+        image.height     = height;
+        image.format     = metadata.format;
+        image.rowPitch   = rowPitch;
+        image.slicePitch = slicePitch;
+        image.pixels     = m_impl->data + offset;
+        return true;
+    };
+
+    if (metadata.dimension == TEX_DIMENSION_TEXTURE3D)
+    {
+        size_t d = depth;
+        for (size_t level = 0; level < metadata.mipLevels; ++level)
+        {
+            const size_t width  = std::max<size_t>(1u, metadata.width >> level);
+            const size_t height = std::max<size_t>(1u, metadata.height >> level);
+
+            for (size_t slice = 0; slice < d; ++slice)
+            {
+                if (!setImage(width, height))
+                    return false;
+            }
+
+            if (d > 1)
+                d >>= 1;
+        }
+    }
+    else
+    {
+        for (size_t item = 0; item < items; ++item)
+        {
+            for (size_t level = 0; level < metadata.mipLevels; ++level)
+            {
+                if (!setImage(std::max<size_t>(1u, metadata.width >> level), std::max<size_t>(1u, metadata.height >> level)))
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool TextureArchive::Load(size_t entry, ScratchImage& image) const noexcept
+{
+    image.Release();
+
+    const size_t nimages = GetImageCount(entry);
+    if (!nimages)
+        return false;
+
+    try
+    {
+        std::vector<Image> views(nimages);
+        if (!GetImages(entry, views.data(), views.size()))
+            return false;
+
+        TexMetadata metadata;
+        GetMetadata(entry, metadata);
+
+        bool hr = image.Initialize(metadata);
+        if (hr == false)
+            return hr;
+
+        for (size_t i = 0; i < nimages; ++i)
+        {
+            const Image& src = views[i];
+            const Image& dest = image.GetImages()[i];
+
+            const size_t rows = ComputeScanlines(src.format, src.height);
+            for (size_t y = 0; y < rows; ++y)
+            {
+                memcpy(dest.pixels + y * dest.rowPitch, src.pixels + y * src.rowPitch, src.rowPitch);
+            }
+        }
+    }
+    catch (...)
+    {
+        image.Release();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,1060 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr uint32_t c_manifestMagic   = 0x53435456; // "VTCS"
+    constexpr uint32_t c_manifestVersion = 1;
+
+    const char* const c_manifestExtension = ".vtcs";
+    const char* const c_payloadDirectory  = "payloads";
+
+#pragma pack(push, 1)
+    struct ManifestHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t dimension;
+        uint64_t width;
+        uint64_t height;
+        uint64_t depth;
+        uint64_t arraySize;
+        uint64_t mipLevels;
+        uint32_t miscFlags;
+        uint32_t miscFlags2;
+        uint64_t imageCount;
+    };
+
+    struct ManifestEntry
+    {
+        uint64_t hashLow;
+        uint64_t hashHigh;
+        uint64_t size;
+    };
+#pragma pack(pop)
+
+    struct ContentHashHasher
+    {
+        size_t operator()(const ContentHash& hash) const noexcept { return static_cast<size_t>(hash.low); }
+    };
+
+    //---------------------------------------------------------------------------------
+    std::string PayloadFileName(const ContentHash& hash)
+    {
+        char name[40] = {};
+        snprintf(name, sizeof(name), "%016llx%016llx.bin",
+            static_cast<unsigned long long>(hash.high), static_cast<unsigned long long>(hash.low));
+        return name;
+    }
+
+    bool ParsePayloadFileName(const std::string& name, ContentHash& hash) noexcept
+    {
+        if ((name.size() != 36) || (name.compare(32, 4, ".bin") != 0))
+            return false;
+
+        uint64_t value[2] = {};
+        for (size_t i = 0; i < 32; ++i)
+        {
+            const char c = name[i];
+            uint64_t digit;
+
+            if ((c >= '0') && (c <= '9'))
+                digit = static_cast<uint64_t>(c - '0');
+            else if ((c >= 'a') && (c <= 'f'))
+                digit = static_cast<uint64_t>(c - 'a' + 10);
+            else
+                return false;
+
+            value[i / 16] = (value[i / 16] << 4) | digit;
+        }
+
+        hash.high = value[0];
+        hash.low  = value[1];
+        return true;
+    }
+
+    // Valid bytes of the image (ComputeScanlines rows without pitch padding)
+    bool GetPayloadLayout(const Image& image, size_t& rowSize, size_t& rows) noexcept
+    {
+        size_t rowPitch, slicePitch;
+        if (!ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE))
+            return false;
+
+        if (rowPitch > image.rowPitch)
+            return false;
+
+        rowSize = rowPitch;
+        rows    = ComputeScanlines(image.format, image.height);
+        return true;
+    }
+
+    bool WriteImageRows(std::ostream& outFile, const Image& image)
+    {
+        size_t rowSize, rows;
+        if (!GetPayloadLayout(image, rowSize, rows))
+            return false;
+
+        const uint8_t* pSource = image.pixels;
+        for (size_t y = 0; y < rows; ++y)
+        {
+            outFile.write(reinterpret_cast<const char*>(pSource), static_cast<std::streamsize>(rowSize));
+            pSource += image.rowPitch;
+        }
+
+        return static_cast<bool>(outFile);
+    }
+
+    bool ReadImageRows(std::istream& inFile, const Image& image)
+    {
+        size_t rowSize, rows;
+        if (!GetPayloadLayout(image, rowSize, rows))
+            return false;
+
+        uint8_t* pDest = image.pixels;
+        for (size_t y = 0; y < rows; ++y)
+        {
+            inFile.read(reinterpret_cast<char*>(pDest), static_cast<std::streamsize>(rowSize));
+            pDest += image.rowPitch;
+        }
+
+        return static_cast<bool>(inFile);
+    }
+
+    // Written to a temporary name first so a crashed writer never leaves a truncated file behind
+    template<typename Fn>
+    bool WriteFileAtomic(const std::filesystem::path& path, Fn&& writer) noexcept
+    {
+        try
+        {
+            std::filesystem::path temp = path;
+            temp += ".tmp";
+
+            {
+                std::ofstream outFile{ temp, std::ios::out | std::ios::binary | std::ios::trunc };
+                if (!outFile)
+                    return false;
+
+                if (!writer(outFile) || !outFile)
+                    return false;
+            }
+
+            std::error_code ec;
+            std::filesystem::rename(temp, path, ec);
+            return !ec;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// Captured resource views
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Internal::GetCapturedImages(
+    const CapturedResourceInfo& capturedResourceInfo,
+    TexMetadata& metadata,
+    std::vector<Image>& images) noexcept
+{
+    if ((capturedResourceInfo.mappedData == nullptr)
+        || (capturedResourceInfo.subresourceInfoArray == nullptr)
+        || (capturedResourceInfo.subresourceInfoArraySize == 0)
+        || (capturedResourceInfo.layerCount == 0)
+        || (capturedResourceInfo.mipLevels == 0))
+        return false;
+
+    const SubresourceInfo& first = capturedResourceInfo.subresourceInfoArray[0];
+
+    metadata = {};
+    metadata.width     = first.width;
+    metadata.height    = 1;
+    metadata.depth     = 1;
+    metadata.arraySize = capturedResourceInfo.layerCount;
+    metadata.mipLevels = capturedResourceInfo.mipLevels;
+    metadata.format    = capturedResourceInfo.format;
+
+    switch (capturedResourceInfo.imageViewType)
+    {
+        case VK_IMAGE_VIEW_TYPE_1D:
+        case VK_IMAGE_VIEW_TYPE_1D_ARRAY:
+            metadata.dimension = TEX_DIMENSION_TEXTURE1D;
+            break;
+
+        case VK_IMAGE_VIEW_TYPE_CUBE:
+        case VK_IMAGE_VIEW_TYPE_CUBE_ARRAY:
+            metadata.miscFlags = TEX_MISC_TEXTURECUBE;
+            [[fallthrough]];
+
+        case VK_IMAGE_VIEW_TYPE_2D:
+        case VK_IMAGE_VIEW_TYPE_2D_ARRAY:
+            metadata.height    = first.height;
+            metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+            break;
+
+        case VK_IMAGE_VIEW_TYPE_3D:
+            // Captured layers are the depth slices, as in SaveToDDSFile
+            metadata.height    = first.height;
+            metadata.depth     = capturedResourceInfo.layerCount;
+            metadata.arraySize = 1;
+            metadata.dimension = TEX_DIMENSION_TEXTURE3D;
+            break;
+
+        default:
+            return false;
+    }
+
+    if (!metadata.width || !metadata.height)
+        return false;
+
+    try
+    {
+        size_t count = 0;
+        size_t d = metadata.depth;
+        for (size_t level = 0; level < metadata.mipLevels; ++level)
+        {
+            count += metadata.IsVolumemap() ? d : metadata.arraySize;
+            if (d > 1)
+                d >>= 1;
+        }
+
+        images.assign(count, Image{});
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    // Subresources are laid out layer-major, each layer holding its full mip chain
+    const size_t layerCount = capturedResourceInfo.layerCount;
+    uint32_t dindex = 0;
+
+    for (size_t item = 0; item < layerCount; ++item)
+    {
+        for (size_t level = 0; level < metadata.mipLevels; ++level, ++dindex)
+        {
+            if (dindex >= capturedResourceInfo.subresourceInfoArraySize)
+                return false;
+
+            const SubresourceInfo& subresInfo = capturedResourceInfo.subresourceInfoArray[dindex];
+
+            const size_t index = metadata.IsVolumemap()
+                ? metadata.ComputeIndex(level, 0, item)
+                : metadata.ComputeIndex(level, item, 0);
+
+            // Volume slices past the depth of a smaller level carry no data
+            if (index == size_t(-1))
+                continue;
+
+            Image& image = images[index];
+            image.width  = std::max<size_t>(1u, metadata.width >> level);
+            image.height = std::max<size_t>(1u, metadata.height >> level);
+            image.format = metadata.format;
+
+            if (!ComputePitch(image.format, image.width, image.height, image.rowPitch, image.slicePitch, CP_FLAGS_NONE))
+                return false;
+
+            if (subresInfo.memorySize < image.slicePitch)
+                return false;
+
+            image.pixels = capturedResourceInfo.mappedData + subresInfo.memoryOffset;
+        }
+    }
+
+    for (const Image& image : images)
+    {
+        if (!image.pixels)
+            return false;
+    }
+
+    return true;
+}
+
+
+//=====================================================================================
+// CaptureStore
+//=====================================================================================
+
+struct CaptureStore::Impl
+{
+    std::filesystem::path                                    directory;
+    std::unordered_set<ContentHash, ContentHashHasher>       payloads;
+    size_t                                                   written = 0;
+    size_t                                                   reused  = 0;
+};
+
+CaptureStore& CaptureStore::operator= (CaptureStore&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        Close();
+
+        m_impl = moveFrom.m_impl;
+        moveFrom.m_impl = nullptr;
+    }
+    return *this;
+}
+
+//-------------------------------------------------------------------------------------
+// Open / close
+//-------------------------------------------------------------------------------------
+bool CaptureStore::Open(const char* directory) noexcept
+{
+    Close();
+
+    if (!directory)
+        return false;
+
+    try
+    {
+        std::unique_ptr<Impl> impl(new Impl);
+        impl->directory = std::filesystem::path(directory);
+
+        std::error_code ec;
+        std::filesystem::create_directories(impl->directory / c_payloadDirectory, ec);
+        if (ec)
+            return false;
+
+        // Payloads of earlier sessions are reused as well
+        for (const auto& entry : std::filesystem::directory_iterator(impl->directory / c_payloadDirectory, ec))
+        {
+            ContentHash hash;
+            if (entry.is_regular_file() && ParsePayloadFileName(entry.path().filename().string(), hash))
+                impl->payloads.insert(hash);
+        }
+
+        m_impl = impl.release();
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void CaptureStore::Close() noexcept
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+size_t CaptureStore::GetPayloadsWritten() const noexcept
+{
+    return m_impl ? m_impl->written : 0;
+}
+
+size_t CaptureStore::GetPayloadsReused() const noexcept
+{
+    return m_impl ? m_impl->reused : 0;
+}
+
+//-------------------------------------------------------------------------------------
+// Add a capture
+//-------------------------------------------------------------------------------------
+bool CaptureStore::Add(const char* name, const Image* images, size_t nimages, const TexMetadata& metadata) noexcept
+{
+    if (!m_impl || !name || !images || !nimages)
+        return false;
+
+    // Load rejects manifests outside these limits
+    if (!ValidateFileMetadata(metadata))
+        return false;
+
+    try
+    {
+        std::vector<ContentHash> hashes(nimages);
+        std::atomic<bool> failed{ false };
+
+        ParallelFor(nimages, 1, [&](size_t begin, size_t end) noexcept
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if ((images[i].format != metadata.format) || !ComputeContentHash(images[i], hashes[i]))
+                    failed = true;
+            }
+        });
+
+        if (failed)
+            return false;
+
+        const std::filesystem::path payloadDirectory = m_impl->directory / c_payloadDirectory;
+
+        std::vector<uint8_t> manifest(sizeof(ManifestHeader) + nimages * sizeof(ManifestEntry));
+
+        auto header = reinterpret_cast<ManifestHeader*>(manifest.data());
+        header->magic      = c_manifestMagic;
+        header->version    = c_manifestVersion;
+        header->format     = static_cast<uint32_t>(metadata.format);
+        header->dimension  = static_cast<uint32_t>(metadata.dimension);
+        header->width      = metadata.width;
+        header->height     = metadata.height;
+        header->depth      = metadata.depth;
+        header->arraySize  = metadata.arraySize;
+        header->mipLevels  = metadata.mipLevels;
+        header->miscFlags  = metadata.miscFlags;
+        header->miscFlags2 = metadata.miscFlags2;
+        header->imageCount = nimages;
+
+        auto entries = reinterpret_cast<ManifestEntry*>(manifest.data() + sizeof(ManifestHeader));
+
+        for (size_t i = 0; i < nimages; ++i)
+        {
+            size_t rowSize, rows;
+            if (!GetPayloadLayout(images[i], rowSize, rows))
+                return false;
+
+            entries[i].hashLow  = hashes[i].low;
+            entries[i].hashHigh = hashes[i].high;
+            entries[i].size     = rowSize * rows;
+
+            // Identical subresources within this capture are deduplicated too
+            if (m_impl->payloads.count(hashes[i]))
+            {
+                ++m_impl->reused;
+                continue;
+            }
+
+            const Image& payload = images[i];
+            if (!WriteFileAtomic(payloadDirectory / PayloadFileName(hashes[i]),
+                [&](std::ostream& outFile) { return WriteImageRows(outFile, payload); }))
+                return false;
+
+            m_impl->payloads.insert(hashes[i]);
+            ++m_impl->written;
+        }
+
+        return WriteFileAtomic(m_impl->directory / (std::string(name) + c_manifestExtension),
+            [&](std::ostream& outFile)
+            {
+                outFile.write(reinterpret_cast<const char*>(manifest.data()), static_cast<std::streamsize>(manifest.size()));
+                return static_cast<bool>(outFile);
+            });
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool CaptureStore::Add(const char* name, const ImageSetView& images) noexcept
+{
+    return Add(name, images.images, images.nimages, images.metadata);
+}
+
+bool CaptureStore::Add(const char* name, const CapturedResourceInfo* capturedResourceInfo) noexcept
+{
+    if (!capturedResourceInfo)
+        return false;
+
+    TexMetadata mdata;
+    std::vector<Image> images;
+
+    if (!GetCapturedImages(*capturedResourceInfo, mdata, images))
+        return false;
+
+    return Add(name, images.data(), images.size(), mdata);
+}
+
+//-------------------------------------------------------------------------------------
+// Rebuild a capture
+//-------------------------------------------------------------------------------------
+bool CaptureStore::Load(const char* name, ScratchImage& image) const noexcept
+{
+    if (!m_impl || !name)
+        return false;
+
+    try
+    {
+        std::ifstream inFile{ m_impl->directory / (std::string(name) + c_manifestExtension), std::ios::in | std::ios::binary };
+        if (!inFile)
+            return false;
+
+        ManifestHeader header = {};
+        inFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!inFile || (header.magic != c_manifestMagic) || (header.version != c_manifestVersion))
+            return false;
+
+        TexMetadata mdata = {};
+        mdata.width      = static_cast<size_t>(header.width);
+        mdata.height     = static_cast<size_t>(header.height);
+        mdata.depth      = static_cast<size_t>(header.depth);
+        mdata.arraySize  = static_cast<size_t>(header.arraySize);
+        mdata.mipLevels  = static_cast<size_t>(header.mipLevels);
+        mdata.miscFlags  = header.miscFlags;
+        mdata.miscFlags2 = header.miscFlags2;
+        mdata.format     = static_cast<VkFormat>(header.format);
+        mdata.dimension  = static_cast<TEX_DIMENSION>(header.dimension);
+
+        if (!ValidateFileMetadata(mdata))
+            return false;
+
+        bool hr = image.Initialize(mdata);
+        if (hr == false)
+            return hr;
+
+        if (image.GetImageCount() != header.imageCount)
+        {
+            image.Release();
+            return false;
+        }
+
+        const std::filesystem::path payloadDirectory = m_impl->directory / c_payloadDirectory;
+
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            ManifestEntry entry = {};
+            inFile.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+
+            const Image& dest = image.GetImages()[i];
+
+            size_t rowSize, rows;
+            if (!inFile || !GetPayloadLayout(dest, rowSize, rows) || (entry.size != rowSize * rows))
+            {
+                image.Release();
+                return false;
+            }
+
+            ContentHash hash;
+            hash.low  = entry.hashLow;
+            hash.high = entry.hashHigh;
+
+            std::ifstream payload{ payloadDirectory / PayloadFileName(hash), std::ios::in | std::ios::binary };
+
+            if (!payload || !ReadImageRows(payload, dest))
+            {
+                image.Release();
+                return false;
+            }
+        }
+    }
+    catch (...)
+    {
+        image.Release();
+        return false;
+    }
+
+    return true;
+}
+
+bool CaptureStore::ExportToDDSFile(const char* name, DDS_FLAGS flags, const char* szFile) const noexcept
+{
+    ScratchImage image;
+    if (!Load(name, image))
+        return false;
+
+    return SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(), flags, szFile);
+}
+
+
+//=====================================================================================
+// DeltaCapture
+//=====================================================================================
+
+namespace
+{
+    constexpr uint32_t c_deltaMagic    = 0x4C445456; // "VTDL"
+    constexpr uint32_t c_deltaVersion  = 1;
+    constexpr uint32_t c_deltaTileSize = 64;
+
+    enum DELTA_HEADER_FLAGS : uint32_t
+    {
+        DELTA_HEADER_BASE  = 0x1,
+        DELTA_HEADER_TILES = 0x2,
+    };
+
+#pragma pack(push, 1)
+    struct DeltaHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t dimension;
+        uint64_t width;
+        uint64_t height;
+        uint64_t depth;
+        uint64_t arraySize;
+        uint64_t mipLevels;
+        uint32_t miscFlags;
+        uint32_t miscFlags2;
+        uint64_t imageCount;
+        uint64_t resourceId;
+        uint64_t sequence;
+        uint32_t flags;
+        uint32_t tileSize;
+        uint64_t regionCount;
+    };
+
+    // Rectangle in texels of one image, its rows are stored tightly packed at 'offset'
+    struct DeltaRegion
+    {
+        uint64_t imageIndex;
+        uint64_t x;
+        uint64_t y;
+        uint64_t width;
+        uint64_t height;
+        uint64_t offset;
+        uint64_t size;
+    };
+#pragma pack(pop)
+
+    // Addressable unit of a row: a texel, or a block for compressed formats
+    struct UnitLayout
+    {
+        size_t blockWidth;
+        size_t blockHeight;
+        size_t bytes;
+    };
+
+    bool GetUnitLayout(VkFormat format, UnitLayout& layout) noexcept
+    {
+        if (IsCompressed(format))
+        {
+            if (!IsASTC(format) || !GetASTCBlockSize(format, layout.blockWidth, layout.blockHeight))
+            {
+                layout.blockWidth  = 4;
+                layout.blockHeight = 4;
+            }
+
+            layout.bytes = BytesPerBlock(format);
+            return (layout.bytes > 0);
+        }
+
+        // Packed and planar layouts are only tracked per subresource
+        const size_t bpp = BitsPerPixel(format);
+        if (!bpp || (bpp % 8) || IsPacked(format) || IsPlanar(format))
+            return false;
+
+        layout.blockWidth  = 1;
+        layout.blockHeight = 1;
+        layout.bytes       = bpp / 8;
+        return true;
+    }
+
+    bool MakeRegionView(const Image& image, const DeltaRegion& region, Image& view) noexcept
+    {
+        if ((region.width == 0) || (region.height == 0)
+            || (region.x + region.width > image.width) || (region.y + region.height > image.height))
+            return false;
+
+        view = image;
+        view.width  = static_cast<size_t>(region.width);
+        view.height = static_cast<size_t>(region.height);
+
+        if (region.x || region.y)
+        {
+            UnitLayout layout;
+            if (!GetUnitLayout(image.format, layout)
+                || (region.x % layout.blockWidth) || (region.y % layout.blockHeight))
+                return false;
+
+            view.pixels += static_cast<size_t>(region.y / layout.blockHeight) * image.rowPitch
+                + static_cast<size_t>(region.x / layout.blockWidth) * layout.bytes;
+        }
+
+        return true;
+    }
+
+    bool BuildRegions(const Image* images, size_t nimages, bool tiles, std::vector<DeltaRegion>& regions)
+    {
+        regions.clear();
+
+        UnitLayout layout = {};
+        if (tiles && !GetUnitLayout(images[0].format, layout))
+            tiles = false;
+
+        for (size_t i = 0; i < nimages; ++i)
+        {
+            const Image& image = images[i];
+
+            if (!tiles)
+            {
+                regions.push_back({ i, 0, 0, image.width, image.height, 0, 0 });
+                continue;
+            }
+
+            const size_t tileWidth  = c_deltaTileSize * layout.blockWidth;
+            const size_t tileHeight = c_deltaTileSize * layout.blockHeight;
+
+            for (size_t y = 0; y < image.height; y += tileHeight)
+            {
+                for (size_t x = 0; x < image.width; x += tileWidth)
+                {
+                    regions.push_back({ i, x, y,
+                        std::min(tileWidth, image.width - x), std::min(tileHeight, image.height - y), 0, 0 });
+                }
+            }
+        }
+
+        return tiles;
+    }
+
+    bool IsSameMetadata(const TexMetadata& a, const TexMetadata& b) noexcept
+    {
+        return (a.width == b.width)
+            && (a.height == b.height)
+            && (a.depth == b.depth)
+            && (a.arraySize == b.arraySize)
+            && (a.mipLevels == b.mipLevels)
+            && (a.miscFlags == b.miscFlags)
+            && (a.miscFlags2 == b.miscFlags2)
+            && (a.format == b.format)
+            && (a.dimension == b.dimension);
+    }
+
+    TexMetadata GetHeaderMetadata(const DeltaHeader& header) noexcept
+    {
+        TexMetadata mdata = {};
+        mdata.width      = static_cast<size_t>(header.width);
+        mdata.height     = static_cast<size_t>(header.height);
+        mdata.depth      = static_cast<size_t>(header.depth);
+        mdata.arraySize  = static_cast<size_t>(header.arraySize);
+        mdata.mipLevels  = static_cast<size_t>(header.mipLevels);
+        mdata.miscFlags  = header.miscFlags;
+        mdata.miscFlags2 = header.miscFlags2;
+        mdata.format     = static_cast<VkFormat>(header.format);
+        mdata.dimension  = static_cast<TEX_DIMENSION>(header.dimension);
+        return mdata;
+    }
+
+    struct DeltaHistory
+    {
+        TexMetadata              metadata;
+        bool                     tiles;
+        uint64_t                 sequence;
+        std::vector<ContentHash> hashes;
+    };
+}
+
+struct DeltaCapture::Impl
+{
+    std::unordered_map<uint64_t, DeltaHistory> history;
+    size_t                                     lastRegionCount = 0;
+};
+
+DeltaCapture& DeltaCapture::operator= (DeltaCapture&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        Reset();
+
+        m_impl = moveFrom.m_impl;
+        moveFrom.m_impl = nullptr;
+    }
+    return *this;
+}
+
+void DeltaCapture::Forget(uint64_t resourceId) noexcept
+{
+    if (m_impl)
+        m_impl->history.erase(resourceId);
+}
+
+void DeltaCapture::Reset() noexcept
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+size_t DeltaCapture::GetLastRegionCount() const noexcept
+{
+    return m_impl ? m_impl->lastRegionCount : 0;
+}
+
+//-------------------------------------------------------------------------------------
+// Save a base or a delta
+//-------------------------------------------------------------------------------------
+bool DeltaCapture::Save(
+    uint64_t resourceId,
+    const Image* images,
+    size_t nimages,
+    const TexMetadata& metadata,
+    DELTA_FLAGS flags,
+    const char* szFile) noexcept
+{
+    if (!images || !nimages || !szFile)
+        return false;
+
+    try
+    {
+        // LoadFromDeltaFiles rejects anything outside these limits
+        if (!ValidateFileMetadata(metadata))
+            return false;
+
+        if (!m_impl)
+            m_impl = new Impl;
+
+        for (size_t i = 0; i < nimages; ++i)
+        {
+            if ((images[i].format != metadata.format) || !images[i].pixels)
+                return false;
+        }
+
+        std::vector<DeltaRegion> regions;
+        const bool tiles = BuildRegions(images, nimages, (flags & DELTA_FLAGS_TILES) != 0, regions);
+
+        // Every region is hashed, in parallel, so the next save can compare against it
+        std::vector<ContentHash> hashes(regions.size());
+        std::atomic<bool> failed{ false };
+
+        ParallelFor(regions.size(), 16, [&](size_t begin, size_t end) noexcept
+        {
+            for (size_t r = begin; r < end; ++r)
+            {
+                Image view;
+                if (!MakeRegionView(images[regions[r].imageIndex], regions[r], view)
+                    || !ComputeContentHash(view, hashes[r]))
+                    failed = true;
+            }
+        });
+
+        if (failed)
+            return false;
+
+        auto previous = m_impl->history.find(resourceId);
+
+        const bool isBase = (flags & DELTA_FLAGS_FORCE_BASE)
+            || (previous == m_impl->history.end())
+            || !IsSameMetadata(previous->second.metadata, metadata)
+            || (previous->second.tiles != tiles)
+            || (previous->second.hashes.size() != hashes.size());
+
+        std::vector<DeltaRegion> changed;
+        changed.reserve(regions.size());
+
+        uint64_t offset = sizeof(DeltaHeader);
+        for (size_t r = 0; r < regions.size(); ++r)
+        {
+            if (!isBase && (previous->second.hashes[r] == hashes[r]))
+                continue;
+
+            Image view;
+            size_t rowSize, rows;
+            if (!MakeRegionView(images[regions[r].imageIndex], regions[r], view)
+                || !GetPayloadLayout(view, rowSize, rows))
+                return false;
+
+            changed.push_back(regions[r]);
+            changed.back().size = rowSize * rows;
+        }
+
+        offset += changed.size() * sizeof(DeltaRegion);
+        for (auto& region : changed)
+        {
+            region.offset = offset;
+            offset += region.size;
+        }
+
+        DeltaHeader header = {};
+        header.magic       = c_deltaMagic;
+        header.version     = c_deltaVersion;
+        header.format      = static_cast<uint32_t>(metadata.format);
+        header.dimension   = static_cast<uint32_t>(metadata.dimension);
+        header.width       = metadata.width;
+        header.height      = metadata.height;
+        header.depth       = metadata.depth;
+        header.arraySize   = metadata.arraySize;
+        header.mipLevels   = metadata.mipLevels;
+        header.miscFlags   = metadata.miscFlags;
+        header.miscFlags2  = metadata.miscFlags2;
+        header.imageCount  = nimages;
+        header.resourceId  = resourceId;
+        header.sequence    = isBase ? 0 : previous->second.sequence + 1;
+        header.flags       = (isBase ? DELTA_HEADER_BASE : 0u) | (tiles ? DELTA_HEADER_TILES : 0u);
+        header.tileSize    = tiles ? c_deltaTileSize : 0;
+        header.regionCount = changed.size();
+
+        const bool written = WriteFileAtomic(std::filesystem::path(szFile), [&](std::ostream& outFile)
+        {
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            outFile.write(reinterpret_cast<const char*>(changed.data()),
+                static_cast<std::streamsize>(changed.size() * sizeof(DeltaRegion)));
+
+            for (const auto& region : changed)
+            {
+                Image view;
+                if (!MakeRegionView(images[region.imageIndex], region, view) || !WriteImageRows(outFile, view))
+                    return false;
+            }
+
+            return static_cast<bool>(outFile);
+        });
+
+        if (!written)
+            return false;
+
+        // History only advances once the file is on disk
+        DeltaHistory& entry = m_impl->history[resourceId];
+        entry.metadata = metadata;
+        entry.tiles    = tiles;
+        entry.sequence = header.sequence;
+        entry.hashes   = std::move(hashes);
+
+        m_impl->lastRegionCount = changed.size();
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool DeltaCapture::Save(uint64_t resourceId, const ImageSetView& images, DELTA_FLAGS flags, const char* szFile) noexcept
+{
+    return Save(resourceId, images.images, images.nimages, images.metadata, flags, szFile);
+}
+
+bool DeltaCapture::Save(
+    uint64_t resourceId,
+    const CapturedResourceInfo* capturedResourceInfo,
+    DELTA_FLAGS flags,
+    const char* szFile) noexcept
+{
+    if (!capturedResourceInfo)
+        return false;
+
+    TexMetadata mdata;
+    std::vector<Image> images;
+
+    if (!GetCapturedImages(*capturedResourceInfo, mdata, images))
+        return false;
+
+    return Save(resourceId, images.data(), images.size(), mdata, flags, szFile);
+}
+
+//-------------------------------------------------------------------------------------
+// Reconstruct from a base and its deltas
+//-------------------------------------------------------------------------------------
+bool VulkanTex::LoadFromDeltaFiles(const char* const* files, size_t count, ScratchImage& image) noexcept
+{
+    if (!files || !count)
+        return false;
+
+    image.Release();
+
+    try
+    {
+        DeltaHeader first = {};
+        std::vector<DeltaRegion> regions;
+
+        for (size_t f = 0; f < count; ++f)
+        {
+            if (!files[f])
+                return false;
+
+            std::ifstream inFile{ std::filesystem::path(files[f]), std::ios::in | std::ios::binary | std::ios::ate };
+            if (!inFile)
+                break;
+
+            const auto fileSize = static_cast<uint64_t>(inFile.tellg());
+            if (fileSize < sizeof(DeltaHeader))
+                break;
+
+            DeltaHeader header = {};
+            inFile.seekg(0);
+            inFile.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+            if (!inFile || (header.magic != c_deltaMagic) || (header.version != c_deltaVersion))
+                break;
+
+            // The region table follows the header
+            if (header.regionCount > (fileSize - sizeof(DeltaHeader)) / sizeof(DeltaRegion))
+                break;
+
+            const TexMetadata mdata = GetHeaderMetadata(header);
+
+            if (f == 0)
+            {
+                if (!(header.flags & DELTA_HEADER_BASE) || !ValidateFileMetadata(mdata))
+                    break;
+
+                if (!image.Initialize(mdata) || (image.GetImageCount() != header.imageCount))
+                    break;
+
+                first = header;
+            }
+            else if ((header.flags & DELTA_HEADER_BASE)
+                || (header.resourceId != first.resourceId)
+                || (header.sequence != first.sequence + f)
+                || (header.imageCount != first.imageCount)
+                || !IsSameMetadata(mdata, image.GetMetadata()))
+            {
+                // Deltas must chain onto the base in save order
+                break;
+            }
+
+            regions.resize(static_cast<size_t>(header.regionCount));
+            inFile.read(reinterpret_cast<char*>(regions.data()),
+                static_cast<std::streamsize>(regions.size() * sizeof(DeltaRegion)));
+
+            if (!inFile)
+                break;
+
+            bool ok = true;
+            for (const auto& region : regions)
+            {
+                Image view;
+                size_t rowSize, rows;
+
+                if ((region.imageIndex >= image.GetImageCount())
+                    || !MakeRegionView(image.GetImages()[region.imageIndex], region, view)
+                    || !GetPayloadLayout(view, rowSize, rows)
+                    || (region.size != rowSize * rows))
+                {
+                    ok = false;
+                    break;
+                }
+
+                inFile.seekg(static_cast<std::streamoff>(region.offset));
+                if (!ReadImageRows(inFile, view))
+                {
+                    ok = false;
+                    break;
+                }
+            }
+
+            if (!ok)
+                break;
+
+            if (f + 1 == count)
+                return true;
+        }
+    }
+    catch (...)
+    {
+    }
+
+    image.Release();
+    return false;
+}
+
+bool VulkanTex::SaveDeltasToDDSFile(
+    const char* const* files,
+    size_t count,
+    DDS_FLAGS flags,
+    const char* szFile) noexcept
+{
+    ScratchImage image;
+    if (!LoadFromDeltaFiles(files, count, image))
+        return false;
+
+    return SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(), flags, szFile);
+}
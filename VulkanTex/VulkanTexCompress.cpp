@@ -0,0 +1,1064 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexDDS.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // LZ codec (LZ4 block format)
+    //---------------------------------------------------------------------------------
+    constexpr size_t c_minMatch     = 4;
+    constexpr size_t c_lastLiterals = 5;    // The last bytes of a block are always literals
+    constexpr size_t c_mfLimit      = 12;   // The last match must start this far from the end
+    constexpr size_t c_maxDistance  = 65535;
+
+    constexpr size_t c_fastHashBits = 14;
+    constexpr size_t c_highHashBits = 16;
+    constexpr size_t c_highMaxDepth = 64;
+
+    // Chunks are whole rows of one subresource, up to this many bytes
+    constexpr size_t c_chunkTargetSize = 256 * 1024;
+
+    inline uint32_t Read32(const uint8_t* p) noexcept
+    {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t Read64(const uint8_t* p) noexcept
+    {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t Hash4(const uint8_t* p, size_t bits) noexcept
+    {
+        return (Read32(p) * 2654435761u) >> (32 - bits);
+    }
+
+    // Number of equal bytes at a and b, not reading past 'limit' on the a side
+    inline size_t CountMatch(const uint8_t* a, const uint8_t* b, const uint8_t* limit) noexcept
+    {
+        const uint8_t* start = a;
+
+        while (a + 8 <= limit)
+        {
+            const uint64_t diff = Read64(a) ^ Read64(b);
+            if (diff)
+                return static_cast<size_t>(a - start) + (static_cast<size_t>(std::countr_zero(diff)) >> 3);
+
+            a += 8;
+            b += 8;
+        }
+
+        while ((a < limit) && (*a == *b))
+        {
+            ++a;
+            ++b;
+        }
+
+        return static_cast<size_t>(a - start);
+    }
+
+    inline void WriteLength(uint8_t*& op, size_t length) noexcept
+    {
+        while (length >= 255)
+        {
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<uint8_t>(length);
+    }
+
+    inline void EmitSequence(uint8_t*& op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) noexcept
+    {
+        const size_t ml = matchLength - c_minMatch;
+
+        uint8_t* token = op++;
+        *token = static_cast<uint8_t>(((literalLength >= 15) ? 15u : literalLength) << 4);
+        if (literalLength >= 15)
+            WriteLength(op, literalLength - 15);
+
+        memcpy(op, literals, literalLength);
+        op += literalLength;
+
+        *op++ = static_cast<uint8_t>(offset);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+
+        *token |= static_cast<uint8_t>((ml >= 15) ? 15u : ml);
+        if (ml >= 15)
+            WriteLength(op, ml - 15);
+    }
+
+    inline void EmitLastLiterals(uint8_t*& op, const uint8_t* literals, size_t literalLength) noexcept
+    {
+        *op++ = static_cast<uint8_t>(((literalLength >= 15) ? 15u : literalLength) << 4);
+        if (literalLength >= 15)
+            WriteLength(op, literalLength - 15);
+
+        memcpy(op, literals, literalLength);
+        op += literalLength;
+    }
+
+    inline size_t CompressBound(size_t size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    // Greedy single-probe matcher; pDestination must hold CompressBound(size) bytes
+    size_t CompressFast(const uint8_t* pSource, size_t size, uint8_t* pDestination)
+    {
+        uint8_t* op = pDestination;
+        const uint8_t* anchor = pSource;
+
+        if (size > c_mfLimit)
+        {
+            std::vector<uint32_t> table(size_t(1) << c_fastHashBits, 0);
+
+            const uint8_t* ip         = pSource + 1;
+            const uint8_t* mfLimit    = pSource + size - c_mfLimit;
+            const uint8_t* matchLimit = pSource + size - c_lastLiterals;
+            size_t misses = 0;
+
+            while (ip < mfLimit)
+            {
+                const uint32_t h = Hash4(ip, c_fastHashBits);
+                const uint8_t* candidate = pSource + table[h];
+                table[h] = static_cast<uint32_t>(ip - pSource);
+
+                if ((candidate >= ip) || (size_t(ip - candidate) > c_maxDistance) || (Read32(candidate) != Read32(ip)))
+                {
+                    // Skip faster through incompressible data
+                    ip += 1 + (misses++ >> 6);
+                    continue;
+                }
+
+                while ((ip > anchor) && (candidate > pSource) && (ip[-1] == candidate[-1]))
+                {
+                    --ip;
+                    --candidate;
+                }
+
+                const size_t length = c_minMatch + CountMatch(ip + c_minMatch, candidate + c_minMatch, matchLimit);
+                EmitSequence(op, anchor, size_t(ip - anchor), size_t(ip - candidate), length);
+
+                ip += length;
+                anchor = ip;
+                misses = 0;
+
+                if (ip < mfLimit)
+                    table[Hash4(ip - 2, c_fastHashBits)] = static_cast<uint32_t>(ip - 2 - pSource);
+            }
+        }
+
+        EmitLastLiterals(op, anchor, size_t(pSource + size - anchor));
+        return size_t(op - pDestination);
+    }
+
+    // Hash chain matcher with one step of lazy evaluation
+    class ChainMatcher
+    {
+    public:
+        ChainMatcher(const uint8_t* pSource, size_t size) :
+            m_source(pSource),
+            m_head(size_t(1) << c_highHashBits, -1),
+            m_prev(size, -1),
+            m_next(0)
+        {
+        }
+
+        // Longest match for 'pos' among the earlier positions, 0 if none
+        size_t Find(size_t pos, const uint8_t* matchLimit, size_t& matchPos) noexcept
+        {
+            Insert(pos);
+
+            size_t best = 0;
+            int32_t candidate = m_head[Hash4(m_source + pos, c_highHashBits)];
+            const uint8_t* ip = m_source + pos;
+
+            for (size_t depth = 0; (candidate >= 0) && (depth < c_highMaxDepth); ++depth)
+            {
+                const size_t cpos = static_cast<size_t>(candidate);
+                if (pos - cpos > c_maxDistance)
+                    break;
+
+                const uint8_t* cp = m_source + cpos;
+                if ((cp[best] == ip[best]) && (Read32(cp) == Read32(ip)))
+                {
+                    const size_t length = c_minMatch + CountMatch(ip + c_minMatch, cp + c_minMatch, matchLimit);
+                    if (length > best)
+                    {
+                        best = length;
+                        matchPos = cpos;
+
+                        if (ip + best >= matchLimit)
+                            break;
+                    }
+                }
+
+                candidate = m_prev[cpos];
+            }
+
+            return (best >= c_minMatch) ? best : 0;
+        }
+
+        // Adds the positions before 'pos' to the chains
+        void Insert(size_t pos) noexcept
+        {
+            while (m_next < pos)
+            {
+                const uint32_t h = Hash4(m_source + m_next, c_highHashBits);
+                m_prev[m_next] = m_head[h];
+                m_head[h] = static_cast<int32_t>(m_next);
+                ++m_next;
+            }
+        }
+
+    private:
+        const uint8_t*       m_source;
+        std::vector<int32_t> m_head;
+        std::vector<int32_t> m_prev;
+        size_t               m_next;
+    };
+
+    size_t CompressHigh(const uint8_t* pSource, size_t size, uint8_t* pDestination)
+    {
+        uint8_t* op = pDestination;
+        size_t anchor = 0;
+
+        if (size > c_mfLimit)
+        {
+            ChainMatcher matcher(pSource, size);
+
+            const size_t mfLimit = size - c_mfLimit;
+            const uint8_t* matchLimit = pSource + size - c_lastLiterals;
+            size_t pos = 0;
+
+            while (pos < mfLimit)
+            {
+                size_t matchPos = 0;
+                size_t length = matcher.Find(pos, matchLimit, matchPos);
+                if (!length)
+                {
+                    ++pos;
+                    continue;
+                }
+
+                // Defer by one byte if that yields a longer match
+                while (pos + 1 < mfLimit)
+                {
+                    size_t nextPos = 0;
+                    const size_t nextLength = matcher.Find(pos + 1, matchLimit, nextPos);
+                    if (nextLength <= length)
+                        break;
+
+                    ++pos;
+                    length = nextLength;
+                    matchPos = nextPos;
+                }
+
+                EmitSequence(op, pSource + anchor, pos - anchor, pos - matchPos, length);
+
+                pos += length;
+                anchor = pos;
+                matcher.Insert(std::min(pos, mfLimit));
+            }
+        }
+
+        EmitLastLiterals(op, pSource + anchor, size - anchor);
+        return size_t(op - pDestination);
+    }
+
+    bool ReadLength(const uint8_t*& ip, const uint8_t* iend, size_t limit, size_t& length) noexcept
+    {
+        for (;;)
+        {
+            if (ip >= iend)
+                return false;
+
+            const uint8_t value = *ip++;
+            length += value;
+
+            if (length > limit)
+                return false;
+
+            if (value != 255)
+                return true;
+        }
+    }
+
+    // Bounds-checked decoder, the output must be exactly rawSize bytes
+    bool DecompressLZ(const uint8_t* pSource, size_t size, uint8_t* pDestination, size_t rawSize) noexcept
+    {
+        const uint8_t* ip   = pSource;
+        const uint8_t* iend = pSource + size;
+        uint8_t*       op   = pDestination;
+        uint8_t*       oend = pDestination + rawSize;
+
+        while (ip < iend)
+        {
+            const uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if ((literalLength == 15) && !ReadLength(ip, iend, rawSize, literalLength))
+                return false;
+
+            if ((literalLength > size_t(iend - ip)) || (literalLength > size_t(oend - op)))
+                return false;
+
+            memcpy(op, ip, literalLength);
+            op += literalLength;
+            ip += literalLength;
+
+            if (ip == iend)
+                break;
+
+            if (iend - ip < 2)
+                return false;
+
+            const size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+            ip += 2;
+
+            if (!offset || (offset > size_t(op - pDestination)))
+                return false;
+
+            size_t matchLength = token & 15;
+            if ((matchLength == 15) && !ReadLength(ip, iend, rawSize, matchLength))
+                return false;
+
+            matchLength += c_minMatch;
+            if (matchLength > size_t(oend - op))
+                return false;
+
+            const uint8_t* match = op - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                // Overlapping copy repeats the last 'offset' bytes
+                while (matchLength)
+                {
+                    const size_t count = std::min(offset, matchLength);
+                    memcpy(op, match, count);
+                    op += count;
+                    match += count;
+                    matchLength -= count;
+                }
+            }
+        }
+
+        return op == oend;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Byte shuffle: groups byte 'b' of every element together so float/normalized channels
+    // with slowly varying high bytes turn into long runs
+    void Shuffle(const uint8_t* pSource, size_t size, size_t elementSize, uint8_t* pDestination) noexcept
+    {
+        const size_t count = size / elementSize;
+
+        for (size_t b = 0; b < elementSize; ++b)
+        {
+            const uint8_t* sPtr = pSource + b;
+            uint8_t* dPtr = pDestination + b * count;
+
+            for (size_t i = 0; i < count; ++i, sPtr += elementSize)
+            {
+                dPtr[i] = *sPtr;
+            }
+        }
+
+        const size_t tail = count * elementSize;
+        memcpy(pDestination + tail, pSource + tail, size - tail);
+    }
+
+    void Unshuffle(const uint8_t* pSource, size_t size, size_t elementSize, uint8_t* pDestination) noexcept
+    {
+        const size_t count = size / elementSize;
+
+        for (size_t b = 0; b < elementSize; ++b)
+        {
+            const uint8_t* sPtr = pSource + b * count;
+            uint8_t* dPtr = pDestination + b;
+
+            for (size_t i = 0; i < count; ++i, dPtr += elementSize)
+            {
+                *dPtr = sPtr[i];
+            }
+        }
+
+        const size_t tail = count * elementSize;
+        memcpy(pDestination + tail, pSource + tail, size - tail);
+    }
+
+    //---------------------------------------------------------------------------------
+    struct ChunkSource
+    {
+        size_t image;
+        size_t firstRow;
+        size_t rowCount;
+    };
+
+    // Bytes of one shuffle element: the texel (or block) size
+    size_t GetElementSize(VkFormat format) noexcept
+    {
+        if (IsCompressed(format))
+            return BytesPerBlock(format);
+
+        const size_t bpp = BitsPerPixel(format);
+        return ((bpp % 8) == 0) ? std::max<size_t>(bpp / 8, 1u) : 1u;
+    }
+
+    // Picks the smallest of the candidate encodings for one chunk
+    void EncodeChunk(
+        const uint8_t* pRaw, size_t rawSize, size_t elementSize, SUPERCOMPRESS_MODE mode, bool shuffleFirst,
+        std::vector<uint8_t>& scratch, std::vector<uint8_t>& output, CompressedChunk& chunk)
+    {
+        output.resize(CompressBound(rawSize));
+        scratch.resize(rawSize);
+
+        auto compress = [&](const uint8_t* pSource, uint8_t* pDestination)
+        {
+            return (mode == SUPERCOMPRESS_HIGH)
+                ? CompressHigh(pSource, rawSize, pDestination)
+                : CompressFast(pSource, rawSize, pDestination);
+        };
+
+        size_t bestSize = rawSize;
+        chunk.codec = CHUNK_STORED;
+        chunk.elementSize = 1;
+
+        const bool canShuffle = (elementSize > 1) && (rawSize >= elementSize);
+
+        // FAST commits to one encoding, HIGH tries both and keeps the smaller
+        if (!shuffleFirst || (mode == SUPERCOMPRESS_HIGH) || !canShuffle)
+        {
+            const size_t size = compress(pRaw, output.data());
+            if (size < bestSize)
+            {
+                bestSize = size;
+                chunk.codec = CHUNK_LZ;
+            }
+        }
+
+        if (canShuffle && (shuffleFirst || (mode == SUPERCOMPRESS_HIGH)))
+        {
+            Shuffle(pRaw, rawSize, elementSize, scratch.data());
+
+            std::vector<uint8_t> shuffled(CompressBound(rawSize));
+            const size_t size = compress(scratch.data(), shuffled.data());
+            if (size < bestSize)
+            {
+                bestSize = size;
+                chunk.codec = CHUNK_LZ_SHUFFLE;
+                chunk.elementSize = static_cast<uint16_t>(elementSize);
+                output.swap(shuffled);
+            }
+        }
+
+        if (chunk.codec == CHUNK_STORED)
+            memcpy(output.data(), pRaw, rawSize);
+
+        output.resize(bestSize);
+        chunk.size = static_cast<uint32_t>(bestSize);
+        chunk.rawSize = static_cast<uint32_t>(rawSize);
+    }
+
+    //---------------------------------------------------------------------------------
+    // Supercompressed DDS container
+    //---------------------------------------------------------------------------------
+    constexpr uint32_t c_vtscMagic   = 0x43535456; // "VTSC"
+    constexpr uint32_t c_vtscVersion = 1;
+
+    struct VTSC_HEADER
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t mode;
+        uint32_t headerSize;    // DDS header bytes (magic + DDS_HEADER [+ DX10]) following this header
+        uint32_t chunkCount;
+        uint32_t imageCount;
+        uint64_t chunkOffset;   // CompressedChunk table
+        uint64_t payloadOffset;
+        uint64_t rawSize;       // Size of the plain DDS file
+    };
+
+    static_assert(sizeof(VTSC_HEADER) == 48, "VTSC header size mismatch");
+    static_assert(sizeof(CompressedChunk) == 24, "Chunk index entry size mismatch");
+
+    inline size_t AlignUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool DecodeVTSCHeader(const uint8_t* pSource, size_t size, VTSC_HEADER& header, std::vector<CompressedChunk>& chunks)
+    {
+        if (!pSource || (size < sizeof(VTSC_HEADER)))
+            return false;
+
+        memcpy(&header, pSource, sizeof(header));
+
+        if ((header.magic != c_vtscMagic) || (header.version != c_vtscVersion))
+            return false;
+
+        if ((header.headerSize > size - sizeof(VTSC_HEADER))
+            || (header.chunkOffset > size)
+            || (uint64_t(header.chunkCount) * sizeof(CompressedChunk) > size - header.chunkOffset)
+            || (header.payloadOffset > size)
+            || (header.rawSize < header.headerSize))
+            return false;
+
+        // The table is copied out since the source buffer may not be aligned
+        chunks.resize(header.chunkCount);
+        if (!chunks.empty())
+            memcpy(chunks.data(), pSource + header.chunkOffset, chunks.size() * sizeof(CompressedChunk));
+
+        // Chunks are sorted by subresource and expand to exactly the plain file
+        uint64_t rawSize = header.headerSize;
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            if ((chunks[i].image >= header.imageCount) || (i && (chunks[i].image < chunks[i - 1].image)))
+                return false;
+
+            rawSize += chunks[i].rawSize;
+        }
+
+        return rawSize == header.rawSize;
+    }
+}
+
+
+//=====================================================================================
+// Internal chunk encoding
+//=====================================================================================
+
+bool VulkanTex::Internal::CompressImages(
+    const Image* images,
+    size_t nimages,
+    SUPERCOMPRESS_MODE mode,
+    std::vector<CompressedChunk>& chunks,
+    std::vector<uint8_t>& payload) noexcept
+{
+    chunks.clear();
+    payload.clear();
+
+    if (!images || !nimages || (mode == SUPERCOMPRESS_NONE))
+        return false;
+
+    try
+    {
+        // Split each subresource into runs of whole rows
+        std::vector<ChunkSource> sources;
+
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            const Image& image = images[index];
+            if (!image.pixels)
+                return false;
+
+            size_t rowPitch, slicePitch;
+            if (!ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE)
+                || (rowPitch > image.rowPitch) || (rowPitch > UINT32_MAX))
+                return false;
+
+            const size_t rows = ComputeScanlines(image.format, image.height);
+            const size_t rowsPerChunk = std::max<size_t>(1u, c_chunkTargetSize / rowPitch);
+
+            for (size_t row = 0; row < rows; row += rowsPerChunk)
+            {
+                const size_t count = std::min(rowsPerChunk, rows - row);
+                if (count * rowPitch > UINT32_MAX)
+                    return false;
+
+                sources.push_back({ index, row, count });
+            }
+        }
+
+        chunks.resize(sources.size());
+        std::vector<std::vector<uint8_t>> outputs(sources.size());
+        std::atomic<bool> failed{ false };
+
+        ParallelFor(sources.size(), 1, [&](size_t begin, size_t end) noexcept
+        {
+            try
+            {
+                std::vector<uint8_t> raw, scratch;
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const ChunkSource& source = sources[i];
+                    const Image& image = images[source.image];
+
+                    size_t rowPitch, slicePitch;
+                    ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE);
+
+                    raw.resize(source.rowCount * rowPitch);
+                    const uint8_t* sPtr = image.pixels + source.firstRow * image.rowPitch;
+                    for (size_t y = 0; y < source.rowCount; ++y, sPtr += image.rowPitch)
+                    {
+                        memcpy(raw.data() + y * rowPitch, sPtr, rowPitch);
+                    }
+
+                    CompressedChunk& chunk = chunks[i];
+                    chunk = {};
+                    chunk.image = static_cast<uint32_t>(source.image);
+
+                    // Shuffling pays off for multi-byte texels; block data mostly does not benefit
+                    EncodeChunk(raw.data(), raw.size(), GetElementSize(image.format), mode,
+                        !IsCompressed(image.format), scratch, outputs[i], chunk);
+                }
+            }
+            catch (...)
+            {
+                failed = true;
+            }
+        });
+
+        if (failed)
+            return false;
+
+        size_t total = 0;
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            chunks[i].offset = total;
+            total += outputs[i].size();
+        }
+
+        payload.resize(total);
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            if (!outputs[i].empty())
+                memcpy(payload.data() + chunks[i].offset, outputs[i].data(), outputs[i].size());
+        }
+    }
+    catch (...)
+    {
+        chunks.clear();
+        payload.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool VulkanTex::Internal::DecompressChunk(
+    const CompressedChunk& chunk,
+    const uint8_t* pSource,
+    size_t size,
+    uint8_t* pDestination) noexcept
+{
+    if (!pSource || !pDestination || (chunk.offset > size) || (chunk.size > size - chunk.offset))
+        return false;
+
+    const uint8_t* pData = pSource + chunk.offset;
+
+    switch (chunk.codec)
+    {
+        case CHUNK_STORED:
+            if (chunk.size != chunk.rawSize)
+                return false;
+
+            memcpy(pDestination, pData, chunk.rawSize);
+            return true;
+
+        case CHUNK_LZ:
+            return DecompressLZ(pData, chunk.size, pDestination, chunk.rawSize);
+
+        case CHUNK_LZ_SHUFFLE:
+            try
+            {
+                if (!chunk.elementSize)
+                    return false;
+
+                std::vector<uint8_t> scratch(chunk.rawSize);
+                if (!DecompressLZ(pData, chunk.size, scratch.data(), chunk.rawSize))
+                    return false;
+
+                Unshuffle(scratch.data(), chunk.rawSize, chunk.elementSize, pDestination);
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+
+        default:
+            return false;
+    }
+}
+
+bool VulkanTex::Internal::DecompressChunks(
+    const CompressedChunk* chunks,
+    size_t count,
+    const uint8_t* pSource,
+    size_t size,
+    uint8_t* pDestination,
+    size_t destSize) noexcept
+{
+    if (!count)
+        return destSize == 0;
+
+    if (!chunks || !pDestination)
+        return false;
+
+    try
+    {
+        // Chunks decode back to back, in table order
+        std::vector<size_t> offsets(count);
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            offsets[i] = total;
+            total += chunks[i].rawSize;
+        }
+
+        if (total != destSize)
+            return false;
+
+        std::atomic<bool> failed{ false };
+
+        ParallelFor(count, 1, [&](size_t begin, size_t end) noexcept
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (!DecompressChunk(chunks[i], pSource, size, pDestination + offsets[i]))
+                    failed = true;
+            }
+        });
+
+        return !failed;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool VulkanTex::Internal::SaveSupercompressedDDS(
+    const Image* images,
+    size_t nimages,
+    const TexMetadata& metadata,
+    DDS_FLAGS flags,
+    Blob& blob) noexcept
+{
+    if (!images || !nimages)
+        return false;
+
+    const SUPERCOMPRESS_MODE mode = (flags & DDS_FLAGS_SUPERCOMPRESS_HIGH) ? SUPERCOMPRESS_HIGH : SUPERCOMPRESS_FAST;
+    flags &= ~(DDS_FLAGS_SUPERCOMPRESS_FAST | DDS_FLAGS_SUPERCOMPRESS_HIGH);
+
+    // 24bpp expansion changes the payload rows, which the chunk encoder does not handle
+    if ((flags & DDS_FLAGS_FORCE_24BPP_RGB) && (metadata.format == VK_FORMAT_B8G8R8_UNORM))
+        return false;
+
+    size_t expected = 0, pixelSize = 0;
+    if (!DetermineImageArray(metadata, CP_FLAGS_NONE, expected, pixelSize) || (nimages < expected))
+        return false;
+
+    for (size_t i = 0; i < expected; ++i)
+    {
+        if (images[i].format != metadata.format)
+            return false;
+    }
+
+    try
+    {
+        uint8_t ddsHeader[DDS_DX10_HEADER_SIZE] = {};
+        size_t headerSize = 0;
+
+        bool hr = EncodeDDSHeader(metadata, flags, ddsHeader, sizeof(ddsHeader), headerSize);
+        if (hr == false)
+            return hr;
+
+        // DDS storage order is the image array order
+        std::vector<CompressedChunk> chunks;
+        std::vector<uint8_t> payload;
+        if (!CompressImages(images, expected, mode, chunks, payload))
+            return false;
+
+        VTSC_HEADER header = {};
+        header.magic       = c_vtscMagic;
+        header.version     = c_vtscVersion;
+        header.mode        = mode;
+        header.headerSize  = static_cast<uint32_t>(headerSize);
+        header.chunkCount  = static_cast<uint32_t>(chunks.size());
+        header.imageCount  = static_cast<uint32_t>(expected);
+        header.chunkOffset = AlignUp(sizeof(VTSC_HEADER) + headerSize, alignof(CompressedChunk));
+        header.payloadOffset = AlignUp(header.chunkOffset + chunks.size() * sizeof(CompressedChunk), 16);
+        header.rawSize     = headerSize;
+
+        for (const auto& chunk : chunks)
+        {
+            header.rawSize += chunk.rawSize;
+        }
+
+        const size_t total = static_cast<size_t>(header.payloadOffset) + payload.size();
+
+        hr = blob.Initialize(total);
+        if (hr == false)
+            return hr;
+
+        uint8_t* pDestination = blob.GetBufferPointer();
+        memset(pDestination, 0, total);
+
+        memcpy(pDestination, &header, sizeof(header));
+        memcpy(pDestination + sizeof(header), ddsHeader, headerSize);
+        memcpy(pDestination + header.chunkOffset, chunks.data(), chunks.size() * sizeof(CompressedChunk));
+        memcpy(pDestination + header.payloadOffset, payload.data(), payload.size());
+
+        hr = blob.Trim(total);
+        if (hr == false)
+        {
+            blob.Release();
+            return hr;
+        }
+    }
+    catch (...)
+    {
+        blob.Release();
+        return false;
+    }
+
+    return true;
+}
+
+bool VulkanTex::Internal::GetSupercompressedDDSHeader(
+    const uint8_t* pSource,
+    size_t size,
+    const uint8_t*& pHeader,
+    size_t& headerSize) noexcept
+{
+    try
+    {
+        VTSC_HEADER header;
+        std::vector<CompressedChunk> chunks;
+        if (!DecodeVTSCHeader(pSource, size, header, chunks))
+            return false;
+
+        pHeader    = pSource + sizeof(VTSC_HEADER);
+        headerSize = header.headerSize;
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+
+bool VulkanTex::Internal::DecodeSupercompressedDDS(
+    const uint8_t* pSource,
+    size_t size,
+    size_t headerSize,
+    const std::vector<uint64_t>& offsets,
+    SupercompressedDDSIndex& index) noexcept
+{
+    try
+    {
+        VTSC_HEADER header;
+        if (offsets.empty() || !DecodeVTSCHeader(pSource, size, header, index.chunks))
+            return false;
+
+        const size_t nimages = offsets.size() - 1;
+        if ((header.headerSize != headerSize) || (header.imageCount != nimages)
+            || (header.rawSize != headerSize + offsets.back()))
+            return false;
+
+        // Every subresource must expand to its size in the DDS layout
+        index.firstChunk.assign(nimages + 1, 0);
+
+        size_t chunk = 0;
+        for (size_t image = 0; image < nimages; ++image)
+        {
+            index.firstChunk[image] = chunk;
+
+            uint64_t rawSize = 0;
+            for (; (chunk < index.chunks.size()) && (index.chunks[chunk].image == image); ++chunk)
+            {
+                rawSize += index.chunks[chunk].rawSize;
+            }
+
+            if (rawSize != offsets[image + 1] - offsets[image])
+                return false;
+        }
+
+        index.firstChunk[nimages] = chunk;
+        index.pPayload    = pSource + header.payloadOffset;
+        index.payloadSize = static_cast<size_t>(size - header.payloadOffset);
+        return chunk == index.chunks.size();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Expand a supercompressed DDS container back to a plain DDS file
+//-------------------------------------------------------------------------------------
+bool VulkanTex::IsSupercompressedDDS(const uint8_t* pSource, size_t size) noexcept
+{
+    try
+    {
+        VTSC_HEADER header;
+        std::vector<CompressedChunk> chunks;
+        return DecodeVTSCHeader(pSource, size, header, chunks);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool VulkanTex::DecompressDDSMemory(
+    const uint8_t* pSource,
+    size_t size,
+    Blob& dds) noexcept
+{
+    dds.Release();
+
+    VTSC_HEADER header;
+    std::vector<CompressedChunk> chunks;
+    try
+    {
+        if (!DecodeVTSCHeader(pSource, size, header, chunks))
+            return false;
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    const size_t rawSize = static_cast<size_t>(header.rawSize);
+
+    bool hr = dds.Initialize(rawSize);
+    if (hr == false)
+        return hr;
+
+    uint8_t* pDestination = dds.GetBufferPointer();
+    memcpy(pDestination, pSource + sizeof(VTSC_HEADER), header.headerSize);
+
+    hr = DecompressChunks(chunks.data(), chunks.size(),
+        pSource + header.payloadOffset, static_cast<size_t>(size - header.payloadOffset),
+        pDestination + header.headerSize, rawSize - header.headerSize);
+
+    if (hr)
+        hr = dds.Trim(rawSize);
+
+    if (hr == false)
+        dds.Release();
+
+    return hr;
+}
+
+bool VulkanTex::DecompressDDSFile(const char* szSource, const char* szDestination) noexcept
+{
+    if (!szSource || !szDestination)
+        return false;
+
+    try
+    {
+        std::ifstream inFile{ std::filesystem::path(szSource), std::ios::in | std::ios::binary | std::ios::ate };
+        if (!inFile)
+            return false;
+
+        std::vector<uint8_t> source(static_cast<size_t>(inFile.tellg()));
+        inFile.seekg(0);
+        inFile.read(reinterpret_cast<char*>(source.data()), static_cast<std::streamsize>(source.size()));
+        if (!inFile)
+            return false;
+
+        Blob dds;
+        bool hr = DecompressDDSMemory(source.data(), source.size(), dds);
+        if (hr == false)
+            return hr;
+
+        std::ofstream outFile{ std::filesystem::path(szDestination), std::ios::out | std::ios::binary | std::ios::trunc };
+        if (!outFile)
+            return false;
+
+        outFile.write(reinterpret_cast<const char*>(dds.GetBufferPointer()), static_cast<std::streamsize>(dds.GetBufferSize()));
+        return static_cast<bool>(outFile);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+//-------------------------------------------------------------------------------------
+// Random access to one subresource (DDS storage order) of a supercompressed container
+//-------------------------------------------------------------------------------------
+bool VulkanTex::DecompressDDSSubresource(
+    const uint8_t* pSource,
+    size_t size,
+    size_t index,
+    Blob& data) noexcept
+{
+    data.Release();
+
+    VTSC_HEADER header;
+    std::vector<CompressedChunk> chunks;
+    try
+    {
+        if (!DecodeVTSCHeader(pSource, size, header, chunks) || (index >= header.imageCount))
+            return false;
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    // Chunks are sorted by subresource
+    const CompressedChunk* first = std::lower_bound(chunks.data(), chunks.data() + chunks.size(), index,
+        [](const CompressedChunk& chunk, size_t value) { return chunk.image < value; });
+
+    const CompressedChunk* last = first;
+    size_t rawSize = 0;
+    while ((last != chunks.data() + chunks.size()) && (last->image == index))
+    {
+        rawSize += last->rawSize;
+        ++last;
+    }
+
+    if (!rawSize)
+        return false;
+
+    bool hr = data.Initialize(rawSize);
+    if (hr == false)
+        return hr;
+
+    hr = DecompressChunks(first, size_t(last - first),
+        pSource + header.payloadOffset, static_cast<size_t>(size - header.payloadOffset),
+        data.GetBufferPointer(), rawSize);
+
+    if (hr)
+        hr = data.Trim(rawSize);
+
+    if (hr == false)
+        data.Release();
+
+    return hr;
+}
@@ -0,0 +1,1213 @@
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    enum COMPONENT_TYPE : uint8_t
+    {
+        COMPONENT_UNORM,
+        COMPONENT_SNORM,
+        COMPONENT_UINT,
+        COMPONENT_SINT,
+        COMPONENT_SFLOAT,
+    };
+
+    // Formats made of whole 8/16/32-bit components in memory order
+    struct PlainFormat
+    {
+        COMPONENT_TYPE type;
+        uint8_t        bytes;       // Per component
+        uint8_t        channels;
+        bool           bgr;         // Memory order is B, G, R(, A)
+    };
+
+    // Formats packed into a single 8/16/32-bit word
+    struct PackedFormat
+    {
+        COMPONENT_TYPE type;        // COMPONENT_UNORM or COMPONENT_UINT
+        uint8_t        bytes;
+        uint8_t        shift[4];    // r, g, b, a
+        uint8_t        bits[4];     // 0 if the channel is absent
+    };
+
+    bool GetPlainFormat(VkFormat format, PlainFormat& desc) noexcept
+    {
+        desc = {};
+
+        auto set = [&desc](COMPONENT_TYPE type, uint8_t bytes, uint8_t channels, bool bgr = false) noexcept
+        {
+            desc.type     = type;
+            desc.bytes    = bytes;
+            desc.channels = channels;
+            desc.bgr      = bgr;
+            return true;
+        };
+
+        switch (format)
+        {
+            case VK_FORMAT_R8_UNORM:
+            case VK_FORMAT_R8_SRGB:                 return set(COMPONENT_UNORM, 1, 1);
+            case VK_FORMAT_R8_SNORM:                return set(COMPONENT_SNORM, 1, 1);
+            case VK_FORMAT_R8_UINT:                 return set(COMPONENT_UINT, 1, 1);
+            case VK_FORMAT_R8_SINT:                 return set(COMPONENT_SINT, 1, 1);
+
+            case VK_FORMAT_R8G8_UNORM:
+            case VK_FORMAT_R8G8_SRGB:               return set(COMPONENT_UNORM, 1, 2);
+            case VK_FORMAT_R8G8_SNORM:              return set(COMPONENT_SNORM, 1, 2);
+            case VK_FORMAT_R8G8_UINT:               return set(COMPONENT_UINT, 1, 2);
+            case VK_FORMAT_R8G8_SINT:               return set(COMPONENT_SINT, 1, 2);
+
+            case VK_FORMAT_R8G8B8_UNORM:
+            case VK_FORMAT_R8G8B8_SRGB:             return set(COMPONENT_UNORM, 1, 3);
+            case VK_FORMAT_R8G8B8_SNORM:            return set(COMPONENT_SNORM, 1, 3);
+            case VK_FORMAT_R8G8B8_UINT:             return set(COMPONENT_UINT, 1, 3);
+            case VK_FORMAT_R8G8B8_SINT:             return set(COMPONENT_SINT, 1, 3);
+
+            case VK_FORMAT_B8G8R8_UNORM:
+            case VK_FORMAT_B8G8R8_SRGB:             return set(COMPONENT_UNORM, 1, 3, true);
+            case VK_FORMAT_B8G8R8_SNORM:            return set(COMPONENT_SNORM, 1, 3, true);
+            case VK_FORMAT_B8G8R8_UINT:             return set(COMPONENT_UINT, 1, 3, true);
+            case VK_FORMAT_B8G8R8_SINT:             return set(COMPONENT_SINT, 1, 3, true);
+
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+            case VK_FORMAT_A8B8G8R8_SRGB_PACK32:    return set(COMPONENT_UNORM, 1, 4);
+            case VK_FORMAT_R8G8B8A8_SNORM:
+            case VK_FORMAT_A8B8G8R8_SNORM_PACK32:   return set(COMPONENT_SNORM, 1, 4);
+            case VK_FORMAT_R8G8B8A8_UINT:
+            case VK_FORMAT_A8B8G8R8_UINT_PACK32:    return set(COMPONENT_UINT, 1, 4);
+            case VK_FORMAT_R8G8B8A8_SINT:
+            case VK_FORMAT_A8B8G8R8_SINT_PACK32:    return set(COMPONENT_SINT, 1, 4);
+
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:           return set(COMPONENT_UNORM, 1, 4, true);
+            case VK_FORMAT_B8G8R8A8_SNORM:          return set(COMPONENT_SNORM, 1, 4, true);
+            case VK_FORMAT_B8G8R8A8_UINT:           return set(COMPONENT_UINT, 1, 4, true);
+            case VK_FORMAT_B8G8R8A8_SINT:           return set(COMPONENT_SINT, 1, 4, true);
+
+            case VK_FORMAT_R16_UNORM:
+            case VK_FORMAT_D16_UNORM:               return set(COMPONENT_UNORM, 2, 1);
+            case VK_FORMAT_R16_SNORM:               return set(COMPONENT_SNORM, 2, 1);
+            case VK_FORMAT_R16_UINT:                return set(COMPONENT_UINT, 2, 1);
+            case VK_FORMAT_R16_SINT:                return set(COMPONENT_SINT, 2, 1);
+            case VK_FORMAT_R16_SFLOAT:              return set(COMPONENT_SFLOAT, 2, 1);
+
+            case VK_FORMAT_R16G16_UNORM:            return set(COMPONENT_UNORM, 2, 2);
+            case VK_FORMAT_R16G16_SNORM:            return set(COMPONENT_SNORM, 2, 2);
+            case VK_FORMAT_R16G16_UINT:             return set(COMPONENT_UINT, 2, 2);
+            case VK_FORMAT_R16G16_SINT:             return set(COMPONENT_SINT, 2, 2);
+            case VK_FORMAT_R16G16_SFLOAT:           return set(COMPONENT_SFLOAT, 2, 2);
+
+            case VK_FORMAT_R16G16B16_UNORM:         return set(COMPONENT_UNORM, 2, 3);
+            case VK_FORMAT_R16G16B16_SNORM:         return set(COMPONENT_SNORM, 2, 3);
+            case VK_FORMAT_R16G16B16_UINT:          return set(COMPONENT_UINT, 2, 3);
+            case VK_FORMAT_R16G16B16_SINT:          return set(COMPONENT_SINT, 2, 3);
+            case VK_FORMAT_R16G16B16_SFLOAT:        return set(COMPONENT_SFLOAT, 2, 3);
+
+            case VK_FORMAT_R16G16B16A16_UNORM:      return set(COMPONENT_UNORM, 2, 4);
+            case VK_FORMAT_R16G16B16A16_SNORM:      return set(COMPONENT_SNORM, 2, 4);
+            case VK_FORMAT_R16G16B16A16_UINT:       return set(COMPONENT_UINT, 2, 4);
+            case VK_FORMAT_R16G16B16A16_SINT:       return set(COMPONENT_SINT, 2, 4);
+            case VK_FORMAT_R16G16B16A16_SFLOAT:     return set(COMPONENT_SFLOAT, 2, 4);
+
+            case VK_FORMAT_R32_UINT:                return set(COMPONENT_UINT, 4, 1);
+            case VK_FORMAT_R32_SINT:                return set(COMPONENT_SINT, 4, 1);
+            case VK_FORMAT_R32_SFLOAT:
+            case VK_FORMAT_D32_SFLOAT:              return set(COMPONENT_SFLOAT, 4, 1);
+
+            case VK_FORMAT_R32G32_UINT:             return set(COMPONENT_UINT, 4, 2);
+            case VK_FORMAT_R32G32_SINT:             return set(COMPONENT_SINT, 4, 2);
+            case VK_FORMAT_R32G32_SFLOAT:           return set(COMPONENT_SFLOAT, 4, 2);
+
+            case VK_FORMAT_R32G32B32_UINT:          return set(COMPONENT_UINT, 4, 3);
+            case VK_FORMAT_R32G32B32_SINT:          return set(COMPONENT_SINT, 4, 3);
+            case VK_FORMAT_R32G32B32_SFLOAT:        return set(COMPONENT_SFLOAT, 4, 3);
+
+            case VK_FORMAT_R32G32B32A32_UINT:       return set(COMPONENT_UINT, 4, 4);
+            case VK_FORMAT_R32G32B32A32_SINT:       return set(COMPONENT_SINT, 4, 4);
+            case VK_FORMAT_R32G32B32A32_SFLOAT:     return set(COMPONENT_SFLOAT, 4, 4);
+
+            default:
+                return false;
+        }
+    }
+
+    bool GetPackedFormat(VkFormat format, PackedFormat& desc) noexcept
+    {
+        auto set = [&desc](COMPONENT_TYPE type, uint8_t bytes,
+            uint8_t rShift, uint8_t rBits, uint8_t gShift, uint8_t gBits,
+            uint8_t bShift, uint8_t bBits, uint8_t aShift, uint8_t aBits) noexcept
+        {
+            desc = { type, bytes, { rShift, gShift, bShift, aShift }, { rBits, gBits, bBits, aBits } };
+            return true;
+        };
+
+        switch (format)
+        {
+            case VK_FORMAT_R4G4_UNORM_PACK8:            return set(COMPONENT_UNORM, 1, 4, 4, 0, 4, 0, 0, 0, 0);
+            case VK_FORMAT_R4G4B4A4_UNORM_PACK16:       return set(COMPONENT_UNORM, 2, 12, 4, 8, 4, 4, 4, 0, 4);
+            case VK_FORMAT_B4G4R4A4_UNORM_PACK16:       return set(COMPONENT_UNORM, 2, 4, 4, 8, 4, 12, 4, 0, 4);
+            case VK_FORMAT_R5G6B5_UNORM_PACK16:         return set(COMPONENT_UNORM, 2, 11, 5, 5, 6, 0, 5, 0, 0);
+            case VK_FORMAT_B5G6R5_UNORM_PACK16:         return set(COMPONENT_UNORM, 2, 0, 5, 5, 6, 11, 5, 0, 0);
+            case VK_FORMAT_R5G5B5A1_UNORM_PACK16:       return set(COMPONENT_UNORM, 2, 11, 5, 6, 5, 1, 5, 0, 1);
+            case VK_FORMAT_B5G5R5A1_UNORM_PACK16:       return set(COMPONENT_UNORM, 2, 1, 5, 6, 5, 11, 5, 0, 1);
+            case VK_FORMAT_A1R5G5B5_UNORM_PACK16:       return set(COMPONENT_UNORM, 2, 10, 5, 5, 5, 0, 5, 15, 1);
+            case VK_FORMAT_A2B10G10R10_UNORM_PACK32:    return set(COMPONENT_UNORM, 4, 0, 10, 10, 10, 20, 10, 30, 2);
+            case VK_FORMAT_A2B10G10R10_UINT_PACK32:     return set(COMPONENT_UINT, 4, 0, 10, 10, 10, 20, 10, 30, 2);
+            case VK_FORMAT_A2R10G10B10_UNORM_PACK32:    return set(COMPONENT_UNORM, 4, 20, 10, 10, 10, 0, 10, 30, 2);
+            case VK_FORMAT_A2R10G10B10_UINT_PACK32:     return set(COMPONENT_UINT, 4, 20, 10, 10, 10, 0, 10, 30, 2);
+
+            default:
+                return false;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Small float formats
+    //---------------------------------------------------------------------------------
+    inline float UFloatToFloat(uint32_t value, uint32_t mantissaBits) noexcept
+    {
+        const uint32_t exponent = value >> mantissaBits;
+        const uint32_t mantissa = value & ((1u << mantissaBits) - 1u);
+
+        uint32_t bits;
+        if (exponent == 0x1F)
+        {
+            bits = 0x7F800000u | (mantissa << (23 - mantissaBits));
+        }
+        else if (exponent != 0)
+        {
+            bits = ((exponent + 112u) << 23) | (mantissa << (23 - mantissaBits));
+        }
+        else
+        {
+            // Denormal: mantissa * 2^(-14 - mantissaBits)
+            return static_cast<float>(mantissa) * std::ldexp(1.f, -14 - static_cast<int>(mantissaBits));
+        }
+
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    inline uint32_t FloatToUFloat(float value, uint32_t mantissaBits) noexcept
+    {
+        // Negative and NaN map to zero, overflow saturates to the largest finite value
+        if (!(value > 0.f))
+            return 0;
+
+        const uint32_t maxValue = (0x1Eu << mantissaBits) | ((1u << mantissaBits) - 1u);
+
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        if (bits >= 0x7F800000u)
+            return maxValue;
+
+        if (bits < 0x38800000u)
+        {
+            // Denormal result
+            const float scaled = value * std::ldexp(1.f, 14 + static_cast<int>(mantissaBits));
+            return std::min(static_cast<uint32_t>(scaled + 0.5f), 1u << mantissaBits);
+        }
+
+        const uint32_t shift = 23 - mantissaBits;
+        bits -= 0x38000000u;
+        bits = (bits + ((1u << (shift - 1)) - 1u) + ((bits >> shift) & 1u)) >> shift;
+
+        return std::min(bits, maxValue);
+    }
+
+    inline void LoadRGB9E5(uint32_t value, Float4& out) noexcept
+    {
+        const float scale = std::ldexp(1.f, static_cast<int>(value >> 27) - 15 - 9);
+        out.x = static_cast<float>(value & 0x1FF) * scale;
+        out.y = static_cast<float>((value >> 9) & 0x1FF) * scale;
+        out.z = static_cast<float>((value >> 18) & 0x1FF) * scale;
+        out.w = 1.f;
+    }
+
+    inline uint32_t StoreRGB9E5(const Float4& in) noexcept
+    {
+        static constexpr float c_maxValue = 65408.f; // (2^9 - 1) / 2^9 * 2^16
+
+        auto clampValue = [](float v) noexcept { return (v > 0.f) ? std::min(v, c_maxValue) : 0.f; };
+
+        const float r = clampValue(in.x);
+        const float g = clampValue(in.y);
+        const float b = clampValue(in.z);
+        const float maxColor = std::max(std::max(r, g), b);
+
+        if (maxColor <= 0.f)
+            return 0;
+
+        int exponent = 0;
+        std::frexp(maxColor, &exponent);
+
+        // floor(log2(maxColor)) == exponent - 1
+        int sharedExponent = std::max(-16, exponent - 1) + 16;
+
+        float scale = std::ldexp(1.f, 15 + 9 - sharedExponent);
+        if (static_cast<uint32_t>(maxColor * scale + 0.5f) == 512u)
+        {
+            ++sharedExponent;
+            scale *= 0.5f;
+        }
+
+        const uint32_t rm = std::min(static_cast<uint32_t>(r * scale + 0.5f), 511u);
+        const uint32_t gm = std::min(static_cast<uint32_t>(g * scale + 0.5f), 511u);
+        const uint32_t bm = std::min(static_cast<uint32_t>(b * scale + 0.5f), 511u);
+
+        return rm | (gm << 9) | (bm << 18) | (static_cast<uint32_t>(sharedExponent) << 27);
+    }
+
+    //---------------------------------------------------------------------------------
+    // Scanline kernels
+    //---------------------------------------------------------------------------------
+    template<typename T>
+    void LoadComponents(
+        Float4* pDestination, size_t count, const uint8_t* pSource,
+        size_t channels, float scale, float minimum) noexcept
+    {
+        auto src = reinterpret_cast<const T*>(pSource);
+
+        for (size_t i = 0; i < count; ++i, src += channels)
+        {
+            float c[4] = { 0.f, 0.f, 0.f, 1.f };
+
+            for (size_t ch = 0; ch < channels; ++ch)
+            {
+                c[ch] = std::max(static_cast<float>(src[ch]) * scale, minimum);
+            }
+
+            pDestination[i] = { c[0], c[1], c[2], c[3] };
+        }
+    }
+
+    // Half conversion runs in blocks through the bulk kernels, then the channels are spread out
+    constexpr size_t c_halfBlock = 256;
+
+    void LoadHalfComponents(Float4* pDestination, size_t count, const uint8_t* pSource, size_t channels) noexcept
+    {
+        auto src = reinterpret_cast<const uint16_t*>(pSource);
+
+        if (channels == 4)
+        {
+            HalfToFloatRow(&pDestination->x, src, count * 4);
+            return;
+        }
+
+        float block[c_halfBlock];
+        const size_t pixelsPerBlock = c_halfBlock / channels;
+
+        for (size_t i = 0; i < count; i += pixelsPerBlock)
+        {
+            const size_t n = std::min(pixelsPerBlock, count - i);
+            HalfToFloatRow(block, src + i * channels, n * channels);
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                float c[4] = { 0.f, 0.f, 0.f, 1.f };
+
+                for (size_t ch = 0; ch < channels; ++ch)
+                {
+                    c[ch] = block[j * channels + ch];
+                }
+
+                pDestination[i + j] = { c[0], c[1], c[2], c[3] };
+            }
+        }
+    }
+
+    void StoreHalfComponents(uint8_t* pDestination, size_t count, const Float4* pSource, size_t channels) noexcept
+    {
+        auto dest = reinterpret_cast<uint16_t*>(pDestination);
+
+        if (channels == 4)
+        {
+            FloatToHalfRow(dest, &pSource->x, count * 4);
+            return;
+        }
+
+        float block[c_halfBlock];
+        const size_t pixelsPerBlock = c_halfBlock / channels;
+
+        for (size_t i = 0; i < count; i += pixelsPerBlock)
+        {
+            const size_t n = std::min(pixelsPerBlock, count - i);
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                const float* c = &pSource[i + j].x;
+
+                for (size_t ch = 0; ch < channels; ++ch)
+                {
+                    block[j * channels + ch] = c[ch];
+                }
+            }
+
+            FloatToHalfRow(dest + i * channels, block, n * channels);
+        }
+    }
+
+    void LoadUNorm8x4(Float4* pDestination, size_t count, const uint8_t* pSource) noexcept
+    {
+#if VULKANTEX_SSE2
+        const __m128  scale = _mm_set1_ps(1.f / 255.f);
+        const __m128i zero  = _mm_setzero_si128();
+
+        for (size_t i = 0; i < count; ++i, pSource += 4)
+        {
+            int32_t packed;
+            memcpy(&packed, pSource, sizeof(packed));
+
+            __m128i v = _mm_cvtsi32_si128(packed);
+            v = _mm_unpacklo_epi8(v, zero);
+            v = _mm_unpacklo_epi16(v, zero);
+            _mm_store_ps(&pDestination[i].x, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+        }
+#else
+        LoadComponents<uint8_t>(pDestination, count, pSource, 4, 1.f / 255.f, 0.f);
+#endif
+    }
+
+    template<typename T>
+    inline T PackComponent(float value, float scale, float minimum, float maximum) noexcept
+    {
+        // NaN saturates to the minimum
+        value = (value >= minimum) ? std::min(value, maximum) : minimum;
+        value *= scale;
+        value = (value >= 0.f) ? (value + 0.5f) : (value - 0.5f);
+        return static_cast<T>(value);
+    }
+
+    template<typename T>
+    void StoreComponents(
+        uint8_t* pDestination, size_t count, const Float4* pSource,
+        size_t channels, const size_t* order,
+        float scale, float minimum, float maximum) noexcept
+    {
+        auto dest = reinterpret_cast<T*>(pDestination);
+
+        for (size_t i = 0; i < count; ++i, dest += channels)
+        {
+            const float* c = &pSource[i].x;
+
+            for (size_t ch = 0; ch < channels; ++ch)
+            {
+                dest[ch] = PackComponent<T>(c[order[ch]], scale, minimum, maximum);
+            }
+        }
+    }
+
+    void StoreUNorm8x4(uint8_t* pDestination, size_t count, const Float4* pSource, bool bgr) noexcept
+    {
+#if VULKANTEX_SSE2
+        const __m128 zero  = _mm_setzero_ps();
+        const __m128 one   = _mm_set1_ps(1.f);
+        const __m128 scale = _mm_set1_ps(255.f);
+
+        for (size_t i = 0; i < count; ++i, pDestination += 4)
+        {
+            __m128 v = _mm_load_ps(&pSource[i].x);
+            if (bgr)
+                v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2));
+
+            // max(v, 0) with v as the second operand maps NaN to zero
+            v = _mm_min_ps(_mm_max_ps(v, zero), one);
+
+            __m128i n = _mm_cvtps_epi32(_mm_mul_ps(v, scale));
+            n = _mm_packs_epi32(n, n);
+            n = _mm_packus_epi16(n, n);
+
+            const int32_t packed = _mm_cvtsi128_si32(n);
+            memcpy(pDestination, &packed, sizeof(packed));
+        }
+#else
+        static constexpr size_t c_rgba[4] = { 0, 1, 2, 3 };
+        static constexpr size_t c_bgra[4] = { 2, 1, 0, 3 };
+        StoreComponents<uint8_t>(pDestination, count, pSource, 4, bgr ? c_bgra : c_rgba, 255.f, 0.f, 1.f);
+#endif
+    }
+
+    // Range of an integer component in float, clamped to values float can represent exactly
+    template<typename T>
+    void GetIntegerRange(COMPONENT_TYPE type, float& minimum, float& maximum) noexcept
+    {
+        if (type == COMPONENT_UINT)
+        {
+            minimum = 0.f;
+            maximum = (sizeof(T) == 4) ? 4294967040.f : static_cast<float>((uint64_t(1) << (sizeof(T) * 8)) - 1u);
+        }
+        else
+        {
+            minimum = -static_cast<float>(uint64_t(1) << (sizeof(T) * 8 - 1));
+            maximum = (sizeof(T) == 4) ? 2147483520.f : static_cast<float>((uint64_t(1) << (sizeof(T) * 8 - 1)) - 1u);
+        }
+    }
+}
+
+
+//=====================================================================================
+// Scanline load/store
+//=====================================================================================
+bool VulkanTex::Internal::IsConvertible(VkFormat fmt) noexcept
+{
+    PlainFormat  plain;
+    PackedFormat packed;
+
+    return GetPlainFormat(fmt, plain)
+        || GetPackedFormat(fmt, packed)
+        || (fmt == VK_FORMAT_B10G11R11_UFLOAT_PACK32)
+        || (fmt == VK_FORMAT_E5B9G9R9_UFLOAT_PACK32);
+}
+
+bool VulkanTex::Internal::LoadScanline(
+    Float4* pDestination, size_t count,
+    const uint8_t* pSource, size_t size, VkFormat format) noexcept
+{
+    if (!pDestination || !count || !pSource || !size)
+        return false;
+
+    PlainFormat plain;
+    if (GetPlainFormat(format, plain))
+    {
+        const size_t pixelSize = size_t(plain.bytes) * plain.channels;
+        count = std::min(count, size / pixelSize);
+
+        switch (plain.bytes)
+        {
+            case 1:
+                switch (plain.type)
+                {
+                    case COMPONENT_UNORM:
+                        if (plain.channels == 4)
+                            LoadUNorm8x4(pDestination, count, pSource);
+                        else
+                            LoadComponents<uint8_t>(pDestination, count, pSource, plain.channels, 1.f / 255.f, 0.f);
+                        break;
+                    case COMPONENT_SNORM: LoadComponents<int8_t>(pDestination, count, pSource, plain.channels, 1.f / 127.f, -1.f); break;
+                    case COMPONENT_UINT:  LoadComponents<uint8_t>(pDestination, count, pSource, plain.channels, 1.f, 0.f); break;
+                    case COMPONENT_SINT:  LoadComponents<int8_t>(pDestination, count, pSource, plain.channels, 1.f, -128.f); break;
+                    default:              return false;
+                }
+                break;
+
+            case 2:
+                switch (plain.type)
+                {
+                    case COMPONENT_UNORM:  LoadComponents<uint16_t>(pDestination, count, pSource, plain.channels, 1.f / 65535.f, 0.f); break;
+                    case COMPONENT_SNORM:  LoadComponents<int16_t>(pDestination, count, pSource, plain.channels, 1.f / 32767.f, -1.f); break;
+                    case COMPONENT_UINT:   LoadComponents<uint16_t>(pDestination, count, pSource, plain.channels, 1.f, 0.f); break;
+                    case COMPONENT_SINT:   LoadComponents<int16_t>(pDestination, count, pSource, plain.channels, 1.f, -32768.f); break;
+                    case COMPONENT_SFLOAT: LoadHalfComponents(pDestination, count, pSource, plain.channels); break;
+                }
+                break;
+
+            case 4:
+                switch (plain.type)
+                {
+                    case COMPONENT_UINT:   LoadComponents<uint32_t>(pDestination, count, pSource, plain.channels, 1.f, 0.f); break;
+                    case COMPONENT_SINT:   LoadComponents<int32_t>(pDestination, count, pSource, plain.channels, 1.f, -2147483648.f); break;
+                    case COMPONENT_SFLOAT: LoadComponents<float>(pDestination, count, pSource, plain.channels, 1.f, -HUGE_VALF); break;
+                    default:               return false;
+                }
+                break;
+
+            default:
+                return false;
+        }
+
+        if (plain.bgr)
+        {
+            for (size_t i = 0; i < count; ++i)
+                std::swap(pDestination[i].x, pDestination[i].z);
+        }
+
+        return true;
+    }
+
+    PackedFormat packed;
+    if (GetPackedFormat(format, packed))
+    {
+        count = std::min(count, size / packed.bytes);
+
+        float scale[4];
+        for (size_t ch = 0; ch < 4; ++ch)
+        {
+            scale[ch] = (packed.type == COMPONENT_UNORM && packed.bits[ch])
+                ? 1.f / static_cast<float>((1u << packed.bits[ch]) - 1u) : 1.f;
+        }
+
+        for (size_t i = 0; i < count; ++i, pSource += packed.bytes)
+        {
+            uint32_t value = 0;
+            switch (packed.bytes)
+            {
+                case 1:  value = *pSource; break;
+                case 2:  { uint16_t v; memcpy(&v, pSource, sizeof(v)); value = v; break; }
+                default: memcpy(&value, pSource, sizeof(value)); break;
+            }
+
+            float c[4] = { 0.f, 0.f, 0.f, 1.f };
+            for (size_t ch = 0; ch < 4; ++ch)
+            {
+                if (packed.bits[ch])
+                {
+                    c[ch] = static_cast<float>((value >> packed.shift[ch]) & ((1u << packed.bits[ch]) - 1u)) * scale[ch];
+                }
+            }
+
+            pDestination[i] = { c[0], c[1], c[2], c[3] };
+        }
+
+        return true;
+    }
+
+    switch (format)
+    {
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+            count = std::min(count, size / sizeof(uint32_t));
+            for (size_t i = 0; i < count; ++i, pSource += sizeof(uint32_t))
+            {
+                uint32_t value;
+                memcpy(&value, pSource, sizeof(value));
+
+                pDestination[i] = {
+                    UFloatToFloat(value & 0x7FF, 6),
+                    UFloatToFloat((value >> 11) & 0x7FF, 6),
+                    UFloatToFloat((value >> 22) & 0x3FF, 5),
+                    1.f };
+            }
+            return true;
+
+        case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+            count = std::min(count, size / sizeof(uint32_t));
+            for (size_t i = 0; i < count; ++i, pSource += sizeof(uint32_t))
+            {
+                uint32_t value;
+                memcpy(&value, pSource, sizeof(value));
+                LoadRGB9E5(value, pDestination[i]);
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool VulkanTex::Internal::StoreScanline(
+    uint8_t* pDestination, size_t size, VkFormat format,
+    const Float4* pSource, size_t count, float threshold) noexcept
+{
+    if (!pDestination || !size || !pSource || !count)
+        return false;
+
+    PlainFormat plain;
+    if (GetPlainFormat(format, plain))
+    {
+        const size_t pixelSize = size_t(plain.bytes) * plain.channels;
+        count = std::min(count, size / pixelSize);
+
+        static constexpr size_t c_rgba[4] = { 0, 1, 2, 3 };
+        static constexpr size_t c_bgra[4] = { 2, 1, 0, 3 };
+
+        const size_t* order = plain.bgr ? c_bgra : c_rgba;
+        float minimum, maximum;
+
+        switch (plain.bytes)
+        {
+            case 1:
+                switch (plain.type)
+                {
+                    case COMPONENT_UNORM:
+                        if (plain.channels == 4)
+                            StoreUNorm8x4(pDestination, count, pSource, plain.bgr);
+                        else
+                            StoreComponents<uint8_t>(pDestination, count, pSource, plain.channels, order, 255.f, 0.f, 1.f);
+                        break;
+                    case COMPONENT_SNORM:
+                        StoreComponents<int8_t>(pDestination, count, pSource, plain.channels, order, 127.f, -1.f, 1.f);
+                        break;
+                    case COMPONENT_UINT:
+                    case COMPONENT_SINT:
+                        if (plain.type == COMPONENT_UINT)
+                        {
+                            GetIntegerRange<uint8_t>(plain.type, minimum, maximum);
+                            StoreComponents<uint8_t>(pDestination, count, pSource, plain.channels, order, 1.f, minimum, maximum);
+                        }
+                        else
+                        {
+                            GetIntegerRange<int8_t>(plain.type, minimum, maximum);
+                            StoreComponents<int8_t>(pDestination, count, pSource, plain.channels, order, 1.f, minimum, maximum);
+                        }
+                        break;
+                    default:
+                        return false;
+                }
+                return true;
+
+            case 2:
+                switch (plain.type)
+                {
+                    case COMPONENT_UNORM:
+                        StoreComponents<uint16_t>(pDestination, count, pSource, plain.channels, order, 65535.f, 0.f, 1.f);
+                        break;
+                    case COMPONENT_SNORM:
+                        StoreComponents<int16_t>(pDestination, count, pSource, plain.channels, order, 32767.f, -1.f, 1.f);
+                        break;
+                    case COMPONENT_UINT:
+                        GetIntegerRange<uint16_t>(plain.type, minimum, maximum);
+                        StoreComponents<uint16_t>(pDestination, count, pSource, plain.channels, order, 1.f, minimum, maximum);
+                        break;
+                    case COMPONENT_SINT:
+                        GetIntegerRange<int16_t>(plain.type, minimum, maximum);
+                        StoreComponents<int16_t>(pDestination, count, pSource, plain.channels, order, 1.f, minimum, maximum);
+                        break;
+                    case COMPONENT_SFLOAT:
+                        StoreHalfComponents(pDestination, count, pSource, plain.channels);
+                        break;
+                }
+                return true;
+
+            case 4:
+                switch (plain.type)
+                {
+                    case COMPONENT_UINT:
+                        GetIntegerRange<uint32_t>(plain.type, minimum, maximum);
+                        StoreComponents<uint32_t>(pDestination, count, pSource, plain.channels, order, 1.f, minimum, maximum);
+                        break;
+                    case COMPONENT_SINT:
+                        GetIntegerRange<int32_t>(plain.type, minimum, maximum);
+                        StoreComponents<int32_t>(pDestination, count, pSource, plain.channels, order, 1.f, minimum, maximum);
+                        break;
+                    case COMPONENT_SFLOAT:
+                    {
+                        auto dest = reinterpret_cast<float*>(pDestination);
+                        for (size_t i = 0; i < count; ++i, dest += plain.channels)
+                            memcpy(dest, &pSource[i].x, sizeof(float) * plain.channels);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    PackedFormat packed;
+    if (GetPackedFormat(format, packed))
+    {
+        count = std::min(count, size / packed.bytes);
+
+        for (size_t i = 0; i < count; ++i, pDestination += packed.bytes)
+        {
+            const float* c = &pSource[i].x;
+            uint32_t value = 0;
+
+            for (size_t ch = 0; ch < 4; ++ch)
+            {
+                if (!packed.bits[ch])
+                    continue;
+
+                const uint32_t maxValue = (1u << packed.bits[ch]) - 1u;
+                uint32_t       n;
+
+                if (packed.bits[ch] == 1)
+                {
+                    // 1-bit channels (alpha) use the caller's cutoff
+                    n = (c[ch] > threshold) ? 1u : 0u;
+                }
+                else if (packed.type == COMPONENT_UNORM)
+                {
+                    n = PackComponent<uint32_t>(c[ch], static_cast<float>(maxValue), 0.f, 1.f);
+                }
+                else
+                {
+                    n = PackComponent<uint32_t>(c[ch], 1.f, 0.f, static_cast<float>(maxValue));
+                }
+
+                value |= n << packed.shift[ch];
+            }
+
+            switch (packed.bytes)
+            {
+                case 1:  *pDestination = static_cast<uint8_t>(value); break;
+                case 2:  { const uint16_t v = static_cast<uint16_t>(value); memcpy(pDestination, &v, sizeof(v)); break; }
+                default: memcpy(pDestination, &value, sizeof(value)); break;
+            }
+        }
+
+        return true;
+    }
+
+    switch (format)
+    {
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+            count = std::min(count, size / sizeof(uint32_t));
+            for (size_t i = 0; i < count; ++i, pDestination += sizeof(uint32_t))
+            {
+                const uint32_t value = FloatToUFloat(pSource[i].x, 6)
+                    | (FloatToUFloat(pSource[i].y, 6) << 11)
+                    | (FloatToUFloat(pSource[i].z, 5) << 22);
+                memcpy(pDestination, &value, sizeof(value));
+            }
+            return true;
+
+        case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+            count = std::min(count, size / sizeof(uint32_t));
+            for (size_t i = 0; i < count; ++i, pDestination += sizeof(uint32_t))
+            {
+                const uint32_t value = StoreRGB9E5(pSource[i]);
+                memcpy(pDestination, &value, sizeof(value));
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+
+namespace
+{
+    //---------------------------------------------------------------------------------
+    // Direct fast paths for common pairs
+    //---------------------------------------------------------------------------------
+    enum CONVERT_PATH : uint32_t
+    {
+        CONVERT_PATH_FLOAT4,            // Load -> (gamma) -> store
+        CONVERT_PATH_COPY,              // Same memory layout
+        CONVERT_PATH_SWIZZLE_8888,      // RGBA8 <-> BGRA8
+        CONVERT_PATH_SWIZZLE_888,       // RGB8 <-> BGR8
+        CONVERT_PATH_HALF_TO_FLOAT,     // 16F -> 32F, any channel count
+        CONVERT_PATH_FLOAT_TO_HALF,     // 32F -> 16F, any channel count
+        CONVERT_PATH_1010102_TO_8888,
+        CONVERT_PATH_8888_TO_1010102,
+    };
+
+    enum GAMMA_MODE : uint32_t
+    {
+        GAMMA_NONE,
+        GAMMA_DECODE,   // sRGB in, linear out
+        GAMMA_ENCODE,   // linear in, sRGB out
+    };
+
+    struct ConvertPlan
+    {
+        VkFormat     srcFormat;
+        VkFormat     destFormat;
+        CONVERT_PATH path;
+        GAMMA_MODE   gamma;
+        bool         swapRB;        // For the 10:10:10:2 paths
+        float        threshold;
+    };
+
+    // 8-bit _SRGB formats share the layout of their _UNORM counterpart
+    VkFormat MakeLinearLayout(VkFormat fmt) noexcept
+    {
+        switch (fmt)
+        {
+            case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+            case VK_FORMAT_A8B8G8R8_SRGB_PACK32:    return VK_FORMAT_R8G8B8A8_UNORM;
+            case VK_FORMAT_A8B8G8R8_SNORM_PACK32:   return VK_FORMAT_R8G8B8A8_SNORM;
+            case VK_FORMAT_A8B8G8R8_UINT_PACK32:    return VK_FORMAT_R8G8B8A8_UINT;
+            case VK_FORMAT_A8B8G8R8_SINT_PACK32:    return VK_FORMAT_R8G8B8A8_SINT;
+            case VK_FORMAT_D16_UNORM:               return VK_FORMAT_R16_UNORM;
+            case VK_FORMAT_D32_SFLOAT:              return VK_FORMAT_R32_SFLOAT;
+            default:                                return MakeLinear(fmt);
+        }
+    }
+
+    ConvertPlan PlanConversion(VkFormat srcFormat, VkFormat destFormat, const ConvertOptions& options) noexcept
+    {
+        ConvertPlan plan = { srcFormat, destFormat, CONVERT_PATH_FLOAT4, GAMMA_NONE, false, options.threshold };
+
+        bool srgbIn  = IsSRGB(srcFormat) || (options.flags & CONVERT_FLAGS_SRGB_IN);
+        bool srgbOut = IsSRGB(destFormat) || (options.flags & CONVERT_FLAGS_SRGB_OUT);
+
+        if (options.flags & CONVERT_FLAGS_IGNORE_SRGB)
+            srgbIn = srgbOut = false;
+
+        if (srgbIn != srgbOut)
+        {
+            // Gamma always goes through the wide intermediate
+            plan.gamma = srgbIn ? GAMMA_DECODE : GAMMA_ENCODE;
+            return plan;
+        }
+
+        if (options.flags & CONVERT_FLAGS_NO_FAST_PATH)
+            return plan;
+
+        const VkFormat srcLayout  = MakeLinearLayout(srcFormat);
+        const VkFormat destLayout = MakeLinearLayout(destFormat);
+
+        if (srcLayout == destLayout)
+        {
+            plan.path = CONVERT_PATH_COPY;
+            return plan;
+        }
+
+        PlainFormat srcPlain, destPlain;
+        const bool isSrcPlain  = GetPlainFormat(srcLayout, srcPlain);
+        const bool isDestPlain = GetPlainFormat(destLayout, destPlain);
+
+        if (isSrcPlain && isDestPlain)
+        {
+            if ((srcPlain.bytes == 1) && (destPlain.bytes == 1)
+                && (srcPlain.type == destPlain.type)
+                && (srcPlain.channels == destPlain.channels)
+                && (srcPlain.bgr != destPlain.bgr))
+            {
+                plan.path = (srcPlain.channels == 4) ? CONVERT_PATH_SWIZZLE_8888 : CONVERT_PATH_SWIZZLE_888;
+                return plan;
+            }
+
+            if ((srcPlain.type == COMPONENT_SFLOAT) && (destPlain.type == COMPONENT_SFLOAT)
+                && (srcPlain.channels == destPlain.channels))
+            {
+                if ((srcPlain.bytes == 2) && (destPlain.bytes == 4))
+                {
+                    plan.path = CONVERT_PATH_HALF_TO_FLOAT;
+                    return plan;
+                }
+
+                if ((srcPlain.bytes == 4) && (destPlain.bytes == 2))
+                {
+                    plan.path = CONVERT_PATH_FLOAT_TO_HALF;
+                    return plan;
+                }
+            }
+        }
+
+        auto is1010102 = [](VkFormat fmt) noexcept
+        {
+            return (fmt == VK_FORMAT_A2B10G10R10_UNORM_PACK32) || (fmt == VK_FORMAT_A2R10G10B10_UNORM_PACK32);
+        };
+
+        auto isUNorm8888 = [](VkFormat fmt) noexcept
+        {
+            return (fmt == VK_FORMAT_R8G8B8A8_UNORM) || (fmt == VK_FORMAT_B8G8R8A8_UNORM);
+        };
+
+        if (BitsPerColor(srcFormat) == 10 && is1010102(srcLayout) && isUNorm8888(destLayout))
+        {
+            // A2B10G10R10 holds red in the low bits like RGBA8; A2R10G10B10 matches BGRA8
+            plan.path   = CONVERT_PATH_1010102_TO_8888;
+            plan.swapRB = (srcLayout == VK_FORMAT_A2R10G10B10_UNORM_PACK32) != IsBGR(destLayout);
+            return plan;
+        }
+
+        if (BitsPerColor(destFormat) == 10 && is1010102(destLayout) && isUNorm8888(srcLayout))
+        {
+            plan.path   = CONVERT_PATH_8888_TO_1010102;
+            plan.swapRB = (destLayout == VK_FORMAT_A2R10G10B10_UNORM_PACK32) != IsBGR(srcLayout);
+            return plan;
+        }
+
+        return plan;
+    }
+
+    void SwizzleRB8888(uint8_t* pDestination, const uint8_t* pSource, size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if VULKANTEX_SSE2
+        const __m128i maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+        const __m128i maskR  = _mm_set1_epi32(0xFF);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i * 4));
+            const __m128i ga = _mm_and_si128(v, maskGA);
+            const __m128i r  = _mm_slli_epi32(_mm_and_si128(v, maskR), 16);
+            const __m128i b  = _mm_and_si128(_mm_srli_epi32(v, 16), maskR);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i * 4), _mm_or_si128(ga, _mm_or_si128(r, b)));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            uint32_t v;
+            memcpy(&v, pSource + i * 4, sizeof(v));
+            v = (v & 0xFF00FF00u) | ((v & 0xFFu) << 16) | ((v >> 16) & 0xFFu);
+            memcpy(pDestination + i * 4, &v, sizeof(v));
+        }
+    }
+
+    void Convert1010102To8888(uint8_t* pDestination, const uint8_t* pSource, size_t count, bool swapRB) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t v;
+            memcpy(&v, pSource + i * 4, sizeof(v));
+
+            // Exact round(x * 255 / 1023)
+            uint32_t c0 = (((v & 0x3FF) * 255u) + 511u) / 1023u;
+            const uint32_t c1 = ((((v >> 10) & 0x3FF) * 255u) + 511u) / 1023u;
+            uint32_t c2 = ((((v >> 20) & 0x3FF) * 255u) + 511u) / 1023u;
+            const uint32_t a = (v >> 30) * 85u;
+
+            if (swapRB)
+                std::swap(c0, c2);
+
+            const uint32_t out = c0 | (c1 << 8) | (c2 << 16) | (a << 24);
+            memcpy(pDestination + i * 4, &out, sizeof(out));
+        }
+    }
+
+    void Convert8888To1010102(uint8_t* pDestination, const uint8_t* pSource, size_t count, bool swapRB) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t v;
+            memcpy(&v, pSource + i * 4, sizeof(v));
+
+            // Exact round(x * 1023 / 255)
+            uint32_t c0 = (((v & 0xFF) * 1023u) + 127u) / 255u;
+            const uint32_t c1 = ((((v >> 8) & 0xFF) * 1023u) + 127u) / 255u;
+            uint32_t c2 = ((((v >> 16) & 0xFF) * 1023u) + 127u) / 255u;
+            const uint32_t a = (((v >> 24) * 3u) + 127u) / 255u;
+
+            if (swapRB)
+                std::swap(c0, c2);
+
+            const uint32_t out = c0 | (c1 << 10) | (c2 << 20) | (a << 30);
+            memcpy(pDestination + i * 4, &out, sizeof(out));
+        }
+    }
+
+    // Converts one row; 'scanline' must hold at least 'width' pixels for the float4 path
+    bool ConvertRow(
+        const ConvertPlan& plan,
+        const uint8_t* pSource, size_t srcRowSize,
+        uint8_t* pDestination, size_t destRowSize,
+        size_t width, Float4* scanline) noexcept
+    {
+        switch (plan.path)
+        {
+            case CONVERT_PATH_COPY:
+                memcpy(pDestination, pSource, std::min(srcRowSize, destRowSize));
+                return true;
+
+            case CONVERT_PATH_SWIZZLE_8888:
+                SwizzleRB8888(pDestination, pSource, width);
+                return true;
+
+            case CONVERT_PATH_SWIZZLE_888:
+                for (size_t i = 0; i < width; ++i)
+                {
+                    pDestination[i * 3]     = pSource[i * 3 + 2];
+                    pDestination[i * 3 + 1] = pSource[i * 3 + 1];
+                    pDestination[i * 3 + 2] = pSource[i * 3];
+                }
+                return true;
+
+            case CONVERT_PATH_HALF_TO_FLOAT:
+                HalfToFloatRow(reinterpret_cast<float*>(pDestination), reinterpret_cast<const uint16_t*>(pSource), srcRowSize / sizeof(uint16_t));
+                return true;
+
+            case CONVERT_PATH_FLOAT_TO_HALF:
+                FloatToHalfRow(reinterpret_cast<uint16_t*>(pDestination), reinterpret_cast<const float*>(pSource), srcRowSize / sizeof(float));
+                return true;
+
+            case CONVERT_PATH_1010102_TO_8888:
+                Convert1010102To8888(pDestination, pSource, width, plan.swapRB);
+                return true;
+
+            case CONVERT_PATH_8888_TO_1010102:
+                Convert8888To1010102(pDestination, pSource, width, plan.swapRB);
+                return true;
+
+            default:
+                break;
+        }
+
+        if (!LoadScanline(scanline, width, pSource, srcRowSize, plan.srcFormat))
+            return false;
+
+        if (plan.gamma == GAMMA_DECODE)
+        {
+            DecodeSRGBRow(scanline, width, plan.srcFormat);
+        }
+        else if (plan.gamma == GAMMA_ENCODE)
+        {
+            EncodeSRGBRow(scanline, width, plan.destFormat);
+        }
+
+        return StoreScanline(pDestination, destRowSize, plan.destFormat, scanline, width, plan.threshold);
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Convert image
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Convert(
+    const Image& srcImage,
+    VkFormat format,
+    ConvertOptions options,
+    ScratchImage& image) noexcept
+{
+    TexMetadata mdata = {};
+    mdata.width     = srcImage.width;
+    mdata.height    = srcImage.height;
+    mdata.depth     = 1;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = srcImage.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    return Convert(&srcImage, 1, mdata, format, options, image);
+}
+
+bool VulkanTex::Convert(
+    const ImageSetView& srcImages,
+    VkFormat format,
+    ConvertOptions options,
+    ScratchImage& result) noexcept
+{
+    return Convert(srcImages.images, srcImages.nimages, srcImages.metadata, format, options, result);
+}
+
+bool VulkanTex::Convert(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    VkFormat format,
+    ConvertOptions options,
+    ScratchImage& result) noexcept
+{
+    if (!srcImages || !nimages)
+        return false;
+
+    if (!IsConvertible(metadata.format) || !IsConvertible(format))
+        return false;
+
+    TexMetadata mdata2 = metadata;
+    mdata2.format = format;
+
+    bool hr = result.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    if (nimages != result.GetImageCount())
+    {
+        result.Release();
+        return false;
+    }
+
+    const Image* dest = result.GetImages();
+    if (!dest)
+    {
+        result.Release();
+        return false;
+    }
+
+    for (size_t index = 0; index < nimages; ++index)
+    {
+        const Image& src = srcImages[index];
+
+        if ((src.format != metadata.format) || !src.pixels)
+        {
+            result.Release();
+            return false;
+        }
+
+        if ((src.width != dest[index].width) || (src.height != dest[index].height))
+        {
+            result.Release();
+            return false;
+        }
+    }
+
+    const ConvertPlan plan = PlanConversion(metadata.format, format, options);
+
+    // One work item per row across every subresource
+    std::vector<size_t> rowStart;
+
+    try
+    {
+        rowStart.resize(nimages + 1);
+    }
+    catch (...)
+    {
+        result.Release();
+        return false;
+    }
+
+    rowStart[0] = 0;
+    for (size_t index = 0; index < nimages; ++index)
+    {
+        rowStart[index + 1] = rowStart[index] + srcImages[index].height;
+    }
+
+    const size_t srcPixelBits  = BitsPerPixel(metadata.format);
+    const size_t destPixelBits = BitsPerPixel(format);
+
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(rowStart[nimages], 16, [&](size_t begin, size_t end) noexcept
+    {
+        std::unique_ptr<Float4[]> scanline;
+        if (plan.path == CONVERT_PATH_FLOAT4)
+        {
+            scanline.reset(new (std::nothrow) Float4[metadata.width]);
+            if (!scanline)
+            {
+                failed = true;
+                return;
+            }
+        }
+
+        size_t index = static_cast<size_t>(std::upper_bound(rowStart.begin(), rowStart.end(), begin) - rowStart.begin()) - 1;
+
+        for (size_t row = begin; row < end; ++row)
+        {
+            while (row >= rowStart[index + 1])
+                ++index;
+
+            const Image& src = srcImages[index];
+            const Image& dst = dest[index];
+            const size_t y   = row - rowStart[index];
+
+            const size_t srcRowSize  = (src.width * srcPixelBits + 7) / 8;
+            const size_t destRowSize = (dst.width * destPixelBits + 7) / 8;
+
+            if (!ConvertRow(plan,
+                src.pixels + y * src.rowPitch, srcRowSize,
+                dst.pixels + y * dst.rowPitch, destRowSize,
+                src.width, scanline.get()))
+            {
+                failed = true;
+                return;
+            }
+        }
+    });
+
+    if (failed)
+    {
+        result.Release();
+        return false;
+    }
+
+    return true;
+}
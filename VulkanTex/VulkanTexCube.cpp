@@ -0,0 +1,627 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr float c_pi = 3.14159265358979323846f;
+
+    //---------------------------------------------------------------------------------
+    // Layouts
+    //---------------------------------------------------------------------------------
+    struct FacePlacement
+    {
+        size_t column;      // In face units
+        size_t row;
+        bool   rotate180;
+    };
+
+    bool GetLayoutFaces(CUBE_LAYOUT layout, size_t width, size_t height, size_t& faceSize, FacePlacement faces[6]) noexcept
+    {
+        switch (layout)
+        {
+            case CUBE_LAYOUT_HORIZONTAL_CROSS:
+                if ((width % 4) || (height % 3) || (width / 4 != height / 3))
+                    return false;
+                faceSize = width / 4;
+                faces[0] = { 2, 1, false };
+                faces[1] = { 0, 1, false };
+                faces[2] = { 1, 0, false };
+                faces[3] = { 1, 2, false };
+                faces[4] = { 1, 1, false };
+                faces[5] = { 3, 1, false };
+                break;
+
+            case CUBE_LAYOUT_VERTICAL_CROSS:
+                if ((width % 3) || (height % 4) || (width / 3 != height / 4))
+                    return false;
+                faceSize = width / 3;
+                faces[0] = { 2, 1, false };
+                faces[1] = { 0, 1, false };
+                faces[2] = { 1, 0, false };
+                faces[3] = { 1, 2, false };
+                faces[4] = { 1, 1, false };
+                faces[5] = { 1, 3, true };
+                break;
+
+            case CUBE_LAYOUT_HORIZONTAL_STRIP:
+                if (width != height * 6)
+                    return false;
+                faceSize = height;
+                for (size_t face = 0; face < 6; ++face)
+                    faces[face] = { face, 0, false };
+                break;
+
+            case CUBE_LAYOUT_VERTICAL_STRIP:
+                if (height != width * 6)
+                    return false;
+                faceSize = width;
+                for (size_t face = 0; face < 6; ++face)
+                    faces[face] = { 0, face, false };
+                break;
+
+            default:
+                return false;
+        }
+
+        return faceSize > 0;
+    }
+
+#if VULKANTEX_SSE2
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b) noexcept
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Four-wide atan2 (about 1e-7 rad error), atan2(0, 0) is 0
+    __m128 Atan2(__m128 y, __m128 x) noexcept
+    {
+        const __m128 signMask = _mm_set1_ps(-0.f);
+        const __m128 ax = _mm_andnot_ps(signMask, x);
+        const __m128 ay = _mm_andnot_ps(signMask, y);
+
+        // Ratio in [0, 1]
+        const __m128 swap = _mm_cmpgt_ps(ay, ax);
+        const __m128 num  = Select(swap, ax, ay);
+        const __m128 den  = Select(swap, ay, ax);
+        const __m128 a    = _mm_div_ps(num, _mm_max_ps(den, _mm_set1_ps(1e-30f)));
+
+        // Reduce to [0, tan(pi / 8)]
+        const __m128 one     = _mm_set1_ps(1.f);
+        const __m128 big     = _mm_cmpgt_ps(a, _mm_set1_ps(0.414213562f));
+        const __m128 reduced = Select(big, _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one)), a);
+        const __m128 offset  = _mm_and_ps(big, _mm_set1_ps(c_pi * 0.25f));
+
+        const __m128 z = _mm_mul_ps(reduced, reduced);
+        __m128 p = _mm_mul_ps(_mm_set1_ps(8.05374449538e-2f), z);
+        p = _mm_mul_ps(_mm_add_ps(p, _mm_set1_ps(-1.38776856032e-1f)), z);
+        p = _mm_mul_ps(_mm_add_ps(p, _mm_set1_ps(1.99777106478e-1f)), z);
+        p = _mm_add_ps(p, _mm_set1_ps(-3.33329491539e-1f));
+
+        __m128 r = _mm_add_ps(_mm_add_ps(offset, reduced), _mm_mul_ps(_mm_mul_ps(reduced, z), p));
+        r = Select(swap, _mm_sub_ps(_mm_set1_ps(c_pi * 0.5f), r), r);
+        r = Select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(c_pi), r), r);
+        return _mm_or_ps(r, _mm_and_ps(y, signMask));
+    }
+#endif
+
+    //---------------------------------------------------------------------------------
+    // Equirectangular texel coordinates of the directions of one cube face row
+    //---------------------------------------------------------------------------------
+    void GetEquirectCoords(
+        float* px, float* py, const float* sTable, size_t count, float t,
+        size_t face, size_t width, size_t height) noexcept
+    {
+        const float (&axes)[3][3] = c_cubeFaceAxes[face];
+
+        // Row-constant part of the direction
+        const float bx = t * axes[1][0] + axes[2][0];
+        const float by = t * axes[1][1] + axes[2][1];
+        const float bz = t * axes[1][2] + axes[2][2];
+
+        const float scaleU = static_cast<float>(width) / (2.f * c_pi);
+        const float scaleV = static_cast<float>(height) / c_pi;
+        const float halfW  = static_cast<float>(width) * 0.5f;
+        const float halfH  = static_cast<float>(height) * 0.5f;
+
+        size_t i = 0;
+
+#if VULKANTEX_SSE2
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 s  = _mm_loadu_ps(sTable + i);
+            const __m128 dx = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(axes[0][0])), _mm_set1_ps(bx));
+            const __m128 dy = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(axes[0][1])), _mm_set1_ps(by));
+            const __m128 dz = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(axes[0][2])), _mm_set1_ps(bz));
+
+            const __m128 longitude = Atan2(dx, dz);
+            const __m128 latitude  = Atan2(dy, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz))));
+
+            _mm_storeu_ps(px + i, _mm_add_ps(_mm_mul_ps(longitude, _mm_set1_ps(scaleU)), _mm_set1_ps(halfW)));
+            _mm_storeu_ps(py + i, _mm_sub_ps(_mm_set1_ps(halfH), _mm_mul_ps(latitude, _mm_set1_ps(scaleV))));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const float dx = sTable[i] * axes[0][0] + bx;
+            const float dy = sTable[i] * axes[0][1] + by;
+            const float dz = sTable[i] * axes[0][2] + bz;
+
+            px[i] = std::atan2(dx, dz) * scaleU + halfW;
+            py[i] = halfH - std::atan2(dy, std::sqrt(dx * dx + dz * dz)) * scaleV;
+        }
+    }
+
+    // Face-plane position of every texel center, s = 2 * (x + 0.5) / n - 1
+    bool BuildFaceTable(size_t faceSize, std::vector<float>& table) noexcept
+    {
+        try
+        {
+            table.resize(faceSize);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        for (size_t x = 0; x < faceSize; ++x)
+        {
+            table[x] = 2.f * (static_cast<float>(x) + 0.5f) / static_cast<float>(faceSize) - 1.f;
+        }
+
+        return true;
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// Float4 expansion of sampled images
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Internal::ExpandImage(const Image& image, uint32_t pixelFlags, FloatPlane& plane) noexcept
+{
+    if (!image.pixels || !image.width || !image.height)
+        return false;
+
+    if (image.width > SIZE_MAX / sizeof(Float4) / image.height)
+        return false;
+
+    plane.pixels.reset(new (std::nothrow) Float4[image.width * image.height]);
+    if (!plane.pixels)
+        return false;
+
+    plane.width  = image.width;
+    plane.height = image.height;
+
+    const size_t rowSize = (image.width * BitsPerPixel(image.format) + 7) / 8;
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(image.height, 16, [&](size_t begin, size_t end) noexcept
+    {
+        for (size_t y = begin; y < end; ++y)
+        {
+            Float4* row = plane.pixels.get() + y * image.width;
+
+            if (!LoadScanline(row, image.width, image.pixels + y * image.rowPitch, rowSize, image.format))
+            {
+                failed = true;
+                return;
+            }
+
+            PrepareSourceRow(row, image.width, image.format, pixelFlags);
+        }
+    });
+
+    return !failed;
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Splits a cross / strip image into the six faces of a cubemap
+//-------------------------------------------------------------------------------------
+bool VulkanTex::UnpackCubeLayout(
+    const Image& srcImage,
+    CUBE_LAYOUT layout,
+    ScratchImage& cube) noexcept
+{
+    if (!srcImage.pixels || IsCompressed(srcImage.format) || IsPlanar(srcImage.format))
+        return false;
+
+    const size_t pixelBits = BitsPerPixel(srcImage.format);
+    if (!pixelBits || (pixelBits % 8))
+        return false;
+
+    size_t faceSize = 0;
+    FacePlacement faces[6] = {};
+    if (!GetLayoutFaces(layout, srcImage.width, srcImage.height, faceSize, faces))
+        return false;
+
+    bool hr = cube.InitializeCube(srcImage.format, faceSize, faceSize, 1, 1);
+    if (hr == false)
+        return hr;
+
+    const size_t pixelBytes = pixelBits / 8;
+    const size_t rowBytes   = faceSize * pixelBytes;
+
+    ParallelFor(6 * faceSize, 64, [&](size_t begin, size_t end) noexcept
+    {
+        for (size_t row = begin; row < end; ++row)
+        {
+            const size_t face = row / faceSize;
+            const size_t y    = row % faceSize;
+            const FacePlacement& placement = faces[face];
+
+            const Image* dest = cube.GetImage(0, face, 0);
+            uint8_t* pDest = dest->pixels + y * dest->rowPitch;
+
+            if (!placement.rotate180)
+            {
+                const uint8_t* pSrc = srcImage.pixels + (placement.row * faceSize + y) * srcImage.rowPitch + placement.column * rowBytes;
+                memcpy(pDest, pSrc, rowBytes);
+                continue;
+            }
+
+            const uint8_t* pSrc = srcImage.pixels + (placement.row * faceSize + faceSize - 1 - y) * srcImage.rowPitch + placement.column * rowBytes;
+            for (size_t x = 0; x < faceSize; ++x)
+            {
+                memcpy(pDest + x * pixelBytes, pSrc + (faceSize - 1 - x) * pixelBytes, pixelBytes);
+            }
+        }
+    });
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Concatenates cubemaps into a cube array
+//-------------------------------------------------------------------------------------
+bool VulkanTex::AssembleCubeArray(
+    const ImageSetView* cubes,
+    size_t nCubes,
+    ScratchImage& result) noexcept
+{
+    if (!cubes || !nCubes)
+        return false;
+
+    const TexMetadata& first = cubes[0].metadata;
+    size_t totalCubes = 0;
+
+    for (size_t i = 0; i < nCubes; ++i)
+    {
+        const TexMetadata& mdata = cubes[i].metadata;
+
+        if (!cubes[i].images || !mdata.IsCubemap() || !mdata.arraySize || (mdata.arraySize % 6))
+            return false;
+
+        if ((mdata.format != first.format) || (mdata.width != first.width) || (mdata.height != first.height)
+            || (mdata.mipLevels != first.mipLevels))
+            return false;
+
+        if (cubes[i].nimages < mdata.arraySize * mdata.mipLevels)
+            return false;
+
+        totalCubes += mdata.arraySize / 6;
+    }
+
+    TexMetadata mdata2 = first;
+    mdata2.arraySize = totalCubes * 6;
+
+    bool hr = result.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    // Both sides are item-major, so the sources line up with the result one to one
+    std::vector<const Image*> sources;
+
+    try
+    {
+        sources.reserve(result.GetImageCount());
+
+        for (size_t i = 0; i < nCubes; ++i)
+        {
+            const size_t count = cubes[i].metadata.arraySize * cubes[i].metadata.mipLevels;
+            for (size_t index = 0; index < count; ++index)
+                sources.push_back(&cubes[i].images[index]);
+        }
+    }
+    catch (...)
+    {
+        result.Release();
+        return false;
+    }
+
+    if (sources.size() != result.GetImageCount())
+    {
+        result.Release();
+        return false;
+    }
+
+    const Image* dest = result.GetImages();
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(sources.size(), 1, [&](size_t begin, size_t end) noexcept
+    {
+        for (size_t index = begin; index < end; ++index)
+        {
+            const Image& src = *sources[index];
+            const Image& dst = dest[index];
+
+            if (!src.pixels || (src.format != dst.format) || (src.width != dst.width) || (src.height != dst.height))
+            {
+                failed = true;
+                return;
+            }
+
+            const size_t rows     = ComputeScanlines(dst.format, dst.height);
+            const size_t rowBytes = std::min(src.rowPitch, dst.rowPitch);
+
+            for (size_t y = 0; y < rows; ++y)
+            {
+                memcpy(dst.pixels + y * dst.rowPitch, src.pixels + y * src.rowPitch, rowBytes);
+            }
+        }
+    });
+
+    if (failed)
+    {
+        result.Release();
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Equirectangular to cubemap
+//-------------------------------------------------------------------------------------
+bool VulkanTex::EquirectToCube(
+    const Image& srcImage,
+    size_t faceSize,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage& cube) noexcept
+{
+    if (!srcImage.pixels || !faceSize || (faceSize > UINT32_MAX))
+        return false;
+
+    if (!IsConvertible(srcImage.format))
+        return false;
+
+    FILTER_KERNEL kernel;
+    if (!GetFilterKernel(filter, kernel))
+        return false;
+
+    TexMetadata mdata = {};
+    mdata.width     = faceSize;
+    mdata.height    = faceSize;
+    mdata.depth     = 1;
+    mdata.arraySize = 6;
+    mdata.mipLevels = 1;
+    mdata.miscFlags = TEX_MISC_TEXTURECUBE;
+    mdata.format    = srcImage.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    const uint32_t pixelFlags = GetFilterPixelFlags(filter, mdata);
+
+    FloatPlane source;
+    if (!ExpandImage(srcImage, pixelFlags, source))
+        return false;
+
+    std::vector<float> sTable;
+    if (!BuildFaceTable(faceSize, sTable))
+        return false;
+
+    bool hr = cube.Initialize(mdata);
+    if (hr == false)
+        return hr;
+
+    const size_t destRowSize = (faceSize * BitsPerPixel(mdata.format) + 7) / 8;
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(6 * faceSize, 4, [&](size_t begin, size_t end) noexcept
+    {
+        std::unique_ptr<Float4[]> row(new (std::nothrow) Float4[faceSize]);
+        std::unique_ptr<float[]> coords(new (std::nothrow) float[faceSize * 2]);
+        if (!row || !coords)
+        {
+            failed = true;
+            return;
+        }
+
+        float* px = coords.get();
+        float* py = coords.get() + faceSize;
+
+        for (size_t r = begin; r < end; ++r)
+        {
+            const size_t face = r / faceSize;
+            const size_t y    = r % faceSize;
+
+            GetEquirectCoords(px, py, sTable.data(), faceSize, sTable[y], face, source.width, source.height);
+
+            if (kernel == FILTER_KERNEL_POINT)
+            {
+                for (size_t x = 0; x < faceSize; ++x)
+                    row[x] = SamplePoint(source, px[x], py[x], true);
+            }
+            else
+            {
+                for (size_t x = 0; x < faceSize; ++x)
+                    row[x] = SampleBilinear(source, px[x], py[x], true);
+            }
+
+            FinishDestinationRow(row.get(), faceSize, mdata.format, pixelFlags);
+
+            const Image* dest = cube.GetImage(0, face, 0);
+            if (!StoreScanline(dest->pixels + y * dest->rowPitch, destRowSize, mdata.format, row.get(), faceSize))
+            {
+                failed = true;
+                return;
+            }
+        }
+    });
+
+    if (failed)
+    {
+        cube.Release();
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Cubemap to equirectangular
+//-------------------------------------------------------------------------------------
+bool VulkanTex::CubeToEquirect(
+    const ImageSetView& srcImages,
+    size_t width,
+    size_t height,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage& image) noexcept
+{
+    return CubeToEquirect(srcImages.images, srcImages.nimages, srcImages.metadata, width, height, filter, image);
+}
+
+bool VulkanTex::CubeToEquirect(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    size_t width,
+    size_t height,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage& image) noexcept
+{
+    if (!srcImages || !width || !height || (width > UINT32_MAX) || (height > UINT32_MAX))
+        return false;
+
+    if (!metadata.IsCubemap() || (metadata.arraySize < 6) || (metadata.width != metadata.height)
+        || (nimages < 6 * metadata.mipLevels))
+        return false;
+
+    if (!IsConvertible(metadata.format))
+        return false;
+
+    FILTER_KERNEL kernel;
+    if (!GetFilterKernel(filter, kernel))
+        return false;
+
+    const uint32_t pixelFlags = GetFilterPixelFlags(filter, metadata);
+    const size_t faceSize = metadata.width;
+
+    FloatPlane faces[6];
+    for (size_t face = 0; face < 6; ++face)
+    {
+        const Image& src = srcImages[face * metadata.mipLevels];
+        if ((src.format != metadata.format) || (src.width != faceSize) || (src.height != faceSize))
+            return false;
+
+        if (!ExpandImage(src, pixelFlags, faces[face]))
+            return false;
+    }
+
+    // Longitude depends only on the column and latitude only on the row
+    std::vector<float> columnSin, columnCos, rowSin, rowCos;
+
+    try
+    {
+        columnSin.resize(width);
+        columnCos.resize(width);
+        rowSin.resize(height);
+        rowCos.resize(height);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    for (size_t x = 0; x < width; ++x)
+    {
+        const double longitude = ((static_cast<double>(x) + 0.5) / static_cast<double>(width) - 0.5) * 2.0 * 3.14159265358979323846;
+        columnSin[x] = static_cast<float>(std::sin(longitude));
+        columnCos[x] = static_cast<float>(std::cos(longitude));
+    }
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        const double latitude = (0.5 - (static_cast<double>(y) + 0.5) / static_cast<double>(height)) * 3.14159265358979323846;
+        rowSin[y] = static_cast<float>(std::sin(latitude));
+        rowCos[y] = static_cast<float>(std::cos(latitude));
+    }
+
+    TexMetadata mdata2 = metadata;
+    mdata2.width     = width;
+    mdata2.height    = height;
+    mdata2.depth     = 1;
+    mdata2.arraySize = 1;
+    mdata2.mipLevels = 1;
+    mdata2.miscFlags &= ~static_cast<uint32_t>(TEX_MISC_TEXTURECUBE);
+    mdata2.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    bool hr = image.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    const Image* dest = image.GetImage(0, 0, 0);
+    const size_t destRowSize = (width * BitsPerPixel(mdata2.format) + 7) / 8;
+    const float halfFace = static_cast<float>(faceSize) * 0.5f;
+
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(height, 4, [&](size_t begin, size_t end) noexcept
+    {
+        std::unique_ptr<Float4[]> row(new (std::nothrow) Float4[width]);
+        if (!row)
+        {
+            failed = true;
+            return;
+        }
+
+        for (size_t y = begin; y < end; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                const float dx = rowCos[y] * columnSin[x];
+                const float dy = rowSin[y];
+                const float dz = rowCos[y] * columnCos[x];
+
+                float s, t;
+                const size_t face = GetCubeFaceCoords(dx, dy, dz, s, t);
+                const float px = (s + 1.f) * halfFace;
+                const float py = (t + 1.f) * halfFace;
+
+                row[x] = (kernel == FILTER_KERNEL_POINT)
+                    ? SamplePoint(faces[face], px, py, false)
+                    : SampleBilinear(faces[face], px, py, false);
+            }
+
+            FinishDestinationRow(row.get(), width, mdata2.format, pixelFlags);
+
+            if (!StoreScanline(dest->pixels + y * dest->rowPitch, destRowSize, mdata2.format, row.get(), width))
+            {
+                failed = true;
+                return;
+            }
+        }
+    });
+
+    if (failed)
+    {
+        image.Release();
+        return false;
+    }
+
+    return true;
+}
@@ -1,9 +1,37 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <vulkan/vulkan_core.h>
 #include "VulkanTex.h"
 #include "VulkanTexDDS.h"
+#include "VulkanTexP.h"
+
+#if _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 using namespace VulkanTex;
 
@@ -22,7 +50,8 @@ namespace DXGI
     constexpr uint32_t FORMAT_R16G16B16A16_FLOAT  = 10;
     constexpr uint32_t FORMAT_R16G16B16A16_UNORM  = 11;
     constexpr uint32_t FORMAT_R16G16B16A16_UINT   = 12;
-    constexpr uint32_t FORMAT_R16G16B16A16_SINT   = 13;
+    constexpr uint32_t FORMAT_R16G16B16A16_SNORM  = 13;
+    constexpr uint32_t FORMAT_R16G16B16A16_SINT   = 14;
     constexpr uint32_t FORMAT_R32G32_FLOAT        = 16;
     constexpr uint32_t FORMAT_R32G32_UINT         = 17;
     constexpr uint32_t FORMAT_R32G32_SINT         = 18;
@@ -33,11 +62,13 @@ namespace DXGI
     constexpr uint32_t FORMAT_R8G8B8A8_UNORM      = 28;
     constexpr uint32_t FORMAT_R8G8B8A8_UNORM_SRGB = 29;
     constexpr uint32_t FORMAT_R8G8B8A8_UINT       = 30;
-    constexpr uint32_t FORMAT_R8G8B8A8_SINT       = 31;
+    constexpr uint32_t FORMAT_R8G8B8A8_SNORM      = 31;
+    constexpr uint32_t FORMAT_R8G8B8A8_SINT       = 32;
     constexpr uint32_t FORMAT_R16G16_FLOAT        = 34;
     constexpr uint32_t FORMAT_R16G16_UNORM        = 35;
     constexpr uint32_t FORMAT_R16G16_UINT         = 36;
-    constexpr uint32_t FORMAT_R16G16_SINT         = 37;
+    constexpr uint32_t FORMAT_R16G16_SNORM        = 37;
+    constexpr uint32_t FORMAT_R16G16_SINT         = 38;
     constexpr uint32_t FORMAT_R32_FLOAT           = 41;
     constexpr uint32_t FORMAT_R32_UINT            = 42;
     constexpr uint32_t FORMAT_R32_SINT            = 43;
@@ -47,15 +78,38 @@ namespace DXGI
     // 16-bit
     constexpr uint32_t FORMAT_R8G8_UNORM          = 49;
     constexpr uint32_t FORMAT_R8G8_UINT           = 50;
-    constexpr uint32_t FORMAT_R8G8_SINT           = 51;
+    constexpr uint32_t FORMAT_R8G8_SNORM          = 51;
+    constexpr uint32_t FORMAT_R8G8_SINT           = 52;
     constexpr uint32_t FORMAT_R16_FLOAT           = 54;
     constexpr uint32_t FORMAT_R16_UNORM           = 56;
     constexpr uint32_t FORMAT_R16_UINT            = 57;
-    constexpr uint32_t FORMAT_R16_SINT            = 58;
+    constexpr uint32_t FORMAT_R16_SNORM           = 58;
+    constexpr uint32_t FORMAT_R16_SINT            = 59;
     // 8-bit
     constexpr uint32_t FORMAT_R8_UNORM            = 61;
     constexpr uint32_t FORMAT_R8_UINT             = 62;
-    constexpr uint32_t FORMAT_R8_SINT             = 63;
+    constexpr uint32_t FORMAT_R8_SNORM            = 63;
+    constexpr uint32_t FORMAT_R8_SINT             = 64;
+    constexpr uint32_t FORMAT_A8_UNORM            = 65;
+    // Packed 16-bit
+    constexpr uint32_t FORMAT_B5G6R5_UNORM        = 85;
+    constexpr uint32_t FORMAT_B5G5R5A1_UNORM      = 86;
+    constexpr uint32_t FORMAT_B4G4R4A4_UNORM      = 115;
+    // Block compressed
+    constexpr uint32_t FORMAT_BC1_UNORM           = 71;
+    constexpr uint32_t FORMAT_BC1_UNORM_SRGB      = 72;
+    constexpr uint32_t FORMAT_BC2_UNORM           = 74;
+    constexpr uint32_t FORMAT_BC2_UNORM_SRGB      = 75;
+    constexpr uint32_t FORMAT_BC3_UNORM           = 77;
+    constexpr uint32_t FORMAT_BC3_UNORM_SRGB      = 78;
+    constexpr uint32_t FORMAT_BC4_UNORM           = 80;
+    constexpr uint32_t FORMAT_BC4_SNORM           = 81;
+    constexpr uint32_t FORMAT_BC5_UNORM           = 83;
+    constexpr uint32_t FORMAT_BC5_SNORM           = 84;
+    constexpr uint32_t FORMAT_BC6H_UF16           = 95;
+    constexpr uint32_t FORMAT_BC6H_SF16           = 96;
+    constexpr uint32_t FORMAT_BC7_UNORM           = 98;
+    constexpr uint32_t FORMAT_BC7_UNORM_SRGB      = 99;
 }
 
 namespace VulkanTex
@@ -119,11 +173,110 @@ namespace VulkanTex
             case VK_FORMAT_R32_SFLOAT: return DXGI::FORMAT_R32_FLOAT;
             case VK_FORMAT_R32_UINT:   return DXGI::FORMAT_R32_UINT;
             case VK_FORMAT_R32_SINT:   return DXGI::FORMAT_R32_SINT;
+            // Signed normalized
+            case VK_FORMAT_R8G8B8A8_SNORM:     return DXGI::FORMAT_R8G8B8A8_SNORM;
+            case VK_FORMAT_R16G16B16A16_SNORM: return DXGI::FORMAT_R16G16B16A16_SNORM;
+            case VK_FORMAT_R8G8_SNORM:         return DXGI::FORMAT_R8G8_SNORM;
+            case VK_FORMAT_R16G16_SNORM:       return DXGI::FORMAT_R16G16_SNORM;
+            case VK_FORMAT_R8_SNORM:           return DXGI::FORMAT_R8_SNORM;
+            case VK_FORMAT_R16_SNORM:          return DXGI::FORMAT_R16_SNORM;
+            case VK_FORMAT_A8_UNORM:           return DXGI::FORMAT_A8_UNORM;
+            // Packed 16-bit
+            case VK_FORMAT_B5G6R5_UNORM_PACK16:   return DXGI::FORMAT_B5G6R5_UNORM;
+            case VK_FORMAT_B5G5R5A1_UNORM_PACK16: return DXGI::FORMAT_B5G5R5A1_UNORM;
+            case VK_FORMAT_B4G4R4A4_UNORM_PACK16: return DXGI::FORMAT_B4G4R4A4_UNORM;
+            // Block compressed
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return DXGI::FORMAT_BC1_UNORM;
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:  return DXGI::FORMAT_BC1_UNORM_SRGB;
+            case VK_FORMAT_BC2_UNORM_BLOCK:      return DXGI::FORMAT_BC2_UNORM;
+            case VK_FORMAT_BC2_SRGB_BLOCK:       return DXGI::FORMAT_BC2_UNORM_SRGB;
+            case VK_FORMAT_BC3_UNORM_BLOCK:      return DXGI::FORMAT_BC3_UNORM;
+            case VK_FORMAT_BC3_SRGB_BLOCK:       return DXGI::FORMAT_BC3_UNORM_SRGB;
+            case VK_FORMAT_BC4_UNORM_BLOCK:      return DXGI::FORMAT_BC4_UNORM;
+            case VK_FORMAT_BC4_SNORM_BLOCK:      return DXGI::FORMAT_BC4_SNORM;
+            case VK_FORMAT_BC5_UNORM_BLOCK:      return DXGI::FORMAT_BC5_UNORM;
+            case VK_FORMAT_BC5_SNORM_BLOCK:      return DXGI::FORMAT_BC5_SNORM;
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:    return DXGI::FORMAT_BC6H_UF16;
+            case VK_FORMAT_BC6H_SFLOAT_BLOCK:    return DXGI::FORMAT_BC6H_SF16;
+            case VK_FORMAT_BC7_UNORM_BLOCK:      return DXGI::FORMAT_BC7_UNORM;
+            case VK_FORMAT_BC7_SRGB_BLOCK:       return DXGI::FORMAT_BC7_UNORM_SRGB;
             // Others
             default:
                 return DXGI::FORMAT_UNKNOWN;
         }
     }
+
+    // Inverse of VkFormatToDXGIFormat; 10:10:10:2 maps to the Vulkan format with the same bit layout
+    VkFormat DXGIFormatToVkFormat(uint32_t dxgiFormat) noexcept
+    {
+        switch (dxgiFormat)
+        {
+            case DXGI::FORMAT_R32G32B32A32_FLOAT:  return VK_FORMAT_R32G32B32A32_SFLOAT;
+            case DXGI::FORMAT_R32G32B32A32_UINT:   return VK_FORMAT_R32G32B32A32_UINT;
+            case DXGI::FORMAT_R32G32B32A32_SINT:   return VK_FORMAT_R32G32B32A32_SINT;
+            case DXGI::FORMAT_R16G16B16A16_FLOAT:  return VK_FORMAT_R16G16B16A16_SFLOAT;
+            case DXGI::FORMAT_R16G16B16A16_UNORM:  return VK_FORMAT_R16G16B16A16_UNORM;
+            case DXGI::FORMAT_R16G16B16A16_UINT:   return VK_FORMAT_R16G16B16A16_UINT;
+            case DXGI::FORMAT_R16G16B16A16_SNORM:  return VK_FORMAT_R16G16B16A16_SNORM;
+            case DXGI::FORMAT_R16G16B16A16_SINT:   return VK_FORMAT_R16G16B16A16_SINT;
+            case DXGI::FORMAT_R32G32_FLOAT:        return VK_FORMAT_R32G32_SFLOAT;
+            case DXGI::FORMAT_R32G32_UINT:         return VK_FORMAT_R32G32_UINT;
+            case DXGI::FORMAT_R32G32_SINT:         return VK_FORMAT_R32G32_SINT;
+            case DXGI::FORMAT_R10G10B10A2_UNORM:   return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+            case DXGI::FORMAT_R10G10B10A2_UINT:    return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+            case DXGI::FORMAT_R11G11B10_FLOAT:     return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+            case DXGI::FORMAT_R8G8B8A8_UNORM:      return VK_FORMAT_R8G8B8A8_UNORM;
+            case DXGI::FORMAT_R8G8B8A8_UNORM_SRGB: return VK_FORMAT_R8G8B8A8_SRGB;
+            case DXGI::FORMAT_R8G8B8A8_UINT:       return VK_FORMAT_R8G8B8A8_UINT;
+            case DXGI::FORMAT_R8G8B8A8_SNORM:      return VK_FORMAT_R8G8B8A8_SNORM;
+            case DXGI::FORMAT_R8G8B8A8_SINT:       return VK_FORMAT_R8G8B8A8_SINT;
+            case DXGI::FORMAT_R16G16_FLOAT:        return VK_FORMAT_R16G16_SFLOAT;
+            case DXGI::FORMAT_R16G16_UNORM:        return VK_FORMAT_R16G16_UNORM;
+            case DXGI::FORMAT_R16G16_UINT:         return VK_FORMAT_R16G16_UINT;
+            case DXGI::FORMAT_R16G16_SNORM:        return VK_FORMAT_R16G16_SNORM;
+            case DXGI::FORMAT_R16G16_SINT:         return VK_FORMAT_R16G16_SINT;
+            case DXGI::FORMAT_R32_FLOAT:           return VK_FORMAT_R32_SFLOAT;
+            case DXGI::FORMAT_R32_UINT:            return VK_FORMAT_R32_UINT;
+            case DXGI::FORMAT_R32_SINT:            return VK_FORMAT_R32_SINT;
+            case DXGI::FORMAT_B8G8R8A8_UNORM:      return VK_FORMAT_B8G8R8A8_UNORM;
+            case DXGI::FORMAT_B8G8R8A8_UNORM_SRGB: return VK_FORMAT_B8G8R8A8_SRGB;
+            case DXGI::FORMAT_R8G8_UNORM:          return VK_FORMAT_R8G8_UNORM;
+            case DXGI::FORMAT_R8G8_UINT:           return VK_FORMAT_R8G8_UINT;
+            case DXGI::FORMAT_R8G8_SNORM:          return VK_FORMAT_R8G8_SNORM;
+            case DXGI::FORMAT_R8G8_SINT:           return VK_FORMAT_R8G8_SINT;
+            case DXGI::FORMAT_R16_FLOAT:           return VK_FORMAT_R16_SFLOAT;
+            case DXGI::FORMAT_R16_UNORM:           return VK_FORMAT_R16_UNORM;
+            case DXGI::FORMAT_R16_UINT:            return VK_FORMAT_R16_UINT;
+            case DXGI::FORMAT_R16_SNORM:           return VK_FORMAT_R16_SNORM;
+            case DXGI::FORMAT_R16_SINT:            return VK_FORMAT_R16_SINT;
+            case DXGI::FORMAT_R8_UNORM:            return VK_FORMAT_R8_UNORM;
+            case DXGI::FORMAT_R8_UINT:             return VK_FORMAT_R8_UINT;
+            case DXGI::FORMAT_R8_SNORM:            return VK_FORMAT_R8_SNORM;
+            case DXGI::FORMAT_R8_SINT:             return VK_FORMAT_R8_SINT;
+            case DXGI::FORMAT_A8_UNORM:            return VK_FORMAT_A8_UNORM;
+            case DXGI::FORMAT_B5G6R5_UNORM:        return VK_FORMAT_B5G6R5_UNORM_PACK16;
+            case DXGI::FORMAT_B5G5R5A1_UNORM:      return VK_FORMAT_B5G5R5A1_UNORM_PACK16;
+            case DXGI::FORMAT_B4G4R4A4_UNORM:      return VK_FORMAT_B4G4R4A4_UNORM_PACK16;
+            case DXGI::FORMAT_BC1_UNORM:           return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+            case DXGI::FORMAT_BC1_UNORM_SRGB:      return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+            case DXGI::FORMAT_BC2_UNORM:           return VK_FORMAT_BC2_UNORM_BLOCK;
+            case DXGI::FORMAT_BC2_UNORM_SRGB:      return VK_FORMAT_BC2_SRGB_BLOCK;
+            case DXGI::FORMAT_BC3_UNORM:           return VK_FORMAT_BC3_UNORM_BLOCK;
+            case DXGI::FORMAT_BC3_UNORM_SRGB:      return VK_FORMAT_BC3_SRGB_BLOCK;
+            case DXGI::FORMAT_BC4_UNORM:           return VK_FORMAT_BC4_UNORM_BLOCK;
+            case DXGI::FORMAT_BC4_SNORM:           return VK_FORMAT_BC4_SNORM_BLOCK;
+            case DXGI::FORMAT_BC5_UNORM:           return VK_FORMAT_BC5_UNORM_BLOCK;
+            case DXGI::FORMAT_BC5_SNORM:           return VK_FORMAT_BC5_SNORM_BLOCK;
+            case DXGI::FORMAT_BC6H_UF16:           return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+            case DXGI::FORMAT_BC6H_SF16:           return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+            case DXGI::FORMAT_BC7_UNORM:           return VK_FORMAT_BC7_UNORM_BLOCK;
+            case DXGI::FORMAT_BC7_UNORM_SRGB:      return VK_FORMAT_BC7_SRGB_BLOCK;
+            default:
+                return VK_FORMAT_UNDEFINED;
+        }
+    }
 }
 
 namespace
@@ -275,159 +428,1629 @@ namespace
     //      FourCC 82 D3DFMT_D32F_LOCKABLE
     //      FourCC 117 D3DFMT_CxV8U8
 
-    // We do not support the following known FourCC codes:
-    //      FourCC CTX1 (Xbox 360 only)
-    //      FourCC EAR, EARG, ET2, ET2A (Ericsson Texture Compression)
-    //      FourCC MET1 (a.k.a. D3DFMT_MULTI2_ARGB8; rarely supported by any hardware)
+    // We do not support the following known FourCC codes:
+    //      FourCC CTX1 (Xbox 360 only)
+    //      FourCC EAR, EARG, ET2, ET2A (Ericsson Texture Compression)
+    //      FourCC MET1 (a.k.a. D3DFMT_MULTI2_ARGB8; rarely supported by any hardware)
+
+    VkFormat GetDXGIFormat(const DDS_HEADER& hdr, const DDS_PIXELFORMAT& ddpf,
+                           DDS_FLAGS flags, uint32_t& convFlags) noexcept
+    {
+        uint32_t ddpfFlags = ddpf.flags;
+
+        if (hdr.reserved1[9] == MAKEFOURCC('N', 'V', 'T', 'T'))
+        {
+            // Clear out non-standard nVidia DDS flags
+            ddpfFlags &= ~0xC0000000 /* DDPF_SRGB | DDPF_NORMAL */;
+        }
+
+        constexpr size_t MAP_SIZE = sizeof(g_LegacyDDSMap) / sizeof(LegacyDDS);
+        size_t           index    = 0;
+
+        if ((ddpf.size == 0) && (ddpf.flags == 0) && (ddpf.fourCC != 0))
+        {
+            // Handle some DDS files where the DDPF_PIXELFORMAT is mostly zero
+            for (index = 0; index < MAP_SIZE; ++index)
+            {
+                const LegacyDDS* entry = &g_LegacyDDSMap[index];
+
+                if (entry->ddpf.flags & DDS_FOURCC)
+                {
+                    if (ddpf.fourCC == entry->ddpf.fourCC)
+                        break;
+                }
+            }
+        }
+        else
+        {
+            for (index = 0; index < MAP_SIZE; ++index)
+            {
+                const LegacyDDS* entry = &g_LegacyDDSMap[index];
+
+                if ((ddpfFlags & DDS_FOURCC) && (entry->ddpf.flags & DDS_FOURCC))
+                {
+                    // In case of FourCC codes, ignore any other bits in ddpf.flags
+                    if (ddpf.fourCC == entry->ddpf.fourCC)
+                        break;
+                }
+                else if ((ddpfFlags == entry->ddpf.flags) && (ddpf.RGBBitCount == entry->ddpf.RGBBitCount))
+                {
+                    if (entry->ddpf.flags & DDS_PAL8)
+                    {
+                        // PAL8 / PAL8A
+                        break;
+                    }
+                    else if (entry->ddpf.flags & DDS_ALPHA)
+                    {
+                        if (ddpf.ABitMask == entry->ddpf.ABitMask)
+                            break;
+                    }
+                    else if (entry->ddpf.flags & DDS_LUMINANCE)
+                    {
+                        if (entry->ddpf.flags & DDS_ALPHAPIXELS)
+                        {
+                            // LUMINANCEA
+                            if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
+                                (ddpf.ABitMask == entry->ddpf.ABitMask))
+                                break;
+                        }
+                        else
+                        {
+                            // LUMINANCE
+                            if (ddpf.RBitMask == entry->ddpf.RBitMask)
+                                break;
+                        }
+                    }
+                    else if (entry->ddpf.flags & DDS_BUMPDUDV)
+                    {
+                        if (entry->ddpf.flags & DDS_ALPHAPIXELS)
+                        {
+                            // BUMPDUDVA
+                            if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
+                                (ddpf.ABitMask == entry->ddpf.ABitMask))
+                            {
+                                flags &= ~DDS_FLAGS_NO_R10B10G10A2_FIXUP;
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            // BUMPDUDV
+                            if (ddpf.RBitMask == entry->ddpf.RBitMask)
+                                break;
+                        }
+                    }
+                    else if (entry->ddpf.flags & DDS_ALPHAPIXELS)
+                    {
+                        // RGBA
+                        if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
+                            (ddpf.GBitMask == entry->ddpf.GBitMask) &&
+                            (ddpf.BBitMask == entry->ddpf.BBitMask) &&
+                            (ddpf.ABitMask == entry->ddpf.ABitMask))
+                            break;
+                    }
+                    else
+                    {
+                        // RGB
+                        if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
+                            (ddpf.GBitMask == entry->ddpf.GBitMask) &&
+                            (ddpf.BBitMask == entry->ddpf.BBitMask))
+                            break;
+                    }
+                }
+            }
+        }
+
+        if (index >= MAP_SIZE)
+            return VK_FORMAT_UNDEFINED;
+
+        uint32_t cflags = g_LegacyDDSMap[index].convFlags;
+        VkFormat format = g_LegacyDDSMap[index].format;
+
+        if ((cflags & CONV_FLAGS_EXPAND) && (flags & DDS_FLAGS_NO_LEGACY_EXPANSION))
+            return VK_FORMAT_UNDEFINED;
+
+        if ((format == VK_FORMAT_A2R10G10B10_UNORM_PACK32) && (flags & DDS_FLAGS_NO_R10B10G10A2_FIXUP))
+        {
+            cflags ^= CONV_FLAGS_SWIZZLE;
+        }
+
+        if ((hdr.reserved1[9] == MAKEFOURCC('N', 'V', 'T', 'T')) &&
+            (ddpf.flags & 0x40000000 /* DDPF_SRGB */))
+        {
+            format = MakeSRGB(format);
+        }
+
+        convFlags = cflags;
+
+        return format;
+    }
+
+    void CopyScanline24bpp(
+        uint8_t* pDestination,
+        const uint8_t* pSource,
+        size_t width) noexcept
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            pDestination[0] = pSource[0]; // B
+            pDestination[1] = pSource[1]; // G
+            pDestination[2] = pSource[2]; // R
+
+            pSource      += 4;
+            pDestination += 3;
+        }
+    }
+
+    inline void TracedWrite(std::ofstream& outFile, const void* pData, size_t size)
+    {
+        Internal::SavePhaseTimer timer(SAVE_PHASE_WRITE, size);
+        outFile.write(static_cast<const char*>(pData), static_cast<std::streamsize>(size));
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Decodes DDS header including optional DX10 extended header
+    //-------------------------------------------------------------------------------------
+    bool DecodeDDSHeader(
+        const uint8_t* pSource,
+        size_t size,
+        DDS_FLAGS flags,
+        TexMetadata& metadata,
+        size_t& headerSize,
+        uint32_t& convFlags) noexcept
+    {
+        if (!pSource || (size < DDS_MIN_HEADER_SIZE))
+            return false;
+
+        uint32_t magic = 0;
+        memcpy(&magic, pSource, sizeof(magic));
+        if (magic != DDS_MAGIC)
+            return false;
+
+        DDS_HEADER header;
+        memcpy(&header, pSource + sizeof(uint32_t), sizeof(header));
+
+        // Some legacy writers leave the structure sizes blank
+        if (((header.size != sizeof(DDS_HEADER)) || (header.ddspf.size != sizeof(DDS_PIXELFORMAT)))
+            && !(flags & DDS_FLAGS_PERMISSIVE))
+            return false;
+
+        metadata = {};
+        metadata.mipLevels = header.mipMapCount ? header.mipMapCount : 1u;
+        headerSize = DDS_MIN_HEADER_SIZE;
+        convFlags  = CONV_FLAGS_NONE;
+
+        if ((header.ddspf.flags & DDS_FOURCC) && (header.ddspf.fourCC == MAKEFOURCC('D', 'X', '1', '0')))
+        {
+            if (size < DDS_DX10_HEADER_SIZE)
+                return false;
+
+            DDS_HEADER_DXT10 ext;
+            memcpy(&ext, pSource + DDS_MIN_HEADER_SIZE, sizeof(ext));
+
+            convFlags |= CONV_FLAGS_DX10;
+            headerSize = DDS_DX10_HEADER_SIZE;
+
+            metadata.arraySize = ext.arraySize;
+            if (!metadata.arraySize)
+                return false;
+
+            metadata.format = DXGIFormatToVkFormat(ext.dxgiFormat);
+            if (metadata.format == VK_FORMAT_UNDEFINED)
+                return false;
+
+            metadata.miscFlags = ext.miscFlag & ~static_cast<uint32_t>(TEX_MISC_TEXTURECUBE);
+
+            switch (ext.resourceDimension)
+            {
+                case DDS_DIMENSION_TEXTURE1D:
+                    if (header.height > 1)
+                        return false;
+
+                    metadata.width  = header.width;
+                    metadata.height = 1;
+                    metadata.depth  = 1;
+                    metadata.dimension = TEX_DIMENSION_TEXTURE1D;
+                    break;
+
+                case DDS_DIMENSION_TEXTURE2D:
+                    if (ext.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE)
+                    {
+                        metadata.miscFlags |= TEX_MISC_TEXTURECUBE;
+                        metadata.arraySize *= 6;
+                    }
+
+                    metadata.width  = header.width;
+                    metadata.height = header.height;
+                    metadata.depth  = 1;
+                    metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+                    break;
+
+                case DDS_DIMENSION_TEXTURE3D:
+                    if (!(header.flags & DDS_HEADER_FLAGS_VOLUME) || (metadata.arraySize > 1))
+                        return false;
+
+                    metadata.width  = header.width;
+                    metadata.height = header.height;
+                    metadata.depth  = header.depth;
+                    metadata.dimension = TEX_DIMENSION_TEXTURE3D;
+                    break;
+
+                default:
+                    return false;
+            }
+
+            metadata.miscFlags2 = ext.miscFlags2 & static_cast<uint32_t>(TEX_MISC2_ALPHA_MODE_MASK);
+        }
+        else
+        {
+            metadata.arraySize = 1;
+
+            if (header.flags & DDS_HEADER_FLAGS_VOLUME)
+            {
+                metadata.width  = header.width;
+                metadata.height = header.height;
+                metadata.depth  = header.depth;
+                metadata.dimension = TEX_DIMENSION_TEXTURE3D;
+            }
+            else
+            {
+                if (header.caps2 & DDS_CUBEMAP)
+                {
+                    // We require all six faces to be defined
+                    if ((header.caps2 & DDS_CUBEMAP_ALLFACES) != DDS_CUBEMAP_ALLFACES)
+                        return false;
+
+                    metadata.arraySize = 6;
+                    metadata.miscFlags |= TEX_MISC_TEXTURECUBE;
+                }
+
+                metadata.width  = header.width;
+                metadata.height = header.height;
+                metadata.depth  = 1;
+                metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+            }
+
+            metadata.format = GetDXGIFormat(header, header.ddspf, flags, convFlags);
+            if (metadata.format == VK_FORMAT_UNDEFINED)
+                return false;
+
+            // Data is used in its stored layout, legacy formats that need expanding or swizzling are not supported
+            if (convFlags & (CONV_FLAGS_EXPAND | CONV_FLAGS_PAL8 | CONV_FLAGS_SWIZZLE))
+                return false;
+
+            if (convFlags & CONV_FLAGS_PMALPHA)
+                metadata.SetAlphaMode(TEX_ALPHA_MODE_PREMULTIPLIED);
+
+            if (convFlags & CONV_FLAGS_NOALPHA)
+                metadata.SetAlphaMode(TEX_ALPHA_MODE_OPAQUE);
+        }
+
+        if (!metadata.width || !metadata.height || !metadata.depth)
+            return false;
+
+        // Direct3D 11 resource limits
+        if (!(flags & DDS_FLAGS_ALLOW_LARGE_FILES))
+        {
+            if ((metadata.width > 16384u) || (metadata.height > 16384u) || (metadata.arraySize > 2048u * 6u)
+                || ((metadata.dimension == TEX_DIMENSION_TEXTURE3D) && ((metadata.width > 2048u) || (metadata.height > 2048u) || (metadata.depth > 2048u))))
+                return false;
+        }
+
+        size_t maxDimension = std::max(metadata.width, metadata.height);
+        if (metadata.dimension == TEX_DIMENSION_TEXTURE3D)
+            maxDimension = std::max(maxDimension, metadata.depth);
+
+        if (metadata.mipLevels > static_cast<size_t>(std::bit_width(maxDimension)))
+            return false;
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Byte offsets (relative to the end of the header) of every subresource in DDS storage
+    // order, which is also the DetermineImageArray / SetupImageArray order.
+    // offsets[nimages] is the size of the whole payload.
+    //-------------------------------------------------------------------------------------
+    bool ComputeDDSLayout(const TexMetadata& metadata, CP_FLAGS cpFlags, std::vector<uint64_t>& offsets)
+    {
+        size_t nimages = 0, pixelSize = 0;
+        if (!DetermineImageArray(metadata, cpFlags, nimages, pixelSize))
+            return false;
+
+        offsets.clear();
+        offsets.reserve(nimages + 1);
+
+        uint64_t offset = 0;
+        auto addImage = [&](size_t level) noexcept
+        {
+            size_t rowPitch, slicePitch;
+            if (!ComputePitch(metadata.format,
+                std::max<size_t>(1u, metadata.width >> level), std::max<size_t>(1u, metadata.height >> level),
+                rowPitch, slicePitch, cpFlags))
+                return false;
+
+            offsets.push_back(offset);
+            offset += slicePitch;
+            return true;
+        };
+
+        if (metadata.dimension == TEX_DIMENSION_TEXTURE3D)
+        {
+            size_t d = metadata.depth;
+            for (size_t level = 0; level < metadata.mipLevels; ++level)
+            {
+                for (size_t slice = 0; slice < d; ++slice)
+                {
+                    if (!addImage(level))
+                        return false;
+                }
+
+                if (d > 1)
+                    d >>= 1;
+            }
+        }
+        else
+        {
+            for (size_t item = 0; item < metadata.arraySize; ++item)
+            {
+                for (size_t level = 0; level < metadata.mipLevels; ++level)
+                {
+                    if (!addImage(level))
+                        return false;
+                }
+            }
+        }
+
+        offsets.push_back(offset);
+        return offsets.size() == nimages + 1;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Metadata of mips [firstMip, firstMip + mipCount) of items [firstItem, firstItem + itemCount)
+    // (0 counts mean "to the end") and the index of each of its subresources in the full array
+    //-------------------------------------------------------------------------------------
+    bool GetSubresourceRange(
+        const TexMetadata& metadata,
+        size_t firstMip,
+        size_t mipCount,
+        size_t firstItem,
+        size_t itemCount,
+        TexMetadata& subset,
+        std::vector<size_t>& sourceIndices)
+    {
+        if ((firstMip >= metadata.mipLevels) || (firstItem >= metadata.arraySize))
+            return false;
+
+        if (!mipCount)
+            mipCount = metadata.mipLevels - firstMip;
+
+        if (!itemCount)
+            itemCount = metadata.arraySize - firstItem;
+
+        if ((mipCount > metadata.mipLevels - firstMip) || (itemCount > metadata.arraySize - firstItem))
+            return false;
+
+        subset = metadata;
+        subset.width     = std::max<size_t>(1u, metadata.width >> firstMip);
+        subset.height    = std::max<size_t>(1u, metadata.height >> firstMip);
+        subset.mipLevels = mipCount;
+        subset.arraySize = itemCount;
+
+        // A partial set of faces is a plain 2D array
+        if (metadata.IsCubemap() && ((firstItem % 6) || (itemCount % 6)))
+            subset.miscFlags &= ~static_cast<uint32_t>(TEX_MISC_TEXTURECUBE);
+
+        sourceIndices.clear();
+
+        if (metadata.dimension == TEX_DIMENSION_TEXTURE3D)
+        {
+            subset.depth = std::max<size_t>(1u, metadata.depth >> firstMip);
+
+            // Slices of consecutive mips are stored back to back
+            size_t first = 0, count = 0;
+            for (size_t level = 0; level < firstMip + mipCount; ++level)
+            {
+                const size_t slices = std::max<size_t>(1u, metadata.depth >> level);
+                if (level < firstMip)
+                    first += slices;
+                else
+                    count += slices;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                sourceIndices.push_back(first + i);
+            }
+        }
+        else
+        {
+            for (size_t item = 0; item < itemCount; ++item)
+            {
+                for (size_t level = 0; level < mipCount; ++level)
+                {
+                    sourceIndices.push_back((firstItem + item) * metadata.mipLevels + firstMip + level);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Fills the selected subresources of 'image'. readRun(offset, buffers, count) reads one
+    // contiguous range of the payload into 'count' consecutive destination buffers.
+    //-------------------------------------------------------------------------------------
+    struct ReadBuffer
+    {
+        uint8_t* pDestination;
+        size_t   size;
+    };
+
+    template<typename ReadRun>
+    bool LoadSubresources(
+        const std::vector<uint64_t>& offsets,
+        const std::vector<size_t>& sourceIndices,
+        const ScratchImage& image,
+        ReadRun&& readRun)
+    {
+        if (sourceIndices.size() != image.GetImageCount())
+            return false;
+
+        std::vector<ReadBuffer> buffers;
+        buffers.reserve(sourceIndices.size());
+
+        size_t index = 0;
+        while (index < sourceIndices.size())
+        {
+            buffers.clear();
+            const uint64_t runOffset = offsets[sourceIndices[index]];
+
+            // Coalesce subresources that follow each other in the file
+            do
+            {
+                const size_t source = sourceIndices[index];
+                const Image& dest = image.GetImages()[index];
+
+                if (offsets[source + 1] - offsets[source] != dest.slicePitch)
+                    return false;
+
+                buffers.push_back({ dest.pixels, dest.slicePitch });
+                ++index;
+            } while ((index < sourceIndices.size()) && (sourceIndices[index] == sourceIndices[index - 1] + 1));
+
+            if (!readRun(runOffset, buffers.data(), buffers.size()))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Legacy 'X' formats leave the alpha bits undefined
+    void SetOpaqueAlpha(const Image& image) noexcept
+    {
+        uint8_t* pRow = image.pixels;
+        for (size_t y = 0; y < image.height; ++y, pRow += image.rowPitch)
+        {
+            switch (image.format)
+            {
+                case VK_FORMAT_R8G8B8A8_UNORM:
+                    for (size_t x = 0; x < image.width; ++x)
+                    {
+                        pRow[x * 4 + 3] = 0xFF;
+                    }
+                    break;
+
+                // Stored with the Direct3D 9 layout, alpha in the top bits
+                case VK_FORMAT_B5G5R5A1_UNORM_PACK16:
+                    for (size_t x = 0; x < image.width; ++x)
+                    {
+                        pRow[x * 2 + 1] |= 0x80;
+                    }
+                    break;
+
+                case VK_FORMAT_B4G4R4A4_UNORM_PACK16:
+                    for (size_t x = 0; x < image.width; ++x)
+                    {
+                        pRow[x * 2 + 1] |= 0xF0;
+                    }
+                    break;
+
+                default:
+                    return;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Positional file reads, no shared file pointer (pread / ReadFile with an offset)
+    //-------------------------------------------------------------------------------------
+    class DDSFileReader
+    {
+    public:
+        DDSFileReader() noexcept = default;
+        DDSFileReader(const DDSFileReader&) = delete;
+        DDSFileReader& operator=(const DDSFileReader&) = delete;
+
+        ~DDSFileReader()
+        {
+#if _WIN32
+            if (m_file != INVALID_HANDLE_VALUE)
+                CloseHandle(m_file);
+#else
+            if (m_fd >= 0)
+                ::close(m_fd);
+#endif
+        }
+
+        bool Open(const char* szFile) noexcept
+        {
+#if _WIN32
+            try
+            {
+                m_file = CreateFileW(std::filesystem::path(szFile).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            }
+            catch (...)
+            {
+                return false;
+            }
+
+            LARGE_INTEGER fileSize = {};
+            if ((m_file == INVALID_HANDLE_VALUE) || !GetFileSizeEx(m_file, &fileSize))
+                return false;
+
+            m_size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+            m_fd = ::open(szFile, O_RDONLY | O_CLOEXEC);
+            if (m_fd < 0)
+                return false;
+
+            struct stat st = {};
+            if (fstat(m_fd, &st) != 0)
+                return false;
+
+            m_size = static_cast<uint64_t>(st.st_size);
+#endif
+            return true;
+        }
+
+        uint64_t GetSize() const noexcept { return m_size; }
+
+#if !_WIN32
+        int GetDescriptor() const noexcept { return m_fd; }
+#endif
+
+        bool Read(uint64_t offset, void* pDestination, size_t size) noexcept
+        {
+            auto ptr = static_cast<uint8_t*>(pDestination);
+            while (size > 0)
+            {
+#if _WIN32
+                OVERLAPPED overlapped = {};
+                overlapped.Offset     = static_cast<DWORD>(offset);
+                overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+                DWORD bytesRead = 0;
+                const DWORD request = static_cast<DWORD>(std::min<size_t>(size, 0x40000000u));
+                if (!ReadFile(m_file, ptr, request, &bytesRead, &overlapped) || !bytesRead)
+                    return false;
+#else
+                const ssize_t bytesRead = ::pread(m_fd, ptr, size, static_cast<off_t>(offset));
+                if (bytesRead < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return false;
+                }
+
+                if (bytesRead == 0)
+                    return false;
+#endif
+                ptr    += bytesRead;
+                offset += static_cast<uint64_t>(bytesRead);
+                size   -= static_cast<size_t>(bytesRead);
+            }
+
+            return true;
+        }
+
+        // One contiguous file range scattered into several buffers
+        bool ReadScatter(uint64_t offset, const ReadBuffer* buffers, size_t count) noexcept
+        {
+#if defined(__linux__)
+            // Single preadv for the common case, per-buffer reads to finish short transfers
+            constexpr size_t c_maxVectors = 1024;
+            if (count <= c_maxVectors)
+            {
+                iovec vectors[c_maxVectors];
+                size_t total = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    vectors[i].iov_base = buffers[i].pDestination;
+                    vectors[i].iov_len  = buffers[i].size;
+                    total += buffers[i].size;
+                }
+
+                const ssize_t bytesRead = ::preadv(m_fd, vectors, static_cast<int>(count), static_cast<off_t>(offset));
+                if ((bytesRead >= 0) && (static_cast<size_t>(bytesRead) == total))
+                    return true;
+            }
+#endif
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!Read(offset, buffers[i].pDestination, buffers[i].size))
+                    return false;
+
+                offset += buffers[i].size;
+            }
+
+            return true;
+        }
+
+    private:
+#if _WIN32
+        HANDLE   m_file = INVALID_HANDLE_VALUE;
+#else
+        int      m_fd = -1;
+#endif
+        uint64_t m_size = 0;
+    };
+
+    //-------------------------------------------------------------------------------------
+    // Loads a subresource range of a DDS image (or 'VTSC' container) held in memory
+    //-------------------------------------------------------------------------------------
+    bool LoadDDSMemory(
+        const uint8_t* pSource,
+        size_t size,
+        DDS_FLAGS flags,
+        size_t firstMip,
+        size_t mipCount,
+        size_t firstItem,
+        size_t itemCount,
+        TexMetadata* metadata,
+        ScratchImage& image,
+        bool metadataOnly) noexcept
+    {
+        image.Reset();
+
+        if (!pSource || !size)
+            return false;
+
+        try
+        {
+            // Supercompressed containers only decode the selected subresources
+            const uint8_t* pHeader = pSource;
+            size_t headerBytes = size;
+            const bool supercompressed = Internal::GetSupercompressedDDSHeader(pSource, size, pHeader, headerBytes);
+
+            TexMetadata mdata;
+            size_t headerSize = 0;
+            uint32_t convFlags = 0;
+            if (!DecodeDDSHeader(pHeader, headerBytes, flags, mdata, headerSize, convFlags))
+                return false;
+
+            const CP_FLAGS cpFlags = (flags & DDS_FLAGS_LEGACY_DWORD) ? CP_FLAGS_LEGACY_DWORD : CP_FLAGS_NONE;
+
+            std::vector<uint64_t> offsets;
+            if (!ComputeDDSLayout(mdata, cpFlags, offsets))
+                return false;
+
+            if (!supercompressed && (offsets.back() > size - headerSize))
+                return false;
+
+            // The chunk table is matched against the layout once, before anything is allocated
+            Internal::SupercompressedDDSIndex chunkIndex;
+            if (supercompressed && !Internal::DecodeSupercompressedDDS(pSource, size, headerSize, offsets, chunkIndex))
+                return false;
+
+            if (metadata)
+                *metadata = mdata;
+
+            if (metadataOnly)
+                return true;
+
+            TexMetadata subset;
+            std::vector<size_t> sourceIndices;
+            if (!GetSubresourceRange(mdata, firstMip, mipCount, firstItem, itemCount, subset, sourceIndices))
+                return false;
+
+            bool hr = image.Initialize(subset, cpFlags);
+            if (hr == false)
+                return hr;
+
+            if (supercompressed)
+            {
+                // VTSC chunks never carry the LEGACY_DWORD padding
+                hr = (cpFlags == CP_FLAGS_NONE);
+
+                for (size_t index = 0; hr && (index < sourceIndices.size()); ++index)
+                {
+                    const Image& dest = image.GetImages()[index];
+                    const size_t first = chunkIndex.firstChunk[sourceIndices[index]];
+                    const size_t last  = chunkIndex.firstChunk[sourceIndices[index] + 1];
+
+                    hr = Internal::DecompressChunks(chunkIndex.chunks.data() + first, last - first,
+                        chunkIndex.pPayload, chunkIndex.payloadSize, dest.pixels, dest.slicePitch);
+                }
+            }
+            else
+            {
+                const uint8_t* pPayload = pSource + headerSize;
+
+                hr = LoadSubresources(offsets, sourceIndices, image, [&](uint64_t offset, const ReadBuffer* buffers, size_t count) noexcept
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        memcpy(buffers[i].pDestination, pPayload + offset, buffers[i].size);
+                        offset += buffers[i].size;
+                    }
+                    return true;
+                });
+            }
+
+            if (hr == false)
+            {
+                image.Release();
+                return hr;
+            }
+
+            if (convFlags & CONV_FLAGS_NOALPHA)
+            {
+                for (size_t i = 0; i < image.GetImageCount(); ++i)
+                {
+                    SetOpaqueAlpha(image.GetImages()[i]);
+                }
+            }
+        }
+        catch (...)
+        {
+            image.Release();
+            return false;
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Loads a subresource range of a DDS file, reading only the header and the selected
+    // byte ranges ('VTSC' containers are read whole)
+    //-------------------------------------------------------------------------------------
+    bool LoadDDSFile(
+        const char* szFile,
+        DDS_FLAGS flags,
+        size_t firstMip,
+        size_t mipCount,
+        size_t firstItem,
+        size_t itemCount,
+        TexMetadata* metadata,
+        ScratchImage& image,
+        bool metadataOnly) noexcept
+    {
+        image.Reset();
+
+        if (!szFile)
+            return false;
+
+        try
+        {
+            DDSFileReader reader;
+            if (!reader.Open(szFile))
+                return false;
+
+            const uint64_t fileSize = reader.GetSize();
+            if (fileSize < sizeof(uint32_t))
+                return false;
+
+            uint8_t header[DDS_DX10_HEADER_SIZE] = {};
+            const size_t headerBytes = static_cast<size_t>(std::min<uint64_t>(fileSize, sizeof(header)));
+            if (!reader.Read(0, header, headerBytes))
+                return false;
+
+            uint32_t magic = 0;
+            memcpy(&magic, header, sizeof(magic));
+
+            if (magic == MAKEFOURCC('V', 'T', 'S', 'C'))
+            {
+                if (fileSize > SIZE_MAX)
+                    return false;
+
+                std::vector<uint8_t> source(static_cast<size_t>(fileSize));
+                if (!reader.Read(0, source.data(), source.size()))
+                    return false;
+
+                return LoadDDSMemory(source.data(), source.size(), flags, firstMip, mipCount, firstItem, itemCount,
+                    metadata, image, metadataOnly);
+            }
+
+            TexMetadata mdata;
+            size_t headerSize = 0;
+            uint32_t convFlags = 0;
+            if (!DecodeDDSHeader(header, headerBytes, flags, mdata, headerSize, convFlags))
+                return false;
+
+            const CP_FLAGS cpFlags = (flags & DDS_FLAGS_LEGACY_DWORD) ? CP_FLAGS_LEGACY_DWORD : CP_FLAGS_NONE;
+
+            std::vector<uint64_t> offsets;
+            if (!ComputeDDSLayout(mdata, cpFlags, offsets) || (offsets.back() > fileSize - headerSize))
+                return false;
+
+            if (metadata)
+                *metadata = mdata;
+
+            if (metadataOnly)
+                return true;
+
+            TexMetadata subset;
+            std::vector<size_t> sourceIndices;
+            if (!GetSubresourceRange(mdata, firstMip, mipCount, firstItem, itemCount, subset, sourceIndices))
+                return false;
+
+            bool hr = image.Initialize(subset, cpFlags);
+            if (hr == false)
+                return hr;
+
+#if !_WIN32
+            if (Internal::t_ioBackend != IO_BACKEND_DEFAULT)
+            {
+                // All selected subresources go to the backend as one batch
+                std::vector<Internal::IORequest> requests;
+                hr = LoadSubresources(offsets, sourceIndices, image, [&](uint64_t offset, const ReadBuffer* buffers, size_t count)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        requests.push_back({ headerSize + offset, buffers[i].pDestination, buffers[i].size });
+                        offset += buffers[i].size;
+                    }
+                    return true;
+                });
+
+                hr = hr && Internal::ReadBatch(reader.GetDescriptor(), requests.data(), requests.size());
+            }
+            else
+#endif
+            {
+                // Every run of subresources adjacent in the file is a single positional read
+                hr = LoadSubresources(offsets, sourceIndices, image, [&](uint64_t offset, const ReadBuffer* buffers, size_t count) noexcept
+                {
+                    return reader.ReadScatter(headerSize + offset, buffers, count);
+                });
+            }
+
+            if (hr == false)
+            {
+                image.Release();
+                return hr;
+            }
+
+            if (convFlags & CONV_FLAGS_NOALPHA)
+            {
+                for (size_t i = 0; i < image.GetImageCount(); ++i)
+                {
+                    SetOpaqueAlpha(image.GetImages()[i]);
+                }
+            }
+        }
+        catch (...)
+        {
+            image.Release();
+            return false;
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Pre-sized file writers
+    // The whole DDS layout is known before anything is written, so every subresource is
+    // split into row bands with a fixed file offset that workers can fill independently.
+    //-------------------------------------------------------------------------------------
+    struct DDSSaveBand
+    {
+        const Image* image;
+        uint64_t     offset;        // File offset of the band's first row
+        size_t       ddsRowPitch;
+        size_t       firstRow;
+        size_t       rowCount;
+        bool         contiguous;    // Source rows are already in DDS layout, the band is one copy
+    };
+
+    struct DDSSaveLayout
+    {
+        uint8_t                  header[DDS_DX10_HEADER_SIZE];
+        size_t                   headerSize;
+        uint64_t                 fileSize;
+        bool                     use24bpp;
+        std::vector<DDSSaveBand> bands;
+    };
+
+    constexpr size_t c_saveBandBytes = 4u * 1024u * 1024u;
+
+    bool ComputeDDSSaveLayout(
+        const Image* images,
+        size_t nimages,
+        const TexMetadata& metadata,
+        DDS_FLAGS flags,
+        DDSSaveLayout& layout,
+        size_t maxBandBytes = c_saveBandBytes) noexcept
+    {
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_HEADER_ENCODE);
+            if (!EncodeDDSHeader(metadata, flags, layout.header, sizeof(layout.header), layout.headerSize))
+                return false;
+            timer.AddBytes(layout.headerSize);
+        }
+
+        layout.use24bpp = ((metadata.format == VK_FORMAT_B8G8R8_UNORM)
+            && (flags & DDS_FLAGS_FORCE_24BPP_RGB)
+            && !(flags & (DDS_FLAGS_FORCE_DX10_EXT | DDS_FLAGS_FORCE_DX10_EXT_MISC2))) != 0;
+
+        size_t count = 0;
+        switch (static_cast<DDS_RESOURCE_DIMENSION>(metadata.dimension))
+        {
+            case DDS_DIMENSION_TEXTURE1D:
+            case DDS_DIMENSION_TEXTURE2D:
+                count = metadata.arraySize * metadata.mipLevels;
+                break;
+
+            case DDS_DIMENSION_TEXTURE3D:
+            {
+                if (metadata.arraySize != 1)
+                    return false;
+
+                for (size_t level = 0, d = metadata.depth; level < metadata.mipLevels; ++level)
+                {
+                    count += d;
+                    if (d > 1)
+                        d >>= 1;
+                }
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        if (!count || (count > nimages))
+            return false;
+
+        uint64_t offset = layout.headerSize;
+
+        try
+        {
+            layout.bands.clear();
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const Image& image = images[index];
+                if (!image.pixels || (image.format != metadata.format))
+                    return false;
+
+                size_t ddsRowPitch = 0;
+                size_t ddsSlicePitch = 0;
+                if (!ComputePitch(metadata.format, image.width, image.height, ddsRowPitch, ddsSlicePitch,
+                    layout.use24bpp ? CP_FLAGS_24BPP : CP_FLAGS_NONE))
+                    return false;
+
+                // Rows already in DDS layout go out as-is, 24bpp otherwise repacks from 32bpp pixels
+                const bool contiguous = (image.rowPitch == ddsRowPitch);
+                const size_t minPitch = layout.use24bpp ? image.width * 4 : ddsRowPitch;
+
+                // DDS uses 1-byte alignment, a shorter source pitch isn't a full line of data
+                if (!contiguous && (image.rowPitch < minPitch))
+                    return false;
+
+                const size_t lines = ComputeScanlines(metadata.format, image.height);
+                if (!lines || (ddsSlicePitch != ddsRowPitch * lines))
+                    return false;
+                const size_t rowsPerBand = std::max<size_t>(maxBandBytes / ddsRowPitch, 1u);
+
+                for (size_t row = 0; row < lines; row += rowsPerBand)
+                {
+                    const size_t rows = std::min(rowsPerBand, lines - row);
+                    layout.bands.push_back({ &image, offset + uint64_t(row) * ddsRowPitch, ddsRowPitch, row, rows, contiguous });
+                }
+
+                offset += ddsSlicePitch;
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        layout.fileSize = offset;
+        return true;
+    }
+
+    // Produces the DDS bytes of one band at pDestination
+    void FillDDSSaveBand(const DDSSaveBand& band, bool use24bpp, uint8_t* pDestination) noexcept
+    {
+        const Image& image = *band.image;
+        const uint8_t* sPtr = image.pixels + band.firstRow * image.rowPitch;
+
+        if (band.contiguous)
+        {
+            memcpy(pDestination, sPtr, band.rowCount * band.ddsRowPitch);
+            return;
+        }
+
+        for (size_t row = 0; row < band.rowCount; ++row)
+        {
+            if (use24bpp)
+                CopyScanline24bpp(pDestination, sPtr, image.width);
+            else
+                memcpy(pDestination, sPtr, band.ddsRowPitch);
+
+            sPtr += image.rowPitch;
+            pDestination += band.ddsRowPitch;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Bounded-memory writer (DDSSaveOptions::memoryBudget)
+    // Bands of at most 'budget' bytes are copied in file order into one scratch buffer of that
+    // size, which is written out whenever the next band no longer fits.
+    //-------------------------------------------------------------------------------------
+    bool SaveDDSBudgeted(const DDSSaveLayout& layout, size_t budget, const char* szFile) noexcept
+    {
+        const size_t scratchSize = static_cast<size_t>(std::min<uint64_t>(budget, layout.fileSize - layout.headerSize));
+
+        // A single row larger than the budget cannot be staged
+        for (const DDSSaveBand& band : layout.bands)
+        {
+            if (band.rowCount * band.ddsRowPitch > scratchSize)
+                return false;
+        }
+
+        std::unique_ptr<uint8_t[]> scratch;
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_ALLOCATE, scratchSize);
+            scratch.reset(new (std::nothrow) uint8_t[scratchSize]);
+            if (!scratch)
+                return false;
+        }
+
+        try
+        {
+            std::ofstream outFile{ std::filesystem::path(szFile), std::ios::out | std::ios::binary | std::ios::trunc };
+            if (!outFile)
+                return false;
+
+            TracedWrite(outFile, layout.header, layout.headerSize);
+
+            size_t used = 0;
+            for (const DDSSaveBand& band : layout.bands)
+            {
+                const size_t size = band.rowCount * band.ddsRowPitch;
+
+                if (used + size > scratchSize)
+                {
+                    TracedWrite(outFile, scratch.get(), used);
+                    if (!outFile)
+                        return false;
+                    used = 0;
+                }
+
+                {
+                    Internal::SavePhaseTimer timer(layout.use24bpp ? SAVE_PHASE_REPACK : SAVE_PHASE_COPY, size);
+                    FillDDSSaveBand(band, layout.use24bpp, scratch.get() + used);
+                }
+                used += size;
+            }
+
+            TracedWrite(outFile, scratch.get(), used);
+            return static_cast<bool>(outFile);
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+#if !_WIN32
+    bool WriteAt(int fd, const void* pData, size_t size, uint64_t offset) noexcept
+    {
+        auto ptr = static_cast<const uint8_t*>(pData);
+        while (size > 0)
+        {
+            const ssize_t written = ::pwrite(fd, ptr, size, static_cast<off_t>(offset));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            if (written == 0)
+                return false;
+
+            ptr += written;
+            offset += static_cast<uint64_t>(written);
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    // Fallback when the file cannot be mapped: bands go out with positioned writes from
+    // the same workers, staged through a per-worker buffer when they need repacking
+    bool WriteDDSBands(int fd, const DDSSaveLayout& layout) noexcept
+    {
+        if (!WriteAt(fd, layout.header, layout.headerSize, 0))
+            return false;
+
+        std::atomic<bool> failed{ false };
+
+        Internal::ParallelFor(layout.bands.size(), 1, [&](size_t begin, size_t end) noexcept
+        {
+            std::vector<uint8_t> staging;
+
+            for (size_t i = begin; (i < end) && !failed.load(std::memory_order_relaxed); ++i)
+            {
+                const DDSSaveBand& band = layout.bands[i];
+                const size_t size = band.rowCount * band.ddsRowPitch;
+
+                const void* pData = nullptr;
+                if (band.contiguous)
+                {
+                    pData = band.image->pixels + band.firstRow * band.image->rowPitch;
+                }
+                else
+                {
+                    try
+                    {
+                        staging.resize(size);
+                    }
+                    catch (...)
+                    {
+                        failed = true;
+                        return;
+                    }
+
+                    FillDDSSaveBand(band, layout.use24bpp, staging.data());
+                    pData = staging.data();
+                }
+
+                if (!WriteAt(fd, pData, size, band.offset))
+                    failed = true;
+            }
+        });
+
+        return !failed;
+    }
+
+    bool SaveDDSMapped(const DDSSaveLayout& layout, const char* szFile) noexcept
+    {
+        if (layout.fileSize > SIZE_MAX)
+            return false;
+
+        const int fd = ::open(szFile, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd < 0)
+            return false;
+
+        const size_t size = static_cast<size_t>(layout.fileSize);
+        void* mapping = MAP_FAILED;
+
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_ALLOCATE, size);
+
+            // Reserve the blocks up front; file systems without fallocate just get the size
+            if (fallocate(fd, 0, 0, static_cast<off_t>(size)) != 0)
+            {
+                if (((errno != EOPNOTSUPP) && (errno != ENOSYS)) || (ftruncate(fd, static_cast<off_t>(size)) != 0))
+                {
+                    ::close(fd);
+                    return false;
+                }
+            }
+
+            mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+
+        if (mapping == MAP_FAILED)
+        {
+            Internal::SavePhaseTimer timer(SAVE_PHASE_WRITE, size);
+            const bool hr = WriteDDSBands(fd, layout);
+            return (::close(fd) == 0) && hr;
+        }
+
+        auto pDestination = static_cast<uint8_t*>(mapping);
+        memcpy(pDestination, layout.header, layout.headerSize);
+
+        {
+            Internal::SavePhaseTimer timer(layout.use24bpp ? SAVE_PHASE_REPACK : SAVE_PHASE_COPY, size - layout.headerSize);
+
+            Internal::ParallelFor(layout.bands.size(), 1, [&](size_t begin, size_t end) noexcept
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    FillDDSSaveBand(layout.bands[i], layout.use24bpp, pDestination + layout.bands[i].offset);
+                }
+            });
+        }
+
+        Internal::SavePhaseTimer timer(SAVE_PHASE_WRITE, size);
+
+        // MS_ASYNC starts writeback without waiting for it, the same durability as a closed stream
+        bool hr = (msync(mapping, size, MS_ASYNC) == 0);
+        hr = (munmap(mapping, size) == 0) && hr;
+        hr = (::close(fd) == 0) && hr;
+        return hr;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Batched writer (IO_BACKEND_THREAD_POOL, IO_BACKEND_IO_URING)
+    // The header and every band go to the backend as positional writes. Tightly packed bands
+    // are written straight from the source images; the others are repacked into the backend's
+    // registered staging buffer, flushing the batch whenever it fills up.
+    //-------------------------------------------------------------------------------------
+    bool SaveDDSBatched(const DDSSaveLayout& layout, const char* szFile) noexcept
+    {
+        const int fd = ::open(szFile, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd < 0)
+            return false;
+
+        bool hr = true;
+        try
+        {
+            size_t stagingSize = 0;
+            uint8_t* staging = Internal::GetIOStaging(stagingSize);
+
+            std::vector<uint8_t> ownStaging;
+            if (!staging)
+            {
+                ownStaging.resize(c_saveBandBytes);
+                staging = ownStaging.data();
+                stagingSize = ownStaging.size();
+            }
+
+            std::vector<Internal::IORequest> requests;
+            requests.reserve(layout.bands.size() + 1);
+            requests.push_back({ 0, const_cast<uint8_t*>(layout.header), layout.headerSize });
+
+            uint64_t pending = layout.headerSize;
+            size_t used = 0;
+
+            auto flush = [&]() noexcept
+            {
+                Internal::SavePhaseTimer timer(SAVE_PHASE_WRITE, pending);
+                const bool result = Internal::WriteBatch(fd, requests.data(), requests.size());
+                requests.clear();
+                pending = 0;
+                used = 0;
+                return result;
+            };
+
+            std::vector<uint8_t> oversized;
+            for (size_t i = 0; hr && (i < layout.bands.size()); ++i)
+            {
+                const DDSSaveBand& band = layout.bands[i];
+                const size_t size = band.rowCount * band.ddsRowPitch;
+
+                if (band.contiguous)
+                {
+                    requests.push_back({ band.offset, const_cast<uint8_t*>(band.image->pixels) + band.firstRow * band.image->rowPitch, size });
+                    pending += size;
+                    continue;
+                }
+
+                // The staging buffer is reused, so whatever already points into it goes out first
+                if ((used + size > stagingSize) && used)
+                    hr = flush();
+
+                uint8_t* pDestination = staging + used;
+                if (size > stagingSize)
+                {
+                    // Single rows wider than the staging buffer
+                    oversized.resize(size);
+                    pDestination = oversized.data();
+                }
+                else
+                {
+                    used += size;
+                }
+
+                {
+                    Internal::SavePhaseTimer timer(layout.use24bpp ? SAVE_PHASE_REPACK : SAVE_PHASE_COPY, size);
+                    FillDDSSaveBand(band, layout.use24bpp, pDestination);
+                }
+
+                requests.push_back({ band.offset, pDestination, size });
+                pending += size;
+
+                if (pDestination == oversized.data())
+                    hr = hr && flush();
+            }
+
+            hr = hr && flush();
+        }
+        catch (...)
+        {
+            hr = false;
+        }
+
+        return (::close(fd) == 0) && hr;
+    }
+
+#if defined(__linux__)
+    //-------------------------------------------------------------------------------------
+    // O_DIRECT writer
+    // The file is streamed front to back through a ring of page-aligned buffers: the calling
+    // thread fills the next buffer while a writer thread hands full ones to the kernel. Every
+    // buffer but the last is full, so each write starts at an aligned file offset; the tail is
+    // zero padded to the alignment and the file size fixed up afterwards.
+    //-------------------------------------------------------------------------------------
+    constexpr size_t c_directIOAlignment   = 4096;
+    constexpr size_t c_directIOBufferBytes = 8u * 1024u * 1024u;
+    constexpr size_t c_directIOBufferCount = 3;
+
+    class DirectIOWriter
+    {
+    public:
+        explicit DirectIOWriter(int fd) noexcept :
+            m_fd(fd),
+            m_buffers{},
+            m_sizes{},
+            m_submitted(0),
+            m_written(0),
+            m_fill(0),
+            m_closing(false),
+            m_failed(false),
+            m_scope(Internal::t_saveTraceScope)
+        {
+        }
+
+        ~DirectIOWriter()
+        {
+            Close();
+
+            for (auto buffer : m_buffers)
+            {
+                std::free(buffer);
+            }
+        }
+
+        DirectIOWriter(const DirectIOWriter&) = delete;
+        DirectIOWriter& operator=(const DirectIOWriter&) = delete;
+
+        bool Start() noexcept
+        {
+            for (auto& buffer : m_buffers)
+            {
+                buffer = static_cast<uint8_t*>(std::aligned_alloc(c_directIOAlignment, c_directIOBufferBytes));
+                if (!buffer)
+                    return false;
+            }
+
+            try
+            {
+                m_thread = std::thread([this]() noexcept { Run(); });
+            }
+            catch (...)
+            {
+                return false;
+            }
+
+            return true;
+        }
+
+        bool Append(const void* pData, size_t size) noexcept
+        {
+            auto ptr = static_cast<const uint8_t*>(pData);
+            while (size > 0)
+            {
+                if ((m_fill == c_directIOBufferBytes) && !Submit())
+                    return false;
+
+                const size_t bytes = std::min(size, c_directIOBufferBytes - m_fill);
+                memcpy(Current() + m_fill, ptr, bytes);
+
+                m_fill += bytes;
+                ptr += bytes;
+                size -= bytes;
+            }
+            return true;
+        }
+
+        // Space for 'size' bytes in the current buffer, nullptr when they would straddle two buffers
+        uint8_t* Claim(size_t size) noexcept
+        {
+            if ((m_fill == c_directIOBufferBytes) && !Submit())
+                return nullptr;
+
+            return (size <= c_directIOBufferBytes - m_fill) ? Current() + m_fill : nullptr;
+        }
+
+        void Commit(size_t size) noexcept { m_fill += size; }
+
+        // Writes the padded tail, waits for the writer thread and trims the padding off the file
+        bool Finish(uint64_t fileSize) noexcept
+        {
+            if (m_fill > 0)
+            {
+                const size_t padded = (m_fill + c_directIOAlignment - 1) & ~(c_directIOAlignment - 1);
+                memset(Current() + m_fill, 0, padded - m_fill);
+                m_fill = padded;
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_sizes[m_submitted % c_directIOBufferCount] = m_fill;
+                ++m_submitted;
+                m_fill = 0;
+            }
+
+            if (!Close())
+                return false;
+
+            return ftruncate(m_fd, static_cast<off_t>(fileSize)) == 0;
+        }
 
-    VkFormat GetDXGIFormat(const DDS_HEADER& hdr, const DDS_PIXELFORMAT& ddpf,
-                           DDS_FLAGS flags, uint32_t& convFlags) noexcept
-    {
-        uint32_t ddpfFlags = ddpf.flags;
+    private:
+        uint8_t* Current() const noexcept { return m_buffers[m_submitted % c_directIOBufferCount]; }
 
-        if (hdr.reserved1[9] == MAKEFOURCC('N', 'V', 'T', 'T'))
+        // Hands the current buffer to the writer thread and waits until the next one is free
+        bool Submit() noexcept
         {
-            // Clear out non-standard nVidia DDS flags
-            ddpfFlags &= ~0xC0000000 /* DDPF_SRGB | DDPF_NORMAL */;
-        }
+            std::unique_lock<std::mutex> lock(m_mutex);
 
-        constexpr size_t MAP_SIZE = sizeof(g_LegacyDDSMap) / sizeof(LegacyDDS);
-        size_t           index    = 0;
+            m_sizes[m_submitted % c_directIOBufferCount] = m_fill;
+            ++m_submitted;
+            m_fill = 0;
+            m_cv.notify_all();
 
-        if ((ddpf.size == 0) && (ddpf.flags == 0) && (ddpf.fourCC != 0))
+            m_cv.wait(lock, [this]() { return m_failed || (m_submitted - m_written < c_directIOBufferCount); });
+            return !m_failed;
+        }
+
+        bool Close() noexcept
         {
-            // Handle some DDS files where the DDPF_PIXELFORMAT is mostly zero
-            for (index = 0; index < MAP_SIZE; ++index)
+            if (m_thread.joinable())
             {
-                const LegacyDDS* entry = &g_LegacyDDSMap[index];
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_closing = true;
+                }
+                m_cv.notify_all();
+                m_thread.join();
 
-                if (entry->ddpf.flags & DDS_FOURCC)
+                // Write time shows up in the caller's statistics, reported from the caller's thread
+                if (m_scope)
                 {
-                    if (ddpf.fourCC == entry->ddpf.fourCC)
-                        break;
+                    for (const WriteRecord& record : m_records)
+                        m_scope->Record(SAVE_PHASE_WRITE, record.start, record.duration, record.bytes);
                 }
+                m_records.clear();
             }
+
+            return !m_failed;
         }
-        else
+
+        void Run() noexcept
         {
-            for (index = 0; index < MAP_SIZE; ++index)
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for (;;)
             {
-                const LegacyDDS* entry = &g_LegacyDDSMap[index];
+                m_cv.wait(lock, [this]() { return m_closing || (m_written < m_submitted); });
+                if (m_written == m_submitted)
+                    break;
 
-                if ((ddpfFlags & DDS_FOURCC) && (entry->ddpf.flags & DDS_FOURCC))
-                {
-                    // In case of FourCC codes, ignore any other bits in ddpf.flags
-                    if (ddpf.fourCC == entry->ddpf.fourCC)
-                        break;
-                }
-                else if ((ddpfFlags == entry->ddpf.flags) && (ddpf.RGBBitCount == entry->ddpf.RGBBitCount))
+                const size_t index = m_written % c_directIOBufferCount;
+                const size_t size = m_sizes[index];
+                const uint64_t offset = m_written * c_directIOBufferBytes;
+                bool hr = !m_failed;
+
+                lock.unlock();
+                if (hr)
                 {
-                    if (entry->ddpf.flags & DDS_PAL8)
-                    {
-                        // PAL8 / PAL8A
-                        break;
-                    }
-                    else if (entry->ddpf.flags & DDS_ALPHA)
-                    {
-                        if (ddpf.ABitMask == entry->ddpf.ABitMask)
-                            break;
-                    }
-                    else if (entry->ddpf.flags & DDS_LUMINANCE)
-                    {
-                        if (entry->ddpf.flags & DDS_ALPHAPIXELS)
-                        {
-                            // LUMINANCEA
-                            if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
-                                (ddpf.ABitMask == entry->ddpf.ABitMask))
-                                break;
-                        }
-                        else
-                        {
-                            // LUMINANCE
-                            if (ddpf.RBitMask == entry->ddpf.RBitMask)
-                                break;
-                        }
-                    }
-                    else if (entry->ddpf.flags & DDS_BUMPDUDV)
+                    const uint64_t start = m_scope ? Internal::GetTraceTimestamp() : 0;
+                    hr = WriteAt(m_fd, m_buffers[index], size, offset);
+
+                    if (m_scope)
                     {
-                        if (entry->ddpf.flags & DDS_ALPHAPIXELS)
+                        // Losing a record only affects the statistics
+                        try
                         {
-                            // BUMPDUDVA
-                            if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
-                                (ddpf.ABitMask == entry->ddpf.ABitMask))
-                            {
-                                flags &= ~DDS_FLAGS_NO_R10B10G10A2_FIXUP;
-                                break;
-                            }
+                            m_records.push_back({ start, Internal::GetTraceTimestamp() - start, size });
                         }
-                        else
+                        catch (...)
                         {
-                            // BUMPDUDV
-                            if (ddpf.RBitMask == entry->ddpf.RBitMask)
-                                break;
                         }
                     }
-                    else if (entry->ddpf.flags & DDS_ALPHAPIXELS)
-                    {
-                        // RGBA
-                        if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
-                            (ddpf.GBitMask == entry->ddpf.GBitMask) &&
-                            (ddpf.BBitMask == entry->ddpf.BBitMask) &&
-                            (ddpf.ABitMask == entry->ddpf.ABitMask))
-                            break;
-                    }
-                    else
-                    {
-                        // RGB
-                        if ((ddpf.RBitMask == entry->ddpf.RBitMask) &&
-                            (ddpf.GBitMask == entry->ddpf.GBitMask) &&
-                            (ddpf.BBitMask == entry->ddpf.BBitMask))
-                            break;
-                    }
                 }
+                lock.lock();
+
+                if (!hr)
+                    m_failed = true;
+
+                ++m_written;
+                m_cv.notify_all();
             }
         }
 
-        if (index >= MAP_SIZE)
-            return VK_FORMAT_UNDEFINED;
-
-        uint32_t cflags = g_LegacyDDSMap[index].convFlags;
-        VkFormat format = g_LegacyDDSMap[index].format;
+        struct WriteRecord
+        {
+            uint64_t start;
+            uint64_t duration;
+            uint64_t bytes;
+        };
+
+        int                     m_fd;
+        uint8_t*                m_buffers[c_directIOBufferCount];
+        size_t                  m_sizes[c_directIOBufferCount];
+        uint64_t                m_submitted;    // Buffers handed to the writer thread
+        uint64_t                m_written;      // Buffers the writer thread is done with
+        size_t                  m_fill;         // Bytes in the current buffer
+        bool                    m_closing;
+        bool                    m_failed;
+        const SaveTraceScope*   m_scope;
+        std::vector<WriteRecord> m_records;     // Writer thread only until it is joined
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        std::thread             m_thread;
+    };
 
-        if ((cflags & CONV_FLAGS_EXPAND) && (flags & DDS_FLAGS_NO_LEGACY_EXPANSION))
-            return VK_FORMAT_UNDEFINED;
+    // 'unsupported' is set when the file system rejects O_DIRECT and nothing has been written
+    bool SaveDDSDirect(const DDSSaveLayout& layout, const char* szFile, bool& unsupported) noexcept
+    {
+        unsupported = false;
 
-        if ((format == VK_FORMAT_A2R10G10B10_UNORM_PACK32) && (flags & DDS_FLAGS_NO_R10B10G10A2_FIXUP))
+        const int fd = ::open(szFile, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | O_DIRECT, 0666);
+        if (fd < 0)
         {
-            cflags ^= CONV_FLAGS_SWIZZLE;
+            unsupported = (errno == EINVAL);
+            return false;
         }
 
-        if ((hdr.reserved1[9] == MAKEFOURCC('N', 'V', 'T', 'T')) &&
-            (ddpf.flags & 0x40000000 /* DDPF_SRGB */))
+        bool hr;
         {
-            format = MakeSRGB(format);
-        }
+            DirectIOWriter writer(fd);
+            hr = writer.Start() && writer.Append(layout.header, layout.headerSize);
 
-        convFlags = cflags;
+            if (hr)
+            {
+                Internal::SavePhaseTimer timer(layout.use24bpp ? SAVE_PHASE_REPACK : SAVE_PHASE_COPY, layout.fileSize - layout.headerSize);
 
-        return format;
-    }
+                std::vector<uint8_t> staging;
+                for (const DDSSaveBand& band : layout.bands)
+                {
+                    const size_t size = band.rowCount * band.ddsRowPitch;
 
-    void CopyScanline24bpp(
-        uint8_t* pDestination,
-        const uint8_t* pSource,
-        size_t width) noexcept
-    {
-        for (size_t x = 0; x < width; ++x)
-        {
-            pDestination[0] = pSource[0]; // B
-            pDestination[1] = pSource[1]; // G
-            pDestination[2] = pSource[2]; // R
+                    if (band.contiguous)
+                    {
+                        hr = writer.Append(band.image->pixels + band.firstRow * band.image->rowPitch, size);
+                    }
+                    else if (uint8_t* pDestination = writer.Claim(size))
+                    {
+                        FillDDSSaveBand(band, layout.use24bpp, pDestination);
+                        writer.Commit(size);
+                    }
+                    else
+                    {
+                        try
+                        {
+                            staging.resize(size);
+                        }
+                        catch (...)
+                        {
+                            hr = false;
+                            break;
+                        }
 
-            pSource      += 4;
-            pDestination += 3;
+                        FillDDSSaveBand(band, layout.use24bpp, staging.data());
+                        hr = writer.Append(staging.data(), size);
+                    }
+
+                    if (!hr)
+                        break;
+                }
+            }
+
+            hr = hr && writer.Finish(layout.fileSize);
         }
+
+        return (::close(fd) == 0) && hr;
     }
+#endif // __linux__
+#endif // !_WIN32
 }
 
 
@@ -804,12 +2427,23 @@ bool VulkanTex::SaveToDDSMemory(
     if (!images || (nimages == 0))
         return false;
 
+    if (flags & (DDS_FLAGS_SUPERCOMPRESS_FAST | DDS_FLAGS_SUPERCOMPRESS_HIGH))
+    {
+        Internal::SavePhaseTimer timer(SAVE_PHASE_COMPRESS);
+        const bool hr = Internal::SaveSupercompressedDDS(images, nimages, metadata, flags, blob);
+        if (hr)
+            timer.AddBytes(blob.GetBufferSize());
+        return hr;
+    }
+
     // Determine memory required
     size_t required = 0;
     bool hr = EncodeDDSHeader(metadata, flags, nullptr, 0, required);
     if (hr == false)
         return hr;
 
+    const size_t headerSize = required;
+
     bool fastpath = true;
     const bool use24bpp = ((metadata.format == VK_FORMAT_B8G8R8_UNORM)
         && (flags & DDS_FLAGS_FORCE_24BPP_RGB)
@@ -845,9 +2479,10 @@ bool VulkanTex::SaveToDDSMemory(
 
     assert(required > 0);
 
-    blob.Release();
-
-    hr = blob.Initialize(required);
+    {
+        Internal::SavePhaseTimer timer(SAVE_PHASE_ALLOCATE, required);
+        hr = blob.Initialize(required);
+    }
 
     if (hr == false)
         return hr;
@@ -855,7 +2490,10 @@ bool VulkanTex::SaveToDDSMemory(
     auto pDestination = blob.GetBufferPointer();
     assert(pDestination);
 
-    hr = EncodeDDSHeader(metadata, flags, pDestination, blob.GetBufferSize(), required);
+    {
+        Internal::SavePhaseTimer timer(SAVE_PHASE_HEADER_ENCODE, headerSize);
+        hr = EncodeDDSHeader(metadata, flags, pDestination, blob.GetBufferSize(), required);
+    }
 
     if (hr == false)
     {
@@ -872,6 +2510,8 @@ bool VulkanTex::SaveToDDSMemory(
         return false;
     }
 
+    Internal::SavePhaseTimer copyTimer(use24bpp ? SAVE_PHASE_REPACK : SAVE_PHASE_COPY, remaining);
+
     switch (static_cast<DDS_RESOURCE_DIMENSION>(metadata.dimension))
     {
         case DDS_DIMENSION_TEXTURE1D:
@@ -907,7 +2547,14 @@ bool VulkanTex::SaveToDDSMemory(
                             return hr;
                         }
 
+                        // Repacked rows are read as 32bpp pixels, as in ComputeDDSSaveLayout
                         const size_t rowPitch = images[index].rowPitch;
+                        if (rowPitch < images[index].width * 4)
+                        {
+                            blob.Release();
+                            return false;
+                        }
+
                         const uint8_t * __restrict sPtr = images[index].pixels;
                         uint8_t * __restrict dPtr = pDestination;
 
@@ -1015,7 +2662,14 @@ bool VulkanTex::SaveToDDSMemory(
                             return hr;
                         }
 
+                        // Repacked rows are read as 32bpp pixels, as in ComputeDDSSaveLayout
                         const size_t rowPitch = images[index].rowPitch;
+                        if (rowPitch < images[index].width * 4)
+                        {
+                            blob.Release();
+                            return false;
+                        }
+
                         const uint8_t * __restrict sPtr = images[index].pixels;
                         uint8_t * __restrict dPtr = pDestination;
 
@@ -1104,15 +2758,83 @@ bool VulkanTex::SaveToDDSFile(
     const TexMetadata& metadata,
     DDS_FLAGS flags,
     const char* szFile) noexcept
+{
+    return SaveToDDSFile(images, nimages, metadata, flags, DDSSaveOptions{}, szFile);
+}
+
+bool VulkanTex::SaveToDDSFile(
+    const Image* images,
+    size_t nimages,
+    const TexMetadata& metadata,
+    DDS_FLAGS flags,
+    const DDSSaveOptions& options,
+    const char* szFile) noexcept
 {
     if (szFile == nullptr)
         return false;
 
+    if (flags & (DDS_FLAGS_SUPERCOMPRESS_FAST | DDS_FLAGS_SUPERCOMPRESS_HIGH))
+    {
+        Blob container;
+        bool hr = SaveToDDSMemory(images, nimages, metadata, flags, container);
+        if (hr == false)
+            return hr;
+
+        std::ofstream outFile{ std::filesystem::path(szFile), std::ios::out | std::ios::binary | std::ios::trunc };
+        if (!outFile)
+            return false;
+
+        TracedWrite(outFile, container.GetBufferPointer(), container.GetBufferSize());
+        return static_cast<bool>(outFile);
+    }
+
+    if (options.memoryBudget)
+    {
+        DDSSaveLayout layout = {};
+        if (!ComputeDDSSaveLayout(images, nimages, metadata, flags, layout, options.memoryBudget))
+            return false;
+
+        return SaveDDSBudgeted(layout, options.memoryBudget, szFile);
+    }
+
+#if !_WIN32
+    if (options.directIOThreshold || (flags & DDS_FLAGS_MAPPED_FILE) || (Internal::t_ioBackend != IO_BACKEND_DEFAULT))
+    {
+        DDSSaveLayout layout = {};
+        if (ComputeDDSSaveLayout(images, nimages, metadata, flags, layout))
+        {
+#if defined(__linux__)
+            if (options.directIOThreshold && (layout.fileSize >= options.directIOThreshold))
+            {
+                bool unsupported = false;
+                const bool hr = SaveDDSDirect(layout, szFile, unsupported);
+                if (!unsupported)
+                    return hr;
+            }
+#endif
+            if (flags & DDS_FLAGS_MAPPED_FILE)
+                return SaveDDSMapped(layout, szFile);
+
+            if (Internal::t_ioBackend != IO_BACKEND_DEFAULT)
+                return SaveDDSBatched(layout, szFile);
+        }
+        else if (flags & DDS_FLAGS_MAPPED_FILE)
+        {
+            return false;
+        }
+    }
+#endif
+
     // Create DDS Header
     uint8_t header[DDS_DX10_HEADER_SIZE] = {};
     size_t  required                     = 0;
 
-    bool hr = EncodeDDSHeader(metadata, flags, header, DDS_DX10_HEADER_SIZE, required);
+    bool hr;
+    {
+        Internal::SavePhaseTimer timer(SAVE_PHASE_HEADER_ENCODE);
+        hr = EncodeDDSHeader(metadata, flags, header, DDS_DX10_HEADER_SIZE, required);
+        timer.AddBytes(required);
+    }
 
     if (hr == false)
         return hr;
@@ -1123,7 +2845,7 @@ bool VulkanTex::SaveToDDSFile(
     if (!outFile)
         return false;
 
-    outFile.write(reinterpret_cast<char*>(header), static_cast<std::streamsize>(required));
+    TracedWrite(outFile, header, required);
 
     if (!outFile)
         return false;
@@ -1185,25 +2907,30 @@ bool VulkanTex::SaveToDDSFile(
 
                     if ((images[index].slicePitch == ddsSlicePitch) && (ddsSlicePitch <= UINT32_MAX))
                     {
-                        outFile.write(reinterpret_cast<char*>(images[index].pixels),
-                                      static_cast<std::streamsize>(ddsSlicePitch));
+                        TracedWrite(outFile, images[index].pixels, ddsSlicePitch);
 
                         if (!outFile)
                             return false;
                     }
                     else if (use24bpp)
                     {
+                        // Repacked rows are read as 32bpp pixels, as in ComputeDDSSaveLayout
                         const size_t               rowPitch = images[index].rowPitch;
                         const uint8_t * __restrict sPtr     = images[index].pixels;
 
                         assert(ddsRowPitch <= metadata.width * 3u);
 
+                        if (rowPitch < images[index].width * 4)
+                            return false;
+
                         for (size_t j = 0; j < images[index].height; ++j)
                         {
-                            CopyScanline24bpp(tempRow.get(), sPtr, images[index].width);
+                            {
+                                Internal::SavePhaseTimer timer(SAVE_PHASE_REPACK, ddsRowPitch);
+                                CopyScanline24bpp(tempRow.get(), sPtr, images[index].width);
+                            }
 
-                            outFile.write(reinterpret_cast<const char*>(tempRow.get()),
-                                          static_cast<std::streamsize>(ddsRowPitch));
+                            TracedWrite(outFile, tempRow.get(), ddsRowPitch);
 
                             if (!outFile)
                                 return false;
@@ -1230,7 +2957,7 @@ bool VulkanTex::SaveToDDSFile(
 
                         for (size_t j = 0; j < lines; ++j)
                         {
-                            outFile.write(reinterpret_cast<const char*>(sPtr), static_cast<std::streamsize>(ddsRowPitch));
+                            TracedWrite(outFile, sPtr, ddsRowPitch);
 
                             if (!outFile)
                                 return false;
@@ -1278,25 +3005,30 @@ bool VulkanTex::SaveToDDSFile(
 
                     if ((images[index].slicePitch == ddsSlicePitch) && (ddsSlicePitch <= UINT32_MAX))
                     {
-                        outFile.write(reinterpret_cast<char*>(images[index].pixels),
-                                      static_cast<std::streamsize>(ddsSlicePitch));
+                        TracedWrite(outFile, images[index].pixels, ddsSlicePitch);
 
                         if (!outFile)
                             return false;
                     }
                     else if (use24bpp)
                     {
+                        // Repacked rows are read as 32bpp pixels, as in ComputeDDSSaveLayout
                         const size_t rowPitch = images[index].rowPitch;
                         const uint8_t * __restrict sPtr = images[index].pixels;
 
                         assert(ddsRowPitch <= metadata.width * 3u);
 
+                        if (rowPitch < images[index].width * 4)
+                            return false;
+
                         for (size_t j = 0; j < images[index].height; ++j)
                         {
-                            CopyScanline24bpp(tempRow.get(), sPtr, images[index].width);
+                            {
+                                Internal::SavePhaseTimer timer(SAVE_PHASE_REPACK, ddsRowPitch);
+                                CopyScanline24bpp(tempRow.get(), sPtr, images[index].width);
+                            }
 
-                            outFile.write(reinterpret_cast<const char*>(tempRow.get()),
-                                          static_cast<std::streamsize>(ddsRowPitch));
+                            TracedWrite(outFile, tempRow.get(), ddsRowPitch);
 
                             if (!outFile)
                                 return false;
@@ -1321,8 +3053,7 @@ bool VulkanTex::SaveToDDSFile(
 
                         for (size_t j = 0; j < lines; ++j)
                         {
-                            outFile.write(reinterpret_cast<const char*>(sPtr),
-                                          static_cast<std::streamsize>(ddsRowPitch));
+                            TracedWrite(outFile, sPtr, ddsRowPitch);
 
                             if (!outFile)
                                 return false;
@@ -1345,3 +3076,96 @@ bool VulkanTex::SaveToDDSFile(
 
     return true;
 }
+
+bool VulkanTex::SaveToDDSMemory(const ImageSetView& images, DDS_FLAGS flags, Blob& blob) noexcept
+{
+    return SaveToDDSMemory(images.images, images.nimages, images.metadata, flags, blob);
+}
+
+bool VulkanTex::SaveToDDSFile(const ImageSetView& images, DDS_FLAGS flags, const char* szFile) noexcept
+{
+    return SaveToDDSFile(images.images, images.nimages, images.metadata, flags, szFile);
+}
+
+bool VulkanTex::SaveToDDSFile(
+    const ImageSetView& images,
+    DDS_FLAGS flags,
+    const DDSSaveOptions& options,
+    const char* szFile) noexcept
+{
+    return SaveToDDSFile(images.images, images.nimages, images.metadata, flags, options, szFile);
+}
+
+//-------------------------------------------------------------------------------------
+// Obtain metadata from DDS file in memory/on disk
+//-------------------------------------------------------------------------------------
+bool VulkanTex::GetMetadataFromDDSMemory(
+    const uint8_t* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    TexMetadata& metadata) noexcept
+{
+    ScratchImage image;
+    return LoadDDSMemory(pSource, size, flags, 0, 0, 0, 0, &metadata, image, true);
+}
+
+bool VulkanTex::GetMetadataFromDDSFile(
+    const char* szFile,
+    DDS_FLAGS flags,
+    TexMetadata& metadata) noexcept
+{
+    ScratchImage image;
+    return LoadDDSFile(szFile, flags, 0, 0, 0, 0, &metadata, image, true);
+}
+
+//-------------------------------------------------------------------------------------
+// Load a DDS file in memory
+//-------------------------------------------------------------------------------------
+bool VulkanTex::LoadFromDDSMemory(
+    const uint8_t* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadDDSMemory(pSource, size, flags, 0, 0, 0, 0, metadata, image, false);
+}
+
+bool VulkanTex::LoadFromDDSMemory(
+    const uint8_t* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    size_t firstMip,
+    size_t mipCount,
+    size_t firstItem,
+    size_t itemCount,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadDDSMemory(pSource, size, flags, firstMip, mipCount, firstItem, itemCount, metadata, image, false);
+}
+
+//-------------------------------------------------------------------------------------
+// Load a DDS file from disk
+//-------------------------------------------------------------------------------------
+bool VulkanTex::LoadFromDDSFile(
+    const char* szFile,
+    DDS_FLAGS flags,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadDDSFile(szFile, flags, 0, 0, 0, 0, metadata, image, false);
+}
+
+bool VulkanTex::LoadFromDDSFile(
+    const char* szFile,
+    DDS_FLAGS flags,
+    size_t firstMip,
+    size_t mipCount,
+    size_t firstItem,
+    size_t itemCount,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadDDSFile(szFile, flags, firstMip, mipCount, firstItem, itemCount, metadata, image, false);
+}
@@ -268,4 +268,5 @@ namespace VulkanTex
     static_assert(DDS_DX10_HEADER_SIZE > DDS_MIN_HEADER_SIZE, "DDS DX10 Header should be larger than standard header");
 
     uint32_t VkFormatToDXGIFormat(VkFormat vkFormat);
+    VkFormat DXGIFormatToVkFormat(uint32_t dxgiFormat) noexcept;
 } // namespace VulkanTex
@@ -0,0 +1,442 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr float c_pi           = 3.14159265358979323846f;
+    constexpr float c_kaiserRadius = 3.f;
+    constexpr float c_kaiserAlpha  = 4.f;
+
+    // Zeroth order modified Bessel function of the first kind
+    float BesselI0(float x) noexcept
+    {
+        float sum  = 1.f;
+        float term = 1.f;
+        const float halfX = x * 0.5f;
+
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (halfX / static_cast<float>(k));
+            const float t2 = term * term;
+            sum += t2;
+
+            if (t2 < sum * 1e-8f)
+                break;
+        }
+
+        return sum;
+    }
+
+    float Sinc(float x) noexcept
+    {
+        if (std::fabs(x) < 1e-5f)
+            return 1.f;
+
+        x *= c_pi;
+        return std::sin(x) / x;
+    }
+
+    float KernelRadius(FILTER_KERNEL kernel) noexcept
+    {
+        switch (kernel)
+        {
+            case FILTER_KERNEL_BOX:     return 0.5f;
+            case FILTER_KERNEL_LINEAR:  return 1.f;
+            case FILTER_KERNEL_CUBIC:   return 2.f;
+            case FILTER_KERNEL_KAISER:  return c_kaiserRadius;
+            default:                    return 0.5f;
+        }
+    }
+
+    float EvaluateKernel(FILTER_KERNEL kernel, float x) noexcept
+    {
+        switch (kernel)
+        {
+            case FILTER_KERNEL_BOX:
+                return ((x >= -0.5f) && (x < 0.5f)) ? 1.f : 0.f;
+
+            case FILTER_KERNEL_LINEAR:
+                return std::max(0.f, 1.f - std::fabs(x));
+
+            case FILTER_KERNEL_CUBIC:
+            {
+                x = std::fabs(x);
+
+                if (x < 1.f)
+                    return (1.5f * x - 2.5f) * x * x + 1.f;
+
+                if (x < 2.f)
+                    return ((-0.5f * x + 2.5f) * x - 4.f) * x + 2.f;
+
+                return 0.f;
+            }
+
+            case FILTER_KERNEL_KAISER:
+            {
+                const float t = x / c_kaiserRadius;
+                if (std::fabs(t) >= 1.f)
+                    return 0.f;
+
+                static const float s_invI0Alpha = 1.f / BesselI0(c_kaiserAlpha);
+                return Sinc(x) * BesselI0(c_kaiserAlpha * std::sqrt(1.f - t * t)) * s_invI0Alpha;
+            }
+
+            default:
+                return 0.f;
+        }
+    }
+
+    inline void MultiplyAdd(Float4& acc, const Float4& value, float weight) noexcept
+    {
+#if VULKANTEX_SSE2
+        const __m128 a = _mm_load_ps(&acc.x);
+        const __m128 v = _mm_load_ps(&value.x);
+        _mm_store_ps(&acc.x, _mm_add_ps(a, _mm_mul_ps(v, _mm_set1_ps(weight))));
+#else
+        acc.x += value.x * weight;
+        acc.y += value.y * weight;
+        acc.z += value.z * weight;
+        acc.w += value.w * weight;
+#endif
+    }
+
+    void FilterRowHorizontal(Float4* pDestination, const Float4* pSource, const FilterTable& table, size_t destWidth) noexcept
+    {
+        const uint32_t* index  = table.index.data();
+        const float*    weight = table.weight.data();
+
+        for (size_t x = 0; x < destWidth; ++x)
+        {
+            Float4 acc = { 0.f, 0.f, 0.f, 0.f };
+
+            for (uint32_t t = table.first[x]; t < table.first[x + 1]; ++t)
+            {
+                MultiplyAdd(acc, pSource[index[t]], weight[t]);
+            }
+
+            pDestination[x] = acc;
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// Filter selection
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Internal::GetFilterKernel(TEX_FILTER_FLAGS filter, FILTER_KERNEL& kernel) noexcept
+{
+    switch (filter & TEX_FILTER_MODE_MASK)
+    {
+        case TEX_FILTER_DEFAULT:
+        case TEX_FILTER_BOX:    kernel = FILTER_KERNEL_BOX;     return true;
+        case TEX_FILTER_POINT:  kernel = FILTER_KERNEL_POINT;   return true;
+        case TEX_FILTER_LINEAR: kernel = FILTER_KERNEL_LINEAR;  return true;
+        case TEX_FILTER_CUBIC:  kernel = FILTER_KERNEL_CUBIC;   return true;
+        case TEX_FILTER_KAISER: kernel = FILTER_KERNEL_KAISER;  return true;
+        default:                                                return false;
+    }
+}
+
+uint32_t VulkanTex::Internal::GetFilterPixelFlags(TEX_FILTER_FLAGS filter, const TexMetadata& metadata) noexcept
+{
+    uint32_t flags = FILTER_PIXEL_DEFAULT;
+
+    if (!(filter & TEX_FILTER_IGNORE_SRGB))
+    {
+        const bool srgb = IsSRGB(metadata.format);
+
+        if (srgb || (filter & TEX_FILTER_SRGB_IN))
+            flags |= FILTER_PIXEL_SRGB_IN;
+
+        if (srgb || (filter & TEX_FILTER_SRGB_OUT))
+            flags |= FILTER_PIXEL_SRGB_OUT;
+    }
+
+    // Premultiplied data is already weighted; straight alpha needs it to avoid color bleeding from transparent texels
+    if (HasAlpha(metadata.format)
+        && !(filter & TEX_FILTER_SEPARATE_ALPHA)
+        && !metadata.IsPMAlpha()
+        && (metadata.GetAlphaMode() != TEX_ALPHA_MODE_OPAQUE))
+    {
+        flags |= FILTER_PIXEL_ALPHA_WEIGHTED;
+    }
+
+    return flags;
+}
+
+//-------------------------------------------------------------------------------------
+// Per-row pixel transforms
+//-------------------------------------------------------------------------------------
+void VulkanTex::Internal::PrepareSourceRow(Float4* pixels, size_t count, VkFormat format, uint32_t pixelFlags) noexcept
+{
+    if (pixelFlags & FILTER_PIXEL_SRGB_IN)
+    {
+        DecodeSRGBRow(pixels, count, format);
+    }
+
+    if (pixelFlags & FILTER_PIXEL_ALPHA_WEIGHTED)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            pixels[i].x *= pixels[i].w;
+            pixels[i].y *= pixels[i].w;
+            pixels[i].z *= pixels[i].w;
+        }
+    }
+}
+
+void VulkanTex::Internal::FinishDestinationRow(Float4* pixels, size_t count, VkFormat format, uint32_t pixelFlags) noexcept
+{
+    if (pixelFlags & FILTER_PIXEL_ALPHA_WEIGHTED)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float alpha = pixels[i].w;
+            const float scale = (alpha > 0.f) ? (1.f / alpha) : 0.f;
+            pixels[i].x *= scale;
+            pixels[i].y *= scale;
+            pixels[i].z *= scale;
+        }
+    }
+
+    if (pixelFlags & FILTER_PIXEL_SRGB_OUT)
+    {
+        EncodeSRGBRow(pixels, count, format);
+    }
+}
+
+//-------------------------------------------------------------------------------------
+// Weight tables
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Internal::BuildFilterTable(FILTER_KERNEL kernel, size_t srcSize, size_t destSize, FilterTable& table) noexcept
+{
+    if (!srcSize || !destSize || (srcSize > UINT32_MAX) || (destSize > UINT32_MAX))
+        return false;
+
+    try
+    {
+        table.first.resize(destSize + 1);
+        table.index.clear();
+        table.weight.clear();
+        table.maxTaps = 1;
+
+        const float scale       = static_cast<float>(srcSize) / static_cast<float>(destSize);
+        const float filterScale = std::max(scale, 1.f);
+        const float support     = KernelRadius(kernel) * filterScale;
+
+        for (size_t i = 0; i < destSize; ++i)
+        {
+            table.first[i] = static_cast<uint32_t>(table.index.size());
+
+            // Pixel centers sit at integer + 0.5
+            const float center = (static_cast<float>(i) + 0.5f) * scale;
+
+            if (kernel == FILTER_KERNEL_POINT)
+            {
+                const size_t nearest = std::min(static_cast<size_t>(center), srcSize - 1);
+                table.index.push_back(static_cast<uint32_t>(nearest));
+                table.weight.push_back(1.f);
+                continue;
+            }
+
+            const ptrdiff_t first = static_cast<ptrdiff_t>(std::floor(center - support));
+            const ptrdiff_t last  = static_cast<ptrdiff_t>(std::ceil(center + support));
+
+            const size_t start = table.index.size();
+            float total = 0.f;
+
+            for (ptrdiff_t k = first; k <= last; ++k)
+            {
+                const float w = EvaluateKernel(kernel, (static_cast<float>(k) + 0.5f - center) / filterScale);
+                if (w == 0.f)
+                    continue;
+
+                // Clamp to edge, merging repeated edge taps
+                const uint32_t sk = static_cast<uint32_t>(std::clamp<ptrdiff_t>(k, 0, static_cast<ptrdiff_t>(srcSize) - 1));
+
+                if ((table.index.size() > start) && (table.index.back() == sk))
+                    table.weight.back() += w;
+                else
+                {
+                    table.index.push_back(sk);
+                    table.weight.push_back(w);
+                }
+
+                total += w;
+            }
+
+            if ((table.index.size() == start) || (std::fabs(total) < 1e-6f))
+            {
+                // Degenerate footprint, fall back to the nearest texel
+                table.index.resize(start);
+                table.weight.resize(start);
+                table.index.push_back(static_cast<uint32_t>(std::min(static_cast<size_t>(center), srcSize - 1)));
+                table.weight.push_back(1.f);
+                continue;
+            }
+
+            const float invTotal = 1.f / total;
+            for (size_t t = start; t < table.weight.size(); ++t)
+                table.weight[t] *= invTotal;
+
+            table.maxTaps = std::max(table.maxTaps, table.index.size() - start);
+        }
+
+        table.first[destSize] = static_cast<uint32_t>(table.index.size());
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Resample a band of rows
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Internal::ResampleRows(
+    const Image& src, const Image& dest,
+    const FilterTable& xTable, const FilterTable& yTable,
+    uint32_t pixelFlags, size_t rowBegin, size_t rowEnd) noexcept
+{
+    if (!src.pixels || !dest.pixels)
+        return false;
+
+    if ((xTable.first.size() != dest.width + 1) || (yTable.first.size() != dest.height + 1))
+        return false;
+
+    rowEnd = std::min(rowEnd, dest.height);
+    if (rowBegin >= rowEnd)
+        return true;
+
+    const size_t srcRowSize  = (src.width * BitsPerPixel(src.format) + 7) / 8;
+    const size_t destRowSize = (dest.width * BitsPerPixel(dest.format) + 7) / 8;
+
+    // Horizontally filtered source rows are cached so each one is loaded once per band
+    const size_t cacheRows = yTable.maxTaps;
+
+    std::unique_ptr<Float4[]> srcRow(new (std::nothrow) Float4[src.width]);
+    std::unique_ptr<Float4[]> cache(new (std::nothrow) Float4[cacheRows * dest.width]);
+    std::unique_ptr<Float4[]> acc(new (std::nothrow) Float4[dest.width]);
+    std::unique_ptr<size_t[]> tags(new (std::nothrow) size_t[cacheRows]);
+
+    if (!srcRow || !cache || !acc || !tags)
+        return false;
+
+    for (size_t i = 0; i < cacheRows; ++i)
+        tags[i] = size_t(-1);
+
+    for (size_t y = rowBegin; y < rowEnd; ++y)
+    {
+        memset(acc.get(), 0, sizeof(Float4) * dest.width);
+
+        for (uint32_t t = yTable.first[y]; t < yTable.first[y + 1]; ++t)
+        {
+            const size_t sy   = yTable.index[t];
+            const size_t slot = sy % cacheRows;
+            Float4* row = cache.get() + slot * dest.width;
+
+            if (tags[slot] != sy)
+            {
+                if (!LoadScanline(srcRow.get(), src.width, src.pixels + sy * src.rowPitch, srcRowSize, src.format))
+                    return false;
+
+                PrepareSourceRow(srcRow.get(), src.width, src.format, pixelFlags);
+                FilterRowHorizontal(row, srcRow.get(), xTable, dest.width);
+                tags[slot] = sy;
+            }
+
+            const float w = yTable.weight[t];
+            for (size_t x = 0; x < dest.width; ++x)
+            {
+                MultiplyAdd(acc[x], row[x], w);
+            }
+        }
+
+        FinishDestinationRow(acc.get(), dest.width, dest.format, pixelFlags);
+
+        if (!StoreScanline(dest.pixels + y * dest.rowPitch, destRowSize, dest.format, acc.get(), dest.width))
+            return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Resample a band of rows of one volume slice
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Internal::ResampleVolumeRows(
+    const Image* srcSlices, size_t srcDepth, const Image& dest,
+    const FilterTable& xTable, const FilterTable& yTable, const FilterTable& zTable,
+    size_t z, uint32_t pixelFlags, size_t rowBegin, size_t rowEnd) noexcept
+{
+    if (!srcSlices || !srcDepth || !dest.pixels)
+        return false;
+
+    if ((xTable.first.size() != dest.width + 1) || (yTable.first.size() != dest.height + 1) || (z + 1 >= zTable.first.size()))
+        return false;
+
+    rowEnd = std::min(rowEnd, dest.height);
+    if (rowBegin >= rowEnd)
+        return true;
+
+    const Image& src0 = srcSlices[0];
+    const size_t srcRowSize  = (src0.width * BitsPerPixel(src0.format) + 7) / 8;
+    const size_t destRowSize = (dest.width * BitsPerPixel(dest.format) + 7) / 8;
+
+    std::unique_ptr<Float4[]> srcRow(new (std::nothrow) Float4[src0.width]);
+    std::unique_ptr<Float4[]> row(new (std::nothrow) Float4[dest.width]);
+    std::unique_ptr<Float4[]> acc(new (std::nothrow) Float4[dest.width]);
+
+    if (!srcRow || !row || !acc)
+        return false;
+
+    for (size_t y = rowBegin; y < rowEnd; ++y)
+    {
+        memset(acc.get(), 0, sizeof(Float4) * dest.width);
+
+        // Only the (usually two) source slices of this output slice are touched
+        for (uint32_t tz = zTable.first[z]; tz < zTable.first[z + 1]; ++tz)
+        {
+            const size_t sz = zTable.index[tz];
+            if (sz >= srcDepth)
+                return false;
+
+            const Image& src = srcSlices[sz];
+
+            for (uint32_t ty = yTable.first[y]; ty < yTable.first[y + 1]; ++ty)
+            {
+                const size_t sy = yTable.index[ty];
+
+                if (!LoadScanline(srcRow.get(), src.width, src.pixels + sy * src.rowPitch, srcRowSize, src.format))
+                    return false;
+
+                PrepareSourceRow(srcRow.get(), src.width, src.format, pixelFlags);
+                FilterRowHorizontal(row.get(), srcRow.get(), xTable, dest.width);
+
+                const float w = zTable.weight[tz] * yTable.weight[ty];
+                for (size_t x = 0; x < dest.width; ++x)
+                {
+                    MultiplyAdd(acc[x], row[x], w);
+                }
+            }
+        }
+
+        FinishDestinationRow(acc.get(), dest.width, dest.format, pixelFlags);
+
+        if (!StoreScanline(dest.pixels + y * dest.rowPitch, destRowSize, dest.format, acc.get(), dest.width))
+            return false;
+    }
+
+    return true;
+}
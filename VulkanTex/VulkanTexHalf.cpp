@@ -0,0 +1,183 @@
+#include <cstddef>
+#include <cstdint>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VULKANTEX_F16C_DISPATCH 1
+#define VULKANTEX_TARGET_F16C __attribute__((target("avx,f16c")))
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#define VULKANTEX_F16C_DISPATCH 1
+#define VULKANTEX_TARGET_F16C
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define VULKANTEX_NEON_FP16 1
+#include <arm_neon.h>
+#endif
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+#if VULKANTEX_F16C_DISPATCH
+    //---------------------------------------------------------------------------------
+    // x86: F16C (with the 256-bit AVX forms), chosen at runtime
+    //---------------------------------------------------------------------------------
+    bool DetectF16C() noexcept
+    {
+        constexpr uint32_t c_osxsave = 1u << 27;
+        constexpr uint32_t c_avx     = 1u << 28;
+        constexpr uint32_t c_f16c    = 1u << 29;
+
+        uint32_t ecx = 0;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4] = {};
+        __cpuid(info, 1);
+        ecx = static_cast<uint32_t>(info[2]);
+#else
+        uint32_t eax = 0, ebx = 0, edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return false;
+#endif
+
+        if ((ecx & (c_osxsave | c_avx | c_f16c)) != (c_osxsave | c_avx | c_f16c))
+            return false;
+
+        // The OS has to save the YMM state
+#if defined(_MSC_VER) && !defined(__clang__)
+        const uint64_t xcr0 = _xgetbv(0);
+#else
+        uint32_t xcr0lo = 0, xcr0hi = 0;
+        __asm__ volatile("xgetbv" : "=a"(xcr0lo), "=d"(xcr0hi) : "c"(0));
+        const uint64_t xcr0 = (static_cast<uint64_t>(xcr0hi) << 32) | xcr0lo;
+#endif
+
+        return (xcr0 & 0x6) == 0x6;
+    }
+
+    bool HasF16C() noexcept
+    {
+        static const bool s_f16c = DetectF16C();
+        return s_f16c;
+    }
+
+    // Each kernel returns the number of values it converted, the caller finishes the tail
+    VULKANTEX_TARGET_F16C
+    size_t HalfToFloatF16C(float* pDestination, const uint16_t* pSource, size_t count) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+            _mm256_storeu_ps(pDestination + i, _mm256_cvtph_ps(h));
+        }
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSource + i));
+            _mm_storeu_ps(pDestination + i, _mm_cvtph_ps(h));
+        }
+
+        return i;
+    }
+
+    VULKANTEX_TARGET_F16C
+    size_t FloatToHalfF16C(uint16_t* pDestination, const float* pSource, size_t count) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), h);
+        }
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i h = _mm_cvtps_ph(_mm_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDestination + i), h);
+        }
+
+        return i;
+    }
+#endif
+
+#if VULKANTEX_NEON_FP16
+    //---------------------------------------------------------------------------------
+    // AArch64: half conversion is part of the base NEON instruction set
+    //---------------------------------------------------------------------------------
+    size_t HalfToFloatNEON(float* pDestination, const uint16_t* pSource, size_t count) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const float16x8_t h = vreinterpretq_f16_u16(vld1q_u16(pSource + i));
+            vst1q_f32(pDestination + i, vcvt_f32_f16(vget_low_f16(h)));
+            vst1q_f32(pDestination + i + 4, vcvt_high_f32_f16(h));
+        }
+
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(pDestination + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(pSource + i))));
+        }
+
+        return i;
+    }
+
+    size_t FloatToHalfNEON(uint16_t* pDestination, const float* pSource, size_t count) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1_u16(pDestination + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(pSource + i))));
+        }
+
+        return i;
+    }
+#endif
+}
+
+
+//-------------------------------------------------------------------------------------
+// Bulk half-precision conversion
+//-------------------------------------------------------------------------------------
+void VulkanTex::Internal::HalfToFloatRow(float* pDestination, const uint16_t* pSource, size_t count) noexcept
+{
+    size_t i = 0;
+
+#if VULKANTEX_F16C_DISPATCH
+    if (HasF16C())
+        i = HalfToFloatF16C(pDestination, pSource, count);
+#elif VULKANTEX_NEON_FP16
+    i = HalfToFloatNEON(pDestination, pSource, count);
+#endif
+
+    for (; i < count; ++i)
+        pDestination[i] = HalfToFloat(pSource[i]);
+}
+
+void VulkanTex::Internal::FloatToHalfRow(uint16_t* pDestination, const float* pSource, size_t count) noexcept
+{
+    size_t i = 0;
+
+#if VULKANTEX_F16C_DISPATCH
+    if (HasF16C())
+        i = FloatToHalfF16C(pDestination, pSource, count);
+#elif VULKANTEX_NEON_FP16
+    i = FloatToHalfNEON(pDestination, pSource, count);
+#endif
+
+    for (; i < count; ++i)
+        pDestination[i] = FloatToHalf(pSource[i]);
+}
@@ -0,0 +1,288 @@
+#include <cstdint>
+#include <cstring>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    // Stripe / block structure follows XXH3: 64-byte stripes are folded into eight 64-bit lanes,
+    // every 16 stripes the lanes are scrambled with the tail of the key
+    constexpr size_t c_stripeSize     = 64;
+    constexpr size_t c_stripesPerBlock = 16;
+    constexpr size_t c_keyWords       = 24;
+
+    constexpr uint32_t c_prime32_1 = 0x9E3779B1u;
+    constexpr uint32_t c_prime32_2 = 0x85EBCA77u;
+    constexpr uint32_t c_prime32_3 = 0xC2B2AE3Du;
+    constexpr uint64_t c_prime64_1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t c_prime64_2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t c_prime64_3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t c_prime64_4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t c_prime64_5 = 0x27D4EB2F165667C5ull;
+
+    struct HashKey
+    {
+        alignas(16) uint64_t words[c_keyWords];
+    };
+
+    constexpr HashKey MakeKey() noexcept
+    {
+        HashKey key = {};
+        uint64_t state = 0x5654657848617368ull; // "VTexHash"
+
+        for (size_t i = 0; i < c_keyWords; ++i)
+        {
+            // SplitMix64
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            key.words[i] = z ^ (z >> 31);
+        }
+
+        return key;
+    }
+
+    constexpr HashKey c_key = MakeKey();
+
+    inline uint64_t ReadU64(const uint8_t* p) noexcept
+    {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t Mul128Fold64(uint64_t a, uint64_t b) noexcept
+    {
+        const uint64_t aLo = a & 0xFFFFFFFFull;
+        const uint64_t aHi = a >> 32;
+        const uint64_t bLo = b & 0xFFFFFFFFull;
+        const uint64_t bHi = b >> 32;
+
+        const uint64_t lolo = aLo * bLo;
+        const uint64_t hilo = aHi * bLo;
+        const uint64_t lohi = aLo * bHi;
+        const uint64_t hihi = aHi * bHi;
+
+        const uint64_t cross = (lolo >> 32) + (hilo & 0xFFFFFFFFull) + lohi;
+        const uint64_t upper = (hilo >> 32) + (cross >> 32) + hihi;
+        const uint64_t lower = (cross << 32) | (lolo & 0xFFFFFFFFull);
+
+        return lower ^ upper;
+    }
+
+    inline uint64_t Avalanche(uint64_t h) noexcept
+    {
+        h ^= h >> 37;
+        h *= 0x165667919E3779F9ull;
+        h ^= h >> 32;
+        return h;
+    }
+
+    //---------------------------------------------------------------------------------
+    struct HashState
+    {
+        alignas(16) uint64_t acc[8];
+        uint8_t  buffer[c_stripeSize];
+        size_t   buffered;
+        size_t   stripe;
+        uint64_t length;
+    };
+
+    void Accumulate(HashState& state, const uint8_t* data) noexcept
+    {
+        const uint64_t* key = c_key.words + state.stripe;
+
+#if VULKANTEX_SSE2
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const __m128i d    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+            const __m128i k    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + i * 2));
+            const __m128i dk   = _mm_xor_si128(d, k);
+            const __m128i dkHi = _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i prod = _mm_mul_epu32(dk, dkHi);
+            const __m128i swap = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+
+            __m128i* acc = reinterpret_cast<__m128i*>(state.acc + i * 2);
+            _mm_store_si128(acc, _mm_add_epi64(_mm_load_si128(acc), _mm_add_epi64(prod, swap)));
+        }
+#else
+        for (size_t i = 0; i < 8; ++i)
+        {
+            const uint64_t d  = ReadU64(data + i * 8);
+            const uint64_t dk = d ^ key[i];
+            state.acc[i ^ 1] += d;
+            state.acc[i]     += (dk & 0xFFFFFFFFull) * (dk >> 32);
+        }
+#endif
+
+        if (++state.stripe == c_stripesPerBlock)
+        {
+            const uint64_t* scramble = c_key.words + (c_keyWords - 8);
+
+#if VULKANTEX_SSE2
+            const __m128i prime = _mm_set1_epi32(static_cast<int>(c_prime32_1));
+
+            for (size_t i = 0; i < 4; ++i)
+            {
+                __m128i* acc = reinterpret_cast<__m128i*>(state.acc + i * 2);
+                __m128i a = _mm_load_si128(acc);
+                a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+                a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(scramble + i * 2)));
+
+                const __m128i lo = _mm_mul_epu32(a, prime);
+                const __m128i hi = _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), prime), 32);
+                _mm_store_si128(acc, _mm_add_epi64(lo, hi));
+            }
+#else
+            for (size_t i = 0; i < 8; ++i)
+            {
+                uint64_t a = state.acc[i];
+                a ^= a >> 47;
+                a ^= scramble[i];
+                state.acc[i] = a * c_prime32_1;
+            }
+#endif
+
+            state.stripe = 0;
+        }
+    }
+
+    void HashInit(HashState& state) noexcept
+    {
+        state.acc[0] = c_prime32_3;
+        state.acc[1] = c_prime64_1;
+        state.acc[2] = c_prime64_2;
+        state.acc[3] = c_prime64_3;
+        state.acc[4] = c_prime64_4;
+        state.acc[5] = c_prime32_2;
+        state.acc[6] = c_prime64_5;
+        state.acc[7] = c_prime32_1;
+        state.buffered = 0;
+        state.stripe   = 0;
+        state.length   = 0;
+    }
+
+    void HashUpdate(HashState& state, const uint8_t* data, size_t size) noexcept
+    {
+        state.length += size;
+
+        if (state.buffered)
+        {
+            const size_t count = std::min(size, c_stripeSize - state.buffered);
+            memcpy(state.buffer + state.buffered, data, count);
+            state.buffered += count;
+            data += count;
+            size -= count;
+
+            if (state.buffered < c_stripeSize)
+                return;
+
+            Accumulate(state, state.buffer);
+            state.buffered = 0;
+        }
+
+        while (size >= c_stripeSize)
+        {
+            Accumulate(state, data);
+            data += c_stripeSize;
+            size -= c_stripeSize;
+        }
+
+        if (size)
+        {
+            memcpy(state.buffer, data, size);
+            state.buffered = size;
+        }
+    }
+
+    uint64_t MergeLanes(const HashState& state, size_t keyOffset, uint64_t start) noexcept
+    {
+        uint64_t result = start;
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            result += Mul128Fold64(
+                state.acc[i * 2] ^ c_key.words[keyOffset + i * 2],
+                state.acc[i * 2 + 1] ^ c_key.words[keyOffset + i * 2 + 1]);
+        }
+
+        return Avalanche(result);
+    }
+
+    void HashFinish(HashState& state, uint64_t layout, ContentHash& hash) noexcept
+    {
+        if (state.buffered)
+        {
+            // Zero-pad the tail; the total length is folded in below so padding cannot alias
+            memset(state.buffer + state.buffered, 0, c_stripeSize - state.buffered);
+            Accumulate(state, state.buffer);
+            state.buffered = 0;
+        }
+
+        hash.low  = MergeLanes(state, 1, (state.length * c_prime64_1) ^ layout);
+        hash.high = MergeLanes(state, 11, ~(state.length * c_prime64_2) ^ Avalanche(layout + c_prime64_4));
+    }
+
+    //---------------------------------------------------------------------------------
+    bool HashImage(const Image& image, ContentHash& hash) noexcept
+    {
+        if (!image.pixels || !image.width || !image.height)
+            return false;
+
+        size_t rowPitch, slicePitch;
+        if (!ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE))
+            return false;
+
+        if (rowPitch > image.rowPitch)
+            return false;
+
+        const size_t rows = ComputeScanlines(image.format, image.height);
+
+        HashState state;
+        HashInit(state);
+
+        // Only the valid bytes of each row are hashed, so images that differ only in pitch padding match
+        const uint8_t* pSource = image.pixels;
+        for (size_t y = 0; y < rows; ++y)
+        {
+            HashUpdate(state, pSource, rowPitch);
+            pSource += image.rowPitch;
+        }
+
+        // Same bytes under a different layout must not collide
+        const uint64_t layout = Avalanche((static_cast<uint64_t>(image.format) * c_prime64_3)
+            ^ (static_cast<uint64_t>(image.width) << 32)
+            ^ static_cast<uint64_t>(image.height));
+
+        HashFinish(state, layout, hash);
+        return true;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Content hashing
+//-------------------------------------------------------------------------------------
+bool VulkanTex::ComputeContentHash(const Image& image, ContentHash& hash) noexcept
+{
+    return HashImage(image, hash);
+}
+
+bool VulkanTex::ComputeContentHash64(const Image& image, uint64_t& hash) noexcept
+{
+    ContentHash value;
+    if (!HashImage(image, value))
+        return false;
+
+    hash = value.low;
+    return true;
+}
@@ -0,0 +1,739 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr float  c_pi = 3.14159265358979323846f;
+    constexpr size_t c_defaultSampleCount = 512;
+
+    //---------------------------------------------------------------------------------
+    // Source cube as linear Float4 faces, plus box-filtered levels down to 1 x 1
+    //---------------------------------------------------------------------------------
+    struct CubeChain
+    {
+        std::vector<FloatPlane> faces;      // level * 6 + face
+        size_t                  levels;
+    };
+
+    bool ValidateCube(const Image* srcImages, size_t nimages, const TexMetadata& metadata) noexcept
+    {
+        if (!srcImages || !metadata.IsCubemap() || (metadata.arraySize < 6) || !metadata.width
+            || (metadata.width != metadata.height) || (nimages < 6 * metadata.mipLevels))
+            return false;
+
+        if (!IsConvertible(metadata.format))
+            return false;
+
+        for (size_t face = 0; face < 6; ++face)
+        {
+            const Image& src = srcImages[face * metadata.mipLevels];
+            if (!src.pixels || (src.format != metadata.format) || (src.width != metadata.width) || (src.height != metadata.height))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ExpandFaces(const Image* srcImages, const TexMetadata& metadata, CubeChain& chain) noexcept
+    {
+        const uint32_t pixelFlags = IsSRGB(metadata.format) ? FILTER_PIXEL_SRGB_IN : FILTER_PIXEL_DEFAULT;
+
+        try
+        {
+            chain.faces.resize(6);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        chain.levels = 1;
+
+        for (size_t face = 0; face < 6; ++face)
+        {
+            if (!ExpandImage(srcImages[face * metadata.mipLevels], pixelFlags, chain.faces[face]))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool BuildChain(const Image* srcImages, const TexMetadata& metadata, CubeChain& chain) noexcept
+    {
+        if (!ExpandFaces(srcImages, metadata, chain))
+            return false;
+
+        size_t levels = 1;
+        for (size_t size = metadata.width; size > 1; size >>= 1)
+            ++levels;
+
+        try
+        {
+            chain.faces.resize(levels * 6);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        for (size_t level = 1; level < levels; ++level)
+        {
+            const size_t srcSize = chain.faces[(level - 1) * 6].width;
+            const size_t size    = std::max<size_t>(srcSize >> 1, 1);
+
+            for (size_t face = 0; face < 6; ++face)
+            {
+                FloatPlane& plane = chain.faces[level * 6 + face];
+                plane.pixels.reset(new (std::nothrow) Float4[size * size]);
+                if (!plane.pixels)
+                    return false;
+
+                plane.width  = size;
+                plane.height = size;
+            }
+
+            // 2 x 2 box, the last row / column is clamped for odd sizes
+            ParallelFor(6 * size, 16, [&](size_t begin, size_t end) noexcept
+            {
+                for (size_t row = begin; row < end; ++row)
+                {
+                    const size_t face = row / size;
+                    const size_t y    = row % size;
+
+                    const FloatPlane& src = chain.faces[(level - 1) * 6 + face];
+                    const Float4* row0 = src.pixels.get() + std::min(2 * y, srcSize - 1) * srcSize;
+                    const Float4* row1 = src.pixels.get() + std::min(2 * y + 1, srcSize - 1) * srcSize;
+                    Float4* dest = chain.faces[level * 6 + face].pixels.get() + y * size;
+
+                    for (size_t x = 0; x < size; ++x)
+                    {
+                        const size_t x0 = std::min(2 * x, srcSize - 1);
+                        const size_t x1 = std::min(2 * x + 1, srcSize - 1);
+
+#if VULKANTEX_SSE2
+                        __m128 sum = _mm_add_ps(_mm_load_ps(&row0[x0].x), _mm_load_ps(&row0[x1].x));
+                        sum = _mm_add_ps(sum, _mm_add_ps(_mm_load_ps(&row1[x0].x), _mm_load_ps(&row1[x1].x)));
+                        _mm_store_ps(&dest[x].x, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                        dest[x].x = (row0[x0].x + row0[x1].x + row1[x0].x + row1[x1].x) * 0.25f;
+                        dest[x].y = (row0[x0].y + row0[x1].y + row1[x0].y + row1[x1].y) * 0.25f;
+                        dest[x].z = (row0[x0].z + row0[x1].z + row1[x0].z + row1[x1].z) * 0.25f;
+                        dest[x].w = (row0[x0].w + row0[x1].w + row1[x0].w + row1[x1].w) * 0.25f;
+#endif
+                    }
+                }
+            });
+        }
+
+        chain.levels = levels;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // GGX importance samples for one roughness, in tangent space (z along the normal).
+    // Stored as structure of arrays, padded to a multiple of four with zero weights.
+    //---------------------------------------------------------------------------------
+    struct SampleTable
+    {
+        std::vector<float>   x;
+        std::vector<float>   y;
+        std::vector<float>   z;
+        std::vector<float>   weight;        // N.L
+        std::vector<float>   levelFrac;
+        std::vector<int32_t> level;         // Chain level, blended with level + 1 by levelFrac
+        float                invTotalWeight;
+    };
+
+    inline float RadicalInverse(uint32_t bits) noexcept
+    {
+        bits = (bits << 16) | (bits >> 16);
+        bits = ((bits & 0x55555555u) << 1) | ((bits & 0xAAAAAAAAu) >> 1);
+        bits = ((bits & 0x33333333u) << 2) | ((bits & 0xCCCCCCCCu) >> 2);
+        bits = ((bits & 0x0F0F0F0Fu) << 4) | ((bits & 0xF0F0F0F0u) >> 4);
+        bits = ((bits & 0x00FF00FFu) << 8) | ((bits & 0xFF00FF00u) >> 8);
+        return static_cast<float>(bits) * 2.3283064365386963e-10f;
+    }
+
+    bool BuildSampleTable(float roughness, size_t sampleCount, size_t faceSize, size_t levels, SampleTable& table) noexcept
+    {
+        const float a  = roughness * roughness;
+        const float a2 = a * a;
+
+        // Solid angle of one top-level texel (average over the cube)
+        const float texelAngle = 4.f * c_pi / (6.f * static_cast<float>(faceSize) * static_cast<float>(faceSize));
+        const float maxLevel   = static_cast<float>(levels - 1);
+
+        try
+        {
+            const size_t capacity = (sampleCount + 3) & ~size_t(3);
+            table.x.reserve(capacity);
+            table.y.reserve(capacity);
+            table.z.reserve(capacity);
+            table.weight.reserve(capacity);
+            table.levelFrac.reserve(capacity);
+            table.level.reserve(capacity);
+
+            double totalWeight = 0.0;
+
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                // Hammersley point
+                const float u = static_cast<float>(i) / static_cast<float>(sampleCount);
+                const float v = RadicalInverse(static_cast<uint32_t>(i));
+
+                const float phi      = 2.f * c_pi * u;
+                const float cosTheta = std::sqrt((1.f - v) / (1.f + (a2 - 1.f) * v));
+                const float sinTheta = std::sqrt(std::max(1.f - cosTheta * cosTheta, 0.f));
+
+                // L = reflect(-V, H) with V = N
+                const float nDotL = 2.f * cosTheta * cosTheta - 1.f;
+                if (nDotL <= 0.f)
+                    continue;
+
+                // pdf(L) = D(H) (N.H) / (4 V.H) = D(H) / 4
+                const float d   = (cosTheta * cosTheta) * (a2 - 1.f) + 1.f;
+                const float pdf = a2 / (4.f * c_pi * d * d);
+
+                const float sampleAngle = 1.f / (static_cast<float>(sampleCount) * pdf);
+                const float level = std::min(std::max(0.5f * std::log2(sampleAngle / texelAngle) + 1.f, 0.f), maxLevel);
+                const float levelFloor = std::floor(level);
+
+                table.x.push_back(2.f * cosTheta * sinTheta * std::cos(phi));
+                table.y.push_back(2.f * cosTheta * sinTheta * std::sin(phi));
+                table.z.push_back(nDotL);
+                table.weight.push_back(nDotL);
+                table.level.push_back(static_cast<int32_t>(levelFloor));
+                table.levelFrac.push_back(level - levelFloor);
+
+                totalWeight += nDotL;
+            }
+
+            if (totalWeight <= 0.0)
+            {
+                table.x.push_back(0.f);
+                table.y.push_back(0.f);
+                table.z.push_back(1.f);
+                table.weight.push_back(1.f);
+                table.level.push_back(0);
+                table.levelFrac.push_back(0.f);
+                totalWeight = 1.0;
+            }
+
+            while (table.weight.size() & 3)
+            {
+                table.x.push_back(0.f);
+                table.y.push_back(0.f);
+                table.z.push_back(1.f);
+                table.weight.push_back(0.f);
+                table.level.push_back(0);
+                table.levelFrac.push_back(0.f);
+            }
+
+            table.invTotalWeight = static_cast<float>(1.0 / totalWeight);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Filtering
+    //---------------------------------------------------------------------------------
+    inline Float4 SampleChain(const CubeChain& chain, size_t face, float s, float t, int32_t level, float levelFrac) noexcept
+    {
+        const FloatPlane& plane0 = chain.faces[static_cast<size_t>(level) * 6 + face];
+        const float half0 = static_cast<float>(plane0.width) * 0.5f;
+        Float4 color = SampleBilinear(plane0, (s + 1.f) * half0, (t + 1.f) * half0, false);
+
+        if (levelFrac > 0.f && static_cast<size_t>(level) + 1 < chain.levels)
+        {
+            const FloatPlane& plane1 = chain.faces[static_cast<size_t>(level + 1) * 6 + face];
+            const float half1 = static_cast<float>(plane1.width) * 0.5f;
+            const Float4 next = SampleBilinear(plane1, (s + 1.f) * half1, (t + 1.f) * half1, false);
+
+            color.x += (next.x - color.x) * levelFrac;
+            color.y += (next.y - color.y) * levelFrac;
+            color.z += (next.z - color.z) * levelFrac;
+            color.w += (next.w - color.w) * levelFrac;
+        }
+
+        return color;
+    }
+
+    // Weighted sum of the table's samples around the unit normal (nx, ny, nz)
+    Float4 FilterTexel(const CubeChain& chain, const SampleTable& table, float nx, float ny, float nz) noexcept
+    {
+        // Tangent frame
+        const bool useZ = std::abs(nz) < 0.999f;
+        float tx = useZ ? -ny : 0.f;
+        float ty = useZ ? nx : -nz;
+        float tz = useZ ? 0.f : ny;
+        const float invLength = 1.f / std::sqrt(tx * tx + ty * ty + tz * tz);
+        tx *= invLength;
+        ty *= invLength;
+        tz *= invLength;
+
+        const float bx = ny * tz - nz * ty;
+        const float by = nz * tx - nx * tz;
+        const float bz = nx * ty - ny * tx;
+
+        const size_t count = table.weight.size();
+
+#if VULKANTEX_SSE2
+        __m128 sum = _mm_setzero_ps();
+
+        alignas(16) float   s[4];
+        alignas(16) float   t[4];
+        alignas(16) int32_t faces[4];
+
+        const __m128 signMask = _mm_set1_ps(-0.f);
+        const __m128 zero     = _mm_setzero_ps();
+
+        for (size_t i = 0; i < count; i += 4)
+        {
+            const __m128 lx = _mm_loadu_ps(table.x.data() + i);
+            const __m128 ly = _mm_loadu_ps(table.y.data() + i);
+            const __m128 lz = _mm_loadu_ps(table.z.data() + i);
+
+            const __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, _mm_set1_ps(tx)), _mm_mul_ps(ly, _mm_set1_ps(bx))), _mm_mul_ps(lz, _mm_set1_ps(nx)));
+            const __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, _mm_set1_ps(ty)), _mm_mul_ps(ly, _mm_set1_ps(by))), _mm_mul_ps(lz, _mm_set1_ps(ny)));
+            const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, _mm_set1_ps(tz)), _mm_mul_ps(ly, _mm_set1_ps(bz))), _mm_mul_ps(lz, _mm_set1_ps(nz)));
+
+            // Same major-axis choice as GetCubeFaceCoords
+            const __m128 ax = _mm_andnot_ps(signMask, x);
+            const __m128 ay = _mm_andnot_ps(signMask, y);
+            const __m128 az = _mm_andnot_ps(signMask, z);
+            const __m128 xMajor = _mm_and_ps(_mm_cmpge_ps(ax, ay), _mm_cmpge_ps(ax, az));
+            const __m128 yMajor = _mm_andnot_ps(xMajor, _mm_cmpge_ps(ay, az));
+            const __m128 zMajor = _mm_andnot_ps(_mm_or_ps(xMajor, yMajor), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+            auto select3 = [&](__m128 forX, __m128 forY, __m128 forZ) noexcept
+            {
+                return _mm_or_ps(_mm_or_ps(_mm_and_ps(xMajor, forX), _mm_and_ps(yMajor, forY)), _mm_and_ps(zMajor, forZ));
+            };
+
+            // +X: s = -z / x, t = -y / |x|; +Y: s = x / |y|, t = z / y; +Z: s = x / z, t = -y / |z| (and negated faces)
+            const __m128 negY = _mm_xor_ps(y, signMask);
+            const __m128 negZ = _mm_xor_ps(z, signMask);
+            _mm_store_ps(s, _mm_div_ps(select3(negZ, x, x), select3(x, ay, z)));
+            _mm_store_ps(t, _mm_div_ps(select3(negY, z, negY), select3(ax, y, az)));
+
+            const __m128 base     = select3(zero, _mm_set1_ps(2.f), _mm_set1_ps(4.f));
+            const __m128 negative = _mm_and_ps(_mm_cmplt_ps(select3(x, y, z), zero), _mm_set1_ps(1.f));
+            _mm_store_si128(reinterpret_cast<__m128i*>(faces), _mm_cvttps_epi32(_mm_add_ps(base, negative)));
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                const float weight = table.weight[i + j];
+                if (weight <= 0.f)
+                    continue;
+
+                const Float4 color = SampleChain(chain, static_cast<size_t>(faces[j]), s[j], t[j], table.level[i + j], table.levelFrac[i + j]);
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(&color.x), _mm_set1_ps(weight)));
+            }
+        }
+
+        Float4 result;
+        _mm_store_ps(&result.x, _mm_mul_ps(sum, _mm_set1_ps(table.invTotalWeight)));
+        return result;
+#else
+        Float4 result = {};
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float weight = table.weight[i];
+            if (weight <= 0.f)
+                continue;
+
+            const float x = table.x[i] * tx + table.y[i] * bx + table.z[i] * nx;
+            const float y = table.x[i] * ty + table.y[i] * by + table.z[i] * ny;
+            const float z = table.x[i] * tz + table.y[i] * bz + table.z[i] * nz;
+
+            float s, t;
+            const size_t face = GetCubeFaceCoords(x, y, z, s, t);
+            const Float4 color = SampleChain(chain, face, s, t, table.level[i], table.levelFrac[i]);
+
+            result.x += color.x * weight;
+            result.y += color.y * weight;
+            result.z += color.z * weight;
+            result.w += color.w * weight;
+        }
+
+        result.x *= table.invTotalWeight;
+        result.y *= table.invTotalWeight;
+        result.z *= table.invTotalWeight;
+        result.w *= table.invTotalWeight;
+        return result;
+#endif
+    }
+
+    //---------------------------------------------------------------------------------
+    // Spherical harmonics: A(l) * Y(l, m)^2 for the polynomial basis in VulkanTex.h
+    //---------------------------------------------------------------------------------
+    constexpr double c_shScale[9] =
+    {
+        3.14159265358979 * 0.282094792 * 0.282094792,
+        2.09439510239320 * 0.488602512 * 0.488602512,
+        2.09439510239320 * 0.488602512 * 0.488602512,
+        2.09439510239320 * 0.488602512 * 0.488602512,
+        0.78539816339745 * 1.092548431 * 1.092548431,
+        0.78539816339745 * 1.092548431 * 1.092548431,
+        0.78539816339745 * 0.315391565 * 0.315391565,
+        0.78539816339745 * 1.092548431 * 1.092548431,
+        0.78539816339745 * 0.546274215 * 0.546274215,
+    };
+
+    // Adds color * weight * basis(x, y, z) into sums (9 x RGB)
+    inline void AccumulateSH(double* sums, float x, float y, float z, float weight, const Float4& color) noexcept
+    {
+        const float basis[9] = { 1.f, y, z, x, x * y, y * z, 3.f * z * z - 1.f, x * z, x * x - y * y };
+
+        for (size_t i = 0; i < 9; ++i)
+        {
+            const float w = basis[i] * weight;
+            sums[i * 3]     += static_cast<double>(color.x * w);
+            sums[i * 3 + 1] += static_cast<double>(color.y * w);
+            sums[i * 3 + 2] += static_cast<double>(color.z * w);
+        }
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// GGX prefiltered radiance
+//-------------------------------------------------------------------------------------
+bool VulkanTex::PrefilterCubemapGGX(
+    const ImageSetView& srcImages,
+    size_t mipLevels,
+    size_t sampleCount,
+    VkFormat format,
+    ScratchImage& cube) noexcept
+{
+    return PrefilterCubemapGGX(srcImages.images, srcImages.nimages, srcImages.metadata, mipLevels, sampleCount, format, cube);
+}
+
+bool VulkanTex::PrefilterCubemapGGX(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    size_t mipLevels,
+    size_t sampleCount,
+    VkFormat format,
+    ScratchImage& cube) noexcept
+{
+    if (!ValidateCube(srcImages, nimages, metadata))
+        return false;
+
+    if (IsCompressed(format) || !IsConvertible(format))
+        return false;
+
+    if (!sampleCount)
+        sampleCount = c_defaultSampleCount;
+
+    if (sampleCount > UINT32_MAX)
+        return false;
+
+    CubeChain chain;
+    if (!BuildChain(srcImages, metadata, chain))
+        return false;
+
+    if (!mipLevels)
+        mipLevels = chain.levels;
+    else if (mipLevels > chain.levels)
+        return false;
+
+    const size_t faceSize = metadata.width;
+
+    // One table per roughness mip, shared by every texel of the mip
+    std::vector<SampleTable> tables;
+
+    try
+    {
+        tables.resize(mipLevels);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    for (size_t mip = 1; mip < mipLevels; ++mip)
+    {
+        const float roughness = static_cast<float>(mip) / static_cast<float>(mipLevels - 1);
+        if (!BuildSampleTable(roughness, sampleCount, faceSize, chain.levels, tables[mip]))
+            return false;
+    }
+
+    TexMetadata mdata2 = metadata;
+    mdata2.width     = faceSize;
+    mdata2.height    = faceSize;
+    mdata2.depth     = 1;
+    mdata2.arraySize = 6;
+    mdata2.mipLevels = mipLevels;
+    mdata2.format    = format;
+    mdata2.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    bool hr = cube.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    // Rows of every (mip, face) image, so large and small mips share the worker pool
+    std::vector<size_t> rowStart;
+
+    try
+    {
+        rowStart.resize(mipLevels * 6 + 1);
+    }
+    catch (...)
+    {
+        cube.Release();
+        return false;
+    }
+
+    rowStart[0] = 0;
+    for (size_t mip = 0; mip < mipLevels; ++mip)
+    {
+        const size_t size = std::max<size_t>(faceSize >> mip, 1);
+        for (size_t face = 0; face < 6; ++face)
+            rowStart[mip * 6 + face + 1] = rowStart[mip * 6 + face] + size;
+    }
+
+    const uint32_t pixelFlags = IsSRGB(format) ? FILTER_PIXEL_SRGB_OUT : FILTER_PIXEL_DEFAULT;
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(rowStart.back(), 1, [&](size_t begin, size_t end) noexcept
+    {
+        std::unique_ptr<Float4[]> row(new (std::nothrow) Float4[faceSize]);
+        if (!row)
+        {
+            failed = true;
+            return;
+        }
+
+        for (size_t r = begin; r < end; ++r)
+        {
+            const size_t index = static_cast<size_t>(std::upper_bound(rowStart.begin(), rowStart.end(), r) - rowStart.begin()) - 1;
+            const size_t mip   = index / 6;
+            const size_t face  = index % 6;
+            const size_t size  = std::max<size_t>(faceSize >> mip, 1);
+            const size_t y     = r - rowStart[index];
+
+            if (!mip)
+            {
+                memcpy(row.get(), chain.faces[face].pixels.get() + y * faceSize, sizeof(Float4) * faceSize);
+            }
+            else
+            {
+                const float (&axes)[3][3] = c_cubeFaceAxes[face];
+                const float t = 2.f * (static_cast<float>(y) + 0.5f) / static_cast<float>(size) - 1.f;
+
+                for (size_t x = 0; x < size; ++x)
+                {
+                    const float s = 2.f * (static_cast<float>(x) + 0.5f) / static_cast<float>(size) - 1.f;
+                    const float invLength = 1.f / std::sqrt(1.f + s * s + t * t);
+
+                    const float nx = (s * axes[0][0] + t * axes[1][0] + axes[2][0]) * invLength;
+                    const float ny = (s * axes[0][1] + t * axes[1][1] + axes[2][1]) * invLength;
+                    const float nz = (s * axes[0][2] + t * axes[1][2] + axes[2][2]) * invLength;
+
+                    row[x] = FilterTexel(chain, tables[mip], nx, ny, nz);
+                }
+            }
+
+            FinishDestinationRow(row.get(), size, format, pixelFlags);
+
+            const Image* dest = cube.GetImage(mip, face, 0);
+            const size_t rowSize = (size * BitsPerPixel(format) + 7) / 8;
+            if (!StoreScanline(dest->pixels + y * dest->rowPitch, rowSize, format, row.get(), size))
+            {
+                failed = true;
+                return;
+            }
+        }
+    });
+
+    if (failed)
+    {
+        cube.Release();
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Irradiance spherical harmonics
+//-------------------------------------------------------------------------------------
+bool VulkanTex::ComputeIrradianceSH(const ImageSetView& srcImages, float* coefficients) noexcept
+{
+    return ComputeIrradianceSH(srcImages.images, srcImages.nimages, srcImages.metadata, coefficients);
+}
+
+bool VulkanTex::ComputeIrradianceSH(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    float* coefficients) noexcept
+{
+    if (!coefficients || !ValidateCube(srcImages, nimages, metadata))
+        return false;
+
+    CubeChain chain;
+    if (!ExpandFaces(srcImages, metadata, chain))
+        return false;
+
+    const size_t faceSize = metadata.width;
+
+    // Face-plane position of each column
+    std::vector<float> sTable;
+
+    try
+    {
+        sTable.resize(faceSize);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    for (size_t x = 0; x < faceSize; ++x)
+    {
+        sTable[x] = 2.f * (static_cast<float>(x) + 0.5f) / static_cast<float>(faceSize) - 1.f;
+    }
+
+    // Texel solid angle is texelArea / (1 + s^2 + t^2)^(3/2)
+    const float texelArea = 4.f / (static_cast<float>(faceSize) * static_cast<float>(faceSize));
+
+    double totals[27] = {};
+    double totalAngle = 0.0;
+    std::mutex totalsLock;
+
+    ParallelFor(6 * faceSize, 16, [&](size_t begin, size_t end) noexcept
+    {
+        double sums[27] = {};
+        double angle = 0.0;
+
+        for (size_t r = begin; r < end; ++r)
+        {
+            const size_t face = r / faceSize;
+            const size_t y    = r % faceSize;
+            const float (&axes)[3][3] = c_cubeFaceAxes[face];
+            const float t = sTable[y];
+            const Float4* pixels = chain.faces[face].pixels.get() + y * faceSize;
+
+            // Row-constant part of the direction
+            const float rx = t * axes[1][0] + axes[2][0];
+            const float ry = t * axes[1][1] + axes[2][1];
+            const float rz = t * axes[1][2] + axes[2][2];
+
+            size_t x = 0;
+
+#if VULKANTEX_SSE2
+            // Four texels at a time, per-row partial sums in float
+            __m128 acc[27];
+            for (size_t i = 0; i < 27; ++i)
+                acc[i] = _mm_setzero_ps();
+            __m128 accAngle = _mm_setzero_ps();
+
+            for (; x + 4 <= faceSize; x += 4)
+            {
+                const __m128 s = _mm_loadu_ps(sTable.data() + x);
+                const __m128 q = _mm_add_ps(_mm_mul_ps(s, s), _mm_set1_ps(1.f + t * t));
+                const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(q));
+                const __m128 weight = _mm_mul_ps(_mm_mul_ps(invLength, _mm_mul_ps(invLength, invLength)), _mm_set1_ps(texelArea));
+
+                const __m128 dx = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(axes[0][0])), _mm_set1_ps(rx)), invLength);
+                const __m128 dy = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(axes[0][1])), _mm_set1_ps(ry)), invLength);
+                const __m128 dz = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(axes[0][2])), _mm_set1_ps(rz)), invLength);
+
+                __m128 red   = _mm_load_ps(&pixels[x].x);
+                __m128 green = _mm_load_ps(&pixels[x + 1].x);
+                __m128 blue  = _mm_load_ps(&pixels[x + 2].x);
+                __m128 alpha = _mm_load_ps(&pixels[x + 3].x);
+                _MM_TRANSPOSE4_PS(red, green, blue, alpha);
+
+                const __m128 basis[9] =
+                {
+                    weight,
+                    _mm_mul_ps(dy, weight),
+                    _mm_mul_ps(dz, weight),
+                    _mm_mul_ps(dx, weight),
+                    _mm_mul_ps(_mm_mul_ps(dx, dy), weight),
+                    _mm_mul_ps(_mm_mul_ps(dy, dz), weight),
+                    _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(3.f), _mm_mul_ps(dz, dz)), _mm_set1_ps(1.f)), weight),
+                    _mm_mul_ps(_mm_mul_ps(dx, dz), weight),
+                    _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), weight),
+                };
+
+                for (size_t i = 0; i < 9; ++i)
+                {
+                    acc[i * 3]     = _mm_add_ps(acc[i * 3], _mm_mul_ps(basis[i], red));
+                    acc[i * 3 + 1] = _mm_add_ps(acc[i * 3 + 1], _mm_mul_ps(basis[i], green));
+                    acc[i * 3 + 2] = _mm_add_ps(acc[i * 3 + 2], _mm_mul_ps(basis[i], blue));
+                }
+
+                accAngle = _mm_add_ps(accAngle, weight);
+            }
+
+            alignas(16) float lanes[4];
+            for (size_t i = 0; i < 27; ++i)
+            {
+                _mm_store_ps(lanes, acc[i]);
+                sums[i] += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+            }
+
+            _mm_store_ps(lanes, accAngle);
+            angle += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+            for (; x < faceSize; ++x)
+            {
+                const float s = sTable[x];
+                const float invLength = 1.f / std::sqrt(1.f + s * s + t * t);
+                const float weight = texelArea * invLength * invLength * invLength;
+
+                const float dx = (s * axes[0][0] + rx) * invLength;
+                const float dy = (s * axes[0][1] + ry) * invLength;
+                const float dz = (s * axes[0][2] + rz) * invLength;
+
+                AccumulateSH(sums, dx, dy, dz, weight, pixels[x]);
+                angle += weight;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(totalsLock);
+        for (size_t i = 0; i < 27; ++i)
+            totals[i] += sums[i];
+        totalAngle += angle;
+    });
+
+    if (totalAngle <= 0.0)
+        return false;
+
+    // The texel solid angles sum to 4 pi up to discretization, normalize that error away
+    const double normalize = 4.0 * 3.14159265358979323846 / totalAngle;
+
+    for (size_t i = 0; i < 27; ++i)
+    {
+        coefficients[i] = static_cast<float>(totals[i] * normalize * c_shScale[i / 3]);
+    }
+
+    return true;
+}
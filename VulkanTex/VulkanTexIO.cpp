@@ -0,0 +1,502 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+#if !_WIN32
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+#if !_WIN32
+    // Large spans are split so a single big subresource still spreads over the workers
+    constexpr size_t c_threadPoolChunkBytes = 8u * 1024u * 1024u;
+
+    bool TransferAt(int fd, bool write, uint8_t* ptr, size_t size, uint64_t offset) noexcept
+    {
+        while (size > 0)
+        {
+            const ssize_t bytes = write
+                ? ::pwrite(fd, ptr, size, static_cast<off_t>(offset))
+                : ::pread(fd, ptr, size, static_cast<off_t>(offset));
+
+            if (bytes < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            if (bytes == 0)
+                return false;
+
+            ptr    += bytes;
+            offset += static_cast<uint64_t>(bytes);
+            size   -= static_cast<size_t>(bytes);
+        }
+        return true;
+    }
+
+    // Appends 'request' to 'chunks' in pieces of at most maxBytes
+    void SplitRequest(const IORequest& request, size_t maxBytes, std::vector<IORequest>& chunks)
+    {
+        for (size_t done = 0; done < request.size; done += maxBytes)
+        {
+            chunks.push_back({ request.offset + done, request.buffer + done, std::min(maxBytes, request.size - done) });
+        }
+    }
+
+    bool TransferThreadPool(int fd, bool write, const IORequest* requests, size_t count) noexcept
+    {
+        std::vector<IORequest> chunks;
+        try
+        {
+            chunks.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                SplitRequest(requests[i], c_threadPoolChunkBytes, chunks);
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        std::atomic<bool> failed{ false };
+
+        ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) noexcept
+        {
+            for (size_t i = begin; (i < end) && !failed.load(std::memory_order_relaxed); ++i)
+            {
+                if (!TransferAt(fd, write, chunks[i].buffer, chunks[i].size, chunks[i].offset))
+                    failed = true;
+            }
+        });
+
+        return !failed;
+    }
+#endif // !_WIN32
+
+#if defined(__linux__)
+    //-------------------------------------------------------------------------------------
+    // io_uring backend
+    // Driven with the raw system calls. Each thread owns one ring, created on first use and
+    // kept for the thread's lifetime so a batch costs a single io_uring_enter in the common
+    // case. The ring also owns a staging buffer registered as fixed buffer 0.
+    //-------------------------------------------------------------------------------------
+    constexpr unsigned c_ringEntries    = 256;
+    constexpr size_t   c_ioStagingBytes = 4u * 1024u * 1024u;
+
+    // The kernel caps one read or write at 2 GiB - 4 KiB
+    constexpr size_t c_maxRingTransfer = 1u << 30;
+
+    class IOUring
+    {
+    public:
+        IOUring() noexcept = default;
+
+        ~IOUring()
+        {
+            if (m_sqes)
+                munmap(m_sqes, m_sqesSize);
+            if (m_cqRing && (m_cqRing != m_sqRing))
+                munmap(m_cqRing, m_cqRingSize);
+            if (m_sqRing)
+                munmap(m_sqRing, m_sqRingSize);
+            if (m_fd >= 0)
+                ::close(m_fd);
+
+            std::free(m_staging);
+        }
+
+        IOUring(const IOUring&) = delete;
+        IOUring& operator=(const IOUring&) = delete;
+
+        bool Initialize() noexcept
+        {
+            io_uring_params params = {};
+            m_fd = static_cast<int>(syscall(__NR_io_uring_setup, c_ringEntries, &params));
+            if (m_fd < 0)
+                return false;
+
+            m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            m_sqesSize   = params.sq_entries * sizeof(io_uring_sqe);
+
+            const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMap)
+                m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+            void* sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+            if (sqRing == MAP_FAILED)
+                return false;
+            m_sqRing = static_cast<uint8_t*>(sqRing);
+
+            if (singleMap)
+            {
+                m_cqRing = m_sqRing;
+            }
+            else
+            {
+                void* cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+                if (cqRing == MAP_FAILED)
+                    return false;
+                m_cqRing = static_cast<uint8_t*>(cqRing);
+            }
+
+            void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+            if (sqes == MAP_FAILED)
+                return false;
+            m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+            m_sqTail    = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.tail);
+            m_sqMask    = *reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.ring_mask);
+            m_sqArray   = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.array);
+            m_cqHead    = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.head);
+            m_cqTail    = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.tail);
+            m_cqMask    = *reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.ring_mask);
+            m_cqes      = reinterpret_cast<io_uring_cqe*>(m_cqRing + params.cq_off.cqes);
+            m_sqEntries = params.sq_entries;
+
+            // IORING_OP_READ/WRITE arrived in 5.6 together with the probe; older kernels use the thread pool
+            if (!SupportsOperations())
+                return false;
+
+            // Registration pins the pages and counts against RLIMIT_MEMLOCK, so it is optional
+            m_staging = static_cast<uint8_t*>(std::aligned_alloc(4096, c_ioStagingBytes));
+            if (m_staging)
+            {
+                iovec vector = { m_staging, c_ioStagingBytes };
+                if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, &vector, 1) != 0)
+                {
+                    std::free(m_staging);
+                    m_staging = nullptr;
+                }
+            }
+
+            return true;
+        }
+
+        uint8_t* GetStaging(size_t& size) const noexcept
+        {
+            size = m_staging ? c_ioStagingBytes : 0;
+            return m_staging;
+        }
+
+        bool IsBroken() const noexcept { return m_broken; }
+
+        bool Transfer(int fd, bool write, const IORequest* requests, size_t count) noexcept
+        {
+            std::vector<IORequest> chunks;
+            std::vector<uint32_t> ready;
+            try
+            {
+                chunks.reserve(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    SplitRequest(requests[i], c_maxRingTransfer, chunks);
+                }
+
+                if (chunks.size() > UINT32_MAX)
+                    return false;
+
+                // Submitted front to back, short transfers go back on the stack with their remainder
+                ready.resize(chunks.size());
+                for (size_t i = 0; i < chunks.size(); ++i)
+                {
+                    ready[i] = static_cast<uint32_t>(chunks.size() - 1 - i);
+                }
+            }
+            catch (...)
+            {
+                return false;
+            }
+
+            bool failed = false;
+            size_t queued = 0;      // In the submission ring, not yet consumed by io_uring_enter
+            size_t inflight = 0;    // Submitted, completion not reaped yet
+
+            for (;;)
+            {
+                while (!failed && !ready.empty() && (queued + inflight < m_sqEntries))
+                {
+                    const uint32_t index = ready.back();
+                    ready.pop_back();
+                    Queue(fd, write, chunks[index], index);
+                    ++queued;
+                }
+
+                if (!queued && !inflight)
+                    break;
+
+                const int submitted = m_broken ? 0 : static_cast<int>(syscall(__NR_io_uring_enter, m_fd,
+                    static_cast<unsigned>(queued), 1u, IORING_ENTER_GETEVENTS, nullptr, 0));
+
+                if (m_broken)
+                {
+                    // The kernel still owns the buffers of the requests in flight, poll until they complete
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+                else if (submitted < 0)
+                {
+                    if ((errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY))
+                    {
+                        // The ring is dropped with this thread's next batch. Entries the kernel has not
+                        // consumed are taken back, those in flight are still reaped below.
+                        const std::atomic_ref<uint32_t> sqTail(*m_sqTail);
+                        sqTail.store(sqTail.load(std::memory_order_relaxed) - static_cast<uint32_t>(queued), std::memory_order_release);
+                        queued   = 0;
+                        failed   = true;
+                        m_broken = true;
+                    }
+                }
+                else
+                {
+                    queued   -= static_cast<size_t>(submitted);
+                    inflight += static_cast<size_t>(submitted);
+                }
+
+                // Reap everything that completed
+                const std::atomic_ref<uint32_t> cqTail(*m_cqTail);
+                const std::atomic_ref<uint32_t> cqHead(*m_cqHead);
+
+                uint32_t head = cqHead.load(std::memory_order_relaxed);
+                const uint32_t tail = cqTail.load(std::memory_order_acquire);
+                for (; head != tail; ++head)
+                {
+                    const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                    const auto index = static_cast<uint32_t>(cqe.user_data);
+                    IORequest& chunk = chunks[index];
+                    --inflight;
+
+                    if (cqe.res < 0)
+                    {
+                        if ((cqe.res == -EINTR) || (cqe.res == -EAGAIN))
+                            ready.push_back(index);
+                        else
+                            failed = true;
+                    }
+                    else if (cqe.res == 0)
+                    {
+                        // End of file before the span was complete
+                        failed = true;
+                    }
+                    else if (static_cast<size_t>(cqe.res) < chunk.size)
+                    {
+                        chunk.offset += static_cast<uint64_t>(cqe.res);
+                        chunk.buffer += cqe.res;
+                        chunk.size   -= static_cast<size_t>(cqe.res);
+                        ready.push_back(index);
+                    }
+                }
+                cqHead.store(head, std::memory_order_release);
+            }
+
+            return !failed;
+        }
+
+    private:
+        bool SupportsOperations() const noexcept
+        {
+            constexpr unsigned c_probeOps = 256;
+            const size_t probeSize = sizeof(io_uring_probe) + c_probeOps * sizeof(io_uring_probe_op);
+
+            std::unique_ptr<uint8_t[]> storage(new (std::nothrow) uint8_t[probeSize]);
+            if (!storage)
+                return false;
+            memset(storage.get(), 0, probeSize);
+
+            auto probe = reinterpret_cast<io_uring_probe*>(storage.get());
+            if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, c_probeOps) != 0)
+                return false;
+
+            auto supported = [probe](unsigned op) noexcept
+            {
+                return (op <= probe->last_op) && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+            };
+
+            return supported(IORING_OP_READ) && supported(IORING_OP_WRITE)
+                && supported(IORING_OP_READ_FIXED) && supported(IORING_OP_WRITE_FIXED);
+        }
+
+        void Queue(int fd, bool write, const IORequest& chunk, uint32_t index) noexcept
+        {
+            const std::atomic_ref<uint32_t> sqTail(*m_sqTail);
+            const uint32_t tail = sqTail.load(std::memory_order_relaxed);
+            const uint32_t slot = tail & m_sqMask;
+
+            // Spans inside the registered staging buffer skip the per-request page pinning
+            const bool fixed = m_staging
+                && (chunk.buffer >= m_staging) && (chunk.buffer + chunk.size <= m_staging + c_ioStagingBytes);
+
+            io_uring_sqe& sqe = m_sqes[slot];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = static_cast<uint8_t>(fixed
+                ? (write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED)
+                : (write ? IORING_OP_WRITE : IORING_OP_READ));
+            sqe.fd        = fd;
+            sqe.off       = chunk.offset;
+            sqe.addr      = reinterpret_cast<uint64_t>(chunk.buffer);
+            sqe.len       = static_cast<uint32_t>(chunk.size);
+            sqe.buf_index = 0;
+            sqe.user_data = index;
+
+            m_sqArray[slot] = slot;
+            sqTail.store(tail + 1, std::memory_order_release);
+        }
+
+        int           m_fd = -1;
+        uint8_t*      m_sqRing = nullptr;
+        uint8_t*      m_cqRing = nullptr;
+        io_uring_sqe* m_sqes = nullptr;
+        io_uring_cqe* m_cqes = nullptr;
+        size_t        m_sqRingSize = 0;
+        size_t        m_cqRingSize = 0;
+        size_t        m_sqesSize = 0;
+        uint32_t*     m_sqTail = nullptr;
+        uint32_t*     m_sqArray = nullptr;
+        uint32_t*     m_cqHead = nullptr;
+        uint32_t*     m_cqTail = nullptr;
+        uint32_t      m_sqMask = 0;
+        uint32_t      m_cqMask = 0;
+        unsigned      m_sqEntries = 0;
+        uint8_t*      m_staging = nullptr;
+        bool          m_broken = false;
+    };
+
+    struct ThreadRing
+    {
+        std::unique_ptr<IOUring> ring;
+        bool                     attempted = false;
+    };
+
+    thread_local ThreadRing t_ring;
+
+    IOUring* GetThreadRing() noexcept
+    {
+        if (t_ring.ring && t_ring.ring->IsBroken())
+        {
+            t_ring.ring.reset();
+            t_ring.attempted = false;
+        }
+
+        if (!t_ring.attempted)
+        {
+            t_ring.attempted = true;
+
+            std::unique_ptr<IOUring> ring(new (std::nothrow) IOUring);
+            if (ring && ring->Initialize())
+                t_ring.ring = std::move(ring);
+        }
+
+        return t_ring.ring.get();
+    }
+#endif // __linux__
+
+#if !_WIN32
+    bool TransferBatch(int fd, bool write, const IORequest* requests, size_t count) noexcept
+    {
+        if (!count)
+            return true;
+
+        if (!requests || (fd < 0))
+            return false;
+
+#if defined(__linux__)
+        if (t_ioBackend == IO_BACKEND_IO_URING)
+        {
+            if (IOUring* ring = GetThreadRing())
+                return ring->Transfer(fd, write, requests, count);
+        }
+#endif
+
+        return TransferThreadPool(fd, write, requests, count);
+    }
+#endif // !_WIN32
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+IOBackendScope::IOBackendScope(IO_BACKEND backend) noexcept :
+    m_previous(t_ioBackend)
+{
+    t_ioBackend = backend;
+}
+
+IOBackendScope::~IOBackendScope()
+{
+    t_ioBackend = m_previous;
+}
+
+bool VulkanTex::IsIOBackendSupported(IO_BACKEND backend) noexcept
+{
+    switch (backend)
+    {
+        case IO_BACKEND_DEFAULT:
+            return true;
+
+#if !_WIN32
+        case IO_BACKEND_THREAD_POOL:
+            return true;
+#endif
+
+#if defined(__linux__)
+        case IO_BACKEND_IO_URING:
+            return GetThreadRing() != nullptr;
+#endif
+
+        default:
+            return false;
+    }
+}
+
+#if !_WIN32
+bool VulkanTex::Internal::ReadBatch(int fd, const IORequest* requests, size_t count) noexcept
+{
+    return TransferBatch(fd, false, requests, count);
+}
+
+bool VulkanTex::Internal::WriteBatch(int fd, const IORequest* requests, size_t count) noexcept
+{
+    return TransferBatch(fd, true, requests, count);
+}
+
+uint8_t* VulkanTex::Internal::GetIOStaging(size_t& size) noexcept
+{
+    size = 0;
+
+#if defined(__linux__)
+    if (t_ioBackend == IO_BACKEND_IO_URING)
+    {
+        if (IOUring* ring = GetThreadRing())
+            return ring->GetStaging(size);
+    }
+#endif
+
+    return nullptr;
+}
+#endif // !_WIN32
@@ -0,0 +1,1401 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    const uint8_t c_ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    // Vendor supercompression scheme (0x10000 - 0x1FFFF range): per-subresource LZ chunks,
+    // the chunk index of every level is stored in the supercompression global data
+    constexpr uint32_t c_ktx2SchemeChunkedLZ = 0x15654;
+
+    const char c_ktx2WriterKey[]   = "KTXwriter";
+    const char c_ktx2WriterValue[] = "VulkanTex";
+
+#pragma pack(push, 1)
+    struct KTX2_HEADER
+    {
+        uint8_t  identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+
+        // Index
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+
+    struct KTX2_LEVEL_INDEX
+    {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(KTX2_HEADER) == 80, "KTX2 header size mismatch");
+    static_assert(sizeof(KTX2_LEVEL_INDEX) == 24, "KTX2 level index size mismatch");
+
+    //---------------------------------------------------------------------------------
+    // Data Format Descriptor (Khronos Data Format 1.3, basic descriptor block)
+    enum KHR_DF_MODEL : uint8_t
+    {
+        KHR_DF_MODEL_UNSPECIFIED = 0,
+        KHR_DF_MODEL_RGBSDA = 1,
+        KHR_DF_MODEL_BC1A = 128,
+        KHR_DF_MODEL_BC2 = 129,
+        KHR_DF_MODEL_BC3 = 130,
+        KHR_DF_MODEL_BC4 = 131,
+        KHR_DF_MODEL_BC5 = 132,
+        KHR_DF_MODEL_BC6H = 133,
+        KHR_DF_MODEL_BC7 = 134,
+        KHR_DF_MODEL_ETC2 = 161,
+        KHR_DF_MODEL_ASTC = 162,
+    };
+
+    enum KHR_DF_CHANNEL : uint8_t
+    {
+        CH_R = 0,
+        CH_G = 1,
+        CH_B = 2,
+        CH_STENCIL = 13,
+        CH_DEPTH = 14,
+        CH_A = 15,
+
+        // Compressed models
+        CH_BC1A_ALPHA = 1,
+        CH_BC2_ALPHA = 15,
+        CH_BC3_ALPHA = 15,
+        CH_BC5_GREEN = 1,
+        CH_ETC2_COLOR = 2,
+        CH_ETC2_ALPHA = 15,
+    };
+
+    enum KHR_DF_SAMPLE : uint8_t
+    {
+        DF_SAMPLE_LINEAR   = 0x10,
+        DF_SAMPLE_EXPONENT = 0x20,
+        DF_SAMPLE_SIGNED   = 0x40,
+        DF_SAMPLE_FLOAT    = 0x80,
+    };
+
+    enum DF_NUMERIC : uint8_t
+    {
+        NUM_UNORM,
+        NUM_SNORM,
+        NUM_UINT,
+        NUM_SINT,
+        NUM_SFLOAT,
+        NUM_UFLOAT,
+    };
+
+    struct DFChannel
+    {
+        uint8_t channel;
+        uint8_t offset;
+        uint8_t bits;
+    };
+
+    struct DFSample
+    {
+        uint16_t bitOffset;
+        uint8_t  bitLength;     // Minus one
+        uint8_t  channelType;
+        uint8_t  samplePosition[4];
+        uint32_t sampleLower;
+        uint32_t sampleUpper;
+    };
+
+    static_assert(sizeof(DFSample) == 16, "DFD sample size mismatch");
+
+    struct DFDescription
+    {
+        uint8_t  model;
+        uint8_t  blockWidth;
+        uint8_t  blockHeight;
+        uint8_t  bytesPlane0;
+        uint8_t  sampleCount;
+        DFSample samples[4];
+    };
+
+    void SetSampleRange(DFSample& sample, DF_NUMERIC numeric, size_t bits) noexcept
+    {
+        switch (numeric)
+        {
+            case NUM_UNORM:
+                sample.sampleLower = 0;
+                sample.sampleUpper = (bits >= 32) ? UINT32_MAX : ((1u << bits) - 1u);
+                break;
+
+            case NUM_SNORM:
+                sample.channelType |= DF_SAMPLE_SIGNED;
+                sample.sampleUpper = (bits >= 32) ? INT32_MAX : ((1u << (bits - 1)) - 1u);
+                sample.sampleLower = static_cast<uint32_t>(-static_cast<int32_t>(sample.sampleUpper));
+                break;
+
+            case NUM_UINT:
+                sample.sampleLower = 0;
+                sample.sampleUpper = 1;
+                break;
+
+            case NUM_SINT:
+                sample.channelType |= DF_SAMPLE_SIGNED;
+                sample.sampleLower = UINT32_MAX;
+                sample.sampleUpper = 1;
+                break;
+
+            case NUM_SFLOAT:
+                sample.channelType |= DF_SAMPLE_SIGNED | DF_SAMPLE_FLOAT;
+                sample.sampleLower = 0xBF800000u; // -1.0f
+                sample.sampleUpper = 0x3F800000u; // 1.0f
+                break;
+
+            case NUM_UFLOAT:
+                sample.channelType |= DF_SAMPLE_FLOAT;
+                sample.sampleLower = 0;
+                sample.sampleUpper = 0x3F800000u;
+                break;
+        }
+    }
+
+    // Channel layout of the common uncompressed formats
+    bool GetUncompressedLayout(VkFormat format, DFChannel* channels, size_t& count, DF_NUMERIC& numeric) noexcept
+    {
+        #define DF_LAYOUT(n, type, ...) { const DFChannel layout[] = { __VA_ARGS__ }; count = n; numeric = type; memcpy(channels, layout, sizeof(layout)); return true; }
+
+        switch (format)
+        {
+            case VK_FORMAT_R8_UNORM: case VK_FORMAT_R8_SRGB:        DF_LAYOUT(1, NUM_UNORM, { CH_R, 0, 8 })
+            case VK_FORMAT_R8_SNORM:                                DF_LAYOUT(1, NUM_SNORM, { CH_R, 0, 8 })
+            case VK_FORMAT_R8_UINT:                                 DF_LAYOUT(1, NUM_UINT,  { CH_R, 0, 8 })
+            case VK_FORMAT_R8_SINT:                                 DF_LAYOUT(1, NUM_SINT,  { CH_R, 0, 8 })
+            case VK_FORMAT_R8G8_UNORM: case VK_FORMAT_R8G8_SRGB:    DF_LAYOUT(2, NUM_UNORM, { CH_R, 0, 8 }, { CH_G, 8, 8 })
+            case VK_FORMAT_R8G8_SNORM:                              DF_LAYOUT(2, NUM_SNORM, { CH_R, 0, 8 }, { CH_G, 8, 8 })
+            case VK_FORMAT_R8G8_UINT:                               DF_LAYOUT(2, NUM_UINT,  { CH_R, 0, 8 }, { CH_G, 8, 8 })
+            case VK_FORMAT_R8G8_SINT:                               DF_LAYOUT(2, NUM_SINT,  { CH_R, 0, 8 }, { CH_G, 8, 8 })
+            case VK_FORMAT_R8G8B8_UNORM: case VK_FORMAT_R8G8B8_SRGB: DF_LAYOUT(3, NUM_UNORM, { CH_R, 0, 8 }, { CH_G, 8, 8 }, { CH_B, 16, 8 })
+            case VK_FORMAT_B8G8R8_UNORM: case VK_FORMAT_B8G8R8_SRGB: DF_LAYOUT(3, NUM_UNORM, { CH_B, 0, 8 }, { CH_G, 8, 8 }, { CH_R, 16, 8 })
+
+            case VK_FORMAT_R8G8B8A8_UNORM: case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_A8B8G8R8_UNORM_PACK32: case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+                DF_LAYOUT(4, NUM_UNORM, { CH_R, 0, 8 }, { CH_G, 8, 8 }, { CH_B, 16, 8 }, { CH_A, 24, 8 })
+            case VK_FORMAT_R8G8B8A8_SNORM: case VK_FORMAT_A8B8G8R8_SNORM_PACK32:
+                DF_LAYOUT(4, NUM_SNORM, { CH_R, 0, 8 }, { CH_G, 8, 8 }, { CH_B, 16, 8 }, { CH_A, 24, 8 })
+            case VK_FORMAT_R8G8B8A8_UINT: case VK_FORMAT_A8B8G8R8_UINT_PACK32:
+                DF_LAYOUT(4, NUM_UINT, { CH_R, 0, 8 }, { CH_G, 8, 8 }, { CH_B, 16, 8 }, { CH_A, 24, 8 })
+            case VK_FORMAT_R8G8B8A8_SINT: case VK_FORMAT_A8B8G8R8_SINT_PACK32:
+                DF_LAYOUT(4, NUM_SINT, { CH_R, 0, 8 }, { CH_G, 8, 8 }, { CH_B, 16, 8 }, { CH_A, 24, 8 })
+            case VK_FORMAT_B8G8R8A8_UNORM: case VK_FORMAT_B8G8R8A8_SRGB:
+                DF_LAYOUT(4, NUM_UNORM, { CH_B, 0, 8 }, { CH_G, 8, 8 }, { CH_R, 16, 8 }, { CH_A, 24, 8 })
+
+            case VK_FORMAT_R16_UNORM:                               DF_LAYOUT(1, NUM_UNORM,  { CH_R, 0, 16 })
+            case VK_FORMAT_R16_SNORM:                               DF_LAYOUT(1, NUM_SNORM,  { CH_R, 0, 16 })
+            case VK_FORMAT_R16_UINT:                                DF_LAYOUT(1, NUM_UINT,   { CH_R, 0, 16 })
+            case VK_FORMAT_R16_SINT:                                DF_LAYOUT(1, NUM_SINT,   { CH_R, 0, 16 })
+            case VK_FORMAT_R16_SFLOAT:                              DF_LAYOUT(1, NUM_SFLOAT, { CH_R, 0, 16 })
+            case VK_FORMAT_R16G16_UNORM:                            DF_LAYOUT(2, NUM_UNORM,  { CH_R, 0, 16 }, { CH_G, 16, 16 })
+            case VK_FORMAT_R16G16_SNORM:                            DF_LAYOUT(2, NUM_SNORM,  { CH_R, 0, 16 }, { CH_G, 16, 16 })
+            case VK_FORMAT_R16G16_UINT:                             DF_LAYOUT(2, NUM_UINT,   { CH_R, 0, 16 }, { CH_G, 16, 16 })
+            case VK_FORMAT_R16G16_SINT:                             DF_LAYOUT(2, NUM_SINT,   { CH_R, 0, 16 }, { CH_G, 16, 16 })
+            case VK_FORMAT_R16G16_SFLOAT:                           DF_LAYOUT(2, NUM_SFLOAT, { CH_R, 0, 16 }, { CH_G, 16, 16 })
+            case VK_FORMAT_R16G16B16A16_UNORM:  DF_LAYOUT(4, NUM_UNORM,  { CH_R, 0, 16 }, { CH_G, 16, 16 }, { CH_B, 32, 16 }, { CH_A, 48, 16 })
+            case VK_FORMAT_R16G16B16A16_SNORM:  DF_LAYOUT(4, NUM_SNORM,  { CH_R, 0, 16 }, { CH_G, 16, 16 }, { CH_B, 32, 16 }, { CH_A, 48, 16 })
+            case VK_FORMAT_R16G16B16A16_UINT:   DF_LAYOUT(4, NUM_UINT,   { CH_R, 0, 16 }, { CH_G, 16, 16 }, { CH_B, 32, 16 }, { CH_A, 48, 16 })
+            case VK_FORMAT_R16G16B16A16_SINT:   DF_LAYOUT(4, NUM_SINT,   { CH_R, 0, 16 }, { CH_G, 16, 16 }, { CH_B, 32, 16 }, { CH_A, 48, 16 })
+            case VK_FORMAT_R16G16B16A16_SFLOAT: DF_LAYOUT(4, NUM_SFLOAT, { CH_R, 0, 16 }, { CH_G, 16, 16 }, { CH_B, 32, 16 }, { CH_A, 48, 16 })
+
+            case VK_FORMAT_R32_UINT:                                DF_LAYOUT(1, NUM_UINT,   { CH_R, 0, 32 })
+            case VK_FORMAT_R32_SINT:                                DF_LAYOUT(1, NUM_SINT,   { CH_R, 0, 32 })
+            case VK_FORMAT_R32_SFLOAT:                              DF_LAYOUT(1, NUM_SFLOAT, { CH_R, 0, 32 })
+            case VK_FORMAT_R32G32_UINT:                             DF_LAYOUT(2, NUM_UINT,   { CH_R, 0, 32 }, { CH_G, 32, 32 })
+            case VK_FORMAT_R32G32_SINT:                             DF_LAYOUT(2, NUM_SINT,   { CH_R, 0, 32 }, { CH_G, 32, 32 })
+            case VK_FORMAT_R32G32_SFLOAT:                           DF_LAYOUT(2, NUM_SFLOAT, { CH_R, 0, 32 }, { CH_G, 32, 32 })
+            case VK_FORMAT_R32G32B32_UINT:      DF_LAYOUT(3, NUM_UINT,   { CH_R, 0, 32 }, { CH_G, 32, 32 }, { CH_B, 64, 32 })
+            case VK_FORMAT_R32G32B32_SINT:      DF_LAYOUT(3, NUM_SINT,   { CH_R, 0, 32 }, { CH_G, 32, 32 }, { CH_B, 64, 32 })
+            case VK_FORMAT_R32G32B32_SFLOAT:    DF_LAYOUT(3, NUM_SFLOAT, { CH_R, 0, 32 }, { CH_G, 32, 32 }, { CH_B, 64, 32 })
+            case VK_FORMAT_R32G32B32A32_UINT:   DF_LAYOUT(4, NUM_UINT,   { CH_R, 0, 32 }, { CH_G, 32, 32 }, { CH_B, 64, 32 }, { CH_A, 96, 32 })
+            case VK_FORMAT_R32G32B32A32_SINT:   DF_LAYOUT(4, NUM_SINT,   { CH_R, 0, 32 }, { CH_G, 32, 32 }, { CH_B, 64, 32 }, { CH_A, 96, 32 })
+            case VK_FORMAT_R32G32B32A32_SFLOAT: DF_LAYOUT(4, NUM_SFLOAT, { CH_R, 0, 32 }, { CH_G, 32, 32 }, { CH_B, 64, 32 }, { CH_A, 96, 32 })
+
+            case VK_FORMAT_R5G6B5_UNORM_PACK16:     DF_LAYOUT(3, NUM_UNORM, { CH_B, 0, 5 }, { CH_G, 5, 6 }, { CH_R, 11, 5 })
+            case VK_FORMAT_B5G6R5_UNORM_PACK16:     DF_LAYOUT(3, NUM_UNORM, { CH_R, 0, 5 }, { CH_G, 5, 6 }, { CH_B, 11, 5 })
+            case VK_FORMAT_R5G5B5A1_UNORM_PACK16:   DF_LAYOUT(4, NUM_UNORM, { CH_A, 0, 1 }, { CH_B, 1, 5 }, { CH_G, 6, 5 }, { CH_R, 11, 5 })
+            case VK_FORMAT_B5G5R5A1_UNORM_PACK16:   DF_LAYOUT(4, NUM_UNORM, { CH_A, 0, 1 }, { CH_R, 1, 5 }, { CH_G, 6, 5 }, { CH_B, 11, 5 })
+            case VK_FORMAT_A1R5G5B5_UNORM_PACK16:   DF_LAYOUT(4, NUM_UNORM, { CH_B, 0, 5 }, { CH_G, 5, 5 }, { CH_R, 10, 5 }, { CH_A, 15, 1 })
+            case VK_FORMAT_R4G4B4A4_UNORM_PACK16:   DF_LAYOUT(4, NUM_UNORM, { CH_A, 0, 4 }, { CH_B, 4, 4 }, { CH_G, 8, 4 }, { CH_R, 12, 4 })
+            case VK_FORMAT_B4G4R4A4_UNORM_PACK16:   DF_LAYOUT(4, NUM_UNORM, { CH_A, 0, 4 }, { CH_R, 4, 4 }, { CH_G, 8, 4 }, { CH_B, 12, 4 })
+            case VK_FORMAT_A2B10G10R10_UNORM_PACK32: DF_LAYOUT(4, NUM_UNORM, { CH_R, 0, 10 }, { CH_G, 10, 10 }, { CH_B, 20, 10 }, { CH_A, 30, 2 })
+            case VK_FORMAT_A2B10G10R10_UINT_PACK32:  DF_LAYOUT(4, NUM_UINT,  { CH_R, 0, 10 }, { CH_G, 10, 10 }, { CH_B, 20, 10 }, { CH_A, 30, 2 })
+            case VK_FORMAT_A2R10G10B10_UNORM_PACK32: DF_LAYOUT(4, NUM_UNORM, { CH_B, 0, 10 }, { CH_G, 10, 10 }, { CH_R, 20, 10 }, { CH_A, 30, 2 })
+            case VK_FORMAT_B10G11R11_UFLOAT_PACK32:  DF_LAYOUT(3, NUM_UFLOAT, { CH_R, 0, 11 }, { CH_G, 11, 11 }, { CH_B, 22, 10 })
+
+            case VK_FORMAT_D16_UNORM:               DF_LAYOUT(1, NUM_UNORM,  { CH_DEPTH, 0, 16 })
+            case VK_FORMAT_D32_SFLOAT:              DF_LAYOUT(1, NUM_SFLOAT, { CH_DEPTH, 0, 32 })
+            case VK_FORMAT_S8_UINT:                 DF_LAYOUT(1, NUM_UINT,   { CH_STENCIL, 0, 8 })
+
+            default:
+                return false;
+        }
+
+        #undef DF_LAYOUT
+    }
+
+    bool GetCompressedBlockSize(VkFormat format, size_t& blockWidth, size_t& blockHeight) noexcept
+    {
+        if (IsASTC(format))
+            return GetASTCBlockSize(format, blockWidth, blockHeight);
+
+        switch (format)
+        {
+            case VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG:
+            case VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG:
+            case VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG:
+            case VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG:
+                blockWidth  = 8;
+                blockHeight = 4;
+                return true;
+
+            default:
+                blockWidth  = 4;
+                blockHeight = 4;
+                return true;
+        }
+    }
+
+    // Describes 'format'; formats without a known channel layout get a descriptor without samples
+    void DescribeFormat(VkFormat format, DFDescription& desc) noexcept
+    {
+        memset(&desc, 0, sizeof(desc));
+        desc.blockWidth  = 1;
+        desc.blockHeight = 1;
+
+        auto addBlockSample = [&](uint8_t channel, uint16_t offset, uint16_t bits, DF_NUMERIC numeric)
+        {
+            DFSample& sample = desc.samples[desc.sampleCount++];
+            sample.bitOffset   = offset;
+            sample.bitLength   = static_cast<uint8_t>(bits - 1);
+            sample.channelType = channel;
+
+            if ((numeric == NUM_UNORM) || (numeric == NUM_SNORM))
+            {
+                // Block formats cover the full 32-bit range
+                sample.sampleLower = (numeric == NUM_SNORM) ? 0x80000000u : 0u;
+                sample.sampleUpper = (numeric == NUM_SNORM) ? 0x7FFFFFFFu : UINT32_MAX;
+                if (numeric == NUM_SNORM)
+                    sample.channelType |= DF_SAMPLE_SIGNED;
+            }
+            else
+            {
+                SetSampleRange(sample, numeric, bits);
+            }
+        };
+
+        if (IsCompressed(format))
+        {
+            size_t bw = 4, bh = 4;
+            GetCompressedBlockSize(format, bw, bh);
+            desc.blockWidth  = static_cast<uint8_t>(bw);
+            desc.blockHeight = static_cast<uint8_t>(bh);
+            desc.bytesPlane0 = static_cast<uint8_t>(BytesPerBlock(format));
+
+            if (IsASTC(format))
+            {
+                desc.model = KHR_DF_MODEL_ASTC;
+                addBlockSample(0, 0, 128, IsASTCHDR(format) ? NUM_SFLOAT : NUM_UNORM);
+                return;
+            }
+
+            switch (format)
+            {
+                case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC1A;
+                    addBlockSample(0, 0, 64, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC1A;
+                    addBlockSample(CH_BC1A_ALPHA, 0, 64, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_BC2_UNORM_BLOCK:
+                case VK_FORMAT_BC2_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC2;
+                    addBlockSample(CH_BC2_ALPHA, 0, 64, NUM_UNORM);
+                    addBlockSample(0, 64, 64, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_BC3_UNORM_BLOCK:
+                case VK_FORMAT_BC3_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC3;
+                    addBlockSample(CH_BC3_ALPHA, 0, 64, NUM_UNORM);
+                    addBlockSample(0, 64, 64, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_BC4_UNORM_BLOCK:
+                case VK_FORMAT_BC4_SNORM_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC4;
+                    addBlockSample(0, 0, 64, (format == VK_FORMAT_BC4_SNORM_BLOCK) ? NUM_SNORM : NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_BC5_UNORM_BLOCK:
+                case VK_FORMAT_BC5_SNORM_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC5;
+                    addBlockSample(0, 0, 64, (format == VK_FORMAT_BC5_SNORM_BLOCK) ? NUM_SNORM : NUM_UNORM);
+                    addBlockSample(CH_BC5_GREEN, 64, 64, (format == VK_FORMAT_BC5_SNORM_BLOCK) ? NUM_SNORM : NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+                case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC6H;
+                    addBlockSample(0, 0, 128, (format == VK_FORMAT_BC6H_SFLOAT_BLOCK) ? NUM_SFLOAT : NUM_UFLOAT);
+                    break;
+
+                case VK_FORMAT_BC7_UNORM_BLOCK:
+                case VK_FORMAT_BC7_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_BC7;
+                    addBlockSample(0, 0, 128, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+                case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+                case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+                case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_ETC2;
+                    addBlockSample(CH_ETC2_COLOR, 0, 64, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+                case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+                    desc.model = KHR_DF_MODEL_ETC2;
+                    addBlockSample(CH_ETC2_ALPHA, 0, 64, NUM_UNORM);
+                    addBlockSample(CH_ETC2_COLOR, 64, 64, NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+                case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+                    desc.model = KHR_DF_MODEL_ETC2;
+                    addBlockSample(0, 0, 64, (format == VK_FORMAT_EAC_R11_SNORM_BLOCK) ? NUM_SNORM : NUM_UNORM);
+                    break;
+
+                case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+                case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+                    desc.model = KHR_DF_MODEL_ETC2;
+                    addBlockSample(0, 0, 64, (format == VK_FORMAT_EAC_R11G11_SNORM_BLOCK) ? NUM_SNORM : NUM_UNORM);
+                    addBlockSample(1, 64, 64, (format == VK_FORMAT_EAC_R11G11_SNORM_BLOCK) ? NUM_SNORM : NUM_UNORM);
+                    break;
+
+                default:
+                    break;
+            }
+            return;
+        }
+
+        desc.bytesPlane0 = static_cast<uint8_t>(BitsPerPixel(format) / 8);
+
+        DFChannel channels[4];
+        size_t count = 0;
+        DF_NUMERIC numeric = NUM_UNORM;
+
+        if (!GetUncompressedLayout(format, channels, count, numeric))
+            return;
+
+        desc.model = KHR_DF_MODEL_RGBSDA;
+        for (size_t i = 0; i < count; ++i)
+        {
+            DFSample& sample = desc.samples[desc.sampleCount++];
+            sample.bitOffset   = channels[i].offset;
+            sample.bitLength   = static_cast<uint8_t>(channels[i].bits - 1);
+            sample.channelType = channels[i].channel;
+            SetSampleRange(sample, numeric, channels[i].bits);
+        }
+    }
+
+    // DFD block: dfdTotalSize followed by one basic descriptor block
+    void EncodeDFD(const TexMetadata& metadata, std::vector<uint8_t>& dfd)
+    {
+        DFDescription desc;
+        DescribeFormat(metadata.format, desc);
+
+        const bool srgb = IsSRGB(metadata.format);
+
+        const uint32_t blockSize = 24u + 16u * desc.sampleCount;
+        const uint32_t totalSize = 4u + blockSize;
+
+        dfd.assign(totalSize, 0);
+        uint8_t* p = dfd.data();
+
+        memcpy(p, &totalSize, 4);
+        // vendorId = 0 (Khronos), descriptorType = 0 (basic) in p[4..8]
+        const uint16_t version = 2;
+        const uint16_t size16  = static_cast<uint16_t>(blockSize);
+        memcpy(p + 8, &version, 2);
+        memcpy(p + 10, &size16, 2);
+
+        p[12] = desc.model;
+        p[13] = 1;                              // BT.709 primaries
+        p[14] = srgb ? 2 : 1;                   // sRGB / linear transfer
+        p[15] = metadata.IsPMAlpha() ? 1 : 0;   // KHR_DF_FLAG_ALPHA_PREMULTIPLIED
+        p[16] = static_cast<uint8_t>(desc.blockWidth - 1);
+        p[17] = static_cast<uint8_t>(desc.blockHeight - 1);
+        p[18] = 0;
+        p[19] = 0;
+        p[20] = desc.bytesPlane0;
+
+        for (size_t i = 0; i < desc.sampleCount; ++i)
+        {
+            DFSample sample = desc.samples[i];
+
+            // Alpha of sRGB formats stays linear
+            if (srgb && ((sample.channelType & 0xF) == CH_A) && (desc.model == KHR_DF_MODEL_RGBSDA))
+                sample.channelType |= DF_SAMPLE_LINEAR;
+
+            memcpy(p + 28 + i * 16, &sample, sizeof(sample));
+        }
+    }
+
+    void EncodeKVD(std::vector<uint8_t>& kvd)
+    {
+        const uint32_t length = static_cast<uint32_t>(sizeof(c_ktx2WriterKey) + sizeof(c_ktx2WriterValue));
+        const size_t padded = (4 + length + 3) & ~size_t(3);
+
+        kvd.assign(padded, 0);
+        memcpy(kvd.data(), &length, 4);
+        memcpy(kvd.data() + 4, c_ktx2WriterKey, sizeof(c_ktx2WriterKey));
+        memcpy(kvd.data() + 4 + sizeof(c_ktx2WriterKey), c_ktx2WriterValue, sizeof(c_ktx2WriterValue));
+    }
+
+    //---------------------------------------------------------------------------------
+    size_t GetTexelBlockBytes(VkFormat format) noexcept
+    {
+        return IsCompressed(format) ? BytesPerBlock(format) : (BitsPerPixel(format) + 7) / 8;
+    }
+
+    uint32_t GetTypeSize(VkFormat format) noexcept
+    {
+        if (IsCompressed(format))
+            return 1;
+
+        if (IsPacked(format))
+            return static_cast<uint32_t>(BitsPerPixel(format) / 8);
+
+        const size_t bits = BitsPerColor(format);
+        return (bits >= 8) ? static_cast<uint32_t>(bits / 8) : 1u;
+    }
+
+    // Level data offsets are aligned to lcm(texel block size, 4)
+    size_t GetLevelAlignment(VkFormat format) noexcept
+    {
+        size_t a = std::max<size_t>(GetTexelBlockBytes(format), 1u);
+        size_t b = 4;
+        size_t x = a, y = b;
+        while (y)
+        {
+            const size_t t = x % y;
+            x = y;
+            y = t;
+        }
+        return a / x * b;
+    }
+
+    size_t AlignUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Number of array layers / faces of the KTX2 image of 'metadata'
+    void GetLayerCounts(const TexMetadata& metadata, size_t& layers, size_t& faces) noexcept
+    {
+        faces  = metadata.IsCubemap() ? 6 : 1;
+        layers = metadata.arraySize / faces;
+    }
+
+    // Images of one level in KTX2 order (layer, face, z slice)
+    template<typename Fn>
+    bool ForEachLevelImage(const TexMetadata& metadata, size_t level, Fn&& fn)
+    {
+        size_t layers, faces;
+        GetLayerCounts(metadata, layers, faces);
+
+        size_t depth = metadata.depth;
+        for (size_t l = 0; l < level; ++l)
+        {
+            if (depth > 1)
+                depth >>= 1;
+        }
+
+        for (size_t layer = 0; layer < layers; ++layer)
+        {
+            for (size_t face = 0; face < faces; ++face)
+            {
+                for (size_t slice = 0; slice < depth; ++slice)
+                {
+                    const size_t index = metadata.ComputeIndex(level, layer * faces + face, slice);
+                    if (index == size_t(-1) || !fn(index))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Bytes of all the tightly packed images of one level
+    bool GetLevelSize(const TexMetadata& metadata, size_t level, uint64_t& size) noexcept
+    {
+        size_t rowPitch, slicePitch;
+        if (!ComputePitch(metadata.format,
+                std::max<size_t>(1u, metadata.width >> level), std::max<size_t>(1u, metadata.height >> level),
+                rowPitch, slicePitch, CP_FLAGS_NONE))
+            return false;
+
+        size = uint64_t(slicePitch) * metadata.arraySize * std::max<size_t>(1u, metadata.depth >> level);
+        return true;
+    }
+
+    // Supercompression global data of c_ktx2SchemeChunkedLZ
+    struct KTX2_SGD_HEADER
+    {
+        uint32_t chunkCount;
+        uint32_t reserved;
+        // levelCount x KTX2_SGD_LEVEL, then chunkCount x CompressedChunk
+    };
+
+    struct KTX2_SGD_LEVEL
+    {
+        uint32_t firstChunk;
+        uint32_t chunkCount;
+    };
+
+    struct KTX2Layout
+    {
+        KTX2_HEADER                   header;
+        std::vector<KTX2_LEVEL_INDEX> levels;
+        std::vector<uint8_t>          dfd;
+        std::vector<uint8_t>          kvd;
+        std::vector<uint8_t>          sgd;
+        std::vector<uint8_t>          payload;        // Supercompressed level data in file order
+        std::vector<size_t>           payloadOffset;  // Start of each level in 'payload'
+        size_t                        totalSize;
+    };
+
+    struct KTX2Index
+    {
+        std::vector<KTX2_LEVEL_INDEX> levels;
+        std::vector<KTX2_SGD_LEVEL>   levelChunks;
+        std::vector<CompressedChunk>  chunks;
+        bool                          supercompressed;
+    };
+
+    // Compresses all levels in file order, chunk offsets are rebased to their level
+    bool SupercompressLevels(
+        const Image* images, const TexMetadata& metadata, SUPERCOMPRESS_MODE mode, KTX2Layout& layout)
+    {
+        std::vector<Image> ordered;
+        std::vector<size_t> levelFirstImage(metadata.mipLevels + 1, 0);
+
+        for (size_t level = metadata.mipLevels; level-- > 0; )
+        {
+            levelFirstImage[level] = ordered.size();
+            ForEachLevelImage(metadata, level, [&](size_t index)
+            {
+                ordered.push_back(images[index]);
+                return true;
+            });
+        }
+
+        std::vector<CompressedChunk> chunks;
+        if (!CompressImages(ordered.data(), ordered.size(), mode, chunks, layout.payload))
+            return false;
+
+        std::vector<KTX2_SGD_LEVEL> levelChunks(metadata.mipLevels, KTX2_SGD_LEVEL{});
+        layout.payloadOffset.assign(metadata.mipLevels, 0);
+
+        size_t chunk = 0;
+        for (size_t level = metadata.mipLevels; level-- > 0; )
+        {
+            const size_t firstImage = levelFirstImage[level];
+            const size_t lastImage  = (level > 0) ? levelFirstImage[level - 1] : ordered.size();
+
+            levelChunks[level].firstChunk = static_cast<uint32_t>(chunk);
+
+            const uint64_t base = (chunk < chunks.size()) ? chunks[chunk].offset : layout.payload.size();
+            layout.payloadOffset[level] = static_cast<size_t>(base);
+
+            uint64_t size = 0;
+            while ((chunk < chunks.size()) && (chunks[chunk].image < lastImage))
+            {
+                chunks[chunk].image -= static_cast<uint32_t>(firstImage);
+                chunks[chunk].offset -= base;
+                size += chunks[chunk].size;
+                ++chunk;
+            }
+
+            levelChunks[level].chunkCount = static_cast<uint32_t>(chunk - levelChunks[level].firstChunk);
+            layout.levels[level].byteLength = size;
+        }
+
+        KTX2_SGD_HEADER sgdHeader = {};
+        sgdHeader.chunkCount = static_cast<uint32_t>(chunks.size());
+
+        const size_t levelBytes = levelChunks.size() * sizeof(KTX2_SGD_LEVEL);
+        layout.sgd.resize(sizeof(KTX2_SGD_HEADER) + levelBytes + chunks.size() * sizeof(CompressedChunk));
+        memcpy(layout.sgd.data(), &sgdHeader, sizeof(sgdHeader));
+        memcpy(layout.sgd.data() + sizeof(sgdHeader), levelChunks.data(), levelBytes);
+        memcpy(layout.sgd.data() + sizeof(sgdHeader) + levelBytes, chunks.data(), chunks.size() * sizeof(CompressedChunk));
+        return true;
+    }
+
+    bool ComputeKTX2Layout(const Image* images, size_t nimages, const TexMetadata& metadata, KTX2_FLAGS flags, KTX2Layout& layout)
+    {
+        if (!IsValid(metadata.format) || IsPlanar(metadata.format))
+            return false;
+
+        if ((metadata.width > UINT32_MAX) || (metadata.height > UINT32_MAX) || (metadata.depth > UINT32_MAX)
+            || (metadata.arraySize > UINT32_MAX) || !metadata.mipLevels || (metadata.mipLevels > UINT32_MAX))
+            return false;
+
+        if (metadata.IsVolumemap() && (metadata.arraySize > 1))
+            return false;
+
+        size_t layers, faces;
+        GetLayerCounts(metadata, layers, faces);
+
+        memset(&layout.header, 0, sizeof(layout.header));
+        KTX2_HEADER& header = layout.header;
+
+        memcpy(header.identifier, c_ktx2Identifier, sizeof(c_ktx2Identifier));
+        header.vkFormat    = static_cast<uint32_t>(metadata.format);
+        header.typeSize    = GetTypeSize(metadata.format);
+        header.pixelWidth  = static_cast<uint32_t>(metadata.width);
+        header.pixelHeight = (metadata.dimension == TEX_DIMENSION_TEXTURE1D) ? 0u : static_cast<uint32_t>(metadata.height);
+        header.pixelDepth  = metadata.IsVolumemap() ? static_cast<uint32_t>(metadata.depth) : 0u;
+        header.layerCount  = (layers > 1) ? static_cast<uint32_t>(layers) : 0u;
+        header.faceCount   = static_cast<uint32_t>(faces);
+        header.levelCount  = static_cast<uint32_t>(metadata.mipLevels);
+        header.supercompressionScheme = 0;
+
+        EncodeDFD(metadata, layout.dfd);
+        EncodeKVD(layout.kvd);
+
+        const SUPERCOMPRESS_MODE mode = (flags & KTX2_FLAGS_SUPERCOMPRESS_HIGH) ? SUPERCOMPRESS_HIGH
+            : (flags & KTX2_FLAGS_SUPERCOMPRESS_FAST) ? SUPERCOMPRESS_FAST : SUPERCOMPRESS_NONE;
+
+        size_t offset = sizeof(KTX2_HEADER) + metadata.mipLevels * sizeof(KTX2_LEVEL_INDEX);
+
+        header.dfdByteOffset = static_cast<uint32_t>(offset);
+        header.dfdByteLength = static_cast<uint32_t>(layout.dfd.size());
+        offset += layout.dfd.size();
+
+        header.kvdByteOffset = static_cast<uint32_t>(offset);
+        header.kvdByteLength = static_cast<uint32_t>(layout.kvd.size());
+        offset += layout.kvd.size();
+
+        // Level data is stored smallest level first so mip tails can be streamed in early
+        layout.levels.assign(metadata.mipLevels, KTX2_LEVEL_INDEX{});
+
+        for (size_t level = metadata.mipLevels; level-- > 0; )
+        {
+            uint64_t size = 0;
+            const bool ok = ForEachLevelImage(metadata, level, [&](size_t index)
+            {
+                if ((index >= nimages) || (images[index].format != metadata.format))
+                    return false;
+
+                size_t rowPitch, slicePitch;
+                if (!ComputePitch(metadata.format, images[index].width, images[index].height, rowPitch, slicePitch, CP_FLAGS_NONE))
+                    return false;
+
+                size += slicePitch;
+                return true;
+            });
+
+            if (!ok)
+                return false;
+
+            layout.levels[level].byteLength             = size;
+            layout.levels[level].uncompressedByteLength = size;
+        }
+
+        size_t alignment = GetLevelAlignment(metadata.format);
+
+        if (mode != SUPERCOMPRESS_NONE)
+        {
+            if (!SupercompressLevels(images, metadata, mode, layout))
+                return false;
+
+            header.supercompressionScheme = c_ktx2SchemeChunkedLZ;
+
+            offset = AlignUp(offset, 8);
+            header.sgdByteOffset = offset;
+            header.sgdByteLength = layout.sgd.size();
+            offset += layout.sgd.size();
+
+            // Supercompressed levels are not aligned
+            alignment = 1;
+        }
+
+        for (size_t level = metadata.mipLevels; level-- > 0; )
+        {
+            offset = AlignUp(offset, alignment);
+            layout.levels[level].byteOffset = offset;
+            offset += static_cast<size_t>(layout.levels[level].byteLength);
+        }
+
+        layout.totalSize = offset;
+        return true;
+    }
+
+    // Copies the tightly packed rows of 'image' to pDestination (or the reverse)
+    void CopyTightRows(uint8_t* pDestination, const Image& image) noexcept
+    {
+        size_t rowPitch, slicePitch;
+        ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE);
+
+        const size_t rows = ComputeScanlines(image.format, image.height);
+        const uint8_t* pSource = image.pixels;
+
+        for (size_t y = 0; y < rows; ++y)
+        {
+            memcpy(pDestination, pSource, rowPitch);
+            pDestination += rowPitch;
+            pSource += image.rowPitch;
+        }
+    }
+
+    void CopyTightRows(const Image& image, const uint8_t* pSource) noexcept
+    {
+        size_t rowPitch, slicePitch;
+        ComputePitch(image.format, image.width, image.height, rowPitch, slicePitch, CP_FLAGS_NONE);
+
+        const size_t rows = ComputeScanlines(image.format, image.height);
+        uint8_t* pDestination = image.pixels;
+
+        for (size_t y = 0; y < rows; ++y)
+        {
+            memcpy(pDestination, pSource, rowPitch);
+            pSource += rowPitch;
+            pDestination += image.rowPitch;
+        }
+    }
+
+    // Writes the data of one level, either the supercompressed payload or the tightly packed images
+    void EncodeLevel(const KTX2Layout& layout, const Image* images, const TexMetadata& metadata, size_t level, uint8_t* pDestination) noexcept
+    {
+        if (layout.header.supercompressionScheme)
+        {
+            memcpy(pDestination, layout.payload.data() + layout.payloadOffset[level], static_cast<size_t>(layout.levels[level].byteLength));
+            return;
+        }
+
+        ForEachLevelImage(metadata, level, [&](size_t index)
+        {
+            size_t rowPitch, slicePitch;
+            ComputePitch(images[index].format, images[index].width, images[index].height, rowPitch, slicePitch, CP_FLAGS_NONE);
+
+            CopyTightRows(pDestination, images[index]);
+            pDestination += slicePitch;
+            return true;
+        });
+    }
+
+    size_t GetHeaderBlockSize(const KTX2Layout& layout) noexcept
+    {
+        if (layout.header.sgdByteLength)
+            return static_cast<size_t>(layout.header.sgdByteOffset + layout.header.sgdByteLength);
+
+        return sizeof(KTX2_HEADER) + layout.levels.size() * sizeof(KTX2_LEVEL_INDEX) + layout.dfd.size() + layout.kvd.size();
+    }
+
+    void EncodeHeaderBlock(const KTX2Layout& layout, uint8_t* pDestination) noexcept
+    {
+        memcpy(pDestination, &layout.header, sizeof(KTX2_HEADER));
+        pDestination += sizeof(KTX2_HEADER);
+
+        memcpy(pDestination, layout.levels.data(), layout.levels.size() * sizeof(KTX2_LEVEL_INDEX));
+        pDestination += layout.levels.size() * sizeof(KTX2_LEVEL_INDEX);
+
+        memcpy(pDestination, layout.dfd.data(), layout.dfd.size());
+        pDestination += layout.dfd.size();
+
+        memcpy(pDestination, layout.kvd.data(), layout.kvd.size());
+        pDestination += layout.kvd.size();
+
+        if (layout.header.sgdByteLength)
+        {
+            // Padding up to the 8-byte aligned supercompression global data
+            const size_t offset = static_cast<size_t>(layout.header.kvdByteOffset) + layout.kvd.size();
+            memset(pDestination, 0, static_cast<size_t>(layout.header.sgdByteOffset) - offset);
+            memcpy(pDestination + (layout.header.sgdByteOffset - offset), layout.sgd.data(), layout.sgd.size());
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Decodes the header, level index, DFD flags and supercompression chunk index.
+    // 'size' must cover GetKTX2HeaderPrefixSize bytes, 'totalSize' is the file size.
+    bool DecodeKTX2Header(
+        const uint8_t* pSource, size_t size, uint64_t totalSize,
+        TexMetadata& metadata, KTX2Index& index)
+    {
+        if (size < sizeof(KTX2_HEADER))
+            return false;
+
+        KTX2_HEADER header;
+        memcpy(&header, pSource, sizeof(header));
+
+        if (memcmp(header.identifier, c_ktx2Identifier, sizeof(c_ktx2Identifier)) != 0)
+            return false;
+
+        const auto format = static_cast<VkFormat>(header.vkFormat);
+        if (!IsValid(format) || IsPlanar(format))
+            return false;
+
+        // Plain payloads and our own chunked scheme are supported
+        if ((header.supercompressionScheme != 0) && (header.supercompressionScheme != c_ktx2SchemeChunkedLZ))
+            return false;
+
+        if (!header.pixelWidth || ((header.faceCount != 1) && (header.faceCount != 6)))
+            return false;
+
+        if (header.pixelDepth && (header.layerCount || (header.faceCount != 1) || !header.pixelHeight))
+            return false;
+
+        metadata = {};
+        metadata.width     = header.pixelWidth;
+        metadata.height    = std::max<uint32_t>(header.pixelHeight, 1u);
+        metadata.depth     = std::max<uint32_t>(header.pixelDepth, 1u);
+        metadata.arraySize = size_t(std::max<uint32_t>(header.layerCount, 1u)) * header.faceCount;
+        metadata.mipLevels = std::max<uint32_t>(header.levelCount, 1u);
+        metadata.format    = format;
+
+        if (header.pixelDepth)
+            metadata.dimension = TEX_DIMENSION_TEXTURE3D;
+        else if (!header.pixelHeight)
+            metadata.dimension = TEX_DIMENSION_TEXTURE1D;
+        else
+            metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+        if (header.faceCount == 6)
+        {
+            if ((metadata.dimension != TEX_DIMENSION_TEXTURE2D) || (metadata.width != metadata.height))
+                return false;
+
+            metadata.miscFlags |= TEX_MISC_TEXTURECUBE;
+        }
+
+        // Bounds the allocations sized from the header below and in the loaders
+        if (!ValidateFileMetadata(metadata))
+            return false;
+
+        const size_t indexEnd = sizeof(KTX2_HEADER) + metadata.mipLevels * sizeof(KTX2_LEVEL_INDEX);
+        if (size < indexEnd)
+            return false;
+
+        auto& levels = index.levels;
+        levels.resize(metadata.mipLevels);
+        memcpy(levels.data(), pSource + sizeof(KTX2_HEADER), metadata.mipLevels * sizeof(KTX2_LEVEL_INDEX));
+
+        index.supercompressed = (header.supercompressionScheme == c_ktx2SchemeChunkedLZ);
+
+        for (size_t level = 0; level < levels.size(); ++level)
+        {
+            const KTX2_LEVEL_INDEX& entry = levels[level];
+            if ((entry.byteOffset > totalSize) || (entry.byteLength > totalSize - entry.byteOffset))
+                return false;
+
+            uint64_t expected;
+            if (!GetLevelSize(metadata, level, expected) || (entry.uncompressedByteLength != expected))
+                return false;
+
+            if (!index.supercompressed && (entry.byteLength != expected))
+                return false;
+        }
+
+        index.levelChunks.clear();
+        index.chunks.clear();
+
+        if (index.supercompressed)
+        {
+            const size_t levelBytes = metadata.mipLevels * sizeof(KTX2_SGD_LEVEL);
+            if ((header.sgdByteOffset > size) || (header.sgdByteLength > size - header.sgdByteOffset)
+                || (header.sgdByteLength < sizeof(KTX2_SGD_HEADER) + levelBytes))
+                return false;
+
+            const uint8_t* pSGD = pSource + header.sgdByteOffset;
+
+            KTX2_SGD_HEADER sgdHeader;
+            memcpy(&sgdHeader, pSGD, sizeof(sgdHeader));
+
+            if (uint64_t(sgdHeader.chunkCount) * sizeof(CompressedChunk) != header.sgdByteLength - sizeof(KTX2_SGD_HEADER) - levelBytes)
+                return false;
+
+            index.levelChunks.resize(metadata.mipLevels);
+            memcpy(index.levelChunks.data(), pSGD + sizeof(KTX2_SGD_HEADER), levelBytes);
+
+            index.chunks.resize(sgdHeader.chunkCount);
+            memcpy(index.chunks.data(), pSGD + sizeof(KTX2_SGD_HEADER) + levelBytes, index.chunks.size() * sizeof(CompressedChunk));
+
+            for (const auto& level : index.levelChunks)
+            {
+                if ((level.firstChunk > sgdHeader.chunkCount) || (level.chunkCount > sgdHeader.chunkCount - level.firstChunk))
+                    return false;
+            }
+        }
+
+        // The premultiplied alpha flag lives in the basic descriptor block
+        if ((header.dfdByteLength >= 16) && (size >= size_t(header.dfdByteOffset) + 16))
+        {
+            if (pSource[header.dfdByteOffset + 15] & 0x1)
+                metadata.SetAlphaMode(TEX_ALPHA_MODE_PREMULTIPLIED);
+        }
+
+        return true;
+    }
+
+    // Bytes needed from the start of the file to decode the header block
+    size_t GetKTX2HeaderPrefixSize(const uint8_t* pHeader) noexcept
+    {
+        KTX2_HEADER header;
+        memcpy(&header, pHeader, sizeof(header));
+
+        const size_t indexEnd = sizeof(KTX2_HEADER) + size_t(std::max<uint32_t>(header.levelCount, 1u)) * sizeof(KTX2_LEVEL_INDEX);
+        const size_t dfdEnd   = (header.dfdByteLength >= 16) ? size_t(header.dfdByteOffset) + 16 : 0;
+        const uint64_t sgdEnd = header.sgdByteOffset + header.sgdByteLength;
+        if ((sgdEnd < header.sgdByteOffset) || (sgdEnd > SIZE_MAX))
+            return SIZE_MAX;
+
+        return std::max({ indexEnd, dfdEnd, static_cast<size_t>(sgdEnd) });
+    }
+
+    // Metadata of the [firstMip, firstMip + mipCount) sub-chain
+    bool GetLevelRange(const TexMetadata& metadata, size_t firstMip, size_t& mipCount, TexMetadata& subset) noexcept
+    {
+        if (firstMip >= metadata.mipLevels)
+            return false;
+
+        if (!mipCount)
+            mipCount = metadata.mipLevels - firstMip;
+
+        if (firstMip + mipCount > metadata.mipLevels)
+            return false;
+
+        subset = metadata;
+        subset.width     = std::max<size_t>(1u, metadata.width >> firstMip);
+        subset.height    = std::max<size_t>(1u, metadata.height >> firstMip);
+        subset.depth     = std::max<size_t>(1u, metadata.depth >> firstMip);
+        subset.mipLevels = mipCount;
+        return true;
+    }
+
+    // Scatters one level of KTX2 data into the images of 'image' at 'destLevel'
+    bool UnpackLevel(const uint8_t* pSource, size_t size, const ScratchImage& image, size_t destLevel)
+    {
+        const TexMetadata& mdata = image.GetMetadata();
+        size_t offset = 0;
+
+        return ForEachLevelImage(mdata, destLevel, [&](size_t index)
+        {
+            const Image& dest = image.GetImages()[index];
+
+            size_t rowPitch, slicePitch;
+            if (!ComputePitch(dest.format, dest.width, dest.height, rowPitch, slicePitch, CP_FLAGS_NONE)
+                || (slicePitch > size - offset))
+                return false;
+
+            CopyTightRows(dest, pSource + offset);
+            offset += slicePitch;
+            return true;
+        }) && (offset == size);
+    }
+
+    // Expands level 'level' of the file (pSource/size is its stored data) into 'destLevel'
+    bool LoadLevel(const KTX2Index& index, size_t level, const uint8_t* pSource, size_t size, const ScratchImage& image, size_t destLevel)
+    {
+        if (!index.supercompressed)
+            return UnpackLevel(pSource, size, image, destLevel);
+
+        // Never allocate more than the destination level holds
+        uint64_t expected;
+        if (!GetLevelSize(image.GetMetadata(), destLevel, expected) || (index.levels[level].uncompressedByteLength != expected))
+            return false;
+
+        const KTX2_SGD_LEVEL& chunks = index.levelChunks[level];
+        std::vector<uint8_t> raw(static_cast<size_t>(expected));
+
+        return DecompressChunks(index.chunks.data() + chunks.firstChunk, chunks.chunkCount, pSource, size, raw.data(), raw.size())
+            && UnpackLevel(raw.data(), raw.size(), image, destLevel);
+    }
+
+    // Reads the header block, then one contiguous range per requested level
+    bool LoadKTX2File(
+        const char* szFile,
+        size_t firstMip,
+        size_t mipCount,
+        TexMetadata* metadata,
+        ScratchImage& image,
+        bool metadataOnly) noexcept
+    {
+        image.Reset();
+
+        if (!szFile)
+            return false;
+
+        try
+        {
+            std::ifstream inFile{ std::filesystem::path(szFile), std::ios::in | std::ios::binary | std::ios::ate };
+            if (!inFile)
+                return false;
+
+            const auto fileSize = static_cast<uint64_t>(inFile.tellg());
+            if (fileSize < sizeof(KTX2_HEADER))
+                return false;
+
+            std::vector<uint8_t> prefix(sizeof(KTX2_HEADER));
+            inFile.seekg(0);
+            inFile.read(reinterpret_cast<char*>(prefix.data()), sizeof(KTX2_HEADER));
+            if (!inFile)
+                return false;
+
+            const size_t prefixSize = GetKTX2HeaderPrefixSize(prefix.data());
+            if (prefixSize > fileSize)
+                return false;
+
+            prefix.resize(prefixSize);
+            inFile.read(reinterpret_cast<char*>(prefix.data() + sizeof(KTX2_HEADER)), static_cast<std::streamsize>(prefixSize - sizeof(KTX2_HEADER)));
+            if (!inFile)
+                return false;
+
+            TexMetadata mdata;
+            KTX2Index ktxIndex;
+
+            if (!DecodeKTX2Header(prefix.data(), prefix.size(), fileSize, mdata, ktxIndex))
+                return false;
+
+            if (metadata)
+                *metadata = mdata;
+
+            if (metadataOnly)
+                return true;
+
+            TexMetadata subset;
+            if (!GetLevelRange(mdata, firstMip, mipCount, subset))
+                return false;
+
+            bool hr = image.Initialize(subset);
+            if (hr == false)
+                return hr;
+
+            // Each requested level is a single contiguous read located through the level index
+            std::vector<uint8_t> buffer;
+            for (size_t level = 0; level < mipCount; ++level)
+            {
+                const KTX2_LEVEL_INDEX& index = ktxIndex.levels[firstMip + level];
+
+                buffer.resize(static_cast<size_t>(index.byteLength));
+                inFile.seekg(static_cast<std::streamoff>(index.byteOffset));
+                inFile.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+                if (!inFile || !LoadLevel(ktxIndex, firstMip + level, buffer.data(), buffer.size(), image, level))
+                {
+                    image.Release();
+                    return false;
+                }
+            }
+        }
+        catch (...)
+        {
+            image.Release();
+            return false;
+        }
+
+        return true;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Obtain metadata from KTX2 file in memory/on disk
+//-------------------------------------------------------------------------------------
+bool VulkanTex::GetMetadataFromKTX2Memory(
+    const uint8_t* pSource,
+    size_t size,
+    TexMetadata& metadata) noexcept
+{
+    if (!pSource || (size < sizeof(KTX2_HEADER)))
+        return false;
+
+    try
+    {
+        KTX2Index index;
+        return DecodeKTX2Header(pSource, size, size, metadata, index);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool VulkanTex::GetMetadataFromKTX2File(
+    const char* szFile,
+    TexMetadata& metadata) noexcept
+{
+    ScratchImage image;
+    return LoadKTX2File(szFile, 0, 0, &metadata, image, true);
+}
+
+//-------------------------------------------------------------------------------------
+// Load a KTX2 file in memory
+//-------------------------------------------------------------------------------------
+bool VulkanTex::LoadFromKTX2Memory(
+    const uint8_t* pSource,
+    size_t size,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadFromKTX2Memory(pSource, size, 0, 0, metadata, image);
+}
+
+bool VulkanTex::LoadFromKTX2Memory(
+    const uint8_t* pSource,
+    size_t size,
+    size_t firstMip,
+    size_t mipCount,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    image.Reset();
+
+    if (!pSource || (size < sizeof(KTX2_HEADER)))
+        return false;
+
+    try
+    {
+        TexMetadata mdata;
+        KTX2Index ktxIndex;
+
+        if (!DecodeKTX2Header(pSource, size, size, mdata, ktxIndex))
+            return false;
+
+        TexMetadata subset;
+        if (!GetLevelRange(mdata, firstMip, mipCount, subset))
+            return false;
+
+        bool hr = image.Initialize(subset);
+        if (hr == false)
+            return hr;
+
+        // Only the byte ranges of the requested levels are touched (friendly to mapped files)
+        for (size_t level = 0; level < mipCount; ++level)
+        {
+            const KTX2_LEVEL_INDEX& index = ktxIndex.levels[firstMip + level];
+
+            if (!LoadLevel(ktxIndex, firstMip + level, pSource + index.byteOffset, static_cast<size_t>(index.byteLength), image, level))
+            {
+                image.Release();
+                return false;
+            }
+        }
+
+        if (metadata)
+            *metadata = mdata;
+    }
+    catch (...)
+    {
+        image.Release();
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Load a KTX2 file from disk
+//-------------------------------------------------------------------------------------
+bool VulkanTex::LoadFromKTX2File(
+    const char* szFile,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadFromKTX2File(szFile, 0, 0, metadata, image);
+}
+
+bool VulkanTex::LoadFromKTX2File(
+    const char* szFile,
+    size_t firstMip,
+    size_t mipCount,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    return LoadKTX2File(szFile, firstMip, mipCount, metadata, image, false);
+}
+
+//-------------------------------------------------------------------------------------
+// Save a KTX2 file to memory
+//-------------------------------------------------------------------------------------
+bool VulkanTex::SaveToKTX2Memory(const Image& image, KTX2_FLAGS flags, Blob& blob) noexcept
+{
+    TexMetadata mdata = {};
+    mdata.width     = image.width;
+    mdata.height    = image.height;
+    mdata.depth     = 1;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = image.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    return SaveToKTX2Memory(&image, 1, mdata, flags, blob);
+}
+
+bool VulkanTex::SaveToKTX2Memory(
+    const Image* images,
+    size_t nimages,
+    const TexMetadata& metadata,
+    KTX2_FLAGS flags,
+    Blob& blob) noexcept
+{
+    if (!images || !nimages)
+        return false;
+
+    try
+    {
+        KTX2Layout layout;
+        if (!ComputeKTX2Layout(images, nimages, metadata, flags, layout))
+            return false;
+
+        bool hr = blob.Initialize(layout.totalSize);
+        if (hr == false)
+            return hr;
+
+        uint8_t* pDestination = blob.GetBufferPointer();
+        memset(pDestination, 0, layout.totalSize);
+
+        EncodeHeaderBlock(layout, pDestination);
+
+        for (size_t level = 0; level < metadata.mipLevels; ++level)
+        {
+            EncodeLevel(layout, images, metadata, level, pDestination + layout.levels[level].byteOffset);
+        }
+
+        // Blob rounds its allocation up to 16 bytes
+        hr = blob.Trim(layout.totalSize);
+        if (hr == false)
+        {
+            blob.Release();
+            return hr;
+        }
+    }
+    catch (...)
+    {
+        blob.Release();
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Save a KTX2 file to disk
+//-------------------------------------------------------------------------------------
+bool VulkanTex::SaveToKTX2File(const Image& image, KTX2_FLAGS flags, const char* szFile) noexcept
+{
+    TexMetadata mdata = {};
+    mdata.width     = image.width;
+    mdata.height    = image.height;
+    mdata.depth     = 1;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = image.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    return SaveToKTX2File(&image, 1, mdata, flags, szFile);
+}
+
+bool VulkanTex::SaveToKTX2File(
+    const Image* images,
+    size_t nimages,
+    const TexMetadata& metadata,
+    KTX2_FLAGS flags,
+    const char* szFile) noexcept
+{
+    if (!images || !nimages || !szFile)
+        return false;
+
+    try
+    {
+        KTX2Layout layout;
+        if (!ComputeKTX2Layout(images, nimages, metadata, flags, layout))
+            return false;
+
+        std::ofstream outFile{ std::filesystem::path(szFile), std::ios::out | std::ios::binary | std::ios::trunc };
+        if (!outFile)
+            return false;
+
+        std::vector<uint8_t> buffer(GetHeaderBlockSize(layout));
+        EncodeHeaderBlock(layout, buffer.data());
+        outFile.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+        size_t offset = buffer.size();
+
+        // Levels go out in file order, smallest first
+        for (size_t level = metadata.mipLevels; level-- > 0; )
+        {
+            const size_t levelOffset = static_cast<size_t>(layout.levels[level].byteOffset);
+
+            if (levelOffset > offset)
+            {
+                const uint8_t padding[16] = {};
+                outFile.write(reinterpret_cast<const char*>(padding), static_cast<std::streamsize>(levelOffset - offset));
+            }
+
+            buffer.resize(static_cast<size_t>(layout.levels[level].byteLength));
+            EncodeLevel(layout, images, metadata, level, buffer.data());
+
+            outFile.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            offset = levelOffset + buffer.size();
+
+            if (!outFile)
+                return false;
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool VulkanTex::SaveToKTX2Memory(const ImageSetView& images, KTX2_FLAGS flags, Blob& blob) noexcept
+{
+    return SaveToKTX2Memory(images.images, images.nimages, images.metadata, flags, blob);
+}
+
+bool VulkanTex::SaveToKTX2File(const ImageSetView& images, KTX2_FLAGS flags, const char* szFile) noexcept
+{
+    return SaveToKTX2File(images.images, images.nimages, images.metadata, flags, szFile);
+}
@@ -0,0 +1,324 @@
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    bool CopyImageRows(const Image& src, const Image& dest) noexcept
+    {
+        if (!src.pixels || !dest.pixels
+            || (src.width != dest.width) || (src.height != dest.height) || (src.format != dest.format))
+            return false;
+
+        const size_t rowSize = std::min(src.rowPitch, dest.rowPitch);
+        const size_t rows    = ComputeScanlines(src.format, src.height);
+
+        for (size_t y = 0; y < rows; ++y)
+        {
+            memcpy(dest.pixels + y * dest.rowPitch, src.pixels + y * src.rowPitch, rowSize);
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Builds levels [1, mipLevels) of every array item in place, one level at a time.
+    // Rows of all items of a level are filtered in parallel.
+    bool Generate2DMipsFromBase(
+        const ScratchImage& mipChain,
+        FILTER_KERNEL kernel, uint32_t pixelFlags) noexcept
+    {
+        const TexMetadata& metadata = mipChain.GetMetadata();
+        const Image*       images   = mipChain.GetImages();
+
+        FilterTable xTable, yTable;
+
+        for (size_t level = 1; level < metadata.mipLevels; ++level)
+        {
+            const Image* src0  = mipChain.GetImage(level - 1, 0, 0);
+            const Image* dest0 = mipChain.GetImage(level, 0, 0);
+
+            if (!src0 || !dest0)
+                return false;
+
+            if (!BuildFilterTable(kernel, src0->width, dest0->width, xTable)
+                || !BuildFilterTable(kernel, src0->height, dest0->height, yTable))
+                return false;
+
+            const size_t height = dest0->height;
+            std::atomic<bool> failed{ false };
+
+            ParallelFor(metadata.arraySize * height, 8, [&](size_t begin, size_t end) noexcept
+            {
+                while (begin < end)
+                {
+                    const size_t item = begin / height;
+                    const size_t y0   = begin - item * height;
+                    const size_t y1   = std::min(height, y0 + (end - begin));
+
+                    const Image& src  = images[metadata.ComputeIndex(level - 1, item, 0)];
+                    const Image& dest = images[metadata.ComputeIndex(level, item, 0)];
+
+                    if (!ResampleRows(src, dest, xTable, yTable, pixelFlags, y0, y1))
+                    {
+                        failed = true;
+                        return;
+                    }
+
+                    begin += y1 - y0;
+                }
+            });
+
+            if (failed)
+                return false;
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Builds levels [1, mipLevels) of a volume in place, one level at a time.
+    // Each output slice reads only the source slices it covers (two for the default box),
+    // output slices of a level are filtered in parallel.
+    bool Generate3DMipsFromBase(
+        const ScratchImage& mipChain,
+        FILTER_KERNEL kernel, uint32_t pixelFlags) noexcept
+    {
+        const TexMetadata& metadata = mipChain.GetMetadata();
+
+        FilterTable xTable, yTable, zTable;
+
+        size_t srcDepth = metadata.depth;
+
+        for (size_t level = 1; level < metadata.mipLevels; ++level)
+        {
+            const size_t destDepth = (srcDepth > 1) ? (srcDepth >> 1) : 1;
+
+            const Image* srcSlices  = mipChain.GetImage(level - 1, 0, 0);
+            const Image* destSlices = mipChain.GetImage(level, 0, 0);
+
+            if (!srcSlices || !destSlices)
+                return false;
+
+            if (!BuildFilterTable(kernel, srcSlices->width, destSlices->width, xTable)
+                || !BuildFilterTable(kernel, srcSlices->height, destSlices->height, yTable)
+                || !BuildFilterTable(kernel, srcDepth, destDepth, zTable))
+                return false;
+
+            const size_t height = destSlices->height;
+            std::atomic<bool> failed{ false };
+
+            // Work is split along the flattened (slice, row) range, so chunks are whole slices
+            // for deep volumes and still spread across threads once the depth has collapsed
+            ParallelFor(destDepth * height, 8, [&](size_t begin, size_t end) noexcept
+            {
+                while (begin < end)
+                {
+                    const size_t z  = begin / height;
+                    const size_t y0 = begin - z * height;
+                    const size_t y1 = std::min(height, y0 + (end - begin));
+
+                    if (!ResampleVolumeRows(srcSlices, srcDepth, destSlices[z],
+                        xTable, yTable, zTable, z, pixelFlags, y0, y1))
+                    {
+                        failed = true;
+                        return;
+                    }
+
+                    begin += y1 - y0;
+                }
+            });
+
+            if (failed)
+                return false;
+
+            srcDepth = destDepth;
+        }
+
+        return true;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Generate mipmap chain
+//-------------------------------------------------------------------------------------
+bool VulkanTex::GenerateMipMaps(
+    const Image& baseImage,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    ScratchImage& mipChain) noexcept
+{
+    TexMetadata mdata = {};
+    mdata.width     = baseImage.width;
+    mdata.height    = baseImage.height;
+    mdata.depth     = 1;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = baseImage.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    return GenerateMipMaps(&baseImage, 1, mdata, filter, levels, mipChain);
+}
+
+bool VulkanTex::GenerateMipMaps(
+    const ImageSetView& srcImages,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    ScratchImage& mipChain) noexcept
+{
+    return GenerateMipMaps(srcImages.images, srcImages.nimages, srcImages.metadata, filter, levels, mipChain);
+}
+
+bool VulkanTex::GenerateMipMaps(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    ScratchImage& mipChain) noexcept
+{
+    if (!srcImages || !nimages)
+        return false;
+
+    if (metadata.IsVolumemap())
+        return GenerateMipMaps3D(srcImages, nimages, metadata, filter, levels, mipChain);
+
+    if (!IsConvertible(metadata.format))
+        return false;
+
+    if (!CalculateMipLevels(metadata.width, metadata.height, levels))
+        return false;
+
+    FILTER_KERNEL kernel;
+    if (!GetFilterKernel(filter, kernel))
+        return false;
+
+    TexMetadata mdata2 = metadata;
+    mdata2.mipLevels = levels;
+
+    bool hr = mipChain.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    // Top level of each item comes straight from the source; existing lower mips are regenerated
+    for (size_t item = 0; item < metadata.arraySize; ++item)
+    {
+        const size_t srcIndex = metadata.ComputeIndex(0, item, 0);
+        const Image* dest     = mipChain.GetImage(0, item, 0);
+
+        if ((srcIndex >= nimages) || !dest
+            || (srcImages[srcIndex].format != metadata.format)
+            || !CopyImageRows(srcImages[srcIndex], *dest))
+        {
+            mipChain.Release();
+            return false;
+        }
+    }
+
+    if (!Generate2DMipsFromBase(mipChain, kernel, GetFilterPixelFlags(filter, metadata)))
+    {
+        mipChain.Release();
+        return false;
+    }
+
+    return true;
+}
+
+
+//-------------------------------------------------------------------------------------
+// Generate mipmap chain for volume texture
+//-------------------------------------------------------------------------------------
+bool VulkanTex::GenerateMipMaps3D(
+    const Image* baseImages,
+    size_t depth,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    ScratchImage& mipChain) noexcept
+{
+    if (!baseImages || !depth)
+        return false;
+
+    TexMetadata mdata = {};
+    mdata.width     = baseImages[0].width;
+    mdata.height    = baseImages[0].height;
+    mdata.depth     = depth;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = baseImages[0].format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE3D;
+
+    return GenerateMipMaps3D(baseImages, depth, mdata, filter, levels, mipChain);
+}
+
+bool VulkanTex::GenerateMipMaps3D(
+    const ImageSetView& srcImages,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    ScratchImage& mipChain) noexcept
+{
+    return GenerateMipMaps3D(srcImages.images, srcImages.nimages, srcImages.metadata, filter, levels, mipChain);
+}
+
+bool VulkanTex::GenerateMipMaps3D(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    ScratchImage& mipChain) noexcept
+{
+    if (!srcImages || !nimages || !metadata.IsVolumemap())
+        return false;
+
+    if (!IsConvertible(metadata.format))
+        return false;
+
+    if (!CalculateMipLevels3D(metadata.width, metadata.height, metadata.depth, levels))
+        return false;
+
+    FILTER_KERNEL kernel;
+    if (!GetFilterKernel(filter, kernel))
+        return false;
+
+    TexMetadata mdata2 = metadata;
+    mdata2.mipLevels = levels;
+
+    bool hr = mipChain.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    // Top level slices come straight from the source; existing lower mips are regenerated
+    for (size_t slice = 0; slice < metadata.depth; ++slice)
+    {
+        const size_t srcIndex = metadata.ComputeIndex(0, 0, slice);
+        const Image* dest     = mipChain.GetImage(0, 0, slice);
+
+        if ((srcIndex >= nimages) || !dest
+            || (srcImages[srcIndex].format != metadata.format)
+            || !CopyImageRows(srcImages[srcIndex], *dest))
+        {
+            mipChain.Release();
+            return false;
+        }
+    }
+
+    if (!Generate3DMipsFromBase(mipChain, kernel, GetFilterPixelFlags(filter, metadata)))
+    {
+        mipChain.Release();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,503 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    constexpr size_t c_ssimWindow = 8;
+    constexpr size_t c_ssimStride = 4;
+
+    // SSIM stabilizing constants for a dynamic range of 1.0
+    constexpr float c_ssimC1 = 0.01f * 0.01f;
+    constexpr float c_ssimC2 = 0.03f * 0.03f;
+
+    //---------------------------------------------------------------------------------
+    // Per-channel sums, the four lanes of a Float4 are the four channels
+    struct ChannelSums
+    {
+        double value[4];
+        size_t pixels;
+    };
+
+    inline void AccumulateSquaredDiff(Float4& acc, const Float4& a, const Float4& b, const Float4& mask) noexcept
+    {
+#if VULKANTEX_SSE2
+        const __m128 d = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(&a.x), _mm_load_ps(&b.x)), _mm_load_ps(&mask.x));
+        _mm_store_ps(&acc.x, _mm_add_ps(_mm_load_ps(&acc.x), _mm_mul_ps(d, d)));
+#else
+        const float dx = (a.x - b.x) * mask.x;
+        const float dy = (a.y - b.y) * mask.y;
+        const float dz = (a.z - b.z) * mask.z;
+        const float dw = (a.w - b.w) * mask.w;
+        acc.x += dx * dx;
+        acc.y += dy * dy;
+        acc.z += dz * dz;
+        acc.w += dw * dw;
+#endif
+    }
+
+    // Accumulates sum(a), sum(b), sum(a*a), sum(b*b), sum(a*b) for every channel
+    struct WindowMoments
+    {
+        Float4 a;
+        Float4 b;
+        Float4 aa;
+        Float4 bb;
+        Float4 ab;
+    };
+
+    inline void AccumulateMoments(WindowMoments& m, const Float4& a, const Float4& b) noexcept
+    {
+#if VULKANTEX_SSE2
+        const __m128 va = _mm_load_ps(&a.x);
+        const __m128 vb = _mm_load_ps(&b.x);
+        _mm_store_ps(&m.a.x, _mm_add_ps(_mm_load_ps(&m.a.x), va));
+        _mm_store_ps(&m.b.x, _mm_add_ps(_mm_load_ps(&m.b.x), vb));
+        _mm_store_ps(&m.aa.x, _mm_add_ps(_mm_load_ps(&m.aa.x), _mm_mul_ps(va, va)));
+        _mm_store_ps(&m.bb.x, _mm_add_ps(_mm_load_ps(&m.bb.x), _mm_mul_ps(vb, vb)));
+        _mm_store_ps(&m.ab.x, _mm_add_ps(_mm_load_ps(&m.ab.x), _mm_mul_ps(va, vb)));
+#else
+        const float* pa = &a.x;
+        const float* pb = &b.x;
+        for (size_t c = 0; c < 4; ++c)
+        {
+            (&m.a.x)[c]  += pa[c];
+            (&m.b.x)[c]  += pb[c];
+            (&m.aa.x)[c] += pa[c] * pa[c];
+            (&m.bb.x)[c] += pb[c] * pb[c];
+            (&m.ab.x)[c] += pa[c] * pb[c];
+        }
+#endif
+    }
+
+    //---------------------------------------------------------------------------------
+    // Compressed inputs are expanded to a temporary image, everything else is read in place
+    bool GetComparableImage(const Image& image, ScratchImage& temp, const Image*& result) noexcept
+    {
+        if (!image.pixels)
+            return false;
+
+        if (IsCompressed(image.format))
+        {
+            if (!IsASTC(image.format))
+                return false;
+
+            if (!Decompress(image, VK_FORMAT_UNDEFINED, temp))
+                return false;
+
+            result = temp.GetImage(0, 0, 0);
+            return (result != nullptr);
+        }
+
+        if (!IsConvertible(image.format))
+            return false;
+
+        result = &image;
+        return true;
+    }
+
+    struct CompareSource
+    {
+        const Image* image;
+        size_t       rowSize;
+        bool         srgb;
+        bool         bias;
+    };
+
+    CompareSource MakeCompareSource(const Image& image, bool srgbFlag, bool biasFlag) noexcept
+    {
+        CompareSource source = {};
+        source.image   = &image;
+        source.rowSize = (image.width * BitsPerPixel(image.format) + 7) / 8;
+        source.srgb    = srgbFlag || IsSRGB(image.format);
+        source.bias    = biasFlag;
+        return source;
+    }
+
+    bool LoadCompareRow(Float4* row, const CompareSource& source, size_t y) noexcept
+    {
+        const Image& image = *source.image;
+
+        if (!LoadScanline(row, image.width, image.pixels + y * image.rowPitch, source.rowSize, image.format))
+            return false;
+
+        if (source.srgb)
+        {
+            DecodeSRGBRow(row, image.width, image.format);
+        }
+
+        if (source.bias)
+        {
+            for (size_t x = 0; x < image.width; ++x)
+            {
+                row[x].x = row[x].x * 2.f - 1.f;
+                row[x].y = row[x].y * 2.f - 1.f;
+                row[x].z = row[x].z * 2.f - 1.f;
+                row[x].w = row[x].w * 2.f - 1.f;
+            }
+        }
+
+        return true;
+    }
+
+    Float4 GetChannelMask(CMSE_FLAGS flags) noexcept
+    {
+        Float4 mask;
+        mask.x = (flags & CMSE_IGNORE_RED) ? 0.f : 1.f;
+        mask.y = (flags & CMSE_IGNORE_GREEN) ? 0.f : 1.f;
+        mask.z = (flags & CMSE_IGNORE_BLUE) ? 0.f : 1.f;
+        mask.w = (flags & CMSE_IGNORE_ALPHA) ? 0.f : 1.f;
+        return mask;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Sum of squared differences per channel over one pair of images
+    bool SumSquaredDiff(const Image& image1, const Image& image2, CMSE_FLAGS flags, ChannelSums& sums) noexcept
+    {
+        if ((image1.width != image2.width) || (image1.height != image2.height) || !image1.width || !image1.height)
+            return false;
+
+        ScratchImage temp1, temp2;
+        const Image* img1 = nullptr;
+        const Image* img2 = nullptr;
+
+        if (!GetComparableImage(image1, temp1, img1) || !GetComparableImage(image2, temp2, img2))
+            return false;
+
+        const CompareSource source1 = MakeCompareSource(*img1, (flags & CMSE_IMAGE1_SRGB) != 0, (flags & CMSE_IMAGE1_X2_BIAS) != 0);
+        const CompareSource source2 = MakeCompareSource(*img2, (flags & CMSE_IMAGE2_SRGB) != 0, (flags & CMSE_IMAGE2_X2_BIAS) != 0);
+        const Float4 mask = GetChannelMask(flags);
+        const size_t width = img1->width;
+
+        double total[4] = {};
+        std::mutex lock;
+        std::atomic<bool> failed{ false };
+
+        // Rows are reduced into float lanes, bands into doubles, and bands are merged once at the end
+        ParallelFor(img1->height, 16, [&](size_t begin, size_t end) noexcept
+        {
+            std::unique_ptr<Float4[]> row1(new (std::nothrow) Float4[width]);
+            std::unique_ptr<Float4[]> row2(new (std::nothrow) Float4[width]);
+
+            if (!row1 || !row2)
+            {
+                failed = true;
+                return;
+            }
+
+            double band[4] = {};
+
+            for (size_t y = begin; y < end; ++y)
+            {
+                if (!LoadCompareRow(row1.get(), source1, y) || !LoadCompareRow(row2.get(), source2, y))
+                {
+                    failed = true;
+                    return;
+                }
+
+                Float4 acc = { 0.f, 0.f, 0.f, 0.f };
+                for (size_t x = 0; x < width; ++x)
+                {
+                    AccumulateSquaredDiff(acc, row1[x], row2[x], mask);
+                }
+
+                band[0] += acc.x;
+                band[1] += acc.y;
+                band[2] += acc.z;
+                band[3] += acc.w;
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            for (size_t c = 0; c < 4; ++c)
+                total[c] += band[c];
+        });
+
+        if (failed)
+            return false;
+
+        for (size_t c = 0; c < 4; ++c)
+            sums.value[c] += total[c];
+
+        sums.pixels += width * img1->height;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Sum of per-window SSIM over one pair of images
+    bool SumSSIM(const Image& image1, const Image& image2, CMSE_FLAGS flags, double& total, size_t& windows) noexcept
+    {
+        if ((image1.width != image2.width) || (image1.height != image2.height) || !image1.width || !image1.height)
+            return false;
+
+        ScratchImage temp1, temp2;
+        const Image* img1 = nullptr;
+        const Image* img2 = nullptr;
+
+        if (!GetComparableImage(image1, temp1, img1) || !GetComparableImage(image2, temp2, img2))
+            return false;
+
+        const CompareSource source1 = MakeCompareSource(*img1, (flags & CMSE_IMAGE1_SRGB) != 0, (flags & CMSE_IMAGE1_X2_BIAS) != 0);
+        const CompareSource source2 = MakeCompareSource(*img2, (flags & CMSE_IMAGE2_SRGB) != 0, (flags & CMSE_IMAGE2_X2_BIAS) != 0);
+        const Float4 mask = GetChannelMask(flags);
+
+        const float channels = mask.x + mask.y + mask.z + mask.w;
+        if (channels == 0.f)
+            return false;
+
+        const size_t width   = img1->width;
+        const size_t height  = img1->height;
+        const size_t windowW = std::min(width, c_ssimWindow);
+        const size_t windowH = std::min(height, c_ssimWindow);
+        const size_t countX  = (width - windowW) / c_ssimStride + 1;
+        const size_t countY  = (height - windowH) / c_ssimStride + 1;
+        const float  invN    = 1.f / static_cast<float>(windowW * windowH);
+
+        double sum = 0.0;
+        std::mutex lock;
+        std::atomic<bool> failed{ false };
+
+        // Each task owns a band of window rows and loads the rows its windows cover
+        ParallelFor(countY, 4, [&](size_t begin, size_t end) noexcept
+        {
+            std::unique_ptr<Float4[]> rows1(new (std::nothrow) Float4[windowH * width]);
+            std::unique_ptr<Float4[]> rows2(new (std::nothrow) Float4[windowH * width]);
+
+            if (!rows1 || !rows2)
+            {
+                failed = true;
+                return;
+            }
+
+            double band = 0.0;
+
+            for (size_t wy = begin; wy < end; ++wy)
+            {
+                const size_t y0 = wy * c_ssimStride;
+
+                for (size_t r = 0; r < windowH; ++r)
+                {
+                    if (!LoadCompareRow(rows1.get() + r * width, source1, y0 + r)
+                        || !LoadCompareRow(rows2.get() + r * width, source2, y0 + r))
+                    {
+                        failed = true;
+                        return;
+                    }
+                }
+
+                for (size_t wx = 0; wx < countX; ++wx)
+                {
+                    const size_t x0 = wx * c_ssimStride;
+
+                    WindowMoments m = {};
+                    for (size_t r = 0; r < windowH; ++r)
+                    {
+                        const Float4* p1 = rows1.get() + r * width + x0;
+                        const Float4* p2 = rows2.get() + r * width + x0;
+
+                        for (size_t x = 0; x < windowW; ++x)
+                        {
+                            AccumulateMoments(m, p1[x], p2[x]);
+                        }
+                    }
+
+                    float ssim = 0.f;
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        if ((&mask.x)[c] == 0.f)
+                            continue;
+
+                        const float muA   = (&m.a.x)[c] * invN;
+                        const float muB   = (&m.b.x)[c] * invN;
+                        const float varA  = std::max(0.f, (&m.aa.x)[c] * invN - muA * muA);
+                        const float varB  = std::max(0.f, (&m.bb.x)[c] * invN - muB * muB);
+                        const float covAB = (&m.ab.x)[c] * invN - muA * muB;
+
+                        ssim += ((2.f * muA * muB + c_ssimC1) * (2.f * covAB + c_ssimC2))
+                            / ((muA * muA + muB * muB + c_ssimC1) * (varA + varB + c_ssimC2));
+                    }
+
+                    band += static_cast<double>(ssim / channels);
+                }
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            sum += band;
+        });
+
+        if (failed)
+            return false;
+
+        total   += sum;
+        windows += countX * countY;
+        return true;
+    }
+
+    bool IsSameLayout(const ImageSetView& image1, const ImageSetView& image2) noexcept
+    {
+        const TexMetadata& m1 = image1.metadata;
+        const TexMetadata& m2 = image2.metadata;
+
+        return (m1.width == m2.width)
+            && (m1.height == m2.height)
+            && (m1.depth == m2.depth)
+            && (m1.arraySize == m2.arraySize)
+            && (m1.mipLevels == m2.mipLevels)
+            && (m1.dimension == m2.dimension)
+            && (image1.nimages == image2.nimages)
+            && image1.images && image2.images;
+    }
+
+    void FinishMSE(const ChannelSums& sums, CMSE_FLAGS flags, float& mse, float* mseV) noexcept
+    {
+        const Float4 mask = GetChannelMask(flags);
+        const float channels = mask.x + mask.y + mask.z + mask.w;
+
+        double total = 0.0;
+        for (size_t c = 0; c < 4; ++c)
+        {
+            const double value = sums.value[c] / static_cast<double>(sums.pixels);
+            total += value;
+
+            if (mseV)
+                mseV[c] = static_cast<float>(value);
+        }
+
+        mse = (channels > 0.f) ? static_cast<float>(total / channels) : 0.f;
+    }
+
+    float MSEToPSNR(float mse) noexcept
+    {
+        if (mse <= 0.f)
+            return std::numeric_limits<float>::infinity();
+
+        return -10.f * std::log10(mse);
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Mean squared error (averaged over the compared channels)
+//-------------------------------------------------------------------------------------
+bool VulkanTex::ComputeMSE(
+    const Image& image1,
+    const Image& image2,
+    float& mse,
+    float* mseV,
+    CMSE_FLAGS flags) noexcept
+{
+    ChannelSums sums = {};
+    if (!SumSquaredDiff(image1, image2, flags, sums))
+        return false;
+
+    FinishMSE(sums, flags, mse, mseV);
+    return true;
+}
+
+bool VulkanTex::ComputeMSE(
+    const ImageSetView& image1,
+    const ImageSetView& image2,
+    float& mse,
+    float* mseV,
+    CMSE_FLAGS flags) noexcept
+{
+    if (!IsSameLayout(image1, image2))
+        return false;
+
+    ChannelSums sums = {};
+    for (size_t i = 0; i < image1.nimages; ++i)
+    {
+        if (!SumSquaredDiff(image1.images[i], image2.images[i], flags, sums))
+            return false;
+    }
+
+    FinishMSE(sums, flags, mse, mseV);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Peak signal-to-noise ratio in dB (infinite for identical images)
+//-------------------------------------------------------------------------------------
+bool VulkanTex::ComputePSNR(
+    const Image& image1,
+    const Image& image2,
+    float& psnr,
+    CMSE_FLAGS flags) noexcept
+{
+    float mse;
+    if (!ComputeMSE(image1, image2, mse, nullptr, flags))
+        return false;
+
+    psnr = MSEToPSNR(mse);
+    return true;
+}
+
+bool VulkanTex::ComputePSNR(
+    const ImageSetView& image1,
+    const ImageSetView& image2,
+    float& psnr,
+    CMSE_FLAGS flags) noexcept
+{
+    float mse;
+    if (!ComputeMSE(image1, image2, mse, nullptr, flags))
+        return false;
+
+    psnr = MSEToPSNR(mse);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------
+// Structural similarity
+//-------------------------------------------------------------------------------------
+bool VulkanTex::ComputeSSIM(
+    const Image& image1,
+    const Image& image2,
+    float& ssim,
+    CMSE_FLAGS flags) noexcept
+{
+    double total   = 0.0;
+    size_t windows = 0;
+
+    if (!SumSSIM(image1, image2, flags, total, windows) || !windows)
+        return false;
+
+    ssim = static_cast<float>(total / static_cast<double>(windows));
+    return true;
+}
+
+bool VulkanTex::ComputeSSIM(
+    const ImageSetView& image1,
+    const ImageSetView& image2,
+    float& ssim,
+    CMSE_FLAGS flags) noexcept
+{
+    if (!IsSameLayout(image1, image2))
+        return false;
+
+    double total   = 0.0;
+    size_t windows = 0;
+
+    for (size_t i = 0; i < image1.nimages; ++i)
+    {
+        if (!SumSSIM(image1.images[i], image2.images[i], flags, total, windows))
+            return false;
+    }
+
+    if (!windows)
+        return false;
+
+    ssim = static_cast<float>(total / static_cast<double>(windows));
+    return true;
+}
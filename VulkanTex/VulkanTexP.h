@@ -0,0 +1,569 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define VULKANTEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Internal helpers shared by the VulkanTex translation units (not part of the public API)
+namespace VulkanTex
+{
+namespace Internal
+{
+    //---------------------------------------------------------------------------------
+    // ASTC format helpers
+    bool IsASTC(VkFormat fmt) noexcept;
+    bool IsASTCHDR(VkFormat fmt) noexcept;
+    bool GetASTCBlockSize(VkFormat fmt, size_t& blockWidth, size_t& blockHeight) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Scalar half-precision conversion (round-to-nearest-even)
+    inline float HalfToFloat(uint16_t value) noexcept
+    {
+        const uint32_t sign     = static_cast<uint32_t>(value & 0x8000u) << 16;
+        uint32_t       exponent = (value >> 10) & 0x1Fu;
+        uint32_t       mantissa = value & 0x3FFu;
+        uint32_t       result   = 0;
+
+        if (exponent == 0x1Fu)
+        {
+            // Inf / NaN
+            result = sign | 0x7F800000u | (mantissa << 13);
+        }
+        else if (exponent != 0)
+        {
+            result = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+        }
+        else if (mantissa != 0)
+        {
+            // Denormal half, renormalize
+            exponent = 113;
+            while ((mantissa & 0x400u) == 0)
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x3FFu;
+            result = sign | (exponent << 23) | (mantissa << 13);
+        }
+        else
+        {
+            result = sign;
+        }
+
+        float f;
+        memcpy(&f, &result, sizeof(f));
+        return f;
+    }
+
+    inline uint16_t FloatToHalf(float value) noexcept
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+        const uint32_t absBits  = bits & 0x7FFFFFFFu;
+
+        if (absBits >= 0x7F800000u)
+        {
+            // Inf / NaN (keep NaN quiet)
+            return static_cast<uint16_t>(sign | 0x7C00u | ((absBits > 0x7F800000u) ? 0x200u : 0u));
+        }
+
+        if (absBits >= 0x477FF000u)
+        {
+            // Overflows to infinity after rounding
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+
+        if (absBits < 0x38800000u)
+        {
+            // Result is a half denormal (or zero)
+            if (absBits < 0x33000000u)
+                return sign;
+
+            const uint32_t shift    = 113u - (absBits >> 23);
+            const uint32_t mantissa = (absBits & 0x7FFFFFu) | 0x800000u;
+            uint32_t       half     = mantissa >> (shift + 13u);
+            const uint32_t rest     = mantissa & ((1u << (shift + 13u)) - 1u);
+            const uint32_t halfway  = 1u << (shift + 12u);
+
+            if ((rest > halfway) || ((rest == halfway) && (half & 1u)))
+                ++half;
+
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        uint32_t half = ((absBits - 0x38000000u) >> 13);
+        const uint32_t rest = absBits & 0x1FFFu;
+
+        if ((rest > 0x1000u) || ((rest == 0x1000u) && (half & 1u)))
+            ++half;
+
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // Bulk conversion, F16C / NEON when the CPU has it (chosen at runtime), scalar otherwise
+    void HalfToFloatRow(float* pDestination, const uint16_t* pSource, size_t count) noexcept;
+    void FloatToHalfRow(uint16_t* pDestination, const float* pSource, size_t count) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Scalar sRGB transfer functions
+    inline float SRGBToLinear(float value) noexcept
+    {
+        if (value <= 0.04045f)
+            return value * (1.f / 12.92f);
+
+        return std::pow((value + 0.055f) * (1.f / 1.055f), 2.4f);
+    }
+
+    inline float LinearToSRGB(float value) noexcept
+    {
+        if (value <= 0.0031308f)
+            return std::max(value, 0.f) * 12.92f;
+
+        return 1.055f * std::pow(std::min(value, 1.f), 1.f / 2.4f) - 0.055f;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Wide intermediate pixel (r, g, b, a) used by the conversion / filtering code
+    struct alignas(16) Float4
+    {
+        float x;
+        float y;
+        float z;
+        float w;
+    };
+
+    // Returns true if the format has a scanline load/store kernel
+    bool IsConvertible(VkFormat fmt) noexcept;
+
+    // Expands 'count' pixels of a row to Float4 (missing channels are 0, missing alpha is 1).
+    // Integer formats load their raw values, _SRGB formats are not linearized.
+    bool LoadScanline(
+        Float4* pDestination, size_t count,
+        const uint8_t* pSource, size_t size, VkFormat format) noexcept;
+
+    // Packs 'count' Float4 pixels into a row of 'format' with saturation and rounding.
+    bool StoreScanline(
+        uint8_t* pDestination, size_t size, VkFormat format,
+        const Float4* pSource, size_t count, float threshold = 0.5f) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Bulk sRGB transfer on color channels (alpha untouched). 'format' is the layout the row
+    // was loaded from / will be stored to: 8-bit layouts decode through a table and encode to
+    // the correctly rounded code, 16-bit UNORM decodes through an interpolated table.
+    void DecodeSRGBRow(Float4* pixels, size_t count, VkFormat format) noexcept;
+    void EncodeSRGBRow(Float4* pixels, size_t count, VkFormat format) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Separable resampling
+    enum FILTER_KERNEL : uint32_t
+    {
+        FILTER_KERNEL_POINT,
+        FILTER_KERNEL_BOX,
+        FILTER_KERNEL_LINEAR,
+        FILTER_KERNEL_CUBIC,    // Catmull-Rom
+        FILTER_KERNEL_KAISER,   // Kaiser-windowed sinc, radius 3
+    };
+
+    enum FILTER_PIXEL_FLAGS : uint32_t
+    {
+        FILTER_PIXEL_DEFAULT = 0x0,
+        FILTER_PIXEL_SRGB_IN = 0x1,         // Linearize after load
+        FILTER_PIXEL_SRGB_OUT = 0x2,        // Encode before store
+        FILTER_PIXEL_ALPHA_WEIGHTED = 0x4,  // Weight color by straight alpha while filtering
+    };
+
+    // Source taps for every destination coordinate along one axis.
+    // Taps of destination 'i' are [first[i], first[i + 1]) in index/weight (weights sum to 1).
+    struct FilterTable
+    {
+        std::vector<uint32_t> first;
+        std::vector<uint32_t> index;
+        std::vector<float>    weight;
+        size_t                maxTaps;
+    };
+
+    bool GetFilterKernel(TEX_FILTER_FLAGS filter, FILTER_KERNEL& kernel) noexcept;
+    uint32_t GetFilterPixelFlags(TEX_FILTER_FLAGS filter, const TexMetadata& metadata) noexcept;
+
+    // Applies FILTER_PIXEL_* after LoadScanline / before StoreScanline ('format' is the row's format)
+    void PrepareSourceRow(Float4* pixels, size_t count, VkFormat format, uint32_t pixelFlags) noexcept;
+    void FinishDestinationRow(Float4* pixels, size_t count, VkFormat format, uint32_t pixelFlags) noexcept;
+
+    bool BuildFilterTable(FILTER_KERNEL kernel, size_t srcSize, size_t destSize, FilterTable& table) noexcept;
+
+    // Filters rows [rowBegin, rowEnd) of 'dest' from 'src' (both must be convertible formats)
+    bool ResampleRows(
+        const Image& src, const Image& dest,
+        const FilterTable& xTable, const FilterTable& yTable,
+        uint32_t pixelFlags, size_t rowBegin, size_t rowEnd) noexcept;
+
+    // Filters rows [rowBegin, rowEnd) of output slice 'z' of a volume level from the slices of the level above.
+    // Only the source slices referenced by zTable[z] are read.
+    bool ResampleVolumeRows(
+        const Image* srcSlices, size_t srcDepth, const Image& dest,
+        const FilterTable& xTable, const FilterTable& yTable, const FilterTable& zTable,
+        size_t z, uint32_t pixelFlags, size_t rowBegin, size_t rowEnd) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Cubemap faces (order +X, -X, +Y, -Y, +Z, -Z)
+    // Texel (x, y) of an n x n face sits at s = 2 * (x + 0.5) / n - 1, t = 2 * (y + 0.5) / n - 1
+    // and looks along s * axes[0] + t * axes[1] + axes[2] (not normalized).
+    inline constexpr float c_cubeFaceAxes[6][3][3] =
+    {
+        { {  0.f,  0.f, -1.f }, { 0.f, -1.f,  0.f }, {  1.f,  0.f,  0.f } },
+        { {  0.f,  0.f,  1.f }, { 0.f, -1.f,  0.f }, { -1.f,  0.f,  0.f } },
+        { {  1.f,  0.f,  0.f }, { 0.f,  0.f,  1.f }, {  0.f,  1.f,  0.f } },
+        { {  1.f,  0.f,  0.f }, { 0.f,  0.f, -1.f }, {  0.f, -1.f,  0.f } },
+        { {  1.f,  0.f,  0.f }, { 0.f, -1.f,  0.f }, {  0.f,  0.f,  1.f } },
+        { { -1.f,  0.f,  0.f }, { 0.f, -1.f,  0.f }, {  0.f,  0.f, -1.f } },
+    };
+
+    // Face hit by direction (x, y, z) and the s, t position on it
+    inline size_t GetCubeFaceCoords(float x, float y, float z, float& s, float& t) noexcept
+    {
+        const float ax = std::abs(x);
+        const float ay = std::abs(y);
+        const float az = std::abs(z);
+
+        size_t face;
+        float  major;
+
+        if ((ax >= ay) && (ax >= az))
+        {
+            face  = (x >= 0.f) ? 0 : 1;
+            major = ax;
+        }
+        else if (ay >= az)
+        {
+            face  = (y >= 0.f) ? 2 : 3;
+            major = ay;
+        }
+        else
+        {
+            face  = (z >= 0.f) ? 4 : 5;
+            major = az;
+        }
+
+        // The axes are orthonormal, so projecting onto them inverts the face mapping
+        const float (&axes)[3][3] = c_cubeFaceAxes[face];
+        const float inv = (major > 0.f) ? (1.f / major) : 0.f;
+        s = (x * axes[0][0] + y * axes[0][1] + z * axes[0][2]) * inv;
+        t = (x * axes[1][0] + y * axes[1][1] + z * axes[1][2]) * inv;
+        return face;
+    }
+
+    // Linear Float4 copy of a sampled image
+    struct FloatPlane
+    {
+        std::unique_ptr<Float4[]> pixels;
+        size_t                    width;
+        size_t                    height;
+    };
+
+    // Loads the image and applies PrepareSourceRow(pixelFlags) to every row
+    bool ExpandImage(const Image& image, uint32_t pixelFlags, FloatPlane& plane) noexcept;
+
+    // Sampling; (px, py) are in texels with centers at integer + 0.5
+    inline size_t WrapCoord(ptrdiff_t value, size_t size) noexcept
+    {
+        const ptrdiff_t n = static_cast<ptrdiff_t>(size);
+        value %= n;
+        return static_cast<size_t>((value < 0) ? value + n : value);
+    }
+
+    inline size_t ClampCoord(ptrdiff_t value, size_t size) noexcept
+    {
+        return static_cast<size_t>(std::min<ptrdiff_t>(std::max<ptrdiff_t>(value, 0), static_cast<ptrdiff_t>(size) - 1));
+    }
+
+    inline Float4 SamplePoint(const FloatPlane& plane, float px, float py, bool wrapX) noexcept
+    {
+        const ptrdiff_t ix = static_cast<ptrdiff_t>(std::floor(px));
+        const ptrdiff_t iy = static_cast<ptrdiff_t>(std::floor(py));
+
+        const size_t x = wrapX ? WrapCoord(ix, plane.width) : ClampCoord(ix, plane.width);
+        const size_t y = ClampCoord(iy, plane.height);
+        return plane.pixels[y * plane.width + x];
+    }
+
+    inline Float4 SampleBilinear(const FloatPlane& plane, float px, float py, bool wrapX) noexcept
+    {
+        const float fx = px - 0.5f;
+        const float fy = py - 0.5f;
+        const float x0f = std::floor(fx);
+        const float y0f = std::floor(fy);
+        const float tx = fx - x0f;
+        const float ty = fy - y0f;
+
+        const ptrdiff_t ix = static_cast<ptrdiff_t>(x0f);
+        const ptrdiff_t iy = static_cast<ptrdiff_t>(y0f);
+
+        const size_t x0 = wrapX ? WrapCoord(ix, plane.width) : ClampCoord(ix, plane.width);
+        const size_t x1 = wrapX ? WrapCoord(ix + 1, plane.width) : ClampCoord(ix + 1, plane.width);
+        const Float4* row0 = plane.pixels.get() + ClampCoord(iy, plane.height) * plane.width;
+        const Float4* row1 = plane.pixels.get() + ClampCoord(iy + 1, plane.height) * plane.width;
+
+        Float4 result;
+
+#if VULKANTEX_SSE2
+        const __m128 a = _mm_load_ps(&row0[x0].x);
+        const __m128 b = _mm_load_ps(&row0[x1].x);
+        const __m128 c = _mm_load_ps(&row1[x0].x);
+        const __m128 d = _mm_load_ps(&row1[x1].x);
+        const __m128 wx = _mm_set1_ps(tx);
+
+        const __m128 top    = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), wx));
+        const __m128 bottom = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(d, c), wx));
+        _mm_store_ps(&result.x, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(ty))));
+#else
+        const float* a = &row0[x0].x;
+        const float* b = &row0[x1].x;
+        const float* c = &row1[x0].x;
+        const float* d = &row1[x1].x;
+        float* out = &result.x;
+
+        for (size_t ch = 0; ch < 4; ++ch)
+        {
+            const float top    = a[ch] + (b[ch] - a[ch]) * tx;
+            const float bottom = c[ch] + (d[ch] - c[ch]) * tx;
+            out[ch] = top + (bottom - top) * ty;
+        }
+#endif
+
+        return result;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Metadata read from a file (KTX2, archive, delta): the ScratchImage::Initialize shape rules,
+    // a mip count within the full chain and the Direct3D 11 size / array limits of DecodeDDSHeader
+    bool ValidateFileMetadata(const TexMetadata& metadata) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Images over the mapped data of a captured resource (no copy), in TexMetadata::ComputeIndex order.
+    // Subresources are tightly packed, rows use the ComputePitch pitch of their level.
+    bool GetCapturedImages(
+        const CapturedResourceInfo& capturedResourceInfo,
+        TexMetadata& metadata, std::vector<Image>& images) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Lossless supercompression (LZ4 block format, optionally on byte-shuffled texels)
+    enum SUPERCOMPRESS_MODE : uint32_t
+    {
+        SUPERCOMPRESS_NONE = 0,
+        SUPERCOMPRESS_FAST = 1,     // Greedy matching
+        SUPERCOMPRESS_HIGH = 2,     // Hash chains with lazy matching, tries shuffled and plain input
+    };
+
+    enum CHUNK_CODEC : uint16_t
+    {
+        CHUNK_STORED = 0,
+        CHUNK_LZ = 1,
+        CHUNK_LZ_SHUFFLE = 2,
+    };
+
+    // Index entry of one independently decodable chunk (whole rows of one subresource)
+    struct CompressedChunk
+    {
+        uint64_t offset;        // Relative to the start of the payload
+        uint32_t size;
+        uint32_t rawSize;
+        uint16_t codec;         // CHUNK_CODEC
+        uint16_t elementSize;   // Shuffle stride of CHUNK_LZ_SHUFFLE
+        uint32_t image;         // Index of the subresource in the order given to CompressImages
+    };
+
+    // Compresses the tightly packed rows of images[0..nimages) in parallel.
+    // Chunks are ordered by image, then by row.
+    bool CompressImages(
+        const Image* images, size_t nimages, SUPERCOMPRESS_MODE mode,
+        std::vector<CompressedChunk>& chunks, std::vector<uint8_t>& payload) noexcept;
+
+    // Decodes chunk.rawSize bytes to pDestination (pSource/size is the payload)
+    bool DecompressChunk(
+        const CompressedChunk& chunk, const uint8_t* pSource, size_t size,
+        uint8_t* pDestination) noexcept;
+
+    // Decodes 'count' chunks back to back in parallel, destSize must be the sum of their raw sizes
+    bool DecompressChunks(
+        const CompressedChunk* chunks, size_t count, const uint8_t* pSource, size_t size,
+        uint8_t* pDestination, size_t destSize) noexcept;
+
+    // 'VTSC' container: DDS header bytes, chunk index and the compressed subresources in DDS order
+    bool SaveSupercompressedDDS(
+        const Image* images, size_t nimages, const TexMetadata& metadata,
+        DDS_FLAGS flags, Blob& blob) noexcept;
+
+    // Locates the plain DDS header (magic, DDS_HEADER [+ DX10]) stored in a 'VTSC' container
+    bool GetSupercompressedDDSHeader(
+        const uint8_t* pSource, size_t size,
+        const uint8_t*& pHeader, size_t& headerSize) noexcept;
+
+    // Chunk table of a 'VTSC' container, checked once against the payload layout of its DDS header
+    struct SupercompressedDDSIndex
+    {
+        std::vector<CompressedChunk> chunks;
+        std::vector<size_t>          firstChunk;    // Chunks of subresource i: [firstChunk[i], firstChunk[i + 1])
+        const uint8_t*               pPayload;
+        size_t                       payloadSize;
+    };
+
+    // 'headerSize' and 'offsets' are the DecodeDDSHeader size and ComputeDDSLayout offsets
+    bool DecodeSupercompressedDDS(
+        const uint8_t* pSource, size_t size, size_t headerSize,
+        const std::vector<uint64_t>& offsets, SupercompressedDDSIndex& index) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Save instrumentation (see SaveTraceScope)
+    inline thread_local const SaveTraceScope* t_saveTraceScope = nullptr;
+
+    uint64_t GetTraceTimestamp() noexcept;
+
+    // Reports one phase on destruction, costs a thread-local load when no scope is installed
+    class SavePhaseTimer
+    {
+    public:
+        explicit SavePhaseTimer(SAVE_PHASE phase, uint64_t bytes = 0) noexcept :
+            m_scope(t_saveTraceScope),
+            m_phase(phase),
+            m_bytes(bytes),
+            m_start(m_scope ? GetTraceTimestamp() : 0)
+        {
+        }
+
+        ~SavePhaseTimer() { Finish(); }
+
+        SavePhaseTimer(const SavePhaseTimer&) = delete;
+        SavePhaseTimer& operator=(const SavePhaseTimer&) = delete;
+
+        void AddBytes(uint64_t bytes) noexcept { m_bytes += bytes; }
+
+        // Ends the phase before the end of the enclosing scope
+        void Finish() noexcept
+        {
+            if (m_scope)
+            {
+                m_scope->Record(m_phase, m_start, GetTraceTimestamp() - m_start, m_bytes);
+                m_scope = nullptr;
+            }
+        }
+
+    private:
+        const SaveTraceScope* m_scope;
+        SAVE_PHASE            m_phase;
+        uint64_t              m_bytes;
+        uint64_t              m_start;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Parallel loop helper
+    inline thread_local size_t t_maxWorkers = 0;   // See ParallelismScope
+
+    inline size_t GetWorkerCount() noexcept
+    {
+        const unsigned int count = std::thread::hardware_concurrency();
+        const size_t workers = (count > 0) ? static_cast<size_t>(count) : 1u;
+        return t_maxWorkers ? std::min(workers, t_maxWorkers) : workers;
+    }
+
+    // Calls fn(begin, end) over [0, count) in chunks of at least 'grain' items.
+    // Chunks are handed out dynamically to the calling thread plus up to GetWorkerCount() - 1 helpers.
+    template<typename Fn>
+    void ParallelFor(size_t count, size_t grain, Fn&& fn) noexcept
+    {
+        if (!count)
+            return;
+
+        grain = std::max<size_t>(grain, 1u);
+
+        const size_t workers = GetWorkerCount();
+        const size_t chunks  = (count + grain - 1) / grain;
+
+        if ((workers <= 1) || (chunks <= 1))
+        {
+            fn(size_t(0), count);
+            return;
+        }
+
+        // Oversubscribe chunks a little so uneven rows balance out
+        const size_t taskCount = std::min<size_t>(chunks, workers * 4);
+        const size_t taskSize  = (count + taskCount - 1) / taskCount;
+
+        std::atomic<size_t> next{ 0 };
+
+        auto worker = [&]() noexcept
+        {
+            for (;;)
+            {
+                const size_t task = next.fetch_add(1, std::memory_order_relaxed);
+                const size_t begin = task * taskSize;
+
+                if (begin >= count)
+                    break;
+
+                fn(begin, std::min<size_t>(begin + taskSize, count));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        const size_t helperCount = std::min<size_t>(workers, taskCount) - 1;
+
+        try
+        {
+            threads.reserve(helperCount);
+
+            for (size_t i = 0; i < helperCount; ++i)
+            {
+                threads.emplace_back(worker);
+            }
+        }
+        catch (...)
+        {
+            // Fewer helpers than requested, the calling thread picks up the remaining work
+        }
+
+        worker();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Batched positional file I/O (see IOBackendScope)
+    inline thread_local IO_BACKEND t_ioBackend = IO_BACKEND_DEFAULT;
+
+    struct IORequest
+    {
+        uint64_t offset;
+        uint8_t* buffer;    // Only read from for writes
+        size_t   size;
+    };
+
+#if !_WIN32
+    // Transfers every request against 'fd' with the calling thread's backend, false if any span
+    // failed or came up short. Requests may complete in any order.
+    bool ReadBatch(int fd, const IORequest* requests, size_t count) noexcept;
+    bool WriteBatch(int fd, const IORequest* requests, size_t count) noexcept;
+
+    // Staging memory registered with the calling thread's io_uring instance; spans placed in it
+    // use the fixed-buffer opcodes. Returns nullptr (size 0) for the other backends.
+    uint8_t* GetIOStaging(size_t& size) noexcept;
+#endif
+} // namespace Internal
+} // namespace VulkanTex
@@ -0,0 +1,555 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    enum PMALPHA_PATH : uint32_t
+    {
+        PMALPHA_PATH_RGBA8,         // 8-bit UNORM with alpha in the fourth byte, exact integer math
+        PMALPHA_PATH_RGBA8_SRGB,    // Same layout with sRGB color, (alpha, color) tables
+        PMALPHA_PATH_RGBA16,        // R16G16B16A16_UNORM, exact integer math
+        PMALPHA_PATH_RGBA32F,       // R32G32B32A32_SFLOAT
+        PMALPHA_PATH_FLOAT4,        // Any other format through LoadScanline / StoreScanline
+    };
+
+    struct PMAlphaPlan
+    {
+        PMALPHA_PATH path;
+        bool         srgb;          // Scale color in linear space
+        bool         reverse;       // Unpremultiply
+    };
+
+    PMAlphaPlan PlanPMAlpha(VkFormat format, TEX_PMALPHA_FLAGS flags, bool reverse) noexcept
+    {
+        PMAlphaPlan plan = {};
+        plan.srgb    = !(flags & TEX_PMALPHA_IGNORE_SRGB) && (IsSRGB(format) || (flags & TEX_PMALPHA_SRGB));
+        plan.reverse = reverse;
+
+        switch (format)
+        {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+            case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+            case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+                plan.path = plan.srgb ? PMALPHA_PATH_RGBA8_SRGB : PMALPHA_PATH_RGBA8;
+                break;
+
+            case VK_FORMAT_R16G16B16A16_UNORM:
+                plan.path = plan.srgb ? PMALPHA_PATH_FLOAT4 : PMALPHA_PATH_RGBA16;
+                break;
+
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+                plan.path = plan.srgb ? PMALPHA_PATH_FLOAT4 : PMALPHA_PATH_RGBA32F;
+                break;
+
+            default:
+                plan.path = PMALPHA_PATH_FLOAT4;
+                break;
+        }
+
+        return plan;
+    }
+
+    //---------------------------------------------------------------------------------
+    // 8-bit kernels
+    //---------------------------------------------------------------------------------
+
+    // Exact round(c * a / 255)
+    inline uint32_t MulDiv255(uint32_t c, uint32_t a) noexcept
+    {
+        const uint32_t t = c * a + 128u;
+        return (t + (t >> 8)) >> 8;
+    }
+
+    void PremultiplyRGBA8(uint8_t* pDestination, const uint8_t* pSource, size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if VULKANTEX_SSE2
+        // Two pixels per register as 16-bit lanes, the same rounding as MulDiv255
+        const __m128i zero      = _mm_setzero_si128();
+        const __m128i bias      = _mm_set1_epi16(128);
+        const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+        auto scale = [&](__m128i px) noexcept
+        {
+            const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, 0xFF), 0xFF);
+            __m128i t = _mm_add_epi16(_mm_mullo_epi16(px, alpha), bias);
+            t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            return _mm_or_si128(_mm_andnot_si128(alphaMask, t), _mm_and_si128(alphaMask, px));
+        };
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i * 4));
+            const __m128i lo = scale(_mm_unpacklo_epi8(v, zero));
+            const __m128i hi = scale(_mm_unpackhi_epi8(v, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i * 4), _mm_packus_epi16(lo, hi));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const uint8_t* s = pSource + i * 4;
+            uint8_t* d = pDestination + i * 4;
+            const uint32_t a = s[3];
+
+            d[0] = static_cast<uint8_t>(MulDiv255(s[0], a));
+            d[1] = static_cast<uint8_t>(MulDiv255(s[1], a));
+            d[2] = static_cast<uint8_t>(MulDiv255(s[2], a));
+            d[3] = s[3];
+        }
+    }
+
+    // ceil(2^40 / a); round(c * 255 / a) == ((510 * c + a) * value[a]) >> 41 for every 8-bit c and a
+    struct ReciprocalTable
+    {
+        uint64_t value[256];
+
+        ReciprocalTable() noexcept
+        {
+            value[0] = 0;
+            for (uint64_t a = 1; a < 256; ++a)
+            {
+                value[a] = ((uint64_t(1) << 40) + a - 1) / a;
+            }
+        }
+    };
+
+    const ReciprocalTable& GetReciprocalTable() noexcept
+    {
+        static const ReciprocalTable s_table;
+        return s_table;
+    }
+
+    inline uint8_t DivideByAlpha(uint32_t c, uint32_t a, uint64_t reciprocal) noexcept
+    {
+        const uint64_t q = ((510u * c + a) * reciprocal) >> 41;
+        return static_cast<uint8_t>(std::min<uint64_t>(q, 255u));
+    }
+
+    void UnpremultiplyRGBA8(uint8_t* pDestination, const uint8_t* pSource, size_t count) noexcept
+    {
+        const uint64_t* reciprocal = GetReciprocalTable().value;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t* s = pSource + i * 4;
+            uint8_t* d = pDestination + i * 4;
+            const uint32_t a = s[3];
+
+            if (!a)
+            {
+                memcpy(d, s, 4);
+                continue;
+            }
+
+            const uint64_t r = reciprocal[a];
+            d[0] = DivideByAlpha(s[0], a, r);
+            d[1] = DivideByAlpha(s[1], a, r);
+            d[2] = DivideByAlpha(s[2], a, r);
+            d[3] = s[3];
+        }
+    }
+
+    // Encoded result for every (alpha, encoded color) pair, scaling in linear space
+    struct SRGBAlphaTable
+    {
+        uint8_t value[256][256];
+
+        explicit SRGBAlphaTable(bool reverse) noexcept
+        {
+            Float4 decoded[256];
+            for (size_t c = 0; c < 256; ++c)
+            {
+                decoded[c] = { static_cast<float>(c) / 255.f, 0.f, 0.f, 1.f };
+            }
+            DecodeSRGBRow(decoded, 256, VK_FORMAT_R8_SRGB);
+
+            Float4 row[256] = {};
+            for (size_t a = 0; a < 256; ++a)
+            {
+                const float alpha = static_cast<float>(a) / 255.f;
+                for (size_t c = 0; c < 256; ++c)
+                {
+                    const float linear = decoded[c].x;
+                    row[c].x = reverse ? ((a != 0) ? std::min(linear / alpha, 1.f) : linear) : linear * alpha;
+                }
+                EncodeSRGBRow(row, 256, VK_FORMAT_R8_SRGB);
+
+                for (size_t c = 0; c < 256; ++c)
+                {
+                    value[a][c] = static_cast<uint8_t>(row[c].x * 255.f + 0.5f);
+                }
+            }
+        }
+    };
+
+    const SRGBAlphaTable& GetSRGBAlphaTable(bool reverse) noexcept
+    {
+        if (reverse)
+        {
+            static const SRGBAlphaTable s_unpremultiply(true);
+            return s_unpremultiply;
+        }
+
+        static const SRGBAlphaTable s_premultiply(false);
+        return s_premultiply;
+    }
+
+    void ScaleRGBA8SRGB(uint8_t* pDestination, const uint8_t* pSource, size_t count, const SRGBAlphaTable& table) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t* s = pSource + i * 4;
+            uint8_t* d = pDestination + i * 4;
+            const uint8_t* row = table.value[s[3]];
+
+            d[0] = row[s[0]];
+            d[1] = row[s[1]];
+            d[2] = row[s[2]];
+            d[3] = s[3];
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // 16-bit kernels
+    //---------------------------------------------------------------------------------
+    void PremultiplyRGBA16(uint16_t* pDestination, const uint16_t* pSource, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint16_t* s = pSource + i * 4;
+            uint16_t* d = pDestination + i * 4;
+            const uint32_t a = s[3];
+
+            d[0] = static_cast<uint16_t>((s[0] * a + 32767u) / 65535u);
+            d[1] = static_cast<uint16_t>((s[1] * a + 32767u) / 65535u);
+            d[2] = static_cast<uint16_t>((s[2] * a + 32767u) / 65535u);
+            d[3] = s[3];
+        }
+    }
+
+    void UnpremultiplyRGBA16(uint16_t* pDestination, const uint16_t* pSource, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint16_t* s = pSource + i * 4;
+            uint16_t* d = pDestination + i * 4;
+            const uint32_t a = s[3];
+
+            if (!a)
+            {
+                memcpy(d, s, 8);
+                continue;
+            }
+
+            d[0] = static_cast<uint16_t>(std::min<uint32_t>((s[0] * 65535u + a / 2u) / a, 65535u));
+            d[1] = static_cast<uint16_t>(std::min<uint32_t>((s[1] * 65535u + a / 2u) / a, 65535u));
+            d[2] = static_cast<uint16_t>(std::min<uint32_t>((s[2] * 65535u + a / 2u) / a, 65535u));
+            d[3] = s[3];
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Float kernels (RGBA, 4 floats per pixel; source and destination may alias)
+    //---------------------------------------------------------------------------------
+    void ScaleFloatRGBA(float* pDestination, const float* pSource, size_t count, bool reverse) noexcept
+    {
+        size_t i = 0;
+
+#if VULKANTEX_SSE2
+        const __m128 colorMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        const __m128 zero      = _mm_setzero_ps();
+
+        for (; i < count; ++i)
+        {
+            const __m128 v = _mm_loadu_ps(pSource + i * 4);
+            const __m128 alpha = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128 scaled;
+            __m128 select = colorMask;
+            if (reverse)
+            {
+                // Zero (or negative) alpha keeps the color
+                scaled = _mm_div_ps(v, alpha);
+                select = _mm_and_ps(select, _mm_cmpgt_ps(alpha, zero));
+            }
+            else
+            {
+                scaled = _mm_mul_ps(v, alpha);
+            }
+
+            _mm_storeu_ps(pDestination + i * 4, _mm_or_ps(_mm_and_ps(select, scaled), _mm_andnot_ps(select, v)));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const float* s = pSource + i * 4;
+            float* d = pDestination + i * 4;
+            const float a = s[3];
+
+            if (reverse && !(a > 0.f))
+            {
+                memmove(d, s, 4 * sizeof(float));
+                continue;
+            }
+
+            const float scale = reverse ? 1.f / a : a;
+            d[0] = s[0] * scale;
+            d[1] = s[1] * scale;
+            d[2] = s[2] * scale;
+            d[3] = a;
+        }
+    }
+
+    bool ProcessRow(
+        const PMAlphaPlan& plan, VkFormat format,
+        const uint8_t* pSource, uint8_t* pDestination, size_t rowSize,
+        size_t width, Float4* scanline) noexcept
+    {
+        switch (plan.path)
+        {
+            case PMALPHA_PATH_RGBA8:
+                if (plan.reverse)
+                    UnpremultiplyRGBA8(pDestination, pSource, width);
+                else
+                    PremultiplyRGBA8(pDestination, pSource, width);
+                return true;
+
+            case PMALPHA_PATH_RGBA8_SRGB:
+                ScaleRGBA8SRGB(pDestination, pSource, width, GetSRGBAlphaTable(plan.reverse));
+                return true;
+
+            case PMALPHA_PATH_RGBA16:
+                if (plan.reverse)
+                    UnpremultiplyRGBA16(reinterpret_cast<uint16_t*>(pDestination), reinterpret_cast<const uint16_t*>(pSource), width);
+                else
+                    PremultiplyRGBA16(reinterpret_cast<uint16_t*>(pDestination), reinterpret_cast<const uint16_t*>(pSource), width);
+                return true;
+
+            case PMALPHA_PATH_RGBA32F:
+                ScaleFloatRGBA(reinterpret_cast<float*>(pDestination), reinterpret_cast<const float*>(pSource), width, plan.reverse);
+                return true;
+
+            default:
+                break;
+        }
+
+        if (!LoadScanline(scanline, width, pSource, rowSize, format))
+            return false;
+
+        if (plan.srgb)
+        {
+            DecodeSRGBRow(scanline, width, format);
+        }
+
+        ScaleFloatRGBA(&scanline->x, &scanline->x, width, plan.reverse);
+
+        if (plan.srgb)
+        {
+            EncodeSRGBRow(scanline, width, format);
+        }
+
+        return StoreScanline(pDestination, rowSize, format, scanline, width);
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Premultiplies (or unpremultiplies) every subresource, one work item per row
+    //-------------------------------------------------------------------------------------
+    bool ScaleByAlpha(
+        const Image* srcImages,
+        size_t nimages,
+        const TexMetadata& metadata,
+        TEX_PMALPHA_FLAGS flags,
+        bool reverse,
+        ScratchImage& result) noexcept
+    {
+        if (!srcImages || !nimages)
+            return false;
+
+        if (IsCompressed(metadata.format) || !HasAlpha(metadata.format) || !IsConvertible(metadata.format))
+            return false;
+
+        if (metadata.GetAlphaMode() == (reverse ? TEX_ALPHA_MODE_STRAIGHT : TEX_ALPHA_MODE_PREMULTIPLIED))
+            return false;
+
+        TexMetadata mdata2 = metadata;
+        mdata2.SetAlphaMode(reverse ? TEX_ALPHA_MODE_STRAIGHT : TEX_ALPHA_MODE_PREMULTIPLIED);
+
+        bool hr = result.Initialize(mdata2);
+        if (hr == false)
+            return hr;
+
+        const Image* dest = result.GetImages();
+        if (!dest || (nimages != result.GetImageCount()))
+        {
+            result.Release();
+            return false;
+        }
+
+        std::vector<size_t> rowStart;
+
+        try
+        {
+            rowStart.resize(nimages + 1);
+        }
+        catch (...)
+        {
+            result.Release();
+            return false;
+        }
+
+        rowStart[0] = 0;
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            const Image& src = srcImages[index];
+
+            if ((src.format != metadata.format) || !src.pixels
+                || (src.width != dest[index].width) || (src.height != dest[index].height))
+            {
+                result.Release();
+                return false;
+            }
+
+            rowStart[index + 1] = rowStart[index] + src.height;
+        }
+
+        const PMAlphaPlan plan = PlanPMAlpha(metadata.format, flags, reverse);
+        const size_t pixelBits = BitsPerPixel(metadata.format);
+
+        std::atomic<bool> failed{ false };
+
+        ParallelFor(rowStart[nimages], 16, [&](size_t begin, size_t end) noexcept
+        {
+            std::unique_ptr<Float4[]> scanline;
+            if (plan.path == PMALPHA_PATH_FLOAT4)
+            {
+                scanline.reset(new (std::nothrow) Float4[metadata.width]);
+                if (!scanline)
+                {
+                    failed = true;
+                    return;
+                }
+            }
+
+            size_t index = static_cast<size_t>(std::upper_bound(rowStart.begin(), rowStart.end(), begin) - rowStart.begin()) - 1;
+
+            for (size_t row = begin; row < end; ++row)
+            {
+                while (row >= rowStart[index + 1])
+                    ++index;
+
+                const Image& src = srcImages[index];
+                const Image& dst = dest[index];
+                const size_t y   = row - rowStart[index];
+
+                if (!ProcessRow(plan, metadata.format,
+                    src.pixels + y * src.rowPitch, dst.pixels + y * dst.rowPitch, (src.width * pixelBits + 7) / 8,
+                    src.width, scanline.get()))
+                {
+                    failed = true;
+                    return;
+                }
+            }
+        });
+
+        if (failed)
+        {
+            result.Release();
+            return false;
+        }
+
+        return true;
+    }
+
+    TexMetadata GetImageMetadata(const Image& image) noexcept
+    {
+        TexMetadata mdata = {};
+        mdata.width     = image.width;
+        mdata.height    = image.height;
+        mdata.depth     = 1;
+        mdata.arraySize = 1;
+        mdata.mipLevels = 1;
+        mdata.format    = image.format;
+        mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+        return mdata;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Converts straight alpha to premultiplied alpha
+//-------------------------------------------------------------------------------------
+bool VulkanTex::PremultiplyAlpha(
+    const Image& srcImage,
+    TEX_PMALPHA_FLAGS flags,
+    ScratchImage& image) noexcept
+{
+    return ScaleByAlpha(&srcImage, 1, GetImageMetadata(srcImage), flags, false, image);
+}
+
+bool VulkanTex::PremultiplyAlpha(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    TEX_PMALPHA_FLAGS flags,
+    ScratchImage& result) noexcept
+{
+    return ScaleByAlpha(srcImages, nimages, metadata, flags, false, result);
+}
+
+bool VulkanTex::PremultiplyAlpha(
+    const ImageSetView& srcImages,
+    TEX_PMALPHA_FLAGS flags,
+    ScratchImage& result) noexcept
+{
+    return ScaleByAlpha(srcImages.images, srcImages.nimages, srcImages.metadata, flags, false, result);
+}
+
+//-------------------------------------------------------------------------------------
+// Converts premultiplied alpha back to straight alpha
+//-------------------------------------------------------------------------------------
+bool VulkanTex::UnpremultiplyAlpha(
+    const Image& srcImage,
+    TEX_PMALPHA_FLAGS flags,
+    ScratchImage& image) noexcept
+{
+    return ScaleByAlpha(&srcImage, 1, GetImageMetadata(srcImage), flags, true, image);
+}
+
+bool VulkanTex::UnpremultiplyAlpha(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    TEX_PMALPHA_FLAGS flags,
+    ScratchImage& result) noexcept
+{
+    return ScaleByAlpha(srcImages, nimages, metadata, flags, true, result);
+}
+
+bool VulkanTex::UnpremultiplyAlpha(
+    const ImageSetView& srcImages,
+    TEX_PMALPHA_FLAGS flags,
+    ScratchImage& result) noexcept
+{
+    return ScaleByAlpha(srcImages.images, srcImages.nimages, srcImages.metadata, flags, true, result);
+}
@@ -0,0 +1,154 @@
+#include <atomic>
+#include <cstdint>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    // Box (FANT) only averages when shrinking; enlarging an axis with it would just replicate texels
+    FILTER_KERNEL GetAxisKernel(FILTER_KERNEL kernel, size_t srcSize, size_t destSize) noexcept
+    {
+        if ((kernel == FILTER_KERNEL_BOX) && (destSize > srcSize))
+            return FILTER_KERNEL_LINEAR;
+
+        return kernel;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Resize image
+//-------------------------------------------------------------------------------------
+bool VulkanTex::Resize(
+    const Image& srcImage,
+    size_t width,
+    size_t height,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage& image) noexcept
+{
+    TexMetadata mdata = {};
+    mdata.width     = srcImage.width;
+    mdata.height    = srcImage.height;
+    mdata.depth     = 1;
+    mdata.arraySize = 1;
+    mdata.mipLevels = 1;
+    mdata.format    = srcImage.format;
+    mdata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+    return Resize(&srcImage, 1, mdata, width, height, filter, image);
+}
+
+bool VulkanTex::Resize(
+    const ImageSetView& srcImages,
+    size_t width,
+    size_t height,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage& result) noexcept
+{
+    return Resize(srcImages.images, srcImages.nimages, srcImages.metadata, width, height, filter, result);
+}
+
+bool VulkanTex::Resize(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    size_t width,
+    size_t height,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage& result) noexcept
+{
+    if (!srcImages || !nimages || !width || !height)
+        return false;
+
+    if ((width > UINT32_MAX) || (height > UINT32_MAX))
+        return false;
+
+    if ((metadata.dimension == TEX_DIMENSION_TEXTURE1D) && (height != 1))
+        return false;
+
+    if (!IsConvertible(metadata.format))
+        return false;
+
+    FILTER_KERNEL kernel;
+    if (!GetFilterKernel(filter, kernel))
+        return false;
+
+    TexMetadata mdata2 = metadata;
+    mdata2.width     = width;
+    mdata2.height    = height;
+    mdata2.mipLevels = 1;
+
+    bool hr = result.Initialize(mdata2);
+    if (hr == false)
+        return hr;
+
+    // Every item (or volume slice) shares the same weight tables
+    FilterTable xTable, yTable;
+    if (!BuildFilterTable(GetAxisKernel(kernel, metadata.width, width), metadata.width, width, xTable)
+        || !BuildFilterTable(GetAxisKernel(kernel, metadata.height, height), metadata.height, height, yTable))
+    {
+        result.Release();
+        return false;
+    }
+
+    const size_t count = result.GetImageCount();
+    const Image* dest  = result.GetImages();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t srcIndex = metadata.IsVolumemap()
+            ? metadata.ComputeIndex(0, 0, i)
+            : metadata.ComputeIndex(0, i, 0);
+
+        if ((srcIndex >= nimages)
+            || (srcImages[srcIndex].format != metadata.format)
+            || (srcImages[srcIndex].width != metadata.width)
+            || (srcImages[srcIndex].height != metadata.height))
+        {
+            result.Release();
+            return false;
+        }
+    }
+
+    const uint32_t pixelFlags = GetFilterPixelFlags(filter, metadata);
+    std::atomic<bool> failed{ false };
+
+    // Bands of rows across all images are filtered in parallel
+    ParallelFor(count * height, 8, [&](size_t begin, size_t end) noexcept
+    {
+        while (begin < end)
+        {
+            const size_t i  = begin / height;
+            const size_t y0 = begin - i * height;
+            const size_t y1 = std::min(height, y0 + (end - begin));
+
+            const size_t srcIndex = metadata.IsVolumemap()
+                ? metadata.ComputeIndex(0, 0, i)
+                : metadata.ComputeIndex(0, i, 0);
+
+            if (!ResampleRows(srcImages[srcIndex], dest[i], xTable, yTable, pixelFlags, y0, y1))
+            {
+                failed = true;
+                return;
+            }
+
+            begin += y1 - y0;
+        }
+    });
+
+    if (failed)
+    {
+        result.Release();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    // Reference curves, the tables are built from these
+    double DecodeExact(double value) noexcept
+    {
+        return (value <= 0.04045) ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+    }
+
+    double EncodeExact(double value) noexcept
+    {
+        return (value <= 0.0031308) ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Decode tables
+    //---------------------------------------------------------------------------------
+    struct DecodeTable8
+    {
+        float value[256];
+
+        DecodeTable8() noexcept
+        {
+            for (size_t i = 0; i < 256; ++i)
+            {
+                value[i] = static_cast<float>(DecodeExact(static_cast<double>(i) / 255.0));
+            }
+        }
+    };
+
+    // One entry every 16 codes, linear interpolation in between (error well below 16-bit precision)
+    struct DecodeTable16
+    {
+        float value[4097];
+
+        DecodeTable16() noexcept
+        {
+            for (size_t i = 0; i < 4097; ++i)
+            {
+                value[i] = static_cast<float>(DecodeExact(static_cast<double>(i * 16) / 65535.0));
+            }
+        }
+    };
+
+    const DecodeTable8& GetDecodeTable8() noexcept
+    {
+        static const DecodeTable8 s_table;
+        return s_table;
+    }
+
+    const DecodeTable16& GetDecodeTable16() noexcept
+    {
+        static const DecodeTable16 s_table;
+        return s_table;
+    }
+
+    //---------------------------------------------------------------------------------
+    // 8-bit encode: value[k] is the smallest linear float whose correctly rounded code is k
+    //---------------------------------------------------------------------------------
+    struct EncodeThresholds8
+    {
+        float value[257];
+
+        EncodeThresholds8() noexcept
+        {
+            value[0]   = -HUGE_VALF;
+            value[256] = HUGE_VALF;
+
+            for (size_t k = 1; k < 256; ++k)
+            {
+                const double boundary = (static_cast<double>(k) - 0.5) / 255.0;
+                auto reaches = [boundary](float x) noexcept { return EncodeExact(x) >= boundary; };
+
+                float x = static_cast<float>(DecodeExact(boundary));
+                while (reaches(x))
+                    x = std::nextafter(x, -HUGE_VALF);
+                while (!reaches(x))
+                    x = std::nextafter(x, HUGE_VALF);
+
+                value[k] = x;
+            }
+        }
+    };
+
+    const EncodeThresholds8& GetEncodeThresholds8() noexcept
+    {
+        static const EncodeThresholds8 s_table;
+        return s_table;
+    }
+
+    // 1.055 * x^(1/2.4) - 0.055 from three square roots, within 0.012 of an 8-bit code over [0.0031308, 1]
+    constexpr float c_encodeS1 = 0.642403059f;
+    constexpr float c_encodeS2 = 0.712067675f;
+    constexpr float c_encodeS3 = -0.336852141f;
+    constexpr float c_encodeX  = -0.0175759659f;
+
+    // Estimates closer than this to a rounding boundary are settled with the exact thresholds
+    constexpr float c_encodeMargin = 0.05f;
+
+    inline float SnapToCode(float x, int32_t code, const float* threshold) noexcept
+    {
+        int32_t k = std::min(std::max(code, 0), 255);
+
+        if (x < threshold[k])
+            --k;
+        else if (x >= threshold[k + 1])
+            ++k;
+
+        return static_cast<float>(k) * (1.f / 255.f);
+    }
+
+    inline float EncodeScalar(float x, const float* threshold) noexcept
+    {
+        x = (x > 0.f) ? std::min(x, 1.f) : 0.f;
+
+        float estimate = x * 12.92f;
+        if (x > 0.0031308f)
+        {
+            const float s1 = std::sqrt(x);
+            const float s2 = std::sqrt(s1);
+            const float s3 = std::sqrt(s2);
+            estimate = c_encodeS1 * s1 + c_encodeS2 * s2 + c_encodeS3 * s3 + c_encodeX * x;
+        }
+
+        return SnapToCode(x, static_cast<int32_t>(estimate * 255.f + 0.5f), threshold);
+    }
+
+#if VULKANTEX_SSE2
+    // Encodes one channel of four pixels
+    inline __m128 EncodeChannel(__m128 x, const float* threshold) noexcept
+    {
+        // max() first so NaN becomes 0
+        x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.f));
+
+        const __m128 s1 = _mm_sqrt_ps(x);
+        const __m128 s2 = _mm_sqrt_ps(s1);
+        const __m128 s3 = _mm_sqrt_ps(s2);
+
+        __m128 curve = _mm_mul_ps(s1, _mm_set1_ps(c_encodeS1));
+        curve = _mm_add_ps(curve, _mm_mul_ps(s2, _mm_set1_ps(c_encodeS2)));
+        curve = _mm_add_ps(curve, _mm_mul_ps(s3, _mm_set1_ps(c_encodeS3)));
+        curve = _mm_add_ps(curve, _mm_mul_ps(x, _mm_set1_ps(c_encodeX)));
+
+        const __m128 low      = _mm_cmple_ps(x, _mm_set1_ps(0.0031308f));
+        const __m128 estimate = _mm_mul_ps(_mm_or_ps(_mm_and_ps(low, _mm_mul_ps(x, _mm_set1_ps(12.92f))), _mm_andnot_ps(low, curve)), _mm_set1_ps(255.f));
+
+        const __m128i code    = _mm_cvtps_epi32(estimate);
+        const __m128  rounded = _mm_cvtepi32_ps(code);
+        __m128 result = _mm_mul_ps(rounded, _mm_set1_ps(1.f / 255.f));
+
+        const __m128 distance = _mm_andnot_ps(_mm_set1_ps(-0.f), _mm_sub_ps(estimate, rounded));
+        const int near = _mm_movemask_ps(_mm_cmpgt_ps(distance, _mm_set1_ps(0.5f - c_encodeMargin)));
+
+        if (near)
+        {
+            alignas(16) float   xs[4];
+            alignas(16) int32_t codes[4];
+            alignas(16) float   out[4];
+            _mm_store_ps(xs, x);
+            _mm_store_si128(reinterpret_cast<__m128i*>(codes), code);
+            _mm_store_ps(out, result);
+
+            for (int j = 0; j < 4; ++j)
+            {
+                if (near & (1 << j))
+                    out[j] = SnapToCode(xs[j], codes[j], threshold);
+            }
+
+            result = _mm_load_ps(out);
+        }
+
+        return result;
+    }
+#endif
+
+    void EncodeRow8(Float4* pixels, size_t count) noexcept
+    {
+        const float* threshold = GetEncodeThresholds8().value;
+        size_t i = 0;
+
+#if VULKANTEX_SSE2
+        // Four pixels at a time, one register per channel
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 r = _mm_load_ps(&pixels[i].x);
+            __m128 g = _mm_load_ps(&pixels[i + 1].x);
+            __m128 b = _mm_load_ps(&pixels[i + 2].x);
+            __m128 a = _mm_load_ps(&pixels[i + 3].x);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+
+            r = EncodeChannel(r, threshold);
+            g = EncodeChannel(g, threshold);
+            b = EncodeChannel(b, threshold);
+
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+            _mm_store_ps(&pixels[i].x, r);
+            _mm_store_ps(&pixels[i + 1].x, g);
+            _mm_store_ps(&pixels[i + 2].x, b);
+            _mm_store_ps(&pixels[i + 3].x, a);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            pixels[i].x = EncodeScalar(pixels[i].x, threshold);
+            pixels[i].y = EncodeScalar(pixels[i].y, threshold);
+            pixels[i].z = EncodeScalar(pixels[i].z, threshold);
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Layout classification
+    //---------------------------------------------------------------------------------
+
+    // Every uncompressed format with an sRGB pairing is 8 bits per channel
+    bool Is8BitLayout(VkFormat format) noexcept
+    {
+        return !IsCompressed(format) && IsSRGB(MakeSRGB(format));
+    }
+
+    bool Is16BitUNormLayout(VkFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R16_UNORM:
+            case VK_FORMAT_R16G16_UNORM:
+            case VK_FORMAT_R16G16B16_UNORM:
+            case VK_FORMAT_R16G16B16A16_UNORM:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// Decode (sRGB -> linear)
+//-------------------------------------------------------------------------------------
+void VulkanTex::Internal::DecodeSRGBRow(Float4* pixels, size_t count, VkFormat format) noexcept
+{
+    if (Is8BitLayout(format))
+    {
+        const float* table = GetDecodeTable8().value;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* c = &pixels[i].x;
+
+            for (size_t ch = 0; ch < 3; ++ch)
+            {
+                const int32_t index = static_cast<int32_t>(c[ch] * 255.f + 0.5f);
+                c[ch] = table[std::min(std::max(index, 0), 255)];
+            }
+        }
+        return;
+    }
+
+    if (Is16BitUNormLayout(format))
+    {
+        const float* table = GetDecodeTable16().value;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float* c = &pixels[i].x;
+
+            for (size_t ch = 0; ch < 3; ++ch)
+            {
+                const uint32_t value = static_cast<uint32_t>(std::min(std::max(static_cast<int32_t>(c[ch] * 65535.f + 0.5f), 0), 65535));
+                const uint32_t index = value >> 4;
+                const float    t     = static_cast<float>(value & 15u) * (1.f / 16.f);
+                c[ch] = table[index] + (table[index + 1] - table[index]) * t;
+            }
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        pixels[i].x = SRGBToLinear(pixels[i].x);
+        pixels[i].y = SRGBToLinear(pixels[i].y);
+        pixels[i].z = SRGBToLinear(pixels[i].z);
+    }
+}
+
+//-------------------------------------------------------------------------------------
+// Encode (linear -> sRGB)
+//-------------------------------------------------------------------------------------
+void VulkanTex::Internal::EncodeSRGBRow(Float4* pixels, size_t count, VkFormat format) noexcept
+{
+    if (Is8BitLayout(format))
+    {
+        EncodeRow8(pixels, count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        pixels[i].x = LinearToSRGB(pixels[i].x);
+        pixels[i].y = LinearToSRGB(pixels[i].y);
+        pixels[i].z = LinearToSRGB(pixels[i].z);
+    }
+}
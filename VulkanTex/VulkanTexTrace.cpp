@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+#include "VulkanTex.h"
+#include "VulkanTexP.h"
+
+using namespace VulkanTex;
+using namespace VulkanTex::Internal;
+
+namespace
+{
+    const char* const g_savePhaseNames[SAVE_PHASE_COUNT] =
+    {
+        "header encode",
+        "allocate",
+        "zero fill",
+        "copy",
+        "repack",
+        "compress",
+        "write",
+    };
+
+    struct TraceEvent
+    {
+        uint64_t   start;
+        uint64_t   duration;
+        uint64_t   bytes;
+        uint32_t   thread;
+        SAVE_PHASE phase;
+    };
+}
+
+uint64_t VulkanTex::Internal::GetTraceTimestamp() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const char* VulkanTex::GetSavePhaseName(SAVE_PHASE phase) noexcept
+{
+    return (phase < SAVE_PHASE_COUNT) ? g_savePhaseNames[phase] : "unknown";
+}
+
+
+//=====================================================================================
+// SaveTraceScope
+//=====================================================================================
+
+SaveTraceScope::SaveTraceScope(Stats* stats, SaveTraceCallback callback, void* context) noexcept :
+    m_stats(stats),
+    m_callback(callback),
+    m_context(context),
+    m_previous(t_saveTraceScope)
+{
+    t_saveTraceScope = this;
+}
+
+SaveTraceScope::~SaveTraceScope()
+{
+    t_saveTraceScope = m_previous;
+}
+
+void SaveTraceScope::Record(SAVE_PHASE phase, uint64_t start, uint64_t duration, uint64_t bytes) const noexcept
+{
+    if (phase >= SAVE_PHASE_COUNT)
+        return;
+
+    if (m_stats)
+    {
+        SavePhaseStats& entry = m_stats->phases[phase];
+        entry.nanoseconds += duration;
+        entry.bytes       += bytes;
+        entry.calls       += 1;
+    }
+
+    if (m_callback)
+        m_callback(m_context, phase, start, duration, bytes);
+}
+
+
+//=====================================================================================
+// TraceRecorder
+//=====================================================================================
+
+struct TraceRecorder::Impl
+{
+    mutable std::mutex                            mutex;
+    std::vector<TraceEvent>                       events;
+    std::unordered_map<std::thread::id, uint32_t> threads;
+};
+
+TraceRecorder::TraceRecorder() noexcept :
+    m_impl(new (std::nothrow) Impl)
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    delete m_impl;
+}
+
+TraceRecorder& TraceRecorder::operator= (TraceRecorder&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        delete m_impl;
+
+        m_impl = moveFrom.m_impl;
+        moveFrom.m_impl = nullptr;
+    }
+    return *this;
+}
+
+void TraceRecorder::Callback(void* context, SAVE_PHASE phase, uint64_t start, uint64_t duration, uint64_t bytes) noexcept
+{
+    auto recorder = static_cast<TraceRecorder*>(context);
+    if (!recorder || !recorder->m_impl)
+        return;
+
+    Impl& impl = *recorder->m_impl;
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(impl.mutex);
+
+        // Small stable ids read better in trace viewers than hashed thread ids
+        const auto thread = impl.threads.emplace(std::this_thread::get_id(), static_cast<uint32_t>(impl.threads.size() + 1)).first->second;
+        impl.events.push_back({ start, duration, bytes, thread, phase });
+    }
+    catch (...)
+    {
+        // Dropping an event is preferable to failing the save
+    }
+}
+
+size_t TraceRecorder::GetEventCount() const noexcept
+{
+    if (!m_impl)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->events.size();
+}
+
+void TraceRecorder::Clear() noexcept
+{
+    if (!m_impl)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    m_impl->events.clear();
+}
+
+//-------------------------------------------------------------------------------------
+// Chrome trace event format: complete ('X') events, timestamps in microseconds
+//-------------------------------------------------------------------------------------
+bool TraceRecorder::ExportChromeTrace(const char* szFile) const noexcept
+{
+    if (!m_impl || !szFile)
+        return false;
+
+    try
+    {
+        std::vector<TraceEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(m_impl->mutex);
+            events = m_impl->events;
+        }
+
+        const uint64_t origin = events.empty() ? 0 : std::min_element(events.begin(), events.end(),
+            [](const TraceEvent& a, const TraceEvent& b) { return a.start < b.start; })->start;
+
+        std::ofstream outFile{ std::filesystem::path(szFile), std::ios::out | std::ios::binary | std::ios::trunc };
+        if (!outFile)
+            return false;
+
+        outFile << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        char line[256];
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const TraceEvent& event = events[i];
+            snprintf(line, sizeof(line),
+                "%s\n{\"name\":\"%s\",\"cat\":\"VulkanTex\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"bytes\":%llu}}",
+                i ? "," : "", GetSavePhaseName(event.phase),
+                static_cast<double>(event.start - origin) / 1000.0, static_cast<double>(event.duration) / 1000.0,
+                event.thread, static_cast<unsigned long long>(event.bytes));
+            outFile << line;
+        }
+
+        outFile << "\n]}\n";
+        return static_cast<bool>(outFile);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
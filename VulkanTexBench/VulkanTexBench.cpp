@@ -0,0 +1,630 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexBench.cpp
+//
+// Synthetic workloads over the library hot paths. Prints a table to stderr and
+// a JSON report to stdout (or --json <file>) so runs can be compared over time.
+//
+//   VulkanTexBench [--json <file>] [--tmp <directory>] [--min-time <seconds>] [--filter <text>]
+//-------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "VulkanTex.h"
+
+using namespace VulkanTex;
+
+namespace
+{
+    struct Options
+    {
+        std::string           jsonFile;
+        std::filesystem::path tempDirectory;
+        double                minTime = 0.25;
+        std::string           filter;
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::string category;
+        std::string format;
+        size_t      width;
+        size_t      height;
+        size_t      arraySize;
+        size_t      mipLevels;
+        uint64_t    iterations;
+        double      nsPerOp;
+        uint64_t    bytesPerOp;
+        double      gbPerSecond;
+    };
+
+    struct Case
+    {
+        std::string category;
+        std::string name;
+        VkFormat    format    = VK_FORMAT_UNDEFINED;
+        size_t      width     = 0;
+        size_t      height    = 0;
+        size_t      arraySize = 0;
+        size_t      mipLevels = 0;
+        uint64_t    bytesPerOp = 0;     // Payload touched by one call of 'run'
+        uint64_t    opsPerRun  = 1;     // Calls made by one 'run' (ns/op is per call)
+        std::function<bool()> run;
+    };
+
+    const char* GetFormatName(VkFormat format) noexcept
+    {
+        switch (format)
+        {
+            case VK_FORMAT_R8G8B8A8_UNORM:       return "R8G8B8A8_UNORM";
+            case VK_FORMAT_B8G8R8A8_UNORM:       return "B8G8R8A8_UNORM";
+            case VK_FORMAT_B8G8R8_UNORM:         return "B8G8R8_UNORM";
+            case VK_FORMAT_R16G16B16A16_SFLOAT:  return "R16G16B16A16_SFLOAT";
+            case VK_FORMAT_R32G32B32A32_SFLOAT:  return "R32G32B32A32_SFLOAT";
+            case VK_FORMAT_R8_UNORM:             return "R8_UNORM";
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:  return "BC1_RGB_UNORM";
+            case VK_FORMAT_BC7_UNORM_BLOCK:      return "BC7_UNORM";
+            case VK_FORMAT_ASTC_6x6_UNORM_BLOCK: return "ASTC_6x6_UNORM";
+            default:                             return "UNKNOWN";
+        }
+    }
+
+    size_t FullMipChain(size_t width, size_t height) noexcept
+    {
+        size_t levels = 1;
+        while ((width > 1) || (height > 1))
+        {
+            width  = std::max<size_t>(1u, width >> 1);
+            height = std::max<size_t>(1u, height >> 1);
+            ++levels;
+        }
+        return levels;
+    }
+
+    void FillPattern(uint8_t* pDestination, size_t size) noexcept
+    {
+        uint32_t state = 0x9E3779B9u;
+        for (size_t i = 0; i < size; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            pDestination[i] = static_cast<uint8_t>(state >> 24);
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Timing: repeat until minTime has elapsed (after one warm-up call)
+    //---------------------------------------------------------------------------------
+    bool RunCase(const Case& benchCase, const Options& options, Result& result)
+    {
+        using clock = std::chrono::steady_clock;
+
+        if (!benchCase.run())
+            return false;
+
+        uint64_t runs = 0;
+        uint64_t batch = 1;
+        double elapsed = 0.0;
+
+        while (elapsed < options.minTime)
+        {
+            const auto start = clock::now();
+            for (uint64_t i = 0; i < batch; ++i)
+            {
+                if (!benchCase.run())
+                    return false;
+            }
+            elapsed += std::chrono::duration<double>(clock::now() - start).count();
+            runs += batch;
+
+            if (batch < (uint64_t(1) << 20))
+                batch *= 2;
+        }
+
+        const uint64_t ops = runs * benchCase.opsPerRun;
+
+        result.name        = benchCase.name;
+        result.category    = benchCase.category;
+        result.format      = GetFormatName(benchCase.format);
+        result.width       = benchCase.width;
+        result.height      = benchCase.height;
+        result.arraySize   = benchCase.arraySize;
+        result.mipLevels   = benchCase.mipLevels;
+        result.iterations  = ops;
+        result.nsPerOp     = elapsed * 1e9 / static_cast<double>(ops);
+        result.bytesPerOp  = benchCase.bytesPerOp;
+        result.gbPerSecond = benchCase.bytesPerOp
+            ? static_cast<double>(benchCase.bytesPerOp) * static_cast<double>(ops) / elapsed / 1e9
+            : 0.0;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Workloads
+    //---------------------------------------------------------------------------------
+    struct Shape
+    {
+        VkFormat format;
+        size_t   width;
+        size_t   height;
+        size_t   arraySize;
+        bool     mips;
+        bool     cube;
+    };
+
+    const Shape c_shapes[] =
+    {
+        { VK_FORMAT_R8G8B8A8_UNORM,      256,  256,  1, true,  false },
+        { VK_FORMAT_R8G8B8A8_UNORM,      2048, 2048, 1, true,  false },
+        { VK_FORMAT_R8G8B8A8_UNORM,      1024, 1024, 6, true,  true  },
+        { VK_FORMAT_R8G8B8A8_UNORM,      512,  512,  64, false, false },
+        { VK_FORMAT_R16G16B16A16_SFLOAT, 1024, 1024, 1, true,  false },
+        { VK_FORMAT_R32G32B32A32_SFLOAT, 1024, 512,  2, false, false },
+        { VK_FORMAT_BC7_UNORM_BLOCK,     4096, 4096, 1, true,  false },
+        { VK_FORMAT_BC1_RGB_UNORM_BLOCK, 2048, 2048, 4, true,  false },
+    };
+
+    TexMetadata MakeMetadata(const Shape& shape) noexcept
+    {
+        TexMetadata metadata = {};
+        metadata.width     = shape.width;
+        metadata.height    = shape.height;
+        metadata.depth     = 1;
+        metadata.arraySize = shape.arraySize;
+        metadata.mipLevels = shape.mips ? FullMipChain(shape.width, shape.height) : 1;
+        metadata.miscFlags = shape.cube ? TEX_MISC_TEXTURECUBE : 0u;
+        metadata.format    = shape.format;
+        metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+        return metadata;
+    }
+
+    std::string DescribeShape(const char* prefix, const TexMetadata& metadata)
+    {
+        char text[160];
+        snprintf(text, sizeof(text), "%s/%s/%zux%zu/a%zu/m%zu%s", prefix, GetFormatName(metadata.format),
+            metadata.width, metadata.height, metadata.arraySize, metadata.mipLevels, metadata.IsCubemap() ? "/cube" : "");
+        return text;
+    }
+
+    void SetShape(Case& benchCase, const TexMetadata& metadata) noexcept
+    {
+        benchCase.format    = metadata.format;
+        benchCase.width     = metadata.width;
+        benchCase.height    = metadata.height;
+        benchCase.arraySize = metadata.arraySize;
+        benchCase.mipLevels = metadata.mipLevels;
+    }
+
+    uint64_t TightSize(const ScratchImage& image) noexcept
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            const Image& img = image.GetImages()[i];
+            size_t rowPitch, slicePitch;
+            if (ComputePitch(img.format, img.width, img.height, rowPitch, slicePitch))
+                total += slicePitch;
+        }
+        return total;
+    }
+
+    // Keeps inputs alive for the lifetime of the registered cases
+    struct Fixtures
+    {
+        std::vector<std::shared_ptr<ScratchImage>>         images;
+        std::vector<std::shared_ptr<std::vector<uint8_t>>> buffers;
+    };
+
+    void AddMetadataCases(std::vector<Case>& cases)
+    {
+        static const VkFormat formats[] =
+        {
+            VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_R16G16B16A16_SFLOAT,
+            VK_FORMAT_R32G32B32A32_SFLOAT, VK_FORMAT_R8_UNORM, VK_FORMAT_BC1_RGB_UNORM_BLOCK,
+            VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_ASTC_6x6_UNORM_BLOCK,
+        };
+
+        for (const VkFormat format : formats)
+        {
+            Case benchCase;
+            benchCase.category  = "ComputePitch";
+            benchCase.name      = std::string("ComputePitch/") + GetFormatName(format) + "/mipchain4096";
+            benchCase.format    = format;
+            benchCase.width     = 4096;
+            benchCase.height    = 4096;
+            benchCase.arraySize = 1;
+            benchCase.mipLevels = FullMipChain(4096, 4096);
+            benchCase.opsPerRun = benchCase.mipLevels;
+            benchCase.run = [format]()
+            {
+                size_t total = 0;
+                for (size_t level = 0; level < 13; ++level)
+                {
+                    size_t rowPitch, slicePitch;
+                    if (!ComputePitch(format, size_t(4096) >> level, size_t(4096) >> level, rowPitch, slicePitch))
+                        return false;
+                    total += slicePitch;
+                }
+                return total > 0;
+            };
+            cases.push_back(std::move(benchCase));
+        }
+
+        for (const Shape& shape : c_shapes)
+        {
+            const TexMetadata metadata = MakeMetadata(shape);
+
+            Case benchCase;
+            benchCase.category = "DetermineImageArray";
+            benchCase.name     = DescribeShape("DetermineImageArray", metadata);
+            SetShape(benchCase, metadata);
+            benchCase.run = [metadata]()
+            {
+                size_t nImages = 0, pixelSize = 0;
+                return DetermineImageArray(metadata, CP_FLAGS_NONE, nImages, pixelSize);
+            };
+            cases.push_back(std::move(benchCase));
+        }
+    }
+
+    void AddInitializeCases(std::vector<Case>& cases)
+    {
+        for (const Shape& shape : c_shapes)
+        {
+            const TexMetadata metadata = MakeMetadata(shape);
+
+            ScratchImage probe;
+            if (!probe.Initialize(metadata))
+                continue;
+
+            Case benchCase;
+            benchCase.category   = "ScratchImage::Initialize";
+            benchCase.name       = DescribeShape("Initialize", metadata);
+            benchCase.bytesPerOp = probe.GetPixelsSize();
+            SetShape(benchCase, metadata);
+            benchCase.run = [metadata]()
+            {
+                ScratchImage image;
+                return image.Initialize(metadata);
+            };
+            cases.push_back(std::move(benchCase));
+        }
+    }
+
+    void AddMemcpyCases(std::vector<Case>& cases, Fixtures& fixtures)
+    {
+        struct CopyShape
+        {
+            size_t width;
+            size_t height;
+            size_t srcPadding;  // Extra bytes per source row (pitch mismatch when non-zero)
+        };
+
+        static const CopyShape shapes[] =
+        {
+            { 4096, 4096, 0 },
+            { 4096, 4096, 256 },
+            { 1000, 1000, 96 },
+            { 64,   64,   192 },
+        };
+
+        for (const CopyShape& shape : shapes)
+        {
+            const size_t rowSize  = shape.width * 4;
+            const size_t srcPitch = rowSize + shape.srcPadding;
+
+            auto source = std::make_shared<std::vector<uint8_t>>(srcPitch * shape.height);
+            auto dest   = std::make_shared<std::vector<uint8_t>>(rowSize * shape.height);
+            FillPattern(source->data(), source->size());
+            fixtures.buffers.push_back(source);
+            fixtures.buffers.push_back(dest);
+
+            char name[128];
+            snprintf(name, sizeof(name), "MemcpySubresource/R8G8B8A8_UNORM/%zux%zu/%s", shape.width, shape.height,
+                shape.srcPadding ? "pitch-mismatch" : "tight");
+
+            Case benchCase;
+            benchCase.category   = "MemcpySubresource";
+            benchCase.name       = name;
+            benchCase.format     = VK_FORMAT_R8G8B8A8_UNORM;
+            benchCase.width      = shape.width;
+            benchCase.height     = shape.height;
+            benchCase.arraySize  = 1;
+            benchCase.mipLevels  = 1;
+            benchCase.bytesPerOp = rowSize * shape.height;
+            benchCase.run = [source, dest, rowSize, srcPitch, shape]()
+            {
+                MemoryCopyInfo dst = { dest->data(), rowSize, dest->size() };
+                MemoryCopyInfo src = { source->data(), srcPitch, source->size() };
+                MemcpySubresource(&dst, &src, rowSize, static_cast<uint32_t>(shape.height), 1);
+                return true;
+            };
+            cases.push_back(std::move(benchCase));
+        }
+    }
+
+    void AddSaveCases(std::vector<Case>& cases, Fixtures& fixtures, const Options& options)
+    {
+        struct SaveShape
+        {
+            Shape     shape;
+            DDS_FLAGS flags;
+            const char* variant;
+        };
+
+        static const SaveShape shapes[] =
+        {
+            { { VK_FORMAT_R8G8B8A8_UNORM,      2048, 2048, 1, true,  false }, DDS_FLAGS_NONE, "" },
+            { { VK_FORMAT_R8G8B8A8_UNORM,      1024, 1024, 6, true,  true  }, DDS_FLAGS_NONE, "" },
+            { { VK_FORMAT_R8G8B8A8_UNORM,      256,  256,  64, false, false }, DDS_FLAGS_NONE, "" },
+            { { VK_FORMAT_R16G16B16A16_SFLOAT, 1024, 1024, 1, true,  false }, DDS_FLAGS_NONE, "" },
+            { { VK_FORMAT_BC7_UNORM_BLOCK,     4096, 4096, 1, true,  false }, DDS_FLAGS_NONE, "" },
+            { { VK_FORMAT_B8G8R8_UNORM,        1024, 1024, 1, false, false }, DDS_FLAGS_FORCE_24BPP_RGB, "/24bpp" },
+        };
+
+        for (const SaveShape& save : shapes)
+        {
+            const TexMetadata metadata = MakeMetadata(save.shape);
+
+            auto image = std::make_shared<ScratchImage>();
+            if (!image->Initialize(metadata))
+                continue;
+
+            FillPattern(image->GetPixels(), image->GetPixelsSize());
+            fixtures.images.push_back(image);
+
+            const uint64_t bytes = TightSize(*image);
+            const DDS_FLAGS flags = save.flags;
+
+            {
+                Case benchCase;
+                benchCase.category   = "SaveToDDSMemory";
+                benchCase.name       = DescribeShape("SaveToDDSMemory", metadata) + save.variant;
+                benchCase.bytesPerOp = bytes;
+                SetShape(benchCase, metadata);
+                benchCase.run = [image, flags]()
+                {
+                    Blob blob;
+                    return SaveToDDSMemory(image->GetImages(), image->GetImageCount(), image->GetMetadata(), flags, blob);
+                };
+                cases.push_back(std::move(benchCase));
+            }
+
+            {
+                const std::string file = (options.tempDirectory / "VulkanTexBench.dds").string();
+
+                Case benchCase;
+                benchCase.category   = "SaveToDDSFile";
+                benchCase.name       = DescribeShape("SaveToDDSFile", metadata) + save.variant;
+                benchCase.bytesPerOp = bytes;
+                SetShape(benchCase, metadata);
+                benchCase.run = [image, flags, file]()
+                {
+                    return SaveToDDSFile(image->GetImages(), image->GetImageCount(), image->GetMetadata(), flags, file.c_str());
+                };
+                cases.push_back(std::move(benchCase));
+            }
+        }
+    }
+
+    // Mapped staging memory laid out like a readback buffer: subresources by layer then mip,
+    // rows tightly packed, each subresource aligned to 256 bytes
+    void AddCaptureCases(std::vector<Case>& cases, Fixtures& fixtures, const Options& options)
+    {
+        struct CaptureShape
+        {
+            VkFormat        format;
+            uint32_t        width;
+            uint32_t        height;
+            uint32_t        layers;
+            bool            mips;
+            VkImageViewType viewType;
+        };
+
+        static const CaptureShape shapes[] =
+        {
+            { VK_FORMAT_R8G8B8A8_UNORM,      2048, 2048, 1, true,  VK_IMAGE_VIEW_TYPE_2D },
+            { VK_FORMAT_R8G8B8A8_UNORM,      512,  512,  6, true,  VK_IMAGE_VIEW_TYPE_CUBE },
+            { VK_FORMAT_R16G16B16A16_SFLOAT, 1024, 1024, 8, false, VK_IMAGE_VIEW_TYPE_2D_ARRAY },
+        };
+
+        for (const CaptureShape& shape : shapes)
+        {
+            const uint32_t mipLevels = shape.mips ? static_cast<uint32_t>(FullMipChain(shape.width, shape.height)) : 1u;
+            const size_t bpp = BitsPerPixel(shape.format);
+
+            auto subresources = std::make_shared<std::vector<SubresourceInfo>>();
+            uint64_t offset = 0, bytes = 0;
+
+            for (uint32_t layer = 0; layer < shape.layers; ++layer)
+            {
+                for (uint32_t level = 0; level < mipLevels; ++level)
+                {
+                    SubresourceInfo info = {};
+                    info.layer        = layer;
+                    info.mipLevel     = level;
+                    info.width        = std::max(1u, shape.width >> level);
+                    info.height       = std::max(1u, shape.height >> level);
+                    info.memoryOffset = offset;
+                    info.memorySize   = uint64_t(info.width) * info.height * bpp / 8;
+
+                    bytes  += info.memorySize;
+                    offset  = (offset + info.memorySize + 255) & ~uint64_t(255);
+                    subresources->push_back(info);
+                }
+            }
+
+            auto mapped = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(offset));
+            FillPattern(mapped->data(), mapped->size());
+            fixtures.buffers.push_back(mapped);
+
+            auto info = std::make_shared<CapturedResourceInfo>();
+            info->mappedData               = mapped->data();
+            info->subresourceInfoArray     = subresources->data();
+            info->subresourceInfoArraySize = static_cast<uint32_t>(subresources->size());
+            info->planeCount               = 1;
+            info->layerCount               = shape.layers;
+            info->mipLevels                = mipLevels;
+            info->imageViewType            = shape.viewType;
+            info->format                   = shape.format;
+
+            char name[160];
+            snprintf(name, sizeof(name), "SaveToDDSFile/captured/%s/%ux%u/a%u/m%u", GetFormatName(shape.format),
+                shape.width, shape.height, shape.layers, mipLevels);
+
+            const std::string file = (options.tempDirectory / "VulkanTexBench_captured.dds").string();
+
+            Case benchCase;
+            benchCase.category   = "CapturedResourceInfo";
+            benchCase.name       = name;
+            benchCase.format     = shape.format;
+            benchCase.width      = shape.width;
+            benchCase.height     = shape.height;
+            benchCase.arraySize  = shape.layers;
+            benchCase.mipLevels  = mipLevels;
+            benchCase.bytesPerOp = bytes;
+            benchCase.run = [info, subresources, mapped, file]()
+            {
+                return SaveToDDSFile(info.get(), DDS_FLAGS_NONE, file.c_str());
+            };
+            cases.push_back(std::move(benchCase));
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    // Reporting
+    //---------------------------------------------------------------------------------
+    std::string EscapeJSON(const std::string& text)
+    {
+        std::string out;
+        for (const char c : text)
+        {
+            if ((c == '"') || (c == '\\'))
+                out.push_back('\\');
+            out.push_back(c);
+        }
+        return out;
+    }
+
+    void WriteJSON(FILE* out, const std::vector<Result>& results, const Options& options)
+    {
+        fprintf(out, "{\n  \"library\": \"VulkanTex\",\n  \"minTime\": %.3f,\n  \"benchmarks\": [\n", options.minTime);
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            fprintf(out,
+                "    { \"name\": \"%s\", \"category\": \"%s\", \"format\": \"%s\", \"width\": %zu, \"height\": %zu, "
+                "\"arraySize\": %zu, \"mipLevels\": %zu, \"iterations\": %llu, \"ns_per_op\": %.2f, "
+                "\"bytes_per_op\": %llu, \"gb_per_s\": %.3f }%s\n",
+                EscapeJSON(r.name).c_str(), EscapeJSON(r.category).c_str(), r.format.c_str(), r.width, r.height,
+                r.arraySize, r.mipLevels, static_cast<unsigned long long>(r.iterations), r.nsPerOp,
+                static_cast<unsigned long long>(r.bytesPerOp), r.gbPerSecond,
+                (i + 1 < results.size()) ? "," : "");
+        }
+
+        fprintf(out, "  ]\n}\n");
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = (i + 1 < argc);
+
+            if (!strcmp(arg, "--json") && hasValue)
+                options.jsonFile = argv[++i];
+            else if (!strcmp(arg, "--tmp") && hasValue)
+                options.tempDirectory = argv[++i];
+            else if (!strcmp(arg, "--min-time") && hasValue)
+                options.minTime = atof(argv[++i]);
+            else if (!strcmp(arg, "--filter") && hasValue)
+                options.filter = argv[++i];
+            else
+                return false;
+        }
+
+        if (options.tempDirectory.empty())
+        {
+            // File saves should measure the library, not the disk
+            std::error_code ec;
+            options.tempDirectory = std::filesystem::is_directory("/dev/shm", ec)
+                ? std::filesystem::path("/dev/shm")
+                : std::filesystem::temp_directory_path(ec);
+        }
+
+        return options.minTime > 0.0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s [--json <file>] [--tmp <directory>] [--min-time <seconds>] [--filter <text>]\n", argv[0]);
+        return 2;
+    }
+
+    Fixtures fixtures;
+    std::vector<Case> cases;
+    AddMetadataCases(cases);
+    AddInitializeCases(cases);
+    AddMemcpyCases(cases, fixtures);
+    AddSaveCases(cases, fixtures, options);
+    AddCaptureCases(cases, fixtures, options);
+
+    std::vector<Result> results;
+    int status = 0;
+
+    fprintf(stderr, "%-64s %12s %10s\n", "benchmark", "ns/op", "GB/s");
+
+    for (const Case& benchCase : cases)
+    {
+        if (!options.filter.empty() && (benchCase.name.find(options.filter) == std::string::npos))
+            continue;
+
+        Result result;
+        if (!RunCase(benchCase, options, result))
+        {
+            fprintf(stderr, "%-64s FAILED\n", benchCase.name.c_str());
+            status = 1;
+            continue;
+        }
+
+        fprintf(stderr, "%-64s %12.1f %10.3f\n", result.name.c_str(), result.nsPerOp, result.gbPerSecond);
+        results.push_back(std::move(result));
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(options.tempDirectory / "VulkanTexBench.dds", ec);
+    std::filesystem::remove(options.tempDirectory / "VulkanTexBench_captured.dds", ec);
+
+    if (options.jsonFile.empty())
+    {
+        WriteJSON(stdout, results, options);
+    }
+    else
+    {
+        FILE* out = fopen(options.jsonFile.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "cannot write %s\n", options.jsonFile.c_str());
+            return 1;
+        }
+
+        WriteJSON(out, results, options);
+        fclose(out);
+    }
+
+    return status;
+}
@@ -0,0 +1,887 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexConv.cpp
+//
+// Batch texture conversion. Files flow through three stages connected by bounded queues:
+//
+//   read (DDS/KTX2 load) -> process (decompress, mips, convert, encode) -> write
+//
+// Every stage has its own workers and the queues cap how many decoded textures are in
+// flight. ScratchImage and Blob objects circulate through pools, so once the pipeline
+// is warm a file reuses the buffers of an earlier one instead of allocating its own.
+//
+//   vktexconv [options] <file|directory|pattern>...
+//-------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "VulkanTex.h"
+
+using namespace VulkanTex;
+
+namespace
+{
+    enum CONTAINER : uint32_t
+    {
+        CONTAINER_DDS = 0,
+        CONTAINER_KTX2,
+    };
+
+    struct Options
+    {
+        std::filesystem::path outputDirectory;
+        VkFormat              format        = VK_FORMAT_UNDEFINED;
+        size_t                mipLevels     = 1;        // 0 = full chain
+        bool                  generateMips  = false;
+        TEX_FILTER_FLAGS      filter        = TEX_FILTER_DEFAULT;
+        bool                  srgb          = false;
+        CONTAINER             container     = CONTAINER_DDS;
+        int                   supercompress = 0;        // 0 none, 1 fast, 2 high
+        bool                  recursive     = false;
+        bool                  overwrite     = false;
+        bool                  stats         = false;
+        size_t                threads       = 0;        // Process workers, 0 = one per core
+        size_t                queueDepth    = 0;        // 0 = one per process worker
+        IO_BACKEND            ioBackend     = IO_BACKEND_DEFAULT;
+        std::string           traceFile;
+    };
+
+    struct Input
+    {
+        std::filesystem::path source;
+        std::filesystem::path relative;     // Mirrored under the output directory
+    };
+
+    //---------------------------------------------------------------------------------
+    // Format names accepted by -f
+    //---------------------------------------------------------------------------------
+    struct FormatName
+    {
+        const char* name;
+        VkFormat    format;
+    };
+
+    const FormatName c_formats[] =
+    {
+        { "R8_UNORM",                   VK_FORMAT_R8_UNORM },
+        { "R8G8_UNORM",                 VK_FORMAT_R8G8_UNORM },
+        { "R8G8B8A8_UNORM",             VK_FORMAT_R8G8B8A8_UNORM },
+        { "R8G8B8A8_SRGB",              VK_FORMAT_R8G8B8A8_SRGB },
+        { "B8G8R8A8_UNORM",             VK_FORMAT_B8G8R8A8_UNORM },
+        { "B8G8R8A8_SRGB",              VK_FORMAT_B8G8R8A8_SRGB },
+        { "A2B10G10R10_UNORM_PACK32",   VK_FORMAT_A2B10G10R10_UNORM_PACK32 },
+        { "B10G11R11_UFLOAT_PACK32",    VK_FORMAT_B10G11R11_UFLOAT_PACK32 },
+        { "R16_UNORM",                  VK_FORMAT_R16_UNORM },
+        { "R16_SFLOAT",                 VK_FORMAT_R16_SFLOAT },
+        { "R16G16_UNORM",               VK_FORMAT_R16G16_UNORM },
+        { "R16G16_SFLOAT",              VK_FORMAT_R16G16_SFLOAT },
+        { "R16G16B16A16_UNORM",         VK_FORMAT_R16G16B16A16_UNORM },
+        { "R16G16B16A16_SFLOAT",        VK_FORMAT_R16G16B16A16_SFLOAT },
+        { "R32_SFLOAT",                 VK_FORMAT_R32_SFLOAT },
+        { "R32G32_SFLOAT",              VK_FORMAT_R32G32_SFLOAT },
+        { "R32G32B32A32_SFLOAT",        VK_FORMAT_R32G32B32A32_SFLOAT },
+    };
+
+    bool ParseFormat(const char* text, VkFormat& format) noexcept
+    {
+        for (const FormatName& entry : c_formats)
+        {
+            if (!strcmp(text, entry.name))
+            {
+                format = entry.format;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ParseFilter(const char* text, TEX_FILTER_FLAGS& filter) noexcept
+    {
+        if (!strcmp(text, "point"))
+            filter = TEX_FILTER_POINT;
+        else if (!strcmp(text, "linear"))
+            filter = TEX_FILTER_LINEAR;
+        else if (!strcmp(text, "cubic"))
+            filter = TEX_FILTER_CUBIC;
+        else if (!strcmp(text, "box") || !strcmp(text, "fant"))
+            filter = TEX_FILTER_BOX;
+        else if (!strcmp(text, "kaiser"))
+            filter = TEX_FILTER_KAISER;
+        else
+            return false;
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Input expansion: '*' and '?' in the file name component, directories list their
+    // .dds/.ktx2 files ('-r' descends into subdirectories)
+    //---------------------------------------------------------------------------------
+    bool MatchPattern(const char* pattern, const char* name) noexcept
+    {
+        const char* star  = nullptr;
+        const char* retry = nullptr;
+
+        while (*name)
+        {
+            if ((*pattern == '?') || (*pattern == *name))
+            {
+                ++pattern;
+                ++name;
+            }
+            else if (*pattern == '*')
+            {
+                star  = pattern++;
+                retry = name;
+            }
+            else if (star)
+            {
+                pattern = star + 1;
+                name    = ++retry;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        while (*pattern == '*')
+            ++pattern;
+
+        return !*pattern;
+    }
+
+    bool IsTextureFile(const std::filesystem::path& path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        return (ext == ".dds") || (ext == ".ktx2");
+    }
+
+    bool ExpandInput(const std::string& arg, bool recursive, std::vector<Input>& inputs)
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code ec;
+        const fs::path path(arg);
+        const std::string name = path.filename().string();
+        const bool wildcard = (name.find_first_of("*?") != std::string::npos);
+
+        if (!wildcard && !fs::is_directory(path, ec))
+        {
+            if (!fs::is_regular_file(path, ec))
+                return false;
+
+            inputs.push_back({ path, path.filename() });
+            return true;
+        }
+
+        const fs::path base = wildcard
+            ? (path.has_parent_path() ? path.parent_path() : fs::path("."))
+            : path;
+
+        std::vector<Input> found;
+        auto consider = [&](const fs::directory_entry& entry)
+        {
+            if (!entry.is_regular_file(ec))
+                return;
+
+            const fs::path& file = entry.path();
+            if (wildcard ? !MatchPattern(name.c_str(), file.filename().string().c_str()) : !IsTextureFile(file))
+                return;
+
+            found.push_back({ file, file.lexically_relative(base) });
+        };
+
+        if (recursive)
+        {
+            for (fs::recursive_directory_iterator it(base, ec), end; !ec && (it != end); it.increment(ec))
+                consider(*it);
+        }
+        else
+        {
+            for (fs::directory_iterator it(base, ec), end; !ec && (it != end); it.increment(ec))
+                consider(*it);
+        }
+
+        if (ec)
+            return false;
+
+        std::sort(found.begin(), found.end(), [](const Input& a, const Input& b) { return a.source < b.source; });
+        inputs.insert(inputs.end(), found.begin(), found.end());
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Output naming
+    //---------------------------------------------------------------------------------
+    std::filesystem::path GetOutputPath(const Options& options, const Input& input)
+    {
+        std::filesystem::path output = options.outputDirectory.empty()
+            ? input.source
+            : options.outputDirectory / input.relative;
+        output.replace_extension((options.container == CONTAINER_KTX2) ? ".ktx2" : ".dds");
+        return output;
+    }
+
+    std::string GetPathKey(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+        return (ec ? std::filesystem::absolute(path, ec) : canonical).lexically_normal().string();
+    }
+
+    // Catches outputs that would replace their own input (same container without -o) or that
+    // several inputs map to (same file name from different directories), before any work starts
+    bool CheckOutputs(const Options& options, const std::vector<Input>& inputs)
+    {
+        std::vector<std::pair<std::string, size_t>> outputs;
+        outputs.reserve(inputs.size());
+
+        bool valid = true;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            std::string key = GetPathKey(GetOutputPath(options, inputs[i]));
+            if (key == GetPathKey(inputs[i].source))
+            {
+                fprintf(stderr, "%s: output would replace the input (use -o or --ktx2)\n", inputs[i].source.string().c_str());
+                valid = false;
+            }
+
+            outputs.emplace_back(std::move(key), i);
+        }
+
+        std::sort(outputs.begin(), outputs.end());
+        for (size_t i = 1; i < outputs.size(); ++i)
+        {
+            if (outputs[i].first == outputs[i - 1].first)
+            {
+                fprintf(stderr, "%s: same output as %s (%s)\n",
+                    inputs[outputs[i].second].source.string().c_str(),
+                    inputs[outputs[i - 1].second].source.string().c_str(),
+                    GetOutputPath(options, inputs[outputs[i].second]).string().c_str());
+                valid = false;
+            }
+        }
+
+        return valid;
+    }
+
+    //---------------------------------------------------------------------------------
+    // Pipeline plumbing
+    //---------------------------------------------------------------------------------
+    template<typename T>
+    class BoundedQueue
+    {
+    public:
+        explicit BoundedQueue(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1)), m_closed(false) {}
+
+        // Blocks while the queue is full
+        void Push(T&& item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [&] { return m_items.size() < m_capacity; });
+            m_items.push_back(std::move(item));
+            m_notEmpty.notify_one();
+        }
+
+        // Blocks while the queue is empty, returns false once it is closed and drained
+        bool Pop(T& item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [&] { return m_closed || !m_items.empty(); });
+            if (m_items.empty())
+                return false;
+
+            item = std::move(m_items.front());
+            m_items.pop_front();
+            m_notFull.notify_one();
+            return true;
+        }
+
+        void Close()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_notEmpty.notify_all();
+        }
+
+    private:
+        std::mutex              m_mutex;
+        std::condition_variable m_notEmpty;
+        std::condition_variable m_notFull;
+        std::deque<T>           m_items;
+        size_t                  m_capacity;
+        bool                    m_closed;
+    };
+
+    // Objects keep their allocation when recycled (see ScratchImage::Reset, Blob::Initialize)
+    template<typename T>
+    class ObjectPool
+    {
+    public:
+        std::unique_ptr<T> Acquire()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_free.empty())
+                {
+                    auto object = std::move(m_free.back());
+                    m_free.pop_back();
+                    return object;
+                }
+            }
+            return std::make_unique<T>();
+        }
+
+        void Recycle(std::unique_ptr<T> object)
+        {
+            if (!object)
+                return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(std::move(object));
+        }
+
+    private:
+        std::mutex                      m_mutex;
+        std::vector<std::unique_ptr<T>> m_free;
+    };
+
+    struct Job
+    {
+        size_t                        index = 0;
+        std::unique_ptr<ScratchImage> image;
+        std::unique_ptr<Blob>         blob;
+    };
+
+    enum STAGE : uint32_t
+    {
+        STAGE_READ = 0,
+        STAGE_PROCESS,
+        STAGE_WRITE,
+        STAGE_COUNT
+    };
+
+    const char* const c_stageNames[STAGE_COUNT] = { "read", "process", "write" };
+
+    class Pipeline
+    {
+    public:
+        Pipeline(const Options& options, const std::vector<Input>& inputs) :
+            m_options(options),
+            m_inputs(inputs),
+            m_nextInput(0),
+            m_failed(0),
+            m_bytesIn(0),
+            m_bytesOut(0),
+            m_busy{}
+        {
+            const size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1u);
+
+            // Loads and writes mostly wait on the file system, so they get a quarter of the cores
+            m_workers[STAGE_PROCESS] = std::min(options.threads ? options.threads : cores, std::max<size_t>(inputs.size(), 1u));
+            m_workers[STAGE_READ]    = std::clamp<size_t>(m_workers[STAGE_PROCESS] / 4, 1u, 8u);
+            m_workers[STAGE_WRITE]   = m_workers[STAGE_READ];
+
+            // Library loops split the cores left per file rather than each using all of them
+            m_innerWorkers = std::max<size_t>(cores / m_workers[STAGE_PROCESS], 1u);
+
+            const size_t depth = options.queueDepth ? options.queueDepth : m_workers[STAGE_PROCESS];
+            m_decoded = std::make_unique<BoundedQueue<Job>>(depth);
+            m_encoded = std::make_unique<BoundedQueue<Job>>(depth);
+        }
+
+        bool Run()
+        {
+            std::atomic<size_t> readersLeft{ m_workers[STAGE_READ] };
+            std::atomic<size_t> processorsLeft{ m_workers[STAGE_PROCESS] };
+
+            std::vector<std::thread> threads;
+
+            for (size_t i = 0; i < m_workers[STAGE_READ]; ++i)
+            {
+                threads.emplace_back([this, &readersLeft]
+                {
+                    ReadWorker();
+                    if (--readersLeft == 0)
+                        m_decoded->Close();
+                });
+            }
+
+            for (size_t i = 0; i < m_workers[STAGE_PROCESS]; ++i)
+            {
+                threads.emplace_back([this, &processorsLeft]
+                {
+                    ProcessWorker();
+                    if (--processorsLeft == 0)
+                        m_encoded->Close();
+                });
+            }
+
+            for (size_t i = 0; i < m_workers[STAGE_WRITE]; ++i)
+            {
+                threads.emplace_back([this] { WriteWorker(); });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            return m_failed == 0;
+        }
+
+        size_t GetFailedCount() const noexcept { return m_failed; }
+        size_t GetWorkerCount(STAGE stage) const noexcept { return m_workers[stage]; }
+        uint64_t GetBytesIn() const noexcept { return m_bytesIn; }
+        uint64_t GetBytesOut() const noexcept { return m_bytesOut; }
+        double GetBusySeconds(STAGE stage) const noexcept { return static_cast<double>(m_busy[stage]) * 1e-9; }
+
+        TraceRecorder& GetTraceRecorder() noexcept { return m_trace; }
+
+    private:
+        class BusyTimer
+        {
+        public:
+            explicit BusyTimer(std::atomic<uint64_t>& counter) noexcept :
+                m_counter(counter), m_start(std::chrono::steady_clock::now()) {}
+            ~BusyTimer()
+            {
+                m_counter += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - m_start).count());
+            }
+
+        private:
+            std::atomic<uint64_t>&                m_counter;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+        void Fail(size_t index, const char* what)
+        {
+            ++m_failed;
+
+            std::lock_guard<std::mutex> lock(m_reportMutex);
+            fprintf(stderr, "%s: %s\n", m_inputs[index].source.string().c_str(), what);
+        }
+
+        void ReadWorker()
+        {
+            IOBackendScope io(m_options.ioBackend);
+
+            for (;;)
+            {
+                const size_t index = m_nextInput.fetch_add(1);
+                if (index >= m_inputs.size())
+                    break;
+
+                Job job;
+                job.index = index;
+                job.image = m_imagePool.Acquire();
+
+                bool hr;
+                {
+                    BusyTimer timer(m_busy[STAGE_READ]);
+
+                    std::string ext = m_inputs[index].source.extension().string();
+                    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+
+                    const std::string file = m_inputs[index].source.string();
+                    hr = (ext == ".ktx2")
+                        ? LoadFromKTX2File(file.c_str(), nullptr, *job.image)
+                        : LoadFromDDSFile(file.c_str(), DDS_FLAGS_NONE, nullptr, *job.image);
+
+                    std::error_code ec;
+                    const auto size = std::filesystem::file_size(m_inputs[index].source, ec);
+                    if (!ec)
+                        m_bytesIn += size;
+                }
+
+                if (!hr)
+                {
+                    Fail(index, "cannot load");
+                    m_imagePool.Recycle(std::move(job.image));
+                    continue;
+                }
+
+                m_decoded->Push(std::move(job));
+            }
+        }
+
+        void ProcessWorker()
+        {
+            ParallelismScope parallelism(m_innerWorkers);
+            SaveTraceScope trace(nullptr, m_options.traceFile.empty() ? nullptr : TraceRecorder::Callback, &m_trace);
+
+            // Intermediates stay with the worker and are re-initialized in place for every file
+            ScratchImage decompressed;
+            ScratchImage mipChain;
+            ScratchImage converted;
+
+            Job job;
+            while (m_decoded->Pop(job))
+            {
+                const char* error = nullptr;
+                job.blob = m_blobPool.Acquire();
+
+                {
+                    BusyTimer timer(m_busy[STAGE_PROCESS]);
+                    error = Process(*job.image, decompressed, mipChain, converted, *job.blob);
+                }
+
+                m_imagePool.Recycle(std::move(job.image));
+
+                if (error)
+                {
+                    Fail(job.index, error);
+                    m_blobPool.Recycle(std::move(job.blob));
+                    continue;
+                }
+
+                m_encoded->Push(std::move(job));
+            }
+        }
+
+        const char* Process(
+            const ScratchImage& source,
+            ScratchImage& decompressed, ScratchImage& mipChain, ScratchImage& converted,
+            Blob& blob) noexcept
+        {
+            const Image* images = source.GetImages();
+            size_t nimages = source.GetImageCount();
+            TexMetadata metadata = source.GetMetadata();
+
+            const bool convert = (m_options.format != VK_FORMAT_UNDEFINED) && (m_options.format != metadata.format);
+
+            if (IsCompressed(metadata.format) && (convert || m_options.generateMips))
+            {
+                if (!Decompress(images, nimages, metadata, VK_FORMAT_UNDEFINED, decompressed))
+                    return "cannot decompress";
+
+                images   = decompressed.GetImages();
+                nimages  = decompressed.GetImageCount();
+                metadata = decompressed.GetMetadata();
+            }
+
+            if (m_options.generateMips)
+            {
+                TEX_FILTER_FLAGS filter = m_options.filter;
+                if (m_options.srgb)
+                    filter |= TEX_FILTER_SRGB;
+
+                if (!GenerateMipMaps(images, nimages, metadata, filter, m_options.mipLevels, mipChain))
+                    return "cannot generate mipmaps";
+
+                images   = mipChain.GetImages();
+                nimages  = mipChain.GetImageCount();
+                metadata = mipChain.GetMetadata();
+            }
+
+            if (m_options.format != VK_FORMAT_UNDEFINED && (m_options.format != metadata.format))
+            {
+                ConvertOptions options;
+                if (m_options.srgb)
+                    options.flags = CONVERT_FLAGS_SRGB;
+
+                if (!Convert(images, nimages, metadata, m_options.format, options, converted))
+                    return "cannot convert";
+
+                images   = converted.GetImages();
+                nimages  = converted.GetImageCount();
+                metadata = converted.GetMetadata();
+            }
+
+            bool hr;
+            if (m_options.container == CONTAINER_KTX2)
+            {
+                KTX2_FLAGS flags = KTX2_FLAGS_NONE;
+                if (m_options.supercompress)
+                    flags = (m_options.supercompress > 1) ? KTX2_FLAGS_SUPERCOMPRESS_HIGH : KTX2_FLAGS_SUPERCOMPRESS_FAST;
+
+                hr = SaveToKTX2Memory(images, nimages, metadata, flags, blob);
+            }
+            else
+            {
+                DDS_FLAGS flags = DDS_FLAGS_NONE;
+                if (m_options.supercompress)
+                    flags = (m_options.supercompress > 1) ? DDS_FLAGS_SUPERCOMPRESS_HIGH : DDS_FLAGS_SUPERCOMPRESS_FAST;
+
+                hr = SaveToDDSMemory(images, nimages, metadata, flags, blob);
+            }
+
+            return hr ? nullptr : "cannot encode";
+        }
+
+        void WriteWorker()
+        {
+            Job job;
+            while (m_encoded->Pop(job))
+            {
+                const char* error = nullptr;
+                {
+                    BusyTimer timer(m_busy[STAGE_WRITE]);
+
+                    const std::filesystem::path output = GetOutputPath(m_options, m_inputs[job.index]);
+
+                    std::error_code ec;
+                    if (!m_options.overwrite && std::filesystem::exists(output, ec))
+                    {
+                        error = "output exists (use -y to overwrite)";
+                    }
+                    else
+                    {
+                        if (output.has_parent_path())
+                            std::filesystem::create_directories(output.parent_path(), ec);
+
+                        std::ofstream outFile{ output, std::ios::out | std::ios::binary | std::ios::trunc };
+                        if (outFile)
+                        {
+                            outFile.write(reinterpret_cast<const char*>(job.blob->GetConstBufferPointer()),
+                                          static_cast<std::streamsize>(job.blob->GetBufferSize()));
+                        }
+
+                        if (!outFile)
+                            error = "cannot write output";
+                        else
+                            m_bytesOut += job.blob->GetBufferSize();
+                    }
+                }
+
+                if (error)
+                    Fail(job.index, error);
+
+                m_blobPool.Recycle(std::move(job.blob));
+            }
+        }
+
+        const Options&                     m_options;
+        const std::vector<Input>&          m_inputs;
+        size_t                             m_workers[STAGE_COUNT];
+        size_t                             m_innerWorkers;
+        std::unique_ptr<BoundedQueue<Job>> m_decoded;
+        std::unique_ptr<BoundedQueue<Job>> m_encoded;
+        ObjectPool<ScratchImage>           m_imagePool;
+        ObjectPool<Blob>                   m_blobPool;
+        std::atomic<size_t>                m_nextInput;
+        std::atomic<size_t>                m_failed;
+        std::atomic<uint64_t>              m_bytesIn;
+        std::atomic<uint64_t>              m_bytesOut;
+        std::atomic<uint64_t>              m_busy[STAGE_COUNT];
+        std::mutex                         m_reportMutex;
+        TraceRecorder                      m_trace;
+    };
+
+    //---------------------------------------------------------------------------------
+    // Command line
+    //---------------------------------------------------------------------------------
+    void PrintUsage(const char* program)
+    {
+        fprintf(stderr,
+            "usage: %s [options] <file|directory|pattern>...\n"
+            "\n"
+            "  -o <directory>        Output directory (default: next to each input, which needs a\n"
+            "                        container change since inputs are never overwritten)\n"
+            "  -l <file>             Read inputs from a list file, one per line ('-' for stdin)\n"
+            "  -r                    Descend into subdirectories of directory and pattern inputs\n"
+            "  -f <format>           Convert to a format (e.g. R8G8B8A8_UNORM, R16G16B16A16_SFLOAT)\n"
+            "  -m <levels>           Generate mipmaps (0 = full chain)\n"
+            "  --filter <name>       Mipmap filter: point, linear, cubic, box, kaiser\n"
+            "  --srgb                Treat non-sRGB formats as sRGB encoded\n"
+            "  --ktx2                Write KTX2 instead of DDS\n"
+            "  --supercompress <fast|high>\n"
+            "  -j <count>            Process workers (default: one per core)\n"
+            "  --queue <depth>       Textures buffered between stages (default: process workers)\n"
+            "  --io <backend>        DDS read backend: default, threads, uring\n"
+            "  -y                    Overwrite existing outputs\n"
+            "  --stats               Print throughput and per-stage busy time\n"
+            "  --trace <file>        Write a Chrome trace of the encode phases\n"
+            "\n"
+            "Patterns match '*' and '?' in the file name only. File inputs keep only their file name\n"
+            "under -o, directory and pattern inputs keep their path below the directory.\n",
+            program);
+    }
+
+    bool ReadListFile(const char* file, std::vector<std::string>& args)
+    {
+        std::ifstream listFile;
+        std::istream* in = &std::cin;
+
+        if (strcmp(file, "-") != 0)
+        {
+            listFile.open(file);
+            if (!listFile)
+                return false;
+            in = &listFile;
+        }
+
+        std::string line;
+        while (std::getline(*in, line))
+        {
+            while (!line.empty() && ((line.back() == '\r') || (line.back() == ' ')))
+                line.pop_back();
+
+            if (!line.empty())
+                args.push_back(line);
+        }
+
+        return true;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options, std::vector<std::string>& args)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = (i + 1 < argc);
+
+            if (arg[0] != '-' || !strcmp(arg, "-"))
+                args.push_back(arg);
+            else if (!strcmp(arg, "-o") && hasValue)
+                options.outputDirectory = argv[++i];
+            else if (!strcmp(arg, "-l") && hasValue)
+            {
+                const char* list = argv[++i];
+                if (!ReadListFile(list, args))
+                {
+                    fprintf(stderr, "cannot read list file %s\n", list);
+                    return false;
+                }
+            }
+            else if (!strcmp(arg, "-r"))
+                options.recursive = true;
+            else if (!strcmp(arg, "-f") && hasValue)
+            {
+                if (!ParseFormat(argv[++i], options.format))
+                {
+                    fprintf(stderr, "unknown format %s\n", argv[i]);
+                    return false;
+                }
+            }
+            else if (!strcmp(arg, "-m") && hasValue)
+            {
+                options.mipLevels    = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+                options.generateMips = true;
+            }
+            else if (!strcmp(arg, "--filter") && hasValue)
+            {
+                if (!ParseFilter(argv[++i], options.filter))
+                {
+                    fprintf(stderr, "unknown filter %s\n", argv[i]);
+                    return false;
+                }
+            }
+            else if (!strcmp(arg, "--srgb"))
+                options.srgb = true;
+            else if (!strcmp(arg, "--ktx2"))
+                options.container = CONTAINER_KTX2;
+            else if (!strcmp(arg, "--supercompress") && hasValue)
+            {
+                const char* level = argv[++i];
+                if (!strcmp(level, "fast"))
+                    options.supercompress = 1;
+                else if (!strcmp(level, "high"))
+                    options.supercompress = 2;
+                else
+                    return false;
+            }
+            else if (!strcmp(arg, "-j") && hasValue)
+                options.threads = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+            else if (!strcmp(arg, "--queue") && hasValue)
+                options.queueDepth = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+            else if (!strcmp(arg, "--io") && hasValue)
+            {
+                const char* backend = argv[++i];
+                if (!strcmp(backend, "default"))
+                    options.ioBackend = IO_BACKEND_DEFAULT;
+                else if (!strcmp(backend, "threads"))
+                    options.ioBackend = IO_BACKEND_THREAD_POOL;
+                else if (!strcmp(backend, "uring"))
+                    options.ioBackend = IO_BACKEND_IO_URING;
+                else
+                    return false;
+            }
+            else if (!strcmp(arg, "-y"))
+                options.overwrite = true;
+            else if (!strcmp(arg, "--stats"))
+                options.stats = true;
+            else if (!strcmp(arg, "--trace") && hasValue)
+                options.traceFile = argv[++i];
+            else
+                return false;
+        }
+
+        return !args.empty();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    std::vector<std::string> args;
+    if (!ParseOptions(argc, argv, options, args))
+    {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Input> inputs;
+    for (const std::string& arg : args)
+    {
+        if (!ExpandInput(arg, options.recursive, inputs))
+            fprintf(stderr, "%s: no such file or directory\n", arg.c_str());
+    }
+
+    if (inputs.empty())
+    {
+        fprintf(stderr, "no input files\n");
+        return 1;
+    }
+
+    if (!CheckOutputs(options, inputs))
+        return 1;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    Pipeline pipeline(options, inputs);
+    const bool success = pipeline.Run();
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (options.stats)
+    {
+        const size_t converted = inputs.size() - pipeline.GetFailedCount();
+
+        fprintf(stderr, "%zu files converted, %zu failed in %.3f s (%.1f files/s)\n",
+            converted, pipeline.GetFailedCount(), elapsed, static_cast<double>(converted) / elapsed);
+        fprintf(stderr, "read %.1f MB, wrote %.1f MB (%.1f MB/s out)\n",
+            static_cast<double>(pipeline.GetBytesIn()) / 1e6, static_cast<double>(pipeline.GetBytesOut()) / 1e6,
+            static_cast<double>(pipeline.GetBytesOut()) / 1e6 / elapsed);
+
+        for (uint32_t stage = 0; stage < STAGE_COUNT; ++stage)
+        {
+            const size_t workers = pipeline.GetWorkerCount(static_cast<STAGE>(stage));
+            const double busy = pipeline.GetBusySeconds(static_cast<STAGE>(stage));
+            fprintf(stderr, "%-8s %2zu workers, %5.1f%% busy\n",
+                c_stageNames[stage], workers, 100.0 * busy / (elapsed * static_cast<double>(workers)));
+        }
+    }
+
+    if (!options.traceFile.empty() && !pipeline.GetTraceRecorder().ExportChromeTrace(options.traceFile.c_str()))
+    {
+        fprintf(stderr, "cannot write %s\n", options.traceFile.c_str());
+        return 1;
+    }
+
+    return success ? 0 : 1;
+}
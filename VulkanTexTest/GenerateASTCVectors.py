@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+#-------------------------------------------------------------------------------------
+# GenerateASTCVectors.py
+#
+# Writes VulkanTexTestASTCVectors.h: ASTC blocks and their expected decode, computed
+# with a small, independent implementation of the decode rules in the Khronos Data
+# Format Specification (ASTC chapter). Only the subset needed by the vectors is
+# covered: 2D block modes, power-of-two weight ranges, bit-only color ranges, CEM 8,
+# 12 (LDR RGB/RGBA direct) and 11 (HDR RGB direct, major component 3).
+#
+# Usage: python3 GenerateASTCVectors.py > VulkanTexTestASTCVectors.h
+#-------------------------------------------------------------------------------------
+
+import random
+
+FOOTPRINTS = [(4, 4), (5, 4), (5, 5), (6, 5), (6, 6), (8, 5), (8, 6), (8, 8),
+              (10, 5), (10, 6), (10, 8), (10, 10), (12, 10), (12, 12)]
+
+# QUANT_METHOD order
+LEVELS = [2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256]
+
+
+def level_encoding(levels):
+    for kind, mul in (('bits', 1), ('trit', 3), ('quint', 5)):
+        if levels % mul == 0 and (levels // mul) & (levels // mul - 1) == 0:
+            return kind, (levels // mul).bit_length() - 1
+    raise ValueError(levels)
+
+
+def ise_bits(quant, count):
+    kind, bits = level_encoding(LEVELS[quant])
+    if kind == 'trit':
+        return count * bits + (8 * count + 4) // 5
+    if kind == 'quint':
+        return count * bits + (7 * count + 2) // 3
+    return count * bits
+
+
+def color_quant(count, available):
+    for quant in range(len(LEVELS) - 1, 3, -1):
+        if ise_bits(quant, count) <= available:
+            return quant
+    return None
+
+
+def decode_block_mode(mode):
+    # Returns (xWeights, yWeights, dualPlane, weightQuant) or None for reserved modes
+    r = (mode >> 4) & 1
+    h = (mode >> 9) & 1
+    d = (mode >> 10) & 1
+    a = (mode >> 5) & 3
+    if mode & 3:
+        r |= (mode & 3) << 1
+        b = (mode >> 7) & 3
+        sel = (mode >> 2) & 3
+        if sel == 0:
+            x, y = b + 4, a + 2
+        elif sel == 1:
+            x, y = b + 8, a + 2
+        elif sel == 2:
+            x, y = a + 2, b + 8
+        else:
+            b &= 1
+            x, y = (b + 2, a + 2) if mode & 0x100 else (a + 2, b + 6)
+    else:
+        r |= ((mode >> 2) & 3) << 1
+        if (mode >> 2) & 3 == 0:
+            return None
+        b = (mode >> 9) & 3
+        sel = (mode >> 7) & 3
+        if sel == 0:
+            x, y = 12, a + 2
+        elif sel == 1:
+            x, y = a + 2, 12
+        elif sel == 2:
+            x, y, d, h = a + 6, b + 6, 0, 0
+        else:
+            if (mode >> 5) & 3 == 0:
+                x, y = 6, 10
+            elif (mode >> 5) & 3 == 1:
+                x, y = 10, 6
+            else:
+                return None
+    return x, y, d, r - 2 + 6 * h
+
+
+def find_block_mode(x, y, dual, quant):
+    for mode in range(2048):
+        if (mode & 0x1FF) == 0x1FC:
+            continue
+        if decode_block_mode(mode) == (x, y, dual, quant):
+            return mode
+    return None
+
+
+def unquant_weight(quant, value):
+    kind, bits = level_encoding(LEVELS[quant])
+    assert kind == 'bits'
+    w = 0
+    for shift in range(6 - bits, -bits, -bits):
+        w |= (value << shift) if shift >= 0 else (value >> -shift)
+    return w + 1 if w > 32 else w
+
+
+def unquant_color(quant, value):
+    kind, bits = level_encoding(LEVELS[quant])
+    assert kind == 'bits'
+    v = 0
+    for shift in range(8 - bits, -bits, -bits):
+        v |= (value << shift) if shift >= 0 else (value >> -shift)
+    return v
+
+
+def hash52(p):
+    p &= 0xFFFFFFFF
+    p ^= p >> 15
+    p = (p * 0xEEDE0891) & 0xFFFFFFFF
+    p ^= p >> 5
+    p = (p + (p << 16)) & 0xFFFFFFFF
+    p ^= p >> 7
+    p ^= p >> 3
+    p = (p ^ (p << 6)) & 0xFFFFFFFF
+    p ^= p >> 17
+    return p
+
+
+def select_partition(seed, x, y, z, count, small):
+    if small:
+        x, y, z = x << 1, y << 1, z << 1
+    seed += (count - 1) * 1024
+    rnum = hash52(seed)
+    s = [(rnum >> sh) & 0xF for sh in (0, 4, 8, 12, 16, 20, 24, 28, 18, 22, 26)]
+    s.append(((rnum >> 30) | (rnum << 2)) & 0xF)
+    s = [v * v for v in s]
+    if seed & 1:
+        sh1 = 4 if seed & 2 else 5
+        sh2 = 6 if count == 3 else 5
+    else:
+        sh1 = 6 if count == 3 else 5
+        sh2 = 4 if seed & 2 else 5
+    sh3 = sh1 if seed & 0x10 else sh2
+    shifts = [sh1, sh2, sh1, sh2, sh1, sh2, sh1, sh2, sh3, sh3, sh3, sh3]
+    s = [v >> sh for v, sh in zip(s, shifts)]
+    a = (s[0] * x + s[1] * y + s[10] * z + (rnum >> 14)) & 0x3F
+    b = (s[2] * x + s[3] * y + s[11] * z + (rnum >> 10)) & 0x3F
+    c = (s[4] * x + s[5] * y + s[8] * z + (rnum >> 6)) & 0x3F
+    d = (s[6] * x + s[7] * y + s[9] * z + (rnum >> 2)) & 0x3F
+    if count < 4:
+        d = 0
+    if count < 3:
+        c = 0
+    if a >= b and a >= c and a >= d:
+        return 0
+    if b >= c and b >= d:
+        return 1
+    if c >= d:
+        return 2
+    return 3
+
+
+def infill(grid, gx, gy, bw, bh):
+    ds = (1024 + bw // 2) // (bw - 1)
+    dt = (1024 + bh // 2) // (bh - 1)
+    out = []
+    for t in range(bh):
+        for s in range(bw):
+            gs = (ds * s * (gx - 1) + 32) >> 6
+            gt = (dt * t * (gy - 1) + 32) >> 6
+            js, fs, jt, ft = gs >> 4, gs & 0xF, gt >> 4, gt & 0xF
+            w11 = (fs * ft + 8) >> 4
+            w10 = ft - w11
+            w01 = fs - w11
+            w00 = 16 - fs - ft + w11
+
+            def at(i, j):
+                return grid[j * gx + i] if i < gx and j < gy else 0
+
+            out.append((at(js, jt) * w00 + at(js + 1, jt) * w01 +
+                        at(js, jt + 1) * w10 + at(js + 1, jt + 1) * w11 + 8) >> 4)
+    return out
+
+
+def lns_to_half(c):
+    e, m = c >> 11, c & 0x7FF
+    if m < 512:
+        mt = 3 * m
+    elif m < 1536:
+        mt = 4 * m - 512
+    else:
+        mt = 5 * m - 2048
+    return min((e << 10) + (mt >> 3), 0x7BFF)
+
+
+def ldr_endpoints(cem, v):
+    if cem == 8:
+        v = v + [255, 255]
+    s0, s1 = v[0] + v[2] + v[4], v[1] + v[3] + v[5]
+    if s1 >= s0:
+        return [v[0], v[2], v[4], v[6]], [v[1], v[3], v[5], v[7]]
+    # Blue contraction
+    return ([(v[1] + v[5]) >> 1, (v[3] + v[5]) >> 1, v[5], v[7]],
+            [(v[0] + v[4]) >> 1, (v[2] + v[4]) >> 1, v[4], v[6]])
+
+
+def hdr_endpoints(cem, v):
+    assert cem == 11
+    assert (v[4] & 0x80) and (v[5] & 0x80)
+    return ([v[0] << 8, v[2] << 8, (v[4] & 0x7F) << 9, 0x7800],
+            [v[1] << 8, v[3] << 8, (v[5] & 0x7F) << 9, 0x7800])
+
+
+class Bits:
+    def __init__(self):
+        self.bits = [0] * 128
+
+    def put(self, pos, count, value):
+        for i in range(count):
+            self.bits[pos + i] = (value >> i) & 1
+
+    def put_reversed(self, pos, count, value):
+        for i in range(count):
+            self.bits[127 - pos - i] = (value >> i) & 1
+
+    def to_bytes(self):
+        return [sum(self.bits[i * 8 + j] << j for j in range(8)) for i in range(16)]
+
+
+def encode(bw, bh, gx, gy, wquant, cem, partitions, seed, dual, ccs, rng, srgb=False, colors=None):
+    """Builds a block with random weights and colors and returns (bytes, expected)."""
+    mode = find_block_mode(gx, gy, 1 if dual else 0, wquant)
+    assert mode is not None, (gx, gy, dual, wquant)
+    planes = 2 if dual else 1
+    nweights = gx * gy * planes
+    wbits = ise_bits(wquant, nweights)
+    assert nweights <= 64 and 24 <= wbits <= 96 and gx <= bw and gy <= bh
+
+    ints = 2 * ((cem >> 2) + 1) * partitions
+    header = 17 if partitions == 1 else 29
+    available = 128 - header - wbits - (2 if dual else 0)
+    cquant = color_quant(ints, available)
+    assert cquant is not None and level_encoding(LEVELS[cquant])[0] == 'bits', (bw, bh, cquant)
+    cbits = level_encoding(LEVELS[cquant])[1]
+
+    block = Bits()
+    block.put(0, 11, mode)
+    block.put(11, 2, partitions - 1)
+    if partitions == 1:
+        block.put(13, 4, cem)
+    else:
+        block.put(13, 10, seed)
+        block.put(23, 2, 0)
+        block.put(25, 4, cem)
+
+    # Color endpoints
+    qcolors = colors if colors is not None else [rng.randrange(1 << cbits) for _ in range(ints)]
+    assert len(qcolors) == ints
+    for i, q in enumerate(qcolors):
+        block.put(header + i * cbits, cbits, q)
+    values = [unquant_color(cquant, q) for q in qcolors]
+
+    # Weights, plane-interleaved, stored bit-reversed from the top of the block
+    wb = level_encoding(LEVELS[wquant])[1]
+    qweights = [rng.randrange(1 << wb) for _ in range(nweights)]
+    for i, q in enumerate(qweights):
+        block.put_reversed(i * wb, wb, q)
+    if dual:
+        block.put(128 - wbits - 2, 2, ccs)
+
+    plane_weights = []
+    for p in range(planes):
+        grid = [unquant_weight(wquant, qweights[i * planes + p]) for i in range(gx * gy)]
+        plane_weights.append(infill(grid, gx, gy, bw, bh))
+
+    expected = []
+    small = bw * bh < 31
+    for t in range(bh):
+        for s in range(bw):
+            part = select_partition(seed, s, t, 0, partitions, small) if partitions > 1 else 0
+            ints_per = ints // partitions
+            v = values[part * ints_per:(part + 1) * ints_per]
+            hdr = cem == 11
+            e0, e1 = hdr_endpoints(cem, v) if hdr else ldr_endpoints(cem, v)
+            texel = []
+            for c in range(4):
+                w = plane_weights[1 if dual and c == ccs else 0][t * bw + s]
+                if hdr:
+                    c0, c1 = e0[c], e1[c]
+                elif srgb:
+                    c0, c1 = (e0[c] << 8) | 0x80, (e1[c] << 8) | 0x80
+                else:
+                    c0, c1 = e0[c] * 257, e1[c] * 257
+                value = (c0 * (64 - w) + c1 * w + 32) >> 6
+                texel.append(lns_to_half(value) if hdr else value)
+            expected.extend(texel)
+    return block.to_bytes(), expected
+
+
+def emit(name, fmt, hdr, block, expected):
+    lines = ['    const uint16_t c_%s[] =' % name, '    {']
+    for i in range(0, len(expected), 16):
+        lines.append('        ' + ', '.join('0x%04X' % v for v in expected[i:i + 16]) + ',')
+    lines.append('    };')
+    entry = '        { "%s", %s, %s,\n          { %s },\n          c_%s },' % (
+        name, fmt, 'true' if hdr else 'false', ', '.join('0x%02X' % b for b in block), name)
+    return '\n'.join(lines), entry
+
+
+def main():
+    rng = random.Random(0x41535443)
+    arrays, entries = [], []
+
+    def add(name, fmt, hdr, result):
+        array, entry = emit(name, fmt, hdr, *result)
+        arrays.append(array)
+        entries.append(entry)
+
+    # Footprint sweep: one LDR RGBA block per footprint with a weight grid smaller than
+    # the footprint (so infill is exercised), alternating 2, 3 and 4 bit weights
+    truncation_differs = 0
+    for i, (bw, bh) in enumerate(FOOTPRINTS):
+        for wquant in ((2, 5, 8)[i % 3], 2, 0):
+            wb = level_encoding(LEVELS[wquant])[1]
+            candidates = [(gx, gy) for gx in range(bw, 1, -1) for gy in range(bh, 1, -1)
+                          if (gx, gy) != (bw, bh) and 24 <= gx * gy * wb <= 47
+                          and find_block_mode(gx, gy, 0, wquant) is not None]
+            if candidates:
+                break
+        gx, gy = candidates[0]
+        result = encode(bw, bh, gx, gy, wquant, 12, 1, 0, False, 0, rng)
+        truncation_differs += sum(1 for v in result[1] if (v & 0xFF) >= 0x80)
+        add('ldr_%dx%d' % (bw, bh), 'VK_FORMAT_ASTC_%dx%d_UNORM_BLOCK' % (bw, bh), False, result)
+    assert truncation_differs > 0
+
+    # Blue contraction (CEM 8, s1 < s0)
+    add('ldr_blue_contract', 'VK_FORMAT_ASTC_6x6_UNORM_BLOCK', False,
+        encode(6, 6, 4, 4, 2, 8, 1, 0, False, 0, rng, colors=[200, 10, 180, 20, 220, 30]))
+
+    # sRGB endpoint expansion
+    add('ldr_srgb', 'VK_FORMAT_ASTC_8x8_SRGB_BLOCK', False,
+        encode(8, 8, 5, 5, 0, 12, 1, 0, False, 0, rng, srgb=True))
+
+    # Dual plane, alpha on the second plane
+    add('ldr_dual_plane', 'VK_FORMAT_ASTC_8x8_UNORM_BLOCK', False,
+        encode(8, 8, 4, 3, 0, 12, 1, 0, True, 3, rng))
+
+    # Two partitions, shared CEM 8, 6-bit colors
+    for seed in range(1024):
+        bits = [select_partition(seed, s, t, 0, 2, True) for t in range(4) for s in range(5)]
+        if 6 <= sum(bits) <= 14:
+            break
+    add('ldr_two_partitions', 'VK_FORMAT_ASTC_5x4_UNORM_BLOCK', False,
+        encode(5, 4, 4, 3, 2, 8, 2, seed, False, 0, rng))
+
+    # HDR RGB direct (CEM 11, major component 3)
+    hdr_colors = [0x40, 0x74, 0x20, 0x6A, 0x80 | 0x30, 0x80 | 0x60]
+    add('hdr_rgb_direct', 'VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK', True,
+        encode(6, 6, 4, 6, 0, 11, 1, 0, False, 0, rng, colors=hdr_colors))
+
+    print('//-------------------------------------------------------------------------------------')
+    print('// VulkanTexTestASTCVectors.h')
+    print('//')
+    print('// Generated by GenerateASTCVectors.py from the Khronos ASTC decode rules. Do not edit.')
+    print('//-------------------------------------------------------------------------------------')
+    print()
+    print('#pragma once')
+    print()
+    print('namespace')
+    print('{')
+    print('\n\n'.join(arrays))
+    print()
+    print('    // Expected values are UNORM16 for LDR blocks and FP16 bits for HDR blocks,')
+    print('    // RGBA per texel in row-major order over the footprint')
+    print('    const ASTCKnownAnswer c_astcKnownAnswers[] =')
+    print('    {')
+    print('\n'.join(entries))
+    print('    };')
+    print('}')
+
+
+if __name__ == '__main__':
+    main()
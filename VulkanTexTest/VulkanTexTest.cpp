@@ -0,0 +1,219 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTest.cpp
+//
+// Regression checks for the library, run through CTest.
+//
+//   VulkanTexTest [<temporary directory>] [<filter>]
+//-------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+
+namespace VulkanTexTest
+{
+    namespace
+    {
+        struct TestCase
+        {
+            const char* name;
+            void (*function)();
+        };
+
+        std::vector<TestCase>& GetTests()
+        {
+            static std::vector<TestCase> tests;
+            return tests;
+        }
+
+        std::filesystem::path g_tempDirectory;
+        int g_failures = 0;
+    }
+
+    void Check(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition)
+        {
+            fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", std::filesystem::path(file).filename().string().c_str(), line, expression);
+            ++g_failures;
+        }
+    }
+
+    TestRegistration::TestRegistration(const char* name, void (*function)())
+    {
+        GetTests().push_back({ name, function });
+    }
+
+    const std::filesystem::path& GetTempDirectory()
+    {
+        return g_tempDirectory;
+    }
+
+    TempFile::TempFile(const char* name)
+        : m_path((g_tempDirectory / (std::string("VulkanTexTest_") + name)).string())
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    TempFile::~TempFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    void FillPattern(const ScratchImage& image, uint32_t seed)
+    {
+        uint32_t state = seed * 2654435761u + 1u;
+        uint8_t* pixels = image.GetPixels();
+        for (size_t i = 0; i < image.GetPixelsSize(); ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            pixels[i] = static_cast<uint8_t>(state >> 24);
+        }
+    }
+
+    bool SamePixels(const ScratchImage& image1, const ScratchImage& image2)
+    {
+        if (image1.GetImageCount() != image2.GetImageCount())
+            return false;
+
+        for (size_t i = 0; i < image1.GetImageCount(); ++i)
+        {
+            const Image& a = image1.GetImages()[i];
+            const Image& b = image2.GetImages()[i];
+            if ((a.width != b.width) || (a.height != b.height) || (a.format != b.format))
+                return false;
+
+            size_t rowPitch, slicePitch;
+            if (!ComputePitch(a.format, a.width, a.height, rowPitch, slicePitch, CP_FLAGS_NONE))
+                return false;
+
+            const size_t rows = ComputeScanlines(a.format, a.height);
+            for (size_t y = 0; y < rows; ++y)
+            {
+                if (memcmp(a.pixels + y * a.rowPitch, b.pixels + y * b.rowPitch, rowPitch) != 0)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool SameSubresources(const ScratchImage& range, const ScratchImage& full, size_t firstMip, size_t firstItem)
+    {
+        const TexMetadata& metadata = range.GetMetadata();
+        if (!range.GetImageCount() || (metadata.format != full.GetMetadata().format))
+            return false;
+
+        for (size_t item = 0; item < metadata.arraySize; ++item)
+        {
+            for (size_t level = 0; level < metadata.mipLevels; ++level)
+            {
+                const size_t depth = std::max<size_t>(metadata.depth >> level, 1);
+                for (size_t slice = 0; slice < depth; ++slice)
+                {
+                    const Image* a = range.GetImage(level, item, slice);
+                    const Image* b = full.GetImage(firstMip + level, firstItem + item, slice);
+                    if (!a || !b || (a->width != b->width) || (a->height != b->height))
+                        return false;
+
+                    size_t rowPitch, slicePitch;
+                    if (!ComputePitch(a->format, a->width, a->height, rowPitch, slicePitch, CP_FLAGS_NONE))
+                        return false;
+
+                    const size_t rows = ComputeScanlines(a->format, a->height);
+                    for (size_t y = 0; y < rows; ++y)
+                    {
+                        if (memcmp(a->pixels + y * a->rowPitch, b->pixels + y * b->rowPitch, rowPitch) != 0)
+                            return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool MakePadded(const ScratchImage& image, size_t padding, PaddedImages& padded)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            const Image& img = image.GetImages()[i];
+            total += (img.rowPitch + padding) * ComputeScanlines(img.format, img.height);
+        }
+
+        padded.storage.assign(total, 0xCD);
+        padded.images.assign(image.GetImages(), image.GetImages() + image.GetImageCount());
+
+        uint8_t* dest = padded.storage.data();
+        for (Image& img : padded.images)
+        {
+            const size_t rows = ComputeScanlines(img.format, img.height);
+            const size_t rowPitch = img.rowPitch + padding;
+            for (size_t y = 0; y < rows; ++y)
+                memcpy(dest + y * rowPitch, img.pixels + y * img.rowPitch, img.rowPitch);
+
+            img.pixels     = dest;
+            img.rowPitch   = rowPitch;
+            img.slicePitch = rowPitch * rows;
+            dest += img.slicePitch;
+        }
+
+        return total > 0;
+    }
+
+    float* GetTexel(const Image& image, size_t x, size_t y)
+    {
+        return reinterpret_cast<float*>(image.pixels + y * image.rowPitch) + x * 4;
+    }
+
+    bool IsNear(float value, float expected, float tolerance)
+    {
+        return std::fabs(value - expected) <= tolerance;
+    }
+
+    std::vector<uint8_t> ReadFile(const char* szFile)
+    {
+        std::ifstream inFile{ std::filesystem::path(szFile), std::ios::in | std::ios::binary };
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+    }
+
+    bool WriteFile(const char* szFile, const uint8_t* data, size_t size)
+    {
+        std::ofstream outFile{ std::filesystem::path(szFile), std::ios::out | std::ios::binary | std::ios::trunc };
+        outFile.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        return static_cast<bool>(outFile);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace VulkanTexTest;
+
+    g_tempDirectory = (argc > 1) ? std::filesystem::path(argv[1]) : std::filesystem::temp_directory_path();
+    const char* filter = (argc > 2) ? argv[2] : nullptr;
+
+    int failedTests = 0;
+    for (const TestCase& test : GetTests())
+    {
+        if (filter && !strstr(test.name, filter))
+            continue;
+
+        const int failures = g_failures;
+        test.function();
+
+        const bool passed = (g_failures == failures);
+        fprintf(stderr, "%s %s\n", passed ? "PASSED" : "FAILED", test.name);
+        failedTests += passed ? 0 : 1;
+    }
+
+    fprintf(stderr, "%d test(s) failed\n", failedTests);
+    return failedTests ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTest.h
+//
+// Minimal test harness: TEST_CASE registers a function, CHECK records a failure and
+// keeps going so one run reports every broken expectation.
+//-------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "VulkanTex.h"
+
+namespace VulkanTexTest
+{
+    void Check(bool condition, const char* expression, const char* file, int line);
+
+    struct TestRegistration
+    {
+        TestRegistration(const char* name, void (*function)());
+    };
+
+    // Directory given on the command line (the build directory under CTest)
+    const std::filesystem::path& GetTempDirectory();
+
+    // Unique file name in the temporary directory, removed when the object goes away
+    class TempFile
+    {
+    public:
+        explicit TempFile(const char* name);
+        ~TempFile();
+
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+
+        const std::string& Path() const noexcept { return m_path; }
+        const char* c_str() const noexcept { return m_path.c_str(); }
+
+    private:
+        std::string m_path;
+    };
+
+    // Deterministic pixel pattern (every image gets different bytes)
+    void FillPattern(const VulkanTex::ScratchImage& image, uint32_t seed);
+
+    // Copy of an image set whose rows are 'padding' bytes longer than the format needs
+    // (the padding is filled with a marker so writers that copy it are caught)
+    struct PaddedImages
+    {
+        std::vector<uint8_t>          storage;
+        std::vector<VulkanTex::Image> images;
+    };
+
+    bool MakePadded(const VulkanTex::ScratchImage& image, size_t padding, PaddedImages& padded);
+
+    // Texel (x, y) of an R32G32B32A32_SFLOAT image
+    float* GetTexel(const VulkanTex::Image& image, size_t x, size_t y);
+
+    // Absolute difference within 'tolerance'
+    bool IsNear(float value, float expected, float tolerance = 1e-5f);
+
+    // Byte comparison of the pixel rows of two image sets of the same shape
+    bool SamePixels(const VulkanTex::ScratchImage& image1, const VulkanTex::ScratchImage& image2);
+
+    // 'range' holds levels [firstMip, ...) of items [firstItem, ...) of 'full', byte for byte
+    bool SameSubresources(const VulkanTex::ScratchImage& range, const VulkanTex::ScratchImage& full, size_t firstMip, size_t firstItem);
+
+    std::vector<uint8_t> ReadFile(const char* szFile);
+    bool WriteFile(const char* szFile, const uint8_t* data, size_t size);
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const VulkanTexTest::TestRegistration s_registration_##name(#name, name); \
+    static void name()
+
+#define CHECK(expression) VulkanTexTest::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,199 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestASTC.cpp
+//
+// ASTC decoder known answers: void-extent blocks for every footprint, LDR and HDR
+// endpoint modes, dual plane and partitioned blocks
+//-------------------------------------------------------------------------------------
+
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    struct ASTCKnownAnswer
+    {
+        const char*     name;
+        VkFormat        format;
+        bool            hdr;
+        uint8_t         block[16];
+        const uint16_t* expected;
+    };
+}
+
+#include "VulkanTexTestASTCVectors.h"
+
+namespace
+{
+    struct ASTCFootprint
+    {
+        size_t   width;
+        size_t   height;
+        VkFormat ldr;
+        VkFormat srgb;
+        VkFormat hdr;
+    };
+
+    constexpr ASTCFootprint c_footprints[] =
+    {
+        { 4,  4,  VK_FORMAT_ASTC_4x4_UNORM_BLOCK,    VK_FORMAT_ASTC_4x4_SRGB_BLOCK,    VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK },
+        { 5,  4,  VK_FORMAT_ASTC_5x4_UNORM_BLOCK,    VK_FORMAT_ASTC_5x4_SRGB_BLOCK,    VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK },
+        { 5,  5,  VK_FORMAT_ASTC_5x5_UNORM_BLOCK,    VK_FORMAT_ASTC_5x5_SRGB_BLOCK,    VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK },
+        { 6,  5,  VK_FORMAT_ASTC_6x5_UNORM_BLOCK,    VK_FORMAT_ASTC_6x5_SRGB_BLOCK,    VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK },
+        { 6,  6,  VK_FORMAT_ASTC_6x6_UNORM_BLOCK,    VK_FORMAT_ASTC_6x6_SRGB_BLOCK,    VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK },
+        { 8,  5,  VK_FORMAT_ASTC_8x5_UNORM_BLOCK,    VK_FORMAT_ASTC_8x5_SRGB_BLOCK,    VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK },
+        { 8,  6,  VK_FORMAT_ASTC_8x6_UNORM_BLOCK,    VK_FORMAT_ASTC_8x6_SRGB_BLOCK,    VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK },
+        { 8,  8,  VK_FORMAT_ASTC_8x8_UNORM_BLOCK,    VK_FORMAT_ASTC_8x8_SRGB_BLOCK,    VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK },
+        { 10, 5,  VK_FORMAT_ASTC_10x5_UNORM_BLOCK,   VK_FORMAT_ASTC_10x5_SRGB_BLOCK,   VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK },
+        { 10, 6,  VK_FORMAT_ASTC_10x6_UNORM_BLOCK,   VK_FORMAT_ASTC_10x6_SRGB_BLOCK,   VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK },
+        { 10, 8,  VK_FORMAT_ASTC_10x8_UNORM_BLOCK,   VK_FORMAT_ASTC_10x8_SRGB_BLOCK,   VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK },
+        { 10, 10, VK_FORMAT_ASTC_10x10_UNORM_BLOCK,  VK_FORMAT_ASTC_10x10_SRGB_BLOCK,  VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK },
+        { 12, 10, VK_FORMAT_ASTC_12x10_UNORM_BLOCK,  VK_FORMAT_ASTC_12x10_SRGB_BLOCK,  VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK },
+        { 12, 12, VK_FORMAT_ASTC_12x12_UNORM_BLOCK,  VK_FORMAT_ASTC_12x12_SRGB_BLOCK,  VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK },
+    };
+
+    const ASTCFootprint* FindFootprint(VkFormat format)
+    {
+        for (const ASTCFootprint& fp : c_footprints)
+        {
+            if (fp.ldr == format || fp.srgb == format || fp.hdr == format)
+                return &fp;
+        }
+        return nullptr;
+    }
+
+    // Image of 2x2 copies of one block, one texel short of the block grid in each
+    // direction so that the partial right and bottom blocks are exercised
+    bool MakeBlockImage(VkFormat format, const ASTCFootprint& fp, const uint8_t block[16], ScratchImage& image)
+    {
+        if (!image.Initialize2D(format, fp.width * 2 - 1, fp.height * 2 - 1, 1, 1))
+            return false;
+
+        const Image* img = image.GetImage(0, 0, 0);
+        for (size_t row = 0; row < 2; ++row)
+        {
+            for (size_t column = 0; column < 2; ++column)
+                memcpy(img->pixels + row * img->rowPitch + column * 16, block, 16);
+        }
+        return true;
+    }
+
+    // Checks every texel of a decoded 2x2 block image against one block of expected texels
+    template<typename T, typename Fn>
+    bool MatchesBlock(const ScratchImage& image, const ASTCFootprint& fp, Fn&& expected)
+    {
+        const Image* img = image.GetImage(0, 0, 0);
+        for (size_t y = 0; y < img->height; ++y)
+        {
+            auto row = reinterpret_cast<const T*>(img->pixels + y * img->rowPitch);
+            for (size_t x = 0; x < img->width; ++x)
+            {
+                const size_t texel = (y % fp.height) * fp.width + (x % fp.width);
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    if (row[x * 4 + c] != expected(texel, c))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Void-extent block with all extent coordinates set to ones
+    void MakeVoidExtent(bool hdr, const uint16_t color[4], uint8_t block[16])
+    {
+        const uint64_t header = hdr ? 0xFFFFFFFFFFFFFFFCull : 0xFFFFFFFFFFFFFDFCull;
+        memcpy(block, &header, sizeof(header));
+        memcpy(block + 8, color, 8);
+    }
+}
+
+// Spec-derived blocks (see GenerateASTCVectors.py) across every footprint
+TEST_CASE(ASTCDecodesKnownBlocks)
+{
+    for (const ASTCKnownAnswer& ka : c_astcKnownAnswers)
+    {
+        const ASTCFootprint* fp = FindFootprint(ka.format);
+        CHECK(fp != nullptr);
+        if (!fp)
+            continue;
+
+        ScratchImage blocks;
+        CHECK(MakeBlockImage(ka.format, *fp, ka.block, blocks));
+
+        if (ka.hdr)
+        {
+            ScratchImage decoded;
+            CHECK(Decompress(*blocks.GetImage(0, 0, 0), VK_FORMAT_R16G16B16A16_SFLOAT, decoded));
+            CHECK(MatchesBlock<uint16_t>(decoded, *fp,
+                [&](size_t texel, size_t c) { return ka.expected[texel * 4 + c]; }));
+
+            // HDR endpoint modes are an error in the LDR profile
+            ScratchImage ldrBlocks;
+            CHECK(MakeBlockImage(fp->ldr, *fp, ka.block, ldrBlocks));
+            CHECK(Decompress(*ldrBlocks.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_UNORM, decoded));
+            CHECK(MatchesBlock<uint8_t>(decoded, *fp,
+                [](size_t, size_t c) { return uint8_t(c == 1 ? 0x00 : 0xFF); }));
+            continue;
+        }
+
+        ScratchImage decoded;
+        CHECK(Decompress(*blocks.GetImage(0, 0, 0), VK_FORMAT_R32G32B32A32_SFLOAT, decoded));
+
+        // LDR texels are UNORM16 values scaled to [0, 1]
+        CHECK(MatchesBlock<float>(decoded, *fp,
+            [&](size_t texel, size_t c) { return float(ka.expected[texel * 4 + c]) * (1.f / 65535.f); }));
+
+        // 8-bit output is the top byte of the UNORM16 result (decode_unorm8)
+        const VkFormat rgba8 = (ka.format == fp->srgb) ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+        CHECK(Decompress(*blocks.GetImage(0, 0, 0), rgba8, decoded));
+        CHECK(MatchesBlock<uint8_t>(decoded, *fp,
+            [&](size_t texel, size_t c) { return uint8_t(ka.expected[texel * 4 + c] >> 8); }));
+    }
+}
+
+// Constant-color blocks decode to their stored color in every footprint and profile
+TEST_CASE(ASTCDecodesVoidExtent)
+{
+    // 0x80FF would round up to 0x81 in 8 bits; the spec truncates
+    const uint16_t ldrColor[4] = { 0x1234, 0x80FF, 0xFFFF, 0x7F80 };
+    const uint8_t  ldrColor8[4] = { 0x12, 0x80, 0xFF, 0x7F };
+
+    // 1.0, 5.0, 0.5, 1.0 as FP16
+    const uint16_t hdrColor[4] = { 0x3C00, 0x4500, 0x3800, 0x3C00 };
+
+    for (const ASTCFootprint& fp : c_footprints)
+    {
+        uint8_t block[16];
+        MakeVoidExtent(false, ldrColor, block);
+
+        for (VkFormat format : { fp.ldr, fp.hdr })
+        {
+            ScratchImage blocks;
+            CHECK(MakeBlockImage(format, fp, block, blocks));
+
+            ScratchImage decoded;
+            CHECK(Decompress(*blocks.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_UNORM, decoded));
+            CHECK(MatchesBlock<uint8_t>(decoded, fp, [&](size_t, size_t c) { return ldrColor8[c]; }));
+
+            CHECK(Decompress(*blocks.GetImage(0, 0, 0), VK_FORMAT_R32G32B32A32_SFLOAT, decoded));
+            CHECK(MatchesBlock<float>(decoded, fp, [&](size_t, size_t c) { return float(ldrColor[c]) * (1.f / 65535.f); }));
+        }
+
+        MakeVoidExtent(true, hdrColor, block);
+
+        ScratchImage blocks;
+        CHECK(MakeBlockImage(fp.hdr, fp, block, blocks));
+
+        ScratchImage decoded;
+        CHECK(Decompress(*blocks.GetImage(0, 0, 0), VK_FORMAT_R16G16B16A16_SFLOAT, decoded));
+        CHECK(MatchesBlock<uint16_t>(decoded, fp, [&](size_t, size_t c) { return hdrColor[c]; }));
+
+        // HDR void-extent is an error in the LDR profile
+        CHECK(MakeBlockImage(fp.ldr, fp, block, blocks));
+        CHECK(Decompress(*blocks.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_UNORM, decoded));
+        CHECK(MatchesBlock<uint8_t>(decoded, fp, [](size_t, size_t c) { return uint8_t(c == 1 ? 0x00 : 0xFF); }));
+    }
+}
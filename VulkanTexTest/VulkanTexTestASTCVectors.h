@@ -0,0 +1,414 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestASTCVectors.h
+//
+// Generated by GenerateASTCVectors.py from the Khronos ASTC decode rules. Do not edit.
+//-------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace
+{
+    const uint16_t c_ldr_4x4[] =
+    {
+        0x8080, 0x7A7A, 0x5656, 0x8C8C, 0x8080, 0x7A7A, 0x5656, 0x8C8C, 0x3E3E, 0xD9D9, 0xB8B8, 0x5D5D, 0x8080, 0x7A7A, 0x5656, 0x8C8C,
+        0x6171, 0xA72F, 0x8474, 0x766E, 0x52F3, 0xBC0B, 0x99F9, 0x6C1C, 0x4CBC, 0xC4FC, 0xA333, 0x67AF, 0x6171, 0xA72F, 0x8474, 0x766E,
+        0x5B3B, 0xB01F, 0x8DAD, 0x7202, 0x52F3, 0xBC0B, 0x99F9, 0x6C1C, 0x6171, 0xA72F, 0x8474, 0x766E, 0x5B3B, 0xB01F, 0x8DAD, 0x7202,
+        0x6AC2, 0x99C5, 0x769E, 0x7D11, 0x8080, 0x7A7A, 0x5656, 0x8C8C, 0x8080, 0x7A7A, 0x5656, 0x8C8C, 0x6AC2, 0x99C5, 0x769E, 0x7D11,
+    };
+
+    const uint16_t c_ldr_5x4[] =
+    {
+        0x1212, 0x0606, 0xC8C8, 0xBFBF, 0x5F27, 0x5B93, 0xA82C, 0x9935, 0x1212, 0x0606, 0xC8C8, 0xBFBF, 0x4575, 0x3F0F, 0xB30A, 0xA60D,
+        0x1212, 0x0606, 0xC8C8, 0xBFBF, 0x4850, 0x423A, 0xB1D5, 0xA4A0, 0x8444, 0x84C4, 0x9878, 0x86A6, 0x2333, 0x1909, 0xC189, 0xB72E,
+        0x5696, 0x5212, 0xABCB, 0x9D7D, 0x4850, 0x423A, 0xB1D5, 0xA4A0, 0x5696, 0x5212, 0xABCB, 0x9D7D, 0x8444, 0x84C4, 0x9878, 0x86A6,
+        0x2BC4, 0x228A, 0xBDE9, 0xB2E6, 0x7048, 0x6E96, 0xA0EC, 0x90A4, 0x7048, 0x6E96, 0xA0EC, 0x90A4, 0x4575, 0x3F0F, 0xB30A, 0xA60D,
+        0x5F27, 0x5B93, 0xA82C, 0x9935, 0x2BC4, 0x228A, 0xBDE9, 0xB2E6, 0x9565, 0x97C7, 0x9139, 0x7E16, 0x9565, 0x97C7, 0x9139, 0x7E16,
+    };
+
+    const uint16_t c_ldr_5x5[] =
+    {
+        0xBA3A, 0xA6F6, 0xF575, 0x6F3F, 0xBA3A, 0xA6F6, 0xF575, 0x6F3F, 0xAD0C, 0x6D51, 0xD6B6, 0x91D5, 0xAB2B, 0x6515, 0xD252, 0x96C6,
+        0xBBBB, 0xAD8D, 0xF8F8, 0x6B4B, 0xBA3A, 0xA6F6, 0xF575, 0x6F3F, 0xB918, 0xA205, 0xF2D2, 0x7236, 0xABEB, 0x6860, 0xD413, 0x94CC,
+        0xAEEE, 0x758D, 0xDB1A, 0x8CE4, 0xBC7C, 0xB0D8, 0xFABA, 0x6951, 0xBA3A, 0xA6F6, 0xF575, 0x6F3F, 0xB7F7, 0x9D14, 0xF02F, 0x752D,
+        0xAACA, 0x636F, 0xD171, 0x97C3, 0xB2B2, 0x8606, 0xE3E3, 0x8303, 0xBD3D, 0xB423, 0xFC7C, 0x6757, 0xBA3A, 0xA6F6, 0xF575, 0x6F3F,
+        0xB676, 0x967E, 0xECAC, 0x7921, 0xA949, 0x5CD8, 0xCDED, 0x9BB7, 0xB676, 0x967E, 0xECAC, 0x7921, 0xBDFD, 0xB76F, 0xFE3D, 0x655D,
+        0xBA3A, 0xA6F6, 0xF575, 0x6F3F, 0xB555, 0x918D, 0xEA09, 0x7C18, 0xA828, 0x57E8, 0xCB4B, 0x9EAE, 0xBA3A, 0xA6F6, 0xF575, 0x6F3F,
+        0xBEBE, 0xBABA, 0xFFFF, 0x6363,
+    };
+
+    const uint16_t c_ldr_6x5[] =
+    {
+        0x3F13, 0x8F2B, 0x957D, 0xD2B6, 0x608C, 0x66CA, 0x6F87, 0xADC9, 0x3F13, 0x8F2B, 0x957D, 0xD2B6, 0x1F1F, 0xB5B5, 0xB9B9, 0xF5F5,
+        0x3F13, 0x8F2B, 0x957D, 0xD2B6, 0x608C, 0x66CA, 0x6F87, 0xADC9, 0x4FD0, 0x7AFB, 0x8282, 0xC040, 0x3F13, 0x8F2B, 0x957D, 0xD2B6,
+        0x3F13, 0x8F2B, 0x957D, 0xD2B6, 0x2E56, 0xA35B, 0xA878, 0xE52C, 0x2E56, 0xA35B, 0xA878, 0xE52C, 0x608C, 0x66CA, 0x6F87, 0xADC9,
+        0x608C, 0x66CA, 0x6F87, 0xADC9, 0x1F1F, 0xB5B5, 0xB9B9, 0xF5F5, 0x3F13, 0x8F2B, 0x957D, 0xD2B6, 0x3F13, 0x8F2B, 0x957D, 0xD2B6,
+        0x1F1F, 0xB5B5, 0xB9B9, 0xF5F5, 0x608C, 0x66CA, 0x6F87, 0xADC9, 0x3F13, 0x8F2B, 0x957D, 0xD2B6, 0x3F13, 0x8F2B, 0x957D, 0xD2B6,
+        0x4FD0, 0x7AFB, 0x8282, 0xC040, 0x4FD0, 0x7AFB, 0x8282, 0xC040, 0x1F1F, 0xB5B5, 0xB9B9, 0xF5F5, 0x4FD0, 0x7AFB, 0x8282, 0xC040,
+        0x1F1F, 0xB5B5, 0xB9B9, 0xF5F5, 0x608C, 0x66CA, 0x6F87, 0xADC9, 0x608C, 0x66CA, 0x6F87, 0xADC9, 0x608C, 0x66CA, 0x6F87, 0xADC9,
+        0x1F1F, 0xB5B5, 0xB9B9, 0xF5F5, 0x3F13, 0x8F2B, 0x957D, 0xD2B6,
+    };
+
+    const uint16_t c_ldr_6x6[] =
+    {
+        0x5313, 0x5F5F, 0x6ED6, 0x7A4E, 0x3131, 0x0E0E, 0x0A0A, 0x8181, 0x6AEB, 0x9898, 0xB5C5, 0x753D, 0x6AEB, 0x9898, 0xB5C5, 0x753D,
+        0x6AEB, 0x9898, 0xB5C5, 0x753D, 0x8181, 0xCECE, 0xF8F8, 0x7070, 0x4CCD, 0x5050, 0x5C2C, 0x7BA3, 0x3DBE, 0x2C2C, 0x2F5F, 0x7ED6,
+        0x65E6, 0x8C8C, 0xA6D6, 0x764E, 0x6EAE, 0xA1A1, 0xC0F8, 0x7470, 0x65E6, 0x8C8C, 0xA6D6, 0x764E, 0x7636, 0xB3B3, 0xD75F, 0x72D6,
+        0x4686, 0x4141, 0x4981, 0x7CF8, 0x4B8B, 0x4D4D, 0x5870, 0x7BE7, 0x6222, 0x8383, 0x9BA3, 0x771B, 0x73B3, 0xADAD, 0xCFE7, 0x735F,
+        0x6222, 0x8383, 0x9BA3, 0x771B, 0x6C2C, 0x9B9B, 0xB981, 0x74F9, 0x3DBE, 0x2C2C, 0x2F5F, 0x7ED6, 0x5BDC, 0x7474, 0x88F8, 0x7870,
+        0x5BDC, 0x7474, 0x88F8, 0x7870, 0x78B8, 0xB9B9, 0xDED6, 0x724E, 0x5BDC, 0x7474, 0x88F8, 0x7870, 0x5D1D, 0x7777, 0x8CB4, 0x782C,
+        0x3777, 0x1D1D, 0x1CB5, 0x802C, 0x69A9, 0x9595, 0xB209, 0x7581, 0x5818, 0x6B6B, 0x7DC5, 0x793D, 0x7DBD, 0xC5C5, 0xEDC5, 0x713D,
+        0x5818, 0x6B6B, 0x7DC5, 0x793D, 0x5313, 0x5F5F, 0x6ED6, 0x7A4E, 0x3131, 0x0E0E, 0x0A0A, 0x8181, 0x7636, 0xB3B3, 0xD75F, 0x72D6,
+        0x5313, 0x5F5F, 0x6ED6, 0x7A4E, 0x8181, 0xCECE, 0xF8F8, 0x7070, 0x5313, 0x5F5F, 0x6ED6, 0x7A4E, 0x47C8, 0x4444, 0x4D3D, 0x7CB4,
+    };
+
+    const uint16_t c_ldr_8x5[] =
+    {
+        0xA7C7, 0xBDDD, 0x4BEC, 0x1777, 0xA9BD, 0xC1B5, 0x4BAF, 0x1AD7, 0xAD45, 0xC8A0, 0x4B43, 0x20E9, 0xB5E5, 0xD989, 0x4A3A, 0x2FC0,
+        0xB6AE, 0xDB12, 0x4A22, 0x3119, 0xB003, 0xCE01, 0x4AEF, 0x25A1, 0xB003, 0xCE01, 0x4AEF, 0x25A1, 0xB25E, 0xD29E, 0x4AA6, 0x29AE,
+        0xAD45, 0xC8A0, 0x4B43, 0x20E9, 0xAC17, 0xC652, 0x4B67, 0x1EE3, 0xAC17, 0xC652, 0x4B67, 0x1EE3, 0xB38B, 0xD4EC, 0x4A82, 0x2BB4,
+        0xB4B8, 0xD73A, 0x4A5E, 0x2DBA, 0xB0CC, 0xCF8B, 0x4AD7, 0x26FB, 0xAF9F, 0xCD3C, 0x4AFB, 0x24F5, 0xB0CC, 0xCF8B, 0x4AD7, 0x26FB,
+        0xB2C2, 0xD363, 0x4A9A, 0x2A5A, 0xAD45, 0xC8A0, 0x4B43, 0x20E9, 0xABB3, 0xC58D, 0x4B73, 0x1E36, 0xB131, 0xD050, 0x4ACB, 0x27A8,
+        0xB3EF, 0xD5B1, 0x4A76, 0x2C60, 0xB0CC, 0xCF8B, 0x4AD7, 0x26FB, 0xAF3B, 0xCC78, 0x4B07, 0x2448, 0xAED6, 0xCBB3, 0x4B13, 0x239B,
+        0xB840, 0xDE25, 0x49F2, 0x33CC, 0xAF9F, 0xCD3C, 0x4AFB, 0x24F5, 0xAA86, 0xC33E, 0x4B97, 0x1C30, 0xAF3B, 0xCC78, 0x4B07, 0x2448,
+        0xB195, 0xD114, 0x4ABE, 0x2854, 0xB1F9, 0xD1D9, 0x4AB2, 0x2901, 0xAF9F, 0xCD3C, 0x4AFB, 0x24F5, 0xAD45, 0xC8A0, 0x4B43, 0x20E9,
+        0xBDBD, 0xE8E8, 0x4949, 0x3D3D, 0xB25E, 0xD29E, 0x4AA6, 0x29AE, 0xAA21, 0xC27A, 0x4BA3, 0x1B83, 0xACE0, 0xC7DB, 0x4B4F, 0x203C,
+        0xAF9F, 0xCD3C, 0x4AFB, 0x24F5, 0xB1F9, 0xD1D9, 0x4AB2, 0x2901, 0xAF3B, 0xCC78, 0x4B07, 0x2448, 0xAB4F, 0xC4C8, 0x4B7F, 0x1D89,
+    };
+
+    const uint16_t c_ldr_8x6[] =
+    {
+        0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0x5454, 0x5959, 0x4141, 0x1B1B, 0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8418, 0x5A72, 0x37EC, 0x4820, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0x59C9, 0x5979, 0x4030, 0x2040, 0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x7672, 0x5A22, 0x3A96, 0x3B43,
+        0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x792D, 0x5A32, 0x3A0E, 0x3DD6, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0x5F3F, 0x5999, 0x3F1F, 0x2565, 0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x7BE7, 0x5A42, 0x3985, 0x4068,
+        0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x6A2A, 0x59DA, 0x3CFD, 0x2FB0, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0x6612, 0x59C1, 0x3DCA, 0x2BD4, 0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x8418, 0x5A72, 0x37EC, 0x4820,
+        0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x5F3F, 0x5999, 0x3F1F, 0x2565, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0x6B87, 0x59E2, 0x3CB8, 0x30F9, 0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x898D, 0x5A92, 0x36DB, 0x4D45,
+        0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x5454, 0x5959, 0x4141, 0x1B1B, 0x70FD, 0x5A02, 0x3BA7, 0x361E,
+        0x70FD, 0x5A02, 0x3BA7, 0x361E, 0xABAB, 0x5B5B, 0x3030, 0x6D6D, 0x8F02, 0x5AB2, 0x35CA, 0x526A, 0x8F02, 0x5AB2, 0x35CA, 0x526A,
+    };
+
+    const uint16_t c_ldr_8x8[] =
+    {
+        0xB048, 0xB272, 0xE01F, 0x8EFA, 0xC199, 0x9454, 0xCE0D, 0x4652, 0xACAC, 0xB8B8, 0xE3E3, 0x9E1E, 0x9EF6, 0xD090, 0xF231, 0xD7A3,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA4BC, 0xC686, 0xEC2B, 0xBF6B, 0xB6C6, 0xA727, 0xD959, 0x73BB,
+        0xACAC, 0xB8B8, 0xE3E3, 0x9E1E, 0xBDFD, 0x9A9A, 0xD1D1, 0x5575, 0xABF3, 0xB9F9, 0xE4A4, 0xA125, 0x9EF6, 0xD090, 0xF231, 0xD7A3,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA4BC, 0xC686, 0xEC2B, 0xBF6B, 0xB555, 0xA9A9, 0xDADA, 0x79C9,
+        0xA79F, 0xC181, 0xE928, 0xB34F, 0xB8F0, 0xA363, 0xD716, 0x6AA6, 0xAA82, 0xBC7C, 0xE625, 0xA733, 0x9FAF, 0xCF4F, 0xF171, 0xD49C,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA403, 0xC7C7, 0xECEC, 0xC272, 0xB272, 0xAEAE, 0xDDDD, 0x85E5,
+        0xA4BC, 0xC686, 0xEC2B, 0xBF6B, 0xB555, 0xA9A9, 0xDADA, 0x79C9, 0xABF3, 0xB9F9, 0xE4A4, 0xA125, 0xA068, 0xCE0D, 0xF0B0, 0xD195,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA403, 0xC7C7, 0xECEC, 0xC272, 0xB100, 0xB131, 0xDF5F, 0x8BF3,
+        0xA121, 0xCCCC, 0xEFEF, 0xCE8E, 0xB272, 0xAEAE, 0xDDDD, 0x85E5, 0xAA82, 0xBC7C, 0xE625, 0xA733, 0xA068, 0xCE0D, 0xF0B0, 0xD195,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA403, 0xC7C7, 0xECEC, 0xC272, 0xAED6, 0xB4F4, 0xE1A1, 0x9508,
+        0x9E3E, 0xD1D1, 0xF2F2, 0xDAAA, 0xAED6, 0xB4F4, 0xE1A1, 0x9508, 0xAB3B, 0xBB3B, 0xE565, 0xA42C, 0xA121, 0xCCCC, 0xEFEF, 0xCE8E,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA403, 0xC7C7, 0xECEC, 0xC272, 0xAD65, 0xB777, 0xE322, 0x9B16,
+        0x9931, 0xDA9A, 0xF837, 0xEFDB, 0xA9C9, 0xBDBD, 0xE6E6, 0xAA3A, 0xAA82, 0xBC7C, 0xE625, 0xA733, 0xA121, 0xCCCC, 0xEFEF, 0xCE8E,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA34B, 0xC908, 0xEDAD, 0xC579, 0xAA82, 0xBC7C, 0xE625, 0xA733,
+        0x9595, 0xE0E0, 0xFBFB, 0xFEFE, 0xA6E6, 0xC2C2, 0xE9E9, 0xB656, 0xA910, 0xBEFE, 0xE7A7, 0xAD41, 0xA1D9, 0xCB8B, 0xEF2E, 0xCB87,
+        0xAD65, 0xB777, 0xE322, 0x9B16, 0xBB1A, 0x9F9F, 0xD4D4, 0x6191, 0xA34B, 0xC908, 0xEDAD, 0xC579, 0xA910, 0xBEFE, 0xE7A7, 0xAD41,
+    };
+
+    const uint16_t c_ldr_10x5[] =
+    {
+        0x1BD4, 0x5B7B, 0x2A62, 0x2804, 0x1BD4, 0x5B7B, 0x2A62, 0x2804, 0x1BD4, 0x5B7B, 0x2A62, 0x2804, 0x1A3A, 0x64E5, 0x2D4D, 0x2BBC,
+        0x178F, 0x7494, 0x322A, 0x31EE, 0x134B, 0x8DAD, 0x39F2, 0x3BD8, 0x0D6D, 0xB030, 0x44A4, 0x4979, 0x0BD4, 0xB999, 0x478F, 0x4D31,
+        0x15F6, 0x7DFE, 0x3515, 0x35A5, 0x2018, 0x4262, 0x229A, 0x1E1A, 0x19B2, 0x6808, 0x2E46, 0x2CF9, 0x1BD4, 0x5B7B, 0x2A62, 0x2804,
+        0x1DF6, 0x4EEF, 0x267E, 0x230F, 0x1B4B, 0x5E9E, 0x2B5B, 0x2941, 0x15F6, 0x7DFE, 0x3515, 0x35A5, 0x11B2, 0x9717, 0x3CDD, 0x3F8F,
+        0x0F07, 0xA6C6, 0x41B9, 0x45C1, 0x0F07, 0xA6C6, 0x41B9, 0x45C1, 0x1818, 0x7171, 0x3131, 0x30B1, 0x2129, 0x3C1C, 0x20A9, 0x1BA0,
+        0x1818, 0x7171, 0x3131, 0x30B1, 0x1C5C, 0x5858, 0x2969, 0x26C7, 0x1F8F, 0x4585, 0x2393, 0x1F57, 0x1AC3, 0x61C1, 0x2C54, 0x2A7E,
+        0x134B, 0x8DAD, 0x39F2, 0x3BD8, 0x10A1, 0x9D5D, 0x3ECF, 0x420A, 0x1129, 0x9A3A, 0x3DD6, 0x40CD, 0x123A, 0x93F3, 0x3BE4, 0x3E52,
+        0x1A3A, 0x64E5, 0x2D4D, 0x2BBC, 0x223A, 0x35D6, 0x1EB7, 0x1925, 0x15F6, 0x7DFE, 0x3515, 0x35A5, 0x1B4B, 0x5E9E, 0x2B5B, 0x2941,
+        0x21B2, 0x38F9, 0x1FB0, 0x1A62, 0x1BD4, 0x5B7B, 0x2A62, 0x2804, 0x11B2, 0x9717, 0x3CDD, 0x3F8F, 0x0F90, 0xA3A3, 0x40C1, 0x4484,
+        0x1129, 0x9A3A, 0x3DD6, 0x40CD, 0x14E5, 0x8444, 0x3707, 0x3820, 0x1C5C, 0x5858, 0x2969, 0x26C7, 0x23D4, 0x2C6C, 0x1BCC, 0x156D,
+        0x145C, 0x8767, 0x3800, 0x395D, 0x1BD4, 0x5B7B, 0x2A62, 0x2804, 0x22C3, 0x32B3, 0x1DBE, 0x17E8, 0x1CE5, 0x5535, 0x2870, 0x2589,
+        0x1018, 0xA080, 0x3FC8, 0x4347, 0x0DF6, 0xAD0C, 0x43AB, 0x483C, 0x12C3, 0x90D0, 0x3AEB, 0x3D15, 0x1818, 0x7171, 0x3131, 0x30B1,
+        0x1E7E, 0x4BCC, 0x2585, 0x21D2, 0x24E5, 0x2626, 0x19DA, 0x12F3,
+    };
+
+    const uint16_t c_ldr_10x6[] =
+    {
+        0x7501, 0x8199, 0x9DE5, 0x5824, 0x7501, 0x8199, 0x9DE5, 0x5824, 0x66DA, 0x654D, 0x8B43, 0x4F83, 0x66DA, 0x654D, 0x8B43, 0x4F83,
+        0x7501, 0x8199, 0x9DE5, 0x5824, 0x8282, 0x9C9C, 0xAFAF, 0x6060, 0x66DA, 0x654D, 0x8B43, 0x4F83, 0x8282, 0x9C9C, 0xAFAF, 0x6060,
+        0x66DA, 0x654D, 0x8B43, 0x4F83, 0x7501, 0x8199, 0x9DE5, 0x5824, 0x7793, 0x86BE, 0xA149, 0x59B5, 0x7793, 0x86BE, 0xA149, 0x59B5,
+        0x6448, 0x6028, 0x87DF, 0x4DF2, 0x6448, 0x6028, 0x87DF, 0x4DF2, 0x726E, 0x7C74, 0x9A82, 0x5692, 0x7FEF, 0x9777, 0xAC4C, 0x5ECE,
+        0x6448, 0x6028, 0x87DF, 0x4DF2, 0x7FEF, 0x9777, 0xAC4C, 0x5ECE, 0x6C00, 0x6F97, 0x9209, 0x52A6, 0x6FDB, 0x774F, 0x971F, 0x5501,
+        0x7A26, 0x8BE3, 0xA4AC, 0x5B47, 0x7A26, 0x8BE3, 0xA4AC, 0x5B47, 0x61B5, 0x5B03, 0x847C, 0x4C60, 0x61B5, 0x5B03, 0x847C, 0x4C60,
+        0x6FDB, 0x774F, 0x971F, 0x5501, 0x7D5D, 0x9252, 0xA8E8, 0x5D3D, 0x61B5, 0x5B03, 0x847C, 0x4C60, 0x7D5D, 0x9252, 0xA8E8, 0x5D3D,
+        0x7125, 0x79E1, 0x98D0, 0x55C9, 0x6AB6, 0x6D05, 0x9058, 0x51DE, 0x7D5D, 0x9252, 0xA8E8, 0x5D3D, 0x7D5D, 0x9252, 0xA8E8, 0x5D3D,
+        0x5E7E, 0x5494, 0x8040, 0x4A6A, 0x5E7E, 0x5494, 0x8040, 0x4A6A, 0x6C00, 0x6F97, 0x9209, 0x52A6, 0x7A26, 0x8BE3, 0xA4AC, 0x5B47,
+        0x5E7E, 0x5494, 0x8040, 0x4A6A, 0x7A26, 0x8BE3, 0xA4AC, 0x5B47, 0x7838, 0x8808, 0xA222, 0x5A1A, 0x63A3, 0x5EDF, 0x8707, 0x4D8D,
+        0x7FEF, 0x9777, 0xAC4C, 0x5ECE, 0x7FEF, 0x9777, 0xAC4C, 0x5ECE, 0x5BEC, 0x4F6F, 0x7CDC, 0x48D9, 0x5BEC, 0x4F6F, 0x7CDC, 0x48D9,
+        0x696D, 0x6A72, 0x8EA6, 0x5115, 0x7793, 0x86BE, 0xA149, 0x59B5, 0x5BEC, 0x4F6F, 0x7CDC, 0x48D9, 0x7793, 0x86BE, 0xA149, 0x59B5,
+        0x7D5D, 0x9252, 0xA8E8, 0x5D3D, 0x5E7E, 0x5494, 0x8040, 0x4A6A, 0x8282, 0x9C9C, 0xAFAF, 0x6060, 0x8282, 0x9C9C, 0xAFAF, 0x6060,
+        0x5959, 0x4A4A, 0x7979, 0x4747, 0x5959, 0x4A4A, 0x7979, 0x4747, 0x66DA, 0x654D, 0x8B43, 0x4F83, 0x7501, 0x8199, 0x9DE5, 0x5824,
+        0x5959, 0x4A4A, 0x7979, 0x4747, 0x7501, 0x8199, 0x9DE5, 0x5824, 0x8282, 0x9C9C, 0xAFAF, 0x6060, 0x5959, 0x4A4A, 0x7979, 0x4747,
+    };
+
+    const uint16_t c_ldr_10x8[] =
+    {
+        0x3323, 0xF443, 0xBF73, 0x41B1, 0x38D9, 0xF3D3, 0xB3EB, 0x43E4, 0x3666, 0xF403, 0xB8DC, 0x42F3, 0x2BCC, 0xF4D4, 0xCE45, 0x3EDF,
+        0x3666, 0xF403, 0xB8DC, 0x42F3, 0x3181, 0xF463, 0xC2BE, 0x4111, 0x1D1D, 0xF5F5, 0xEBEB, 0x3939, 0x3181, 0xF463, 0xC2BE, 0x4111,
+        0x2FE0, 0xF484, 0xC609, 0x4070, 0x1D1D, 0xF5F5, 0xEBEB, 0x3939, 0x3181, 0xF463, 0xC2BE, 0x4111, 0x3595, 0xF413, 0xBA82, 0x42A2,
+        0x34C5, 0xF423, 0xBC27, 0x4252, 0x2C9C, 0xF4C4, 0xCCA0, 0x3F2F, 0x3808, 0xF3E3, 0xB591, 0x4393, 0x33F4, 0xF433, 0xBDCD, 0x4202,
+        0x1DEE, 0xF5E5, 0xEA45, 0x3989, 0x30B1, 0xF474, 0xC464, 0x40C1, 0x2F0F, 0xF494, 0xC7AF, 0x4020, 0x1DEE, 0xF5E5, 0xEA45, 0x3989,
+        0x2E3E, 0xF4A4, 0xC955, 0x3FD0, 0x3181, 0xF463, 0xC2BE, 0x4111, 0x3181, 0xF463, 0xC2BE, 0x4111, 0x2E3E, 0xF4A4, 0xC955, 0x3FD0,
+        0x3B4B, 0xF3A3, 0xAEFA, 0x44D5, 0x3737, 0xF3F3, 0xB737, 0x4343, 0x1F8F, 0xF5C5, 0xE6FA, 0x3A2A, 0x2E3E, 0xF4A4, 0xC955, 0x3FD0,
+        0x2C9C, 0xF4C4, 0xCCA0, 0x3F2F, 0x1F8F, 0xF5C5, 0xE6FA, 0x3A2A, 0x2C9C, 0xF4C4, 0xCCA0, 0x3F2F, 0x2D6D, 0xF4B4, 0xCAFA, 0x3F7F,
+        0x2E3E, 0xF4A4, 0xC955, 0x3FD0, 0x2F0F, 0xF494, 0xC7AF, 0x4020, 0x3E8E, 0xF362, 0xA864, 0x4616, 0x39A9, 0xF3C3, 0xB246, 0x4434,
+        0x2060, 0xF5B5, 0xE554, 0x3A7A, 0x2BCC, 0xF4D4, 0xCE45, 0x3EDF, 0x2BCC, 0xF4D4, 0xCE45, 0x3EDF, 0x2060, 0xF5B5, 0xE554, 0x3A7A,
+        0x2AFB, 0xF4E4, 0xCFEB, 0x3E8E, 0x2AFB, 0xF4E4, 0xCFEB, 0x3E8E, 0x2C9C, 0xF4C4, 0xCCA0, 0x3F2F, 0x2FE0, 0xF484, 0xC609, 0x4070,
+        0x4030, 0xF342, 0xA518, 0x46B6, 0x3B4B, 0xF3A3, 0xAEFA, 0x44D5, 0x2131, 0xF5A5, 0xE3AF, 0x3ACB, 0x2AFB, 0xF4E4, 0xCFEB, 0x3E8E,
+        0x2888, 0xF514, 0xD4DC, 0x3D9D, 0x2131, 0xF5A5, 0xE3AF, 0x3ACB, 0x2959, 0xF504, 0xD336, 0x3DEE, 0x26E7, 0xF534, 0xD827, 0x3CFD,
+        0x2888, 0xF514, 0xD4DC, 0x3D9D, 0x30B1, 0xF474, 0xC464, 0x40C1, 0x42A2, 0xF312, 0xA028, 0x47A7, 0x3E8E, 0xF362, 0xA864, 0x4616,
+        0x2202, 0xF595, 0xE209, 0x3B1B, 0x27B8, 0xF524, 0xD682, 0x3D4D, 0x27B8, 0xF524, 0xD682, 0x3D4D, 0x2202, 0xF595, 0xE209, 0x3B1B,
+        0x2616, 0xF544, 0xD9CD, 0x3CAC, 0x2202, 0xF595, 0xE209, 0x3B1B, 0x2545, 0xF554, 0xDB73, 0x3C5C, 0x3252, 0xF453, 0xC118, 0x4161,
+        0x45E6, 0xF2D2, 0x9991, 0x48E9, 0x41D2, 0xF322, 0xA1CD, 0x4757, 0x23A4, 0xF575, 0xDEBE, 0x3BBC, 0x2545, 0xF554, 0xDB73, 0x3C5C,
+        0x2545, 0xF554, 0xDB73, 0x3C5C, 0x23A4, 0xF575, 0xDEBE, 0x3BBC, 0x2474, 0xF564, 0xDD18, 0x3C0C, 0x1F8F, 0xF5C5, 0xE6FA, 0x3A2A,
+        0x23A4, 0xF575, 0xDEBE, 0x3BBC, 0x3323, 0xF443, 0xBF73, 0x41B1, 0x4787, 0xF2B2, 0x9646, 0x4989, 0x4373, 0xF302, 0x9E82, 0x47F8,
+        0x2474, 0xF564, 0xDD18, 0x3C0C, 0x2474, 0xF564, 0xDD18, 0x3C0C, 0x2474, 0xF564, 0xDD18, 0x3C0C, 0x2474, 0xF564, 0xDD18, 0x3C0C,
+    };
+
+    const uint16_t c_ldr_10x10[] =
+    {
+        0x4B6B, 0x7808, 0x6D7D, 0x4DBD, 0x4971, 0x6BBF, 0x7D71, 0x5A06, 0x4777, 0x5F77, 0x8D65, 0x664E, 0x4707, 0x5CBC, 0x90F0, 0x6909,
+        0x4777, 0x5F77, 0x8D65, 0x664E, 0x4890, 0x664A, 0x8488, 0x5F7B, 0x4A52, 0x7135, 0x765A, 0x5490, 0x4B6B, 0x7808, 0x6D7D, 0x4DBD,
+        0x4BDC, 0x7AC2, 0x69F2, 0x4B03, 0x4C4C, 0x7D7D, 0x6666, 0x4848, 0x4A1A, 0x6FD7, 0x7820, 0x55EE, 0x4858, 0x64ED, 0x864E, 0x60D8,
+        0x4696, 0x5A02, 0x947C, 0x6BC3, 0x46CF, 0x5B5F, 0x92B6, 0x6A66, 0x47AF, 0x60D4, 0x8B9F, 0x64F1, 0x4858, 0x64ED, 0x864E, 0x60D8,
+        0x49E2, 0x6E7A, 0x79E5, 0x574B, 0x4A8A, 0x7292, 0x7494, 0x5333, 0x4AFB, 0x754D, 0x7109, 0x5078, 0x4BA3, 0x7965, 0x6BB7, 0x4C60,
+        0x48C9, 0x67A7, 0x82C2, 0x5E1E, 0x473F, 0x5E1A, 0x8F2B, 0x67AB, 0x45EE, 0x55EA, 0x99CD, 0x6FDB, 0x4626, 0x5747, 0x9807, 0x6E7E,
+        0x4777, 0x5F77, 0x8D65, 0x664E, 0x4890, 0x664A, 0x8488, 0x5F7B, 0x4901, 0x6905, 0x80FC, 0x5CC0, 0x49A9, 0x6D1D, 0x7BAB, 0x58A8,
+        0x4A52, 0x7135, 0x765A, 0x5490, 0x4AFB, 0x754D, 0x7109, 0x5078, 0x4820, 0x638F, 0x8814, 0x6236, 0x4696, 0x5A02, 0x947C, 0x6BC3,
+        0x4545, 0x51D2, 0x9F1F, 0x73F4, 0x4626, 0x5747, 0x9807, 0x6E7E, 0x47AF, 0x60D4, 0x8B9F, 0x64F1, 0x4890, 0x664A, 0x8488, 0x5F7B,
+        0x4901, 0x6905, 0x80FC, 0x5CC0, 0x4939, 0x6A62, 0x7F37, 0x5B63, 0x49E2, 0x6E7A, 0x79E5, 0x574B, 0x4A8A, 0x7292, 0x7494, 0x5333,
+        0x46CF, 0x5B5F, 0x92B6, 0x6A66, 0x45B5, 0x548C, 0x9B93, 0x7139, 0x4464, 0x4C5C, 0xA636, 0x7969, 0x457D, 0x532F, 0x9D59, 0x7296,
+        0x47E8, 0x6232, 0x89D9, 0x6393, 0x4858, 0x64ED, 0x864E, 0x60D8, 0x4820, 0x638F, 0x8814, 0x6236, 0x4858, 0x64ED, 0x864E, 0x60D8,
+        0x4901, 0x6905, 0x80FC, 0x5CC0, 0x49E2, 0x6E7A, 0x79E5, 0x574B, 0x457D, 0x532F, 0x9D59, 0x7296, 0x449C, 0x4DB9, 0xA470, 0x780C,
+        0x43BB, 0x4844, 0xAB87, 0x7D81, 0x4545, 0x51D2, 0x9F1F, 0x73F4, 0x47AF, 0x60D4, 0x8B9F, 0x64F1, 0x4890, 0x664A, 0x8488, 0x5F7B,
+        0x47AF, 0x60D4, 0x8B9F, 0x64F1, 0x473F, 0x5E1A, 0x8F2B, 0x67AB, 0x4858, 0x64ED, 0x864E, 0x60D8, 0x4939, 0x6A62, 0x7F37, 0x5B63,
+        0x442C, 0x4AFF, 0xA7FB, 0x7AC6, 0x4383, 0x46E7, 0xAD4D, 0x7EDE, 0x4313, 0x442C, 0xB0D8, 0x8199, 0x4464, 0x4C5C, 0xA636, 0x7969,
+        0x47E8, 0x6232, 0x89D9, 0x6393, 0x4820, 0x638F, 0x8814, 0x6236, 0x46CF, 0x5B5F, 0x92B6, 0x6A66, 0x465E, 0x58A4, 0x9642, 0x6D21,
+        0x4777, 0x5F77, 0x8D65, 0x664E, 0x4890, 0x664A, 0x8488, 0x5F7B, 0x4383, 0x46E7, 0xAD4D, 0x7EDE, 0x42DB, 0x42CF, 0xB29E, 0x82F6,
+        0x42A2, 0x4171, 0xB464, 0x8454, 0x449C, 0x4DB9, 0xA470, 0x780C, 0x47E8, 0x6232, 0x89D9, 0x6393, 0x4858, 0x64ED, 0x864E, 0x60D8,
+        0x46CF, 0x5B5F, 0x92B6, 0x6A66, 0x45EE, 0x55EA, 0x99CD, 0x6FDB, 0x4707, 0x5CBC, 0x90F0, 0x6909, 0x4820, 0x638F, 0x8814, 0x6236,
+        0x4232, 0x3EB6, 0xB7EF, 0x870F, 0x41FA, 0x3D59, 0xB9B5, 0x886C, 0x4189, 0x3A9E, 0xBD41, 0x8B27, 0x43F4, 0x49A1, 0xA9C1, 0x7C24,
+        0x47AF, 0x60D4, 0x8B9F, 0x64F1, 0x47E8, 0x6232, 0x89D9, 0x6393, 0x45EE, 0x55EA, 0x99CD, 0x6FDB, 0x450D, 0x5074, 0xA0E4, 0x7551,
+        0x465E, 0x58A4, 0x9642, 0x6D21, 0x4777, 0x5F77, 0x8D65, 0x664E, 0x40E1, 0x3686, 0xC292, 0x8F3F, 0x40E1, 0x3686, 0xC292, 0x8F3F,
+        0x40E1, 0x3686, 0xC292, 0x8F3F, 0x4383, 0x46E7, 0xAD4D, 0x7EDE, 0x47E8, 0x6232, 0x89D9, 0x6393, 0x4820, 0x638F, 0x8814, 0x6236,
+        0x457D, 0x532F, 0x9D59, 0x7296, 0x442C, 0x4AFF, 0xA7FB, 0x7AC6, 0x457D, 0x532F, 0x9D59, 0x7296, 0x46CF, 0x5B5F, 0x92B6, 0x6A66,
+    };
+
+    const uint16_t c_ldr_12x10[] =
+    {
+        0xAA5E, 0x2575, 0x7757, 0xC0F8, 0x92FA, 0x3BDC, 0x6A2A, 0xDD4C, 0xB8D8, 0x1798, 0x7F7F, 0xAF6F, 0xC1C1, 0x0F0F, 0x8484, 0xA4A4,
+        0xB347, 0x1CED, 0x7C5C, 0xB62D, 0x8FA3, 0x3F0F, 0x6848, 0xE158, 0x8480, 0x49B9, 0x6202, 0xEED6, 0x91DD, 0x3CED, 0x6989, 0xDEA6,
+        0x988C, 0x3686, 0x6D4D, 0xD68E, 0xAA5E, 0x2575, 0x7757, 0xC0F8, 0xAB7B, 0x2464, 0x77F8, 0xBF9F, 0xC1C1, 0x0F0F, 0x8484, 0xA4A4,
+        0xA4CC, 0x2ACB, 0x7434, 0xC7B7, 0x9652, 0x38A8, 0x6C0C, 0xD940, 0xB347, 0x1CED, 0x7C5C, 0xB62D, 0xBE6A, 0x1242, 0x82A2, 0xA8B0,
+        0xAFEF, 0x2020, 0x7A7A, 0xBA3A, 0x8FA3, 0x3F0F, 0x6848, 0xE158, 0x88F4, 0x4575, 0x6484, 0xE971, 0x92FA, 0x3BDC, 0x6A2A, 0xDD4C,
+        0x9652, 0x38A8, 0x6C0C, 0xD940, 0xAA5E, 0x2575, 0x7757, 0xC0F8, 0xA941, 0x2686, 0x76B6, 0xC252, 0xB8D8, 0x1798, 0x7F7F, 0xAF6F,
+        0x9E1E, 0x3131, 0x7070, 0xCFCF, 0x99A9, 0x3575, 0x6DEE, 0xD534, 0xB10C, 0x1F0F, 0x7B1B, 0xB8E0, 0xB9F5, 0x1686, 0x8020, 0xAE15,
+        0xAC98, 0x2353, 0x7898, 0xBE46, 0x8FA3, 0x3F0F, 0x6848, 0xE158, 0x8D69, 0x4131, 0x6707, 0xE40B, 0x9535, 0x39BA, 0x6B6B, 0xDA9A,
+        0x9418, 0x3ACB, 0x6ACA, 0xDBF3, 0xA941, 0x2686, 0x76B6, 0xC252, 0xA5E9, 0x29BA, 0x74D4, 0xC65E, 0xAFEF, 0x2020, 0x7A7A, 0xBA3A,
+        0x9BE3, 0x3353, 0x6F2F, 0xD282, 0x9AC6, 0x3464, 0x6E8E, 0xD3DB, 0xAED2, 0x2131, 0x79D9, 0xBB93, 0xB8D8, 0x1798, 0x7F7F, 0xAF6F,
+        0xAB7B, 0x2464, 0x77F8, 0xBF9F, 0x90C0, 0x3DFE, 0x68E9, 0xDFFF, 0x8FA3, 0x3F0F, 0x6848, 0xE158, 0x976F, 0x3797, 0x6CAC, 0xD7E7,
+        0x91DD, 0x3CED, 0x6989, 0xDEA6, 0xA941, 0x2686, 0x76B6, 0xC252, 0xA3AF, 0x2BDC, 0x7393, 0xC910, 0xAB7B, 0x2464, 0x77F8, 0xBF9F,
+        0x9535, 0x39BA, 0x6B6B, 0xDA9A, 0x9E1E, 0x3131, 0x7070, 0xCFCF, 0xA823, 0x2797, 0x7616, 0xC3AB, 0xB464, 0x1BDC, 0x7CFD, 0xB4D4,
+        0xA823, 0x2797, 0x7616, 0xC3AB, 0x90C0, 0x3DFE, 0x68E9, 0xDFFF, 0x9418, 0x3ACB, 0x6ACA, 0xDBF3, 0x99A9, 0x3575, 0x6DEE, 0xD534,
+        0x90C0, 0x3DFE, 0x68E9, 0xDFFF, 0xA941, 0x2686, 0x76B6, 0xC252, 0xA175, 0x2DFE, 0x7252, 0xCBC3, 0xA292, 0x2CED, 0x72F3, 0xCA6A,
+        0x8FA3, 0x3F0F, 0x6848, 0xE158, 0x9D00, 0x3242, 0x6FCF, 0xD128, 0xA706, 0x28A9, 0x7575, 0xC504, 0xB10C, 0x1F0F, 0x7B1B, 0xB8E0,
+        0xA5E9, 0x29BA, 0x74D4, 0xC65E, 0x90C0, 0x3DFE, 0x68E9, 0xDFFF, 0x988C, 0x3686, 0x6D4D, 0xD68E, 0x9F3B, 0x3020, 0x7111, 0xCE76,
+        0x8D69, 0x4131, 0x6707, 0xE40B, 0xA706, 0x28A9, 0x7575, 0xC504, 0x9AC6, 0x3464, 0x6E8E, 0xD3DB, 0x99A9, 0x3575, 0x6DEE, 0xD534,
+        0x88F4, 0x4575, 0x6484, 0xE971, 0x9F3B, 0x3020, 0x7111, 0xCE76, 0xA175, 0x2DFE, 0x7252, 0xCBC3, 0xAC98, 0x2353, 0x7898, 0xBE46,
+        0xA292, 0x2CED, 0x72F3, 0xCA6A, 0x90C0, 0x3DFE, 0x68E9, 0xDFFF, 0x9D00, 0x3242, 0x6FCF, 0xD128, 0xA175, 0x2DFE, 0x7252, 0xCBC3,
+        0x8C4C, 0x4242, 0x6666, 0xE565, 0xA706, 0x28A9, 0x7575, 0xC504, 0x988C, 0x3686, 0x6D4D, 0xD68E, 0x90C0, 0x3DFE, 0x68E9, 0xDFFF,
+        0x86BA, 0x4797, 0x6343, 0xEC23, 0xA175, 0x2DFE, 0x7252, 0xCBC3, 0x9E1E, 0x3131, 0x7070, 0xCFCF, 0xAB7B, 0x2464, 0x77F8, 0xBF9F,
+        0xA175, 0x2DFE, 0x7252, 0xCBC3, 0x91DD, 0x3CED, 0x6989, 0xDEA6, 0x9E1E, 0x3131, 0x7070, 0xCFCF, 0x9F3B, 0x3020, 0x7111, 0xCE76,
+        0x8B2F, 0x4353, 0x65C5, 0xE6BE, 0xA706, 0x28A9, 0x7575, 0xC504, 0x9652, 0x38A8, 0x6C0C, 0xD940, 0x8C4C, 0x4242, 0x6666, 0xE565,
+        0x800C, 0x4DFE, 0x5F7F, 0xF43B, 0xA4CC, 0x2ACB, 0x7434, 0xC7B7, 0x9D00, 0x3242, 0x6FCF, 0xD128, 0xA941, 0x2686, 0x76B6, 0xC252,
+        0x9E1E, 0x3131, 0x7070, 0xCFCF, 0x91DD, 0x3CED, 0x6989, 0xDEA6, 0xA292, 0x2CED, 0x72F3, 0xCA6A, 0xA5E9, 0x29BA, 0x74D4, 0xC65E,
+        0x88F4, 0x4575, 0x6484, 0xE971, 0xA5E9, 0x29BA, 0x74D4, 0xC65E, 0x92FA, 0x3BDC, 0x6A2A, 0xDD4C, 0x8363, 0x4ACB, 0x6161, 0xF02F,
+        0x7A7A, 0x5353, 0x5C5C, 0xFAFA, 0xA706, 0x28A9, 0x7575, 0xC504, 0x9652, 0x38A8, 0x6C0C, 0xD940, 0xA4CC, 0x2ACB, 0x7434, 0xC7B7,
+        0x9AC6, 0x3464, 0x6E8E, 0xD3DB, 0x91DD, 0x3CED, 0x6989, 0xDEA6, 0xA706, 0x28A9, 0x7575, 0xC504, 0xA706, 0x28A9, 0x7575, 0xC504,
+        0x86BA, 0x4797, 0x6343, 0xEC23, 0xA5E9, 0x29BA, 0x74D4, 0xC65E, 0x90C0, 0x3DFE, 0x68E9, 0xDFFF, 0x7A7A, 0x5353, 0x5C5C, 0xFAFA,
+    };
+
+    const uint16_t c_ldr_12x12[] =
+    {
+        0xA561, 0xA3BB, 0x60B4, 0x6787, 0x9490, 0x8018, 0x4458, 0x8DAD, 0x8B1B, 0x6C0C, 0x3464, 0xA323, 0xABAF, 0xB118, 0x6B57, 0x5939,
+        0xBE9A, 0xD930, 0x8B3F, 0x2E4E, 0xB417, 0xC2EA, 0x7985, 0x4626, 0xACBC, 0xB353, 0x6D1D, 0x56D7, 0xA77B, 0xA830, 0x6440, 0x62C2,
+        0xACBC, 0xB353, 0x6D1D, 0x56D7, 0xB631, 0xC75F, 0x7D11, 0x4161, 0xA77B, 0xA830, 0x6440, 0x62C2, 0x9169, 0x7969, 0x3F07, 0x94D4,
+        0xA66E, 0xA5F5, 0x627A, 0x6525, 0x959D, 0x8252, 0x461E, 0x8B4B, 0x8C28, 0x6E46, 0x362A, 0xA0C0, 0xA995, 0xACA4, 0x67CB, 0x5DFE,
+        0xBB73, 0xD282, 0x85ED, 0x3575, 0xB30A, 0xC0B0, 0x77BF, 0x4888, 0xABAF, 0xB118, 0x6B57, 0x5939, 0xA66E, 0xA5F5, 0x627A, 0x6525,
+        0xABAF, 0xB118, 0x6B57, 0x5939, 0xB524, 0xC524, 0x7B4B, 0x43C4, 0xA66E, 0xA5F5, 0x627A, 0x6525, 0x9383, 0x7DDD, 0x4292, 0x9010,
+        0xA77B, 0xA830, 0x6440, 0x62C2, 0x96AA, 0x848C, 0x47E4, 0x88E8, 0x8D35, 0x7080, 0x37F0, 0x9E5E, 0xA77B, 0xA830, 0x6440, 0x62C2,
+        0xB84C, 0xCBD3, 0x809C, 0x3C9C, 0xAFE3, 0xBA01, 0x726E, 0x4FAF, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xA454, 0xA181, 0x5EEF, 0x69EA,
+        0xA888, 0xAA6A, 0x6606, 0x6060, 0xB1FD, 0xBE76, 0x75FA, 0x4AEB, 0xA66E, 0xA5F5, 0x627A, 0x6525, 0x96AA, 0x848C, 0x47E4, 0x88E8,
+        0xA77B, 0xA830, 0x6440, 0x62C2, 0x97B7, 0x86C6, 0x49A9, 0x8686, 0x8E42, 0x72BA, 0x39B5, 0x9BFB, 0xA561, 0xA3BB, 0x60B4, 0x6787,
+        0xB631, 0xC75F, 0x7D11, 0x4161, 0xAFE3, 0xBA01, 0x726E, 0x4FAF, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xA347, 0x9F47, 0x5D29, 0x6C4C,
+        0xA77B, 0xA830, 0x6440, 0x62C2, 0xB0F0, 0xBC3C, 0x7434, 0x4D4D, 0xA888, 0xAA6A, 0x6606, 0x6060, 0x98C4, 0x8900, 0x4B6F, 0x8424,
+        0xA888, 0xAA6A, 0x6606, 0x6060, 0x98C4, 0x8900, 0x4B6F, 0x8424, 0x8F4F, 0x74F5, 0x3B7B, 0x9999, 0xA347, 0x9F47, 0x5D29, 0x6C4C,
+        0xB1FD, 0xBE76, 0x75FA, 0x4AEB, 0xADC9, 0xB58D, 0x6EE2, 0x5474, 0xA77B, 0xA830, 0x6440, 0x62C2, 0xA020, 0x9898, 0x57D8, 0x7373,
+        0xA561, 0xA3BB, 0x60B4, 0x6787, 0xAED6, 0xB7C7, 0x70A8, 0x5212, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0x9CF8, 0x91E9, 0x5286, 0x7A9A,
+        0xA995, 0xACA4, 0x67CB, 0x5DFE, 0x98C4, 0x8900, 0x4B6F, 0x8424, 0x8F4F, 0x74F5, 0x3B7B, 0x9999, 0xA454, 0xA181, 0x5EEF, 0x69EA,
+        0xAED6, 0xB7C7, 0x70A8, 0x5212, 0xABAF, 0xB118, 0x6B57, 0x5939, 0xA77B, 0xA830, 0x6440, 0x62C2, 0x9F12, 0x965E, 0x5612, 0x75D5,
+        0xA454, 0xA181, 0x5EEF, 0x69EA, 0xADC9, 0xB58D, 0x6EE2, 0x5474, 0xA888, 0xAA6A, 0x6606, 0x6060, 0x9E05, 0x9424, 0x544C, 0x7838,
+        0xAAA2, 0xAEDE, 0x6991, 0x5B9B, 0x99D1, 0x8B3B, 0x4D35, 0x81C1, 0x8E42, 0x72BA, 0x39B5, 0x9BFB, 0x9F12, 0x965E, 0x5612, 0x75D5,
+        0xABAF, 0xB118, 0x6B57, 0x5939, 0xAAA2, 0xAEDE, 0x6991, 0x5B9B, 0xA561, 0xA3BB, 0x60B4, 0x6787, 0x9CF8, 0x91E9, 0x5286, 0x7A9A,
+        0xA12D, 0x9AD2, 0x599D, 0x7111, 0xABAF, 0xB118, 0x6B57, 0x5939, 0xA888, 0xAA6A, 0x6606, 0x6060, 0xA23A, 0x9D0C, 0x5B63, 0x6EAE,
+        0xABAF, 0xB118, 0x6B57, 0x5939, 0x9ADE, 0x8D75, 0x4EFB, 0x7F5F, 0x8E42, 0x72BA, 0x39B5, 0x9BFB, 0xA020, 0x9898, 0x57D8, 0x7373,
+        0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xA454, 0xA181, 0x5EEF, 0x69EA, 0x9BEB, 0x8FAF, 0x50C0, 0x7CFD,
+        0xA020, 0x9898, 0x57D8, 0x7373, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xA77B, 0xA830, 0x6440, 0x62C2, 0xA454, 0xA181, 0x5EEF, 0x69EA,
+        0xACBC, 0xB353, 0x6D1D, 0x56D7, 0x9BEB, 0x8FAF, 0x50C0, 0x7CFD, 0x8F4F, 0x74F5, 0x3B7B, 0x9999, 0x9ADE, 0x8D75, 0x4EFB, 0x7F5F,
+        0xA454, 0xA181, 0x5EEF, 0x69EA, 0xA77B, 0xA830, 0x6440, 0x62C2, 0xA347, 0x9F47, 0x5D29, 0x6C4C, 0x99D1, 0x8B3B, 0x4D35, 0x81C1,
+        0x9E05, 0x9424, 0x544C, 0x7838, 0xA77B, 0xA830, 0x6440, 0x62C2, 0xA888, 0xAA6A, 0x6606, 0x6060, 0xA77B, 0xA830, 0x6440, 0x62C2,
+        0xACBC, 0xB353, 0x6D1D, 0x56D7, 0x9CF8, 0x91E9, 0x5286, 0x7A9A, 0x905C, 0x772F, 0x3D41, 0x9737, 0x9BEB, 0x8FAF, 0x50C0, 0x7CFD,
+        0xA23A, 0x9D0C, 0x5B63, 0x6EAE, 0xA66E, 0xA5F5, 0x627A, 0x6525, 0xA347, 0x9F47, 0x5D29, 0x6C4C, 0x98C4, 0x8900, 0x4B6F, 0x8424,
+        0x9CF8, 0x91E9, 0x5286, 0x7A9A, 0xA66E, 0xA5F5, 0x627A, 0x6525, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xA995, 0xACA4, 0x67CB, 0x5DFE,
+        0xADC9, 0xB58D, 0x6EE2, 0x5474, 0x9E05, 0x9424, 0x544C, 0x7838, 0x9169, 0x7969, 0x3F07, 0x94D4, 0x99D1, 0x8B3B, 0x4D35, 0x81C1,
+        0x9F12, 0x965E, 0x5612, 0x75D5, 0xA347, 0x9F47, 0x5D29, 0x6C4C, 0xA12D, 0x9AD2, 0x599D, 0x7111, 0x96AA, 0x848C, 0x47E4, 0x88E8,
+        0x99D1, 0x8B3B, 0x4D35, 0x81C1, 0xA454, 0xA181, 0x5EEF, 0x69EA, 0xAAA2, 0xAEDE, 0x6991, 0x5B9B, 0xACBC, 0xB353, 0x6D1D, 0x56D7,
+        0xAED6, 0xB7C7, 0x70A8, 0x5212, 0x9E05, 0x9424, 0x544C, 0x7838, 0x9276, 0x7BA3, 0x40CD, 0x9272, 0x97B7, 0x86C6, 0x49A9, 0x8686,
+        0x9CF8, 0x91E9, 0x5286, 0x7A9A, 0xA347, 0x9F47, 0x5D29, 0x6C4C, 0xA020, 0x9898, 0x57D8, 0x7373, 0x959D, 0x8252, 0x461E, 0x8B4B,
+        0x98C4, 0x8900, 0x4B6F, 0x8424, 0xA347, 0x9F47, 0x5D29, 0x6C4C, 0xA995, 0xACA4, 0x67CB, 0x5DFE, 0xAED6, 0xB7C7, 0x70A8, 0x5212,
+    };
+
+    const uint16_t c_ldr_blue_contract[] =
+    {
+        0x1414, 0x1919, 0x1E1E, 0xFFFF, 0x1414, 0x1919, 0x1E1E, 0xFFFF, 0x2000, 0x2414, 0x2A0A, 0xFFFF, 0x46BE, 0x47C3, 0x50C8, 0xFFFF,
+        0x825A, 0x7EAA, 0x8C64, 0xFFFF, 0xD2D2, 0xC8C8, 0xDCDC, 0xFFFF, 0x8B4B, 0x86E6, 0x9555, 0xFFFF, 0x5B9B, 0x5AFB, 0x65A5, 0xFFFF,
+        0x3DCE, 0x3F87, 0x47D8, 0xFFFF, 0x4FAF, 0x5000, 0x59B9, 0xFFFF, 0x825A, 0x7EAA, 0x8C64, 0xFFFF, 0xD2D2, 0xC8C8, 0xDCDC, 0xFFFF,
+        0xC6E6, 0xBDCD, 0xD0F0, 0xFFFF, 0x7F5F, 0x7BEB, 0x8969, 0xFFFF, 0x52AA, 0x52BE, 0x5CB4, 0xFFFF, 0x52AA, 0x52BE, 0x5CB4, 0xFFFF,
+        0x825A, 0x7EAA, 0x8C64, 0xFFFF, 0xD2D2, 0xC8C8, 0xDCDC, 0xFFFF, 0xA028, 0x9A1E, 0xAA32, 0xFFFF, 0x7078, 0x6E32, 0x7A82, 0xFFFF,
+        0x52AA, 0x52BE, 0x5CB4, 0xFFFF, 0x52AA, 0x52BE, 0x5CB4, 0xFFFF, 0x825A, 0x7EAA, 0x8C64, 0xFFFF, 0xD2D2, 0xC8C8, 0xDCDC, 0xFFFF,
+        0x648C, 0x6337, 0x6E96, 0xFFFF, 0x4CB4, 0x4D41, 0x56BE, 0xFFFF, 0x43C4, 0x4505, 0x4DCE, 0xFFFF, 0x648C, 0x6337, 0x6E96, 0xFFFF,
+        0x8B4B, 0x86E6, 0x9555, 0xFFFF, 0xBAFA, 0xB2D2, 0xC504, 0xFFFF, 0x1414, 0x1919, 0x1E1E, 0xFFFF, 0x1414, 0x1919, 0x1E1E, 0xFFFF,
+        0x2BEC, 0x2F0F, 0x35F6, 0xFFFF, 0x7C64, 0x792D, 0x866E, 0xFFFF, 0x943C, 0x8F23, 0x9E46, 0xFFFF, 0x943C, 0x8F23, 0x9E46, 0xFFFF,
+    };
+
+    const uint16_t c_ldr_srgb[] =
+    {
+        0x3F80, 0xDC80, 0x1880, 0xA680, 0x3F80, 0xDC80, 0x1880, 0xA680, 0x4B00, 0xDCE0, 0x1FA0, 0x9F60, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50,
+        0x9B80, 0xDF80, 0x5180, 0x6D80, 0x9B80, 0xDF80, 0x5180, 0x6D80, 0x9B80, 0xDF80, 0x5180, 0x6D80, 0x9B80, 0xDF80, 0x5180, 0x6D80,
+        0x7340, 0xDE30, 0x3890, 0x8670, 0x5680, 0xDD40, 0x26C0, 0x9840, 0x4B00, 0xDCE0, 0x1FA0, 0x9F60, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50,
+        0x8A40, 0xDEF0, 0x46D0, 0x7830, 0x6D80, 0xDE00, 0x3500, 0x8A00, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50, 0x9B80, 0xDF80, 0x5180, 0x6D80,
+        0x9000, 0xDF20, 0x4A60, 0x74A0, 0x67C0, 0xDDD0, 0x3170, 0x8D90, 0x5680, 0xDD40, 0x26C0, 0x9840, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50,
+        0x7EC0, 0xDE90, 0x3FB0, 0x7F50, 0x5680, 0xDD40, 0x26C0, 0x9840, 0x67C0, 0xDDD0, 0x3170, 0x8D90, 0x9000, 0xDF20, 0x4A60, 0x74A0,
+        0x5C40, 0xDD70, 0x2A50, 0x94B0, 0x6D80, 0xDE00, 0x3500, 0x8A00, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50, 0x6200, 0xDDA0, 0x2DE0, 0x9120,
+        0x6200, 0xDDA0, 0x2DE0, 0x9120, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50, 0x6D80, 0xDE00, 0x3500, 0x8A00, 0x5C40, 0xDD70, 0x2A50, 0x94B0,
+        0x5C40, 0xDD70, 0x2A50, 0x94B0, 0x6D80, 0xDE00, 0x3500, 0x8A00, 0x7900, 0xDE60, 0x3C20, 0x82E0, 0x50C0, 0xDD10, 0x2330, 0x9BD0,
+        0x50C0, 0xDD10, 0x2330, 0x9BD0, 0x7900, 0xDE60, 0x3C20, 0x82E0, 0x6D80, 0xDE00, 0x3500, 0x8A00, 0x5C40, 0xDD70, 0x2A50, 0x94B0,
+        0x9000, 0xDF20, 0x4A60, 0x74A0, 0x67C0, 0xDDD0, 0x3170, 0x8D90, 0x4B00, 0xDCE0, 0x1FA0, 0x9F60, 0x4540, 0xDCB0, 0x1C10, 0xA2F0,
+        0x4540, 0xDCB0, 0x1C10, 0xA2F0, 0x4B00, 0xDCE0, 0x1FA0, 0x9F60, 0x67C0, 0xDDD0, 0x3170, 0x8D90, 0x9000, 0xDF20, 0x4A60, 0x74A0,
+        0x9B80, 0xDF80, 0x5180, 0x6D80, 0x7EC0, 0xDE90, 0x3FB0, 0x7F50, 0x6200, 0xDDA0, 0x2DE0, 0x9120, 0x4B00, 0xDCE0, 0x1FA0, 0x9F60,
+        0x4B00, 0xDCE0, 0x1FA0, 0x9F60, 0x6200, 0xDDA0, 0x2DE0, 0x9120, 0x6D80, 0xDE00, 0x3500, 0x8A00, 0x7340, 0xDE30, 0x3890, 0x8670,
+        0x9B80, 0xDF80, 0x5180, 0x6D80, 0x9B80, 0xDF80, 0x5180, 0x6D80, 0x9000, 0xDF20, 0x4A60, 0x74A0, 0x5C40, 0xDD70, 0x2A50, 0x94B0,
+        0x5C40, 0xDD70, 0x2A50, 0x94B0, 0x9000, 0xDF20, 0x4A60, 0x74A0, 0x7340, 0xDE30, 0x3890, 0x8670, 0x3F80, 0xDC80, 0x1880, 0xA680,
+    };
+
+    const uint16_t c_ldr_dual_plane[] =
+    {
+        0x2C2C, 0xC1C1, 0xBEBE, 0x9C9C, 0x7121, 0x6EBE, 0x9EAE, 0x9C9C, 0xB615, 0x1BBC, 0x7E9E, 0x9C9C, 0x9888, 0x3F4F, 0x8C5C, 0x9C9C,
+        0x5D6D, 0x8676, 0xA7D7, 0x9C9C, 0x2C2C, 0xC1C1, 0xBEBE, 0x9858, 0x2C2C, 0xC1C1, 0xBEBE, 0x8969, 0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x91F1, 0x7121, 0x6EBE, 0x9EAE, 0x91F1, 0xB615, 0x1BBC, 0x7E9E, 0x91F1, 0x9888, 0x3F4F, 0x8C5C, 0x9636,
+        0x5D6D, 0x8676, 0xA7D7, 0x9858, 0x2C2C, 0xC1C1, 0xBEBE, 0x9858, 0x2C2C, 0xC1C1, 0xBEBE, 0x8969, 0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x8969, 0x7121, 0x6EBE, 0x9EAE, 0x8969, 0xB615, 0x1BBC, 0x7E9E, 0x8969, 0x9888, 0x3F4F, 0x8C5C, 0x8FCF,
+        0x5D6D, 0x8676, 0xA7D7, 0x9636, 0x2C2C, 0xC1C1, 0xBEBE, 0x9858, 0x2C2C, 0xC1C1, 0xBEBE, 0x8969, 0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x7EBE, 0x7121, 0x6EBE, 0x9EAE, 0x7EBE, 0xB615, 0x1BBC, 0x7E9E, 0x7EBE, 0x9888, 0x3F4F, 0x8C5C, 0x8747,
+        0x5D6D, 0x8676, 0xA7D7, 0x9414, 0x2C2C, 0xC1C1, 0xBEBE, 0x9858, 0x2C2C, 0xC1C1, 0xBEBE, 0x8969, 0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A, 0x7121, 0x6EBE, 0x9EAE, 0x7A7A, 0xB615, 0x1BBC, 0x7E9E, 0x7A7A, 0x9888, 0x3F4F, 0x8C5C, 0x8525,
+        0x5D6D, 0x8676, 0xA7D7, 0x91F1, 0x2C2C, 0xC1C1, 0xBEBE, 0x9858, 0x3606, 0xB5E5, 0xBA29, 0x8B8B, 0x3FE0, 0xAA09, 0xB595, 0x7EBE,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A, 0x7121, 0x6EBE, 0x9EAE, 0x7A7A, 0xB615, 0x1BBC, 0x7E9E, 0x7A7A, 0x9888, 0x3F4F, 0x8C5C, 0x8525,
+        0x5D6D, 0x8676, 0xA7D7, 0x91F1, 0x3606, 0xB5E5, 0xBA29, 0x9A7A, 0x5393, 0x9252, 0xAC6C, 0x91F1, 0x7121, 0x6EBE, 0x9EAE, 0x8969,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A, 0x7121, 0x6EBE, 0x9EAE, 0x7A7A, 0xB615, 0x1BBC, 0x7E9E, 0x7A7A, 0x9888, 0x3F4F, 0x8C5C, 0x8525,
+        0x5D6D, 0x8676, 0xA7D7, 0x91F1, 0x3606, 0xB5E5, 0xBA29, 0x9A7A, 0x6747, 0x7A9A, 0xA343, 0x9636, 0x9888, 0x3F4F, 0x8C5C, 0x91F1,
+        0x2C2C, 0xC1C1, 0xBEBE, 0x7A7A, 0x7121, 0x6EBE, 0x9EAE, 0x7A7A, 0xB615, 0x1BBC, 0x7E9E, 0x7A7A, 0x9888, 0x3F4F, 0x8C5C, 0x8525,
+        0x5D6D, 0x8676, 0xA7D7, 0x91F1, 0x3FE0, 0xAA09, 0xB595, 0x9C9C, 0x84D4, 0x5707, 0x9585, 0x9C9C, 0xC9C9, 0x0404, 0x7575, 0x9C9C,
+    };
+
+    const uint16_t c_ldr_two_partitions[] =
+    {
+        0xE5E5, 0x7373, 0xCBCB, 0xFFFF, 0x6161, 0x2CAD, 0xDDDD, 0xFFFF, 0x5E9E, 0x37E4, 0xE6D6, 0xFFFF, 0xAEEE, 0xB4F4, 0xD7D7, 0xFFFF,
+        0x9C9C, 0xCACA, 0xDBDB, 0xFFFF, 0x6969, 0x0C0C, 0xC3C3, 0xFFFF, 0x6424, 0x2175, 0xD4E4, 0xFFFF, 0x5E5E, 0x38E9, 0xE7A7, 0xFFFF,
+        0xA256, 0xC3F7, 0xDA9A, 0xFFFF, 0x9C9C, 0xCACA, 0xDBDB, 0xFFFF, 0x6464, 0x2070, 0xD413, 0xFFFF, 0x6323, 0x2589, 0xD827, 0xFFFF,
+        0xB6F2, 0xAB67, 0xD615, 0xFFFF, 0xA6EA, 0xBE82, 0xD999, 0xFFFF, 0xB383, 0xAF7F, 0xD6D6, 0xFFFF, 0x5959, 0x4D4D, 0xF7F7, 0xFFFF,
+        0x5D5D, 0x3CFD, 0xEAEA, 0xFFFF, 0xB4A8, 0xAE21, 0xD696, 0xFFFF, 0xC141, 0x9F1F, 0xD3D3, 0xFFFF, 0xE5E5, 0x7373, 0xCBCB, 0xFFFF,
+    };
+
+    const uint16_t c_hdr_rgb_direct[] =
+    {
+        0x2000, 0x1000, 0x3000, 0x3C00, 0x3030, 0x26E8, 0x4DC0, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00,
+        0x3030, 0x26E8, 0x4DC0, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00,
+        0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00,
+        0x39C0, 0x34C0, 0x6000, 0x3C00, 0x2980, 0x1DA0, 0x41C0, 0x3C00, 0x24A8, 0x16B0, 0x38C0, 0x3C00, 0x34E0, 0x2DD0, 0x56C0, 0x3C00,
+        0x3030, 0x26E8, 0x4DC0, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x3030, 0x26E8, 0x4DC0, 0x3C00,
+        0x39C0, 0x34C0, 0x6000, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00, 0x3030, 0x26E8, 0x4DC0, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00,
+        0x39C0, 0x34C0, 0x6000, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00,
+        0x39C0, 0x34C0, 0x6000, 0x3C00, 0x39C0, 0x34C0, 0x6000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00,
+        0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00, 0x2000, 0x1000, 0x3000, 0x3C00,
+    };
+
+    // Expected values are UNORM16 for LDR blocks and FP16 bits for HDR blocks,
+    // RGBA per texel in row-major order over the footprint
+    const ASTCKnownAnswer c_astcKnownAnswers[] =
+    {
+        { "ldr_4x4", VK_FORMAT_ASTC_4x4_UNORM_BLOCK, false,
+          { 0x22, 0x80, 0x01, 0x7D, 0xF4, 0xB2, 0xAD, 0x70, 0x19, 0xBB, 0x00, 0x00, 0x00, 0x82, 0x75, 0x0C },
+          c_ldr_4x4 },
+        { "ldr_5x4", VK_FORMAT_ASTC_5x4_UNORM_BLOCK, false,
+          { 0xB3, 0x80, 0x25, 0x90, 0x0D, 0xA0, 0x91, 0xF7, 0x7E, 0xC9, 0x68, 0x69, 0xD9, 0xAC, 0x21, 0x18 },
+          c_ldr_5x4 },
+        { "ldr_5x5", VK_FORMAT_ASTC_5x5_UNORM_BLOCK, false,
+          { 0x82, 0x82, 0x4D, 0x7D, 0xA3, 0x74, 0x8F, 0xFF, 0x45, 0xC7, 0x00, 0x3F, 0x98, 0xB3, 0x2C, 0x33 },
+          c_ldr_5x5 },
+        { "ldr_6x5", VK_FORMAT_ASTC_6x5_UNORM_BLOCK, false,
+          { 0x22, 0x81, 0x01, 0x3F, 0x80, 0x6A, 0x97, 0x72, 0x15, 0xEB, 0x01, 0xD0, 0xEA, 0x5E, 0x6B, 0x67 },
+          c_ldr_6x5 },
+        { "ldr_6x6", VK_FORMAT_ASTC_6x6_UNORM_BLOCK, false,
+          { 0x13, 0x81, 0x15, 0xB0, 0x4A, 0x25, 0xF0, 0x15, 0xE0, 0x02, 0x01, 0x20, 0xDF, 0xC3, 0xDB, 0xC2 },
+          c_ldr_6x6 },
+        { "ldr_8x5", VK_FORMAT_ASTC_8x5_UNORM_BLOCK, false,
+          { 0x82, 0x82, 0x49, 0x7B, 0x6F, 0xD1, 0x99, 0x92, 0x24, 0x7A, 0x00, 0x12, 0xC6, 0x1F, 0xB6, 0x42 },
+          c_ldr_8x5 },
+        { "ldr_8x6", VK_FORMAT_ASTC_8x6_UNORM_BLOCK, false,
+          { 0x06, 0x80, 0xA9, 0x56, 0xB3, 0xB6, 0x82, 0x60, 0x36, 0xDA, 0x00, 0x00, 0xB5, 0xC2, 0x36, 0xD2 },
+          c_ldr_8x6 },
+        { "ldr_8x8", VK_FORMAT_ASTC_8x8_UNORM_BLOCK, false,
+          { 0x93, 0x81, 0x5F, 0x76, 0x8D, 0xAB, 0xF6, 0x97, 0xFD, 0x7B, 0x40, 0x8A, 0x25, 0x57, 0xB1, 0xC2 },
+          c_ldr_8x8 },
+        { "ldr_10x5", VK_FORMAT_ASTC_10x5_UNORM_BLOCK, false,
+          { 0x82, 0x82, 0x53, 0x0E, 0x1A, 0xAA, 0x25, 0xA0, 0x12, 0xB0, 0x00, 0x14, 0x4B, 0x29, 0x17, 0x66 },
+          c_ldr_10x5 },
+        { "ldr_10x6", VK_FORMAT_ASTC_10x6_UNORM_BLOCK, false,
+          { 0x06, 0x81, 0xAD, 0x74, 0x12, 0x37, 0x5E, 0xF3, 0xC0, 0x8E, 0x00, 0x1C, 0x09, 0x9F, 0x7B, 0x5A },
+          c_ldr_10x6 },
+        { "ldr_10x8", VK_FORMAT_ASTC_10x8_UNORM_BLOCK, false,
+          { 0x93, 0x81, 0xA3, 0x3A, 0xE2, 0xEB, 0x05, 0xD7, 0x9B, 0x72, 0xC0, 0x36, 0xE4, 0xBB, 0xEF, 0x3A },
+          c_ldr_10x8 },
+        { "ldr_10x10", VK_FORMAT_ASTC_10x10_UNORM_BLOCK, false,
+          { 0x82, 0x82, 0x99, 0x7C, 0xFA, 0x4C, 0xCC, 0xAE, 0x91, 0x3E, 0x01, 0x96, 0x3C, 0x03, 0xA8, 0x86 },
+          c_ldr_10x10 },
+        { "ldr_12x10", VK_FORMAT_ASTC_12x10_UNORM_BLOCK, false,
+          { 0x86, 0x81, 0xF5, 0x82, 0xA7, 0x1E, 0xB8, 0x08, 0xF5, 0x49, 0x81, 0xB1, 0x66, 0x5C, 0x4A, 0x6F },
+          c_ldr_12x10 },
+        { "ldr_12x12", VK_FORMAT_ASTC_12x12_UNORM_BLOCK, false,
+          { 0x93, 0x81, 0xFD, 0x82, 0xA3, 0xBE, 0x3F, 0x20, 0x7F, 0x4F, 0x40, 0xA3, 0x58, 0xD5, 0xD2, 0x33 },
+          c_ldr_12x12 },
+        { "ldr_blue_contract", VK_FORMAT_ASTC_6x6_UNORM_BLOCK, false,
+          { 0x42, 0x00, 0x91, 0x15, 0x68, 0x29, 0xB8, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x05, 0x6B, 0xEB, 0x0B },
+          c_ldr_blue_contract },
+        { "ldr_srgb", VK_FORMAT_ASTC_8x8_SRGB_BLOCK, false,
+          { 0xE1, 0x80, 0x7F, 0x36, 0xB9, 0xBF, 0x31, 0xA2, 0x4C, 0xDB, 0x00, 0x00, 0x00, 0x1D, 0x55, 0x3D },
+          c_ldr_srgb },
+        { "ldr_dual_plane", VK_FORMAT_ASTC_8x8_UNORM_BLOCK, false,
+          { 0x21, 0x84, 0x93, 0x59, 0x08, 0x82, 0xEB, 0x7C, 0x39, 0xF5, 0x00, 0x00, 0xC0, 0xD8, 0xDB, 0x8B },
+          c_ldr_dual_plane },
+        { "ldr_two_partitions", VK_FORMAT_ASTC_5x4_UNORM_BLOCK, false,
+          { 0x22, 0x28, 0x00, 0xF0, 0xFA, 0xDD, 0xC3, 0x96, 0x35, 0x6B, 0x98, 0xE0, 0x1E, 0xD4, 0x2F, 0x17 },
+          c_ldr_two_partitions },
+        { "hdr_rgb_direct", VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK, true,
+          { 0x4D, 0x60, 0x81, 0xE8, 0x40, 0xD4, 0x60, 0xC1, 0x01, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xA6, 0x60 },
+          c_hdr_rgb_direct },
+    };
+}
@@ -0,0 +1,90 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestArchive.cpp
+//
+// TextureArchiveWriter / TextureArchive
+//-------------------------------------------------------------------------------------
+
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+// A rejected Add must not shift the payloads of the textures added after it
+TEST_CASE(ArchiveRejectedAdd)
+{
+    TempFile file("rejected.vta");
+
+    ScratchImage good;
+    CHECK(good.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 64, 32, 2, 1));
+    FillPattern(good, 3);
+
+    // Second image declares the sRGB variant of the metadata format
+    ScratchImage bad;
+    CHECK(bad.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 64, 32, 2, 1));
+    FillPattern(bad, 11);
+    std::vector<Image> badImages(bad.GetImages(), bad.GetImages() + bad.GetImageCount());
+    badImages[1].format = VK_FORMAT_R8G8B8A8_SRGB;
+
+    TextureArchiveWriter writer;
+    CHECK(writer.Open(file.c_str()));
+    CHECK(!writer.Add("bad", badImages.data(), badImages.size(), bad.GetMetadata()));
+    CHECK(writer.Add("good", good));
+    CHECK(writer.Finish());
+
+    TextureArchive archive;
+    CHECK(archive.Open(file.c_str()));
+    CHECK(archive.GetEntryCount() == 1);
+    CHECK(archive.Find("bad") == size_t(-1));
+
+    const size_t entry = archive.Find("good");
+    CHECK(entry != size_t(-1));
+
+    ScratchImage loaded;
+    CHECK((entry != size_t(-1)) && archive.Load(entry, loaded));
+    CHECK(SamePixels(loaded, good));
+}
+
+// Entry metadata is validated by Open, a corrupted entry must not reach GetImages / Load
+TEST_CASE(ArchiveRejectsCorruptEntry)
+{
+    constexpr size_t c_entryOffsetField = 32;
+    constexpr size_t c_arraySizeField   = 28;
+    constexpr size_t c_mipLevelsField   = 32;
+
+    TempFile file("corrupt.vta");
+
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 16, 16, 2, 1));
+    FillPattern(image, 5);
+
+    TextureArchiveWriter writer;
+    CHECK(writer.Open(file.c_str()));
+    CHECK(writer.Add("texture", image));
+    CHECK(writer.Finish());
+
+    const std::vector<uint8_t> original = ReadFile(file.c_str());
+    CHECK(original.size() > c_entryOffsetField + sizeof(uint64_t));
+    if (original.size() <= c_entryOffsetField + sizeof(uint64_t))
+        return;
+
+    uint64_t entryOffset;
+    memcpy(&entryOffset, original.data() + c_entryOffsetField, sizeof(entryOffset));
+
+    auto opensWith = [&](size_t field, uint32_t value)
+    {
+        std::vector<uint8_t> data = original;
+        memcpy(data.data() + entryOffset + field, &value, sizeof(value));
+        if (!WriteFile(file.c_str(), data.data(), data.size()))
+            return true;
+
+        TextureArchive archive;
+        return archive.Open(file.c_str());
+    };
+
+    CHECK(opensWith(c_mipLevelsField, 1));
+    CHECK(!opensWith(c_mipLevelsField, 0xDD000000u));
+    CHECK(!opensWith(c_mipLevelsField, 2));     // Image count no longer matches
+    CHECK(!opensWith(c_arraySizeField, 0xFFFFFFF0u));
+    CHECK(!opensWith(c_arraySizeField, 3));
+}
@@ -0,0 +1,241 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestCapture.cpp
+//
+// Incremental capture (DeltaCapture / LoadFromDeltaFiles), content hashing and the
+// deduplicating CaptureStore
+//-------------------------------------------------------------------------------------
+
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+// A corrupt .vtd header must be rejected before the image or region table is sized from it
+TEST_CASE(DeltaRejectsCorruptHeader)
+{
+    constexpr size_t c_arraySizeField   = 40;
+    constexpr size_t c_mipLevelsField   = 48;
+    constexpr size_t c_regionCountField = 96;
+
+    TempFile base("corrupt.vtd");
+
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 32, 32, 1, 1));
+    FillPattern(image, 9);
+
+    DeltaCapture capture;
+    CHECK(capture.Save(1, image, DELTA_FLAGS_NONE, base.c_str()));
+
+    const std::vector<uint8_t> original = ReadFile(base.c_str());
+    CHECK(original.size() > c_regionCountField + sizeof(uint64_t));
+    if (original.size() <= c_regionCountField + sizeof(uint64_t))
+        return;
+
+    auto loadsWith = [&](size_t field, uint64_t value)
+    {
+        std::vector<uint8_t> data = original;
+        memcpy(data.data() + field, &value, sizeof(value));
+        if (!WriteFile(base.c_str(), data.data(), data.size()))
+            return true;
+
+        const char* files[] = { base.c_str() };
+        ScratchImage loaded;
+        return LoadFromDeltaFiles(files, 1, loaded);
+    };
+
+    CHECK(loadsWith(c_mipLevelsField, 1));
+    CHECK(!loadsWith(c_regionCountField, uint64_t(1) << 40));
+    CHECK(!loadsWith(c_regionCountField, 1000));
+    CHECK(!loadsWith(c_mipLevelsField, uint64_t(1) << 40));
+    CHECK(!loadsWith(c_arraySizeField, uint64_t(1) << 33));
+}
+
+// Manifest metadata is bounded before Load sizes the image from it
+TEST_CASE(CaptureStoreRejectsCorruptManifest)
+{
+    constexpr size_t c_arraySizeField = 40;
+
+    const std::filesystem::path directory = GetTempDirectory() / "VulkanTexTest_corrupt_store";
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 16, 16, 1, 1));
+    FillPattern(image, 2);
+
+    {
+        CaptureStore store;
+        CHECK(store.Open(directory.string().c_str()));
+        CHECK(store.Add("capture", image));
+    }
+
+    // The manifest is the only file at the top of the store directory
+    std::filesystem::path manifest;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+    {
+        if (entry.is_regular_file())
+            manifest = entry.path();
+    }
+
+    CHECK(!manifest.empty());
+    if (!manifest.empty())
+    {
+        std::vector<uint8_t> data = ReadFile(manifest.string().c_str());
+        const uint64_t arraySize = uint64_t(1) << 33;
+        memcpy(data.data() + c_arraySizeField, &arraySize, sizeof(arraySize));
+        CHECK(WriteFile(manifest.string().c_str(), data.data(), data.size()));
+
+        CaptureStore store;
+        ScratchImage loaded;
+        CHECK(store.Open(directory.string().c_str()));
+        CHECK(!store.Load("capture", loaded));
+    }
+
+    std::filesystem::remove_all(directory, ec);
+}
+
+// Hashes ignore pitch padding but change with any byte, the format or the dimensions
+TEST_CASE(ContentHashKnownProperties)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 16, 8, 1, 1));
+    FillPattern(image, 6);
+    const Image& img = *image.GetImage(0, 0, 0);
+
+    ContentHash hash = {}, other = {};
+    uint64_t hash64 = 0, other64 = 0;
+    CHECK(ComputeContentHash(img, hash));
+    CHECK(ComputeContentHash64(img, hash64));
+
+    PaddedImages padded;
+    CHECK(MakePadded(image, 20, padded));
+    CHECK(ComputeContentHash(padded.images[0], other) && other == hash);
+    CHECK(ComputeContentHash64(padded.images[0], other64) && other64 == hash64);
+
+    Image reinterpreted = img;
+    reinterpreted.format = VK_FORMAT_R32_UINT;
+    CHECK(ComputeContentHash(reinterpreted, other) && other != hash);
+    CHECK(ComputeContentHash64(reinterpreted, other64) && other64 != hash64);
+
+    reinterpreted = img;
+    reinterpreted.width  = 8;
+    reinterpreted.height = 16;
+    reinterpreted.rowPitch = 32;
+    CHECK(ComputeContentHash(reinterpreted, other) && other != hash);
+
+    img.pixels[img.slicePitch - 1] ^= 1;
+    CHECK(ComputeContentHash(img, other) && other != hash);
+    CHECK(ComputeContentHash64(img, other64) && other64 != hash64);
+}
+
+// Identical subresources are stored once, within a capture, across captures and across reopens
+TEST_CASE(CaptureStoreDeduplicates)
+{
+    const std::filesystem::path directory = GetTempDirectory() / "VulkanTexTest_dedup_store";
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+
+    // Two array items of three levels, the second item a copy of the first
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 32, 16, 2, 3));
+    FillPattern(image, 12);
+    for (size_t level = 0; level < 3; ++level)
+        memcpy(image.GetImage(level, 1, 0)->pixels, image.GetImage(level, 0, 0)->pixels, image.GetImage(level, 0, 0)->slicePitch);
+
+    {
+        CaptureStore store;
+        CHECK(store.Open(directory.string().c_str()));
+
+        CHECK(store.Add("first", image));
+        CHECK(store.GetPayloadsWritten() == 3);
+        CHECK(store.GetPayloadsReused() == 3);
+
+        CHECK(store.Add("second", image));
+        CHECK(store.GetPayloadsWritten() == 3);
+        CHECK(store.GetPayloadsReused() == 9);
+
+        // One changed level adds one payload
+        image.GetImage(2, 1, 0)->pixels[0] ^= 0xFF;
+        CHECK(store.Add("third", image));
+        CHECK(store.GetPayloadsWritten() == 4);
+        CHECK(store.GetPayloadsReused() == 14);
+
+        ScratchImage loaded;
+        CHECK(store.Load("third", loaded));
+        CHECK(SamePixels(loaded, image));
+        CHECK(loaded.GetMetadata().arraySize == 2 && loaded.GetMetadata().mipLevels == 3);
+    }
+
+    CaptureStore store;
+    CHECK(store.Open(directory.string().c_str()));
+    CHECK(store.Add("fourth", image));
+    CHECK(store.GetPayloadsWritten() == 0);
+    CHECK(store.GetPayloadsReused() == 6);
+
+    ScratchImage loaded;
+    CHECK(store.Load("first", loaded));
+    CHECK(!SamePixels(loaded, image));
+    CHECK(!store.Load("missing", loaded));
+
+    std::filesystem::remove_all(directory, ec);
+}
+
+// A base followed by its deltas rebuilds the image of every save, in subresource and tile mode
+TEST_CASE(DeltaReconstructsEverySave)
+{
+    for (DELTA_FLAGS mode : { DELTA_FLAGS_NONE, DELTA_FLAGS_TILES })
+    {
+        TempFile base("base.vtd");
+        TempFile delta1("delta1.vtd");
+        TempFile delta2("delta2.vtd");
+        const char* files[] = { base.c_str(), delta1.c_str(), delta2.c_str() };
+
+        ScratchImage image;
+        CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 160, 96, 2, 2));
+        FillPattern(image, 21);
+
+        DeltaCapture capture;
+        CHECK(capture.Save(7, image, mode, base.c_str()));
+
+        // One texel of the top level of item 1, then one of the second level of item 0
+        const Image* changed = image.GetImage(0, 1, 0);
+        changed->pixels[70 * changed->rowPitch + 100 * 4] ^= 0x5A;
+        CHECK(capture.Save(7, image, mode, delta1.c_str()));
+        CHECK(capture.GetLastRegionCount() == 1);
+
+        ScratchImage first;
+        CHECK(first.Initialize(image.GetMetadata()));
+        memcpy(first.GetPixels(), image.GetPixels(), image.GetPixelsSize());
+
+        changed = image.GetImage(1, 0, 0);
+        changed->pixels[5] ^= 0xA5;
+        CHECK(capture.Save(7, image, mode, delta2.c_str()));
+        CHECK(capture.GetLastRegionCount() == 1);
+        CHECK(ReadFile(delta2.c_str()).size() < ReadFile(base.c_str()).size() / 2);
+
+        ScratchImage loaded;
+        CHECK(LoadFromDeltaFiles(files, 2, loaded));
+        CHECK(SamePixels(loaded, first));
+        CHECK(LoadFromDeltaFiles(files, 3, loaded));
+        CHECK(SamePixels(loaded, image));
+
+        // Deltas cannot be loaded without their base
+        CHECK(!LoadFromDeltaFiles(files + 1, 2, loaded));
+
+        TempFile merged("merged.dds");
+        TempFile reference("reference.dds");
+        CHECK(SaveDeltasToDDSFile(files, 3, DDS_FLAGS_NONE, merged.c_str()));
+        CHECK(SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DDS_FLAGS_NONE, reference.c_str()));
+        CHECK(ReadFile(merged.c_str()) == ReadFile(reference.c_str()));
+
+        // An unchanged save writes no regions, a forgotten resource starts over with a base
+        CHECK(capture.Save(7, image, mode, delta1.c_str()));
+        CHECK(capture.GetLastRegionCount() == 0);
+
+        capture.Forget(7);
+        CHECK(capture.Save(7, image, mode, base.c_str()));
+        CHECK(LoadFromDeltaFiles(files, 1, loaded));
+        CHECK(SamePixels(loaded, image));
+    }
+}
@@ -0,0 +1,194 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestCompress.cpp
+//
+// Lossless supercompression of DDS ('VTSC' containers) and KTX2
+//-------------------------------------------------------------------------------------
+
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    // Field offsets in the VTSC header
+    constexpr size_t c_vtscChunkCountOffset = 16;
+    constexpr size_t c_vtscChunkTableOffset = 24;
+
+    std::vector<uint8_t> ToVector(const Blob& blob)
+    {
+        return std::vector<uint8_t>(blob.GetConstBufferPointer(), blob.GetConstBufferPointer() + blob.GetBufferSize());
+    }
+
+    bool LoadsDDS(const std::vector<uint8_t>& data)
+    {
+        ScratchImage image;
+        return LoadFromDDSMemory(data.data(), data.size(), DDS_FLAGS_NONE, nullptr, image);
+    }
+
+    bool ExpandsDDS(const std::vector<uint8_t>& data)
+    {
+        Blob dds;
+        return DecompressDDSMemory(data.data(), data.size(), dds);
+    }
+}
+
+// Truncated and corrupted containers fail cleanly
+TEST_CASE(SupercompressedDDSRejectsCorruptContainer)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 64, 64, 1, 2));
+    FillPattern(image, 7);
+
+    Blob blob;
+    CHECK(SaveToDDSMemory(image, DDS_FLAGS_SUPERCOMPRESS_FAST, blob));
+    const std::vector<uint8_t> original = ToVector(blob);
+    CHECK(LoadsDDS(original) && ExpandsDDS(original));
+
+    for (size_t size : { size_t(0), size_t(4), size_t(47), size_t(48), original.size() / 2, original.size() - 1 })
+    {
+        const std::vector<uint8_t> truncated(original.begin(), original.begin() + static_cast<ptrdiff_t>(size));
+        CHECK(!LoadsDDS(truncated));
+        CHECK(!ExpandsDDS(truncated));
+    }
+
+    auto patched = [&](size_t offset, uint32_t value)
+    {
+        std::vector<uint8_t> data = original;
+        memcpy(data.data() + offset, &value, sizeof(value));
+        return data;
+    };
+
+    // No chunks at all, more chunks than the file holds
+    CHECK(!LoadsDDS(patched(c_vtscChunkCountOffset, 0)));
+    CHECK(!ExpandsDDS(patched(c_vtscChunkCountOffset, 0)));
+    CHECK(!LoadsDDS(patched(c_vtscChunkCountOffset, 0xFFFFFFFFu)));
+
+    // First chunk: claims a huge raw size, then points at another subresource
+    uint64_t chunkTable;
+    memcpy(&chunkTable, original.data() + c_vtscChunkTableOffset, sizeof(chunkTable));
+    CHECK(!LoadsDDS(patched(static_cast<size_t>(chunkTable) + 12, 0x7FFFFFFFu)));
+    CHECK(!ExpandsDDS(patched(static_cast<size_t>(chunkTable) + 12, 0x7FFFFFFFu)));
+    CHECK(!LoadsDDS(patched(static_cast<size_t>(chunkTable) + 20, 1)));
+}
+
+namespace
+{
+    // Smooth gradient (compresses well, unlike FillPattern)
+    void FillGradient(const ScratchImage& image)
+    {
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            const Image& img = image.GetImages()[i];
+            for (size_t y = 0; y < img.height; ++y)
+            {
+                uint8_t* row = img.pixels + y * img.rowPitch;
+                for (size_t x = 0; x < img.rowPitch; ++x)
+                    row[x] = static_cast<uint8_t>(x / 4 + y + i);
+            }
+        }
+    }
+
+    enum class Content { Zero, Gradient, Random };
+
+    bool MakeSource(VkFormat format, size_t width, size_t height, size_t arraySize, size_t mipLevels, Content content, ScratchImage& image)
+    {
+        if (!image.Initialize2D(format, width, height, arraySize, mipLevels))
+            return false;
+
+        switch (content)
+        {
+            case Content::Zero:     memset(image.GetPixels(), 0, image.GetPixelsSize()); break;
+            case Content::Gradient: FillGradient(image); break;
+            case Content::Random:   FillPattern(image, 11); break;
+        }
+        return true;
+    }
+
+    // Checks that both supercompression levels of both containers load back byte-exact
+    void CheckRoundTrips(const ScratchImage& source, const Image* images, size_t nimages)
+    {
+        const TexMetadata& metadata = source.GetMetadata();
+
+        Blob plain;
+        CHECK(SaveToDDSMemory(images, nimages, metadata, DDS_FLAGS_NONE, plain));
+
+        for (DDS_FLAGS flags : { DDS_FLAGS_SUPERCOMPRESS_FAST, DDS_FLAGS_SUPERCOMPRESS_HIGH })
+        {
+            Blob blob;
+            CHECK(SaveToDDSMemory(images, nimages, metadata, flags, blob));
+            CHECK(IsSupercompressedDDS(blob.GetConstBufferPointer(), blob.GetBufferSize()));
+
+            TexMetadata loadedMetadata = {};
+            ScratchImage loaded;
+            CHECK(LoadFromDDSMemory(blob.GetConstBufferPointer(), blob.GetBufferSize(), DDS_FLAGS_NONE, &loadedMetadata, loaded));
+            CHECK(loadedMetadata.mipLevels == metadata.mipLevels && loadedMetadata.arraySize == metadata.arraySize);
+            CHECK(SamePixels(source, loaded));
+
+            // Expanding the container gives back exactly what the plain writer produces
+            Blob expanded;
+            CHECK(DecompressDDSMemory(blob.GetConstBufferPointer(), blob.GetBufferSize(), expanded));
+            CHECK(ToVector(expanded) == ToVector(plain));
+        }
+
+        for (KTX2_FLAGS flags : { KTX2_FLAGS_SUPERCOMPRESS_FAST, KTX2_FLAGS_SUPERCOMPRESS_HIGH })
+        {
+            Blob blob;
+            CHECK(SaveToKTX2Memory(images, nimages, metadata, flags, blob));
+
+            TexMetadata loadedMetadata = {};
+            ScratchImage loaded;
+            CHECK(LoadFromKTX2Memory(blob.GetConstBufferPointer(), blob.GetBufferSize(), &loadedMetadata, loaded));
+            CHECK(loadedMetadata.mipLevels == metadata.mipLevels && loadedMetadata.arraySize == metadata.arraySize);
+            CHECK(SamePixels(source, loaded));
+        }
+    }
+}
+
+// Lossless round trips: compressible, all-zero, tiny and incompressible payloads
+TEST_CASE(SupercompressionRoundTrips)
+{
+    struct Shape
+    {
+        VkFormat format;
+        size_t   width, height, arraySize, mipLevels;
+        Content  content;
+    };
+
+    const Shape shapes[] =
+    {
+        { VK_FORMAT_R8G8B8A8_UNORM,      64,  64,  2, 7, Content::Gradient },
+        { VK_FORMAT_R8G8B8A8_UNORM,      256, 256, 1, 1, Content::Zero },
+        { VK_FORMAT_R8G8B8A8_UNORM,      1,   1,   1, 1, Content::Zero },
+        { VK_FORMAT_R8_UNORM,            1,   1,   1, 1, Content::Random },
+        { VK_FORMAT_R8G8B8A8_UNORM,      128, 128, 1, 1, Content::Random },
+        { VK_FORMAT_R16G16B16A16_SFLOAT, 33,  17,  3, 3, Content::Random },
+    };
+
+    for (const Shape& shape : shapes)
+    {
+        ScratchImage source;
+        CHECK(MakeSource(shape.format, shape.width, shape.height, shape.arraySize, shape.mipLevels, shape.content, source));
+        CheckRoundTrips(source, source.GetImages(), source.GetImageCount());
+    }
+
+    // Nothing to write
+    Blob blob;
+    CHECK(!SaveToDDSMemory(nullptr, 0, TexMetadata{}, DDS_FLAGS_SUPERCOMPRESS_FAST, blob));
+    CHECK(!SaveToKTX2Memory(nullptr, 0, TexMetadata{}, KTX2_FLAGS_SUPERCOMPRESS_FAST, blob));
+}
+
+// Source rows with padding beyond the format's pitch are packed before compressing
+TEST_CASE(SupercompressionPaddedPitch)
+{
+    for (Content content : { Content::Gradient, Content::Random })
+    {
+        ScratchImage source;
+        CHECK(MakeSource(VK_FORMAT_R8G8B8A8_UNORM, 45, 31, 2, 4, content, source));
+
+        PaddedImages padded;
+        CHECK(MakePadded(source, 20, padded));
+        CheckRoundTrips(source, padded.images.data(), padded.images.size());
+    }
+}
@@ -0,0 +1,318 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestConvert.cpp
+//
+// Format conversion, alpha premultiplication, half-float and sRGB known answers
+//-------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    // Reference sRGB transfer functions in double precision
+    double DecodeSRGB(double value)
+    {
+        return (value <= 0.04045) ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+    }
+
+    double EncodeSRGB(double value)
+    {
+        return (value <= 0.0031308) ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+    }
+}
+
+// UNORM channels widen exactly, swizzle between layouts and survive a round trip through float
+TEST_CASE(ConvertKnownValues)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 37, 19, 2, 1));
+    FillPattern(image, 4);
+
+    ScratchImage wide;
+    CHECK(Convert(image.GetImages(), image.GetImageCount(), image.GetMetadata(), VK_FORMAT_R32G32B32A32_SFLOAT, {}, wide));
+    CHECK(wide.GetMetadata().format == VK_FORMAT_R32G32B32A32_SFLOAT);
+    CHECK(wide.GetImageCount() == image.GetImageCount());
+
+    ScratchImage unorm16;
+    CHECK(Convert(image.GetImages(), image.GetImageCount(), image.GetMetadata(), VK_FORMAT_R16G16B16A16_UNORM, {}, unorm16));
+
+    ScratchImage bgra;
+    CHECK(Convert(image.GetImages(), image.GetImageCount(), image.GetMetadata(), VK_FORMAT_B8G8R8A8_UNORM, {}, bgra));
+
+    for (size_t i = 0; i < image.GetImageCount() && i < wide.GetImageCount(); ++i)
+    {
+        const Image& src = image.GetImages()[i];
+        bool exact = true;
+
+        for (size_t y = 0; y < src.height; ++y)
+        {
+            const uint8_t* s = src.pixels + y * src.rowPitch;
+            const float* f = GetTexel(wide.GetImages()[i], 0, y);
+            auto u = reinterpret_cast<const uint16_t*>(unorm16.GetImages()[i].pixels + y * unorm16.GetImages()[i].rowPitch);
+            const uint8_t* b = bgra.GetImages()[i].pixels + y * bgra.GetImages()[i].rowPitch;
+
+            for (size_t x = 0; x < src.width; ++x)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    exact &= IsNear(f[x * 4 + c], float(s[x * 4 + c]) / 255.f, 1e-7f);
+                    exact &= (u[x * 4 + c] == s[x * 4 + c] * 257u);
+                }
+
+                exact &= (b[x * 4] == s[x * 4 + 2]) && (b[x * 4 + 1] == s[x * 4 + 1])
+                    && (b[x * 4 + 2] == s[x * 4]) && (b[x * 4 + 3] == s[x * 4 + 3]);
+            }
+        }
+
+        CHECK(exact);
+    }
+
+    ScratchImage back;
+    CHECK(Convert(wide.GetImages(), wide.GetImageCount(), wide.GetMetadata(), VK_FORMAT_R8G8B8A8_UNORM, {}, back));
+    CHECK(SamePixels(back, image));
+
+    // Missing channels load as 0, missing alpha as 1; stores round to nearest and saturate
+    ScratchImage rg;
+    CHECK(rg.Initialize2D(VK_FORMAT_R32G32_SFLOAT, 3, 1, 1, 1));
+    const float rgValues[6] = { 0.5f, -1.f, 2.f, 0.25f, 0.0055f, 0.998f };
+    memcpy(rg.GetPixels(), rgValues, sizeof(rgValues));
+
+    ScratchImage rgba;
+    CHECK(Convert(*rg.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_UNORM, {}, rgba));
+    const uint8_t expected[12] = { 128, 0, 0, 255, 255, 64, 0, 255, 1, 254, 0, 255 };
+    CHECK(rgba.GetPixels() && memcmp(rgba.GetPixels(), expected, sizeof(expected)) == 0);
+}
+
+// Premultiplication scales color by alpha and marks the result, unpremultiplying inverts it
+TEST_CASE(PremultiplyAlphaKnownValues)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 3, 1, 1, 1));
+    const uint8_t texels[12] = { 200, 100, 50, 128, 10, 20, 30, 0, 90, 180, 255, 255 };
+    memcpy(image.GetPixels(), texels, sizeof(texels));
+
+    ScratchImage premultiplied;
+    CHECK(PremultiplyAlpha(image.GetImages(), 1, image.GetMetadata(), TEX_PMALPHA_DEFAULT, premultiplied));
+    CHECK(premultiplied.GetMetadata().GetAlphaMode() == TEX_ALPHA_MODE_PREMULTIPLIED);
+
+    const uint8_t expected[12] = { 100, 50, 25, 128, 0, 0, 0, 0, 90, 180, 255, 255 };
+    CHECK(premultiplied.GetPixels() && memcmp(premultiplied.GetPixels(), expected, sizeof(expected)) == 0);
+
+    // Already premultiplied data is rejected
+    ScratchImage again;
+    CHECK(!PremultiplyAlpha(premultiplied.GetImages(), 1, premultiplied.GetMetadata(), TEX_PMALPHA_DEFAULT, again));
+
+    ScratchImage straight;
+    CHECK(UnpremultiplyAlpha(premultiplied.GetImages(), 1, premultiplied.GetMetadata(), TEX_PMALPHA_DEFAULT, straight));
+    CHECK(straight.GetMetadata().GetAlphaMode() == TEX_ALPHA_MODE_STRAIGHT);
+    CHECK(!UnpremultiplyAlpha(straight.GetImages(), 1, straight.GetMetadata(), TEX_PMALPHA_DEFAULT, again));
+
+    // 100 * 255 / 128 rounds to 199, opaque texels are unchanged
+    const uint8_t restored[12] = { 199, 100, 50, 128, 0, 0, 0, 0, 90, 180, 255, 255 };
+    CHECK(straight.GetPixels() && memcmp(straight.GetPixels(), restored, sizeof(restored)) == 0);
+
+    // Float data inverts to within rounding, zero-alpha texels keep their color when unpremultiplying
+    ScratchImage wide;
+    CHECK(wide.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 19, 3, 1, 1));
+    for (size_t y = 0; y < 3; ++y)
+    {
+        for (size_t x = 0; x < 19; ++x)
+        {
+            float* texel = GetTexel(*wide.GetImage(0, 0, 0), x, y);
+            texel[0] = float(x) / 18.f;
+            texel[1] = 0.5f;
+            texel[2] = 1.f - float(y) / 2.f;
+            texel[3] = float((x + y) % 5) / 4.f;
+        }
+    }
+
+    CHECK(PremultiplyAlpha(*wide.GetImage(0, 0, 0), TEX_PMALPHA_DEFAULT, premultiplied));
+    CHECK(UnpremultiplyAlpha(*premultiplied.GetImage(0, 0, 0), TEX_PMALPHA_DEFAULT, straight));
+
+    bool inverted = true;
+    for (size_t y = 0; y < 3 && straight.GetPixels(); ++y)
+    {
+        for (size_t x = 0; x < 19; ++x)
+        {
+            const float* source = GetTexel(*wide.GetImage(0, 0, 0), x, y);
+            const float* scaled = GetTexel(*premultiplied.GetImage(0, 0, 0), x, y);
+            const float* result = GetTexel(*straight.GetImage(0, 0, 0), x, y);
+
+            for (size_t c = 0; c < 3; ++c)
+            {
+                inverted &= IsNear(scaled[c], source[c] * source[3], 1e-6f);
+                inverted &= IsNear(result[c], (source[3] > 0.f) ? source[c] : 0.f, 1e-6f);
+            }
+            inverted &= (result[3] == source[3]);
+        }
+    }
+    CHECK(inverted);
+
+    const float transparent[4] = { 0.25f, 0.5f, 0.75f, 0.f };
+    memcpy(GetTexel(*wide.GetImage(0, 0, 0), 0, 0), transparent, sizeof(transparent));
+    CHECK(UnpremultiplyAlpha(*wide.GetImage(0, 0, 0), TEX_PMALPHA_DEFAULT, straight));
+    CHECK(straight.GetPixels() && memcmp(GetTexel(*straight.GetImage(0, 0, 0), 0, 0), transparent, sizeof(transparent)) == 0);
+}
+
+// Every non-NaN half widens exactly and narrows back to itself; narrowing rounds to nearest even
+TEST_CASE(ConvertHalfFloatExact)
+{
+    ScratchImage halves;
+    CHECK(halves.Initialize2D(VK_FORMAT_R16_SFLOAT, 256, 256, 1, 1));
+
+    auto bits = reinterpret_cast<uint16_t*>(halves.GetPixels());
+    for (uint32_t i = 0; i < 65536 && bits; ++i)
+    {
+        const bool nan = ((i & 0x7C00u) == 0x7C00u) && (i & 0x3FFu);
+        bits[i] = static_cast<uint16_t>(nan ? 0 : i);
+    }
+
+    ScratchImage floats;
+    CHECK(Convert(*halves.GetImage(0, 0, 0), VK_FORMAT_R32_SFLOAT, {}, floats));
+
+    auto values = reinterpret_cast<const float*>(floats.GetPixels());
+    bool exact = (values != nullptr);
+    for (uint32_t i = 0; i < 65536 && exact; ++i)
+    {
+        const uint32_t exponent = (bits[i] >> 10) & 0x1Fu;
+        const uint32_t mantissa = bits[i] & 0x3FFu;
+
+        float expected = (exponent == 0x1F) ? std::numeric_limits<float>::infinity()
+            : (exponent == 0) ? std::ldexp(float(mantissa), -24)
+            : std::ldexp(float(mantissa | 0x400u), int(exponent) - 25);
+        if (bits[i] & 0x8000u)
+            expected = -expected;
+
+        exact &= (values[i] == expected) && (std::signbit(values[i]) == ((bits[i] & 0x8000u) != 0));
+    }
+    CHECK(exact);
+
+    ScratchImage back;
+    CHECK(Convert(*floats.GetImage(0, 0, 0), VK_FORMAT_R16_SFLOAT, {}, back));
+    CHECK(SamePixels(back, halves));
+
+    // Ties go to the even neighbour, values past halfway round up, tiny values round into subnormals
+    struct Narrowing
+    {
+        float    value;
+        uint16_t half;
+    };
+
+    const Narrowing cases[] =
+    {
+        { 1.f + std::ldexp(1.f, -11),                         0x3C00 },
+        { 1.f + 3.f * std::ldexp(1.f, -11),                   0x3C02 },
+        { 1.f + std::ldexp(1.f, -11) + std::ldexp(1.f, -20), 0x3C01 },
+        { std::ldexp(1.f, -24),                               0x0001 },
+        { std::ldexp(1.f, -25),                               0x0000 },
+        { 1.5f * std::ldexp(1.f, -25),                        0x0001 },
+        { 65504.f,                                            0x7BFF },
+        { -0.f,                                               0x8000 },
+        { 0.1f,                                               0x2E66 },
+        { -2.f,                                               0xC000 },
+    };
+
+    // 37 texels per row so both the vector body and the scalar tail see every case
+    constexpr size_t c_width = 37;
+    ScratchImage narrow;
+    CHECK(narrow.Initialize2D(VK_FORMAT_R32_SFLOAT, c_width, 1, 1, 1));
+    auto row = reinterpret_cast<float*>(narrow.GetPixels());
+    for (size_t x = 0; x < c_width && row; ++x)
+        row[x] = cases[x % std::size(cases)].value;
+
+    CHECK(Convert(*narrow.GetImage(0, 0, 0), VK_FORMAT_R16_SFLOAT, {}, back));
+    auto result = reinterpret_cast<const uint16_t*>(back.GetPixels());
+    for (size_t x = 0; x < c_width && result; ++x)
+        CHECK(result[x] == cases[x % std::size(cases)].half);
+}
+
+// sRGB codes decode to the transfer function, encoding picks the correctly rounded code
+TEST_CASE(ConvertSRGBKnownValues)
+{
+    ScratchImage codes;
+    CHECK(codes.Initialize2D(VK_FORMAT_R8G8B8A8_SRGB, 256, 1, 1, 1));
+    for (size_t i = 0; i < 256 && codes.GetPixels(); ++i)
+        memset(codes.GetPixels() + i * 4, int(i), 4);
+
+    ScratchImage linear;
+    CHECK(Convert(*codes.GetImage(0, 0, 0), VK_FORMAT_R32G32B32A32_SFLOAT, {}, linear));
+
+    bool decoded = (linear.GetPixels() != nullptr);
+    for (size_t i = 0; i < 256 && decoded; ++i)
+    {
+        const float* texel = GetTexel(*linear.GetImage(0, 0, 0), i, 0);
+        for (size_t c = 0; c < 3; ++c)
+            decoded &= IsNear(texel[c], float(DecodeSRGB(double(i) / 255.0)), 1e-6f);
+
+        // Alpha is linear
+        decoded &= IsNear(texel[3], float(i) / 255.f, 1e-7f);
+    }
+    CHECK(decoded);
+
+    ScratchImage encoded;
+    CHECK(Convert(*linear.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_SRGB, {}, encoded));
+    CHECK(SamePixels(encoded, codes));
+
+    // Copying the encoded values to a linear format leaves the bytes alone
+    ConvertOptions ignore;
+    ignore.flags = CONVERT_FLAGS_IGNORE_SRGB;
+    CHECK(Convert(*codes.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_UNORM, ignore, encoded));
+    CHECK(encoded.GetPixels() && memcmp(encoded.GetPixels(), codes.GetPixels(), 1024) == 0);
+
+    // Linear 0.5 is code 188, linear 0.2158605 is code 128; arbitrary values round like the exact curve
+    constexpr size_t c_count = 1001;
+    ScratchImage ramp;
+    CHECK(ramp.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, c_count, 1, 1, 1));
+    for (size_t i = 0; i < c_count && ramp.GetPixels(); ++i)
+    {
+        float* texel = GetTexel(*ramp.GetImage(0, 0, 0), i, 0);
+        texel[0] = 0.5f;
+        texel[1] = 0.2158605f;
+        texel[2] = float(i) / float(c_count - 1);
+        texel[3] = 1.f;
+    }
+
+    CHECK(Convert(*ramp.GetImage(0, 0, 0), VK_FORMAT_R8G8B8A8_SRGB, {}, encoded));
+
+    bool rounded = (encoded.GetPixels() != nullptr);
+    for (size_t i = 0; i < c_count && rounded; ++i)
+    {
+        const uint8_t* texel = encoded.GetPixels() + i * 4;
+        const double exact = EncodeSRGB(double(GetTexel(*ramp.GetImage(0, 0, 0), i, 0)[2])) * 255.0;
+
+        rounded &= (texel[0] == 188) && (texel[1] == 128) && (texel[3] == 255);
+
+        // Skip values within float precision of a rounding boundary
+        if (std::fabs(exact - std::floor(exact) - 0.5) > 1e-3)
+            rounded &= (texel[2] == uint8_t(std::lround(exact)));
+    }
+    CHECK(rounded);
+
+    // 16-bit UNORM decodes through the interpolated table
+    ScratchImage unorm16;
+    CHECK(unorm16.Initialize2D(VK_FORMAT_R16G16B16A16_UNORM, 257, 1, 1, 1));
+    auto words = reinterpret_cast<uint16_t*>(unorm16.GetPixels());
+    for (size_t i = 0; i < 257 * 4 && words; ++i)
+        words[i] = static_cast<uint16_t>(std::min<size_t>((i / 4) * 256 + (i % 4) * 61, 65535));
+
+    ConvertOptions srgbIn;
+    srgbIn.flags = CONVERT_FLAGS_SRGB_IN;
+    CHECK(Convert(*unorm16.GetImage(0, 0, 0), VK_FORMAT_R32G32B32A32_SFLOAT, srgbIn, linear));
+
+    decoded = (linear.GetPixels() != nullptr);
+    for (size_t i = 0; i < 257 && decoded; ++i)
+    {
+        const float* texel = GetTexel(*linear.GetImage(0, 0, 0), i, 0);
+        for (size_t c = 0; c < 3; ++c)
+            decoded &= IsNear(texel[c], float(DecodeSRGB(words[i * 4 + c] / 65535.0)), 2e-6f);
+        decoded &= IsNear(texel[3], words[i * 4 + 3] / 65535.f, 1e-7f);
+    }
+    CHECK(decoded);
+}
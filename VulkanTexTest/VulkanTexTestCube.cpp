@@ -0,0 +1,321 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestCube.cpp
+//
+// Cubemap utilities (layout unpacking, cube array assembly, equirect projection) and
+// image-based lighting (GGX prefiltering, irradiance SH)
+//-------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    constexpr float c_pi = 3.14159265358979f;
+
+    // Fills the face-sized cell (column, row) of an RGBA8 image with 'value' in every byte
+    void FillCell(const Image& image, size_t faceSize, size_t column, size_t row, uint8_t value)
+    {
+        for (size_t y = 0; y < faceSize; ++y)
+            memset(image.pixels + (row * faceSize + y) * image.rowPitch + column * faceSize * 4, value, faceSize * 4);
+    }
+
+    bool IsUniform(const Image& image, uint8_t value, size_t skipX, size_t skipY)
+    {
+        for (size_t y = 0; y < image.height; ++y)
+        {
+            for (size_t x = 0; x < image.width; ++x)
+            {
+                if ((x == skipX) && (y == skipY))
+                    continue;
+
+                const uint8_t* texel = image.pixels + y * image.rowPitch + x * 4;
+                if ((texel[0] != value) || (texel[1] != value) || (texel[2] != value) || (texel[3] != value))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Equirect image whose red channel is 0.5 (1 + y) and green 0.5 (1 + z) for the direction of
+    // each texel, with +Z at the horizontal center; neither depends on the handedness of X
+    void FillEquirect(const Image& image)
+    {
+        for (size_t y = 0; y < image.height; ++y)
+        {
+            const float latitude = c_pi * (0.5f - (float(y) + 0.5f) / float(image.height));
+            for (size_t x = 0; x < image.width; ++x)
+            {
+                const float longitude = 2.f * c_pi * ((float(x) + 0.5f) / float(image.width) - 0.5f);
+
+                float* texel = GetTexel(image, x, y);
+                texel[0] = 0.5f * (1.f + std::sin(latitude));
+                texel[1] = 0.5f * (1.f + std::cos(latitude) * std::cos(longitude));
+                texel[2] = 0.25f;
+                texel[3] = 1.f;
+            }
+        }
+    }
+}
+
+// Faces come out of each layout in +X, -X, +Y, -Y, +Z, -Z order; the vertical cross -Z is rotated
+TEST_CASE(UnpackCubeLayouts)
+{
+    constexpr size_t c_face = 4;
+
+    struct Layout
+    {
+        CUBE_LAYOUT layout;
+        size_t      columns, rows;
+        size_t      cells[6][2];
+    };
+
+    const Layout layouts[] =
+    {
+        { CUBE_LAYOUT_HORIZONTAL_CROSS, 4, 3, { { 2, 1 }, { 0, 1 }, { 1, 0 }, { 1, 2 }, { 1, 1 }, { 3, 1 } } },
+        { CUBE_LAYOUT_VERTICAL_CROSS,   3, 4, { { 2, 1 }, { 0, 1 }, { 1, 0 }, { 1, 2 }, { 1, 1 }, { 1, 3 } } },
+        { CUBE_LAYOUT_HORIZONTAL_STRIP, 6, 1, { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 } } },
+        { CUBE_LAYOUT_VERTICAL_STRIP,   1, 6, { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 } } },
+    };
+
+    for (const Layout& layout : layouts)
+    {
+        ScratchImage image;
+        CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, layout.columns * c_face, layout.rows * c_face, 1, 1));
+        memset(image.GetPixels(), 0xEE, image.GetPixelsSize());
+
+        const Image& img = *image.GetImage(0, 0, 0);
+        for (size_t face = 0; face < 6; ++face)
+            FillCell(img, c_face, layout.cells[face][0], layout.cells[face][1], uint8_t(0x10 * (face + 1)));
+
+        // Marker in the top-left texel of the -Z cell
+        uint8_t* marker = img.pixels + layout.cells[5][1] * c_face * img.rowPitch + layout.cells[5][0] * c_face * 4;
+        memset(marker, 0xFF, 4);
+
+        ScratchImage cube;
+        CHECK(UnpackCubeLayout(img, layout.layout, cube));
+        CHECK(cube.GetMetadata().IsCubemap() && cube.GetMetadata().arraySize == 6);
+        CHECK(cube.GetMetadata().width == c_face && cube.GetMetadata().height == c_face);
+        if (cube.GetImageCount() != 6)
+            continue;
+
+        for (size_t face = 0; face < 5; ++face)
+            CHECK(IsUniform(*cube.GetImage(0, face, 0), uint8_t(0x10 * (face + 1)), c_face, c_face));
+
+        const size_t markerAt = (layout.layout == CUBE_LAYOUT_VERTICAL_CROSS) ? c_face - 1 : 0;
+        CHECK(IsUniform(*cube.GetImage(0, 5, 0), 0x60, markerAt, markerAt));
+        CHECK(cube.GetImage(0, 5, 0)->pixels[markerAt * cube.GetImage(0, 5, 0)->rowPitch + markerAt * 4] == 0xFF);
+    }
+
+    // The image must be the layout's size in faces
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 4 * c_face, 4 * c_face, 1, 1));
+
+    ScratchImage cube;
+    CHECK(!UnpackCubeLayout(*image.GetImage(0, 0, 0), CUBE_LAYOUT_HORIZONTAL_CROSS, cube));
+}
+
+// Cube arrays are concatenated cube by cube
+TEST_CASE(AssembleCubeArrayConcatenates)
+{
+    ScratchImage first, second;
+    CHECK(first.InitializeCube(VK_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 2));
+    CHECK(second.InitializeCube(VK_FORMAT_R8G8B8A8_UNORM, 8, 8, 2, 2));
+    FillPattern(first, 1);
+    FillPattern(second, 2);
+
+    const ImageSetView cubes[2] = { first, second };
+
+    ScratchImage result;
+    CHECK(AssembleCubeArray(cubes, 2, result));
+    CHECK(result.GetMetadata().IsCubemap() && result.GetMetadata().arraySize == 18 && result.GetMetadata().mipLevels == 2);
+    CHECK(SameSubresources(first, result, 0, 0));
+    CHECK(SameSubresources(second, result, 0, 6));
+
+    // Face sizes must match
+    ScratchImage small;
+    CHECK(small.InitializeCube(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1, 2));
+    const ImageSetView mismatched[2] = { first, small };
+    CHECK(!AssembleCubeArray(mismatched, 2, result));
+}
+
+// +Z is the equirect center and +Y its top, and projecting to a cube and back is nearly lossless
+TEST_CASE(EquirectProjectionRoundTrips)
+{
+    ScratchImage equirect;
+    CHECK(equirect.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 128, 64, 1, 1));
+    FillEquirect(*equirect.GetImage(0, 0, 0));
+
+    ScratchImage cube;
+    CHECK(EquirectToCube(*equirect.GetImage(0, 0, 0), 32, TEX_FILTER_LINEAR, cube));
+    CHECK(cube.GetMetadata().IsCubemap() && cube.GetMetadata().width == 32 && cube.GetMetadata().mipLevels == 1);
+    if (cube.GetImageCount() != 6)
+        return;
+
+    // Red follows y, green the component towards +Z: check the four face centers that define both
+    const float centers[6][2] = { { 0.5f, 0.5f }, { 0.5f, 0.5f }, { 1.f, 0.5f }, { 0.f, 0.5f }, { 0.5f, 1.f }, { 0.5f, 0.f } };
+    for (size_t face = 0; face < 6; ++face)
+    {
+        const Image& img = *cube.GetImage(0, face, 0);
+        float center[2] = {};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const float* texel = GetTexel(img, 15 + (i & 1), 15 + (i >> 1));
+            center[0] += 0.25f * texel[0];
+            center[1] += 0.25f * texel[1];
+        }
+
+        CHECK(IsNear(center[0], centers[face][0], 0.02f));
+        CHECK(IsNear(center[1], centers[face][1], 0.02f));
+    }
+
+    ScratchImage back;
+    CHECK(CubeToEquirect(cube, 128, 64, TEX_FILTER_LINEAR, back));
+    CHECK(back.GetMetadata().width == 128 && back.GetMetadata().height == 64);
+
+    float mse = 1.f;
+    CHECK(ComputeMSE(*back.GetImage(0, 0, 0), *equirect.GetImage(0, 0, 0), mse, nullptr));
+    CHECK(mse < 1e-4f);
+
+    // A constant panorama is a constant cube
+    ScratchImage constant;
+    CHECK(constant.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 64, 32, 1, 1));
+    memset(constant.GetPixels(), 0x42, constant.GetPixelsSize());
+
+    for (TEX_FILTER_FLAGS filter : { TEX_FILTER_POINT, TEX_FILTER_LINEAR })
+    {
+        CHECK(EquirectToCube(*constant.GetImage(0, 0, 0), 16, filter, cube));
+        for (size_t face = 0; face < cube.GetImageCount(); ++face)
+            CHECK(IsUniform(*cube.GetImage(0, face, 0), 0x42, 16, 16));
+    }
+}
+
+// Mip 0 is the source, a constant environment stays constant, rougher mips are smoother
+TEST_CASE(PrefilterCubemapGGXKnownProperties)
+{
+    ScratchImage equirect;
+    CHECK(equirect.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 128, 64, 1, 1));
+    FillEquirect(*equirect.GetImage(0, 0, 0));
+
+    ScratchImage cube, source;
+    CHECK(EquirectToCube(*equirect.GetImage(0, 0, 0), 32, TEX_FILTER_LINEAR, cube));
+    CHECK(Convert(cube, VK_FORMAT_R16G16B16A16_SFLOAT, {}, source));
+
+    ScratchImage prefiltered;
+    CHECK(PrefilterCubemapGGX(source, 0, 64, VK_FORMAT_R16G16B16A16_SFLOAT, prefiltered));
+    CHECK(prefiltered.GetMetadata().IsCubemap() && prefiltered.GetMetadata().mipLevels == 6);
+    CHECK(prefiltered.GetMetadata().width == 32 && prefiltered.GetMetadata().format == VK_FORMAT_R16G16B16A16_SFLOAT);
+    if (prefiltered.GetMetadata().mipLevels != 6)
+        return;
+
+    // Red spans [0, 1] over the sphere; every rougher lobe averages more of it away
+    float range[6] = {};
+    for (size_t face = 0; face < 6; ++face)
+    {
+        const Image& top = *prefiltered.GetImage(0, face, 0);
+        CHECK(memcmp(top.pixels, source.GetImage(0, face, 0)->pixels, top.slicePitch) == 0);
+
+        for (size_t level = 0; level < 6; ++level)
+        {
+            ScratchImage wide;
+            CHECK(Convert(*prefiltered.GetImage(level, face, 0), VK_FORMAT_R32G32B32A32_SFLOAT, {}, wide));
+            const Image& img = *wide.GetImage(0, 0, 0);
+            for (size_t y = 0; y < img.height; ++y)
+            {
+                for (size_t x = 0; x < img.width; ++x)
+                    range[level] = std::max(range[level], std::fabs(GetTexel(img, x, y)[0] - 0.5f));
+            }
+        }
+    }
+
+    CHECK(range[0] > 0.45f);
+    for (size_t level = 1; level < 6; ++level)
+        CHECK(range[level] < range[level - 1]);
+    CHECK(range[5] < 0.6f * range[0]);
+
+    ScratchImage constant;
+    CHECK(constant.InitializeCube(VK_FORMAT_R32G32B32A32_SFLOAT, 16, 16, 1, 1));
+    for (size_t face = 0; face < 6; ++face)
+    {
+        const Image& img = *constant.GetImage(0, face, 0);
+        for (size_t i = 0; i < 256; ++i)
+        {
+            float* texel = GetTexel(img, i % 16, i / 16);
+            texel[0] = 0.25f;
+            texel[1] = 0.5f;
+            texel[2] = 1.f;
+            texel[3] = 1.f;
+        }
+    }
+
+    CHECK(PrefilterCubemapGGX(constant, 3, 32, VK_FORMAT_R32G32B32A32_SFLOAT, prefiltered));
+    CHECK(prefiltered.GetMetadata().mipLevels == 3);
+
+    bool uniform = (prefiltered.GetImageCount() == 18);
+    for (size_t i = 0; i < prefiltered.GetImageCount() && uniform; ++i)
+    {
+        const Image& img = prefiltered.GetImages()[i];
+        for (size_t y = 0; y < img.height; ++y)
+        {
+            for (size_t x = 0; x < img.width; ++x)
+            {
+                const float* texel = GetTexel(img, x, y);
+                uniform &= IsNear(texel[0], 0.25f, 1e-4f) && IsNear(texel[1], 0.5f, 1e-4f) && IsNear(texel[2], 1.f, 1e-4f);
+            }
+        }
+    }
+    CHECK(uniform);
+}
+
+// SH0 is pi L for a constant radiance L, linear radiance 0.5 (1 + y) adds (pi / 3) y to the irradiance
+TEST_CASE(ComputeIrradianceSHKnownValues)
+{
+    ScratchImage constant;
+    CHECK(constant.InitializeCube(VK_FORMAT_R32G32B32A32_SFLOAT, 16, 16, 1, 1));
+    const float radiance[3] = { 0.25f, 0.5f, 2.f };
+    for (size_t face = 0; face < 6; ++face)
+    {
+        const Image& img = *constant.GetImage(0, face, 0);
+        for (size_t i = 0; i < 256; ++i)
+        {
+            float* texel = GetTexel(img, i % 16, i / 16);
+            memcpy(texel, radiance, sizeof(radiance));
+            texel[3] = 1.f;
+        }
+    }
+
+    float sh[27] = {};
+    CHECK(ComputeIrradianceSH(constant, sh));
+    for (size_t c = 0; c < 3; ++c)
+        CHECK(IsNear(sh[c], c_pi * radiance[c], 1e-3f));
+    for (size_t i = 3; i < 27; ++i)
+        CHECK(IsNear(sh[i], 0.f, 1e-3f));
+
+    // Red 0.5 (1 + y): E = pi / 2 + (pi / 3) y. Green 0.5 (1 + z): E = pi / 2 + (pi / 3) z
+    ScratchImage equirect;
+    CHECK(equirect.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 256, 128, 1, 1));
+    FillEquirect(*equirect.GetImage(0, 0, 0));
+
+    ScratchImage cube;
+    CHECK(EquirectToCube(*equirect.GetImage(0, 0, 0), 64, TEX_FILTER_LINEAR, cube));
+    CHECK(ComputeIrradianceSH(cube, sh));
+
+    CHECK(IsNear(sh[0], 0.5f * c_pi, 1e-2f));
+    CHECK(IsNear(sh[1], 0.5f * c_pi, 1e-2f));
+    CHECK(IsNear(sh[1 * 3 + 0], c_pi / 3.f, 1e-2f));
+    CHECK(IsNear(sh[1 * 3 + 1], 0.f, 1e-2f));
+    CHECK(IsNear(sh[2 * 3 + 0], 0.f, 1e-2f));
+    CHECK(IsNear(sh[2 * 3 + 1], c_pi / 3.f, 1e-2f));
+    for (size_t k = 3; k < 9; ++k)
+    {
+        CHECK(IsNear(sh[k * 3 + 0], 0.f, 1e-2f));
+        CHECK(IsNear(sh[k * 3 + 1], 0.f, 1e-2f));
+    }
+
+    // Blue is constant 0.25
+    CHECK(IsNear(sh[2], 0.25f * c_pi, 1e-3f));
+}
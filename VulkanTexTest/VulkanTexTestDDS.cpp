@@ -0,0 +1,301 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestDDS.cpp
+//
+// DDS writers: every save path produces the same file; mip / array-item range loads
+//-------------------------------------------------------------------------------------
+
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    // Captured resource over the pixels of a 2D (array) ScratchImage, layer-major with
+    // each layer holding its mip chain
+    struct CapturedImage
+    {
+        std::vector<SubresourceInfo> subresources;
+        CapturedResourceInfo         info = {};
+    };
+
+    void MakeCaptured(const ScratchImage& image, CapturedImage& captured)
+    {
+        const TexMetadata& metadata = image.GetMetadata();
+
+        for (size_t item = 0; item < metadata.arraySize; ++item)
+        {
+            for (size_t level = 0; level < metadata.mipLevels; ++level)
+            {
+                const Image* img = image.GetImage(level, item, 0);
+
+                SubresourceInfo subresource = {};
+                subresource.layer        = static_cast<uint32_t>(item);
+                subresource.mipLevel     = static_cast<uint32_t>(level);
+                subresource.width        = static_cast<uint32_t>(img->width);
+                subresource.height       = static_cast<uint32_t>(img->height);
+                subresource.memoryOffset = static_cast<VkDeviceSize>(img->pixels - image.GetPixels());
+                subresource.memorySize   = img->slicePitch;
+                captured.subresources.push_back(subresource);
+            }
+        }
+
+        captured.info.mappedData               = image.GetPixels();
+        captured.info.subresourceInfoArray     = captured.subresources.data();
+        captured.info.subresourceInfoArraySize = static_cast<uint32_t>(captured.subresources.size());
+        captured.info.planeCount               = 1;
+        captured.info.layerCount               = static_cast<uint32_t>(metadata.arraySize);
+        captured.info.mipLevels                = static_cast<uint32_t>(metadata.mipLevels);
+        captured.info.imageViewType            = (metadata.arraySize > 1) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+        captured.info.format                   = metadata.format;
+    }
+
+    // B8G8R8 images with rows of 32bpp pixels (the source layout DDS_FLAGS_FORCE_24BPP_RGB
+    // repacks when rows aren't already in DDS layout), plus 'padding' bytes per row
+    bool MakeX8Rows(const ScratchImage& image, size_t padding, PaddedImages& rows)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            const Image& img = image.GetImages()[i];
+            total += (img.width * 4 + padding) * img.height;
+        }
+
+        rows.storage.assign(total, 0xCD);
+        rows.images.assign(image.GetImages(), image.GetImages() + image.GetImageCount());
+
+        uint8_t* dest = rows.storage.data();
+        for (Image& img : rows.images)
+        {
+            const size_t rowPitch = img.width * 4 + padding;
+            for (size_t y = 0; y < img.height; ++y)
+            {
+                for (size_t x = 0; x < img.width; ++x)
+                    memcpy(dest + y * rowPitch + x * 4, img.pixels + y * img.rowPitch + x * 3, 3);
+            }
+
+            img.pixels     = dest;
+            img.rowPitch   = rowPitch;
+            img.slicePitch = rowPitch * img.height;
+            dest += img.slicePitch;
+        }
+
+        return total > 0;
+    }
+
+    // Saves through the mapped, O_DIRECT, batched (thread pool and io_uring) and budgeted
+    // writers and through SaveToDDSMemory, comparing each file with the default writer's
+    std::vector<uint8_t> CheckSavePaths(const Image* images, size_t nimages, const TexMetadata& metadata, DDS_FLAGS flags)
+    {
+        TempFile reference("SavePathReference.dds");
+        CHECK(SaveToDDSFile(images, nimages, metadata, flags, reference.c_str()));
+        const std::vector<uint8_t> expected = ReadFile(reference.c_str());
+        CHECK(!expected.empty());
+
+        TempFile file("SavePath.dds");
+        auto matches = [&]()
+        {
+            return ReadFile(file.c_str()) == expected;
+        };
+
+        CHECK(SaveToDDSFile(images, nimages, metadata, flags | DDS_FLAGS_MAPPED_FILE, file.c_str()));
+        CHECK(matches());
+
+        DDSSaveOptions direct;
+        direct.directIOThreshold = 1;
+        CHECK(SaveToDDSFile(images, nimages, metadata, flags, direct, file.c_str()));
+        CHECK(matches());
+
+        for (IO_BACKEND backend : { IO_BACKEND_THREAD_POOL, IO_BACKEND_IO_URING })
+        {
+            IOBackendScope scope(backend);
+            CHECK(SaveToDDSFile(images, nimages, metadata, flags, file.c_str()));
+            CHECK(matches());
+        }
+
+        // Budgets of a couple of rows and of more than the whole file
+        for (size_t budget : { size_t(2048), size_t(1) << 30 })
+        {
+            DDSSaveOptions budgeted;
+            budgeted.memoryBudget = budget;
+            CHECK(SaveToDDSFile(images, nimages, metadata, flags, budgeted, file.c_str()));
+            CHECK(matches());
+        }
+
+        // A row that does not fit the budget cannot be staged
+        DDSSaveOptions tooSmall;
+        tooSmall.memoryBudget = 1;
+        CHECK(!SaveToDDSFile(images, nimages, metadata, flags, tooSmall, file.c_str()));
+
+        Blob blob;
+        CHECK(SaveToDDSMemory(images, nimages, metadata, flags, blob));
+        CHECK(std::vector<uint8_t>(blob.GetConstBufferPointer(), blob.GetConstBufferPointer() + blob.GetBufferSize()) == expected);
+
+        return expected;
+    }
+
+    // Every writer refuses the images
+    void CheckSavesFail(const Image* images, size_t nimages, const TexMetadata& metadata, DDS_FLAGS flags)
+    {
+        TempFile file("SavePathRejected.dds");
+        CHECK(!SaveToDDSFile(images, nimages, metadata, flags, file.c_str()));
+        CHECK(!SaveToDDSFile(images, nimages, metadata, flags | DDS_FLAGS_MAPPED_FILE, file.c_str()));
+
+        DDSSaveOptions options;
+        options.directIOThreshold = 1;
+        CHECK(!SaveToDDSFile(images, nimages, metadata, flags, options, file.c_str()));
+
+        options = {};
+        options.memoryBudget = 1u << 20;
+        CHECK(!SaveToDDSFile(images, nimages, metadata, flags, options, file.c_str()));
+
+        {
+            IOBackendScope scope(IO_BACKEND_THREAD_POOL);
+            CHECK(!SaveToDDSFile(images, nimages, metadata, flags, file.c_str()));
+        }
+
+        Blob blob;
+        CHECK(!SaveToDDSMemory(images, nimages, metadata, flags, blob));
+    }
+}
+
+// Every writer produces the bytes of the default SaveToDDSFile, for packed and padded sources
+TEST_CASE(DDSSavePathsMatch)
+{
+    struct Shape
+    {
+        VkFormat  format;
+        size_t    width, height, arraySize, mipLevels;
+        DDS_FLAGS flags;
+    };
+
+    const Shape shapes[] =
+    {
+        { VK_FORMAT_R8G8B8A8_UNORM,      67,  45,  3, 4, DDS_FLAGS_NONE },
+        { VK_FORMAT_R8G8B8A8_UNORM,      256, 256, 1, 9, DDS_FLAGS_FORCE_DX10_EXT },
+        { VK_FORMAT_B8G8R8_UNORM,        37,  29,  2, 3, DDS_FLAGS_FORCE_24BPP_RGB },
+        { VK_FORMAT_R16G16B16A16_SFLOAT, 1,   1,   1, 1, DDS_FLAGS_NONE },
+        { VK_FORMAT_BC1_RGB_UNORM_BLOCK, 36,  20,  1, 3, DDS_FLAGS_NONE },
+    };
+
+    for (const Shape& shape : shapes)
+    {
+        ScratchImage image;
+        CHECK(image.Initialize2D(shape.format, shape.width, shape.height, shape.arraySize, shape.mipLevels));
+        FillPattern(image, static_cast<uint32_t>(shape.width));
+
+        const std::vector<uint8_t> expected = CheckSavePaths(image.GetImages(), image.GetImageCount(), image.GetMetadata(), shape.flags);
+
+        PaddedImages padded;
+        CHECK(MakePadded(image, 12, padded));
+
+        if (shape.flags & DDS_FLAGS_FORCE_24BPP_RGB)
+        {
+            // Padded 24bpp rows are neither DDS layout nor 32bpp pixels
+            CheckSavesFail(padded.images.data(), padded.images.size(), image.GetMetadata(), shape.flags);
+
+            // Rows of 32bpp pixels are repacked to the same file as the packed source
+            CHECK(MakeX8Rows(image, 12, padded));
+        }
+
+        CHECK(CheckSavePaths(padded.images.data(), padded.images.size(), image.GetMetadata(), shape.flags) == expected);
+    }
+
+    // Volume texture
+    ScratchImage volume;
+    CHECK(volume.Initialize3D(VK_FORMAT_R8G8B8A8_UNORM, 19, 11, 5, 3));
+    FillPattern(volume, 3);
+    CheckSavePaths(volume.GetImages(), volume.GetImageCount(), volume.GetMetadata(), DDS_FLAGS_NONE);
+}
+
+// The captured-resource overload writes the same file with and without a memory budget
+TEST_CASE(DDSCapturedSavePathsMatch)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 53, 31, 2, 3));
+    FillPattern(image, 5);
+
+    CapturedImage captured;
+    MakeCaptured(image, captured);
+
+    TempFile reference("CapturedReference.dds");
+    CHECK(SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DDS_FLAGS_NONE, reference.c_str()));
+
+    TempFile file("Captured.dds");
+    CHECK(SaveToDDSFile(&captured.info, DDS_FLAGS_NONE, file.c_str()));
+    CHECK(ReadFile(file.c_str()) == ReadFile(reference.c_str()));
+
+    DDSSaveOptions budgeted;
+    budgeted.memoryBudget = 4096;
+    CHECK(SaveToDDSFile(&captured.info, DDS_FLAGS_NONE, budgeted, file.c_str()));
+    CHECK(ReadFile(file.c_str()) == ReadFile(reference.c_str()));
+}
+
+// Range loads return exactly the requested mips and items, from plain and supercompressed files
+TEST_CASE(DDSRangeLoads)
+{
+    struct Range
+    {
+        size_t firstMip, mipCount, firstItem, itemCount;
+    };
+
+    const Range ranges[] =
+    {
+        { 0, 0, 0, 0 },
+        { 1, 2, 0, 0 },
+        { 2, 0, 3, 2 },
+        { 3, 1, 4, 1 },
+        { 0, 1, 1, 3 },
+    };
+
+    for (VkFormat format : { VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_BC1_RGB_UNORM_BLOCK })
+    {
+        ScratchImage image;
+        CHECK(image.Initialize2D(format, 40, 24, 5, 4));
+        FillPattern(image, 17);
+
+        for (DDS_FLAGS flags : { DDS_FLAGS_NONE, DDS_FLAGS_SUPERCOMPRESS_FAST })
+        {
+            Blob blob;
+            CHECK(SaveToDDSMemory(image.GetImages(), image.GetImageCount(), image.GetMetadata(), flags, blob));
+
+            TempFile file("Range.dds");
+            CHECK(WriteFile(file.c_str(), blob.GetConstBufferPointer(), blob.GetBufferSize()));
+
+            for (const Range& range : ranges)
+            {
+                TexMetadata metadata = {};
+                ScratchImage loaded;
+                CHECK(LoadFromDDSMemory(blob.GetConstBufferPointer(), blob.GetBufferSize(), DDS_FLAGS_NONE,
+                    range.firstMip, range.mipCount, range.firstItem, range.itemCount, &metadata, loaded));
+                CHECK(metadata.mipLevels == 4 && metadata.arraySize == 5);
+                CHECK(loaded.GetMetadata().mipLevels == (range.mipCount ? range.mipCount : 4 - range.firstMip));
+                CHECK(loaded.GetMetadata().arraySize == (range.itemCount ? range.itemCount : 5 - range.firstItem));
+                CHECK(SameSubresources(loaded, image, range.firstMip, range.firstItem));
+
+                CHECK(LoadFromDDSFile(file.c_str(), DDS_FLAGS_NONE,
+                    range.firstMip, range.mipCount, range.firstItem, range.itemCount, nullptr, loaded));
+                CHECK(SameSubresources(loaded, image, range.firstMip, range.firstItem));
+            }
+
+            ScratchImage loaded;
+            CHECK(!LoadFromDDSFile(file.c_str(), DDS_FLAGS_NONE, 4, 1, 0, 0, nullptr, loaded));
+            CHECK(!LoadFromDDSFile(file.c_str(), DDS_FLAGS_NONE, 0, 0, 3, 3, nullptr, loaded));
+            CHECK(!LoadFromDDSMemory(blob.GetConstBufferPointer(), blob.GetBufferSize(), DDS_FLAGS_NONE, 2, 3, 0, 0, nullptr, loaded));
+        }
+    }
+
+    // Volume mips keep halving the depth
+    ScratchImage volume;
+    CHECK(volume.Initialize3D(VK_FORMAT_R8G8B8A8_UNORM, 16, 8, 8, 4));
+    FillPattern(volume, 2);
+
+    TempFile file("RangeVolume.dds");
+    CHECK(SaveToDDSFile(volume.GetImages(), volume.GetImageCount(), volume.GetMetadata(), DDS_FLAGS_NONE, file.c_str()));
+
+    ScratchImage loaded;
+    CHECK(LoadFromDDSFile(file.c_str(), DDS_FLAGS_NONE, 1, 2, 0, 0, nullptr, loaded));
+    CHECK(loaded.GetMetadata().depth == 4 && loaded.GetMetadata().mipLevels == 2);
+    CHECK(SameSubresources(loaded, volume, 1, 0));
+}
@@ -0,0 +1,294 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestFilter.cpp
+//
+// Mipmap generation and resize: box averages, chain shapes, constant images
+//-------------------------------------------------------------------------------------
+
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    // Arbitrary but exactly representable value of channel c of texel (x, y, z) of item 'item'
+    float TexelValue(size_t item, size_t x, size_t y, size_t z, size_t c)
+    {
+        return float((x * 7 + y * 13 + z * 5 + c * 3 + item * 11) % 17) * (1.f / 16.f);
+    }
+
+    void FillTexels(const ScratchImage& image)
+    {
+        const TexMetadata& metadata = image.GetMetadata();
+        for (size_t item = 0; item < metadata.arraySize; ++item)
+        {
+            for (size_t z = 0; z < metadata.depth; ++z)
+            {
+                const Image* img = image.GetImage(0, item, z);
+                for (size_t y = 0; y < img->height; ++y)
+                {
+                    for (size_t x = 0; x < img->width; ++x)
+                    {
+                        for (size_t c = 0; c < 4; ++c)
+                            GetTexel(*img, x, y)[c] = TexelValue(item, x, y, z, c);
+                    }
+                }
+            }
+        }
+    }
+
+    // Every texel of every image is 'value' in all channels
+    bool IsConstant(const ScratchImage& image, float value, float tolerance)
+    {
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            const Image& img = image.GetImages()[i];
+            for (size_t y = 0; y < img.height; ++y)
+            {
+                for (size_t x = 0; x < img.width; ++x)
+                {
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        if (!IsNear(GetTexel(img, x, y)[c], value, tolerance))
+                            return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool MakeConstant(VkFormat format, size_t width, size_t height, size_t depth, float value, ScratchImage& image)
+    {
+        const bool ok = (depth > 1)
+            ? image.Initialize3D(VK_FORMAT_R32G32B32A32_SFLOAT, width, height, depth, 1)
+            : image.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, width, height, 1, 1);
+        if (!ok)
+            return false;
+
+        for (size_t i = 0; i < image.GetImageCount(); ++i)
+        {
+            const Image& img = image.GetImages()[i];
+            for (size_t y = 0; y < img.height; ++y)
+            {
+                for (size_t x = 0; x < img.width; ++x)
+                {
+                    for (size_t c = 0; c < 4; ++c)
+                        GetTexel(img, x, y)[c] = value;
+                }
+            }
+        }
+
+        if (format == VK_FORMAT_R32G32B32A32_SFLOAT)
+            return true;
+
+        ScratchImage converted;
+        if (!Convert(image.GetImages(), image.GetImageCount(), image.GetMetadata(), format, {}, converted))
+            return false;
+
+        image = std::move(converted);
+        return true;
+    }
+}
+
+// Box-filtered levels are 2x2 averages of the level above, per array item, down to 1x1
+// with TEX_FILTER_SEPARATE_ALPHA; by default straight alpha weights the color samples
+TEST_CASE(GenerateMipMapsBoxAverages)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 8, 4, 2, 1));
+    FillTexels(image);
+
+    ScratchImage chain;
+    CHECK(GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), TEX_FILTER_BOX | TEX_FILTER_SEPARATE_ALPHA, 0, chain));
+
+    const TexMetadata& metadata = chain.GetMetadata();
+    CHECK(metadata.mipLevels == 4);
+    CHECK(metadata.arraySize == 2);
+    if (metadata.mipLevels != 4 || metadata.arraySize != 2)
+        return;
+
+    const size_t sizes[4][2] = { { 8, 4 }, { 4, 2 }, { 2, 1 }, { 1, 1 } };
+    for (size_t item = 0; item < 2; ++item)
+    {
+        for (size_t level = 0; level < 4; ++level)
+        {
+            const Image* img = chain.GetImage(level, item, 0);
+            CHECK(img->width == sizes[level][0] && img->height == sizes[level][1]);
+        }
+
+        // Level 0 is the source, level 1 averages 2x2 blocks, the last level is the mean
+        CHECK(memcmp(chain.GetImage(0, item, 0)->pixels, image.GetImage(0, item, 0)->pixels, image.GetImage(0, item, 0)->slicePitch) == 0);
+
+        const Image* level1 = chain.GetImage(1, item, 0);
+        bool averaged = true;
+        for (size_t y = 0; y < 2; ++y)
+        {
+            for (size_t x = 0; x < 4; ++x)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    const float expected = 0.25f * (TexelValue(item, 2 * x, 2 * y, 0, c) + TexelValue(item, 2 * x + 1, 2 * y, 0, c)
+                        + TexelValue(item, 2 * x, 2 * y + 1, 0, c) + TexelValue(item, 2 * x + 1, 2 * y + 1, 0, c));
+                    averaged &= IsNear(GetTexel(*level1, x, y)[c], expected);
+                }
+            }
+        }
+        CHECK(averaged);
+
+        for (size_t c = 0; c < 4; ++c)
+        {
+            float mean = 0.f;
+            for (size_t y = 0; y < 4; ++y)
+            {
+                for (size_t x = 0; x < 8; ++x)
+                    mean += TexelValue(item, x, y, 0, c);
+            }
+            CHECK(IsNear(GetTexel(*chain.GetImage(3, item, 0), 0, 0)[c], mean / 32.f));
+        }
+    }
+
+    // Transparent texels do not bleed their color into the average
+    ScratchImage edge;
+    CHECK(edge.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 2, 1, 1, 1));
+    const float edgeTexels[8] = { 1.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f };
+    memcpy(edge.GetPixels(), edgeTexels, sizeof(edgeTexels));
+
+    CHECK(GenerateMipMaps(*edge.GetImage(0, 0, 0), TEX_FILTER_BOX, 0, chain));
+    CHECK(chain.GetMetadata().mipLevels == 2);
+    if (chain.GetMetadata().mipLevels == 2)
+    {
+        const float* texel = GetTexel(*chain.GetImage(1, 0, 0), 0, 0);
+        CHECK(IsNear(texel[0], 1.f) && IsNear(texel[1], 0.f) && IsNear(texel[2], 0.f) && IsNear(texel[3], 0.5f));
+    }
+
+    // A constant 8-bit image stays constant with every filter, a level count limits the chain
+    for (TEX_FILTER_FLAGS filter : { TEX_FILTER_POINT, TEX_FILTER_LINEAR, TEX_FILTER_CUBIC, TEX_FILTER_BOX, TEX_FILTER_KAISER })
+    {
+        ScratchImage constant;
+        CHECK(MakeConstant(VK_FORMAT_R8G8B8A8_UNORM, 37, 21, 1, 0.4f, constant));
+
+        CHECK(GenerateMipMaps(*constant.GetImage(0, 0, 0), filter, 3, chain));
+        CHECK(chain.GetMetadata().mipLevels == 3);
+
+        ScratchImage wide;
+        CHECK(Convert(chain.GetImages(), chain.GetImageCount(), chain.GetMetadata(), VK_FORMAT_R32G32B32A32_SFLOAT, {}, wide));
+        CHECK(IsConstant(wide, 102.f / 255.f, 1e-6f));
+    }
+}
+
+// Volume levels halve the depth too and box-average 2x2x2 texels
+TEST_CASE(GenerateMipMaps3DBoxAverages)
+{
+    ScratchImage volume;
+    CHECK(volume.Initialize3D(VK_FORMAT_R32G32B32A32_SFLOAT, 4, 4, 4, 1));
+    FillTexels(volume);
+
+    ScratchImage chain;
+    CHECK(GenerateMipMaps3D(volume.GetImages(), volume.GetImageCount(), volume.GetMetadata(), TEX_FILTER_BOX | TEX_FILTER_SEPARATE_ALPHA, 0, chain));
+
+    const TexMetadata& metadata = chain.GetMetadata();
+    CHECK(metadata.dimension == TEX_DIMENSION_TEXTURE3D);
+    CHECK(metadata.mipLevels == 3);
+    if (metadata.mipLevels != 3)
+        return;
+
+    CHECK(chain.GetImageCount() == 4 + 2 + 1);
+    CHECK(chain.GetImage(1, 0, 1) && !chain.GetImage(1, 0, 2));
+    CHECK(chain.GetImage(2, 0, 0) && chain.GetImage(2, 0, 0)->width == 1 && chain.GetImage(2, 0, 0)->height == 1);
+
+    bool averaged = true;
+    for (size_t z = 0; z < 2; ++z)
+    {
+        const Image* slice = chain.GetImage(1, 0, z);
+        for (size_t y = 0; y < 2; ++y)
+        {
+            for (size_t x = 0; x < 2; ++x)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    float expected = 0.f;
+                    for (size_t i = 0; i < 8; ++i)
+                        expected += TexelValue(0, 2 * x + (i & 1), 2 * y + ((i >> 1) & 1), 2 * z + (i >> 2), c);
+                    averaged &= IsNear(GetTexel(*slice, x, y)[c], expected / 8.f);
+                }
+            }
+        }
+    }
+    CHECK(averaged);
+
+    // The 1x1x1 level is the mean of the volume
+    for (size_t c = 0; c < 4; ++c)
+    {
+        float mean = 0.f;
+        for (size_t i = 0; i < 64; ++i)
+            mean += TexelValue(0, i & 3, (i >> 2) & 3, i >> 4, c);
+        CHECK(IsNear(GetTexel(*chain.GetImage(2, 0, 0), 0, 0)[c], mean / 64.f));
+    }
+
+    // A constant volume stays constant with every filter
+    for (TEX_FILTER_FLAGS filter : { TEX_FILTER_POINT, TEX_FILTER_LINEAR, TEX_FILTER_CUBIC, TEX_FILTER_BOX })
+    {
+        ScratchImage constant;
+        CHECK(MakeConstant(VK_FORMAT_R32G32B32A32_SFLOAT, 9, 6, 5, 0.75f, constant));
+        CHECK(GenerateMipMaps3D(constant.GetImages(), constant.GetMetadata().depth, filter, 0, chain));
+        CHECK(chain.GetMetadata().mipLevels == 4);
+        CHECK(IsConstant(chain, 0.75f, 1e-6f));
+    }
+}
+
+// Box shrinking averages, linear enlarging interpolates between texel centers, constants stay constant
+TEST_CASE(ResizeKnownValues)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 8, 4, 2, 1));
+    FillTexels(image);
+
+    ScratchImage resized;
+    CHECK(Resize(image.GetImages(), image.GetImageCount(), image.GetMetadata(), 4, 2, TEX_FILTER_BOX | TEX_FILTER_SEPARATE_ALPHA, resized));
+    CHECK(resized.GetMetadata().width == 4 && resized.GetMetadata().height == 2 && resized.GetMetadata().arraySize == 2);
+
+    for (size_t item = 0; item < 2 && item < resized.GetImageCount(); ++item)
+    {
+        bool averaged = true;
+        for (size_t y = 0; y < 2; ++y)
+        {
+            for (size_t x = 0; x < 4; ++x)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    const float expected = 0.25f * (TexelValue(item, 2 * x, 2 * y, 0, c) + TexelValue(item, 2 * x + 1, 2 * y, 0, c)
+                        + TexelValue(item, 2 * x, 2 * y + 1, 0, c) + TexelValue(item, 2 * x + 1, 2 * y + 1, 0, c));
+                    averaged &= IsNear(GetTexel(*resized.GetImage(0, item, 0), x, y)[c], expected);
+                }
+            }
+        }
+        CHECK(averaged);
+    }
+
+    // Point sampling at the same size is a copy
+    CHECK(Resize(image.GetImages(), image.GetImageCount(), image.GetMetadata(), 8, 4, TEX_FILTER_POINT | TEX_FILTER_SEPARATE_ALPHA, resized));
+    CHECK(SamePixels(resized, image));
+
+    // 2 -> 4 texels: destination centers fall at -0.25, 0.25, 0.75 and 1.25 source texels (edges clamp)
+    ScratchImage ramp;
+    CHECK(ramp.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 2, 1, 1, 1));
+    const float rampTexels[8] = { 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f, 1.f };
+    memcpy(ramp.GetPixels(), rampTexels, sizeof(rampTexels));
+
+    CHECK(Resize(*ramp.GetImage(0, 0, 0), 4, 1, TEX_FILTER_LINEAR, resized));
+    const float expected[4] = { 0.f, 0.25f, 0.75f, 1.f };
+    for (size_t x = 0; x < 4 && resized.GetPixels(); ++x)
+        CHECK(IsNear(GetTexel(*resized.GetImage(0, 0, 0), x, 0)[0], expected[x]));
+
+    for (TEX_FILTER_FLAGS filter : { TEX_FILTER_POINT, TEX_FILTER_LINEAR, TEX_FILTER_CUBIC, TEX_FILTER_BOX, TEX_FILTER_KAISER })
+    {
+        ScratchImage constant;
+        CHECK(MakeConstant(VK_FORMAT_R32G32B32A32_SFLOAT, 13, 7, 1, 0.3f, constant));
+
+        CHECK(Resize(*constant.GetImage(0, 0, 0), 29, 3, filter, resized));
+        CHECK(resized.GetMetadata().width == 29 && resized.GetMetadata().height == 3);
+        CHECK(IsConstant(resized, 0.3f, 1e-6f));
+    }
+}
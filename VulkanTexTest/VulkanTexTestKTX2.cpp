@@ -0,0 +1,140 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestKTX2.cpp
+//
+// KTX2 reader / writer
+//-------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    // Field offsets in the KTX2 header and level index
+    constexpr size_t c_pixelWidthOffset  = 20;
+    constexpr size_t c_layerCountOffset  = 32;
+    constexpr size_t c_levelIndexOffset  = 80;
+
+    template<typename T>
+    std::vector<uint8_t> Patch(const Blob& blob, size_t offset, T value)
+    {
+        std::vector<uint8_t> data(blob.GetConstBufferPointer(), blob.GetConstBufferPointer() + blob.GetBufferSize());
+        memcpy(data.data() + offset, &value, sizeof(value));
+        return data;
+    }
+
+    bool Loads(const std::vector<uint8_t>& data)
+    {
+        ScratchImage image;
+        return LoadFromKTX2Memory(data.data(), data.size(), nullptr, image);
+    }
+}
+
+// Header fields are bounded before anything is sized from them
+TEST_CASE(KTX2RejectsCorruptHeader)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 32, 32, 1, 3));
+    FillPattern(image, 1);
+
+    Blob blob;
+    CHECK(SaveToKTX2Memory(image, KTX2_FLAGS_NONE, blob));
+    CHECK(Loads(std::vector<uint8_t>(blob.GetConstBufferPointer(), blob.GetConstBufferPointer() + blob.GetBufferSize())));
+
+    CHECK(!Loads(Patch<uint32_t>(blob, c_layerCountOffset, 0xFF000003u)));
+    CHECK(!Loads(Patch<uint32_t>(blob, c_pixelWidthOffset, 0x00100000u)));
+
+    // Level 0: byteLength, then uncompressedByteLength
+    CHECK(!Loads(Patch<uint64_t>(blob, c_levelIndexOffset + 8, 16)));
+    CHECK(!Loads(Patch<uint64_t>(blob, c_levelIndexOffset + 16, uint64_t(1) << 40)));
+
+    TempFile file("corrupt.ktx2");
+    const std::vector<uint8_t> data = Patch<uint32_t>(blob, c_layerCountOffset, 0xFF000003u);
+    CHECK(WriteFile(file.c_str(), data.data(), data.size()));
+
+    ScratchImage loaded;
+    CHECK(!LoadFromKTX2File(file.c_str(), nullptr, loaded));
+}
+
+// Every shape round trips through memory and files, level ranges read just those levels
+TEST_CASE(KTX2RoundTripsAndLevelRanges)
+{
+    struct Shape
+    {
+        TEX_DIMENSION dimension;
+        VkFormat      format;
+        size_t        width, height, depthOrArray, mipLevels;
+    };
+
+    const Shape shapes[] =
+    {
+        { TEX_DIMENSION_TEXTURE2D, VK_FORMAT_R8G8B8A8_UNORM,      45, 30, 3, 4 },
+        { TEX_DIMENSION_TEXTURE2D, VK_FORMAT_R16G16B16A16_SFLOAT, 16, 16, 1, 5 },
+        { TEX_DIMENSION_TEXTURE2D, VK_FORMAT_BC1_RGB_UNORM_BLOCK, 36, 20, 2, 3 },
+        { TEX_DIMENSION_TEXTURE3D, VK_FORMAT_R8G8B8A8_UNORM,      12, 10, 6, 3 },
+        { TEX_DIMENSION_TEXTURE1D, VK_FORMAT_R32_SFLOAT,          64, 1,  2, 4 },
+    };
+
+    for (const Shape& shape : shapes)
+    {
+        ScratchImage image;
+        if (shape.dimension == TEX_DIMENSION_TEXTURE3D)
+            CHECK(image.Initialize3D(shape.format, shape.width, shape.height, shape.depthOrArray, shape.mipLevels));
+        else if (shape.dimension == TEX_DIMENSION_TEXTURE1D)
+            CHECK(image.Initialize1D(shape.format, shape.width, shape.depthOrArray, shape.mipLevels));
+        else
+            CHECK(image.Initialize2D(shape.format, shape.width, shape.height, shape.depthOrArray, shape.mipLevels));
+        FillPattern(image, static_cast<uint32_t>(shape.width));
+
+        Blob blob;
+        CHECK(SaveToKTX2Memory(image.GetImages(), image.GetImageCount(), image.GetMetadata(), KTX2_FLAGS_NONE, blob));
+
+        TexMetadata metadata = {};
+        ScratchImage loaded;
+        CHECK(LoadFromKTX2Memory(blob.GetConstBufferPointer(), blob.GetBufferSize(), &metadata, loaded));
+        CHECK(metadata.dimension == shape.dimension && metadata.format == shape.format);
+        CHECK(metadata.width == image.GetMetadata().width && metadata.height == image.GetMetadata().height);
+        CHECK(metadata.depth == image.GetMetadata().depth && metadata.arraySize == image.GetMetadata().arraySize);
+        CHECK(metadata.mipLevels == shape.mipLevels);
+        CHECK(SamePixels(loaded, image));
+
+        TempFile file("RoundTrip.ktx2");
+        CHECK(SaveToKTX2File(image.GetImages(), image.GetImageCount(), image.GetMetadata(), KTX2_FLAGS_NONE, file.c_str()));
+        CHECK(ReadFile(file.c_str()) == std::vector<uint8_t>(blob.GetConstBufferPointer(), blob.GetConstBufferPointer() + blob.GetBufferSize()));
+        CHECK(LoadFromKTX2File(file.c_str(), nullptr, loaded));
+        CHECK(SamePixels(loaded, image));
+
+        // Levels 1..2, and from level 1 to the end; 'metadata' still describes the file
+        for (size_t mipCount : { size_t(2), size_t(0) })
+        {
+            metadata = {};
+            CHECK(LoadFromKTX2Memory(blob.GetConstBufferPointer(), blob.GetBufferSize(), 1, mipCount, &metadata, loaded));
+            CHECK(metadata.mipLevels == shape.mipLevels);
+            CHECK(loaded.GetMetadata().mipLevels == (mipCount ? mipCount : shape.mipLevels - 1));
+            CHECK(loaded.GetMetadata().width == std::max<size_t>(shape.width >> 1, 1));
+            CHECK(SameSubresources(loaded, image, 1, 0));
+
+            CHECK(LoadFromKTX2File(file.c_str(), 1, mipCount, nullptr, loaded));
+            CHECK(SameSubresources(loaded, image, 1, 0));
+        }
+
+        CHECK(!LoadFromKTX2Memory(blob.GetConstBufferPointer(), blob.GetBufferSize(), shape.mipLevels, 1, nullptr, loaded));
+        CHECK(!LoadFromKTX2Memory(blob.GetConstBufferPointer(), blob.GetBufferSize(), 1, shape.mipLevels, nullptr, loaded));
+    }
+
+    // Cubemaps keep their cube flag
+    ScratchImage cube;
+    CHECK(cube.InitializeCube(VK_FORMAT_R8G8B8A8_UNORM, 8, 8, 2, 2));
+    FillPattern(cube, 3);
+
+    Blob blob;
+    CHECK(SaveToKTX2Memory(cube.GetImages(), cube.GetImageCount(), cube.GetMetadata(), KTX2_FLAGS_NONE, blob));
+
+    ScratchImage loaded;
+    CHECK(LoadFromKTX2Memory(blob.GetConstBufferPointer(), blob.GetBufferSize(), nullptr, loaded));
+    CHECK(loaded.GetMetadata().IsCubemap() && loaded.GetMetadata().arraySize == 12);
+    CHECK(SamePixels(loaded, cube));
+}
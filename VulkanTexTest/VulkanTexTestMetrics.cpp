@@ -0,0 +1,94 @@
+//-------------------------------------------------------------------------------------
+// VulkanTexTestMetrics.cpp
+//
+// Image comparison: MSE, PSNR and SSIM known answers
+//-------------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstring>
+#include "VulkanTexTest.h"
+
+using namespace VulkanTex;
+using namespace VulkanTexTest;
+
+namespace
+{
+    void FillFloat(const Image& image, float offset, size_t channel)
+    {
+        for (size_t y = 0; y < image.height; ++y)
+        {
+            for (size_t x = 0; x < image.width; ++x)
+            {
+                float* texel = GetTexel(image, x, y);
+                for (size_t c = 0; c < 4; ++c)
+                    texel[c] = float((x * 3 + y * 5 + c) % 9) * (1.f / 16.f) + ((c == channel) ? offset : 0.f);
+            }
+        }
+    }
+}
+
+// Identical images, a known per-channel offset, ignored channels and sRGB linearization
+TEST_CASE(ComputeMetricsKnownValues)
+{
+    ScratchImage image;
+    CHECK(image.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 64, 40, 1, 1));
+    FillPattern(image, 8);
+    const Image& img = *image.GetImage(0, 0, 0);
+
+    float mse = -1.f;
+    float mseV[4] = { -1.f, -1.f, -1.f, -1.f };
+    CHECK(ComputeMSE(img, img, mse, mseV));
+    CHECK(mse == 0.f && mseV[0] == 0.f && mseV[1] == 0.f && mseV[2] == 0.f && mseV[3] == 0.f);
+
+    float psnr = 0.f;
+    CHECK(ComputePSNR(img, img, psnr));
+    CHECK(std::isinf(psnr));
+
+    float ssim = 0.f;
+    CHECK(ComputeSSIM(img, img, ssim));
+    CHECK(IsNear(ssim, 1.f));
+
+    // Red is 0.1 higher everywhere: channel MSE 0.01, mean over four channels 0.0025
+    ScratchImage a, b;
+    CHECK(a.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 33, 17, 1, 1));
+    CHECK(b.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 33, 17, 1, 1));
+    FillFloat(*a.GetImage(0, 0, 0), 0.f, 0);
+    FillFloat(*b.GetImage(0, 0, 0), 0.1f, 0);
+
+    CHECK(ComputeMSE(*a.GetImage(0, 0, 0), *b.GetImage(0, 0, 0), mse, mseV));
+    CHECK(IsNear(mse, 0.0025f, 1e-6f));
+    CHECK(IsNear(mseV[0], 0.01f, 1e-6f) && mseV[1] == 0.f && mseV[2] == 0.f && mseV[3] == 0.f);
+
+    CHECK(ComputePSNR(*a.GetImage(0, 0, 0), *b.GetImage(0, 0, 0), psnr));
+    CHECK(IsNear(psnr, 26.0206f, 1e-3f));
+
+    CHECK(ComputeMSE(*a.GetImage(0, 0, 0), *b.GetImage(0, 0, 0), mse, nullptr, CMSE_IGNORE_RED));
+    CHECK(mse == 0.f);
+
+    // Only the luminance term of the red channel drops
+    CHECK(ComputeSSIM(*a.GetImage(0, 0, 0), *b.GetImage(0, 0, 0), ssim));
+    CHECK(ssim < 1.f && ssim > 0.75f);
+    CHECK(ComputeSSIM(*a.GetImage(0, 0, 0), *b.GetImage(0, 0, 0), ssim, CMSE_IGNORE_RED));
+    CHECK(IsNear(ssim, 1.f));
+
+    // The images differ in size
+    CHECK(!ComputeMSE(*a.GetImage(0, 0, 0), img, mse, nullptr));
+    CHECK(!ComputeSSIM(*a.GetImage(0, 0, 0), img, ssim));
+
+    // sRGB 188 is linear 0.5029 once the first image is linearized
+    ScratchImage encoded, linear;
+    CHECK(encoded.Initialize2D(VK_FORMAT_R8G8B8A8_UNORM, 8, 8, 1, 1));
+    CHECK(linear.Initialize2D(VK_FORMAT_R32G32B32A32_SFLOAT, 8, 8, 1, 1));
+    memset(encoded.GetPixels(), 188, encoded.GetPixelsSize());
+    for (size_t i = 0; i < 64; ++i)
+    {
+        float* texel = GetTexel(*linear.GetImage(0, 0, 0), i % 8, i / 8);
+        texel[0] = texel[1] = texel[2] = 0.502886f;
+        texel[3] = 188.f / 255.f;
+    }
+
+    CHECK(ComputeMSE(*encoded.GetImage(0, 0, 0), *linear.GetImage(0, 0, 0), mse, nullptr, CMSE_IMAGE1_SRGB));
+    CHECK(mse < 1e-10f);
+    CHECK(ComputeMSE(*encoded.GetImage(0, 0, 0), *linear.GetImage(0, 0, 0), mse, nullptr));
+    CHECK(mse > 0.01f);
+}